@@ -0,0 +1,112 @@
+/*
+ * benchmark-dates.c: Measures decoding the dates of tasks
+ *
+ * Copyright (C) 2009 Manuel Rego Casasnovas <mrego@igalia.com>
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301 USA
+ */
+
+/*
+ * Decodes a set of dates in the layout sent by Remember The Milk with
+ * g_time_val_from_iso8601() and with rtm_util_g_time_val_from_iso8601(),
+ * checks both agree and prints the dates decoded per second by each one.
+ *
+ * Usage: benchmark-dates [DATES] [ITERATIONS]
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <rtm-glib/rtm-util.h>
+
+#define BENCHMARK_DEFAULT_DATES 10000
+#define BENCHMARK_DEFAULT_ITERATIONS 100
+
+typedef gboolean (*DecodeFunc) (const gchar *iso_date, GTimeVal *time_val);
+
+static gchar **
+generate_dates (guint n_dates)
+{
+        gchar **dates;
+        GTimeVal time_val;
+        guint i;
+
+        dates = g_new0 (gchar *, n_dates + 1);
+        for (i = 0; i < n_dates; i++) {
+                /* Spread over about 40 years from 1990 */
+                time_val.tv_sec = 631152000 + (glong) i * 126223;
+                time_val.tv_usec = 0;
+                dates[i] = g_time_val_to_iso8601 (&time_val);
+        }
+
+        return dates;
+}
+
+static glong
+run (const gchar *name, DecodeFunc decode, gchar **dates, guint n_dates,
+     guint iterations)
+{
+        GTimeVal time_val;
+        gint64 start, elapsed;
+        glong checksum = 0;
+        guint i, j;
+
+        start = g_get_monotonic_time ();
+        for (j = 0; j < iterations; j++) {
+                for (i = 0; i < n_dates; i++) {
+                        decode (dates[i], &time_val);
+                        checksum += time_val.tv_sec;
+                }
+        }
+        elapsed = g_get_monotonic_time () - start;
+
+        g_print ("%-8s %10.2f ms %14.0f dates/s\n", name, elapsed / 1000.0,
+                 (gdouble) n_dates * iterations * 1000000.0 /
+                 MAX (elapsed, 1));
+
+        return checksum;
+}
+
+gint
+main (gint argc, gchar **argv)
+{
+        gchar **dates;
+        guint n_dates, iterations;
+        glong generic, fast;
+
+        n_dates = argc > 1 ? atoi (argv[1]) : BENCHMARK_DEFAULT_DATES;
+        iterations = argc > 2 ? atoi (argv[2]) : BENCHMARK_DEFAULT_ITERATIONS;
+        if (iterations == 0) {
+                iterations = 1;
+        }
+
+        dates = generate_dates (n_dates);
+
+        g_print ("%u dates like %s, %u iterations\n", n_dates,
+                 n_dates > 0 ? dates[0] : "", iterations);
+
+        generic = run ("generic", (DecodeFunc) g_time_val_from_iso8601,
+                       dates, n_dates, iterations);
+        fast = run ("fast", rtm_util_g_time_val_from_iso8601, dates, n_dates,
+                    iterations);
+
+        g_strfreev (dates);
+
+        if (generic != fast) {
+                g_printerr ("The decoded dates do not match\n");
+                return EXIT_FAILURE;
+        }
+
+        return EXIT_SUCCESS;
+}
@@ -0,0 +1,230 @@
+/*
+ * benchmark-json.c: Compares parsing XML and JSON responses
+ *
+ * Copyright (C) 2009 Manuel Rego Casasnovas <mrego@igalia.com>
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301 USA
+ */
+
+/*
+ * Answers rtm.tasks.getList with a large generated response through the
+ * loopback transport, once in XML and once in JSON, and prints the time and
+ * the number of allocations each format needs per call.
+ *
+ * Usage: benchmark-json [TASKS] [ITERATIONS]
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <rtm-glib/rtm-glib.h>
+#include <rtm-glib/rtm-loopback-transport.h>
+
+#define BENCHMARK_DEFAULT_TASKS 2000
+#define BENCHMARK_DEFAULT_ITERATIONS 20
+
+static gsize n_allocations = 0;
+
+#ifdef __GLIBC__
+/* Counts the allocations of the whole process */
+extern void *__libc_malloc (size_t size);
+extern void *__libc_calloc (size_t n, size_t size);
+extern void *__libc_realloc (void *ptr, size_t size);
+
+void *
+malloc (size_t size)
+{
+        n_allocations++;
+        return __libc_malloc (size);
+}
+
+void *
+calloc (size_t n, size_t size)
+{
+        n_allocations++;
+        return __libc_calloc (n, size);
+}
+
+void *
+realloc (void *ptr, size_t size)
+{
+        n_allocations++;
+        return __libc_realloc (ptr, size);
+}
+#endif
+
+static gchar *
+generate_xml (guint n_tasks)
+{
+        GString *xml;
+        guint i;
+
+        xml = g_string_new ("<?xml version=\"1.0\" encoding=\"UTF-8\"?>"
+                            "<rsp stat=\"ok\"><tasks><list id=\"100653\">");
+
+        for (i = 0; i < n_tasks; i++) {
+                g_string_append_printf (
+                        xml,
+                        "<taskseries id=\"%u\" "
+                        "created=\"2009-05-07T10:19:54Z\" "
+                        "modified=\"2009-05-07T10:19:54Z\" "
+                        "name=\"Task number %u\" source=\"api\" "
+                        "url=\"\" location_id=\"\">"
+                        "<tags><tag>work</tag><tag>tag%u</tag></tags>"
+                        "<participants/><notes/>"
+                        "<task id=\"%u\" due=\"2009-05-08T00:00:00Z\" "
+                        "has_due_time=\"0\" "
+                        "added=\"2009-05-07T10:19:54Z\" completed=\"\" "
+                        "deleted=\"\" priority=\"2\" postponed=\"0\" "
+                        "estimate=\"\"/></taskseries>",
+                        i, i, i % 10, i);
+        }
+
+        g_string_append (xml, "</list></tasks></rsp>");
+
+        return g_string_free (xml, FALSE);
+}
+
+static gchar *
+generate_json (guint n_tasks)
+{
+        GString *json;
+        guint i;
+
+        json = g_string_new ("{\"rsp\":{\"stat\":\"ok\",\"tasks\":{\"list\":"
+                             "{\"id\":\"100653\",\"taskseries\":[");
+
+        for (i = 0; i < n_tasks; i++) {
+                g_string_append_printf (
+                        json,
+                        "%s{\"id\":\"%u\","
+                        "\"created\":\"2009-05-07T10:19:54Z\","
+                        "\"modified\":\"2009-05-07T10:19:54Z\","
+                        "\"name\":\"Task number %u\",\"source\":\"api\","
+                        "\"url\":\"\",\"location_id\":\"\","
+                        "\"tags\":{\"tag\":[\"work\",\"tag%u\"]},"
+                        "\"participants\":[],\"notes\":[],"
+                        "\"task\":{\"id\":\"%u\","
+                        "\"due\":\"2009-05-08T00:00:00Z\","
+                        "\"has_due_time\":\"0\","
+                        "\"added\":\"2009-05-07T10:19:54Z\","
+                        "\"completed\":\"\",\"deleted\":\"\","
+                        "\"priority\":\"2\",\"postponed\":\"0\","
+                        "\"estimate\":\"\"}}",
+                        i == 0 ? "" : ",", i, i, i % 10, i);
+        }
+
+        g_string_append (json, "]}}}}");
+
+        return g_string_free (json, FALSE);
+}
+
+static void
+run (RtmGlib *rtm, const gchar *format, gsize size, guint n_tasks,
+     guint iterations)
+{
+        GList *tasks;
+        gint64 start, elapsed;
+        gsize allocations;
+        guint i;
+        GError *error = NULL;
+
+        allocations = n_allocations;
+        start = g_get_monotonic_time ();
+
+        for (i = 0; i < iterations; i++) {
+                tasks = rtm_glib_tasks_get_list (rtm, NULL, NULL, NULL,
+                                                 &error);
+                if (error != NULL) {
+                        g_printerr ("%s: %s\n", format, error->message);
+                        exit (EXIT_FAILURE);
+                }
+                if (g_list_length (tasks) != n_tasks) {
+                        g_printerr ("%s: got %u tasks\n", format,
+                                    g_list_length (tasks));
+                        exit (EXIT_FAILURE);
+                }
+                g_list_free_full (tasks, g_object_unref);
+        }
+
+        elapsed = g_get_monotonic_time () - start;
+        allocations = n_allocations - allocations;
+
+        g_print ("%-4s %8" G_GSIZE_FORMAT " bytes %10.2f ms/call "
+                 "%8.1f MB/s %10" G_GSIZE_FORMAT " allocs/call\n",
+                 format, size,
+                 elapsed / 1000.0 / iterations,
+                 (gdouble) size * iterations / elapsed,
+                 allocations / iterations);
+}
+
+gint
+main (gint argc, gchar **argv)
+{
+        RtmGlib *rtm;
+        RtmLoopbackTransport *transport;
+        gchar *xml, *json;
+        guint n_tasks, iterations;
+
+        /* Count every allocation, not only the new slices */
+        g_setenv ("G_SLICE", "always-malloc", TRUE);
+        g_type_init ();
+
+        n_tasks = argc > 1 ? atoi (argv[1]) : BENCHMARK_DEFAULT_TASKS;
+        iterations = argc > 2 ? atoi (argv[2]) : BENCHMARK_DEFAULT_ITERATIONS;
+        if (iterations == 0) {
+                iterations = 1;
+        }
+
+        xml = generate_xml (n_tasks);
+        json = generate_json (n_tasks);
+
+        rtm = rtm_glib_new ("api_key", "shared_secret");
+        rtm_glib_set_rate_limit (rtm, 0, 1);
+        rtm_glib_set_timeout (rtm, 0);
+
+        transport = rtm_loopback_transport_new ();
+        rtm_glib_set_transport (rtm, RTM_TRANSPORT (transport));
+
+        rtm_loopback_transport_add_response (
+                transport, "rtm.auth.checkToken",
+                "<?xml version=\"1.0\" encoding=\"UTF-8\"?>"
+                "<rsp stat=\"ok\"><auth><token>auth_token</token>"
+                "<perms>delete</perms></auth></rsp>");
+        if (!rtm_glib_auth_check_token (rtm, "auth_token", NULL)) {
+                g_printerr ("Authentication failed\n");
+                return EXIT_FAILURE;
+        }
+
+        g_print ("tasks.getList with %u tasks, %u iterations\n",
+                 n_tasks, iterations);
+
+        rtm_loopback_transport_add_response (transport, "rtm.tasks.getList",
+                                             xml);
+        rtm_glib_set_use_json (rtm, FALSE);
+        run (rtm, "XML", strlen (xml), n_tasks, iterations);
+
+        rtm_loopback_transport_add_response (transport, "rtm.tasks.getList",
+                                             json);
+        rtm_glib_set_use_json (rtm, TRUE);
+        run (rtm, "JSON", strlen (json), n_tasks, iterations);
+
+        g_object_unref (rtm);
+        g_object_unref (transport);
+        g_free (xml);
+        g_free (json);
+
+        return EXIT_SUCCESS;
+}
@@ -0,0 +1,146 @@
+/*
+ * benchmark-sign.c: Measures signing large batches of calls
+ *
+ * Copyright (C) 2009 Manuel Rego Casasnovas <mrego@igalia.com>
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301 USA
+ */
+
+/*
+ * Pushes a batch of rtm.tasks.setName calls to a #RtmRequestQueue answered
+ * by the loopback transport, and prints the signatures per second of
+ * rtm_request_queue_presign() and the time to drain the queue with and
+ * without signing the batch first.
+ *
+ * Usage: benchmark-sign [CALLS]
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <rtm-glib/rtm-glib.h>
+#include <rtm-glib/rtm-loopback-transport.h>
+#include <rtm-glib/rtm-request-queue.h>
+
+#define BENCHMARK_DEFAULT_CALLS 20000
+
+/* Only the first call is sent before the batch is signed */
+#define BENCHMARK_MAX_IN_FLIGHT 1
+
+static void
+call_cb (RtmRequestQueue *queue, const gchar *method, RestXmlNode *root,
+         const GError *error, gpointer user_data)
+{
+        if (error != NULL) {
+                g_printerr ("%s: %s\n", method, error->message);
+                exit (EXIT_FAILURE);
+        }
+}
+
+static void
+push (RtmRequestQueue *queue, guint n_calls)
+{
+        gchar task_id[16], name[32];
+        guint i;
+
+        for (i = 0; i < n_calls; i++) {
+                g_snprintf (task_id, sizeof (task_id), "%u", i);
+                g_snprintf (name, sizeof (name), "Task number %u", i);
+
+                rtm_request_queue_push (queue, "rtm.tasks.setName", call_cb,
+                                        NULL,
+                                        "auth_token", "auth_token",
+                                        "timeline", "12741021",
+                                        "list_id", "100653",
+                                        "taskseries_id", task_id,
+                                        "task_id", task_id,
+                                        "name", name,
+                                        NULL);
+        }
+}
+
+static void
+run (RtmGlib *rtm, guint n_calls, gboolean presign)
+{
+        RtmRequestQueue *queue;
+        gint64 start, signed_time, elapsed;
+
+        queue = rtm_request_queue_new (rtm, BENCHMARK_MAX_IN_FLIGHT);
+        push (queue, n_calls);
+
+        start = g_get_monotonic_time ();
+
+        if (presign) {
+                rtm_request_queue_presign (queue);
+                signed_time = g_get_monotonic_time () - start;
+
+                g_print ("presign %8u calls %10.2f ms %12.0f signatures/s\n",
+                         n_calls, signed_time / 1000.0,
+                         n_calls * 1000000.0 / MAX (signed_time, 1));
+        }
+
+        rtm_request_queue_wait (queue);
+        elapsed = g_get_monotonic_time () - start;
+
+        g_print ("%-7s %8u calls %10.2f ms %12.0f calls/s\n",
+                 presign ? "drain" : "serial", n_calls, elapsed / 1000.0,
+                 n_calls * 1000000.0 / MAX (elapsed, 1));
+
+        g_object_unref (queue);
+}
+
+gint
+main (gint argc, gchar **argv)
+{
+        RtmGlib *rtm;
+        RtmLoopbackTransport *transport;
+        guint n_calls;
+
+        g_type_init ();
+
+        n_calls = argc > 1 ? atoi (argv[1]) : BENCHMARK_DEFAULT_CALLS;
+
+        rtm = rtm_glib_new ("api_key", "shared_secret");
+        rtm_glib_set_rate_limit (rtm, 0, 1);
+        rtm_glib_set_timeout (rtm, 0);
+
+        transport = rtm_loopback_transport_new ();
+        rtm_glib_set_transport (rtm, RTM_TRANSPORT (transport));
+
+        rtm_loopback_transport_add_response (
+                transport, "rtm.auth.checkToken",
+                "<?xml version=\"1.0\" encoding=\"UTF-8\"?>"
+                "<rsp stat=\"ok\"><auth><token>auth_token</token>"
+                "<perms>delete</perms></auth></rsp>");
+        if (!rtm_glib_auth_check_token (rtm, "auth_token", NULL)) {
+                g_printerr ("Authentication failed\n");
+                return EXIT_FAILURE;
+        }
+
+        rtm_loopback_transport_add_response (
+                transport, "rtm.tasks.setName",
+                "<?xml version=\"1.0\" encoding=\"UTF-8\"?>"
+                "<rsp stat=\"ok\"><transaction id=\"1\" undoable=\"0\"/>"
+                "</rsp>");
+
+        g_print ("tasks.setName, %u processors\n", g_get_num_processors ());
+
+        run (rtm, n_calls, FALSE);
+        run (rtm, n_calls, TRUE);
+
+        g_object_unref (rtm);
+        g_object_unref (transport);
+
+        return EXIT_SUCCESS;
+}
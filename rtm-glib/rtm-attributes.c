@@ -0,0 +1,128 @@
+/*
+ * rtm-attributes.c: Lookup of the attribute names of responses
+ *
+ * Copyright (C) 2009 Manuel Rego Casasnovas <mrego@igalia.com>
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301 USA
+ */
+
+/*
+ * Resolves the attribute names found in responses to the index of the field
+ * they set, so the models do not compare each name with every known one.
+ *
+ * Each model keeps a static #RtmAttributes with the names it knows, in the
+ * order of its field identifiers. On first use the names are placed in a
+ * small open-addressing table, hashed from their length and a few of their
+ * characters, so a lookup costs that hash and a single string comparison.
+ * The tables are built once and only read afterwards, from any thread.
+ */
+
+#include <string.h>
+#include <rtm-attributes.h>
+
+static guint
+rtm_attributes_hash (const gchar *name, gsize length)
+{
+        guint hash;
+
+        hash = (guint) length * 31 + (guchar) name[0];
+        if (length > 1) {
+                hash = hash * 31 + (guchar) name[1];
+                hash = hash * 31 + (guchar) name[length - 1];
+        }
+
+        return hash;
+}
+
+static void
+rtm_attributes_build (RtmAttributes *attributes)
+{
+        const gchar *name;
+        guint id, slot;
+
+        for (id = 0; attributes->names[id] != NULL; id++) {
+                name = attributes->names[id];
+                slot = rtm_attributes_hash (name, strlen (name)) %
+                        RTM_ATTRIBUTES_N_SLOTS;
+                while (attributes->slots[slot] != 0) {
+                        slot = (slot + 1) % RTM_ATTRIBUTES_N_SLOTS;
+                }
+                /* Zero marks an empty slot */
+                attributes->slots[slot] = id + 1;
+        }
+}
+
+/**
+ * rtm_attributes_lookup:
+ * @attributes: the #RtmAttributes of a model.
+ * @name: the name of an attribute.
+ *
+ * Finds the field set by an attribute.
+ *
+ * Returns: the index of @name in the names of @attributes, or -1 if it is
+ * not known.
+ */
+gint
+rtm_attributes_lookup (RtmAttributes *attributes, const gchar *name)
+{
+        guint slot, id;
+
+        if (g_once_init_enter (&attributes->initialized)) {
+                rtm_attributes_build (attributes);
+                g_once_init_leave (&attributes->initialized, 1);
+        }
+
+        if (name == NULL || name[0] == '\0') {
+                return -1;
+        }
+
+        slot = rtm_attributes_hash (name, strlen (name)) %
+                RTM_ATTRIBUTES_N_SLOTS;
+        while ((id = attributes->slots[slot]) != 0) {
+                if (strcmp (attributes->names[id - 1], name) == 0) {
+                        return id - 1;
+                }
+                slot = (slot + 1) % RTM_ATTRIBUTES_N_SLOTS;
+        }
+
+        return -1;
+}
+
+/**
+ * rtm_attributes_load_node:
+ * @attributes: the #RtmAttributes of a model.
+ * @node: a #RestXmlNode of a response.
+ * @set: the #RtmAttributesSetFunc of the model.
+ * @object: the object of the model.
+ *
+ * Sets the fields of @object from the attributes of @node, walking them
+ * once. Unknown attributes are ignored.
+ */
+void
+rtm_attributes_load_node (RtmAttributes *attributes, RestXmlNode *node,
+                          RtmAttributesSetFunc set, gpointer object)
+{
+        GHashTableIter iter;
+        gpointer name, value;
+        gint id;
+
+        g_hash_table_iter_init (&iter, node->attrs);
+        while (g_hash_table_iter_next (&iter, &name, &value)) {
+                id = rtm_attributes_lookup (attributes, name);
+                if (id >= 0) {
+                        set (object, id, value);
+                }
+        }
+}
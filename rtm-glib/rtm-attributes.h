@@ -0,0 +1,55 @@
+/*
+ * rtm-attributes.h: Lookup of the attribute names of responses
+ *
+ * Copyright (C) 2009 Manuel Rego Casasnovas <mrego@igalia.com>
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301 USA
+ */
+
+#ifndef __RTM_ATTRIBUTES_H__
+#define __RTM_ATTRIBUTES_H__
+
+#include <glib.h>
+#include <rest/rest-xml-parser.h>
+
+
+G_BEGIN_DECLS
+
+/* Slots of a table, more than twice the names of any element */
+#define RTM_ATTRIBUTES_N_SLOTS 64
+
+typedef struct {
+        const gchar * const *names;
+        gsize initialized;
+        guint8 slots[RTM_ATTRIBUTES_N_SLOTS];
+} RtmAttributes;
+
+/* Static initializer of a table of the %NULL-terminated array @names */
+#define RTM_ATTRIBUTES_INIT(names) { (names), 0, { 0 } }
+
+/* Sets the field @id of @object, as returned by rtm_attributes_lookup() */
+typedef void (*RtmAttributesSetFunc) (gpointer object, gint id,
+                                      const gchar *value);
+
+gint
+rtm_attributes_lookup (RtmAttributes *attributes, const gchar *name);
+
+void
+rtm_attributes_load_node (RtmAttributes *attributes, RestXmlNode *node,
+                          RtmAttributesSetFunc set, gpointer object);
+
+G_END_DECLS
+
+#endif /* __RTM_ATTRIBUTES_H__ */
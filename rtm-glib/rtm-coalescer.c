@@ -0,0 +1,828 @@
+/*
+ * rtm-coalescer.c: Merges redundant modifications of the same task
+ *
+ * Copyright (C) 2009 Manuel Rego Casasnovas <mrego@igalia.com>
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301 USA
+ */
+
+/**
+ * SECTION:rtm-coalescer
+ * @short_description: Merges redundant modifications of the same task
+ *
+ * #RtmCoalescer holds the modifications of each task for
+ * #RtmCoalescer:window milliseconds since the first one, and then sends
+ * them in push order, one after another. A modification that sets a whole
+ * field of the task, like its name, priority or due date, supersedes a
+ * previous one of the same field not sent yet, which is dropped. Only the
+ * last value is sent, so a user editing a task several times within the
+ * window costs a single call per field.
+ *
+ * The callback of a superseded modification is called with the response of
+ * the call that superseded it. Other modifications, like adding tags or
+ * postponing, are never dropped.
+ *
+ * Modifications are sent in the thread-default main context of the thread
+ * that created the coalescer, so a main loop must be running there, or
+ * rtm_coalescer_wait() must be called. Pending modifications are flushed
+ * when the coalescer is disposed.
+ */
+
+#include <string.h>
+#include <gio/gio.h>
+#include <rtm-coalescer.h>
+#include <rtm-glib-private.h>
+#include <rtm-util.h>
+
+#define RTM_COALESCER_GET_PRIVATE(obj) (G_TYPE_INSTANCE_GET_PRIVATE (       \
+                                           (obj), RTM_TYPE_COALESCER, RtmCoalescerPrivate))
+
+#define RTM_COALESCER_DEFAULT_WINDOW 1000
+
+struct _RtmCoalescerPrivate {
+        RtmGlib *rtm;
+        guint window;
+        GHashTable *tasks;
+        guint n_pending;
+        guint n_sent;
+        guint n_superseded;
+        GMainContext *context;
+};
+
+enum {
+        PROP_0,
+
+        PROP_RTM,
+        PROP_WINDOW,
+};
+
+typedef struct {
+        RtmCoalescerCallback callback;
+        gpointer user_data;
+} RtmCoalescerClosure;
+
+typedef struct {
+        gchar *method;
+        const gchar *field;
+        gchar **params;
+        GSList *closures;
+} RtmCoalescerOp;
+
+typedef struct {
+        RtmCoalescer *coalescer;
+        gchar *key;
+        GQueue *pending;
+        GQueue *sending;
+        GSource *timeout;
+        gboolean flush_wanted;
+} RtmCoalescerTask;
+
+/* Methods setting a whole field of a task, where only the last call counts.
+ * Completing and uncompleting set the same field. */
+static const gchar *rtm_coalescer_fields[][2] = {
+        { "rtm.tasks.setName", "name" },
+        { "rtm.tasks.setURL", "url" },
+        { "rtm.tasks.setTags", "tags" },
+        { "rtm.tasks.setLocation", "location" },
+        { "rtm.tasks.setPriority", "priority" },
+        { "rtm.tasks.complete", "completed" },
+        { "rtm.tasks.uncomplete", "completed" },
+        { "rtm.tasks.setRecurrence", "recurrence" },
+        { "rtm.tasks.setEstimate", "estimate" },
+        { "rtm.tasks.setDueDate", "due" },
+        { NULL, NULL }
+};
+
+G_DEFINE_TYPE (RtmCoalescer, rtm_coalescer, G_TYPE_OBJECT);
+
+static const gchar *
+rtm_coalescer_lookup_field (const gchar *method)
+{
+        guint i;
+
+        for (i = 0; rtm_coalescer_fields[i][0] != NULL; i++) {
+                if (strcmp (rtm_coalescer_fields[i][0], method) == 0) {
+                        return rtm_coalescer_fields[i][1];
+                }
+        }
+
+        return NULL;
+}
+
+static void
+rtm_coalescer_closure_free (RtmCoalescerClosure *closure)
+{
+        g_slice_free (RtmCoalescerClosure, closure);
+}
+
+static void
+rtm_coalescer_op_free (RtmCoalescerOp *op)
+{
+        g_free (op->method);
+        g_strfreev (op->params);
+        g_slist_free_full (op->closures,
+                           (GDestroyNotify) rtm_coalescer_closure_free);
+
+        g_slice_free (RtmCoalescerOp, op);
+}
+
+static void
+rtm_coalescer_task_free (RtmCoalescerTask *task)
+{
+        if (task->timeout) {
+                g_source_destroy (task->timeout);
+                g_source_unref (task->timeout);
+        }
+        g_queue_free_full (task->pending,
+                           (GDestroyNotify) rtm_coalescer_op_free);
+        g_queue_free_full (task->sending,
+                           (GDestroyNotify) rtm_coalescer_op_free);
+        g_free (task->key);
+
+        g_slice_free (RtmCoalescerTask, task);
+}
+
+static void
+rtm_coalescer_get_property (GObject *gobject, guint prop_id, GValue *value,
+                            GParamSpec *pspec)
+{
+        RtmCoalescerPrivate *priv = RTM_COALESCER_GET_PRIVATE (RTM_COALESCER (gobject));
+
+        switch (prop_id) {
+        case PROP_RTM:
+                g_value_set_object (value, priv->rtm);
+                break;
+
+        case PROP_WINDOW:
+                g_value_set_uint (value, priv->window);
+                break;
+
+        default:
+                G_OBJECT_WARN_INVALID_PROPERTY_ID (gobject, prop_id,
+                                                   pspec);
+                break;
+        }
+}
+
+static void
+rtm_coalescer_set_property (GObject *gobject, guint prop_id,
+                            const GValue *value, GParamSpec *pspec)
+{
+        RtmCoalescerPrivate *priv = RTM_COALESCER_GET_PRIVATE (RTM_COALESCER (gobject));
+
+        switch (prop_id) {
+        case PROP_RTM:
+                priv->rtm = g_value_dup_object (value);
+                break;
+
+        case PROP_WINDOW:
+                priv->window = g_value_get_uint (value);
+                break;
+
+        default:
+                G_OBJECT_WARN_INVALID_PROPERTY_ID (gobject, prop_id,
+                                                   pspec);
+                break;
+        }
+}
+
+static void
+rtm_coalescer_dispose (GObject *gobject)
+{
+        RtmCoalescer *coalescer = RTM_COALESCER (gobject);
+        RtmCoalescerPrivate *priv = RTM_COALESCER_GET_PRIVATE (coalescer);
+
+        /* Modifications in flight keep a reference to the coalescer, so
+         * flushing the pending ones keeps it alive until they are sent */
+        if (priv->rtm && g_hash_table_size (priv->tasks) > 0) {
+                rtm_coalescer_flush (coalescer);
+        }
+
+        if (g_hash_table_size (priv->tasks) == 0 && priv->rtm) {
+                g_object_unref (priv->rtm);
+                priv->rtm = NULL;
+        }
+
+        G_OBJECT_CLASS (rtm_coalescer_parent_class)->dispose (gobject);
+}
+
+static void
+rtm_coalescer_finalize (GObject *gobject)
+{
+        RtmCoalescerPrivate *priv = RTM_COALESCER_GET_PRIVATE (RTM_COALESCER (gobject));
+
+        g_hash_table_destroy (priv->tasks);
+        g_main_context_unref (priv->context);
+
+        G_OBJECT_CLASS (rtm_coalescer_parent_class)->finalize (gobject);
+}
+
+static void
+rtm_coalescer_class_init (RtmCoalescerClass *klass)
+{
+        GObjectClass *gobject_class = G_OBJECT_CLASS (klass);
+
+        g_type_class_add_private (klass, sizeof (RtmCoalescerPrivate));
+
+        gobject_class->get_property = rtm_coalescer_get_property;
+        gobject_class->set_property = rtm_coalescer_set_property;
+        gobject_class->dispose = rtm_coalescer_dispose;
+        gobject_class->finalize = rtm_coalescer_finalize;
+
+        g_object_class_install_property (
+                gobject_class,
+                PROP_RTM,
+                g_param_spec_object (
+                        "rtm",
+                        "Rtm",
+                        "The RtmGlib object used to call the methods",
+                        RTM_TYPE_GLIB,
+                        G_PARAM_READWRITE | G_PARAM_CONSTRUCT_ONLY));
+
+        g_object_class_install_property (
+                gobject_class,
+                PROP_WINDOW,
+                g_param_spec_uint (
+                        "window",
+                        "Window",
+                        "Milliseconds the modifications of a task are held",
+                        0,
+                        G_MAXUINT,
+                        RTM_COALESCER_DEFAULT_WINDOW,
+                        G_PARAM_READWRITE | G_PARAM_CONSTRUCT));
+
+}
+
+static void
+rtm_coalescer_init (RtmCoalescer *coalescer)
+{
+        coalescer->priv = RTM_COALESCER_GET_PRIVATE (coalescer);
+
+        coalescer->priv->tasks = g_hash_table_new_full (
+                g_str_hash, g_str_equal,
+                NULL, (GDestroyNotify) rtm_coalescer_task_free);
+        coalescer->priv->context = g_main_context_ref_thread_default ();
+}
+
+/**
+ * rtm_coalescer_new:
+ * @rtm: a #RtmGlib object already authenticated, used to call the methods.
+ * @window: milliseconds the modifications of a task are held.
+ *
+ * Creates a new instance of this class.
+ *
+ * Returns: a new #RtmCoalescer object.
+ */
+RtmCoalescer *
+rtm_coalescer_new (RtmGlib *rtm, guint window)
+{
+        g_return_val_if_fail (rtm != NULL, NULL);
+
+        return g_object_new (RTM_TYPE_COALESCER,
+                             "rtm", rtm,
+                             "window", window,
+                             NULL);
+}
+
+/**
+ * rtm_coalescer_get_window:
+ * @coalescer: a #RtmCoalescer object.
+ *
+ * Gets the time the modifications of a task are held.
+ *
+ * Returns: the window in milliseconds.
+ */
+guint
+rtm_coalescer_get_window (RtmCoalescer *coalescer)
+{
+        g_return_val_if_fail (coalescer != NULL, 0);
+
+        return coalescer->priv->window;
+}
+
+/**
+ * rtm_coalescer_set_window:
+ * @coalescer: a #RtmCoalescer object.
+ * @window: milliseconds the modifications of a task are held.
+ *
+ * Sets the time the modifications of a task are held, since the first one
+ * pushed. Tasks already waiting are not affected. With 0, they are sent from
+ * the next iteration of the main context.
+ */
+void
+rtm_coalescer_set_window (RtmCoalescer *coalescer, guint window)
+{
+        g_return_if_fail (coalescer != NULL);
+
+        g_object_set (coalescer, "window", window, NULL);
+}
+
+static void
+rtm_coalescer_send_next (RtmCoalescerTask *task);
+
+/**
+ * rtm_coalescer_flush_task:
+ * @task: a #RtmCoalescerTask.
+ *
+ * Sends the pending modifications of @task, once the ones already being
+ * sent are done.
+ */
+static void
+rtm_coalescer_flush_task (RtmCoalescerTask *task)
+{
+        GQueue *batch;
+
+        if (task->timeout) {
+                g_source_destroy (task->timeout);
+                g_source_unref (task->timeout);
+                task->timeout = NULL;
+        }
+
+        if (!g_queue_is_empty (task->sending)) {
+                task->flush_wanted = TRUE;
+                return;
+        }
+        task->flush_wanted = FALSE;
+
+        batch = task->sending;
+        task->sending = task->pending;
+        task->pending = batch;
+
+        rtm_coalescer_send_next (task);
+}
+
+static void
+rtm_coalescer_call_cb (GObject *source_object, GAsyncResult *result,
+                       gpointer user_data)
+{
+        RtmCoalescerTask *task = user_data;
+        RtmCoalescer *coalescer = task->coalescer;
+        RtmCoalescerOp *op;
+        RtmCoalescerClosure *closure;
+        RestXmlNode *root;
+        GSList *item;
+        GError *error = NULL;
+
+        root = rtm_glib_call_method_finish (RTM_GLIB (source_object), result,
+                                            &error);
+
+        op = g_queue_pop_head (task->sending);
+
+        DEBUG_PRINT ("rtm_coalescer: %s finished for %s", op->method,
+                     task->key);
+
+        /* The closures were prepended, the first pushed is the last one */
+        op->closures = g_slist_reverse (op->closures);
+        for (item = op->closures; item; item = item->next) {
+                closure = item->data;
+                coalescer->priv->n_pending--;
+                closure->callback (coalescer, op->method, root, error,
+                                   closure->user_data);
+        }
+
+        if (root != NULL) {
+                rest_xml_node_unref (root);
+        }
+        if (error != NULL) {
+                g_error_free (error);
+        }
+        rtm_coalescer_op_free (op);
+
+        rtm_coalescer_send_next (task);
+
+        g_object_unref (coalescer);
+}
+
+/**
+ * rtm_coalescer_send_next:
+ * @task: a #RtmCoalescerTask.
+ *
+ * Sends the next modification of @task being flushed. Once all of them are
+ * done, the pending ones are flushed if their window is over, and @task is
+ * forgotten if nothing is left.
+ */
+static void
+rtm_coalescer_send_next (RtmCoalescerTask *task)
+{
+        RtmCoalescerPrivate *priv = task->coalescer->priv;
+        RtmCoalescerOp *op;
+
+        op = g_queue_peek_head (task->sending);
+        if (op == NULL) {
+                if (task->flush_wanted) {
+                        rtm_coalescer_flush_task (task);
+                } else if (g_queue_is_empty (task->pending)) {
+                        g_hash_table_remove (priv->tasks, task->key);
+                }
+                return;
+        }
+
+        priv->n_sent++;
+
+        rtm_glib_call_method_params_async (priv->rtm, op->method, op->params,
+                                           NULL, rtm_coalescer_call_cb,
+                                           task);
+        g_object_ref (task->coalescer);
+}
+
+static gboolean
+rtm_coalescer_window_cb (gpointer user_data)
+{
+        RtmCoalescerTask *task = user_data;
+
+        g_source_unref (task->timeout);
+        task->timeout = NULL;
+
+        rtm_coalescer_flush_task (task);
+
+        return FALSE;
+}
+
+/**
+ * rtm_coalescer_push_params:
+ * @coalescer: a #RtmCoalescer object.
+ * @method: the method name to be called.
+ * @task: the #RtmTask modified.
+ * @params: %NULL-terminated array alternating names and values, already
+ * including the task identifiers.
+ * @callback: a #RtmCoalescerCallback called with the result.
+ * @user_data: the data to pass to callback function.
+ *
+ * Holds a modification of @task, superseding a pending one of the same
+ * field. Takes ownership of @params.
+ */
+static void
+rtm_coalescer_push_params (RtmCoalescer *coalescer, const gchar *method,
+                           RtmTask *task, gchar **params,
+                           RtmCoalescerCallback callback, gpointer user_data)
+{
+        RtmCoalescerPrivate *priv = coalescer->priv;
+        RtmCoalescerTask *coalesced;
+        RtmCoalescerOp *op, *old_op;
+        RtmCoalescerClosure *closure;
+        GList *item;
+        gchar *key;
+
+        /* The list changes when the task is moved */
+        key = g_strdup_printf ("%s/%s", rtm_task_get_taskseries_id (task),
+                               rtm_task_get_id (task));
+
+        coalesced = g_hash_table_lookup (priv->tasks, key);
+        if (coalesced == NULL) {
+                coalesced = g_slice_new0 (RtmCoalescerTask);
+                coalesced->coalescer = coalescer;
+                coalesced->key = key;
+                coalesced->pending = g_queue_new ();
+                coalesced->sending = g_queue_new ();
+                g_hash_table_insert (priv->tasks, coalesced->key, coalesced);
+        } else {
+                g_free (key);
+        }
+
+        closure = g_slice_new0 (RtmCoalescerClosure);
+        closure->callback = callback;
+        closure->user_data = user_data;
+
+        op = g_slice_new0 (RtmCoalescerOp);
+        op->method = g_strdup (method);
+        op->field = rtm_coalescer_lookup_field (method);
+        op->params = params;
+        op->closures = g_slist_prepend (NULL, closure);
+
+        /* Drop the previous value of the same field, its callbacks get the
+         * result of the new one */
+        if (op->field != NULL) {
+                for (item = coalesced->pending->head; item; item = item->next) {
+                        old_op = item->data;
+                        if (g_strcmp0 (old_op->field, op->field) == 0) {
+                                DEBUG_PRINT ("rtm_coalescer: %s supersedes "
+                                             "%s for %s", method,
+                                             old_op->method, coalesced->key);
+                                op->closures = g_slist_concat (
+                                        op->closures, old_op->closures);
+                                old_op->closures = NULL;
+                                g_queue_delete_link (coalesced->pending, item);
+                                rtm_coalescer_op_free (old_op);
+                                priv->n_superseded++;
+                                break;
+                        }
+                }
+        }
+
+        g_queue_push_tail (coalesced->pending, op);
+        priv->n_pending++;
+
+        if (coalesced->timeout == NULL && !coalesced->flush_wanted) {
+                coalesced->timeout = g_timeout_source_new (priv->window);
+                g_source_set_callback (coalesced->timeout,
+                                       rtm_coalescer_window_cb, coalesced,
+                                       NULL);
+                g_source_attach (coalesced->timeout, priv->context);
+        }
+}
+
+/**
+ * rtm_coalescer_build_params:
+ * @coalescer: a #RtmCoalescer object.
+ * @timeline: the timeline within which to run the method.
+ * @task: the #RtmTask modified.
+ * @args: list of parameters (pairs of name and value) terminated by %NULL.
+ *
+ * Builds the parameters of a modification of @task.
+ *
+ * Returns: a %NULL-terminated array alternating names and values.
+ */
+static gchar **
+rtm_coalescer_build_params (RtmCoalescer *coalescer, const gchar *timeline,
+                            RtmTask *task, va_list args)
+{
+        GPtrArray *params;
+        gchar *auth_token = NULL;
+        gchar **extra;
+        guint i;
+
+        g_object_get (coalescer->priv->rtm, "auth_token", &auth_token, NULL);
+
+        params = g_ptr_array_new ();
+        g_ptr_array_add (params, g_strdup ("auth_token"));
+        g_ptr_array_add (params, auth_token);
+        g_ptr_array_add (params, g_strdup ("timeline"));
+        g_ptr_array_add (params, g_strdup (timeline));
+        g_ptr_array_add (params, g_strdup ("list_id"));
+        g_ptr_array_add (params, g_strdup (rtm_task_get_list_id (task)));
+        g_ptr_array_add (params, g_strdup ("taskseries_id"));
+        g_ptr_array_add (params, g_strdup (rtm_task_get_taskseries_id (task)));
+        g_ptr_array_add (params, g_strdup ("task_id"));
+        g_ptr_array_add (params, g_strdup (rtm_task_get_id (task)));
+
+        extra = rtm_glib_collect_params (args);
+        for (i = 0; extra[i] != NULL; i++) {
+                g_ptr_array_add (params, extra[i]);
+        }
+        g_free (extra);
+
+        g_ptr_array_add (params, NULL);
+
+        return (gchar **) g_ptr_array_free (params, FALSE);
+}
+
+static void
+rtm_coalescer_push_valist (RtmCoalescer *coalescer, const gchar *method,
+                           gchar *timeline, RtmTask *task,
+                           RtmCoalescerCallback callback, gpointer user_data,
+                           va_list args)
+{
+        gchar **params;
+
+        params = rtm_coalescer_build_params (coalescer, timeline, task, args);
+        rtm_coalescer_push_params (coalescer, method, task, params, callback,
+                                   user_data);
+}
+
+static void
+rtm_coalescer_push_internal (RtmCoalescer *coalescer, const gchar *method,
+                             gchar *timeline, RtmTask *task,
+                             RtmCoalescerCallback callback,
+                             gpointer user_data, ...)
+{
+        va_list args;
+
+        va_start (args, user_data);
+        rtm_coalescer_push_valist (coalescer, method, timeline, task,
+                                   callback, user_data, args);
+        va_end (args);
+}
+
+/**
+ * rtm_coalescer_push:
+ * @coalescer: a #RtmCoalescer object.
+ * @method: the method name to be called.
+ * @timeline: the timeline within which to run the method.
+ * @task: the #RtmTask modified.
+ * @callback: a #RtmCoalescerCallback called with the result.
+ * @user_data: the data to pass to callback function.
+ * @Varargs: list of parameters (pairs of name and value) terminated by %NULL.
+ *
+ * Holds a modification of @task with the arguments passed. The method name
+ * and parameters are the same ones the web service expects; the auth_token,
+ * timeline and task identifiers are added and a format parameter is ignored.
+ */
+void
+rtm_coalescer_push (RtmCoalescer *coalescer, const gchar *method,
+                    gchar *timeline, RtmTask *task,
+                    RtmCoalescerCallback callback, gpointer user_data, ...)
+{
+        g_return_if_fail (coalescer != NULL);
+        g_return_if_fail (method != NULL);
+        g_return_if_fail (timeline != NULL);
+        g_return_if_fail (task != NULL);
+        g_return_if_fail (callback != NULL);
+
+        va_list args;
+
+        va_start (args, user_data);
+        rtm_coalescer_push_valist (coalescer, method, timeline, task,
+                                   callback, user_data, args);
+        va_end (args);
+}
+
+/**
+ * rtm_coalescer_set_name:
+ * @coalescer: a #RtmCoalescer object.
+ * @timeline: the timeline within which to run the method.
+ * @task: a #RtmTask to be modified with the new name.
+ * @name: the desired name.
+ * @callback: a #RtmCoalescerCallback called with the result.
+ * @user_data: the data to pass to callback function.
+ *
+ * Renames a task, like rtm_glib_tasks_set_name(), once the window is over.
+ */
+void
+rtm_coalescer_set_name (RtmCoalescer *coalescer, gchar *timeline,
+                        RtmTask *task, gchar *name,
+                        RtmCoalescerCallback callback, gpointer user_data)
+{
+        g_return_if_fail (coalescer != NULL);
+        g_return_if_fail (timeline != NULL);
+        g_return_if_fail (task != NULL);
+        g_return_if_fail (name != NULL);
+        g_return_if_fail (callback != NULL);
+
+        rtm_coalescer_push_internal (coalescer, "rtm.tasks.setName", timeline,
+                                     task, callback, user_data,
+                                     "name", name,
+                                     NULL);
+}
+
+/**
+ * rtm_coalescer_set_priority:
+ * @coalescer: a #RtmCoalescer object.
+ * @timeline: the timeline within which to run the method.
+ * @task: a #RtmTask to be modified with the new priority.
+ * @priority: The desired priority of a task.
+ * @callback: a #RtmCoalescerCallback called with the result.
+ * @user_data: the data to pass to callback function.
+ *
+ * Sets the priority of a task, like rtm_glib_tasks_set_priority(), once the
+ * window is over.
+ */
+void
+rtm_coalescer_set_priority (RtmCoalescer *coalescer, gchar *timeline,
+                            RtmTask *task, gchar *priority,
+                            RtmCoalescerCallback callback, gpointer user_data)
+{
+        g_return_if_fail (coalescer != NULL);
+        g_return_if_fail (timeline != NULL);
+        g_return_if_fail (task != NULL);
+        g_return_if_fail (callback != NULL);
+
+        if (priority == NULL) {
+                priority = "";
+        }
+
+        rtm_coalescer_push_internal (coalescer, "rtm.tasks.setPriority",
+                                     timeline, task, callback, user_data,
+                                     "priority", priority,
+                                     NULL);
+}
+
+/**
+ * rtm_coalescer_set_due_date:
+ * @coalescer: a #RtmCoalescer object.
+ * @timeline: the timeline within which to run the method.
+ * @task: a #RtmTask to be modified with the new due date.
+ * @due: Due date for a task, in ISO 8601 format.
+ * @has_due_time: Specifies whether the due date has a due time.
+ * @parse: Specifies whether to parse due as per rtm.time.parse.
+ * @callback: a #RtmCoalescerCallback called with the result.
+ * @user_data: the data to pass to callback function.
+ *
+ * Sets the due date of a task, like rtm_glib_tasks_set_due_date(), once the
+ * window is over.
+ */
+void
+rtm_coalescer_set_due_date (RtmCoalescer *coalescer, gchar *timeline,
+                            RtmTask *task, gchar *due, gboolean has_due_time,
+                            gboolean parse, RtmCoalescerCallback callback,
+                            gpointer user_data)
+{
+        g_return_if_fail (coalescer != NULL);
+        g_return_if_fail (timeline != NULL);
+        g_return_if_fail (task != NULL);
+        g_return_if_fail (callback != NULL);
+
+        if (due == NULL) {
+                due = "";
+        }
+
+        rtm_coalescer_push_internal (coalescer, "rtm.tasks.setDueDate",
+                                     timeline, task, callback, user_data,
+                                     "due", due,
+                                     "has_due_time", has_due_time ? "1" : "0",
+                                     "parse", parse ? "1" : "0",
+                                     NULL);
+}
+
+/**
+ * rtm_coalescer_flush:
+ * @coalescer: a #RtmCoalescer object.
+ *
+ * Sends the pending modifications of every task right away, without waiting
+ * for the end of their window.
+ */
+void
+rtm_coalescer_flush (RtmCoalescer *coalescer)
+{
+        g_return_if_fail (coalescer != NULL);
+
+        GList *tasks, *item;
+
+        /* Flushing can forget tasks with nothing left */
+        tasks = g_hash_table_get_values (coalescer->priv->tasks);
+        for (item = tasks; item; item = item->next) {
+                rtm_coalescer_flush_task (item->data);
+        }
+        g_list_free (tasks);
+}
+
+/**
+ * rtm_coalescer_get_n_pending:
+ * @coalescer: a #RtmCoalescer object.
+ *
+ * Gets the number of modifications whose callback has not been called yet.
+ *
+ * Returns: the number of modifications held or being sent.
+ */
+guint
+rtm_coalescer_get_n_pending (RtmCoalescer *coalescer)
+{
+        g_return_val_if_fail (coalescer != NULL, 0);
+
+        return coalescer->priv->n_pending;
+}
+
+/**
+ * rtm_coalescer_get_n_sent:
+ * @coalescer: a #RtmCoalescer object.
+ *
+ * Gets the number of calls sent by @coalescer.
+ *
+ * Returns: the number of calls sent.
+ */
+guint
+rtm_coalescer_get_n_sent (RtmCoalescer *coalescer)
+{
+        g_return_val_if_fail (coalescer != NULL, 0);
+
+        return coalescer->priv->n_sent;
+}
+
+/**
+ * rtm_coalescer_get_n_superseded:
+ * @coalescer: a #RtmCoalescer object.
+ *
+ * Gets the number of modifications dropped because a later one of the same
+ * field superseded them.
+ *
+ * Returns: the number of calls saved.
+ */
+guint
+rtm_coalescer_get_n_superseded (RtmCoalescer *coalescer)
+{
+        g_return_val_if_fail (coalescer != NULL, 0);
+
+        return coalescer->priv->n_superseded;
+}
+
+/**
+ * rtm_coalescer_wait:
+ * @coalescer: a #RtmCoalescer object.
+ *
+ * Flushes the pending modifications and runs the main context of
+ * @coalescer until the callback of every modification pushed has been
+ * called. Useful for programs without a main loop.
+ */
+void
+rtm_coalescer_wait (RtmCoalescer *coalescer)
+{
+        g_return_if_fail (coalescer != NULL);
+
+        g_object_ref (coalescer);
+        rtm_coalescer_flush (coalescer);
+        while (rtm_coalescer_get_n_pending (coalescer) > 0) {
+                g_main_context_iteration (coalescer->priv->context, TRUE);
+        }
+        g_object_unref (coalescer);
+}
@@ -0,0 +1,130 @@
+/*
+ * rtm-coalescer.h: Merges redundant modifications of the same task
+ *
+ * Copyright (C) 2009 Manuel Rego Casasnovas <mrego@igalia.com>
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301 USA
+ */
+
+#ifndef __RTM_COALESCER_H__
+#define __RTM_COALESCER_H__
+
+#include <glib-object.h>
+#include <rest/rest-xml-parser.h>
+#include <rtm-glib/rtm-glib.h>
+#include <rtm-glib/rtm-task.h>
+
+
+G_BEGIN_DECLS
+
+#define RTM_TYPE_COALESCER (rtm_coalescer_get_type ())
+#define RTM_COALESCER(obj)                                                  \
+        (G_TYPE_CHECK_INSTANCE_CAST ((obj), RTM_TYPE_COALESCER, RtmCoalescer))
+#define RTM_IS_COALESCER(obj)                                       \
+        (G_TYPE_CHECK_INSTANCE_TYPE ((obj), RTM_TYPE_COALESCER))
+#define RTM_COALESCER_CLASS(klass)                                          \
+        (G_TYPE_CHECK_CLASS_CAST ((klass), RTM_TYPE_COALESCER, RtmCoalescerClass))
+#define RTM_IS_COALESCER_CLASS(klass)                               \
+        (G_TYPE_CHECK_CLASS_TYPE ((klass), RTM_TYPE_COALESCER))
+#define RTM_COALESCER_GET_CLASS(obj)                                        \
+        (G_TYPE_INSTANCE_GET_CLASS ((obj), RTM_TYPE_COALESCER, RtmCoalescerClass))
+
+typedef struct _RtmCoalescer RtmCoalescer;
+typedef struct _RtmCoalescerClass RtmCoalescerClass;
+typedef struct _RtmCoalescerPrivate RtmCoalescerPrivate;
+
+struct _RtmCoalescer {
+        GObject parent_instance;
+
+        /*< private >*/
+        RtmCoalescerPrivate *priv;
+};
+
+struct _RtmCoalescerClass {
+        GObjectClass parent_class;
+};
+
+/**
+ * RtmCoalescerCallback:
+ * @coalescer: the #RtmCoalescer.
+ * @method: the method name that was sent, which can be a later one that
+ * superseded the one pushed.
+ * @root: the #RestXmlNode with the method response, or %NULL on error. It is
+ * only valid during the callback, use rest_xml_node_ref() to keep it.
+ * @error: the #GError if the call failed, or %NULL.
+ * @user_data: the data passed when the modification was pushed.
+ *
+ * Called once for each modification pushed, when the call that applied it
+ * finishes.
+ */
+typedef void (*RtmCoalescerCallback) (RtmCoalescer *coalescer,
+                                      const gchar *method,
+                                      RestXmlNode *root,
+                                      const GError *error,
+                                      gpointer user_data);
+
+GType
+rtm_coalescer_get_type (void) G_GNUC_CONST;
+
+RtmCoalescer *
+rtm_coalescer_new (RtmGlib *rtm, guint window);
+
+guint
+rtm_coalescer_get_window (RtmCoalescer *coalescer);
+
+void
+rtm_coalescer_set_window (RtmCoalescer *coalescer, guint window);
+
+void
+rtm_coalescer_push (RtmCoalescer *coalescer, const gchar *method,
+                    gchar *timeline, RtmTask *task,
+                    RtmCoalescerCallback callback, gpointer user_data,
+                    ...) G_GNUC_NULL_TERMINATED;
+
+void
+rtm_coalescer_set_name (RtmCoalescer *coalescer, gchar *timeline,
+                        RtmTask *task, gchar *name,
+                        RtmCoalescerCallback callback, gpointer user_data);
+
+void
+rtm_coalescer_set_priority (RtmCoalescer *coalescer, gchar *timeline,
+                            RtmTask *task, gchar *priority,
+                            RtmCoalescerCallback callback,
+                            gpointer user_data);
+
+void
+rtm_coalescer_set_due_date (RtmCoalescer *coalescer, gchar *timeline,
+                            RtmTask *task, gchar *due, gboolean has_due_time,
+                            gboolean parse, RtmCoalescerCallback callback,
+                            gpointer user_data);
+
+void
+rtm_coalescer_flush (RtmCoalescer *coalescer);
+
+guint
+rtm_coalescer_get_n_pending (RtmCoalescer *coalescer);
+
+guint
+rtm_coalescer_get_n_sent (RtmCoalescer *coalescer);
+
+guint
+rtm_coalescer_get_n_superseded (RtmCoalescer *coalescer);
+
+void
+rtm_coalescer_wait (RtmCoalescer *coalescer);
+
+G_END_DECLS
+
+#endif /* __RTM_COALESCER_H__ */
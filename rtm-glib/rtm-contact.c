@@ -28,6 +28,7 @@
 #include <rtm-contact.h>
 #include <rtm-util.h>
 #include <rtm-error.h>
+#include <rtm-attributes.h>
 
 #define RTM_CONTACT_GET_PRIVATE(obj) (G_TYPE_INSTANCE_GET_PRIVATE (        \
                                               (obj), RTM_TYPE_CONTACT, RtmContactPrivate))
@@ -46,6 +47,23 @@ enum {
         PROP_FULLNAME,
 };
 
+/* Attributes of the contact element, in the order of rtm_contact_attribute_names */
+enum {
+        ATTRIBUTE_ID,
+        ATTRIBUTE_USERNAME,
+        ATTRIBUTE_FULLNAME,
+};
+
+static const gchar * const rtm_contact_attribute_names[] = {
+        "id",
+        "username",
+        "fullname",
+        NULL
+};
+
+static RtmAttributes rtm_contact_attributes =
+        RTM_ATTRIBUTES_INIT (rtm_contact_attribute_names);
+
 G_DEFINE_TYPE (RtmContact, rtm_contact, G_TYPE_OBJECT);
 
 static void
@@ -301,6 +319,27 @@ rtm_contact_set_fullname (RtmContact *contact, const gchar* fullname)
         return TRUE;
 }
 
+static void
+rtm_contact_set_attribute (RtmContact *contact, gint id, const gchar *value)
+{
+        RtmContactPrivate *priv = contact->priv;
+
+        switch (id) {
+        case ATTRIBUTE_ID:
+                g_free (priv->id);
+                priv->id = g_strdup (value);
+                break;
+        case ATTRIBUTE_USERNAME:
+                g_free (priv->username);
+                priv->username = g_strdup (value);
+                break;
+        case ATTRIBUTE_FULLNAME:
+                g_free (priv->fullname);
+                priv->fullname = g_strdup (value);
+                break;
+        }
+}
+
 /**
  * rtm_contact_load_data:
  * @contact: a #RtmContact.
@@ -315,9 +354,30 @@ rtm_contact_load_data (RtmContact *contact, RestXmlNode *node)
         g_return_if_fail (contact != NULL);
         g_return_if_fail (node != NULL);
 
-        rtm_contact_set_id (contact, rest_xml_node_get_attr (node, "id"));
-        rtm_contact_set_username (contact, rest_xml_node_get_attr (node, "username"));
-        rtm_contact_set_fullname (contact, rest_xml_node_get_attr (node, "fullname"));
+        rtm_attributes_load_node (&rtm_contact_attributes, node,
+                                  (RtmAttributesSetFunc) rtm_contact_set_attribute,
+                                  contact);
+}
+
+/**
+ * rtm_contact_load_attribute:
+ * @contact: a #RtmContact.
+ * @name: the name of an attribute of the contact element.
+ * @value: the value of the attribute.
+ *
+ * Sets one field of the #RtmContact object, as found in a response. Unknown
+ * attributes are ignored.
+ */
+void
+rtm_contact_load_attribute (RtmContact *contact, const gchar *name,
+                            const gchar *value)
+{
+        g_return_if_fail (contact != NULL);
+        g_return_if_fail (name != NULL);
+
+        rtm_contact_set_attribute (
+                contact, rtm_attributes_lookup (&rtm_contact_attributes, name),
+                value);
 }
 
 /**
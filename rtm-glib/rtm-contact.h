@@ -80,6 +80,10 @@ rtm_contact_set_fullname (RtmContact *contact, const gchar* fullname);
 void
 rtm_contact_load_data (RtmContact *contact, RestXmlNode *node);
 
+void
+rtm_contact_load_attribute (RtmContact *contact, const gchar *name,
+                            const gchar *value);
+
 gchar *
 rtm_contact_to_string (RtmContact *contact);
 
@@ -68,3 +68,63 @@ rtm_get_error_quark (void)
 
         return quark;
 }
+
+/**
+ * rtm_error_from_service_code:
+ * @code: the error code of a failed response from Remember The Milk.
+ *
+ * Maps the error codes of the web service to #RtmError codes.
+ *
+ * Returns: The #RtmError for @code.
+ */
+RtmError
+rtm_error_from_service_code (gint code)
+{
+        switch (code) {
+        case 96:        /* Invalid signature */
+        case 97:        /* Missing signature */
+                return RTM_ERROR_INVALID_SIGNATURE;
+
+        case 98:        /* Login failed / Invalid auth token */
+                return RTM_ERROR_LOGIN_FAILED;
+
+        case 100:       /* Invalid API Key */
+                return RTM_ERROR_INVALID_API_KEY;
+
+        case 101:       /* Invalid frob - did you authenticate? */
+                return RTM_ERROR_INVALID_FROB;
+
+        case 105:       /* Service currently unavailable */
+                return RTM_ERROR_SERVICE_UNAVAILABLE;
+
+        default:
+                return RTM_ERROR_RESPONSE_FAIL;
+        }
+}
+
+/**
+ * rtm_error_is_transient:
+ * @err: a #GError.
+ *
+ * Checks if the error is caused by a temporary condition, so the same call
+ * could succeed if it is sent again later.
+ *
+ * Returns: %TRUE if @err is a transient error.
+ */
+gboolean
+rtm_error_is_transient (const GError *err)
+{
+        if (err == NULL || err->domain != RTM_ERROR_DOMAIN) {
+                return FALSE;
+        }
+
+        switch (err->code) {
+        case RTM_ERROR_NETWORK:
+        case RTM_ERROR_TIMED_OUT:
+        case RTM_ERROR_SERVICE_UNAVAILABLE:
+                return TRUE;
+
+        default:
+                return FALSE;
+        }
+}
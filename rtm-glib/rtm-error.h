@@ -31,6 +31,10 @@
  * _RtmError:
  *
  * A #GError error code.
+ *
+ * Failed responses from Remember The Milk without a more specific code are
+ * reported as %RTM_ERROR_RESPONSE_FAIL. In every case the message starts
+ * with the numeric error code of the service.
  */
 enum _RtmError
 {
@@ -40,6 +44,13 @@ enum _RtmError
         RTM_TASK_NOT_FOUND,
         RTM_TAG_ALREADY_ASSIGNED,
         RTM_TAG_NOT_FOUND,
+        RTM_ERROR_NETWORK,
+        RTM_ERROR_TIMED_OUT,
+        RTM_ERROR_SERVICE_UNAVAILABLE,
+        RTM_ERROR_INVALID_SIGNATURE,
+        RTM_ERROR_LOGIN_FAILED,
+        RTM_ERROR_INVALID_API_KEY,
+        RTM_ERROR_INVALID_FROB,
 };
 
 typedef enum _RtmError RtmError;
@@ -53,5 +64,11 @@ rtm_error_get_code (GError *err);
 GQuark
 rtm_get_error_quark (void);
 
+RtmError
+rtm_error_from_service_code (gint code);
+
+gboolean
+rtm_error_is_transient (const GError *err);
+
 
 #endif
@@ -0,0 +1,140 @@
+/*
+ * rtm-glib-private.h: API Library internal methods
+ *
+ * Copyright (C) 2009 Manuel Rego Casasnovas <mrego@igalia.com>
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301 USA
+ */
+
+#ifndef __RTM_GLIB_PRIVATE_H__
+#define __RTM_GLIB_PRIVATE_H__
+
+#include <stdarg.h>
+#include <glib-object.h>
+#include <gio/gio.h>
+#include <rest/rest-xml-parser.h>
+#include <rtm-glib/rtm-glib.h>
+#include <rtm-glib/rtm-method-stats.h>
+#include <rtm-glib/rtm-request.h>
+
+
+G_BEGIN_DECLS
+
+/* Private methods headers, not installed */
+gboolean
+rtm_glib_check_response (RtmGlib *rtm, RestXmlNode *root, GError **error);
+
+void
+rtm_glib_set_response_error (GError **error, const gchar *error_code,
+                             const gchar *error_msg);
+
+void
+rtm_glib_sign_params (RtmGlib *rtm, const gchar *method, gchar **params,
+                      RtmSignedParams *signed_params);
+
+void
+rtm_glib_presign (RtmGlib *rtm, gchar **methods, gchar ***params,
+                  RtmSignature *signatures, guint n);
+
+RestXmlNode *
+rtm_glib_call_method (RtmGlib *rtm, gchar *method, GError **error, ...);
+
+void
+rtm_glib_call_method_async (RtmGlib *rtm, gchar *method,
+                            GCancellable *cancellable,
+                            GAsyncReadyCallback callback, gpointer user_data,
+                            ...);
+
+void
+rtm_glib_call_method_params_async (RtmGlib *rtm, const gchar *method,
+                                   gchar **params, GCancellable *cancellable,
+                                   GAsyncReadyCallback callback,
+                                   gpointer user_data);
+
+void
+rtm_glib_call_method_signed_async (RtmGlib *rtm, const gchar *method,
+                                   gchar **params, RtmSignature *signature,
+                                   GCancellable *cancellable,
+                                   GAsyncReadyCallback callback,
+                                   gpointer user_data);
+
+RestXmlNode *
+rtm_glib_call_method_finish (RtmGlib *rtm, GAsyncResult *result,
+                             GError **error);
+
+GBytes *
+rtm_glib_call_method_json (RtmGlib *rtm, gchar *method, GError **error, ...);
+
+void
+rtm_glib_call_method_json_async (RtmGlib *rtm, gchar *method,
+                                 GCancellable *cancellable,
+                                 GAsyncReadyCallback callback,
+                                 gpointer user_data, ...);
+
+GBytes *
+rtm_glib_call_method_json_finish (RtmGlib *rtm, GAsyncResult *result,
+                                  GError **error);
+
+gboolean
+rtm_glib_call_method_is_json (GAsyncResult *result);
+
+gchar **
+rtm_glib_collect_params (va_list params);
+
+RestXmlNode *
+rtm_glib_parse_response (RtmGlib *rtm, GBytes *payload, GError **error);
+
+void
+rtm_task_copy_series (RtmTask *task, RtmTask *series);
+
+void
+rtm_task_set_lazy (RtmTask *task, gboolean lazy);
+
+RtmTaskBatch *
+rtm_task_batch_new (void);
+
+void
+rtm_task_batch_begin_series (RtmTaskBatch *batch);
+
+void
+rtm_task_batch_begin_task (RtmTaskBatch *batch);
+
+void
+rtm_task_batch_load_attribute (RtmTaskBatch *batch, const gchar *element,
+                               const gchar *name, const gchar *value);
+
+void
+rtm_task_batch_end_series (RtmTaskBatch *batch);
+
+void
+rtm_task_batch_set_list_id (RtmTaskBatch *batch, guint first,
+                            const gchar *list_id);
+
+RtmMethodStats *
+rtm_method_stats_new (const gchar *method);
+
+void
+rtm_method_stats_add_call (RtmMethodStats *stats, gboolean failed);
+
+void
+rtm_method_stats_add_latency (RtmMethodStats *stats, RtmMethodPhase phase,
+                              gint64 latency);
+
+void
+rtm_method_stats_add_payload_size (RtmMethodStats *stats, gsize size);
+
+G_END_DECLS
+
+#endif /* __RTM_GLIB_PRIVATE_H__ */
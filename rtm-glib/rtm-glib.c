@@ -23,20 +23,39 @@
  * @short_description: API library for Remember The Milk
  *
  * API library to acces Remember The Milk web service
+ *
+ * Each attempt of a call waits at most #RtmGlib:timeout seconds for the
+ * response. The asynchronous methods take a #GCancellable. The synchronous
+ * ones use the cancellable pushed with g_cancellable_push_current() in the
+ * calling thread, if any, so they can be interrupted from another thread.
+ *
+ * One #RtmGlib can be shared by several threads, for example by the workers
+ * of a #GThreadPool, which can call any method concurrently once it is
+ * authenticated. The properties and the transport should be set before
+ * sharing it. The asynchronous methods return in the thread-default main
+ * context of the caller. #RtmRestTransport runs the HTTP sessions in the
+ * default main context, which must be free or iterated by some thread,
+ * unless #RtmGlib:io_thread is set. A #RtmRequestQueue must only be used
+ * from one thread.
  */
 
 #include <glib-object.h>
 #include <string.h>
-#include <rest/rest-proxy.h>
 #include <rest/rest-xml-parser.h>
 #include <rtm-glib.h>
+#include <rtm-glib-private.h>
 #include <rtm-error.h>
+#include <rtm-json.h>
 #include <rtm-location.h>
+#include <rtm-rate-limiter.h>
+#include <rtm-request.h>
+#include <rtm-rest-transport.h>
+#include <rtm-task-parser.h>
 #include <rtm-time-zone.h>
+#include <rtm-timeout.h>
 #include <rtm-util.h>
 
 
-#define RTM_URL "http://api.rememberthemilk.com/services/rest/"
 #define RTM_URL_AUTH "http://www.rememberthemilk.com/services/auth/"
 
 
@@ -319,13 +338,79 @@
 #define RTM_METHOD_CONTACTS_DELETE "rtm.contacts.delete"
 
 
+/* Methods without side effects, safe to be sent again after a failure */
+static const gchar *rtm_glib_read_methods[] = {
+        RTM_METHOD_TEST_ECHO,
+        RTM_METHOD_TEST_LOGIN,
+        RTM_METHOD_AUTH_GET_FROB,
+        RTM_METHOD_AUTH_CHECK_TOKEN,
+        RTM_METHOD_LISTS_GET_LIST,
+        RTM_METHOD_TASKS_GET_LIST,
+        RTM_METHOD_LOCATIONS_GET_LIST,
+        RTM_METHOD_TIME_ZONES_GET_LIST,
+        RTM_METHOD_TIME_PARSE,
+        RTM_METHOD_TIME_CONVERT,
+        RTM_METHOD_CONTACTS_GET_LIST,
+        NULL
+};
+
+/* Methods with large responses, which their dedicated entry points keep as
+   they are read to be parsed without building a tree */
+static const gchar *rtm_glib_streamed_methods[] = {
+        RTM_METHOD_TASKS_GET_LIST,
+        NULL
+};
+
+/* Default retry policy */
+#define RTM_GLIB_DEFAULT_MAX_RETRIES 3
+#define RTM_GLIB_DEFAULT_RETRY_BASE_DELAY 500
+#define RTM_GLIB_DEFAULT_RETRY_MAX_DELAY 8000
+
+/* Default time limit of each attempt, in seconds */
+#define RTM_GLIB_DEFAULT_TIMEOUT 30
+
+
 #define RTM_GLIB_GET_PRIVATE(obj) (G_TYPE_INSTANCE_GET_PRIVATE (        \
                                            (obj), RTM_TYPE_GLIB, RtmGlibPrivate))
 
+/*
+ * Stands for the auth token of the #RtmGlib in the parameters of the calls
+ * made by its methods. It is replaced by a copy of the current token when
+ * the parameters are collected, so another thread can set a new one.
+ */
+static const gchar rtm_glib_auth_token_placeholder[] = "auth_token";
+#define RTM_GLIB_AUTH_TOKEN rtm_glib_auth_token_placeholder
+
+/*
+ * The mutex guards the credentials, the transport, the calls in flight, the
+ * templates to sign them and the keep-alive pings. The credentials are
+ * copied under the lock by each call that needs them. The condition is
+ * signalled when a synchronous call in flight lands.
+ */
 struct _RtmGlibPrivate {
         gchar *api_key;
         gchar *shared_secret;
         gchar *auth_token;
+        GMutex mutex;
+        RtmTransport *transport;
+        gboolean own_transport;
+        GMainContext *io_context;
+        GMainLoop *io_loop;
+        GThread *io_thread;
+        gint64 last_send_time;
+        guint keepalive;
+        GSource *keepalive_source;
+        guint max_retries;
+        guint retry_base_delay;
+        guint retry_max_delay;
+        guint timeout;
+        gboolean use_json;
+        gboolean lazy_tasks;
+        GHashTable *flights;
+        GCond flights_cond;
+        GHashTable *requests;
+        GMutex stats_mutex;
+        GHashTable *stats;
 };
 
 enum {
@@ -334,26 +419,203 @@ enum {
         PROP_API_KEY,
         PROP_SHARED_SECRET,
         PROP_AUTH_TOKEN,
+        PROP_TIMEOUT,
+        PROP_USE_JSON,
+        PROP_LAZY_TASKS,
+        PROP_IO_THREAD,
 };
 
 G_DEFINE_TYPE (RtmGlib, rtm_glib, G_TYPE_OBJECT);
 
+/**
+ * rtm_glib_replace_auth_token:
+ * @rtm: a #RtmGlib object.
+ * @auth_token: the new authentication token.
+ *
+ * Sets the #RtmGlib:auth_token property. Calls running in other threads
+ * keep the copy of the previous value they took.
+ */
+static void
+rtm_glib_replace_auth_token (RtmGlib *rtm, const gchar *auth_token)
+{
+        RtmGlibPrivate *priv = rtm->priv;
 
+        g_mutex_lock (&priv->mutex);
 
-/* Private methods headers */
-gchar *
-rtm_glib_caculate_md5 (RtmGlib *rtm, GHashTable * params);
+        if (g_strcmp0 (priv->auth_token, auth_token) != 0) {
+                g_free (priv->auth_token);
+                priv->auth_token = g_strdup (auth_token);
+        }
 
-gboolean
-rtm_glib_check_response (RtmGlib *rtm, RestXmlNode *root, GError **error);
+        g_mutex_unlock (&priv->mutex);
+}
 
-void
-rtm_glib_sign_call (RtmGlib *rtm, RestProxyCall **call);
+/**
+ * rtm_glib_dup_auth_token:
+ * @rtm: a #RtmGlib object.
+ *
+ * Gets the #RtmGlib:auth_token property for a call, which keeps using it
+ * even if another thread sets a new one.
+ *
+ * Returns: a copy of the authentication token, or %NULL.
+ */
+static gchar *
+rtm_glib_dup_auth_token (RtmGlib *rtm)
+{
+        gchar *auth_token;
 
-RestXmlNode *
-rtm_glib_call_method (RtmGlib *rtm, gchar *method, GError **error, ...);
+        g_mutex_lock (&rtm->priv->mutex);
+        auth_token = g_strdup (rtm->priv->auth_token);
+        g_mutex_unlock (&rtm->priv->mutex);
+
+        return auth_token;
+}
+
+/**
+ * rtm_glib_has_auth_token:
+ * @rtm: a #RtmGlib object.
+ *
+ * Checks if @rtm has an authentication token, which another thread could
+ * be setting.
+ *
+ * Returns: %TRUE if #RtmGlib:auth_token is set.
+ */
+static gboolean
+rtm_glib_has_auth_token (RtmGlib *rtm)
+{
+        gboolean has_auth_token;
+
+        g_mutex_lock (&rtm->priv->mutex);
+        has_auth_token = rtm->priv->auth_token != NULL;
+        g_mutex_unlock (&rtm->priv->mutex);
+
+        return has_auth_token;
+}
+
+static gpointer
+rtm_glib_io_thread_func (gpointer user_data)
+{
+        GMainLoop *loop = user_data;
+        GMainContext *context = g_main_loop_get_context (loop);
+
+        g_main_context_push_thread_default (context);
+        g_main_loop_run (loop);
+        g_main_context_pop_thread_default (context);
+
+        return NULL;
+}
+
+static gboolean
+rtm_glib_io_thread_quit (gpointer user_data)
+{
+        g_main_loop_quit (user_data);
+
+        return FALSE;
+}
+
+/**
+ * rtm_glib_steal_own_transport:
+ * @rtm: a #RtmGlib object.
+ *
+ * Drops the transport if it was created by @rtm, so the next call creates
+ * one running in the current I/O context. Must be called with the mutex
+ * held.
+ *
+ * Returns: the dropped #RtmTransport to be unreferenced once the mutex is
+ * released, or %NULL.
+ */
+static RtmTransport *
+rtm_glib_steal_own_transport (RtmGlib *rtm)
+{
+        RtmTransport *old_transport = NULL;
+
+        if (rtm->priv->own_transport) {
+                old_transport = rtm->priv->transport;
+                rtm->priv->transport = NULL;
+                rtm->priv->own_transport = FALSE;
+        }
+
+        return old_transport;
+}
+
+/**
+ * rtm_glib_start_io_thread:
+ * @rtm: a #RtmGlib object.
+ *
+ * Starts a thread iterating a #GMainContext of its own, where the
+ * #RtmRestTransport created by @rtm runs its HTTP sessions.
+ */
+static void
+rtm_glib_start_io_thread (RtmGlib *rtm)
+{
+        RtmGlibPrivate *priv = rtm->priv;
+        RtmTransport *old_transport;
+
+        g_mutex_lock (&priv->mutex);
+
+        if (priv->io_thread != NULL) {
+                g_mutex_unlock (&priv->mutex);
+                return;
+        }
+
+        priv->io_context = g_main_context_new ();
+        priv->io_loop = g_main_loop_new (priv->io_context, FALSE);
+        priv->io_thread = g_thread_new ("rtm-glib-io", rtm_glib_io_thread_func,
+                                        priv->io_loop);
+        old_transport = rtm_glib_steal_own_transport (rtm);
+
+        g_mutex_unlock (&priv->mutex);
+
+        if (old_transport) {
+                g_object_unref (old_transport);
+        }
+}
+
+/**
+ * rtm_glib_stop_io_thread:
+ * @rtm: a #RtmGlib object.
+ *
+ * Stops the thread started by rtm_glib_start_io_thread() and waits for it.
+ * Calls already using the transport of the thread keep their reference to
+ * its context.
+ */
+static void
+rtm_glib_stop_io_thread (RtmGlib *rtm)
+{
+        RtmGlibPrivate *priv = rtm->priv;
+        RtmTransport *old_transport;
+        GMainContext *context;
+        GMainLoop *loop;
+        GThread *thread;
+
+        g_mutex_lock (&priv->mutex);
+
+        if (priv->io_thread == NULL) {
+                g_mutex_unlock (&priv->mutex);
+                return;
+        }
+
+        context = priv->io_context;
+        loop = priv->io_loop;
+        thread = priv->io_thread;
+        priv->io_thread = NULL;
+        priv->io_loop = NULL;
+        priv->io_context = NULL;
+        old_transport = rtm_glib_steal_own_transport (rtm);
+
+        g_mutex_unlock (&priv->mutex);
+
+        if (old_transport) {
+                g_object_unref (old_transport);
+        }
 
+        /* Quit from the loop itself, it could be not running yet */
+        g_main_context_invoke (context, rtm_glib_io_thread_quit, loop);
+        g_thread_join (thread);
 
+        g_main_loop_unref (loop);
+        g_main_context_unref (context);
+}
 
 static void
 rtm_glib_get_property (GObject *gobject, guint prop_id, GValue *value,
@@ -363,15 +625,39 @@ rtm_glib_get_property (GObject *gobject, guint prop_id, GValue *value,
 
         switch (prop_id) {
         case PROP_API_KEY:
+                g_mutex_lock (&priv->mutex);
                 g_value_set_string (value, priv->api_key);
+                g_mutex_unlock (&priv->mutex);
                 break;
 
         case PROP_SHARED_SECRET:
+                g_mutex_lock (&priv->mutex);
                 g_value_set_string (value, priv->shared_secret);
+                g_mutex_unlock (&priv->mutex);
                 break;
 
         case PROP_AUTH_TOKEN:
+                g_mutex_lock (&priv->mutex);
                 g_value_set_string (value, priv->auth_token);
+                g_mutex_unlock (&priv->mutex);
+                break;
+
+        case PROP_TIMEOUT:
+                g_value_set_uint (value, priv->timeout);
+                break;
+
+        case PROP_USE_JSON:
+                g_value_set_boolean (value, priv->use_json);
+                break;
+
+        case PROP_LAZY_TASKS:
+                g_value_set_boolean (value, priv->lazy_tasks);
+                break;
+
+        case PROP_IO_THREAD:
+                g_mutex_lock (&priv->mutex);
+                g_value_set_boolean (value, priv->io_thread != NULL);
+                g_mutex_unlock (&priv->mutex);
                 break;
 
         default:
@@ -389,18 +675,44 @@ rtm_glib_set_property (GObject *gobject, guint prop_id, const GValue *value,
 
         switch (prop_id) {
         case PROP_API_KEY:
+                g_mutex_lock (&priv->mutex);
                 g_free (priv->api_key);
                 priv->api_key = g_value_dup_string (value);
+                g_hash_table_remove_all (priv->requests);
+                g_mutex_unlock (&priv->mutex);
                 break;
 
         case PROP_SHARED_SECRET:
+                g_mutex_lock (&priv->mutex);
                 g_free (priv->shared_secret);
                 priv->shared_secret = g_value_dup_string (value);
+                g_hash_table_remove_all (priv->requests);
+                g_mutex_unlock (&priv->mutex);
                 break;
 
         case PROP_AUTH_TOKEN:
-                g_free (priv->auth_token);
-                priv->auth_token = g_value_dup_string (value);
+                rtm_glib_replace_auth_token (RTM_GLIB (gobject),
+                                             g_value_get_string (value));
+                break;
+
+        case PROP_TIMEOUT:
+                priv->timeout = g_value_get_uint (value);
+                break;
+
+        case PROP_USE_JSON:
+                priv->use_json = g_value_get_boolean (value);
+                break;
+
+        case PROP_LAZY_TASKS:
+                priv->lazy_tasks = g_value_get_boolean (value);
+                break;
+
+        case PROP_IO_THREAD:
+                if (g_value_get_boolean (value)) {
+                        rtm_glib_start_io_thread (RTM_GLIB (gobject));
+                } else {
+                        rtm_glib_stop_io_thread (RTM_GLIB (gobject));
+                }
                 break;
 
         default:
@@ -410,6 +722,27 @@ rtm_glib_set_property (GObject *gobject, guint prop_id, const GValue *value,
         }
 }
 
+static void
+rtm_glib_dispose (GObject *gobject)
+{
+        RtmGlibPrivate *priv = RTM_GLIB_GET_PRIVATE (RTM_GLIB (gobject));
+
+        if (priv->keepalive_source) {
+                g_source_destroy (priv->keepalive_source);
+                g_source_unref (priv->keepalive_source);
+                priv->keepalive_source = NULL;
+        }
+
+        if (priv->transport) {
+                g_object_unref (priv->transport);
+                priv->transport = NULL;
+        }
+
+        rtm_glib_stop_io_thread (RTM_GLIB (gobject));
+
+        G_OBJECT_CLASS (rtm_glib_parent_class)->dispose (gobject);
+}
+
 static void
 rtm_glib_finalize (GObject *gobject)
 {
@@ -418,6 +751,12 @@ rtm_glib_finalize (GObject *gobject)
         g_free (priv->api_key);
         g_free (priv->shared_secret);
         g_free (priv->auth_token);
+        g_hash_table_destroy (priv->flights);
+        g_cond_clear (&priv->flights_cond);
+        g_hash_table_destroy (priv->requests);
+        g_mutex_clear (&priv->mutex);
+        g_hash_table_destroy (priv->stats);
+        g_mutex_clear (&priv->stats_mutex);
 
         G_OBJECT_CLASS (rtm_glib_parent_class)->finalize (gobject);
 }
@@ -431,6 +770,7 @@ rtm_glib_class_init (RtmGlibClass *klass)
 
         gobject_class->get_property = rtm_glib_get_property;
         gobject_class->set_property = rtm_glib_set_property;
+        gobject_class->dispose = rtm_glib_dispose;
         gobject_class->finalize = rtm_glib_finalize;
 
         g_object_class_install_property (
@@ -455,7 +795,7 @@ rtm_glib_class_init (RtmGlibClass *klass)
 
         g_object_class_install_property (
                 gobject_class,
-                PROP_SHARED_SECRET,
+                PROP_AUTH_TOKEN,
                 g_param_spec_string (
                         "auth_token",
                         "Authentication Token",
@@ -463,12 +803,74 @@ rtm_glib_class_init (RtmGlibClass *klass)
                         NULL,
                         G_PARAM_READWRITE));
 
+        g_object_class_install_property (
+                gobject_class,
+                PROP_TIMEOUT,
+                g_param_spec_uint (
+                        "timeout",
+                        "Timeout",
+                        "Seconds to wait for each response, or 0 to wait "
+                        "forever",
+                        0,
+                        G_MAXUINT,
+                        RTM_GLIB_DEFAULT_TIMEOUT,
+                        G_PARAM_READWRITE | G_PARAM_CONSTRUCT));
+
+        g_object_class_install_property (
+                gobject_class,
+                PROP_USE_JSON,
+                g_param_spec_boolean (
+                        "use_json",
+                        "Use JSON",
+                        "Whether the getList methods ask for JSON responses",
+                        FALSE,
+                        G_PARAM_READWRITE));
+
+        g_object_class_install_property (
+                gobject_class,
+                PROP_LAZY_TASKS,
+                g_param_spec_boolean (
+                        "lazy_tasks",
+                        "Lazy tasks",
+                        "Whether the tasks of tasks.getList decode the fields "
+                        "seldom read on first access",
+                        FALSE,
+                        G_PARAM_READWRITE));
+
+        g_object_class_install_property (
+                gobject_class,
+                PROP_IO_THREAD,
+                g_param_spec_boolean (
+                        "io_thread",
+                        "I/O thread",
+                        "Whether the HTTP sessions run in a thread of "
+                        "their own",
+                        FALSE,
+                        G_PARAM_READWRITE));
+
 }
 
 static void
 rtm_glib_init (RtmGlib *rtm)
 {
         rtm->priv = RTM_GLIB_GET_PRIVATE (rtm);
+
+        rtm->priv->max_retries = RTM_GLIB_DEFAULT_MAX_RETRIES;
+        rtm->priv->retry_base_delay = RTM_GLIB_DEFAULT_RETRY_BASE_DELAY;
+        rtm->priv->retry_max_delay = RTM_GLIB_DEFAULT_RETRY_MAX_DELAY;
+
+        g_mutex_init (&rtm->priv->mutex);
+        rtm->priv->flights = g_hash_table_new_full (g_str_hash, g_str_equal,
+                                                    g_free, NULL);
+        g_cond_init (&rtm->priv->flights_cond);
+        rtm->priv->requests = g_hash_table_new_full (
+                g_str_hash, g_str_equal,
+                g_free, (GDestroyNotify) rtm_request_unref);
+
+        g_mutex_init (&rtm->priv->stats_mutex);
+        rtm->priv->stats = g_hash_table_new_full (
+                g_str_hash, g_str_equal,
+                g_free, (GDestroyNotify) rtm_method_stats_free);
 }
 
 /**
@@ -493,761 +895,6495 @@ rtm_glib_new (gchar *api_key, gchar *shared_secret)
 }
 
 /**
- * rtm_glib_caculate_md5:
+ * rtm_glib_set_transport:
  * @rtm: a #RtmGlib object.
- * @params: a #GHashTable with the params for a HTTP request.
- *
- * Calculates the md5 value for the params in order to sign the HTTP request
- * following the algorithm described at:
- * http://www.rememberthemilk.com/services/api/authentication.rtm
+ * @transport: the #RtmTransport used to send the calls.
  *
- * Returns: the md5 value.
+ * Sets how the calls are sent to Remember The Milk. Calls already in flight
+ * keep using the previous transport.
  */
-gchar *
-rtm_glib_caculate_md5 (RtmGlib *rtm, GHashTable * params)
+void
+rtm_glib_set_transport (RtmGlib *rtm, RtmTransport *transport)
 {
-        g_assert (rtm != NULL);
-        g_assert (params != NULL);
-
-        GList *keys;
-        gchar *key;
-        gchar *value;
-        gchar *params_string;
-        gchar *md5;
-
-        /* First concat the SHARED SECRET key */
-        params_string = rtm->priv->shared_secret;
+        g_return_if_fail (rtm != NULL);
+        g_return_if_fail (RTM_IS_TRANSPORT (transport));
 
-        /* Sort the param hash */
-        keys = g_hash_table_get_keys (params);
-        keys = g_list_sort (keys, (GCompareFunc) g_strcmp0);
+        RtmTransport *old_transport;
 
-        /* Iterate over the params hash */
-        while (keys) {
-                key = keys->data;
-                value = g_hash_table_lookup (params, key);
+        g_mutex_lock (&rtm->priv->mutex);
+        old_transport = rtm->priv->transport;
+        rtm->priv->transport = g_object_ref (transport);
+        rtm->priv->own_transport = FALSE;
+        g_mutex_unlock (&rtm->priv->mutex);
 
-                // Concat each key and value
-                params_string = g_strconcat (params_string, key, value, NULL);
-
-                keys = keys->next;
+        if (old_transport) {
+                g_object_unref (old_transport);
         }
-
-        DEBUG_PRINT ("params_string: %s", params_string);
-
-        /* Generates the md5 value */
-        md5 = g_compute_checksum_for_string (G_CHECKSUM_MD5,
-                                             params_string,
-                                             strlen (params_string));
-
-        g_free (params_string);
-
-        return md5;
 }
 
 /**
- * rtm_glib_sign_call:
+ * rtm_glib_ensure_transport:
  * @rtm: a #RtmGlib object.
- * @call: a #RestProxyCall to be signed.
- * @see_also: rtm_caculate_md5()
  *
- * Signs a call adding the api_sig param.
+ * Creates the default transport of @rtm if it has none. Called with the
+ * mutex held.
+ *
+ * Returns: the #RtmTransport of @rtm.
  */
-void
-rtm_glib_sign_call (RtmGlib *rtm, RestProxyCall **call)
+static RtmTransport *
+rtm_glib_ensure_transport (RtmGlib *rtm)
 {
-        g_assert (rtm != NULL);
-        g_assert (call != NULL);
-
-        GHashTable *params;
-        gchar *md5;
+        if (rtm->priv->transport == NULL) {
+                rtm->priv->transport = RTM_TRANSPORT (
+                        rtm_rest_transport_new_full (NULL,
+                                                     rtm->priv->io_context));
+                rtm->priv->own_transport = TRUE;
+        }
 
-        /* Gets the call params */
-        params = rest_proxy_call_get_params (*call);
+        return rtm->priv->transport;
+}
 
-        /* Calculate the md5 */
-        md5 = rtm_glib_caculate_md5 (rtm, params);
+/**
+ * rtm_glib_ref_transport:
+ * @rtm: a #RtmGlib object.
+ *
+ * Gets the transport of @rtm for a call, which keeps using it even if
+ * another thread sets a new one.
+ *
+ * Returns: a new reference to the #RtmTransport of @rtm.
+ */
+static RtmTransport *
+rtm_glib_ref_transport (RtmGlib *rtm)
+{
+        RtmTransport *transport;
 
-        /* Adds the new api_sig param */
-        rest_proxy_call_add_param (*call, "api_sig", md5);
+        g_mutex_lock (&rtm->priv->mutex);
+        transport = g_object_ref (rtm_glib_ensure_transport (rtm));
+        g_mutex_unlock (&rtm->priv->mutex);
 
-        g_hash_table_unref (params);
-        g_free (md5);
+        return transport;
 }
 
 /**
- * rtm_glib_check_response:
+ * rtm_glib_get_transport:
  * @rtm: a #RtmGlib object.
- * @root: the root #RestXmlNode of Remember The Milk response.
- * @error: a #GError to be filled if response is not successful.
  *
- * Checks if response is or not successful.
+ * Gets how the calls are sent to Remember The Milk. By default a
+ * #RtmRestTransport is created on the first call, running in the I/O thread
+ * if #RtmGlib:io_thread is set.
  *
- * Returns: %TRUE if the response is successful.
+ * Returns: the #RtmTransport of @rtm, owned by it and only valid until
+ * rtm_glib_set_transport() replaces it.
  */
-gboolean
-rtm_glib_check_response (RtmGlib *rtm, RestXmlNode *root, GError **error)
+RtmTransport *
+rtm_glib_get_transport (RtmGlib *rtm)
 {
-        g_assert (rtm != NULL);
-        g_assert (root != NULL);
-
-        RestXmlNode *error_node;
-        const gchar *status, *error_code, *error_msg;
-
-        if (g_strcmp0 (root->name, "rsp") == 0) {
-                status = rest_xml_node_get_attr (root, "stat");
-                if (g_strcmp0 (status, "ok") != 0) {
-                        error_node = rest_xml_node_find (root, "err");
+        g_return_val_if_fail (rtm != NULL, NULL);
 
-                        error_code = rest_xml_node_get_attr (error_node, "code");
-                        error_msg = rest_xml_node_get_attr (error_node, "msg");
+        RtmTransport *transport;
 
-                        g_set_error (
-                                error,
-                                RTM_ERROR_DOMAIN,
-                                RTM_ERROR_RESPONSE_FAIL,
-                                "%s: %s",
-                                error_code,
-                                error_msg);
-                        return FALSE;
-                }
-        } else {
-                g_set_error (
-                        error,
-                        RTM_ERROR_DOMAIN,
-                        RTM_UNKNOWN_ERROR,
-                        "Unknown response from Remember The Milk");
-                return FALSE;
-        }
+        g_mutex_lock (&rtm->priv->mutex);
+        transport = rtm_glib_ensure_transport (rtm);
+        g_mutex_unlock (&rtm->priv->mutex);
 
-        return TRUE;
+        return transport;
 }
 
 /**
- * rtm_glib_call_method:
+ * rtm_glib_get_connection_stats:
  * @rtm: a #RtmGlib object.
- * @method: the method name to be called.
- * @Varargs: list of parameters (pairs of name and value) terminated by %NULL.
+ * @sessions: location to store the number of HTTP sessions created, or
+ * %NULL.
+ * @reused: location to store the number of calls that took an already
+ * created HTTP session from the pool, or %NULL.
  *
- * Calls a method of Remember The Milk API with the arguments passed.
+ * Gets the session statistics of @rtm. Each call takes an HTTP session from
+ * a pool, which can keep its connection alive between calls. A new session
+ * is only created when all of them are busy and after a transport error.
+ * Both are 0 if the transport of @rtm is not a #RtmRestTransport.
  *
- * Returns: A #RestXmlNode object with the method response. Or %NULL if call
- * fails.
+ * Sessions are counted, not TCP connections: see
+ * rtm_rest_transport_get_connection_stats().
  */
-RestXmlNode *
-rtm_glib_call_method (RtmGlib *rtm, gchar *method, GError **error, ...)
+void
+rtm_glib_get_connection_stats (RtmGlib *rtm, guint *sessions, guint *reused)
 {
-        g_assert (rtm != NULL);
-        g_assert (method != NULL);
-
-        RestProxy *proxy;
-        RestProxyCall *call;
-        RestXmlParser *parser;
-        RestXmlNode *root;
-        va_list params;
-        GError *tmp_error = NULL;
-
-        DEBUG_PRINT ("rtm_call_method: %s", method);
+        g_return_if_fail (rtm != NULL);
 
-        proxy = rest_proxy_new (RTM_URL, FALSE);
-        call = rest_proxy_new_call (proxy);
+        RtmTransport *transport;
 
-        rest_proxy_call_add_param (call, "method", method);
-        rest_proxy_call_add_param (call, "api_key", rtm->priv->api_key);
+        if (sessions) {
+                *sessions = 0;
+        }
+        if (reused) {
+                *reused = 0;
+        }
 
-        va_start (params, error);
-        rest_proxy_call_add_params_from_valist (call, params);
-        va_end (params);
+        transport = rtm_glib_ref_transport (rtm);
+        if (RTM_IS_REST_TRANSPORT (transport)) {
+                rtm_rest_transport_get_connection_stats (
+                        RTM_REST_TRANSPORT (transport), sessions, reused);
+        }
+        g_object_unref (transport);
+}
 
-        rtm_glib_sign_call (rtm, &call);
-        rest_proxy_call_run (call, NULL, &tmp_error);
-        if (tmp_error != NULL) {
-                g_object_unref (call);
-                g_object_unref (proxy);
+/**
+ * rtm_glib_get_transfer_stats:
+ * @rtm: a #RtmGlib object.
+ * @compressed: location to store the number of bytes received, or %NULL.
+ * @uncompressed: location to store the number of bytes once decompressed,
+ * or %NULL.
+ *
+ * Gets the size of all the responses received by @rtm. Responses are
+ * requested with gzip or deflate compression, so @compressed is what went
+ * over the network and @uncompressed what was parsed. Both are 0 if the
+ * transport of @rtm is not a #RtmRestTransport.
+ */
+void
+rtm_glib_get_transfer_stats (RtmGlib *rtm, guint64 *compressed,
+                             guint64 *uncompressed)
+{
+        g_return_if_fail (rtm != NULL);
 
-                g_set_error (
-                        error,
-                        RTM_ERROR_DOMAIN,
-                        RTM_UNKNOWN_ERROR,
-                        "%s",
-                        tmp_error->message);
+        RtmTransport *transport;
 
-                return NULL;
+        if (compressed) {
+                *compressed = 0;
         }
-        DEBUG_PRINT ("payload: %s", rest_proxy_call_get_payload (call));
-
-        parser = rest_xml_parser_new ();
-        root = rest_xml_parser_parse_from_data (
-                parser,
-                rest_proxy_call_get_payload (call),
-                rest_proxy_call_get_payload_length (call));
-
-        if (!rtm_glib_check_response (rtm, root, &tmp_error)) {
-                g_propagate_error (error, tmp_error);
-                rest_xml_node_unref (root);
-                root = NULL;
+        if (uncompressed) {
+                *uncompressed = 0;
         }
 
-        g_object_unref (call);
-        g_object_unref (proxy);
-        g_object_unref (parser);
-
-        return root;
+        transport = rtm_glib_ref_transport (rtm);
+        if (RTM_IS_REST_TRANSPORT (transport)) {
+                rtm_rest_transport_get_transfer_stats (
+                        RTM_REST_TRANSPORT (transport),
+                        compressed, uncompressed);
+        }
+        g_object_unref (transport);
 }
 
 /**
- * rtm_glib_test_echo:
+ * rtm_glib_set_rate_limit:
  * @rtm: a #RtmGlib object.
- * @error: location to store #GError or %NULL.
+ * @rate: the average number of requests per second, or 0 for no limit.
+ * @burst: the number of requests that can be sent at once after being idle.
  *
- * Just checks if the webservice is working properly.
+ * Sets the rate limit of the calls. The limit is shared by every #RtmGlib
+ * object in the process with the same #RtmGlib:api_key, as Remember The Milk
+ * limits the request rate per API key. Calls over the limit are delayed, not
+ * failed. By default one request per second is allowed, with bursts of three.
  *
- * Returns: %TRUE if the service is available.
+ * The time each call waits is recorded in the %RTM_METHOD_PHASE_QUEUE
+ * latency of its method, see rtm_glib_get_method_stats(). A call cancelled
+ * before being sent gives its turn back.
  */
-gboolean
-rtm_glib_test_echo (RtmGlib *rtm, GError **error)
+void
+rtm_glib_set_rate_limit (RtmGlib *rtm, gdouble rate, guint burst)
 {
-        g_return_val_if_fail (rtm != NULL, FALSE);
+        g_return_if_fail (rtm != NULL);
+        g_return_if_fail (rate >= 0);
 
-        RestXmlNode *root, *node;
-        gboolean valid = FALSE;
-        GError *tmp_error = NULL;
+        g_mutex_lock (&rtm->priv->mutex);
+        rtm_rate_limiter_set_rate (rtm->priv->api_key, rate, burst);
+        g_mutex_unlock (&rtm->priv->mutex);
+}
 
-        root = rtm_glib_call_method (rtm,
+/**
+ * rtm_glib_get_rate_limit:
+ * @rtm: a #RtmGlib object.
+ * @rate: location to store the average number of requests per second, or
+ * %NULL.
+ * @burst: location to store the burst size, or %NULL.
+ *
+ * Gets the rate limit shared by the calls with the #RtmGlib:api_key of @rtm.
+ */
+void
+rtm_glib_get_rate_limit (RtmGlib *rtm, gdouble *rate, guint *burst)
+{
+        g_return_if_fail (rtm != NULL);
+
+        g_mutex_lock (&rtm->priv->mutex);
+        rtm_rate_limiter_get_rate (rtm->priv->api_key, rate, burst);
+        g_mutex_unlock (&rtm->priv->mutex);
+}
+
+/**
+ * rtm_glib_set_retry_policy:
+ * @rtm: a #RtmGlib object.
+ * @max_retries: the number of times a call is sent again, or 0 to disable.
+ * @base_delay: the delay ceiling in milliseconds before the first retry.
+ * @max_delay: the maximum delay ceiling in milliseconds.
+ *
+ * Sets how calls are retried after a transient error (see
+ * rtm_error_is_transient()). Only methods without side effects, such as the
+ * getList ones, are retried. Each retry waits a random time between zero and
+ * a ceiling which starts at @base_delay and doubles on each attempt, up to
+ * @max_delay. By default calls are retried 3 times, from 500 ms up to 8 s.
+ */
+void
+rtm_glib_set_retry_policy (RtmGlib *rtm, guint max_retries, guint base_delay,
+                           guint max_delay)
+{
+        g_return_if_fail (rtm != NULL);
+        g_return_if_fail (base_delay <= max_delay);
+
+        rtm->priv->max_retries = max_retries;
+        rtm->priv->retry_base_delay = base_delay;
+        rtm->priv->retry_max_delay = max_delay;
+}
+
+/**
+ * rtm_glib_get_retry_policy:
+ * @rtm: a #RtmGlib object.
+ * @max_retries: location to store the number of retries, or %NULL.
+ * @base_delay: location to store the base delay in milliseconds, or %NULL.
+ * @max_delay: location to store the maximum delay in milliseconds, or %NULL.
+ *
+ * Gets how calls are retried after a transient error.
+ */
+void
+rtm_glib_get_retry_policy (RtmGlib *rtm, guint *max_retries,
+                           guint *base_delay, guint *max_delay)
+{
+        g_return_if_fail (rtm != NULL);
+
+        if (max_retries) {
+                *max_retries = rtm->priv->max_retries;
+        }
+        if (base_delay) {
+                *base_delay = rtm->priv->retry_base_delay;
+        }
+        if (max_delay) {
+                *max_delay = rtm->priv->retry_max_delay;
+        }
+}
+
+/**
+ * rtm_glib_set_timeout:
+ * @rtm: a #RtmGlib object.
+ * @timeout: the time limit in seconds, or 0 for no limit.
+ *
+ * Sets the #RtmGlib:timeout property, how long each attempt of a call waits
+ * for the response. Calls without a response in time fail with
+ * %RTM_ERROR_TIMED_OUT, which is retried as any other transient error. By
+ * default the limit is 30 seconds.
+ */
+void
+rtm_glib_set_timeout (RtmGlib *rtm, guint timeout)
+{
+        g_return_if_fail (rtm != NULL);
+
+        g_object_set (rtm, "timeout", timeout, NULL);
+}
+
+/**
+ * rtm_glib_get_timeout:
+ * @rtm: a #RtmGlib object.
+ *
+ * Gets the #RtmGlib:timeout property.
+ *
+ * Returns: the time limit of each attempt in seconds, or 0 for no limit.
+ */
+guint
+rtm_glib_get_timeout (RtmGlib *rtm)
+{
+        g_return_val_if_fail (rtm != NULL, 0);
+
+        return rtm->priv->timeout;
+}
+
+/**
+ * rtm_glib_set_use_json:
+ * @rtm: a #RtmGlib object.
+ * @use_json: %TRUE to ask for JSON responses.
+ *
+ * Sets the #RtmGlib:use_json property. When set, the getList methods of
+ * lists, tasks, locations, time zones and contacts ask for JSON responses,
+ * which are decoded straight into the returned objects as they are read,
+ * without building a document tree first. Other methods always use XML.
+ */
+void
+rtm_glib_set_use_json (RtmGlib *rtm, gboolean use_json)
+{
+        g_return_if_fail (rtm != NULL);
+
+        g_object_set (rtm, "use_json", use_json, NULL);
+}
+
+/**
+ * rtm_glib_get_use_json:
+ * @rtm: a #RtmGlib object.
+ *
+ * Gets the #RtmGlib:use_json property.
+ *
+ * Returns: %TRUE if the getList methods ask for JSON responses.
+ */
+gboolean
+rtm_glib_get_use_json (RtmGlib *rtm)
+{
+        g_return_val_if_fail (rtm != NULL, FALSE);
+
+        return rtm->priv->use_json;
+}
+
+/**
+ * rtm_glib_set_lazy_tasks:
+ * @rtm: a #RtmGlib object.
+ * @lazy_tasks: %TRUE to decode the fields seldom read on first access.
+ *
+ * Sets the #RtmGlib:lazy_tasks property. When set, the #RtmTask objects of
+ * rtm_glib_tasks_get_list() and rtm_glib_tasks_foreach_async() only decode
+ * their IDs, name, priority, due date and postponed count as they are
+ * loaded. The URL, location, source, estimate, recurrence, tags and the
+ * other dates are kept as found in the response and decoded on first
+ * access, so consumers only pay for the fields they read.
+ */
+void
+rtm_glib_set_lazy_tasks (RtmGlib *rtm, gboolean lazy_tasks)
+{
+        g_return_if_fail (rtm != NULL);
+
+        g_object_set (rtm, "lazy_tasks", lazy_tasks, NULL);
+}
+
+/**
+ * rtm_glib_get_lazy_tasks:
+ * @rtm: a #RtmGlib object.
+ *
+ * Gets the #RtmGlib:lazy_tasks property.
+ *
+ * Returns: %TRUE if the tasks decode the fields seldom read on first
+ * access.
+ */
+gboolean
+rtm_glib_get_lazy_tasks (RtmGlib *rtm)
+{
+        g_return_val_if_fail (rtm != NULL, FALSE);
+
+        return rtm->priv->lazy_tasks;
+}
+
+/**
+ * rtm_glib_set_io_thread:
+ * @rtm: a #RtmGlib object.
+ * @io_thread: %TRUE to run the HTTP sessions in a thread of their own.
+ *
+ * Sets the #RtmGlib:io_thread property. When set, @rtm starts a thread with
+ * its own #GMainContext, and the #RtmRestTransport it creates runs the HTTP
+ * sessions there. Synchronous methods then only wait for the response,
+ * without iterating the main context of the calling thread, and the
+ * asynchronous ones still return in it. A transport set with
+ * rtm_glib_set_transport() is not affected. Should be changed while no call
+ * is running.
+ */
+void
+rtm_glib_set_io_thread (RtmGlib *rtm, gboolean io_thread)
+{
+        g_return_if_fail (rtm != NULL);
+
+        g_object_set (rtm, "io_thread", io_thread, NULL);
+}
+
+/**
+ * rtm_glib_get_io_thread:
+ * @rtm: a #RtmGlib object.
+ *
+ * Gets the #RtmGlib:io_thread property.
+ *
+ * Returns: %TRUE if the HTTP sessions run in a thread of their own.
+ */
+gboolean
+rtm_glib_get_io_thread (RtmGlib *rtm)
+{
+        g_return_val_if_fail (rtm != NULL, FALSE);
+
+        return rtm->priv->io_thread != NULL;
+}
+
+/**
+ * rtm_glib_mark_send:
+ * @rtm: a #RtmGlib object.
+ *
+ * Records that a call is being sent, so no keep-alive ping is needed for a
+ * while.
+ */
+static void
+rtm_glib_mark_send (RtmGlib *rtm)
+{
+        g_mutex_lock (&rtm->priv->mutex);
+        rtm->priv->last_send_time = g_get_monotonic_time ();
+        g_mutex_unlock (&rtm->priv->mutex);
+}
+
+static void
+rtm_glib_ping_cb (GObject *source_object, GAsyncResult *result,
+                  gpointer user_data)
+{
+        GError *error = NULL;
+
+        if (!rtm_glib_test_echo_finish (RTM_GLIB (source_object), result,
+                                        &error)) {
+                DEBUG_PRINT ("rtm_glib_prewarm: ping failed: %s",
+                             error ? error->message : "invalid response");
+                g_clear_error (&error);
+        }
+}
+
+static gboolean
+rtm_glib_ping (gpointer user_data)
+{
+        rtm_glib_test_echo_async (RTM_GLIB (user_data), NULL,
+                                  rtm_glib_ping_cb, NULL);
+
+        return FALSE;
+}
+
+static gboolean
+rtm_glib_keepalive_timeout (gpointer user_data)
+{
+        GWeakRef *weak_rtm = user_data;
+        RtmGlib *rtm;
+        gint64 idle, interval;
+
+        rtm = g_weak_ref_get (weak_rtm);
+        if (rtm == NULL) {
+                return FALSE;
+        }
+
+        g_mutex_lock (&rtm->priv->mutex);
+        idle = g_get_monotonic_time () - rtm->priv->last_send_time;
+        interval = (gint64) rtm->priv->keepalive * G_USEC_PER_SEC;
+        g_mutex_unlock (&rtm->priv->mutex);
+
+        /* Only ping if no call was sent during the last interval. The
+         * previous ping was sent a bit after its tick, and the timer has a
+         * granularity of one second */
+        if (idle + G_USEC_PER_SEC >= interval) {
+                rtm_glib_ping (rtm);
+        }
+
+        g_object_unref (rtm);
+
+        return TRUE;
+}
+
+static void
+rtm_glib_weak_ref_free (GWeakRef *weak_rtm)
+{
+        g_weak_ref_clear (weak_rtm);
+        g_slice_free (GWeakRef, weak_rtm);
+}
+
+/**
+ * rtm_glib_prewarm:
+ * @rtm: a #RtmGlib object.
+ * @keepalive: seconds between the keep-alive pings, or 0 for none.
+ *
+ * Sends a rtm.test.echo call in the background, so the host name is
+ * resolved and a connection is opened before the first real call. If
+ * @keepalive is not 0, another echo is sent every time @rtm has not sent
+ * any call for @keepalive seconds, so the connection is not closed while
+ * idle. Calling it again replaces the interval; 0 stops the pings.
+ *
+ * The pings run in the I/O thread if #RtmGlib:io_thread is set, otherwise
+ * in the thread-default main context of the caller, which must be
+ * iterated. They count for the rate limit and the method statistics like
+ * any other call.
+ */
+void
+rtm_glib_prewarm (RtmGlib *rtm, guint keepalive)
+{
+        g_return_if_fail (rtm != NULL);
+
+        RtmGlibPrivate *priv = rtm->priv;
+        GMainContext *context;
+        GSource *source = NULL;
+        GSource *old_source;
+        GWeakRef *weak_rtm;
+
+        g_mutex_lock (&priv->mutex);
+        context = priv->io_context ? g_main_context_ref (priv->io_context) :
+                g_main_context_ref_thread_default ();
+        g_mutex_unlock (&priv->mutex);
+
+        if (keepalive > 0) {
+                weak_rtm = g_slice_new0 (GWeakRef);
+                g_weak_ref_init (weak_rtm, rtm);
+
+                source = g_timeout_source_new_seconds (keepalive);
+                g_source_set_callback (source, rtm_glib_keepalive_timeout,
+                                       weak_rtm,
+                                       (GDestroyNotify) rtm_glib_weak_ref_free);
+        }
+
+        g_mutex_lock (&priv->mutex);
+        old_source = priv->keepalive_source;
+        priv->keepalive_source = source;
+        priv->keepalive = keepalive;
+        g_mutex_unlock (&priv->mutex);
+
+        if (old_source) {
+                g_source_destroy (old_source);
+                g_source_unref (old_source);
+        }
+        if (source) {
+                g_source_attach (source, context);
+        }
+
+        g_main_context_invoke_full (context, G_PRIORITY_DEFAULT,
+                                    rtm_glib_ping, g_object_ref (rtm),
+                                    g_object_unref);
+
+        g_main_context_unref (context);
+}
+
+static gint
+rtm_glib_compare_method_stats (gconstpointer a, gconstpointer b)
+{
+        return strcmp (rtm_method_stats_get_method (a),
+                       rtm_method_stats_get_method (b));
+}
+
+/**
+ * rtm_glib_get_method_stats:
+ * @rtm: a #RtmGlib object.
+ *
+ * Gets a snapshot of the latency and payload size statistics of every
+ * method called by @rtm, sorted by method name. The time spent creating the
+ * objects from the response (%RTM_METHOD_PHASE_LOAD) is only measured for
+ * the getList methods.
+ *
+ * Returns: A #GList of #RtmMethodStats. Free with g_list_free_full() and
+ * rtm_method_stats_free().
+ */
+GList *
+rtm_glib_get_method_stats (RtmGlib *rtm)
+{
+        g_return_val_if_fail (rtm != NULL, NULL);
+
+        GHashTableIter iter;
+        gpointer stats;
+        GList *list = NULL;
+
+        g_mutex_lock (&rtm->priv->stats_mutex);
+
+        g_hash_table_iter_init (&iter, rtm->priv->stats);
+        while (g_hash_table_iter_next (&iter, NULL, &stats)) {
+                list = g_list_prepend (list, rtm_method_stats_copy (stats));
+        }
+
+        g_mutex_unlock (&rtm->priv->stats_mutex);
+
+        return g_list_sort (list, rtm_glib_compare_method_stats);
+}
+
+/**
+ * rtm_glib_reset_method_stats:
+ * @rtm: a #RtmGlib object.
+ *
+ * Clears the statistics of every method called by @rtm.
+ */
+void
+rtm_glib_reset_method_stats (RtmGlib *rtm)
+{
+        g_return_if_fail (rtm != NULL);
+
+        g_mutex_lock (&rtm->priv->stats_mutex);
+        g_hash_table_remove_all (rtm->priv->stats);
+        g_mutex_unlock (&rtm->priv->stats_mutex);
+}
+
+/**
+ * rtm_glib_lookup_request:
+ * @rtm: a #RtmGlib object.
+ * @method: the method name to be called, or %NULL.
+ * @auth_token: the auth token of the call, or %NULL.
+ *
+ * Gets the template to sign the calls to @method, creating it the first
+ * time or when @auth_token changes.
+ *
+ * Returns: a #RtmRequest. Free with rtm_request_unref().
+ */
+static RtmRequest *
+rtm_glib_lookup_request (RtmGlib *rtm, const gchar *method,
+                         const gchar *auth_token)
+{
+        RtmGlibPrivate *priv = rtm->priv;
+        RtmRequest *request;
+        const gchar *key;
+
+        key = method != NULL ? method : "";
+
+        g_mutex_lock (&priv->mutex);
+
+        request = g_hash_table_lookup (priv->requests, key);
+        if (request == NULL ||
+            g_strcmp0 (rtm_request_get_auth_token (request),
+                       auth_token) != 0) {
+                request = rtm_request_new (priv->shared_secret,
+                                           priv->api_key, method,
+                                           auth_token);
+                g_hash_table_replace (priv->requests, g_strdup (key),
+                                      request);
+        }
+        rtm_request_ref (request);
+
+        g_mutex_unlock (&priv->mutex);
+
+        return request;
+}
+
+/**
+ * rtm_glib_sign_params:
+ * @rtm: a #RtmGlib object.
+ * @method: the method name to be called, or %NULL.
+ * @params: %NULL-terminated array alternating names and values.
+ * @signed_params: the #RtmSignedParams to fill.
+ *
+ * Builds the full list of parameters of a call, adding the method, the API
+ * key and the api_sig parameter with the signature of all of them. Calls to
+ * the same method reuse the signature of the static parameters.
+ *
+ * Clear @signed_params with rtm_signed_params_clear(), @params must be kept
+ * until then.
+ */
+void
+rtm_glib_sign_params (RtmGlib *rtm, const gchar *method, gchar **params,
+                      RtmSignedParams *signed_params)
+{
+        g_assert (rtm != NULL);
+
+        RtmRequest *request;
+
+        request = rtm_glib_lookup_request (
+                rtm, method, rtm_transport_lookup_param (params,
+                                                         "auth_token"));
+        rtm_request_sign (request, params, signed_params);
+        rtm_request_unref (request);
+}
+
+/**
+ * rtm_glib_presign:
+ * @rtm: a #RtmGlib object.
+ * @methods: the method name of each call.
+ * @params: the %NULL-terminated array alternating names and values of each
+ * call.
+ * @signatures: the #RtmSignature of each call to fill.
+ * @n: the number of calls.
+ *
+ * Signs many calls at once, spreading them over the processors. Send them
+ * with rtm_glib_call_method_signed_async(), or clear @signatures with
+ * rtm_signature_clear().
+ */
+void
+rtm_glib_presign (RtmGlib *rtm, gchar **methods, gchar ***params,
+                  RtmSignature *signatures, guint n)
+{
+        g_assert (rtm != NULL);
+
+        RtmRequest *request = NULL;
+        const gchar *auth_token;
+        guint i;
+
+        /* Batches usually repeat the same method and token */
+        for (i = 0; i < n; i++) {
+                auth_token = rtm_transport_lookup_param (params[i],
+                                                         "auth_token");
+                if (request == NULL ||
+                    g_strcmp0 (methods[i], methods[i - 1]) != 0 ||
+                    g_strcmp0 (auth_token,
+                               rtm_request_get_auth_token (request)) != 0) {
+                        if (request != NULL) {
+                                rtm_request_unref (request);
+                        }
+                        request = rtm_glib_lookup_request (rtm, methods[i],
+                                                           auth_token);
+                }
+                signatures[i].request = rtm_request_ref (request);
+        }
+        if (request != NULL) {
+                rtm_request_unref (request);
+        }
+
+        rtm_request_sign_batch (params, signatures, n);
+}
+
+/**
+ * rtm_glib_set_response_error:
+ * @error: a #GError to be filled.
+ * @error_code: the code of the failed response, or %NULL.
+ * @error_msg: the message of the failed response, or %NULL.
+ *
+ * Fills @error with the error of a failed response.
+ */
+void
+rtm_glib_set_response_error (GError **error, const gchar *error_code,
+                             const gchar *error_msg)
+{
+        gint code;
+
+        code = error_code ? (gint) g_ascii_strtoll (error_code, NULL, 10) : 0;
+
+        g_set_error (
+                error,
+                RTM_ERROR_DOMAIN,
+                rtm_error_from_service_code (code),
+                "%s: %s",
+                error_code,
+                error_msg);
+}
+
+/**
+ * rtm_glib_check_response:
+ * @rtm: a #RtmGlib object.
+ * @root: the root #RestXmlNode of Remember The Milk response.
+ * @error: a #GError to be filled if response is not successful.
+ *
+ * Checks if response is or not successful.
+ *
+ * Returns: %TRUE if the response is successful.
+ */
+gboolean
+rtm_glib_check_response (RtmGlib *rtm, RestXmlNode *root, GError **error)
+{
+        g_assert (rtm != NULL);
+        g_assert (root != NULL);
+
+        RestXmlNode *error_node;
+        const gchar *status, *error_code, *error_msg;
+
+        if (g_strcmp0 (root->name, "rsp") == 0) {
+                status = rest_xml_node_get_attr (root, "stat");
+                if (g_strcmp0 (status, "ok") != 0) {
+                        error_node = rest_xml_node_find (root, "err");
+
+                        error_code = rest_xml_node_get_attr (error_node, "code");
+                        error_msg = rest_xml_node_get_attr (error_node, "msg");
+
+                        rtm_glib_set_response_error (error, error_code,
+                                                     error_msg);
+                        return FALSE;
+                }
+        } else {
+                g_set_error (
+                        error,
+                        RTM_ERROR_DOMAIN,
+                        RTM_UNKNOWN_ERROR,
+                        "Unknown response from Remember The Milk");
+                return FALSE;
+        }
+
+        return TRUE;
+}
+
+/**
+ * rtm_glib_collect_params_full:
+ * @params: list of parameters (pairs of name and value) terminated by %NULL.
+ * @auth_token: the value given to the parameters set to %RTM_GLIB_AUTH_TOKEN.
+ *
+ * Copies the parameters of a method call into an array, so they can be kept
+ * after the variable arguments are gone.
+ *
+ * The format parameter is left out. The calls built from these parameters
+ * parse their XML response into a tree, the JSON entry points add it
+ * themselves.
+ *
+ * Returns: A %NULL-terminated array alternating names and values. Free with
+ * g_strfreev().
+ */
+static gchar **
+rtm_glib_collect_params_full (va_list params, const gchar *auth_token)
+{
+        GPtrArray *array;
+        const gchar *name, *value;
+
+        array = g_ptr_array_new ();
+
+        while ((name = va_arg (params, const gchar *)) != NULL) {
+                value = va_arg (params, const gchar *);
+                if (strcmp (name, "format") == 0) {
+                        DEBUG_PRINT ("rtm_collect_params: format=%s ignored",
+                                     value);
+                        continue;
+                }
+                if (value == RTM_GLIB_AUTH_TOKEN) {
+                        value = auth_token;
+                }
+                g_ptr_array_add (array, g_strdup (name));
+                g_ptr_array_add (array, g_strdup (value));
+        }
+        g_ptr_array_add (array, NULL);
+
+        return (gchar **) g_ptr_array_free (array, FALSE);
+}
+
+/**
+ * rtm_glib_collect_params:
+ * @params: list of parameters (pairs of name and value) terminated by %NULL.
+ *
+ * Copies the parameters of a method call into an array, so they can be kept
+ * after the variable arguments are gone. The format parameter is left out,
+ * see rtm_glib_collect_params_full().
+ *
+ * Returns: A %NULL-terminated array alternating names and values. Free with
+ * g_strfreev().
+ */
+gchar **
+rtm_glib_collect_params (va_list params)
+{
+        return rtm_glib_collect_params_full (params, NULL);
+}
+
+/**
+ * rtm_glib_collect_call_params:
+ * @rtm: a #RtmGlib object.
+ * @params: list of parameters (pairs of name and value) terminated by %NULL.
+ *
+ * Same as rtm_glib_collect_params() but replacing %RTM_GLIB_AUTH_TOKEN with
+ * the current #RtmGlib:auth_token of @rtm.
+ *
+ * Returns: A %NULL-terminated array alternating names and values. Free with
+ * g_strfreev().
+ */
+static gchar **
+rtm_glib_collect_call_params (RtmGlib *rtm, va_list params)
+{
+        gchar **array;
+
+        g_mutex_lock (&rtm->priv->mutex);
+        array = rtm_glib_collect_params_full (params, rtm->priv->auth_token);
+        g_mutex_unlock (&rtm->priv->mutex);
+
+        return array;
+}
+
+/**
+ * rtm_glib_parse_response:
+ * @rtm: a #RtmGlib object.
+ * @payload: the payload of a response.
+ * @error: a #GError to be filled if response is not successful.
+ *
+ * Parses @payload and checks if the response is successful.
+ *
+ * Returns: A #RestXmlNode object with the method response. Or %NULL if the
+ * response is not successful.
+ */
+RestXmlNode *
+rtm_glib_parse_response (RtmGlib *rtm, GBytes *payload, GError **error)
+{
+        g_assert (rtm != NULL);
+        g_assert (payload != NULL);
+
+        RestXmlParser *parser;
+        RestXmlNode *root;
+        const gchar *data;
+        gsize length;
+        GError *tmp_error = NULL;
+
+        data = g_bytes_get_data (payload, &length);
+
+        DEBUG_PRINT ("payload: %.*s", (gint) length, data);
+
+        parser = rest_xml_parser_new ();
+        root = rest_xml_parser_parse_from_data (parser, data, length);
+        g_object_unref (parser);
+
+        if (root == NULL) {
+                g_set_error (
+                        error,
+                        RTM_ERROR_DOMAIN,
+                        RTM_UNKNOWN_ERROR,
+                        "Unknown response from Remember The Milk");
+                return NULL;
+        }
+
+        if (!rtm_glib_check_response (rtm, root, &tmp_error)) {
+                g_propagate_error (error, tmp_error);
+                rest_xml_node_unref (root);
+                return NULL;
+        }
+
+        return root;
+}
+
+/**
+ * rtm_glib_json_next_member:
+ * @reader: a #RtmJsonReader inside an object.
+ * @error: location to store #GError or %NULL.
+ *
+ * Reads the name of the next member of the object, which is got with
+ * rtm_json_reader_get_member().
+ *
+ * Returns: %TRUE if there is a member, %FALSE at the end of the object or on
+ * error.
+ */
+static gboolean
+rtm_glib_json_next_member (RtmJsonReader *reader, GError **error)
+{
+        return rtm_json_reader_next (reader, error) == RTM_JSON_TOKEN_MEMBER;
+}
+
+static gboolean
+rtm_glib_json_is_member (RtmJsonReader *reader, const gchar *name)
+{
+        return strcmp (rtm_json_reader_get_member (reader), name) == 0;
+}
+
+static gboolean
+rtm_glib_json_is_scalar (RtmJsonToken token)
+{
+        return token == RTM_JSON_TOKEN_STRING || token == RTM_JSON_TOKEN_NUMBER;
+}
+
+/**
+ * rtm_glib_json_enter_rsp:
+ * @reader: a new #RtmJsonReader.
+ * @error: location to store #GError or %NULL.
+ *
+ * Moves @reader inside the "rsp" object wrapping every response.
+ *
+ * Returns: %TRUE on success, %FALSE if the response is not valid.
+ */
+static gboolean
+rtm_glib_json_enter_rsp (RtmJsonReader *reader, GError **error)
+{
+        RtmJsonToken token;
+        gboolean is_rsp;
+        GError *tmp_error = NULL;
+
+        if (rtm_json_reader_next (reader, &tmp_error) ==
+            RTM_JSON_TOKEN_BEGIN_OBJECT) {
+                while (rtm_glib_json_next_member (reader, &tmp_error)) {
+                        is_rsp = rtm_glib_json_is_member (reader, "rsp");
+                        token = rtm_json_reader_next (reader, &tmp_error);
+                        if (is_rsp && token == RTM_JSON_TOKEN_BEGIN_OBJECT) {
+                                return TRUE;
+                        }
+                        if (!rtm_json_reader_skip (reader, token,
+                                                   &tmp_error)) {
+                                break;
+                        }
+                }
+        }
+
+        if (tmp_error != NULL) {
+                g_propagate_error (error, tmp_error);
+        } else {
+                g_set_error (
+                        error,
+                        RTM_ERROR_DOMAIN,
+                        RTM_UNKNOWN_ERROR,
+                        "Unknown response from Remember The Milk");
+        }
+
+        return FALSE;
+}
+
+/**
+ * rtm_glib_check_json_response:
+ * @rtm: a #RtmGlib object.
+ * @payload: the payload of a JSON response.
+ * @error: a #GError to be filled if response is not successful.
+ *
+ * Checks if a JSON response is or not successful. Remember The Milk sends
+ * the status first, so only the beginning of a successful response is read.
+ *
+ * Returns: %TRUE if the response is successful.
+ */
+static gboolean
+rtm_glib_check_json_response (RtmGlib *rtm, GBytes *payload, GError **error)
+{
+        RtmJsonReader *reader;
+        RtmJsonToken token;
+        const gchar *data;
+        gsize length;
+        gboolean is_stat, is_err, is_code, ok = FALSE, failed = FALSE;
+        gchar *error_code = NULL, *error_msg = NULL;
+        GError *tmp_error = NULL;
+
+        data = g_bytes_get_data (payload, &length);
+
+        DEBUG_PRINT ("payload: %.*s", (gint) length, data);
+
+        reader = rtm_json_reader_new (data, length);
+
+        if (!rtm_glib_json_enter_rsp (reader, &tmp_error)) {
+                rtm_json_reader_free (reader);
+                g_propagate_error (error, tmp_error);
+                return FALSE;
+        }
+
+        while (!ok && rtm_glib_json_next_member (reader, &tmp_error)) {
+                is_stat = rtm_glib_json_is_member (reader, "stat");
+                is_err = rtm_glib_json_is_member (reader, "err");
+
+                token = rtm_json_reader_next (reader, &tmp_error);
+                if (is_stat && token == RTM_JSON_TOKEN_STRING) {
+                        ok = (strcmp (rtm_json_reader_get_string (reader),
+                                      "ok") == 0);
+                        failed = !ok;
+                } else if (is_err && token == RTM_JSON_TOKEN_BEGIN_OBJECT) {
+                        while (rtm_glib_json_next_member (reader,
+                                                          &tmp_error)) {
+                                is_code = rtm_glib_json_is_member (reader,
+                                                                   "code");
+                                token = rtm_json_reader_next (reader,
+                                                              &tmp_error);
+                                if (!rtm_glib_json_is_scalar (token)) {
+                                        rtm_json_reader_skip (reader, token,
+                                                              &tmp_error);
+                                } else if (is_code) {
+                                        g_free (error_code);
+                                        error_code = g_strdup (
+                                                rtm_json_reader_get_string (
+                                                        reader));
+                                } else if (rtm_glib_json_is_member (reader,
+                                                                    "msg")) {
+                                        g_free (error_msg);
+                                        error_msg = g_strdup (
+                                                rtm_json_reader_get_string (
+                                                        reader));
+                                }
+
+                                if (tmp_error != NULL) {
+                                        break;
+                                }
+                        }
+                } else {
+                        rtm_json_reader_skip (reader, token, &tmp_error);
+                }
+
+                if (tmp_error != NULL) {
+                        break;
+                }
+        }
+
+        rtm_json_reader_free (reader);
+
+        if (!ok) {
+                if (tmp_error != NULL) {
+                        g_propagate_error (error, tmp_error);
+                } else if (failed) {
+                        rtm_glib_set_response_error (error, error_code,
+                                                     error_msg);
+                } else {
+                        g_set_error (
+                                error,
+                                RTM_ERROR_DOMAIN,
+                                RTM_UNKNOWN_ERROR,
+                                "Unknown response from Remember The Milk");
+                }
+        }
+
+        g_free (error_code);
+        g_free (error_msg);
+
+        return ok;
+}
+
+/**
+ * rtm_glib_is_json_call:
+ * @params: %NULL-terminated array alternating names and values.
+ *
+ * Checks if a call asks for a JSON response.
+ *
+ * Returns: %TRUE if the format parameter is "json".
+ */
+static gboolean
+rtm_glib_is_json_call (gchar **params)
+{
+        return g_strcmp0 (rtm_transport_lookup_param (params, "format"),
+                          "json") == 0;
+}
+
+/**
+ * rtm_glib_is_streamed:
+ * @method: the method name.
+ *
+ * Checks if @method is one of the methods whose XML responses are kept as
+ * they are read by rtm_glib_call_method_streamed(), to be parsed without
+ * building a tree. Called through rtm_glib_call_method() they are parsed
+ * into a tree as any other method.
+ *
+ * Returns: %TRUE if @method has a streamed entry point.
+ */
+static gboolean
+rtm_glib_is_streamed (const gchar *method)
+{
+        guint i;
+
+        for (i = 0; rtm_glib_streamed_methods[i] != NULL; i++) {
+                if (g_strcmp0 (rtm_glib_streamed_methods[i], method) == 0) {
+                        return TRUE;
+                }
+        }
+
+        return FALSE;
+}
+
+/* Bytes of a response where the status of the rsp element is looked for */
+#define RTM_GLIB_XML_STATUS_LENGTH 512
+
+/**
+ * rtm_glib_check_xml_response:
+ * @rtm: a #RtmGlib object.
+ * @payload: the payload of a XML response.
+ * @error: a #GError to be filled if response is not successful.
+ *
+ * Checks if a XML response is or not successful. The status of a successful
+ * response is found in the rsp element at its beginning, so only a failed
+ * or unexpected response is parsed to get the error.
+ *
+ * Returns: %TRUE if the response is successful.
+ */
+static gboolean
+rtm_glib_check_xml_response (RtmGlib *rtm, GBytes *payload, GError **error)
+{
+        RestXmlNode *root;
+        const gchar *data, *rsp, *end, *stat;
+        gsize length;
+
+        data = g_bytes_get_data (payload, &length);
+        length = MIN (length, RTM_GLIB_XML_STATUS_LENGTH);
+
+        rsp = g_strstr_len (data, length, "<rsp");
+        if (rsp != NULL) {
+                end = memchr (rsp, '>', length - (rsp - data));
+                if (end != NULL) {
+                        stat = g_strstr_len (rsp, end - rsp, "stat=\"ok\"");
+                        if (stat != NULL) {
+                                return TRUE;
+                        }
+                }
+        }
+
+        root = rtm_glib_parse_response (rtm, payload, error);
+        if (root == NULL) {
+                return FALSE;
+        }
+
+        rest_xml_node_unref (root);
+
+        return TRUE;
+}
+
+/**
+ * rtm_glib_parse_payload:
+ * @rtm: a #RtmGlib object.
+ * @json: whether @payload is a JSON response.
+ * @raw: whether the result is @payload instead of a tree.
+ * @payload: the payload of a response.
+ * @error: a #GError to be filled if response is not successful.
+ *
+ * Checks if the response is successful, parsing it into a tree unless @raw.
+ *
+ * Returns: A #RestXmlNode with the XML response, or a new reference to
+ * @payload if @raw. %NULL if the response is not successful.
+ */
+static gpointer
+rtm_glib_parse_payload (RtmGlib *rtm, gboolean json, gboolean raw,
+                        GBytes *payload, GError **error)
+{
+        gboolean ok;
+
+        if (!raw) {
+                return rtm_glib_parse_response (rtm, payload, error);
+        }
+
+        if (json) {
+                ok = rtm_glib_check_json_response (rtm, payload, error);
+        } else {
+                ok = rtm_glib_check_xml_response (rtm, payload, error);
+        }
+
+        return ok ? g_bytes_ref (payload) : NULL;
+}
+
+static gpointer
+rtm_glib_ref_result (gboolean raw, gpointer result)
+{
+        if (raw) {
+                return g_bytes_ref (result);
+        } else {
+                return rest_xml_node_ref (result);
+        }
+}
+
+static void
+rtm_glib_free_result (gboolean raw, gpointer result)
+{
+        if (raw) {
+                g_bytes_unref (result);
+        } else {
+                rest_xml_node_unref (result);
+        }
+}
+
+/**
+ * rtm_glib_add_json_format:
+ * @params: %NULL-terminated array alternating names and values.
+ *
+ * Adds the parameter asking for a JSON response to @params.
+ *
+ * Returns: the new array, @params is freed.
+ */
+static gchar **
+rtm_glib_add_json_format (gchar **params)
+{
+        guint length;
+
+        length = g_strv_length (params);
+        params = g_renew (gchar *, params, length + 3);
+        params[length] = g_strdup ("format");
+        params[length + 1] = g_strdup ("json");
+        params[length + 2] = NULL;
+
+        return params;
+}
+
+/**
+ * rtm_glib_is_retry_safe:
+ * @method: the method name.
+ *
+ * Checks if @method is one of the methods without side effects.
+ *
+ * Returns: %TRUE if @method can be sent again without changing its result.
+ */
+static gboolean
+rtm_glib_is_retry_safe (const gchar *method)
+{
+        guint i;
+
+        for (i = 0; rtm_glib_read_methods[i] != NULL; i++) {
+                if (g_strcmp0 (rtm_glib_read_methods[i], method) == 0) {
+                        return TRUE;
+                }
+        }
+
+        return FALSE;
+}
+
+static gboolean
+rtm_glib_should_retry (RtmGlib *rtm, const gchar *method, guint attempt,
+                       const GError *error)
+{
+        return attempt < rtm->priv->max_retries &&
+                rtm_error_is_transient (error) &&
+                rtm_glib_is_retry_safe (method);
+}
+
+/**
+ * rtm_glib_reserve_send:
+ * @rtm: a #RtmGlib object.
+ *
+ * Reserves a token of the rate limit shared by the calls with the
+ * #RtmGlib:api_key of @rtm.
+ *
+ * Returns: the time in microseconds the call has to wait before being sent.
+ */
+static gint64
+rtm_glib_reserve_send (RtmGlib *rtm)
+{
+        gint64 delay;
+
+        g_mutex_lock (&rtm->priv->mutex);
+        delay = rtm_rate_limiter_reserve (rtm->priv->api_key);
+        g_mutex_unlock (&rtm->priv->mutex);
+
+        return delay;
+}
+
+/**
+ * rtm_glib_refund_send:
+ * @rtm: a #RtmGlib object.
+ *
+ * Gives back the token reserved with rtm_glib_reserve_send() by a call
+ * dropped before being sent.
+ */
+static void
+rtm_glib_refund_send (RtmGlib *rtm)
+{
+        g_mutex_lock (&rtm->priv->mutex);
+        rtm_rate_limiter_refund (rtm->priv->api_key);
+        g_mutex_unlock (&rtm->priv->mutex);
+}
+
+/**
+ * rtm_glib_get_backoff:
+ * @rtm: a #RtmGlib object.
+ * @attempt: the number of attempts already failed, minus one.
+ *
+ * Gets a random delay between zero and an exponentially growing ceiling,
+ * so clients failing at the same time do not retry at the same time.
+ *
+ * Returns: the delay in microseconds.
+ */
+static gint64
+rtm_glib_get_backoff (RtmGlib *rtm, guint attempt)
+{
+        guint64 ceiling;
+
+        ceiling = (guint64) rtm->priv->retry_base_delay << MIN (attempt, 16);
+        ceiling = MIN (ceiling, rtm->priv->retry_max_delay);
+
+        return (gint64) g_random_int_range (0, ceiling + 1) * 1000;
+}
+
+/*
+ * Time spent in each phase of a call, in microseconds, or -1 for the phases
+ * not reached.
+ */
+typedef struct {
+        gint64 latency[RTM_METHOD_N_PHASES];
+        gssize payload_size;
+} RtmGlibCallTimes;
+
+static void
+rtm_glib_call_times_init (RtmGlibCallTimes *times)
+{
+        guint phase;
+
+        for (phase = 0; phase < RTM_METHOD_N_PHASES; phase++) {
+                times->latency[phase] = -1;
+        }
+        times->payload_size = -1;
+}
+
+static void
+rtm_glib_call_times_add (RtmGlibCallTimes *times, RtmMethodPhase phase,
+                         gint64 start)
+{
+        times->latency[phase] = MAX (times->latency[phase], 0) +
+                g_get_monotonic_time () - start;
+}
+
+/**
+ * rtm_glib_lookup_stats:
+ * @rtm: a #RtmGlib object.
+ * @method: the method name.
+ *
+ * Gets the statistics of @method, creating them if needed. Must be called
+ * with the stats mutex held.
+ *
+ * Returns: the #RtmMethodStats of @method.
+ */
+static RtmMethodStats *
+rtm_glib_lookup_stats (RtmGlib *rtm, const gchar *method)
+{
+        RtmMethodStats *stats;
+
+        stats = g_hash_table_lookup (rtm->priv->stats, method);
+        if (stats == NULL) {
+                stats = rtm_method_stats_new (method);
+                g_hash_table_insert (rtm->priv->stats, g_strdup (method),
+                                     stats);
+        }
+
+        return stats;
+}
+
+/**
+ * rtm_glib_record_call:
+ * @rtm: a #RtmGlib object.
+ * @method: the method name.
+ * @times: the time spent in each phase of the call.
+ * @failed: whether the call failed.
+ *
+ * Adds a finished call to the statistics of @method.
+ */
+static void
+rtm_glib_record_call (RtmGlib *rtm, const gchar *method,
+                      const RtmGlibCallTimes *times, gboolean failed)
+{
+        RtmMethodStats *stats;
+        guint phase;
+
+        g_mutex_lock (&rtm->priv->stats_mutex);
+
+        stats = rtm_glib_lookup_stats (rtm, method);
+        rtm_method_stats_add_call (stats, failed);
+        for (phase = 0; phase < RTM_METHOD_N_PHASES; phase++) {
+                if (times->latency[phase] >= 0) {
+                        rtm_method_stats_add_latency (stats, phase,
+                                                      times->latency[phase]);
+                }
+        }
+        if (times->payload_size >= 0) {
+                rtm_method_stats_add_payload_size (stats,
+                                                   times->payload_size);
+        }
+
+        g_mutex_unlock (&rtm->priv->stats_mutex);
+}
+
+/**
+ * rtm_glib_record_load:
+ * @rtm: a #RtmGlib object.
+ * @method: the method name.
+ * @start: the monotonic time when the objects started to be created.
+ *
+ * Adds the time spent creating the objects of a response to the statistics
+ * of @method.
+ */
+static void
+rtm_glib_record_load (RtmGlib *rtm, const gchar *method, gint64 start)
+{
+        gint64 latency;
+
+        latency = g_get_monotonic_time () - start;
+
+        g_mutex_lock (&rtm->priv->stats_mutex);
+        rtm_method_stats_add_latency (rtm_glib_lookup_stats (rtm, method),
+                                      RTM_METHOD_PHASE_LOAD, latency);
+        g_mutex_unlock (&rtm->priv->stats_mutex);
+}
+
+/**
+ * rtm_glib_call_method_sync:
+ * @rtm: a #RtmGlib object.
+ * @method: the method name to be called.
+ * @params: %NULL-terminated array alternating names and values.
+ * @raw: whether the response is only checked and returned as payload.
+ * @cancellable: optional #GCancellable object, %NULL to ignore.
+ * @error: location to store #GError or %NULL.
+ *
+ * Sends a call to Remember The Milk API from the calling thread. Methods
+ * without side effects are sent again after a transient error, following the
+ * retry policy of @rtm.
+ *
+ * Returns: A #RestXmlNode object with the method response, or a #GBytes with
+ * the payload if @raw. Or %NULL if call fails.
+ */
+static gpointer
+rtm_glib_call_method_sync (RtmGlib *rtm, const gchar *method,
+                           gchar **params, gboolean raw,
+                           GCancellable *cancellable, GError **error)
+{
+        RtmTransport *transport;
+        RtmTimeout *timeout;
+        gpointer result;
+        GBytes *payload;
+        RtmSignedParams signed_params;
+        RtmGlibCallTimes times;
+        gboolean json, slept;
+        gint64 delay, start;
+        guint attempt;
+        GError *call_error = NULL;
+
+        DEBUG_PRINT ("rtm_call_method: %s", method);
+
+        json = raw && rtm_glib_is_json_call (params);
+        rtm_glib_call_times_init (&times);
+
+        for (attempt = 0; ; attempt++) {
+                delay = rtm_glib_reserve_send (rtm);
+
+                start = g_get_monotonic_time ();
+                slept = rtm_timeout_sleep (delay, cancellable);
+                rtm_glib_call_times_add (&times, RTM_METHOD_PHASE_QUEUE,
+                                         start);
+                if (!slept) {
+                        rtm_glib_refund_send (rtm);
+                        g_cancellable_set_error_if_cancelled (cancellable,
+                                                              &call_error);
+                        result = NULL;
+                        break;
+                }
+
+                transport = rtm_glib_ref_transport (rtm);
+                rtm_glib_sign_params (rtm, method, params, &signed_params);
+                timeout = rtm_timeout_new (rtm->priv->timeout, cancellable);
+                rtm_glib_mark_send (rtm);
+
+                start = g_get_monotonic_time ();
+                payload = rtm_transport_send (
+                        transport, signed_params.params,
+                        rtm_timeout_get_cancellable (timeout), &call_error);
+                rtm_glib_call_times_add (&times, RTM_METHOD_PHASE_NETWORK,
+                                         start);
+                if (payload != NULL) {
+                        times.payload_size = g_bytes_get_size (payload);
+
+                        start = g_get_monotonic_time ();
+                        result = rtm_glib_parse_payload (rtm, json, raw,
+                                                         payload,
+                                                         &call_error);
+                        rtm_glib_call_times_add (&times,
+                                                 RTM_METHOD_PHASE_PARSE,
+                                                 start);
+                        g_bytes_unref (payload);
+                } else {
+                        result = NULL;
+                        rtm_timeout_check (timeout, &call_error);
+                }
+
+                rtm_timeout_free (timeout);
+                rtm_signed_params_clear (&signed_params);
+                g_object_unref (transport);
+
+                if (result != NULL ||
+                    !rtm_glib_should_retry (rtm, method, attempt, call_error)) {
+                        break;
+                }
+
+                DEBUG_PRINT ("rtm_call_method: %s failed, retrying: %s",
+                             method, call_error->message);
+                g_clear_error (&call_error);
+
+                start = g_get_monotonic_time ();
+                slept = rtm_timeout_sleep (rtm_glib_get_backoff (rtm, attempt),
+                                           cancellable);
+                rtm_glib_call_times_add (&times, RTM_METHOD_PHASE_QUEUE,
+                                         start);
+                if (!slept) {
+                        g_cancellable_set_error_if_cancelled (cancellable,
+                                                              &call_error);
+                        break;
+                }
+        }
+
+        rtm_glib_record_call (rtm, method, &times, result == NULL);
+
+        if (result == NULL) {
+                g_propagate_error (error, call_error);
+        }
+
+        return result;
+}
+
+static gpointer
+rtm_glib_call_method_params (RtmGlib *rtm, const gchar *method,
+                             gchar **params, gboolean raw,
+                             GCancellable *cancellable, GError **error);
+
+/**
+ * rtm_glib_call_method:
+ * @rtm: a #RtmGlib object.
+ * @method: the method name to be called.
+ * @Varargs: list of parameters (pairs of name and value) terminated by %NULL.
+ *
+ * Calls a method of Remember The Milk API with the arguments passed. Methods
+ * without side effects are sent again after a transient error, following the
+ * retry policy of @rtm. The call is interrupted if the current #GCancellable
+ * of the thread is cancelled.
+ *
+ * Returns: A #RestXmlNode object with the method response. Or %NULL if call
+ * fails.
+ */
+RestXmlNode *
+rtm_glib_call_method (RtmGlib *rtm, gchar *method, GError **error, ...)
+{
+        g_assert (rtm != NULL);
+        g_assert (method != NULL);
+
+        RestXmlNode *root;
+        va_list args;
+        gchar **params;
+
+        va_start (args, error);
+        params = rtm_glib_collect_call_params (rtm, args);
+        va_end (args);
+
+        root = rtm_glib_call_method_params (rtm, method, params, FALSE,
+                                            g_cancellable_get_current (),
+                                            error);
+
+        g_strfreev (params);
+
+        return root;
+}
+
+/**
+ * rtm_glib_call_method_json:
+ * @rtm: a #RtmGlib object.
+ * @method: the method name to be called.
+ * @Varargs: list of parameters (pairs of name and value) terminated by %NULL.
+ *
+ * Same as rtm_glib_call_method() but asking for a JSON response, which is
+ * only checked to be successful.
+ *
+ * Returns: the payload of the response. Or %NULL if call fails. Free with
+ * g_bytes_unref().
+ */
+GBytes *
+rtm_glib_call_method_json (RtmGlib *rtm, gchar *method, GError **error, ...)
+{
+        g_assert (rtm != NULL);
+        g_assert (method != NULL);
+
+        GBytes *payload;
+        va_list args;
+        gchar **params;
+
+        va_start (args, error);
+        params = rtm_glib_add_json_format (
+                rtm_glib_collect_call_params (rtm, args));
+        va_end (args);
+
+        payload = rtm_glib_call_method_params (rtm, method, params, TRUE,
+                                               g_cancellable_get_current (),
+                                               error);
+
+        g_strfreev (params);
+
+        return payload;
+}
+
+/**
+ * rtm_glib_call_method_streamed:
+ * @rtm: a #RtmGlib object.
+ * @method: the name of a method whose response is streamed.
+ * @Varargs: list of parameters (pairs of name and value) terminated by %NULL.
+ *
+ * Same as rtm_glib_call_method() but for the methods whose XML response is
+ * not parsed into a tree, which is only checked to be successful.
+ *
+ * Returns: the payload of the response. Or %NULL if call fails. Free with
+ * g_bytes_unref().
+ */
+static GBytes *
+rtm_glib_call_method_streamed (RtmGlib *rtm, gchar *method, GError **error,
+                               ...)
+{
+        g_assert (rtm != NULL);
+        g_assert (rtm_glib_is_streamed (method));
+
+        GBytes *payload;
+        va_list args;
+        gchar **params;
+
+        va_start (args, error);
+        params = rtm_glib_collect_call_params (rtm, args);
+        va_end (args);
+
+        payload = rtm_glib_call_method_params (rtm, method, params, TRUE,
+                                               g_cancellable_get_current (),
+                                               error);
+
+        g_strfreev (params);
+
+        return payload;
+}
+
+/*
+ * A call in progress. Concurrent calls to the same read method with the same
+ * parameters share a single flight, so only one request is sent for all of
+ * them. Each asynchronous caller gets its own #GTask. A synchronous flight is
+ * sent by the thread that started it, the other threads wait for its result.
+ */
+typedef struct {
+        gint ref_count;
+        RtmGlib *rtm;
+        gchar *key;
+        gchar *method;
+        gchar **params;
+        RtmSignature signature;
+        gboolean json;
+        gboolean raw;
+        guint attempt;
+        RtmTransport *transport;
+        RtmTimeout *timeout;
+        RtmGlibCallTimes times;
+        gint64 phase_start;
+        GCancellable *cancellable;
+        GMainContext *context;
+        GList *tasks;
+        gboolean sync;
+        gboolean done;
+        gpointer result;
+        GError *error;
+} RtmGlibFlight;
+
+typedef struct {
+        RtmGlibFlight *flight;
+        GCancellable *cancellable;
+        gulong cancelled_id;
+        gboolean completed;
+} RtmGlibCallData;
+
+static RtmGlibFlight *
+rtm_glib_flight_ref (RtmGlibFlight *flight)
+{
+        g_atomic_int_inc (&flight->ref_count);
+
+        return flight;
+}
+
+static void
+rtm_glib_flight_unref (RtmGlibFlight *flight)
+{
+        if (!g_atomic_int_dec_and_test (&flight->ref_count)) {
+                return;
+        }
+
+        g_assert (flight->tasks == NULL);
+
+        if (flight->transport) {
+                g_object_unref (flight->transport);
+        }
+        if (flight->cancellable) {
+                g_object_unref (flight->cancellable);
+        }
+        if (flight->context) {
+                g_main_context_unref (flight->context);
+        }
+        if (flight->result) {
+                rtm_glib_free_result (flight->raw, flight->result);
+        }
+        g_clear_error (&flight->error);
+        g_object_unref (flight->rtm);
+        g_free (flight->key);
+        g_free (flight->method);
+        g_strfreev (flight->params);
+        rtm_signature_clear (&flight->signature);
+
+        g_slice_free (RtmGlibFlight, flight);
+}
+
+static gint
+rtm_glib_flight_compare_pairs (gconstpointer a, gconstpointer b)
+{
+        return strcmp (*(const gchar **) a, *(const gchar **) b);
+}
+
+/**
+ * rtm_glib_flight_key:
+ * @method: the method name.
+ * @raw: whether the call returns the payload instead of a tree.
+ * @params: %NULL-terminated array alternating names and values.
+ *
+ * Builds the key identifying a call, which does not depend on the order of
+ * the parameters. Each string is prefixed by its length, so values can not
+ * be confused with separators. Calls returning a tree and calls returning
+ * the payload never share a flight.
+ *
+ * Returns: a newly allocated string.
+ */
+static gchar *
+rtm_glib_flight_key (const gchar *method, gboolean raw, gchar **params)
+{
+        GPtrArray *pairs;
+        GString *key;
+        gchar *pair;
+        guint i;
+
+        pairs = g_ptr_array_new_with_free_func (g_free);
+        for (i = 0; params != NULL && params[i] != NULL; i += 2) {
+                g_ptr_array_add (pairs, g_strdup_printf (
+                                         "%" G_GSIZE_FORMAT ":%s"
+                                         "%" G_GSIZE_FORMAT ":%s",
+                                         strlen (params[i]), params[i],
+                                         strlen (params[i + 1]),
+                                         params[i + 1]));
+        }
+        g_ptr_array_sort (pairs, rtm_glib_flight_compare_pairs);
+
+        key = g_string_new (method);
+        if (raw) {
+                g_string_append (key, "\nraw");
+        }
+        for (i = 0; i < pairs->len; i++) {
+                pair = g_ptr_array_index (pairs, i);
+                g_string_append_c (key, '\n');
+                g_string_append (key, pair);
+        }
+
+        g_ptr_array_free (pairs, TRUE);
+
+        return g_string_free (key, FALSE);
+}
+
+/**
+ * rtm_glib_flight_land:
+ * @flight: a #RtmGlibFlight.
+ *
+ * Stops sharing @flight with new callers, once it is finished or nobody
+ * waits for it anymore. Must be called with the mutex held.
+ */
+static void
+rtm_glib_flight_land (RtmGlibFlight *flight)
+{
+        if (flight->key != NULL &&
+            g_hash_table_lookup (flight->rtm->priv->flights,
+                                 flight->key) == flight) {
+                g_hash_table_remove (flight->rtm->priv->flights, flight->key);
+        }
+}
+
+/**
+ * rtm_glib_flight_has_tasks:
+ * @flight: a #RtmGlibFlight.
+ *
+ * Checks if a caller is still waiting for @flight. Callers can cancel from
+ * other threads.
+ *
+ * Returns: %TRUE if some caller did not cancel.
+ */
+static gboolean
+rtm_glib_flight_has_tasks (RtmGlibFlight *flight)
+{
+        gboolean has_tasks;
+
+        g_mutex_lock (&flight->rtm->priv->mutex);
+        has_tasks = (flight->tasks != NULL);
+        g_mutex_unlock (&flight->rtm->priv->mutex);
+
+        return has_tasks;
+}
+
+static void
+rtm_glib_call_data_free (RtmGlibCallData *data)
+{
+        if (data->cancelled_id) {
+                g_cancellable_disconnect (data->cancellable,
+                                          data->cancelled_id);
+        }
+        if (data->cancellable) {
+                g_object_unref (data->cancellable);
+        }
+        rtm_glib_flight_unref (data->flight);
+
+        g_slice_free (RtmGlibCallData, data);
+}
+
+static gboolean
+rtm_glib_call_method_cancel_idle (gpointer user_data)
+{
+        GTask *task = G_TASK (user_data);
+        RtmGlibCallData *data = g_task_get_task_data (task);
+        RtmGlibFlight *flight = data->flight;
+        GMutex *mutex = &flight->rtm->priv->mutex;
+        gboolean abandoned;
+
+        g_mutex_lock (mutex);
+
+        if (data->completed) {
+                g_mutex_unlock (mutex);
+                return FALSE;
+        }
+        data->completed = TRUE;
+
+        flight->tasks = g_list_remove (flight->tasks, task);
+
+        /* Only abort the request if no other caller is waiting for it, a
+         * synchronous flight is waited for by the thread sending it */
+        abandoned = (flight->tasks == NULL && !flight->sync);
+        if (abandoned) {
+                rtm_glib_flight_land (flight);
+        }
+
+        g_mutex_unlock (mutex);
+
+        rtm_glib_flight_ref (flight);
+
+        g_task_return_error_if_cancelled (task);
+        g_object_unref (task);
+
+        if (abandoned) {
+                g_cancellable_cancel (flight->cancellable);
+        }
+
+        rtm_glib_flight_unref (flight);
+
+        return FALSE;
+}
+
+static void
+rtm_glib_call_method_cancelled_cb (GCancellable *cancellable, GTask *task)
+{
+        GSource *source;
+
+        /* The task can not be completed from inside the "cancelled" handler,
+         * as that would disconnect the handler while it is running */
+        source = g_idle_source_new ();
+        g_source_set_callback (source, rtm_glib_call_method_cancel_idle,
+                               g_object_ref (task), g_object_unref);
+        g_source_attach (source, g_task_get_context (task));
+        g_source_unref (source);
+}
+
+/**
+ * rtm_glib_flight_complete:
+ * @flight: a #RtmGlibFlight.
+ * @result: the parsed response, or %NULL.
+ * @error: the error if @result is %NULL.
+ *
+ * Returns the result of @flight to every caller waiting for it.
+ */
+static void
+rtm_glib_flight_complete (RtmGlibFlight *flight, gpointer result,
+                          const GError *error)
+{
+        GList *tasks, *item;
+        GTask *task;
+        RtmGlibCallData *data;
+
+        g_mutex_lock (&flight->rtm->priv->mutex);
+
+        rtm_glib_flight_land (flight);
+
+        if (flight->sync) {
+                if (result != NULL) {
+                        flight->result = rtm_glib_ref_result (flight->raw,
+                                                              result);
+                } else {
+                        flight->error = g_error_copy (error);
+                }
+                flight->done = TRUE;
+                g_cond_broadcast (&flight->rtm->priv->flights_cond);
+        }
+
+        tasks = flight->tasks;
+        flight->tasks = NULL;
+
+        for (item = tasks; item; item = item->next) {
+                data = g_task_get_task_data (item->data);
+                data->completed = TRUE;
+        }
+
+        g_mutex_unlock (&flight->rtm->priv->mutex);
+
+        for (item = tasks; item; item = item->next) {
+                task = G_TASK (item->data);
+
+                if (result == NULL) {
+                        g_task_return_error (task, g_error_copy (error));
+                } else if (flight->raw) {
+                        g_task_return_pointer (
+                                task, rtm_glib_ref_result (TRUE, result),
+                                (GDestroyNotify) g_bytes_unref);
+                } else {
+                        g_task_return_pointer (
+                                task, rtm_glib_ref_result (FALSE, result),
+                                (GDestroyNotify) rest_xml_node_unref);
+                }
+                g_object_unref (task);
+        }
+
+        g_list_free (tasks);
+}
+
+static void
+rtm_glib_call_method_schedule (RtmGlibFlight *flight, gint64 backoff);
+
+static void
+rtm_glib_call_method_cb (GObject *source_object, GAsyncResult *result,
+                         gpointer user_data)
+{
+        RtmGlibFlight *flight = user_data;
+        RtmGlib *rtm = flight->rtm;
+        gpointer parsed = NULL;
+        GBytes *payload;
+        gint64 start;
+        GError *tmp_error = NULL;
+
+        payload = rtm_transport_send_finish (RTM_TRANSPORT (source_object),
+                                             result, &tmp_error);
+        rtm_glib_call_times_add (&flight->times, RTM_METHOD_PHASE_NETWORK,
+                                 flight->phase_start);
+        if (payload == NULL) {
+                rtm_timeout_check (flight->timeout, &tmp_error);
+        }
+        rtm_timeout_free (flight->timeout);
+        flight->timeout = NULL;
+
+        /* Every caller cancelled */
+        if (!rtm_glib_flight_has_tasks (flight)) {
+                rtm_glib_record_call (rtm, flight->method, &flight->times,
+                                      TRUE);
+                if (payload != NULL) {
+                        g_bytes_unref (payload);
+                } else {
+                        g_error_free (tmp_error);
+                }
+                rtm_glib_flight_unref (flight);
+                return;
+        }
+
+        if (payload != NULL) {
+                flight->times.payload_size = g_bytes_get_size (payload);
+
+                start = g_get_monotonic_time ();
+                parsed = rtm_glib_parse_payload (rtm, flight->json,
+                                                 flight->raw, payload,
+                                                 &tmp_error);
+                rtm_glib_call_times_add (&flight->times,
+                                         RTM_METHOD_PHASE_PARSE, start);
+                g_bytes_unref (payload);
+        }
+
+        if (parsed == NULL &&
+            rtm_glib_should_retry (rtm, flight->method, flight->attempt,
+                                   tmp_error)) {
+                DEBUG_PRINT ("rtm_call_method_async: %s failed, retrying: %s",
+                             flight->method, tmp_error->message);
+                g_error_free (tmp_error);
+
+                rtm_glib_call_method_schedule (
+                        flight, rtm_glib_get_backoff (rtm, flight->attempt));
+                flight->attempt++;
+
+                rtm_glib_flight_unref (flight);
+                return;
+        }
+
+        rtm_glib_record_call (rtm, flight->method, &flight->times,
+                              parsed == NULL);
+        rtm_glib_flight_complete (flight, parsed, tmp_error);
+
+        if (parsed != NULL) {
+                rtm_glib_free_result (flight->raw, parsed);
+        } else {
+                g_error_free (tmp_error);
+        }
+
+        rtm_glib_flight_unref (flight);
+}
+
+static gboolean
+rtm_glib_call_method_send (gpointer user_data)
+{
+        RtmGlibFlight *flight = user_data;
+        RtmSignedParams signed_params;
+
+        /* Cancelled while waiting for the rate limit or the backoff */
+        if (!rtm_glib_flight_has_tasks (flight)) {
+                rtm_glib_refund_send (flight->rtm);
+                return FALSE;
+        }
+
+        rtm_glib_call_times_add (&flight->times, RTM_METHOD_PHASE_QUEUE,
+                                 flight->phase_start);
+        flight->phase_start = g_get_monotonic_time ();
+
+        if (flight->signature.request != NULL) {
+                rtm_request_assemble (&flight->signature, flight->params,
+                                      &signed_params);
+        } else {
+                rtm_glib_sign_params (flight->rtm, flight->method,
+                                      flight->params, &signed_params);
+        }
+        flight->timeout = rtm_timeout_new (flight->rtm->priv->timeout,
+                                           flight->cancellable);
+        rtm_glib_mark_send (flight->rtm);
+
+        rtm_transport_send_async (flight->transport, signed_params.params,
+                                  rtm_timeout_get_cancellable (flight->timeout),
+                                  rtm_glib_call_method_cb,
+                                  rtm_glib_flight_ref (flight));
+
+        rtm_signed_params_clear (&signed_params);
+
+        return FALSE;
+}
+
+/**
+ * rtm_glib_call_method_schedule:
+ * @flight: a #RtmGlibFlight.
+ * @backoff: extra time in microseconds to wait before sending the call.
+ *
+ * Sends the call once the rate limit and @backoff allow it.
+ */
+static void
+rtm_glib_call_method_schedule (RtmGlibFlight *flight, gint64 backoff)
+{
+        RtmGlib *rtm = flight->rtm;
+        GSource *source;
+        gint64 delay;
+
+        delay = rtm_glib_reserve_send (rtm);
+        delay += backoff;
+
+        flight->phase_start = g_get_monotonic_time ();
+
+        if (delay > 0) {
+                source = g_timeout_source_new ((delay + 999) / 1000);
+                g_source_set_callback (source, rtm_glib_call_method_send,
+                                       rtm_glib_flight_ref (flight),
+                                       (GDestroyNotify) rtm_glib_flight_unref);
+                g_source_attach (source, flight->context);
+                g_source_unref (source);
+        } else {
+                rtm_glib_call_method_send (flight);
+        }
+}
+
+/**
+ * rtm_glib_call_method_start:
+ * @rtm: a #RtmGlib object.
+ * @method: the method name to be called.
+ * @params: %NULL-terminated array alternating names and values.
+ * @signature: the #RtmSignature of the call, taken by the flight, or %NULL
+ * to sign it when sent.
+ * @raw: whether the response is only checked and returned as payload.
+ * @cancellable: optional #GCancellable object, %NULL to ignore.
+ * @callback: a #GAsyncReadyCallback to call when the request is satisfied.
+ * @user_data: the data to pass to callback function.
+ *
+ * Starts an asynchronous call, joining the one in flight if there is one.
+ */
+static void
+rtm_glib_call_method_start (RtmGlib *rtm, const gchar *method,
+                            gchar **params, RtmSignature *signature,
+                            gboolean raw, GCancellable *cancellable,
+                            GAsyncReadyCallback callback, gpointer user_data)
+{
+        g_assert (rtm != NULL);
+        g_assert (method != NULL);
+
+        GTask *task;
+        RtmGlibCallData *data;
+        RtmGlibFlight *flight = NULL;
+        RtmTransport *transport;
+        gchar *key = NULL;
+        gboolean new_flight;
+
+        task = g_task_new (rtm, cancellable, callback, user_data);
+        g_task_set_source_tag (task, rtm_glib_call_method_async);
+
+        /* Taken before the lock, the transport is created under it */
+        transport = rtm_glib_ref_transport (rtm);
+
+        g_mutex_lock (&rtm->priv->mutex);
+
+        if (rtm_glib_is_retry_safe (method)) {
+                key = rtm_glib_flight_key (method, raw, params);
+                flight = g_hash_table_lookup (rtm->priv->flights, key);
+        }
+
+        new_flight = (flight == NULL);
+        if (!new_flight) {
+                DEBUG_PRINT ("rtm_call_method_async: %s joins the call in "
+                             "flight", method);
+                g_free (key);
+        } else {
+                DEBUG_PRINT ("rtm_call_method_async: %s", method);
+
+                flight = g_slice_new0 (RtmGlibFlight);
+                flight->rtm = g_object_ref (rtm);
+                flight->key = key;
+                flight->method = g_strdup (method);
+                flight->params = g_strdupv (params);
+                if (signature != NULL) {
+                        flight->signature = *signature;
+                        signature->request = NULL;
+                }
+                flight->raw = raw;
+                flight->json = raw && rtm_glib_is_json_call (params);
+                rtm_glib_call_times_init (&flight->times);
+                flight->transport = transport;
+                flight->cancellable = g_cancellable_new ();
+                flight->context = g_main_context_ref (g_task_get_context (task));
+
+                if (key != NULL) {
+                        g_hash_table_insert (rtm->priv->flights,
+                                             g_strdup (key), flight);
+                }
+        }
+
+        data = g_slice_new0 (RtmGlibCallData);
+        data->flight = rtm_glib_flight_ref (flight);
+        g_task_set_task_data (task, data,
+                              (GDestroyNotify) rtm_glib_call_data_free);
+
+        /* The flight keeps a reference to each task until it is completed */
+        flight->tasks = g_list_append (flight->tasks, task);
+
+        g_mutex_unlock (&rtm->priv->mutex);
+
+        if (!new_flight) {
+                g_object_unref (transport);
+        }
+
+        if (cancellable) {
+                data->cancellable = g_object_ref (cancellable);
+                data->cancelled_id = g_cancellable_connect (
+                        cancellable,
+                        G_CALLBACK (rtm_glib_call_method_cancelled_cb),
+                        task, NULL);
+        }
+
+        if (new_flight) {
+                rtm_glib_call_method_schedule (flight, 0);
+        }
+}
+
+static void
+rtm_glib_flight_cancelled_cb (GCancellable *cancellable, RtmGlib *rtm)
+{
+        g_mutex_lock (&rtm->priv->mutex);
+        g_cond_broadcast (&rtm->priv->flights_cond);
+        g_mutex_unlock (&rtm->priv->mutex);
+}
+
+/**
+ * rtm_glib_flight_wait:
+ * @flight: a synchronous #RtmGlibFlight.
+ * @cancellable: optional #GCancellable object, %NULL to ignore.
+ * @error: location to store #GError or %NULL.
+ *
+ * Blocks until the thread sending @flight completes it, or until
+ * @cancellable is cancelled.
+ *
+ * Returns: a new reference to the result of @flight, or %NULL if it failed.
+ */
+static gpointer
+rtm_glib_flight_wait (RtmGlibFlight *flight, GCancellable *cancellable,
+                      GError **error)
+{
+        RtmGlibPrivate *priv = flight->rtm->priv;
+        gulong cancelled_id = 0;
+        gboolean done;
+
+        /* Connected without the lock, the handler takes it */
+        if (cancellable) {
+                cancelled_id = g_cancellable_connect (
+                        cancellable,
+                        G_CALLBACK (rtm_glib_flight_cancelled_cb),
+                        flight->rtm, NULL);
+        }
+
+        g_mutex_lock (&priv->mutex);
+        while (!flight->done && !g_cancellable_is_cancelled (cancellable)) {
+                g_cond_wait (&priv->flights_cond, &priv->mutex);
+        }
+        done = flight->done;
+        g_mutex_unlock (&priv->mutex);
+
+        if (cancelled_id) {
+                g_cancellable_disconnect (cancellable, cancelled_id);
+        }
+
+        /* The result does not change once the flight is done */
+        if (!done) {
+                g_cancellable_set_error_if_cancelled (cancellable, error);
+                return NULL;
+        } else if (flight->result == NULL) {
+                g_propagate_error (error, g_error_copy (flight->error));
+                return NULL;
+        }
+
+        return rtm_glib_ref_result (flight->raw, flight->result);
+}
+
+/**
+ * rtm_glib_call_method_params:
+ * @rtm: a #RtmGlib object.
+ * @method: the method name to be called.
+ * @params: %NULL-terminated array alternating names and values.
+ * @raw: whether the response is only checked and returned as payload.
+ * @cancellable: optional #GCancellable object, %NULL to ignore.
+ * @error: location to store #GError or %NULL.
+ *
+ * Calls a method of Remember The Milk API with the arguments passed. Methods
+ * without side effects are sent again after a transient error, following the
+ * retry policy of @rtm.
+ *
+ * If another thread is already calling the same read method with the same
+ * parameters, no new request is sent and both get the same response.
+ *
+ * Returns: A #RestXmlNode object with the method response, or a #GBytes with
+ * the payload if @raw. Or %NULL if call fails.
+ */
+static gpointer
+rtm_glib_call_method_params (RtmGlib *rtm, const gchar *method,
+                             gchar **params, gboolean raw,
+                             GCancellable *cancellable, GError **error)
+{
+        RtmGlibFlight *flight;
+        gpointer result;
+        gchar *key;
+        GError *tmp_error = NULL;
+
+        if (!rtm_glib_is_retry_safe (method)) {
+                return rtm_glib_call_method_sync (rtm, method, params, raw,
+                                                  cancellable, error);
+        }
+
+        key = rtm_glib_flight_key (method, raw, params);
+
+        for (;;) {
+                g_mutex_lock (&rtm->priv->mutex);
+
+                flight = g_hash_table_lookup (rtm->priv->flights, key);
+                if (flight != NULL && flight->sync) {
+                        rtm_glib_flight_ref (flight);
+                        g_mutex_unlock (&rtm->priv->mutex);
+
+                        DEBUG_PRINT ("rtm_call_method: %s joins the call in "
+                                     "flight", method);
+
+                        result = rtm_glib_flight_wait (flight, cancellable,
+                                                       &tmp_error);
+                        rtm_glib_flight_unref (flight);
+
+                        /* The thread sending it was cancelled, not this one */
+                        if (result == NULL &&
+                            g_error_matches (tmp_error, G_IO_ERROR,
+                                             G_IO_ERROR_CANCELLED) &&
+                            !g_cancellable_is_cancelled (cancellable)) {
+                                g_clear_error (&tmp_error);
+                                continue;
+                        }
+                        break;
+                }
+
+                /* An asynchronous flight is completed from a main context,
+                 * maybe the one of this thread, so it is not waited for */
+                if (flight == NULL) {
+                        flight = g_slice_new0 (RtmGlibFlight);
+                        flight->ref_count = 1;
+                        flight->rtm = g_object_ref (rtm);
+                        flight->key = g_strdup (key);
+                        flight->method = g_strdup (method);
+                        flight->raw = raw;
+                        flight->sync = TRUE;
+                        g_hash_table_insert (rtm->priv->flights,
+                                             g_strdup (key), flight);
+                } else {
+                        flight = NULL;
+                }
+
+                g_mutex_unlock (&rtm->priv->mutex);
+
+                result = rtm_glib_call_method_sync (rtm, method, params, raw,
+                                                    cancellable, &tmp_error);
+                if (flight != NULL) {
+                        rtm_glib_flight_complete (flight, result, tmp_error);
+                        rtm_glib_flight_unref (flight);
+                }
+                break;
+        }
+
+        g_free (key);
+
+        if (result == NULL) {
+                g_propagate_error (error, tmp_error);
+        }
+
+        return result;
+}
+
+/**
+ * rtm_glib_call_method_params_async:
+ * @rtm: a #RtmGlib object.
+ * @method: the method name to be called.
+ * @params: %NULL-terminated array alternating names and values.
+ * @cancellable: optional #GCancellable object, %NULL to ignore.
+ * @callback: a #GAsyncReadyCallback to call when the request is satisfied.
+ * @user_data: the data to pass to callback function.
+ *
+ * Same as rtm_glib_call_method_async() but taking the parameters from an
+ * array. The result is got with rtm_glib_call_method_finish().
+ *
+ * If a call to the same read method with the same parameters is already in
+ * flight, no new request is sent and both callers get the same response.
+ */
+void
+rtm_glib_call_method_params_async (RtmGlib *rtm, const gchar *method,
+                                   gchar **params, GCancellable *cancellable,
+                                   GAsyncReadyCallback callback,
+                                   gpointer user_data)
+{
+        rtm_glib_call_method_start (rtm, method, params, NULL, FALSE,
+                                    cancellable, callback, user_data);
+}
+
+/**
+ * rtm_glib_call_method_signed_async:
+ * @rtm: a #RtmGlib object.
+ * @method: the method name to be called.
+ * @params: %NULL-terminated array alternating names and values.
+ * @signature: the #RtmSignature of the call filled by rtm_glib_presign(),
+ * which is cleared.
+ * @cancellable: optional #GCancellable object, %NULL to ignore.
+ * @callback: a #GAsyncReadyCallback to call when the request is satisfied.
+ * @user_data: the data to pass to callback function.
+ *
+ * Same as rtm_glib_call_method_params_async() but for a call already
+ * signed, which is sent, and sent again if retried, with @signature.
+ */
+void
+rtm_glib_call_method_signed_async (RtmGlib *rtm, const gchar *method,
+                                   gchar **params, RtmSignature *signature,
+                                   GCancellable *cancellable,
+                                   GAsyncReadyCallback callback,
+                                   gpointer user_data)
+{
+        rtm_glib_call_method_start (rtm, method, params, signature, FALSE,
+                                    cancellable, callback, user_data);
+
+        /* Not taken if the call joined one in flight */
+        rtm_signature_clear (signature);
+}
+
+/**
+ * rtm_glib_call_method_async:
+ * @rtm: a #RtmGlib object.
+ * @method: the method name to be called.
+ * @cancellable: optional #GCancellable object, %NULL to ignore.
+ * @callback: a #GAsyncReadyCallback to call when the request is satisfied.
+ * @user_data: the data to pass to callback function.
+ * @Varargs: list of parameters (pairs of name and value) terminated by %NULL.
+ *
+ * Asynchronously calls a method of Remember The Milk API with the arguments
+ * passed. The call is run in the main loop, so many calls can be in flight at
+ * the same time.
+ */
+void
+rtm_glib_call_method_async (RtmGlib *rtm, gchar *method,
+                            GCancellable *cancellable,
+                            GAsyncReadyCallback callback, gpointer user_data,
+                            ...)
+{
+        g_assert (rtm != NULL);
+        g_assert (method != NULL);
+
+        va_list args;
+        gchar **params;
+
+        va_start (args, user_data);
+        params = rtm_glib_collect_call_params (rtm, args);
+        va_end (args);
+
+        rtm_glib_call_method_params_async (rtm, method, params, cancellable,
+                                           callback, user_data);
+
+        g_strfreev (params);
+}
+
+/**
+ * rtm_glib_call_method_finish:
+ * @rtm: a #RtmGlib object.
+ * @result: the #GAsyncResult passed to the callback.
+ * @error: location to store #GError or %NULL.
+ *
+ * Finishes an operation started with rtm_glib_call_method_async().
+ *
+ * Returns: A #RestXmlNode object with the method response. Or %NULL if call
+ * fails.
+ */
+RestXmlNode *
+rtm_glib_call_method_finish (RtmGlib *rtm, GAsyncResult *result,
+                             GError **error)
+{
+        g_return_val_if_fail (g_task_is_valid (result, rtm), NULL);
+
+        RtmGlibCallData *data;
+
+        data = g_task_get_task_data (G_TASK (result));
+        g_return_val_if_fail (!data->flight->raw, NULL);
+
+        return g_task_propagate_pointer (G_TASK (result), error);
+}
+
+/**
+ * rtm_glib_call_method_json_async:
+ * @rtm: a #RtmGlib object.
+ * @method: the method name to be called.
+ * @cancellable: optional #GCancellable object, %NULL to ignore.
+ * @callback: a #GAsyncReadyCallback to call when the request is satisfied.
+ * @user_data: the data to pass to callback function.
+ * @Varargs: list of parameters (pairs of name and value) terminated by %NULL.
+ *
+ * Same as rtm_glib_call_method_async() but asking for a JSON response. The
+ * result is got with rtm_glib_call_method_json_finish().
+ */
+void
+rtm_glib_call_method_json_async (RtmGlib *rtm, gchar *method,
+                                 GCancellable *cancellable,
+                                 GAsyncReadyCallback callback,
+                                 gpointer user_data, ...)
+{
+        g_assert (rtm != NULL);
+        g_assert (method != NULL);
+
+        va_list args;
+        gchar **params;
+
+        va_start (args, user_data);
+        params = rtm_glib_add_json_format (
+                rtm_glib_collect_call_params (rtm, args));
+        va_end (args);
+
+        rtm_glib_call_method_start (rtm, method, params, NULL, TRUE,
+                                    cancellable, callback, user_data);
+
+        g_strfreev (params);
+}
+
+/**
+ * rtm_glib_call_method_streamed_async:
+ * @rtm: a #RtmGlib object.
+ * @method: the name of a method whose response is streamed.
+ * @cancellable: optional #GCancellable object, %NULL to ignore.
+ * @callback: a #GAsyncReadyCallback to call when the request is satisfied.
+ * @user_data: the data to pass to callback function.
+ * @Varargs: list of parameters (pairs of name and value) terminated by %NULL.
+ *
+ * Same as rtm_glib_call_method_async() but for the methods whose XML
+ * response is not parsed into a tree. The result is got with
+ * rtm_glib_call_method_json_finish().
+ */
+static void
+rtm_glib_call_method_streamed_async (RtmGlib *rtm, gchar *method,
+                                     GCancellable *cancellable,
+                                     GAsyncReadyCallback callback,
+                                     gpointer user_data, ...)
+{
+        g_assert (rtm != NULL);
+        g_assert (rtm_glib_is_streamed (method));
+
+        va_list args;
+        gchar **params;
+
+        va_start (args, user_data);
+        params = rtm_glib_collect_call_params (rtm, args);
+        va_end (args);
+
+        rtm_glib_call_method_start (rtm, method, params, NULL, TRUE,
+                                    cancellable, callback, user_data);
+
+        g_strfreev (params);
+}
+
+/**
+ * rtm_glib_call_method_json_finish:
+ * @rtm: a #RtmGlib object.
+ * @result: the #GAsyncResult passed to the callback.
+ * @error: location to store #GError or %NULL.
+ *
+ * Finishes an operation started with rtm_glib_call_method_json_async() or
+ * rtm_glib_call_method_streamed_async().
+ *
+ * Returns: the payload of the response. Or %NULL if call fails. Free with
+ * g_bytes_unref().
+ */
+GBytes *
+rtm_glib_call_method_json_finish (RtmGlib *rtm, GAsyncResult *result,
+                                  GError **error)
+{
+        g_return_val_if_fail (g_task_is_valid (result, rtm), NULL);
+
+        RtmGlibCallData *data;
+
+        data = g_task_get_task_data (G_TASK (result));
+        g_return_val_if_fail (data->flight->raw, NULL);
+
+        return g_task_propagate_pointer (G_TASK (result), error);
+}
+
+/**
+ * rtm_glib_call_method_is_json:
+ * @result: the #GAsyncResult of an asynchronous call.
+ *
+ * Checks if an asynchronous call asked for a JSON response, so its result
+ * has to be got with rtm_glib_call_method_json_finish().
+ *
+ * Returns: %TRUE if the call asked for a JSON response.
+ */
+gboolean
+rtm_glib_call_method_is_json (GAsyncResult *result)
+{
+        RtmGlibCallData *data;
+
+        data = g_task_get_task_data (G_TASK (result));
+
+        return data->flight->json;
+}
+
+/**
+ * rtm_glib_parse_content:
+ * @root: the root #RestXmlNode of a successful response.
+ * @tag: the name of the node to look for.
+ *
+ * Gets the content of the first node named @tag in the response.
+ *
+ * Returns: A copy of the node content.
+ */
+static gchar *
+rtm_glib_parse_content (RestXmlNode *root, const gchar *tag)
+{
+        RestXmlNode *node;
+        gchar *content;
+
+        node = rest_xml_node_find (root, tag);
+        content = g_strdup (node->content);
+        DEBUG_PRINT ("%s: %s", tag, content);
+
+        return content;
+}
+
+/**
+ * rtm_glib_parse_transaction_id:
+ * @root: the root #RestXmlNode of a successful response.
+ *
+ * Gets the transaction identifier of a response.
+ *
+ * Returns: The transaction identifier.
+ */
+static gchar *
+rtm_glib_parse_transaction_id (RestXmlNode *root)
+{
+        RestXmlNode *node;
+        gchar *transaction_id;
+
+        node = rest_xml_node_find (root, "transaction");
+        transaction_id = g_strdup (rest_xml_node_get_attr (node, "id"));
+        DEBUG_PRINT ("transaction_id: %s", transaction_id);
+
+        return transaction_id;
+}
+
+static gboolean
+rtm_glib_parse_test_echo (RtmGlib *rtm, RestXmlNode *root)
+{
+        RestXmlNode *node;
+        gboolean valid;
+
+        node = rest_xml_node_find (root, "api_key");
+        g_mutex_lock (&rtm->priv->mutex);
+        valid = (g_strcmp0 (node->content, rtm->priv->api_key) == 0);
+        g_mutex_unlock (&rtm->priv->mutex);
+
+        node = rest_xml_node_find (root, "method");
+        DEBUG_PRINT ("method: %s", node->content);
+
+        return valid;
+}
+
+static gchar *
+rtm_glib_parse_username (RestXmlNode *root)
+{
+        RestXmlNode *node;
+
+        node = rest_xml_node_find (root, "user");
+        DEBUG_PRINT ("user_id: %s", rest_xml_node_get_attr (node, "id"));
+
+        return rtm_glib_parse_content (root, "username");
+}
+
+static RtmTask *
+rtm_glib_parse_task (RestXmlNode *root)
+{
+        RestXmlNode *node;
+        const gchar *task_list_id;
+        RtmTask *task;
+
+        node = rest_xml_node_find (root, "list");
+        task_list_id = rest_xml_node_get_attr (node, "id");
+
+        node = rest_xml_node_find (node, "taskseries");
+        task = rtm_task_new ();
+        rtm_task_load_data (task, node, task_list_id);
+
+        return task;
+}
+
+static GList *
+rtm_glib_parse_lists (RestXmlNode *root)
+{
+        RestXmlNode *node;
+        GList *glist = NULL;
+        RtmList *rtmlist;
+
+        for (node = rest_xml_node_find (root, "list"); node; node = node->next) {
+                rtmlist = rtm_list_new ();
+                rtm_list_load_data (rtmlist, node);
+                glist = g_list_append (glist, rtmlist);
+        }
+
+        return glist;
+}
+
+static RtmList *
+rtm_glib_parse_list (RestXmlNode *root)
+{
+        RestXmlNode *node;
+        RtmList *list;
+
+        node = rest_xml_node_find (root, "list");
+
+        list = rtm_list_new ();
+        rtm_list_load_data (list, node);
+
+        return list;
+}
+
+static GList *
+rtm_glib_parse_locations (RestXmlNode *root)
+{
+        RestXmlNode *node;
+        GList *list = NULL;
+        RtmLocation *location;
+
+        for (node = rest_xml_node_find (root, "location"); node; node = node->next) {
+                location = rtm_location_new ();
+                rtm_location_load_data (location, node);
+                list = g_list_append (list, location);
+        }
+
+        return list;
+}
+
+static GList *
+rtm_glib_parse_time_zones (RestXmlNode *root)
+{
+        RestXmlNode *node;
+        GList *list = NULL;
+        RtmTimeZone *time_zone;
+
+        for (node = rest_xml_node_find (root, "timezone"); node; node = node->next) {
+                time_zone = rtm_time_zone_new ();
+                rtm_time_zone_load_data (time_zone, node);
+                list = g_list_append (list, time_zone);
+        }
+
+        return list;
+}
+
+static GList *
+rtm_glib_parse_contacts (RestXmlNode *root)
+{
+        RestXmlNode *node;
+        GList *glist = NULL;
+        RtmContact *contact;
+
+        for (node = rest_xml_node_find (root, "contact"); node; node = node->next) {
+                contact = rtm_contact_new ();
+                rtm_contact_load_data (contact, node);
+                glist = g_list_append (glist, contact);
+        }
+
+        return glist;
+}
+
+static RtmContact *
+rtm_glib_parse_contact (RestXmlNode *root)
+{
+        RestXmlNode *node;
+        RtmContact *contact;
+
+        node = rest_xml_node_find (root, "contact");
+
+        contact = rtm_contact_new ();
+        rtm_contact_load_data (contact, node);
+
+        return contact;
+}
+
+typedef void (*RtmGlibLoadAttributeFunc) (gpointer object, const gchar *name,
+                                          const gchar *value);
+
+/**
+ * rtm_glib_decode_object:
+ * @reader: a #RtmJsonReader after the beginning of an object.
+ * @type: the #GType of the object to create.
+ * @load_attribute: the function setting each field of the object.
+ * @error: location to store #GError or %NULL.
+ *
+ * Decodes an element with attributes only, such as a list or a location.
+ *
+ * Returns: the new object, or %NULL on error.
+ */
+static GObject *
+rtm_glib_decode_object (RtmJsonReader *reader, GType type,
+                        RtmGlibLoadAttributeFunc load_attribute,
+                        GError **error)
+{
+        GObject *object;
+        RtmJsonToken token;
+        GError *tmp_error = NULL;
+
+        object = g_object_new (type, NULL);
+
+        while (rtm_glib_json_next_member (reader, &tmp_error)) {
+                token = rtm_json_reader_next (reader, &tmp_error);
+                if (rtm_glib_json_is_scalar (token)) {
+                        load_attribute (object,
+                                        rtm_json_reader_get_member (reader),
+                                        rtm_json_reader_get_string (reader));
+                } else if (!rtm_json_reader_skip (reader, token,
+                                                  &tmp_error)) {
+                        break;
+                }
+        }
+
+        if (tmp_error != NULL) {
+                g_propagate_error (error, tmp_error);
+                g_object_unref (object);
+                return NULL;
+        }
+
+        return object;
+}
+
+/**
+ * rtm_glib_decode_objects:
+ * @payload: the payload of a successful JSON response.
+ * @container: the name of the element with the list, such as "lists".
+ * @element: the name of each element of the list, such as "list".
+ * @type: the #GType of the objects to create.
+ * @load_attribute: the function setting each field of the objects.
+ * @error: location to store #GError or %NULL.
+ *
+ * Decodes the response of a getList method straight into objects. A single
+ * element is sent as an object instead of an array of one.
+ *
+ * Returns: A #GList of objects of @type, or %NULL on error.
+ */
+static GList *
+rtm_glib_decode_objects (GBytes *payload, const gchar *container,
+                         const gchar *element, GType type,
+                         RtmGlibLoadAttributeFunc load_attribute,
+                         GError **error)
+{
+        RtmJsonReader *reader;
+        RtmJsonToken token;
+        GObject *object;
+        GList *list = NULL;
+        const gchar *data;
+        gsize length;
+        gboolean is_container, is_element, array;
+        GError *tmp_error = NULL;
+
+        data = g_bytes_get_data (payload, &length);
+        reader = rtm_json_reader_new (data, length);
+
+        if (!rtm_glib_json_enter_rsp (reader, &tmp_error)) {
+                goto out;
+        }
+
+        while (rtm_glib_json_next_member (reader, &tmp_error)) {
+                is_container = rtm_glib_json_is_member (reader, container);
+                token = rtm_json_reader_next (reader, &tmp_error);
+                if (!is_container || token != RTM_JSON_TOKEN_BEGIN_OBJECT) {
+                        if (!rtm_json_reader_skip (reader, token,
+                                                   &tmp_error)) {
+                                goto out;
+                        }
+                        continue;
+                }
+
+                while (rtm_glib_json_next_member (reader, &tmp_error)) {
+                        is_element = rtm_glib_json_is_member (reader,
+                                                              element);
+                        token = rtm_json_reader_next (reader, &tmp_error);
+                        if (!is_element) {
+                                if (!rtm_json_reader_skip (reader, token,
+                                                           &tmp_error)) {
+                                        goto out;
+                                }
+                                continue;
+                        }
+
+                        array = (token == RTM_JSON_TOKEN_BEGIN_ARRAY);
+                        if (array) {
+                                token = rtm_json_reader_next (reader,
+                                                              &tmp_error);
+                        }
+                        while (tmp_error == NULL &&
+                               token != RTM_JSON_TOKEN_END_ARRAY) {
+                                if (token == RTM_JSON_TOKEN_BEGIN_OBJECT) {
+                                        object = rtm_glib_decode_object (
+                                                reader, type, load_attribute,
+                                                &tmp_error);
+                                        if (object == NULL) {
+                                                goto out;
+                                        }
+                                        list = g_list_prepend (list, object);
+                                } else if (!rtm_json_reader_skip (
+                                                   reader, token,
+                                                   &tmp_error)) {
+                                        goto out;
+                                }
+                                if (!array) {
+                                        break;
+                                }
+                                token = rtm_json_reader_next (reader,
+                                                              &tmp_error);
+                        }
+                        if (tmp_error != NULL) {
+                                goto out;
+                        }
+                }
+                if (tmp_error != NULL) {
+                        goto out;
+                }
+        }
+
+out:
+        rtm_json_reader_free (reader);
+
+        if (tmp_error != NULL) {
+                g_propagate_error (error, tmp_error);
+                g_list_free_full (list, g_object_unref);
+                return NULL;
+        }
+
+        return g_list_reverse (list);
+}
+
+/* Loads an attribute of a taskseries, as rtm_task_load_attribute() */
+typedef void (*RtmGlibLoadTaskAttributeFunc) (gpointer target,
+                                              const gchar *element,
+                                              const gchar *name,
+                                              const gchar *value);
+
+/*
+ * Where the tasks of a tasks.getList response are decoded: either into
+ * #RtmTask objects prepended to @tasks, or into @batch if it is set.
+ */
+typedef struct {
+        GList *tasks;
+        gboolean lazy;
+        RtmTaskBatch *batch;
+} RtmGlibTaskSink;
+
+/**
+ * rtm_glib_decode_task_element:
+ * @reader: a #RtmJsonReader after the beginning of an object.
+ * @load: the #RtmGlibLoadTaskAttributeFunc of @target.
+ * @target: the #RtmTask or #RtmTaskBatch being decoded.
+ * @element: the name of the element, such as "task" or "rrule".
+ * @error: location to store #GError or %NULL.
+ *
+ * Decodes the attributes of an element nested in a taskseries.
+ *
+ * Returns: %TRUE on success, %FALSE on error.
+ */
+static gboolean
+rtm_glib_decode_task_element (RtmJsonReader *reader,
+                              RtmGlibLoadTaskAttributeFunc load,
+                              gpointer target, const gchar *element,
+                              GError **error)
+{
+        RtmJsonToken token;
+        GError *tmp_error = NULL;
+
+        while (rtm_glib_json_next_member (reader, &tmp_error)) {
+                token = rtm_json_reader_next (reader, &tmp_error);
+                if (rtm_glib_json_is_scalar (token)) {
+                        load (target, element,
+                              rtm_json_reader_get_member (reader),
+                              rtm_json_reader_get_string (reader));
+                } else if (!rtm_json_reader_skip (reader, token,
+                                                  &tmp_error)) {
+                        break;
+                }
+        }
+
+        if (tmp_error != NULL) {
+                g_propagate_error (error, tmp_error);
+                return FALSE;
+        }
+
+        return TRUE;
+}
+
+/**
+ * rtm_glib_decode_tags:
+ * @reader: a #RtmJsonReader after the beginning of the tags object.
+ * @load: the #RtmGlibLoadTaskAttributeFunc of @target.
+ * @target: the #RtmTask or #RtmTaskBatch being decoded.
+ * @error: location to store #GError or %NULL.
+ *
+ * Decodes the tags of a taskseries, sent as a string if there is only one
+ * and as an array of strings otherwise.
+ *
+ * Returns: %TRUE on success, %FALSE on error.
+ */
+static gboolean
+rtm_glib_decode_tags (RtmJsonReader *reader, RtmGlibLoadTaskAttributeFunc load,
+                      gpointer target, GError **error)
+{
+        RtmJsonToken token;
+        gboolean is_tag;
+        GError *tmp_error = NULL;
+
+        while (rtm_glib_json_next_member (reader, &tmp_error)) {
+                is_tag = rtm_glib_json_is_member (reader, "tag");
+                token = rtm_json_reader_next (reader, &tmp_error);
+                if (is_tag && token == RTM_JSON_TOKEN_BEGIN_ARRAY) {
+                        token = rtm_json_reader_next (reader, &tmp_error);
+                        while (rtm_glib_json_is_scalar (token)) {
+                                load (target, "tag", "$t",
+                                      rtm_json_reader_get_string (reader));
+                                token = rtm_json_reader_next (reader,
+                                                              &tmp_error);
+                        }
+                        if (token != RTM_JSON_TOKEN_END_ARRAY &&
+                            !rtm_json_reader_skip (reader, token,
+                                                   &tmp_error)) {
+                                break;
+                        }
+                } else if (is_tag && rtm_glib_json_is_scalar (token)) {
+                        load (target, "tag", "$t",
+                              rtm_json_reader_get_string (reader));
+                } else if (!rtm_json_reader_skip (reader, token,
+                                                  &tmp_error)) {
+                        break;
+                }
+        }
+
+        if (tmp_error != NULL) {
+                g_propagate_error (error, tmp_error);
+                return FALSE;
+        }
+
+        return TRUE;
+}
+
+/**
+ * rtm_glib_decode_taskseries:
+ * @reader: a #RtmJsonReader after the beginning of a taskseries object.
+ * @sink: the #RtmGlibTaskSink where the tasks are decoded.
+ * @error: location to store #GError or %NULL.
+ *
+ * Decodes a taskseries into one task for each of its tasks, as the
+ * instances of a recurring taskseries. The first task is loaded into the
+ * object of the taskseries, the others get a copy of its fields at the end.
+ *
+ * Returns: %TRUE on success, %FALSE on error.
+ */
+static gboolean
+rtm_glib_decode_taskseries (RtmJsonReader *reader, RtmGlibTaskSink *sink,
+                            GError **error)
+{
+        RtmTask *series = NULL, *task;
+        RtmGlibLoadTaskAttributeFunc load;
+        gpointer series_target, task_target;
+        GList *instances = NULL, *item;
+        RtmJsonToken token;
+        gboolean is_task, is_rrule, is_tags, array, seen_task = FALSE;
+        gboolean ok = TRUE;
+        GError *tmp_error = NULL;
+
+        if (sink->batch != NULL) {
+                rtm_task_batch_begin_series (sink->batch);
+                load = (RtmGlibLoadTaskAttributeFunc)
+                        rtm_task_batch_load_attribute;
+                series_target = sink->batch;
+        } else {
+                series = rtm_task_new ();
+                rtm_task_set_lazy (series, sink->lazy);
+                load = (RtmGlibLoadTaskAttributeFunc) rtm_task_load_attribute;
+                series_target = series;
+        }
+
+        while (ok && rtm_glib_json_next_member (reader, &tmp_error)) {
+                is_task = rtm_glib_json_is_member (reader, "task");
+                is_rrule = rtm_glib_json_is_member (reader, "rrule");
+                is_tags = rtm_glib_json_is_member (reader, "tags");
+
+                token = rtm_json_reader_next (reader, &tmp_error);
+                if (rtm_glib_json_is_scalar (token)) {
+                        load (series_target, "taskseries",
+                              rtm_json_reader_get_member (reader),
+                              rtm_json_reader_get_string (reader));
+                } else if (is_task && (token == RTM_JSON_TOKEN_BEGIN_ARRAY ||
+                                       token == RTM_JSON_TOKEN_BEGIN_OBJECT)) {
+                        /* A single task can come without the array */
+                        array = (token == RTM_JSON_TOKEN_BEGIN_ARRAY);
+                        if (array) {
+                                token = rtm_json_reader_next (reader,
+                                                              &tmp_error);
+                        }
+                        while (ok && tmp_error == NULL &&
+                               token != RTM_JSON_TOKEN_END_ARRAY) {
+                                if (token == RTM_JSON_TOKEN_BEGIN_OBJECT) {
+                                        if (sink->batch != NULL) {
+                                                rtm_task_batch_begin_task (
+                                                        sink->batch);
+                                                task_target = sink->batch;
+                                        } else if (!seen_task) {
+                                                seen_task = TRUE;
+                                                task_target = series;
+                                        } else {
+                                                task = rtm_task_new ();
+                                                rtm_task_set_lazy (task,
+                                                                   sink->lazy);
+                                                instances = g_list_prepend (
+                                                        instances, task);
+                                                task_target = task;
+                                        }
+                                        ok = rtm_glib_decode_task_element (
+                                                reader, load, task_target,
+                                                "task", &tmp_error);
+                                } else {
+                                        ok = rtm_json_reader_skip (
+                                                reader, token, &tmp_error);
+                                }
+                                if (!array) {
+                                        break;
+                                }
+                                if (ok) {
+                                        token = rtm_json_reader_next (
+                                                reader, &tmp_error);
+                                }
+                        }
+                        ok = ok && tmp_error == NULL;
+                } else if (is_rrule && token == RTM_JSON_TOKEN_BEGIN_OBJECT) {
+                        ok = rtm_glib_decode_task_element (
+                                reader, load, series_target, "rrule",
+                                &tmp_error);
+                } else if (is_tags && token == RTM_JSON_TOKEN_BEGIN_OBJECT) {
+                        ok = rtm_glib_decode_tags (reader, load, series_target,
+                                                   &tmp_error);
+                } else {
+                        ok = rtm_json_reader_skip (reader, token, &tmp_error);
+                }
+        }
+
+        if (tmp_error != NULL) {
+                g_propagate_error (error, tmp_error);
+                g_list_free_full (instances, g_object_unref);
+                if (series != NULL) {
+                        g_object_unref (series);
+                }
+                return FALSE;
+        }
+
+        if (sink->batch != NULL) {
+                rtm_task_batch_end_series (sink->batch);
+                return TRUE;
+        }
+
+        /* The tasks are prepended, so they are in order once reversed */
+        sink->tasks = g_list_prepend (sink->tasks, series);
+        instances = g_list_reverse (instances);
+        for (item = instances; item; item = item->next) {
+                rtm_task_copy_series (item->data, series);
+                sink->tasks = g_list_prepend (sink->tasks, item->data);
+        }
+        g_list_free (instances);
+
+        return TRUE;
+}
+
+/**
+ * rtm_glib_decode_task_list:
+ * @reader: a #RtmJsonReader after the beginning of a list object.
+ * @sink: the #RtmGlibTaskSink where the tasks are decoded.
+ * @error: location to store #GError or %NULL.
+ *
+ * Decodes the taskseries of a list of the tasks.getList response.
+ *
+ * Returns: %TRUE on success, %FALSE on error.
+ */
+static gboolean
+rtm_glib_decode_task_list (RtmJsonReader *reader, RtmGlibTaskSink *sink,
+                           GError **error)
+{
+        RtmJsonToken token;
+        GList *first, *item;
+        guint first_index = 0;
+        gchar *list_id = NULL;
+        gboolean is_id, is_taskseries, array;
+        GError *tmp_error = NULL;
+
+        first = sink->tasks;
+        if (sink->batch != NULL) {
+                first_index = rtm_task_batch_get_length (sink->batch);
+        }
+
+        while (rtm_glib_json_next_member (reader, &tmp_error)) {
+                is_id = rtm_glib_json_is_member (reader, "id");
+                is_taskseries = rtm_glib_json_is_member (reader,
+                                                         "taskseries");
+
+                token = rtm_json_reader_next (reader, &tmp_error);
+                if (is_id && rtm_glib_json_is_scalar (token)) {
+                        g_free (list_id);
+                        list_id = g_strdup (rtm_json_reader_get_string (
+                                                    reader));
+                        continue;
+                }
+
+                if (!is_taskseries) {
+                        if (!rtm_json_reader_skip (reader, token,
+                                                   &tmp_error)) {
+                                break;
+                        }
+                        continue;
+                }
+
+                array = (token == RTM_JSON_TOKEN_BEGIN_ARRAY);
+                if (array) {
+                        token = rtm_json_reader_next (reader, &tmp_error);
+                }
+                while (tmp_error == NULL &&
+                       token != RTM_JSON_TOKEN_END_ARRAY) {
+                        if (token == RTM_JSON_TOKEN_BEGIN_OBJECT) {
+                                if (!rtm_glib_decode_taskseries (
+                                            reader, sink, &tmp_error)) {
+                                        break;
+                                }
+                        } else if (!rtm_json_reader_skip (reader, token,
+                                                          &tmp_error)) {
+                                break;
+                        }
+                        if (!array) {
+                                break;
+                        }
+                        token = rtm_json_reader_next (reader, &tmp_error);
+                }
+                if (tmp_error != NULL) {
+                        break;
+                }
+        }
+
+        /* The list ID can come after its taskseries */
+        if (sink->batch != NULL) {
+                rtm_task_batch_set_list_id (sink->batch, first_index,
+                                            list_id);
+        }
+        for (item = sink->tasks; item != first; item = item->next) {
+                rtm_task_load_attribute (item->data, "list", "id", list_id);
+        }
+        g_free (list_id);
+
+        if (tmp_error != NULL) {
+                g_propagate_error (error, tmp_error);
+                return FALSE;
+        }
+
+        return TRUE;
+}
+
+/**
+ * rtm_glib_decode_tasks_into:
+ * @payload: the payload of a successful JSON response.
+ * @sink: the #RtmGlibTaskSink where the tasks are decoded.
+ * @error: location to store #GError or %NULL.
+ *
+ * Decodes the response of tasks.getList straight into @sink.
+ *
+ * Returns: %TRUE on success, %FALSE on error.
+ */
+static gboolean
+rtm_glib_decode_tasks_into (GBytes *payload, RtmGlibTaskSink *sink,
+                            GError **error)
+{
+        RtmJsonReader *reader;
+        RtmJsonToken token;
+        const gchar *data;
+        gsize length;
+        gboolean is_tasks, is_list, array;
+        GError *tmp_error = NULL;
+
+        data = g_bytes_get_data (payload, &length);
+        reader = rtm_json_reader_new (data, length);
+
+        if (!rtm_glib_json_enter_rsp (reader, &tmp_error)) {
+                goto out;
+        }
+
+        while (rtm_glib_json_next_member (reader, &tmp_error)) {
+                is_tasks = rtm_glib_json_is_member (reader, "tasks");
+                token = rtm_json_reader_next (reader, &tmp_error);
+                if (!is_tasks || token != RTM_JSON_TOKEN_BEGIN_OBJECT) {
+                        if (!rtm_json_reader_skip (reader, token,
+                                                   &tmp_error)) {
+                                goto out;
+                        }
+                        continue;
+                }
+
+                while (rtm_glib_json_next_member (reader, &tmp_error)) {
+                        is_list = rtm_glib_json_is_member (reader, "list");
+                        token = rtm_json_reader_next (reader, &tmp_error);
+
+                        if (!is_list) {
+                                if (!rtm_json_reader_skip (reader, token,
+                                                           &tmp_error)) {
+                                        goto out;
+                                }
+                                continue;
+                        }
+
+                        array = (token == RTM_JSON_TOKEN_BEGIN_ARRAY);
+                        if (array) {
+                                token = rtm_json_reader_next (reader,
+                                                              &tmp_error);
+                        }
+                        while (tmp_error == NULL &&
+                               token != RTM_JSON_TOKEN_END_ARRAY) {
+                                if (token == RTM_JSON_TOKEN_BEGIN_OBJECT) {
+                                        if (!rtm_glib_decode_task_list (
+                                                    reader, sink,
+                                                    &tmp_error)) {
+                                                goto out;
+                                        }
+                                } else if (!rtm_json_reader_skip (
+                                                   reader, token,
+                                                   &tmp_error)) {
+                                        goto out;
+                                }
+                                if (!array) {
+                                        break;
+                                }
+                                token = rtm_json_reader_next (reader,
+                                                              &tmp_error);
+                        }
+                        if (tmp_error != NULL) {
+                                goto out;
+                        }
+                }
+                if (tmp_error != NULL) {
+                        goto out;
+                }
+        }
+
+out:
+        rtm_json_reader_free (reader);
+
+        if (tmp_error != NULL) {
+                g_propagate_error (error, tmp_error);
+                return FALSE;
+        }
+
+        return TRUE;
+}
+
+/**
+ * rtm_glib_decode_tasks:
+ * @payload: the payload of a successful JSON response.
+ * @lazy: whether the tasks decode the fields seldom read on first access.
+ * @error: location to store #GError or %NULL.
+ *
+ * Decodes the response of tasks.getList straight into #RtmTask objects.
+ *
+ * Returns: A #GList of #RtmTask objects, or %NULL on error.
+ */
+static GList *
+rtm_glib_decode_tasks (GBytes *payload, gboolean lazy, GError **error)
+{
+        RtmGlibTaskSink sink = { NULL, lazy, NULL };
+
+        if (!rtm_glib_decode_tasks_into (payload, &sink, error)) {
+                g_list_free_full (sink.tasks, g_object_unref);
+                return NULL;
+        }
+
+        return g_list_reverse (sink.tasks);
+}
+
+static void
+rtm_glib_prepend_task (RtmTask *task, gpointer user_data)
+{
+        GList **tasks = user_data;
+
+        *tasks = g_list_prepend (*tasks, task);
+}
+
+/**
+ * rtm_glib_decode_tasks_xml:
+ * @payload: the payload of a successful XML response.
+ * @lazy: whether the tasks decode the fields seldom read on first access.
+ * @error: location to store #GError or %NULL.
+ *
+ * Parses the XML response of tasks.getList straight into #RtmTask objects,
+ * without building a tree.
+ *
+ * Returns: A #GList of #RtmTask objects, or %NULL on error.
+ */
+static GList *
+rtm_glib_decode_tasks_xml (GBytes *payload, gboolean lazy, GError **error)
+{
+        RtmTaskParser *parser;
+        GList *tasks = NULL;
+        const gchar *data;
+        gsize length;
+        gboolean ok;
+
+        data = g_bytes_get_data (payload, &length);
+
+        parser = rtm_task_parser_new (rtm_glib_prepend_task, &tasks);
+        rtm_task_parser_set_lazy (parser, lazy);
+        ok = rtm_task_parser_feed (parser, data, length, error) &&
+                rtm_task_parser_finish (parser, error);
+        rtm_task_parser_free (parser);
+
+        if (!ok) {
+                g_list_free_full (tasks, g_object_unref);
+                return NULL;
+        }
+
+        return g_list_reverse (tasks);
+}
+
+/**
+ * rtm_glib_decode_task_batch:
+ * @payload: the payload of a successful response.
+ * @json: whether @payload is a JSON response, or a XML one.
+ * @error: location to store #GError or %NULL.
+ *
+ * Decodes the response of tasks.getList straight into a #RtmTaskBatch.
+ *
+ * Returns: A new #RtmTaskBatch, or %NULL on error.
+ */
+static RtmTaskBatch *
+rtm_glib_decode_task_batch (GBytes *payload, gboolean json, GError **error)
+{
+        RtmGlibTaskSink sink = { NULL, FALSE, NULL };
+        RtmTaskParser *parser;
+        const gchar *data;
+        gsize length;
+        gboolean ok;
+
+        sink.batch = rtm_task_batch_new ();
+
+        if (json) {
+                ok = rtm_glib_decode_tasks_into (payload, &sink, error);
+        } else {
+                data = g_bytes_get_data (payload, &length);
+                parser = rtm_task_parser_new (NULL, NULL);
+                rtm_task_parser_set_batch (parser, sink.batch);
+                ok = rtm_task_parser_feed (parser, data, length, error) &&
+                        rtm_task_parser_finish (parser, error);
+                rtm_task_parser_free (parser);
+        }
+
+        if (!ok) {
+                rtm_task_batch_unref (sink.batch);
+                return NULL;
+        }
+
+        return sink.batch;
+}
+
+static GList *
+rtm_glib_decode_lists (GBytes *payload, GError **error)
+{
+        return rtm_glib_decode_objects (
+                payload, "lists", "list", RTM_TYPE_LIST,
+                (RtmGlibLoadAttributeFunc) rtm_list_load_attribute, error);
+}
+
+static GList *
+rtm_glib_decode_locations (GBytes *payload, GError **error)
+{
+        return rtm_glib_decode_objects (
+                payload, "locations", "location", RTM_TYPE_LOCATION,
+                (RtmGlibLoadAttributeFunc) rtm_location_load_attribute,
+                error);
+}
+
+static GList *
+rtm_glib_decode_time_zones (GBytes *payload, GError **error)
+{
+        return rtm_glib_decode_objects (
+                payload, "timezones", "timezone", RTM_TYPE_TIME_ZONE,
+                (RtmGlibLoadAttributeFunc) rtm_time_zone_load_attribute,
+                error);
+}
+
+static GList *
+rtm_glib_decode_contacts (GBytes *payload, GError **error)
+{
+        return rtm_glib_decode_objects (
+                payload, "contacts", "contact", RTM_TYPE_CONTACT,
+                (RtmGlibLoadAttributeFunc) rtm_contact_load_attribute,
+                error);
+}
+
+/**
+ * rtm_glib_test_echo:
+ * @rtm: a #RtmGlib object.
+ * @error: location to store #GError or %NULL.
+ *
+ * Just checks if the webservice is working properly.
+ *
+ * Returns: %TRUE if the service is available.
+ */
+gboolean
+rtm_glib_test_echo (RtmGlib *rtm, GError **error)
+{
+        g_return_val_if_fail (rtm != NULL, FALSE);
+
+        RestXmlNode *root;
+        gboolean valid = FALSE;
+        GError *tmp_error = NULL;
+
+        root = rtm_glib_call_method (rtm,
                 RTM_METHOD_TEST_ECHO, &tmp_error,
                 NULL);
         if (tmp_error != NULL) {
                 g_propagate_error (error, tmp_error);
-                return FALSE;
+                return FALSE;
+        }
+
+        valid = rtm_glib_parse_test_echo (rtm, root);
+
+        rest_xml_node_unref (root);
+
+        return valid;
+}
+
+/**
+ * rtm_glib_test_echo_async:
+ * @rtm: a #RtmGlib object.
+ * @cancellable: optional #GCancellable object, %NULL to ignore.
+ * @callback: a #GAsyncReadyCallback to call when the request is satisfied.
+ * @user_data: the data to pass to callback function.
+ *
+ * Asynchronously checks if the webservice is working properly.
+ *
+ * When the operation is finished, @callback will be called. You can then call
+ * rtm_glib_test_echo_finish() to get the result of the operation.
+ */
+void
+rtm_glib_test_echo_async (RtmGlib *rtm, GCancellable *cancellable,
+                          GAsyncReadyCallback callback, gpointer user_data)
+{
+        g_return_if_fail (rtm != NULL);
+
+        rtm_glib_call_method_async (rtm,
+                RTM_METHOD_TEST_ECHO, cancellable, callback, user_data,
+                NULL);
+}
+
+/**
+ * rtm_glib_test_echo_finish:
+ * @rtm: a #RtmGlib object.
+ * @result: the #GAsyncResult passed to the callback.
+ * @error: location to store #GError or %NULL.
+ *
+ * Finishes an operation started with rtm_glib_test_echo_async().
+ *
+ * Returns: %TRUE if the service is available.
+ */
+gboolean
+rtm_glib_test_echo_finish (RtmGlib *rtm, GAsyncResult *result, GError **error)
+{
+        g_return_val_if_fail (rtm != NULL, FALSE);
+
+        RestXmlNode *root;
+        gboolean valid;
+
+        root = rtm_glib_call_method_finish (rtm, result, error);
+        if (root == NULL) {
+                return FALSE;
+        }
+
+        valid = rtm_glib_parse_test_echo (rtm, root);
+
+        rest_xml_node_unref (root);
+
+        return valid;
+}
+
+/**
+ * rtm_glib_test_login:
+ * @rtm: a #RtmGlib object.
+ * @auth_token: the authentication token.
+ * @error: location to store #GError or %NULL.
+ *
+ * Checks if the user is already logged. In that case sets the
+ * #RtmGlib:auth_token property.
+ *
+ * Returns: The username if is already logged.
+ */
+gchar *
+rtm_glib_test_login (RtmGlib *rtm, gchar *auth_token, GError **error)
+{
+        g_return_val_if_fail (rtm != NULL, NULL);
+        g_return_val_if_fail (auth_token != NULL, NULL);
+
+        RestXmlNode *root;
+        gchar *username;
+        GError *tmp_error = NULL;
+
+        root = rtm_glib_call_method (rtm,
+                RTM_METHOD_TEST_LOGIN, &tmp_error,
+                "auth_token", auth_token,
+                NULL);
+        if (tmp_error != NULL) {
+                g_propagate_error (error, tmp_error);
+                return NULL;
+        }
+
+        username = rtm_glib_parse_username (root);
+
+        rest_xml_node_unref (root);
+
+        rtm_glib_replace_auth_token (rtm, auth_token);
+
+        return username;
+}
+
+static void
+rtm_glib_test_login_cb (GObject *source_object, GAsyncResult *result,
+                        gpointer user_data)
+{
+        GTask *task = G_TASK (user_data);
+        RtmGlib *rtm = RTM_GLIB (source_object);
+        RestXmlNode *root;
+        GError *tmp_error = NULL;
+
+        root = rtm_glib_call_method_finish (rtm, result, &tmp_error);
+        if (root == NULL) {
+                g_task_return_error (task, tmp_error);
+        } else {
+                rtm_glib_replace_auth_token (rtm, g_task_get_task_data (task));
+                g_task_return_pointer (task, rtm_glib_parse_username (root),
+                                       g_free);
+                rest_xml_node_unref (root);
+        }
+
+        g_object_unref (task);
+}
+
+/**
+ * rtm_glib_test_login_async:
+ * @rtm: a #RtmGlib object.
+ * @auth_token: the authentication token.
+ * @cancellable: optional #GCancellable object, %NULL to ignore.
+ * @callback: a #GAsyncReadyCallback to call when the request is satisfied.
+ * @user_data: the data to pass to callback function.
+ *
+ * Asynchronously checks if the user is already logged. In that case sets the
+ * #RtmGlib:auth_token property before calling @callback.
+ *
+ * When the operation is finished, @callback will be called. You can then call
+ * rtm_glib_test_login_finish() to get the result of the operation.
+ */
+void
+rtm_glib_test_login_async (RtmGlib *rtm, gchar *auth_token,
+                           GCancellable *cancellable,
+                           GAsyncReadyCallback callback, gpointer user_data)
+{
+        g_return_if_fail (rtm != NULL);
+        g_return_if_fail (auth_token != NULL);
+
+        GTask *task;
+
+        task = g_task_new (rtm, cancellable, callback, user_data);
+        g_task_set_source_tag (task, rtm_glib_test_login_async);
+        g_task_set_task_data (task, g_strdup (auth_token), g_free);
+
+        rtm_glib_call_method_async (rtm,
+                RTM_METHOD_TEST_LOGIN, cancellable,
+                rtm_glib_test_login_cb, task,
+                "auth_token", auth_token,
+                NULL);
+}
+
+/**
+ * rtm_glib_test_login_finish:
+ * @rtm: a #RtmGlib object.
+ * @result: the #GAsyncResult passed to the callback.
+ * @error: location to store #GError or %NULL.
+ *
+ * Finishes an operation started with rtm_glib_test_login_async().
+ *
+ * Returns: The username if is already logged.
+ */
+gchar *
+rtm_glib_test_login_finish (RtmGlib *rtm, GAsyncResult *result,
+                            GError **error)
+{
+        g_return_val_if_fail (g_task_is_valid (result, rtm), NULL);
+
+        return g_task_propagate_pointer (G_TASK (result), error);
+}
+
+/**
+ * rtm_glib_auth_get_frob:
+ * @rtm: a #RtmGlib object.
+ * @error: location to store #GError or %NULL.
+ *
+ * Gets the authentication frob.
+ *
+ * Returns: The authentication frob.
+ **/
+gchar *
+rtm_glib_auth_get_frob (RtmGlib *rtm, GError **error)
+{
+        g_return_val_if_fail (rtm != NULL, NULL);
+
+        RestXmlNode *root;
+        gchar *frob;
+        GError *tmp_error = NULL;
+
+        root = rtm_glib_call_method (rtm,
+                RTM_METHOD_AUTH_GET_FROB, &tmp_error,
+                NULL);
+        if (tmp_error != NULL) {
+                g_propagate_error (error, tmp_error);
+                return NULL;
+        }
+
+        frob = rtm_glib_parse_content (root, "frob");
+
+        rest_xml_node_unref (root);
+
+        return frob;
+}
+
+/**
+ * rtm_glib_auth_get_frob_async:
+ * @rtm: a #RtmGlib object.
+ * @cancellable: optional #GCancellable object, %NULL to ignore.
+ * @callback: a #GAsyncReadyCallback to call when the request is satisfied.
+ * @user_data: the data to pass to callback function.
+ *
+ * Asynchronously gets the authentication frob.
+ *
+ * When the operation is finished, @callback will be called. You can then call
+ * rtm_glib_auth_get_frob_finish() to get the result of the operation.
+ **/
+void
+rtm_glib_auth_get_frob_async (RtmGlib *rtm, GCancellable *cancellable,
+                              GAsyncReadyCallback callback, gpointer user_data)
+{
+        g_return_if_fail (rtm != NULL);
+
+        rtm_glib_call_method_async (rtm,
+                RTM_METHOD_AUTH_GET_FROB, cancellable, callback, user_data,
+                NULL);
+}
+
+/**
+ * rtm_glib_auth_get_frob_finish:
+ * @rtm: a #RtmGlib object.
+ * @result: the #GAsyncResult passed to the callback.
+ * @error: location to store #GError or %NULL.
+ *
+ * Finishes an operation started with rtm_glib_auth_get_frob_async().
+ *
+ * Returns: The authentication frob.
+ **/
+gchar *
+rtm_glib_auth_get_frob_finish (RtmGlib *rtm, GAsyncResult *result,
+                               GError **error)
+{
+        g_return_val_if_fail (rtm != NULL, NULL);
+
+        RestXmlNode *root;
+        gchar *frob;
+
+        root = rtm_glib_call_method_finish (rtm, result, error);
+        if (root == NULL) {
+                return NULL;
+        }
+
+        frob = rtm_glib_parse_content (root, "frob");
+
+        rest_xml_node_unref (root);
+
+        return frob;
+}
+
+/**
+ * rtm_glib_auth_get_token:
+ * @rtm: a #RtmGlib object.
+ * @frob: the authentication frob.
+ * @error: location to store #GError or %NULL.
+ *
+ * Gets the authentication token and sets the #RtmGlib:auth_token property.
+ *
+ * Returns: The authentication token.
+ **/
+gchar *
+rtm_glib_auth_get_token (RtmGlib *rtm, gchar *frob, GError **error)
+{
+        g_return_val_if_fail (rtm != NULL, NULL);
+        g_return_val_if_fail (frob != NULL, NULL);
+
+        RestXmlNode *root;
+        gchar *auth_token;
+        GError *tmp_error = NULL;
+
+        root = rtm_glib_call_method (rtm,
+                RTM_METHOD_AUTH_GET_TOKEN, &tmp_error,
+                "frob", frob,
+                NULL);
+        if (tmp_error != NULL) {
+                g_propagate_error (error, tmp_error);
+                return NULL;
+        }
+
+        auth_token = rtm_glib_parse_content (root, "token");
+
+        rest_xml_node_unref (root);
+
+        rtm_glib_replace_auth_token (rtm, auth_token);
+
+        return auth_token;
+}
+
+/**
+ * rtm_glib_auth_get_token_async:
+ * @rtm: a #RtmGlib object.
+ * @frob: the authentication frob.
+ * @cancellable: optional #GCancellable object, %NULL to ignore.
+ * @callback: a #GAsyncReadyCallback to call when the request is satisfied.
+ * @user_data: the data to pass to callback function.
+ *
+ * Asynchronously gets the authentication token and sets the
+ * #RtmGlib:auth_token property.
+ *
+ * When the operation is finished, @callback will be called. You can then call
+ * rtm_glib_auth_get_token_finish() to get the result of the operation.
+ **/
+void
+rtm_glib_auth_get_token_async (RtmGlib *rtm, gchar *frob,
+                               GCancellable *cancellable,
+                               GAsyncReadyCallback callback,
+                               gpointer user_data)
+{
+        g_return_if_fail (rtm != NULL);
+        g_return_if_fail (frob != NULL);
+
+        rtm_glib_call_method_async (rtm,
+                RTM_METHOD_AUTH_GET_TOKEN, cancellable, callback, user_data,
+                "frob", frob,
+                NULL);
+}
+
+/**
+ * rtm_glib_auth_get_token_finish:
+ * @rtm: a #RtmGlib object.
+ * @result: the #GAsyncResult passed to the callback.
+ * @error: location to store #GError or %NULL.
+ *
+ * Finishes an operation started with rtm_glib_auth_get_token_async().
+ *
+ * Returns: The authentication token.
+ **/
+gchar *
+rtm_glib_auth_get_token_finish (RtmGlib *rtm, GAsyncResult *result,
+                                GError **error)
+{
+        g_return_val_if_fail (rtm != NULL, NULL);
+
+        RestXmlNode *root;
+        gchar *auth_token;
+
+        root = rtm_glib_call_method_finish (rtm, result, error);
+        if (root == NULL) {
+                return NULL;
+        }
+
+        auth_token = rtm_glib_parse_content (root, "token");
+
+        rest_xml_node_unref (root);
+
+        rtm_glib_replace_auth_token (rtm, auth_token);
+
+        return auth_token;
+}
+
+/**
+ * rtm_glib_auth_check_token:
+ * @rtm: a #RtmGlib object.
+ * @auth_token: the authentication token.
+ * @error: location to store #GError or %NULL.
+ *
+ * Checks if authentication token is or not valid. If it is valid sets the
+ * #RtmGlib:auth_token property.
+ *
+ * Returns: %TRUE if authentication token is valid.
+ **/
+gboolean
+rtm_glib_auth_check_token (RtmGlib *rtm, gchar *auth_token, GError **error)
+{
+        g_return_val_if_fail (rtm != NULL, FALSE);
+        g_return_val_if_fail (auth_token != NULL, FALSE);
+
+        RestXmlNode *root, *node;
+        gboolean valid = FALSE;
+        GError *tmp_error = NULL;
+
+        root = rtm_glib_call_method (rtm,
+                RTM_METHOD_AUTH_CHECK_TOKEN, &tmp_error,
+                "auth_token", auth_token,
+                NULL);
+        if (tmp_error != NULL) {
+                g_propagate_error (error, tmp_error);
+                return FALSE;
+        }
+
+        node = rest_xml_node_find (root, "token");
+
+        valid = (g_strcmp0 (node->content, auth_token) == 0);
+
+        rest_xml_node_unref (root);
+
+        if (valid) {
+                rtm_glib_replace_auth_token (rtm, auth_token);
+        }
+
+        return valid;
+}
+
+static void
+rtm_glib_auth_check_token_cb (GObject *source_object, GAsyncResult *result,
+                              gpointer user_data)
+{
+        GTask *task = G_TASK (user_data);
+        RtmGlib *rtm = RTM_GLIB (source_object);
+        const gchar *auth_token = g_task_get_task_data (task);
+        RestXmlNode *root, *node;
+        gboolean valid;
+        GError *tmp_error = NULL;
+
+        root = rtm_glib_call_method_finish (rtm, result, &tmp_error);
+        if (root == NULL) {
+                g_task_return_error (task, tmp_error);
+                g_object_unref (task);
+                return;
+        }
+
+        node = rest_xml_node_find (root, "token");
+
+        valid = (g_strcmp0 (node->content, auth_token) == 0);
+
+        rest_xml_node_unref (root);
+
+        if (valid) {
+                rtm_glib_replace_auth_token (rtm, auth_token);
+        }
+
+        g_task_return_boolean (task, valid);
+        g_object_unref (task);
+}
+
+/**
+ * rtm_glib_auth_check_token_async:
+ * @rtm: a #RtmGlib object.
+ * @auth_token: the authentication token.
+ * @cancellable: optional #GCancellable object, %NULL to ignore.
+ * @callback: a #GAsyncReadyCallback to call when the request is satisfied.
+ * @user_data: the data to pass to callback function.
+ *
+ * Asynchronously checks if authentication token is or not valid. If it is
+ * valid sets the #RtmGlib:auth_token property before calling @callback.
+ *
+ * When the operation is finished, @callback will be called. You can then call
+ * rtm_glib_auth_check_token_finish() to get the result of the operation.
+ **/
+void
+rtm_glib_auth_check_token_async (RtmGlib *rtm, gchar *auth_token,
+                                 GCancellable *cancellable,
+                                 GAsyncReadyCallback callback,
+                                 gpointer user_data)
+{
+        g_return_if_fail (rtm != NULL);
+        g_return_if_fail (auth_token != NULL);
+
+        GTask *task;
+
+        task = g_task_new (rtm, cancellable, callback, user_data);
+        g_task_set_source_tag (task, rtm_glib_auth_check_token_async);
+        g_task_set_task_data (task, g_strdup (auth_token), g_free);
+
+        rtm_glib_call_method_async (rtm,
+                RTM_METHOD_AUTH_CHECK_TOKEN, cancellable,
+                rtm_glib_auth_check_token_cb, task,
+                "auth_token", auth_token,
+                NULL);
+}
+
+/**
+ * rtm_glib_auth_check_token_finish:
+ * @rtm: a #RtmGlib object.
+ * @result: the #GAsyncResult passed to the callback.
+ * @error: location to store #GError or %NULL.
+ *
+ * Finishes an operation started with rtm_glib_auth_check_token_async().
+ *
+ * Returns: %TRUE if authentication token is valid.
+ **/
+gboolean
+rtm_glib_auth_check_token_finish (RtmGlib *rtm, GAsyncResult *result,
+                                  GError **error)
+{
+        g_return_val_if_fail (g_task_is_valid (result, rtm), FALSE);
+
+        return g_task_propagate_boolean (G_TASK (result), error);
+}
+
+/**
+ * rtm_glib_auth_get_login_url:
+ * @rtm: a #RtmGlib object.
+ * @frob: the authentication frob.
+ * @perms: the requested permissions. Valid values are %read, %write or
+ * %delete. Default %read.
+ *
+ * Gets the URL to login in Remember The Milk.
+ *
+ * Returns: The URL to login.
+ **/
+gchar *
+rtm_glib_auth_get_login_url (RtmGlib *rtm, gchar *frob, gchar *perms)
+{
+        g_return_val_if_fail (rtm != NULL, NULL);
+        g_return_val_if_fail (frob != NULL, NULL);
+
+        if (perms == NULL) {
+                perms = "read";
+        }
+        g_return_val_if_fail (
+                (g_strcmp0 (perms, "read") == 0) ||
+                (g_strcmp0 (perms, "write") == 0) ||
+                (g_strcmp0 (perms, "delete") == 0),
+                NULL);
+
+        gchar *url;
+        gchar *params[] = { "perms", perms, "frob", frob, NULL };
+        RtmSignedParams signed_params;
+
+        rtm_glib_sign_params (rtm, NULL, params, &signed_params);
+
+        g_mutex_lock (&rtm->priv->mutex);
+        url = g_strconcat (RTM_URL_AUTH, "?",
+                           "api_key=", rtm->priv->api_key, "&",
+                           "perms=", perms, "&",
+                           "frob=", frob, "&",
+                           "api_sig=", signed_params.api_sig,
+                           NULL);
+        g_mutex_unlock (&rtm->priv->mutex);
+
+        DEBUG_PRINT ("url: %s", url);
+
+        rtm_signed_params_clear (&signed_params);
+
+        return url;
+}
+
+/**
+ * rtm_glib_tasks_fetch:
+ * @rtm: a #RtmGlib object already authenticated.
+ * @list_id: %NULL or the id of the list to perform an action on.
+ * @filter: the filter of the tasks, not %NULL.
+ * @last_sync: the time of the last synchronization, not %NULL.
+ * @json: location to store whether the response was asked in JSON.
+ * @error: location to store #GError or %NULL.
+ *
+ * Calls tasks.getList, asking for a JSON response if #RtmGlib:use_json is
+ * set. The payload has to be decoded in the format stored in @json, as
+ * another thread could change the property meanwhile.
+ *
+ * Returns: the payload of the response, or %NULL on error.
+ */
+static GBytes *
+rtm_glib_tasks_fetch (RtmGlib *rtm, gchar *list_id, gchar *filter,
+                      gchar *last_sync, gboolean *json, GError **error)
+{
+        GBytes *payload;
+        GError *tmp_error = NULL;
+
+        *json = rtm->priv->use_json;
+        if (*json) {
+                if (list_id == NULL) {
+                        payload = rtm_glib_call_method_json (
+                                rtm,
+                                RTM_METHOD_TASKS_GET_LIST, &tmp_error,
+                                "auth_token", RTM_GLIB_AUTH_TOKEN,
+                                "filter", filter,
+                                "last_sync", last_sync,
+                                NULL);
+                } else {
+                        payload = rtm_glib_call_method_json (
+                                rtm,
+                                RTM_METHOD_TASKS_GET_LIST, &tmp_error,
+                                "auth_token", RTM_GLIB_AUTH_TOKEN,
+                                "list_id", list_id,
+                                "filter", filter,
+                                "last_sync", last_sync,
+                                NULL);
+                }
+        } else if (list_id == NULL) {
+                payload = rtm_glib_call_method_streamed (
+                        rtm,
+                        RTM_METHOD_TASKS_GET_LIST, &tmp_error,
+                        "auth_token", RTM_GLIB_AUTH_TOKEN,
+                        "filter", filter,
+                        "last_sync", last_sync,
+                        NULL);
+        } else {
+                payload = rtm_glib_call_method_streamed (
+                        rtm,
+                        RTM_METHOD_TASKS_GET_LIST, &tmp_error,
+                        "auth_token", RTM_GLIB_AUTH_TOKEN,
+                        "list_id", list_id,
+                        "filter", filter,
+                        "last_sync", last_sync,
+                        NULL);
+        }
+        if (tmp_error != NULL) {
+                g_propagate_error (error, tmp_error);
+                return NULL;
+        }
+
+        return payload;
+}
+
+/**
+ * rtm_glib_tasks_get_list:
+ * @rtm: a #RtmGlib object already authenticated.
+ * @list_id: %NULL or the id of the list to perform an action on.
+ * @filter: %NULL or if specified, only tasks matching the desired criteria
+ * are returned.
+ * @last_sync: %NULL or an ISO 8601 formatted time value. If @last_sync is
+ * provided, only tasks modified since last_sync will be returned, and each
+ * element will have an attribute, current, equal to @last_sync.
+ * @error: location to store #GError or %NULL.
+ *
+ * Gets the list of tasks.
+ *
+ * Returns: A #GList of #RtmTask objects.
+ **/
+GList *
+rtm_glib_tasks_get_list (RtmGlib *rtm, gchar *list_id, gchar *filter,
+                         gchar *last_sync, GError **error)
+{
+        g_return_val_if_fail (rtm != NULL, NULL);
+        g_return_val_if_fail (rtm_glib_has_auth_token (rtm), NULL);
+
+        if (filter == NULL) {
+                filter = "";
+        }
+        if (last_sync == NULL) {
+                last_sync = "";
+        }
+
+        GBytes *payload;
+        GList *list = NULL;
+        gint64 start;
+        gboolean json;
+
+        payload = rtm_glib_tasks_fetch (rtm, list_id, filter, last_sync,
+                                        &json, error);
+        if (payload == NULL) {
+                return NULL;
+        }
+
+        start = g_get_monotonic_time ();
+        if (json) {
+                list = rtm_glib_decode_tasks (payload, rtm->priv->lazy_tasks,
+                                              error);
+        } else {
+                list = rtm_glib_decode_tasks_xml (
+                        payload, rtm->priv->lazy_tasks, error);
+        }
+        rtm_glib_record_load (rtm, RTM_METHOD_TASKS_GET_LIST, start);
+        g_bytes_unref (payload);
+
+        return list;
+}
+
+/**
+ * rtm_glib_tasks_get_list_async:
+ * @rtm: a #RtmGlib object already authenticated.
+ * @list_id: %NULL or the id of the list to perform an action on.
+ * @filter: %NULL or if specified, only tasks matching the desired criteria
+ * are returned.
+ * @last_sync: %NULL or an ISO 8601 formatted time value. If @last_sync is
+ * provided, only tasks modified since last_sync will be returned, and each
+ * element will have an attribute, current, equal to @last_sync.
+ * @cancellable: optional #GCancellable object, %NULL to ignore.
+ * @callback: a #GAsyncReadyCallback to call when the request is satisfied.
+ * @user_data: the data to pass to callback function.
+ *
+ * Asynchronously gets the list of tasks.
+ *
+ * When the operation is finished, @callback will be called. You can then call
+ * rtm_glib_tasks_get_list_finish() to get the result of the operation.
+ **/
+void
+rtm_glib_tasks_get_list_async (RtmGlib *rtm, gchar *list_id, gchar *filter,
+                               gchar *last_sync, GCancellable *cancellable,
+                               GAsyncReadyCallback callback,
+                               gpointer user_data)
+{
+        g_return_if_fail (rtm != NULL);
+        g_return_if_fail (rtm_glib_has_auth_token (rtm));
+
+        gboolean json = rtm->priv->use_json;
+
+        if (filter == NULL) {
+                filter = "";
+        }
+        if (last_sync == NULL) {
+                last_sync = "";
+        }
+
+        if (json && list_id == NULL) {
+                rtm_glib_call_method_json_async (
+                        rtm,
+                        RTM_METHOD_TASKS_GET_LIST,
+                        cancellable, callback, user_data,
+                        "auth_token", RTM_GLIB_AUTH_TOKEN,
+                        "filter", filter,
+                        "last_sync", last_sync,
+                        NULL);
+        } else if (json) {
+                rtm_glib_call_method_json_async (
+                        rtm,
+                        RTM_METHOD_TASKS_GET_LIST,
+                        cancellable, callback, user_data,
+                        "auth_token", RTM_GLIB_AUTH_TOKEN,
+                        "list_id", list_id,
+                        "filter", filter,
+                        "last_sync", last_sync,
+                        NULL);
+        } else if (list_id == NULL) {
+                rtm_glib_call_method_streamed_async (
+                        rtm,
+                        RTM_METHOD_TASKS_GET_LIST,
+                        cancellable, callback, user_data,
+                        "auth_token", RTM_GLIB_AUTH_TOKEN,
+                        "filter", filter,
+                        "last_sync", last_sync,
+                        NULL);
+        } else {
+                rtm_glib_call_method_streamed_async (
+                        rtm,
+                        RTM_METHOD_TASKS_GET_LIST,
+                        cancellable, callback, user_data,
+                        "auth_token", RTM_GLIB_AUTH_TOKEN,
+                        "list_id", list_id,
+                        "filter", filter,
+                        "last_sync", last_sync,
+                        NULL);
+        }
+}
+
+/**
+ * rtm_glib_tasks_get_list_finish:
+ * @rtm: a #RtmGlib object.
+ * @result: the #GAsyncResult passed to the callback.
+ * @error: location to store #GError or %NULL.
+ *
+ * Finishes an operation started with rtm_glib_tasks_get_list_async().
+ *
+ * Returns: A #GList of #RtmTask objects.
+ **/
+GList *
+rtm_glib_tasks_get_list_finish (RtmGlib *rtm, GAsyncResult *result,
+                                GError **error)
+{
+        g_return_val_if_fail (rtm != NULL, NULL);
+
+        GBytes *payload;
+        GList *list;
+        gint64 start;
+        gboolean json;
+
+        /* Both JSON and XML responses of tasks.getList are kept as payload */
+        json = rtm_glib_call_method_is_json (result);
+        payload = rtm_glib_call_method_json_finish (rtm, result, error);
+        if (payload == NULL) {
+                return NULL;
+        }
+
+        start = g_get_monotonic_time ();
+        if (json) {
+                list = rtm_glib_decode_tasks (payload, rtm->priv->lazy_tasks,
+                                              error);
+        } else {
+                list = rtm_glib_decode_tasks_xml (
+                        payload, rtm->priv->lazy_tasks, error);
+        }
+        rtm_glib_record_load (rtm, RTM_METHOD_TASKS_GET_LIST, start);
+        g_bytes_unref (payload);
+
+        return list;
+}
+
+/**
+ * rtm_glib_tasks_get_batch:
+ * @rtm: a #RtmGlib object already authenticated.
+ * @list_id: %NULL or the id of the list to perform an action on.
+ * @filter: %NULL or if specified, only tasks matching the desired criteria
+ * are returned.
+ * @last_sync: %NULL or an ISO 8601 formatted time value. If @last_sync is
+ * provided, only tasks modified since last_sync will be returned, and each
+ * element will have an attribute, current, equal to @last_sync.
+ * @error: location to store #GError or %NULL.
+ *
+ * Gets the list of tasks, as rtm_glib_tasks_get_list(), into a
+ * #RtmTaskBatch whose tasks share one arena instead of a #RtmTask object
+ * each.
+ *
+ * Returns: A #RtmTaskBatch, free it with rtm_task_batch_unref().
+ **/
+RtmTaskBatch *
+rtm_glib_tasks_get_batch (RtmGlib *rtm, gchar *list_id, gchar *filter,
+                          gchar *last_sync, GError **error)
+{
+        g_return_val_if_fail (rtm != NULL, NULL);
+        g_return_val_if_fail (rtm_glib_has_auth_token (rtm), NULL);
+
+        if (filter == NULL) {
+                filter = "";
+        }
+        if (last_sync == NULL) {
+                last_sync = "";
+        }
+
+        GBytes *payload;
+        RtmTaskBatch *batch;
+        gint64 start;
+        gboolean json;
+
+        payload = rtm_glib_tasks_fetch (rtm, list_id, filter, last_sync,
+                                        &json, error);
+        if (payload == NULL) {
+                return NULL;
+        }
+
+        start = g_get_monotonic_time ();
+        batch = rtm_glib_decode_task_batch (payload, json, error);
+        rtm_glib_record_load (rtm, RTM_METHOD_TASKS_GET_LIST, start);
+        g_bytes_unref (payload);
+
+        return batch;
+}
+
+/**
+ * rtm_glib_tasks_get_batch_async:
+ * @rtm: a #RtmGlib object already authenticated.
+ * @list_id: %NULL or the id of the list to perform an action on.
+ * @filter: %NULL or if specified, only tasks matching the desired criteria
+ * are returned.
+ * @last_sync: %NULL or an ISO 8601 formatted time value.
+ * @cancellable: optional #GCancellable object, %NULL to ignore.
+ * @callback: a #GAsyncReadyCallback to call when the request is satisfied.
+ * @user_data: the data to pass to callback function.
+ *
+ * Asynchronously gets the list of tasks into a #RtmTaskBatch.
+ *
+ * When the operation is finished, @callback will be called. You can then call
+ * rtm_glib_tasks_get_batch_finish() to get the result of the operation.
+ **/
+void
+rtm_glib_tasks_get_batch_async (RtmGlib *rtm, gchar *list_id, gchar *filter,
+                                gchar *last_sync, GCancellable *cancellable,
+                                GAsyncReadyCallback callback,
+                                gpointer user_data)
+{
+        /* The same call, only the result is decoded otherwise */
+        rtm_glib_tasks_get_list_async (rtm, list_id, filter, last_sync,
+                                       cancellable, callback, user_data);
+}
+
+/**
+ * rtm_glib_tasks_get_batch_finish:
+ * @rtm: a #RtmGlib object.
+ * @result: the #GAsyncResult passed to the callback.
+ * @error: location to store #GError or %NULL.
+ *
+ * Finishes an operation started with rtm_glib_tasks_get_batch_async().
+ *
+ * Returns: A #RtmTaskBatch, free it with rtm_task_batch_unref().
+ **/
+RtmTaskBatch *
+rtm_glib_tasks_get_batch_finish (RtmGlib *rtm, GAsyncResult *result,
+                                 GError **error)
+{
+        g_return_val_if_fail (rtm != NULL, NULL);
+
+        GBytes *payload;
+        RtmTaskBatch *batch;
+        gint64 start;
+        gboolean json;
+
+        json = rtm_glib_call_method_is_json (result);
+        payload = rtm_glib_call_method_json_finish (rtm, result, error);
+        if (payload == NULL) {
+                return NULL;
+        }
+
+        start = g_get_monotonic_time ();
+        batch = rtm_glib_decode_task_batch (payload, json, error);
+        rtm_glib_record_load (rtm, RTM_METHOD_TASKS_GET_LIST, start);
+        g_bytes_unref (payload);
+
+        return batch;
+}
+
+/*
+ * A rtm_glib_tasks_foreach_async() call. Each attempt gets a new parser, an
+ * attempt is only retried while no task has been handed out.
+ */
+typedef struct {
+        gchar **params;
+        RtmGlibTaskFunc func;
+        gpointer func_data;
+        RtmTransport *transport;
+        RtmTaskParser *parser;
+        RtmTimeout *timeout;
+        RtmGlibCallTimes times;
+        gint64 phase_start;
+        guint attempt;
+        guint n_tasks;
+        GError *error;
+} RtmGlibForeachData;
+
+static void
+rtm_glib_foreach_data_free (RtmGlibForeachData *data)
+{
+        g_strfreev (data->params);
+        g_object_unref (data->transport);
+        if (data->parser) {
+                rtm_task_parser_free (data->parser);
+        }
+        g_clear_error (&data->error);
+
+        g_slice_free (RtmGlibForeachData, data);
+}
+
+static void
+rtm_glib_tasks_foreach_schedule (GTask *task, gint64 backoff);
+
+static void
+rtm_glib_tasks_foreach_task (RtmTask *rtm_task, gpointer user_data)
+{
+        GTask *task = G_TASK (user_data);
+        RtmGlibForeachData *data = g_task_get_task_data (task);
+
+        data->n_tasks++;
+        data->func (g_task_get_source_object (task), rtm_task,
+                    data->func_data);
+
+        g_object_unref (rtm_task);
+}
+
+static void
+rtm_glib_tasks_foreach_chunk (const gchar *chunk, gsize length,
+                              gpointer user_data)
+{
+        GTask *task = G_TASK (user_data);
+        RtmGlibForeachData *data = g_task_get_task_data (task);
+
+        if (data->error != NULL) {
+                return;
+        }
+
+        data->times.payload_size = MAX (data->times.payload_size, 0) + length;
+
+        /* Stop the download of a failed or malformed response */
+        if (!rtm_task_parser_feed (data->parser, chunk, length,
+                                   &data->error)) {
+                g_cancellable_cancel (
+                        rtm_timeout_get_cancellable (data->timeout));
+        }
+}
+
+static void
+rtm_glib_tasks_foreach_cb (GObject *source_object, GAsyncResult *result,
+                           gpointer user_data)
+{
+        GTask *task = G_TASK (user_data);
+        RtmGlibForeachData *data = g_task_get_task_data (task);
+        RtmGlib *rtm = g_task_get_source_object (task);
+        GError *tmp_error = NULL;
+
+        if (!rtm_transport_send_stream_finish (RTM_TRANSPORT (source_object),
+                                               result, &tmp_error)) {
+                rtm_timeout_check (data->timeout, &tmp_error);
+        }
+        rtm_glib_call_times_add (&data->times, RTM_METHOD_PHASE_NETWORK,
+                                 data->phase_start);
+        rtm_timeout_free (data->timeout);
+        data->timeout = NULL;
+
+        if (data->error != NULL) {
+                g_clear_error (&tmp_error);
+                tmp_error = data->error;
+                data->error = NULL;
+        } else if (tmp_error == NULL) {
+                rtm_task_parser_finish (data->parser, &tmp_error);
+        }
+        rtm_task_parser_free (data->parser);
+        data->parser = NULL;
+
+        if (tmp_error != NULL && data->n_tasks == 0 &&
+            rtm_glib_should_retry (rtm, RTM_METHOD_TASKS_GET_LIST,
+                                   data->attempt, tmp_error)) {
+                DEBUG_PRINT ("rtm_tasks_foreach: failed, retrying: %s",
+                             tmp_error->message);
+                g_error_free (tmp_error);
+
+                rtm_glib_tasks_foreach_schedule (
+                        task, rtm_glib_get_backoff (rtm, data->attempt));
+                data->attempt++;
+
+                g_object_unref (task);
+                return;
+        }
+
+        rtm_glib_record_call (rtm, RTM_METHOD_TASKS_GET_LIST, &data->times,
+                              tmp_error != NULL);
+
+        if (tmp_error != NULL) {
+                g_task_return_error (task, tmp_error);
+        } else {
+                g_task_return_boolean (task, TRUE);
+        }
+        g_object_unref (task);
+}
+
+static gboolean
+rtm_glib_tasks_foreach_send (gpointer user_data)
+{
+        GTask *task = G_TASK (user_data);
+        RtmGlibForeachData *data = g_task_get_task_data (task);
+        RtmGlib *rtm = g_task_get_source_object (task);
+        RtmSignedParams signed_params;
+
+        /* Cancelled while waiting for the rate limit or the backoff */
+        if (g_task_return_error_if_cancelled (task)) {
+                rtm_glib_refund_send (rtm);
+                rtm_glib_record_call (rtm, RTM_METHOD_TASKS_GET_LIST,
+                                      &data->times, TRUE);
+                return FALSE;
+        }
+
+        rtm_glib_call_times_add (&data->times, RTM_METHOD_PHASE_QUEUE,
+                                 data->phase_start);
+        data->phase_start = g_get_monotonic_time ();
+
+        data->parser = rtm_task_parser_new (rtm_glib_tasks_foreach_task,
+                                            task);
+        rtm_task_parser_set_lazy (data->parser, rtm->priv->lazy_tasks);
+        rtm_glib_sign_params (rtm, RTM_METHOD_TASKS_GET_LIST, data->params,
+                              &signed_params);
+        data->timeout = rtm_timeout_new (rtm->priv->timeout,
+                                         g_task_get_cancellable (task));
+        rtm_glib_mark_send (rtm);
+
+        rtm_transport_send_stream_async (
+                data->transport, signed_params.params,
+                rtm_glib_tasks_foreach_chunk, task,
+                rtm_timeout_get_cancellable (data->timeout),
+                rtm_glib_tasks_foreach_cb, g_object_ref (task));
+
+        rtm_signed_params_clear (&signed_params);
+
+        return FALSE;
+}
+
+/**
+ * rtm_glib_tasks_foreach_schedule:
+ * @task: the #GTask of a rtm_glib_tasks_foreach_async() call.
+ * @backoff: extra time in microseconds to wait before sending the call.
+ *
+ * Sends the call once the rate limit and @backoff allow it.
+ */
+static void
+rtm_glib_tasks_foreach_schedule (GTask *task, gint64 backoff)
+{
+        RtmGlibForeachData *data = g_task_get_task_data (task);
+        RtmGlib *rtm = g_task_get_source_object (task);
+        GSource *source;
+        gint64 delay;
+
+        delay = rtm_glib_reserve_send (rtm);
+        delay += backoff;
+
+        data->phase_start = g_get_monotonic_time ();
+
+        if (delay > 0) {
+                source = g_timeout_source_new ((delay + 999) / 1000);
+                g_source_set_callback (source, rtm_glib_tasks_foreach_send,
+                                       g_object_ref (task), g_object_unref);
+                g_source_attach (source, g_task_get_context (task));
+                g_source_unref (source);
+        } else {
+                rtm_glib_tasks_foreach_send (task);
+        }
+}
+
+/**
+ * rtm_glib_tasks_foreach_async:
+ * @rtm: a #RtmGlib object already authenticated.
+ * @list_id: %NULL or the id of the list to perform an action on.
+ * @filter: %NULL or if specified, only tasks matching the desired criteria
+ * are returned.
+ * @last_sync: %NULL or an ISO 8601 formatted time value. If @last_sync is
+ * provided, only tasks modified since last_sync will be returned.
+ * @func: the #RtmGlibTaskFunc called for each task.
+ * @func_data: the data to pass to @func.
+ * @cancellable: optional #GCancellable object, %NULL to ignore.
+ * @callback: a #GAsyncReadyCallback to call when the request is satisfied.
+ * @user_data: the data to pass to callback function.
+ *
+ * Asynchronously gets the list of tasks, calling @func for each task as
+ * soon as it is downloaded instead of waiting for the whole response. The
+ * response is parsed while it arrives, so the tasks can be shown or indexed
+ * meanwhile and the whole list is never kept in memory.
+ *
+ * @func is called from the thread-default main context of the caller, in
+ * the order of the response. The response is always XML, whatever
+ * #RtmGlib:use_json says. A call is only sent again after a transient error
+ * if no task was handed out yet.
+ *
+ * When the operation is finished, after the last call to @func, @callback
+ * will be called. You can then call rtm_glib_tasks_foreach_finish() to know
+ * if every task was got.
+ **/
+void
+rtm_glib_tasks_foreach_async (RtmGlib *rtm, gchar *list_id, gchar *filter,
+                              gchar *last_sync, RtmGlibTaskFunc func,
+                              gpointer func_data, GCancellable *cancellable,
+                              GAsyncReadyCallback callback,
+                              gpointer user_data)
+{
+        g_return_if_fail (rtm != NULL);
+        g_return_if_fail (rtm_glib_has_auth_token (rtm));
+        g_return_if_fail (func != NULL);
+
+        GTask *task;
+        RtmGlibForeachData *data;
+        GPtrArray *params;
+
+        params = g_ptr_array_new ();
+        g_ptr_array_add (params, g_strdup ("auth_token"));
+        g_ptr_array_add (params, rtm_glib_dup_auth_token (rtm));
+        if (list_id != NULL) {
+                g_ptr_array_add (params, g_strdup ("list_id"));
+                g_ptr_array_add (params, g_strdup (list_id));
+        }
+        g_ptr_array_add (params, g_strdup ("filter"));
+        g_ptr_array_add (params, g_strdup (filter ? filter : ""));
+        g_ptr_array_add (params, g_strdup ("last_sync"));
+        g_ptr_array_add (params, g_strdup (last_sync ? last_sync : ""));
+        g_ptr_array_add (params, NULL);
+
+        data = g_slice_new0 (RtmGlibForeachData);
+        data->params = (gchar **) g_ptr_array_free (params, FALSE);
+        data->func = func;
+        data->func_data = func_data;
+        data->transport = rtm_glib_ref_transport (rtm);
+        rtm_glib_call_times_init (&data->times);
+
+        DEBUG_PRINT ("rtm_tasks_foreach: %s", RTM_METHOD_TASKS_GET_LIST);
+
+        task = g_task_new (rtm, cancellable, callback, user_data);
+        g_task_set_source_tag (task, rtm_glib_tasks_foreach_async);
+        g_task_set_task_data (task, data,
+                              (GDestroyNotify) rtm_glib_foreach_data_free);
+
+        rtm_glib_tasks_foreach_schedule (task, 0);
+
+        g_object_unref (task);
+}
+
+/**
+ * rtm_glib_tasks_foreach_finish:
+ * @rtm: a #RtmGlib object.
+ * @result: the #GAsyncResult passed to the callback.
+ * @error: location to store #GError or %NULL.
+ *
+ * Finishes an operation started with rtm_glib_tasks_foreach_async().
+ *
+ * Returns: %TRUE if every task was handed out, %FALSE on error. The tasks
+ * handed out before the error are still valid.
+ **/
+gboolean
+rtm_glib_tasks_foreach_finish (RtmGlib *rtm, GAsyncResult *result,
+                               GError **error)
+{
+        g_return_val_if_fail (g_task_is_valid (result, rtm), FALSE);
+
+        return g_task_propagate_boolean (G_TASK (result), error);
+}
+
+/**
+ * rtm_glib_lists_get_list:
+ * @rtm: a #RtmGlib object already authenticated.
+ * @error: location to store #GError or %NULL.
+ *
+ * Gets the list of lists.
+ *
+ * Returns: A #GList of #RtmList objects.
+ **/
+GList *
+rtm_glib_lists_get_list (RtmGlib *rtm, GError **error)
+{
+        g_return_val_if_fail (rtm != NULL, NULL);
+        g_return_val_if_fail (rtm_glib_has_auth_token (rtm), NULL);
+
+        RestXmlNode *root;
+        GBytes *payload;
+        GList *glist = NULL;
+        gint64 start;
+        GError *tmp_error = NULL;
+
+        if (rtm->priv->use_json) {
+                payload = rtm_glib_call_method_json (rtm,
+                        RTM_METHOD_LISTS_GET_LIST, &tmp_error,
+                        "auth_token", RTM_GLIB_AUTH_TOKEN,
+                        NULL);
+                if (tmp_error != NULL) {
+                        g_propagate_error (error, tmp_error);
+                        return NULL;
+                }
+
+                start = g_get_monotonic_time ();
+                glist = rtm_glib_decode_lists (payload, error);
+                rtm_glib_record_load (rtm, RTM_METHOD_LISTS_GET_LIST, start);
+                g_bytes_unref (payload);
+
+                return glist;
+        }
+
+        root = rtm_glib_call_method (rtm,
+                RTM_METHOD_LISTS_GET_LIST, &tmp_error,
+                "auth_token", RTM_GLIB_AUTH_TOKEN,
+                NULL);
+        if (tmp_error != NULL) {
+                g_propagate_error (error, tmp_error);
+                return NULL;
+        }
+
+        start = g_get_monotonic_time ();
+        glist = rtm_glib_parse_lists (root);
+        rtm_glib_record_load (rtm, RTM_METHOD_LISTS_GET_LIST, start);
+
+        rest_xml_node_unref (root);
+
+        return glist;
+}
+
+/**
+ * rtm_glib_lists_get_list_async:
+ * @rtm: a #RtmGlib object already authenticated.
+ * @cancellable: optional #GCancellable object, %NULL to ignore.
+ * @callback: a #GAsyncReadyCallback to call when the request is satisfied.
+ * @user_data: the data to pass to callback function.
+ *
+ * Asynchronously gets the list of lists.
+ *
+ * When the operation is finished, @callback will be called. You can then call
+ * rtm_glib_lists_get_list_finish() to get the result of the operation.
+ **/
+void
+rtm_glib_lists_get_list_async (RtmGlib *rtm, GCancellable *cancellable,
+                               GAsyncReadyCallback callback,
+                               gpointer user_data)
+{
+        g_return_if_fail (rtm != NULL);
+        g_return_if_fail (rtm_glib_has_auth_token (rtm));
+
+        if (rtm->priv->use_json) {
+                rtm_glib_call_method_json_async (rtm,
+                        RTM_METHOD_LISTS_GET_LIST,
+                        cancellable, callback, user_data,
+                        "auth_token", RTM_GLIB_AUTH_TOKEN,
+                        NULL);
+        } else {
+                rtm_glib_call_method_async (rtm,
+                        RTM_METHOD_LISTS_GET_LIST,
+                        cancellable, callback, user_data,
+                        "auth_token", RTM_GLIB_AUTH_TOKEN,
+                        NULL);
+        }
+}
+
+/**
+ * rtm_glib_lists_get_list_finish:
+ * @rtm: a #RtmGlib object.
+ * @result: the #GAsyncResult passed to the callback.
+ * @error: location to store #GError or %NULL.
+ *
+ * Finishes an operation started with rtm_glib_lists_get_list_async().
+ *
+ * Returns: A #GList of #RtmList objects.
+ **/
+GList *
+rtm_glib_lists_get_list_finish (RtmGlib *rtm, GAsyncResult *result,
+                                GError **error)
+{
+        g_return_val_if_fail (rtm != NULL, NULL);
+
+        RestXmlNode *root;
+        GBytes *payload;
+        GList *glist;
+        gint64 start;
+
+        if (rtm_glib_call_method_is_json (result)) {
+                payload = rtm_glib_call_method_json_finish (rtm, result,
+                                                            error);
+                if (payload == NULL) {
+                        return NULL;
+                }
+
+                start = g_get_monotonic_time ();
+                glist = rtm_glib_decode_lists (payload, error);
+                rtm_glib_record_load (rtm, RTM_METHOD_LISTS_GET_LIST, start);
+                g_bytes_unref (payload);
+
+                return glist;
+        }
+
+        root = rtm_glib_call_method_finish (rtm, result, error);
+        if (root == NULL) {
+                return NULL;
+        }
+
+        start = g_get_monotonic_time ();
+        glist = rtm_glib_parse_lists (root);
+        rtm_glib_record_load (rtm, RTM_METHOD_LISTS_GET_LIST, start);
+
+        rest_xml_node_unref (root);
+
+        return glist;
+}
+
+/**
+ * rtm_glib_timelines_create:
+ * @rtm: a #RtmGlib object already authenticated.
+ * @error: location to store #GError or %NULL.
+ *
+ * Gets a new timeline.
+ *
+ * Returns: A timeline.
+ **/
+gchar *
+rtm_glib_timelines_create (RtmGlib *rtm, GError **error)
+{
+        g_return_val_if_fail (rtm != NULL, NULL);
+        g_return_val_if_fail (rtm_glib_has_auth_token (rtm), NULL);
+
+        RestXmlNode *root;
+        gchar *timeline;
+        GError *tmp_error = NULL;
+
+        root = rtm_glib_call_method (rtm,
+                RTM_METHOD_TIMELINES_CREATE, &tmp_error,
+                "auth_token", RTM_GLIB_AUTH_TOKEN,
+                NULL);
+        if (tmp_error != NULL) {
+                g_propagate_error (error, tmp_error);
+                return NULL;
+        }
+
+        timeline = rtm_glib_parse_content (root, "timeline");
+
+        rest_xml_node_unref (root);
+
+        return timeline;
+}
+
+/**
+ * rtm_glib_timelines_create_async:
+ * @rtm: a #RtmGlib object already authenticated.
+ * @cancellable: optional #GCancellable object, %NULL to ignore.
+ * @callback: a #GAsyncReadyCallback to call when the request is satisfied.
+ * @user_data: the data to pass to callback function.
+ *
+ * Asynchronously gets a new timeline.
+ *
+ * When the operation is finished, @callback will be called. You can then call
+ * rtm_glib_timelines_create_finish() to get the result of the operation.
+ **/
+void
+rtm_glib_timelines_create_async (RtmGlib *rtm, GCancellable *cancellable,
+                                 GAsyncReadyCallback callback,
+                                 gpointer user_data)
+{
+        g_return_if_fail (rtm != NULL);
+        g_return_if_fail (rtm_glib_has_auth_token (rtm));
+
+        rtm_glib_call_method_async (rtm,
+                RTM_METHOD_TIMELINES_CREATE, cancellable, callback, user_data,
+                "auth_token", RTM_GLIB_AUTH_TOKEN,
+                NULL);
+}
+
+/**
+ * rtm_glib_timelines_create_finish:
+ * @rtm: a #RtmGlib object.
+ * @result: the #GAsyncResult passed to the callback.
+ * @error: location to store #GError or %NULL.
+ *
+ * Finishes an operation started with rtm_glib_timelines_create_async().
+ *
+ * Returns: A timeline.
+ **/
+gchar *
+rtm_glib_timelines_create_finish (RtmGlib *rtm, GAsyncResult *result,
+                                  GError **error)
+{
+        g_return_val_if_fail (rtm != NULL, NULL);
+
+        RestXmlNode *root;
+        gchar *timeline;
+
+        root = rtm_glib_call_method_finish (rtm, result, error);
+        if (root == NULL) {
+                return NULL;
+        }
+
+        timeline = rtm_glib_parse_content (root, "timeline");
+
+        rest_xml_node_unref (root);
+
+        return timeline;
+}
+
+/**
+ * rtm_glib_tasks_add:
+ * @rtm: a #RtmGlib object already authenticated.
+ * @timeline: the timeline within which to run a method.
+ * @task_name: the desired task name.
+ * @list_id: %NULL or the id of the list to perform an action on.
+ * @parse: %FALSE or %TRUE to specify whether to process name using Smart Add.
+ * @error: location to store #GError or %NULL.
+ *
+ * Adds a task to the list specified by @list_id or the default list if
+ * @list_id is %NULL.
+ *
+ * Returns: A #RtmTask with the data of the task added.
+ **/
+RtmTask *
+rtm_glib_tasks_add (RtmGlib *rtm, gchar* timeline, gchar *task_name,
+                    gchar *list_id, gboolean parse, GError **error)
+{
+        g_return_val_if_fail (rtm != NULL, NULL);
+        g_return_val_if_fail (rtm_glib_has_auth_token (rtm), NULL);
+        g_return_val_if_fail (timeline != NULL, NULL);
+        g_return_val_if_fail (task_name != NULL, NULL);
+
+        RestXmlNode *root;
+        RtmTask *task;
+        GError *tmp_error = NULL;
+        gchar *parse_smart_add = "0";
+
+        if (parse) {
+                parse_smart_add = "1";
+        }
+
+        if (list_id == NULL) {
+                root = rtm_glib_call_method (
+                        rtm,
+                        RTM_METHOD_TASKS_ADD, &tmp_error,
+                        "auth_token", RTM_GLIB_AUTH_TOKEN,
+                        "timeline", timeline,
+                        "name", task_name,
+                        "parse", parse_smart_add,
+                        NULL);
+        } else {
+                root = rtm_glib_call_method (
+                        rtm,
+                        RTM_METHOD_TASKS_ADD, &tmp_error,
+                        "auth_token", RTM_GLIB_AUTH_TOKEN,
+                        "timeline", timeline,
+                        "name", task_name,
+                        "list_id", list_id,
+                        "parse", parse_smart_add,
+                        NULL);
+        }
+        if (tmp_error != NULL) {
+                g_propagate_error (error, tmp_error);
+                return NULL;
+        }
+
+        task = rtm_glib_parse_task (root);
+
+        rest_xml_node_unref (root);
+
+        return task;
+}
+
+/**
+ * rtm_glib_tasks_add_async:
+ * @rtm: a #RtmGlib object already authenticated.
+ * @timeline: the timeline within which to run a method.
+ * @task_name: the desired task name.
+ * @list_id: %NULL or the id of the list to perform an action on.
+ * @parse: %FALSE or %TRUE to specify whether to process name using Smart Add.
+ * @cancellable: optional #GCancellable object, %NULL to ignore.
+ * @callback: a #GAsyncReadyCallback to call when the request is satisfied.
+ * @user_data: the data to pass to callback function.
+ *
+ * Asynchronously adds a task to the list specified by @list_id or the default
+ * list if @list_id is %NULL.
+ *
+ * When the operation is finished, @callback will be called. You can then call
+ * rtm_glib_tasks_add_finish() to get the result of the operation.
+ **/
+void
+rtm_glib_tasks_add_async (RtmGlib *rtm, gchar* timeline, gchar *task_name,
+                          gchar *list_id, gboolean parse,
+                          GCancellable *cancellable,
+                          GAsyncReadyCallback callback, gpointer user_data)
+{
+        g_return_if_fail (rtm != NULL);
+        g_return_if_fail (rtm_glib_has_auth_token (rtm));
+        g_return_if_fail (timeline != NULL);
+        g_return_if_fail (task_name != NULL);
+
+        gchar *parse_smart_add = "0";
+
+        if (parse) {
+                parse_smart_add = "1";
+        }
+
+        if (list_id == NULL) {
+                rtm_glib_call_method_async (
+                        rtm,
+                        RTM_METHOD_TASKS_ADD, cancellable, callback, user_data,
+                        "auth_token", RTM_GLIB_AUTH_TOKEN,
+                        "timeline", timeline,
+                        "name", task_name,
+                        "parse", parse_smart_add,
+                        NULL);
+        } else {
+                rtm_glib_call_method_async (
+                        rtm,
+                        RTM_METHOD_TASKS_ADD, cancellable, callback, user_data,
+                        "auth_token", RTM_GLIB_AUTH_TOKEN,
+                        "timeline", timeline,
+                        "name", task_name,
+                        "list_id", list_id,
+                        "parse", parse_smart_add,
+                        NULL);
+        }
+}
+
+/**
+ * rtm_glib_tasks_add_finish:
+ * @rtm: a #RtmGlib object.
+ * @result: the #GAsyncResult passed to the callback.
+ * @error: location to store #GError or %NULL.
+ *
+ * Finishes an operation started with rtm_glib_tasks_add_async().
+ *
+ * Returns: A #RtmTask with the data of the task added.
+ **/
+RtmTask *
+rtm_glib_tasks_add_finish (RtmGlib *rtm, GAsyncResult *result, GError **error)
+{
+        g_return_val_if_fail (rtm != NULL, NULL);
+
+        RestXmlNode *root;
+        RtmTask *task;
+
+        root = rtm_glib_call_method_finish (rtm, result, error);
+        if (root == NULL) {
+                return NULL;
+        }
+
+        task = rtm_glib_parse_task (root);
+
+        rest_xml_node_unref (root);
+
+        return task;
+}
+
+/**
+ * rtm_glib_transactions_undo:
+ * @rtm: a #RtmGlib object already authenticated.
+ * @timeline: the timeline within which to run a method.
+ * @transaction_id: the id of transaction within a timeline.
+ * @error: location to store #GError or %NULL.
+ *
+ * Reverts the affects of an action.
+ *
+ * Returns: %TRUE if the transcation is undone successfuly.
+ **/
+gboolean
+rtm_glib_transactions_undo (RtmGlib *rtm, gchar *timeline,
+                            gchar* transaction_id, GError **error)
+{
+        g_return_val_if_fail (rtm != NULL, FALSE);
+        g_return_val_if_fail (rtm_glib_has_auth_token (rtm), FALSE);
+        g_return_val_if_fail (timeline != NULL, FALSE);
+        g_return_val_if_fail (transaction_id != NULL, FALSE);
+
+        RestXmlNode *root;
+        GError *tmp_error = NULL;
+
+        root = rtm_glib_call_method (rtm,
+                RTM_METHOD_TRANSACTIONS_UNDO, &tmp_error,
+                "auth_token", RTM_GLIB_AUTH_TOKEN,
+                "timeline", timeline,
+                "transaction_id", transaction_id,
+                NULL);
+        if (tmp_error != NULL) {
+                g_propagate_error (error, tmp_error);
+                return FALSE;
+        }
+
+        rest_xml_node_unref (root);
+
+        return TRUE;
+}
+
+/**
+ * rtm_glib_transactions_undo_async:
+ * @rtm: a #RtmGlib object already authenticated.
+ * @timeline: the timeline within which to run a method.
+ * @transaction_id: the id of transaction within a timeline.
+ * @cancellable: optional #GCancellable object, %NULL to ignore.
+ * @callback: a #GAsyncReadyCallback to call when the request is satisfied.
+ * @user_data: the data to pass to callback function.
+ *
+ * Asynchronously reverts the affects of an action.
+ *
+ * When the operation is finished, @callback will be called. You can then call
+ * rtm_glib_transactions_undo_finish() to get the result of the operation.
+ **/
+void
+rtm_glib_transactions_undo_async (RtmGlib *rtm, gchar *timeline,
+                                  gchar* transaction_id,
+                                  GCancellable *cancellable,
+                                  GAsyncReadyCallback callback,
+                                  gpointer user_data)
+{
+        g_return_if_fail (rtm != NULL);
+        g_return_if_fail (rtm_glib_has_auth_token (rtm));
+        g_return_if_fail (timeline != NULL);
+        g_return_if_fail (transaction_id != NULL);
+
+        rtm_glib_call_method_async (rtm,
+                RTM_METHOD_TRANSACTIONS_UNDO, cancellable, callback, user_data,
+                "auth_token", RTM_GLIB_AUTH_TOKEN,
+                "timeline", timeline,
+                "transaction_id", transaction_id,
+                NULL);
+}
+
+/**
+ * rtm_glib_transactions_undo_finish:
+ * @rtm: a #RtmGlib object.
+ * @result: the #GAsyncResult passed to the callback.
+ * @error: location to store #GError or %NULL.
+ *
+ * Finishes an operation started with rtm_glib_transactions_undo_async().
+ *
+ * Returns: %TRUE if the transcation is undone successfuly.
+ **/
+gboolean
+rtm_glib_transactions_undo_finish (RtmGlib *rtm, GAsyncResult *result,
+                                   GError **error)
+{
+        g_return_val_if_fail (rtm != NULL, FALSE);
+
+        RestXmlNode *root;
+
+        root = rtm_glib_call_method_finish (rtm, result, error);
+        if (root == NULL) {
+                return FALSE;
+        }
+
+        rest_xml_node_unref (root);
+
+        return TRUE;
+}
+
+/**
+ * rtm_glib_tasks_delete:
+ * @rtm: a #RtmGlib object already authenticated.
+ * @timeline: the timeline within which to run a method.
+ * @task: a #RtmTask to be deleted.
+ * @error: location to store #GError or %NULL.
+ *
+ * Removes a task.
+ *
+ * Returns: The transaction identifier or %NULL if it fails.
+ **/
+gchar *
+rtm_glib_tasks_delete (RtmGlib *rtm, gchar* timeline, RtmTask *task,
+                       GError **error)
+{
+        g_return_val_if_fail (rtm != NULL, NULL);
+        g_return_val_if_fail (rtm_glib_has_auth_token (rtm), NULL);
+        g_return_val_if_fail (timeline != NULL, NULL);
+        g_return_val_if_fail (task != NULL, NULL);
+
+        RestXmlNode *root;
+        gchar *transaction_id;
+        GError *tmp_error = NULL;
+
+        root = rtm_glib_call_method (
+                rtm,
+                RTM_METHOD_TASKS_DELETE, &tmp_error,
+                "auth_token", RTM_GLIB_AUTH_TOKEN,
+                "timeline", timeline,
+                "list_id", rtm_task_get_list_id (task),
+                "taskseries_id", rtm_task_get_taskseries_id (task),
+                "task_id", rtm_task_get_id (task),
+                NULL);
+        if (tmp_error != NULL) {
+                g_propagate_error (error, tmp_error);
+                return NULL;
+        }
+
+        transaction_id = rtm_glib_parse_transaction_id (root);
+
+        rest_xml_node_unref (root);
+
+        return transaction_id;
+}
+
+/**
+ * rtm_glib_tasks_delete_async:
+ * @rtm: a #RtmGlib object already authenticated.
+ * @timeline: the timeline within which to run a method.
+ * @task: a #RtmTask to be deleted.
+ * @cancellable: optional #GCancellable object, %NULL to ignore.
+ * @callback: a #GAsyncReadyCallback to call when the request is satisfied.
+ * @user_data: the data to pass to callback function.
+ *
+ * Asynchronously removes a task.
+ *
+ * When the operation is finished, @callback will be called. You can then call
+ * rtm_glib_tasks_delete_finish() to get the result of the operation.
+ **/
+void
+rtm_glib_tasks_delete_async (RtmGlib *rtm, gchar* timeline, RtmTask *task,
+                             GCancellable *cancellable,
+                             GAsyncReadyCallback callback, gpointer user_data)
+{
+        g_return_if_fail (rtm != NULL);
+        g_return_if_fail (rtm_glib_has_auth_token (rtm));
+        g_return_if_fail (timeline != NULL);
+        g_return_if_fail (task != NULL);
+
+        rtm_glib_call_method_async (
+                rtm,
+                RTM_METHOD_TASKS_DELETE, cancellable, callback, user_data,
+                "auth_token", RTM_GLIB_AUTH_TOKEN,
+                "timeline", timeline,
+                "list_id", rtm_task_get_list_id (task),
+                "taskseries_id", rtm_task_get_taskseries_id (task),
+                "task_id", rtm_task_get_id (task),
+                NULL);
+}
+
+/**
+ * rtm_glib_tasks_delete_finish:
+ * @rtm: a #RtmGlib object.
+ * @result: the #GAsyncResult passed to the callback.
+ * @error: location to store #GError or %NULL.
+ *
+ * Finishes an operation started with rtm_glib_tasks_delete_async().
+ *
+ * Returns: The transaction identifier or %NULL if it fails.
+ **/
+gchar *
+rtm_glib_tasks_delete_finish (RtmGlib *rtm, GAsyncResult *result,
+                              GError **error)
+{
+        g_return_val_if_fail (rtm != NULL, NULL);
+
+        RestXmlNode *root;
+        gchar *transaction_id;
+
+        root = rtm_glib_call_method_finish (rtm, result, error);
+        if (root == NULL) {
+                return NULL;
+        }
+
+        transaction_id = rtm_glib_parse_transaction_id (root);
+
+        rest_xml_node_unref (root);
+
+        return transaction_id;
+}
+
+/**
+ * rtm_glib_tasks_set_name:
+ * @rtm: a #RtmGlib object already authenticated.
+ * @timeline: the timeline within which to run a method.
+ * @task: a #RtmTask to be modified with the new name.
+ * @name: the desired name.
+ * @error: location to store #GError or %NULL.
+ *
+ * Renames a task.
+ *
+ * Returns: The transaction identifier or %NULL if it fails.
+ **/
+gchar *
+rtm_glib_tasks_set_name (RtmGlib *rtm, gchar* timeline, RtmTask *task,
+                         gchar *name, GError **error)
+{
+        g_return_val_if_fail (rtm != NULL, NULL);
+        g_return_val_if_fail (rtm_glib_has_auth_token (rtm), NULL);
+        g_return_val_if_fail (timeline != NULL, NULL);
+        g_return_val_if_fail (task != NULL, NULL);
+        g_return_val_if_fail (name != NULL, NULL);
+
+        RestXmlNode *root;
+        gchar *transaction_id;
+        GError *tmp_error = NULL;
+
+        root = rtm_glib_call_method (
+                rtm,
+                RTM_METHOD_TASKS_SET_NAME, &tmp_error,
+                "auth_token", RTM_GLIB_AUTH_TOKEN,
+                "timeline", timeline,
+                "list_id", rtm_task_get_list_id (task),
+                "taskseries_id", rtm_task_get_taskseries_id (task),
+                "task_id", rtm_task_get_id (task),
+                "name", name,
+                NULL);
+        if (tmp_error != NULL) {
+                g_propagate_error (error, tmp_error);
+                return NULL;
+        }
+
+        transaction_id = rtm_glib_parse_transaction_id (root);
+
+        rest_xml_node_unref (root);
+
+        return transaction_id;
+}
+
+/**
+ * rtm_glib_tasks_set_name_async:
+ * @rtm: a #RtmGlib object already authenticated.
+ * @timeline: the timeline within which to run a method.
+ * @task: a #RtmTask to be modified with the new name.
+ * @name: the desired name.
+ * @cancellable: optional #GCancellable object, %NULL to ignore.
+ * @callback: a #GAsyncReadyCallback to call when the request is satisfied.
+ * @user_data: the data to pass to callback function.
+ *
+ * Asynchronously renames a task.
+ *
+ * When the operation is finished, @callback will be called. You can then call
+ * rtm_glib_tasks_set_name_finish() to get the result of the operation.
+ **/
+void
+rtm_glib_tasks_set_name_async (RtmGlib *rtm, gchar* timeline, RtmTask *task,
+                               gchar *name, GCancellable *cancellable,
+                               GAsyncReadyCallback callback,
+                               gpointer user_data)
+{
+        g_return_if_fail (rtm != NULL);
+        g_return_if_fail (rtm_glib_has_auth_token (rtm));
+        g_return_if_fail (timeline != NULL);
+        g_return_if_fail (task != NULL);
+        g_return_if_fail (name != NULL);
+
+        rtm_glib_call_method_async (
+                rtm,
+                RTM_METHOD_TASKS_SET_NAME, cancellable, callback, user_data,
+                "auth_token", RTM_GLIB_AUTH_TOKEN,
+                "timeline", timeline,
+                "list_id", rtm_task_get_list_id (task),
+                "taskseries_id", rtm_task_get_taskseries_id (task),
+                "task_id", rtm_task_get_id (task),
+                "name", name,
+                NULL);
+}
+
+/**
+ * rtm_glib_tasks_set_name_finish:
+ * @rtm: a #RtmGlib object.
+ * @result: the #GAsyncResult passed to the callback.
+ * @error: location to store #GError or %NULL.
+ *
+ * Finishes an operation started with rtm_glib_tasks_set_name_async().
+ *
+ * Returns: The transaction identifier or %NULL if it fails.
+ **/
+gchar *
+rtm_glib_tasks_set_name_finish (RtmGlib *rtm, GAsyncResult *result,
+                                GError **error)
+{
+        g_return_val_if_fail (rtm != NULL, NULL);
+
+        RestXmlNode *root;
+        gchar *transaction_id;
+
+        root = rtm_glib_call_method_finish (rtm, result, error);
+        if (root == NULL) {
+                return NULL;
+        }
+
+        transaction_id = rtm_glib_parse_transaction_id (root);
+
+        rest_xml_node_unref (root);
+
+        return transaction_id;
+}
+
+/**
+ * rtm_glib_lists_add:
+ * @rtm: a #RtmGlib object already authenticated.
+ * @timeline: the timeline within which to run a method.
+ * @list_name: the desired list name.
+ * @filter: if specified, a smart list is created with the desired criteria.
+ * @error: location to store #GError or %NULL.
+ *
+ * Adds a new list.
+ *
+ * Returns: A #RtmList with the data of the new list added.
+ **/
+RtmList *
+rtm_glib_lists_add (RtmGlib *rtm, gchar* timeline, gchar *list_name,
+                    gchar *filter, GError **error)
+{
+        g_return_val_if_fail (rtm != NULL, NULL);
+        g_return_val_if_fail (rtm_glib_has_auth_token (rtm), NULL);
+        g_return_val_if_fail (timeline != NULL, NULL);
+        g_return_val_if_fail (list_name != NULL, NULL);
+
+        RestXmlNode *root;
+        RtmList *list;
+        GError *tmp_error = NULL;
+
+        if (filter == NULL) {
+                filter = "";
+        }
+
+        root = rtm_glib_call_method (
+                rtm,
+                RTM_METHOD_LISTS_ADD, &tmp_error,
+                "auth_token", RTM_GLIB_AUTH_TOKEN,
+                "timeline", timeline,
+                "name", list_name,
+                "filter", filter,
+                NULL);
+        if (tmp_error != NULL) {
+                g_propagate_error (error, tmp_error);
+                return NULL;
+        }
+
+        list = rtm_glib_parse_list (root);
+
+        rest_xml_node_unref (root);
+
+        return list;
+}
+
+/**
+ * rtm_glib_lists_add_async:
+ * @rtm: a #RtmGlib object already authenticated.
+ * @timeline: the timeline within which to run a method.
+ * @list_name: the desired list name.
+ * @filter: if specified, a smart list is created with the desired criteria.
+ * @cancellable: optional #GCancellable object, %NULL to ignore.
+ * @callback: a #GAsyncReadyCallback to call when the request is satisfied.
+ * @user_data: the data to pass to callback function.
+ *
+ * Asynchronously adds a new list.
+ *
+ * When the operation is finished, @callback will be called. You can then call
+ * rtm_glib_lists_add_finish() to get the result of the operation.
+ **/
+void
+rtm_glib_lists_add_async (RtmGlib *rtm, gchar* timeline, gchar *list_name,
+                          gchar *filter, GCancellable *cancellable,
+                          GAsyncReadyCallback callback, gpointer user_data)
+{
+        g_return_if_fail (rtm != NULL);
+        g_return_if_fail (rtm_glib_has_auth_token (rtm));
+        g_return_if_fail (timeline != NULL);
+        g_return_if_fail (list_name != NULL);
+
+        if (filter == NULL) {
+                filter = "";
+        }
+
+        rtm_glib_call_method_async (
+                rtm,
+                RTM_METHOD_LISTS_ADD, cancellable, callback, user_data,
+                "auth_token", RTM_GLIB_AUTH_TOKEN,
+                "timeline", timeline,
+                "name", list_name,
+                "filter", filter,
+                NULL);
+}
+
+/**
+ * rtm_glib_lists_add_finish:
+ * @rtm: a #RtmGlib object.
+ * @result: the #GAsyncResult passed to the callback.
+ * @error: location to store #GError or %NULL.
+ *
+ * Finishes an operation started with rtm_glib_lists_add_async().
+ *
+ * Returns: A #RtmList with the data of the new list added.
+ **/
+RtmList *
+rtm_glib_lists_add_finish (RtmGlib *rtm, GAsyncResult *result, GError **error)
+{
+        g_return_val_if_fail (rtm != NULL, NULL);
+
+        RestXmlNode *root;
+        RtmList *list;
+
+        root = rtm_glib_call_method_finish (rtm, result, error);
+        if (root == NULL) {
+                return NULL;
+        }
+
+        list = rtm_glib_parse_list (root);
+
+        rest_xml_node_unref (root);
+
+        return list;
+}
+
+/**
+ * rtm_glib_lists_delete:
+ * @rtm: a #RtmGlib object already authenticated.
+ * @timeline: the timeline within which to run a method.
+ * @list: a #RtmList to be deleted.
+ * @error: location to store #GError or %NULL.
+ *
+ * Removes a list.
+ *
+ * Returns: The transaction identifier or %NULL if it fails.
+ **/
+gchar *
+rtm_glib_lists_delete (RtmGlib *rtm, gchar* timeline, RtmList *list,
+                       GError **error)
+{
+        g_return_val_if_fail (rtm != NULL, NULL);
+        g_return_val_if_fail (rtm_glib_has_auth_token (rtm), NULL);
+        g_return_val_if_fail (timeline != NULL, NULL);
+        g_return_val_if_fail (list != NULL, NULL);
+
+        RestXmlNode *root;
+        gchar *transaction_id;
+        GError *tmp_error = NULL;
+
+        root = rtm_glib_call_method (
+                rtm,
+                RTM_METHOD_LISTS_DELETE, &tmp_error,
+                "auth_token", RTM_GLIB_AUTH_TOKEN,
+                "timeline", timeline,
+                "list_id", rtm_list_get_id (list),
+                NULL);
+        if (tmp_error != NULL) {
+                g_propagate_error (error, tmp_error);
+                return NULL;
+        }
+
+        transaction_id = rtm_glib_parse_transaction_id (root);
+
+        rest_xml_node_unref (root);
+
+        return transaction_id;
+}
+
+/**
+ * rtm_glib_lists_delete_async:
+ * @rtm: a #RtmGlib object already authenticated.
+ * @timeline: the timeline within which to run a method.
+ * @list: a #RtmList to be deleted.
+ * @cancellable: optional #GCancellable object, %NULL to ignore.
+ * @callback: a #GAsyncReadyCallback to call when the request is satisfied.
+ * @user_data: the data to pass to callback function.
+ *
+ * Asynchronously removes a list.
+ *
+ * When the operation is finished, @callback will be called. You can then call
+ * rtm_glib_lists_delete_finish() to get the result of the operation.
+ **/
+void
+rtm_glib_lists_delete_async (RtmGlib *rtm, gchar* timeline, RtmList *list,
+                             GCancellable *cancellable,
+                             GAsyncReadyCallback callback, gpointer user_data)
+{
+        g_return_if_fail (rtm != NULL);
+        g_return_if_fail (rtm_glib_has_auth_token (rtm));
+        g_return_if_fail (timeline != NULL);
+        g_return_if_fail (list != NULL);
+
+        rtm_glib_call_method_async (
+                rtm,
+                RTM_METHOD_LISTS_DELETE, cancellable, callback, user_data,
+                "auth_token", RTM_GLIB_AUTH_TOKEN,
+                "timeline", timeline,
+                "list_id", rtm_list_get_id (list),
+                NULL);
+}
+
+/**
+ * rtm_glib_lists_delete_finish:
+ * @rtm: a #RtmGlib object.
+ * @result: the #GAsyncResult passed to the callback.
+ * @error: location to store #GError or %NULL.
+ *
+ * Finishes an operation started with rtm_glib_lists_delete_async().
+ *
+ * Returns: The transaction identifier or %NULL if it fails.
+ **/
+gchar *
+rtm_glib_lists_delete_finish (RtmGlib *rtm, GAsyncResult *result,
+                              GError **error)
+{
+        g_return_val_if_fail (rtm != NULL, NULL);
+
+        RestXmlNode *root;
+        gchar *transaction_id;
+
+        root = rtm_glib_call_method_finish (rtm, result, error);
+        if (root == NULL) {
+                return NULL;
+        }
+
+        transaction_id = rtm_glib_parse_transaction_id (root);
+
+        rest_xml_node_unref (root);
+
+        return transaction_id;
+}
+
+/**
+ * rtm_glib_lists_set_name:
+ * @rtm: a #RtmGlib object already authenticated.
+ * @timeline: the timeline within which to run a method.
+ * @list: a #RtmList to be modified with the new name.
+ * @name: the desired name.
+ * @error: location to store #GError or %NULL.
+ *
+ * Renames a list. The new name can not be %Inbox or %Sent.
+ *
+ * Returns: The transaction identifier or %NULL if it fails.
+ **/
+gchar *
+rtm_glib_lists_set_name (RtmGlib *rtm, gchar* timeline, RtmList *list,
+                         gchar *name, GError **error)
+{
+        g_return_val_if_fail (rtm != NULL, NULL);
+        g_return_val_if_fail (rtm_glib_has_auth_token (rtm), NULL);
+        g_return_val_if_fail (timeline != NULL, NULL);
+        g_return_val_if_fail (list != NULL, NULL);
+        g_return_val_if_fail (name != NULL, NULL);
+        g_return_val_if_fail (
+                (g_strcmp0 (name, "Inbox") != 0) ||
+                (g_strcmp0 (name, "Sent") != 0),
+                NULL);
+
+        RestXmlNode *root;
+        gchar *transaction_id;
+        GError *tmp_error = NULL;
+
+        root = rtm_glib_call_method (
+                rtm,
+                RTM_METHOD_LISTS_SET_NAME, &tmp_error,
+                "auth_token", RTM_GLIB_AUTH_TOKEN,
+                "timeline", timeline,
+                "list_id", rtm_list_get_id (list),
+                "name", name,
+                NULL);
+        if (tmp_error != NULL) {
+                g_propagate_error (error, tmp_error);
+                return NULL;
         }
 
-        node = rest_xml_node_find (root, "api_key");
-        valid = (g_strcmp0 (node->content, rtm->priv->api_key) == 0);
+        transaction_id = rtm_glib_parse_transaction_id (root);
 
-        node = rest_xml_node_find (root, "method");
-        DEBUG_PRINT ("method: %s", node->content);
+        rest_xml_node_unref (root);
+
+        return transaction_id;
+}
+
+/**
+ * rtm_glib_lists_set_name_async:
+ * @rtm: a #RtmGlib object already authenticated.
+ * @timeline: the timeline within which to run a method.
+ * @list: a #RtmList to be modified with the new name.
+ * @name: the desired name.
+ * @cancellable: optional #GCancellable object, %NULL to ignore.
+ * @callback: a #GAsyncReadyCallback to call when the request is satisfied.
+ * @user_data: the data to pass to callback function.
+ *
+ * Asynchronously renames a list.
+ *
+ * When the operation is finished, @callback will be called. You can then call
+ * rtm_glib_lists_set_name_finish() to get the result of the operation.
+ **/
+void
+rtm_glib_lists_set_name_async (RtmGlib *rtm, gchar* timeline, RtmList *list,
+                               gchar *name, GCancellable *cancellable,
+                               GAsyncReadyCallback callback,
+                               gpointer user_data)
+{
+        g_return_if_fail (rtm != NULL);
+        g_return_if_fail (rtm_glib_has_auth_token (rtm));
+        g_return_if_fail (timeline != NULL);
+        g_return_if_fail (list != NULL);
+        g_return_if_fail (name != NULL);
+        g_return_if_fail (
+                (g_strcmp0 (name, "Inbox") != 0) ||
+                (g_strcmp0 (name, "Sent") != 0));
+
+        rtm_glib_call_method_async (
+                rtm,
+                RTM_METHOD_LISTS_SET_NAME, cancellable, callback, user_data,
+                "auth_token", RTM_GLIB_AUTH_TOKEN,
+                "timeline", timeline,
+                "list_id", rtm_list_get_id (list),
+                "name", name,
+                NULL);
+}
+
+/**
+ * rtm_glib_lists_set_name_finish:
+ * @rtm: a #RtmGlib object.
+ * @result: the #GAsyncResult passed to the callback.
+ * @error: location to store #GError or %NULL.
+ *
+ * Finishes an operation started with rtm_glib_lists_set_name_async().
+ *
+ * Returns: The transaction identifier or %NULL if it fails.
+ **/
+gchar *
+rtm_glib_lists_set_name_finish (RtmGlib *rtm, GAsyncResult *result,
+                                GError **error)
+{
+        g_return_val_if_fail (rtm != NULL, NULL);
+
+        RestXmlNode *root;
+        gchar *transaction_id;
+
+        root = rtm_glib_call_method_finish (rtm, result, error);
+        if (root == NULL) {
+                return NULL;
+        }
+
+        transaction_id = rtm_glib_parse_transaction_id (root);
 
         rest_xml_node_unref (root);
 
-        return valid;
+        return transaction_id;
 }
 
 /**
- * rtm_glib_test_login:
+ * rtm_glib_lists_set_default_list:
+ * @rtm: a #RtmGlib object already authenticated.
+ * @timeline: the timeline within which to run a method.
+ * @list: the #RtmList to set as default list.
+ * @error: location to store #GError or %NULL.
+ *
+ * Sets the default list.
+ *
+ * Returns: %TRUE if the opration is successfuly.
+ **/
+gboolean
+rtm_glib_lists_set_default_list (RtmGlib *rtm, gchar* timeline, RtmList *list,
+                                 GError **error)
+{
+        g_return_val_if_fail (rtm != NULL, FALSE);
+        g_return_val_if_fail (rtm_glib_has_auth_token (rtm), FALSE);
+        g_return_val_if_fail (timeline != NULL, FALSE);
+        g_return_val_if_fail (list != NULL, FALSE);
+
+        RestXmlNode *root;
+        GError *tmp_error = NULL;
+
+        root = rtm_glib_call_method (
+                rtm,
+                RTM_METHOD_LISTS_SET_DEFAULT_LIST, &tmp_error,
+                "auth_token", RTM_GLIB_AUTH_TOKEN,
+                "timeline", timeline,
+                "list_id", rtm_list_get_id (list),
+                NULL);
+        if (tmp_error != NULL) {
+                g_propagate_error (error, tmp_error);
+                return FALSE;
+        }
+
+        rest_xml_node_unref (root);
+
+        return TRUE;
+}
+
+/**
+ * rtm_glib_lists_set_default_list_async:
+ * @rtm: a #RtmGlib object already authenticated.
+ * @timeline: the timeline within which to run a method.
+ * @list: the #RtmList to set as default list.
+ * @cancellable: optional #GCancellable object, %NULL to ignore.
+ * @callback: a #GAsyncReadyCallback to call when the request is satisfied.
+ * @user_data: the data to pass to callback function.
+ *
+ * Asynchronously sets the default list.
+ *
+ * When the operation is finished, @callback will be called. You can then call
+ * rtm_glib_lists_set_default_list_finish() to get the result of the
+ * operation.
+ **/
+void
+rtm_glib_lists_set_default_list_async (RtmGlib *rtm, gchar* timeline,
+                                       RtmList *list,
+                                       GCancellable *cancellable,
+                                       GAsyncReadyCallback callback,
+                                       gpointer user_data)
+{
+        g_return_if_fail (rtm != NULL);
+        g_return_if_fail (rtm_glib_has_auth_token (rtm));
+        g_return_if_fail (timeline != NULL);
+        g_return_if_fail (list != NULL);
+
+        rtm_glib_call_method_async (
+                rtm,
+                RTM_METHOD_LISTS_SET_DEFAULT_LIST,
+                cancellable, callback, user_data,
+                "auth_token", RTM_GLIB_AUTH_TOKEN,
+                "timeline", timeline,
+                "list_id", rtm_list_get_id (list),
+                NULL);
+}
+
+/**
+ * rtm_glib_lists_set_default_list_finish:
  * @rtm: a #RtmGlib object.
- * @auth_token: the authentication token.
+ * @result: the #GAsyncResult passed to the callback.
  * @error: location to store #GError or %NULL.
  *
- * Checks if the user is already logged. In that case sets the
- * #RtmGlib:auth_token property.
+ * Finishes an operation started with rtm_glib_lists_set_default_list_async().
  *
- * Returns: The username if is already logged.
- */
+ * Returns: %TRUE if the opration is successfuly.
+ **/
+gboolean
+rtm_glib_lists_set_default_list_finish (RtmGlib *rtm, GAsyncResult *result,
+                                        GError **error)
+{
+        g_return_val_if_fail (rtm != NULL, FALSE);
+
+        RestXmlNode *root;
+
+        root = rtm_glib_call_method_finish (rtm, result, error);
+        if (root == NULL) {
+                return FALSE;
+        }
+
+        rest_xml_node_unref (root);
+
+        return TRUE;
+}
+
+/**
+ * rtm_glib_lists_archive:
+ * @rtm: a #RtmGlib object already authenticated.
+ * @timeline: the timeline within which to run a method.
+ * @list: the #RtmList to be archived.
+ * @error: location to store #GError or %NULL.
+ *
+ * Archives a list.
+ *
+ * Returns: The transaction identifier or %NULL if it fails.
+ **/
 gchar *
-rtm_glib_test_login (RtmGlib *rtm, gchar *auth_token, GError **error)
+rtm_glib_lists_archive (RtmGlib *rtm, gchar* timeline, RtmList *list,
+                        GError **error)
 {
         g_return_val_if_fail (rtm != NULL, NULL);
-        g_return_val_if_fail (auth_token != NULL, NULL);
+        g_return_val_if_fail (rtm_glib_has_auth_token (rtm), NULL);
+        g_return_val_if_fail (timeline != NULL, NULL);
+        g_return_val_if_fail (list != NULL, NULL);
 
-        RestXmlNode *root, *node;
-        gchar *username;
+        RestXmlNode *root;
+        gchar *transaction_id;
         GError *tmp_error = NULL;
 
-        root = rtm_glib_call_method (rtm,
-                RTM_METHOD_TEST_LOGIN, &tmp_error,
-                "auth_token", auth_token,
+        root = rtm_glib_call_method (
+                rtm,
+                RTM_METHOD_LISTS_ARCHIVE, &tmp_error,
+                "auth_token", RTM_GLIB_AUTH_TOKEN,
+                "timeline", timeline,
+                "list_id", rtm_list_get_id (list),
                 NULL);
         if (tmp_error != NULL) {
                 g_propagate_error (error, tmp_error);
                 return NULL;
         }
 
-        node = rest_xml_node_find (root, "user");
-        DEBUG_PRINT ("user_id: %s", rest_xml_node_get_attr (node, "id"));
+        transaction_id = rtm_glib_parse_transaction_id (root);
+
+        rest_xml_node_unref (root);
+
+        return transaction_id;
+}
+
+/**
+ * rtm_glib_lists_archive_async:
+ * @rtm: a #RtmGlib object already authenticated.
+ * @timeline: the timeline within which to run a method.
+ * @list: the #RtmList to be archived.
+ * @cancellable: optional #GCancellable object, %NULL to ignore.
+ * @callback: a #GAsyncReadyCallback to call when the request is satisfied.
+ * @user_data: the data to pass to callback function.
+ *
+ * Asynchronously archives a list.
+ *
+ * When the operation is finished, @callback will be called. You can then call
+ * rtm_glib_lists_archive_finish() to get the result of the operation.
+ **/
+void
+rtm_glib_lists_archive_async (RtmGlib *rtm, gchar* timeline, RtmList *list,
+                              GCancellable *cancellable,
+                              GAsyncReadyCallback callback, gpointer user_data)
+{
+        g_return_if_fail (rtm != NULL);
+        g_return_if_fail (rtm_glib_has_auth_token (rtm));
+        g_return_if_fail (timeline != NULL);
+        g_return_if_fail (list != NULL);
+
+        rtm_glib_call_method_async (
+                rtm,
+                RTM_METHOD_LISTS_ARCHIVE, cancellable, callback, user_data,
+                "auth_token", RTM_GLIB_AUTH_TOKEN,
+                "timeline", timeline,
+                "list_id", rtm_list_get_id (list),
+                NULL);
+}
+
+/**
+ * rtm_glib_lists_archive_finish:
+ * @rtm: a #RtmGlib object.
+ * @result: the #GAsyncResult passed to the callback.
+ * @error: location to store #GError or %NULL.
+ *
+ * Finishes an operation started with rtm_glib_lists_archive_async().
+ *
+ * Returns: The transaction identifier or %NULL if it fails.
+ **/
+gchar *
+rtm_glib_lists_archive_finish (RtmGlib *rtm, GAsyncResult *result,
+                               GError **error)
+{
+        g_return_val_if_fail (rtm != NULL, NULL);
+
+        RestXmlNode *root;
+        gchar *transaction_id;
+
+        root = rtm_glib_call_method_finish (rtm, result, error);
+        if (root == NULL) {
+                return NULL;
+        }
 
-        node = rest_xml_node_find (root, "username");
-        username = g_strdup (node->content);
-        DEBUG_PRINT ("username: %s", username);
+        transaction_id = rtm_glib_parse_transaction_id (root);
 
         rest_xml_node_unref (root);
 
-        rtm->priv->auth_token = g_strdup (auth_token);
+        return transaction_id;
+}
 
-        return username;
+/**
+ * rtm_glib_lists_unarchive:
+ * @rtm: a #RtmGlib object already authenticated.
+ * @timeline: the timeline within which to run a method.
+ * @list: the #RtmList to be unarchived.
+ * @error: location to store #GError or %NULL.
+ *
+ * Unarchives a list.
+ *
+ * Returns: The transaction identifier or %NULL if it fails.
+ **/
+gchar *
+rtm_glib_lists_unarchive (RtmGlib *rtm, gchar* timeline, RtmList *list,
+                          GError **error)
+{
+        g_return_val_if_fail (rtm != NULL, NULL);
+        g_return_val_if_fail (rtm_glib_has_auth_token (rtm), NULL);
+        g_return_val_if_fail (timeline != NULL, NULL);
+        g_return_val_if_fail (list != NULL, NULL);
+
+        RestXmlNode *root;
+        gchar *transaction_id;
+        GError *tmp_error = NULL;
+
+        root = rtm_glib_call_method (
+                rtm,
+                RTM_METHOD_LISTS_UNARCHIVE, &tmp_error,
+                "auth_token", RTM_GLIB_AUTH_TOKEN,
+                "timeline", timeline,
+                "list_id", rtm_list_get_id (list),
+                NULL);
+        if (tmp_error != NULL) {
+                g_propagate_error (error, tmp_error);
+                return NULL;
+        }
+
+        transaction_id = rtm_glib_parse_transaction_id (root);
+
+        rest_xml_node_unref (root);
+
+        return transaction_id;
 }
 
 /**
- * rtm_glib_auth_get_frob:
+ * rtm_glib_lists_unarchive_async:
+ * @rtm: a #RtmGlib object already authenticated.
+ * @timeline: the timeline within which to run a method.
+ * @list: the #RtmList to be unarchived.
+ * @cancellable: optional #GCancellable object, %NULL to ignore.
+ * @callback: a #GAsyncReadyCallback to call when the request is satisfied.
+ * @user_data: the data to pass to callback function.
+ *
+ * Asynchronously unarchives a list.
+ *
+ * When the operation is finished, @callback will be called. You can then call
+ * rtm_glib_lists_unarchive_finish() to get the result of the operation.
+ **/
+void
+rtm_glib_lists_unarchive_async (RtmGlib *rtm, gchar* timeline, RtmList *list,
+                                GCancellable *cancellable,
+                                GAsyncReadyCallback callback,
+                                gpointer user_data)
+{
+        g_return_if_fail (rtm != NULL);
+        g_return_if_fail (rtm_glib_has_auth_token (rtm));
+        g_return_if_fail (timeline != NULL);
+        g_return_if_fail (list != NULL);
+
+        rtm_glib_call_method_async (
+                rtm,
+                RTM_METHOD_LISTS_UNARCHIVE, cancellable, callback, user_data,
+                "auth_token", RTM_GLIB_AUTH_TOKEN,
+                "timeline", timeline,
+                "list_id", rtm_list_get_id (list),
+                NULL);
+}
+
+/**
+ * rtm_glib_lists_unarchive_finish:
  * @rtm: a #RtmGlib object.
+ * @result: the #GAsyncResult passed to the callback.
  * @error: location to store #GError or %NULL.
  *
- * Gets the authentication frob.
+ * Finishes an operation started with rtm_glib_lists_unarchive_async().
  *
- * Returns: The authentication frob.
+ * Returns: The transaction identifier or %NULL if it fails.
  **/
 gchar *
-rtm_glib_auth_get_frob (RtmGlib *rtm, GError **error)
+rtm_glib_lists_unarchive_finish (RtmGlib *rtm, GAsyncResult *result,
+                                 GError **error)
 {
         g_return_val_if_fail (rtm != NULL, NULL);
 
-        RestXmlNode *root, *node;
-        gchar *frob;
-        GError *tmp_error = NULL;
+        RestXmlNode *root;
+        gchar *transaction_id;
 
-        root = rtm_glib_call_method (rtm,
-                RTM_METHOD_AUTH_GET_FROB, &tmp_error,
-                NULL);
-        if (tmp_error != NULL) {
-                g_propagate_error (error, tmp_error);
+        root = rtm_glib_call_method_finish (rtm, result, error);
+        if (root == NULL) {
                 return NULL;
         }
 
-        node = rest_xml_node_find (root, "frob");
-
-        frob = g_strdup (node->content);
-        DEBUG_PRINT ("frob: %s", frob);
+        transaction_id = rtm_glib_parse_transaction_id (root);
 
         rest_xml_node_unref (root);
 
-        return frob;
+        return transaction_id;
 }
 
 /**
- * rtm_glib_auth_get_token:
- * @rtm: a #RtmGlib object.
- * @frob: the authentication frob.
+ * rtm_glib_tasks_set_url:
+ * @rtm: a #RtmGlib object already authenticated.
+ * @timeline: the timeline within which to run a method.
+ * @task: a #RtmTask to be modified with the new name.
+ * @url: The URL associated with a task. Valid protocols are http, https, ftp
+ * and file. If %NUL, any existing URL will be unset.
  * @error: location to store #GError or %NULL.
  *
- * Gets the authentication token and sets the #RtmGlib:auth_token property.
+ * Sets an URL for a task.
  *
- * Returns: The authentication token.
+ * Returns: The transaction identifier or %NULL if it fails.
  **/
 gchar *
-rtm_glib_auth_get_token (RtmGlib *rtm, gchar *frob, GError **error)
+rtm_glib_tasks_set_url (RtmGlib *rtm, gchar* timeline, RtmTask *task,
+                        gchar *url, GError **error)
 {
         g_return_val_if_fail (rtm != NULL, NULL);
-        g_return_val_if_fail (frob != NULL, NULL);
+        g_return_val_if_fail (rtm_glib_has_auth_token (rtm), NULL);
+        g_return_val_if_fail (timeline != NULL, NULL);
+        g_return_val_if_fail (task != NULL, NULL);
 
-        RestXmlNode *root, *node;
-        gchar *auth_token;
+        if (url == NULL) {
+                url = "";
+        }
+
+        RestXmlNode *root;
+        gchar *transaction_id;
         GError *tmp_error = NULL;
 
-        root = rtm_glib_call_method (rtm,
-                RTM_METHOD_AUTH_GET_TOKEN, &tmp_error,
-                "frob", frob,
+        root = rtm_glib_call_method (
+                rtm,
+                RTM_METHOD_TASKS_SET_URL, &tmp_error,
+                "auth_token", RTM_GLIB_AUTH_TOKEN,
+                "timeline", timeline,
+                "list_id", rtm_task_get_list_id (task),
+                "taskseries_id", rtm_task_get_taskseries_id (task),
+                "task_id", rtm_task_get_id (task),
+                "url", url,
                 NULL);
         if (tmp_error != NULL) {
                 g_propagate_error (error, tmp_error);
                 return NULL;
         }
 
-        node = rest_xml_node_find (root, "token");
-
-        auth_token = g_strdup (node->content);
-        DEBUG_PRINT ("auth_token: %s", auth_token);
+        transaction_id = rtm_glib_parse_transaction_id (root);
 
         rest_xml_node_unref (root);
 
-        rtm->priv->auth_token = g_strdup (auth_token);
-
-        return auth_token;
+        return transaction_id;
 }
 
 /**
- * rtm_glib_auth_check_token:
- * @rtm: a #RtmGlib object.
- * @auth_token: the authentication token.
- * @error: location to store #GError or %NULL.
+ * rtm_glib_tasks_set_url_async:
+ * @rtm: a #RtmGlib object already authenticated.
+ * @timeline: the timeline within which to run a method.
+ * @task: a #RtmTask to be modified with the new name.
+ * @url: The URL associated with a task. Valid protocols are http, https, ftp
+ * and file. If %NUL, any existing URL will be unset.
+ * @cancellable: optional #GCancellable object, %NULL to ignore.
+ * @callback: a #GAsyncReadyCallback to call when the request is satisfied.
+ * @user_data: the data to pass to callback function.
  *
- * Checks if authentication token is or not valid. If it is valid sets the
- * #RtmGlib:auth_token property.
+ * Asynchronously sets an URL for a task.
  *
- * Returns: %TRUE if authentication token is valid.
+ * When the operation is finished, @callback will be called. You can then call
+ * rtm_glib_tasks_set_url_finish() to get the result of the operation.
  **/
-gboolean
-rtm_glib_auth_check_token (RtmGlib *rtm, gchar *auth_token, GError **error)
+void
+rtm_glib_tasks_set_url_async (RtmGlib *rtm, gchar* timeline, RtmTask *task,
+                              gchar *url, GCancellable *cancellable,
+                              GAsyncReadyCallback callback, gpointer user_data)
 {
-        g_return_val_if_fail (rtm != NULL, FALSE);
-        g_return_val_if_fail (auth_token != NULL, FALSE);
-
-        RestXmlNode *root, *node;
-        gboolean valid = FALSE;
-        GError *tmp_error = NULL;
-
-        root = rtm_glib_call_method (rtm,
-                RTM_METHOD_AUTH_CHECK_TOKEN, &tmp_error,
-                "auth_token", auth_token,
-                NULL);
-        if (tmp_error != NULL) {
-                g_propagate_error (error, tmp_error);
-                return FALSE;
-        }
-
-        node = rest_xml_node_find (root, "token");
-
-        valid = (g_strcmp0 (node->content, auth_token) == 0);
-
-        rest_xml_node_unref (root);
+        g_return_if_fail (rtm != NULL);
+        g_return_if_fail (rtm_glib_has_auth_token (rtm));
+        g_return_if_fail (timeline != NULL);
+        g_return_if_fail (task != NULL);
 
-        if (valid) {
-                rtm->priv->auth_token = g_strdup (auth_token);
+        if (url == NULL) {
+                url = "";
         }
 
-        return valid;
+        rtm_glib_call_method_async (
+                rtm,
+                RTM_METHOD_TASKS_SET_URL, cancellable, callback, user_data,
+                "auth_token", RTM_GLIB_AUTH_TOKEN,
+                "timeline", timeline,
+                "list_id", rtm_task_get_list_id (task),
+                "taskseries_id", rtm_task_get_taskseries_id (task),
+                "task_id", rtm_task_get_id (task),
+                "url", url,
+                NULL);
 }
 
 /**
- * rtm_glib_auth_get_login_url:
+ * rtm_glib_tasks_set_url_finish:
  * @rtm: a #RtmGlib object.
- * @frob: the authentication frob.
- * @perms: the requested permissions. Valid values are %read, %write or
- * %delete. Default %read.
+ * @result: the #GAsyncResult passed to the callback.
+ * @error: location to store #GError or %NULL.
  *
- * Gets the URL to login in Remember The Milk.
+ * Finishes an operation started with rtm_glib_tasks_set_url_async().
  *
- * Returns: The URL to login.
+ * Returns: The transaction identifier or %NULL if it fails.
  **/
 gchar *
-rtm_glib_auth_get_login_url (RtmGlib *rtm, gchar *frob, gchar *perms)
+rtm_glib_tasks_set_url_finish (RtmGlib *rtm, GAsyncResult *result,
+                               GError **error)
 {
         g_return_val_if_fail (rtm != NULL, NULL);
-        g_return_val_if_fail (frob != NULL, NULL);
-
-        if (perms == NULL) {
-                perms = "read";
-        }
-        g_return_val_if_fail (
-                (g_strcmp0 (perms, "read") == 0) ||
-                (g_strcmp0 (perms, "write") == 0) ||
-                (g_strcmp0 (perms, "delete") == 0),
-                NULL);
-
-        gchar *url;
-        GHashTable *params;
-        gchar *md5;
 
-        params = g_hash_table_new (g_str_hash, g_str_equal);
-
-        g_hash_table_insert (params, "api_key", rtm->priv->api_key);
-        g_hash_table_insert (params, "perms", perms);
-        g_hash_table_insert (params, "frob", frob);
-
-        md5 = rtm_glib_caculate_md5 (rtm, params);
+        RestXmlNode *root;
+        gchar *transaction_id;
 
-        url = g_strconcat (RTM_URL_AUTH, "?",
-                           "api_key=", rtm->priv->api_key, "&",
-                           "perms=", perms, "&",
-                           "frob=", frob, "&",
-                           "api_sig=", md5,
-                           NULL);
+        root = rtm_glib_call_method_finish (rtm, result, error);
+        if (root == NULL) {
+                return NULL;
+        }
 
-        DEBUG_PRINT ("url: %s", url);
+        transaction_id = rtm_glib_parse_transaction_id (root);
 
-        g_hash_table_unref (params);
-        g_free (md5);
+        rest_xml_node_unref (root);
 
-        return url;
+        return transaction_id;
 }
 
 /**
- * rtm_glib_tasks_get_list:
+ * rtm_glib_tasks_set_tags:
  * @rtm: a #RtmGlib object already authenticated.
- * @list_id: %NULL or the id of the list to perform an action on.
- * @filter: %NULL or if specified, only tasks matching the desired criteria
- * are returned.
- * @last_sync: %NULL or an ISO 8601 formatted time value. If @last_sync is
- * provided, only tasks modified since last_sync will be returned, and each
- * element will have an attribute, current, equal to @last_sync.
- * @error: location to store #GError or %NULL.
+ * @timeline: the timeline within which to run a method.
+ * @task: a #RtmTask to be modified with the new name.
+ * @tags: A comma delimited list of tags. If %NULL, any existing tag will be
+ * unset.
  *
- * Gets the list of tasks.
+ * Sets the tags of a task.
  *
- * Returns: A #GList of #RtmTask objects.
+ * Returns: The transaction identifier or %NULL if it fails.
  **/
-GList *
-rtm_glib_tasks_get_list (RtmGlib *rtm, gchar *list_id, gchar *filter,
-                         gchar *last_sync, GError **error)
+gchar *
+rtm_glib_tasks_set_tags (RtmGlib *rtm, gchar* timeline, RtmTask *task,
+                         gchar *tags, GError **error)
 {
         g_return_val_if_fail (rtm != NULL, NULL);
-        g_return_val_if_fail (rtm->priv->auth_token != NULL, NULL);
+        g_return_val_if_fail (rtm_glib_has_auth_token (rtm), NULL);
+        g_return_val_if_fail (timeline != NULL, NULL);
+        g_return_val_if_fail (task != NULL, NULL);
 
-        if (filter == NULL) {
-                filter = "";
-        }
-        if (last_sync == NULL) {
-                last_sync = "";
+        if (tags == NULL) {
+                tags = "";
         }
 
-        RestXmlNode *root, *node, *node2;
-        GList *list = NULL;
-        RtmTask *task;
-        const gchar *task_list_id;
+        RestXmlNode *root;
+        gchar *transaction_id;
         GError *tmp_error = NULL;
 
-        if (list_id == NULL) {
-                root = rtm_glib_call_method (
-                        rtm,
-                        RTM_METHOD_TASKS_GET_LIST, &tmp_error,
-                        "auth_token", rtm->priv->auth_token,
-                        "filter", filter,
-                        "last_sync", last_sync,
-                        NULL);
-        } else {
-                root = rtm_glib_call_method (
-                        rtm,
-                        RTM_METHOD_TASKS_GET_LIST, &tmp_error,
-                        "auth_token", rtm->priv->auth_token,
-                        "list_id", list_id,
-                        "filter", filter,
-                        "last_sync", last_sync,
-                        NULL);
-        }
+        root = rtm_glib_call_method (
+                rtm,
+                RTM_METHOD_TASKS_SET_TAGS, &tmp_error,
+                "auth_token", RTM_GLIB_AUTH_TOKEN,
+                "timeline", timeline,
+                "list_id", rtm_task_get_list_id (task),
+                "taskseries_id", rtm_task_get_taskseries_id (task),
+                "task_id", rtm_task_get_id (task),
+                "tags", tags,
+                NULL);
         if (tmp_error != NULL) {
                 g_propagate_error (error, tmp_error);
                 return NULL;
         }
 
-        for (node = rest_xml_node_find (root, "list"); node; node = node->next) {
-                task_list_id = rest_xml_node_get_attr (node, "id");
-                for (node2 = rest_xml_node_find (node, "taskseries"); node2; node2 = node2->next) {
-                        task = rtm_task_new ();
-                        rtm_task_load_data (task, node2, task_list_id);
-                        list = g_list_append (list, task);
-                }
-        }
+        transaction_id = rtm_glib_parse_transaction_id (root);
 
         rest_xml_node_unref (root);
 
-        return list;
+        return transaction_id;
 }
 
 /**
- * rtm_glib_lists_get_list:
+ * rtm_glib_tasks_set_tags_async:
  * @rtm: a #RtmGlib object already authenticated.
- * @error: location to store #GError or %NULL.
+ * @timeline: the timeline within which to run a method.
+ * @task: a #RtmTask to be modified with the new name.
+ * @tags: A comma delimited list of tags. If %NULL, any existing tag will be
+ * unset.
+ * @cancellable: optional #GCancellable object, %NULL to ignore.
+ * @callback: a #GAsyncReadyCallback to call when the request is satisfied.
+ * @user_data: the data to pass to callback function.
  *
- * Gets the list of lists.
+ * Asynchronously sets the tags of a task.
  *
- * Returns: A #GList of #RtmList objects.
+ * When the operation is finished, @callback will be called. You can then call
+ * rtm_glib_tasks_set_tags_finish() to get the result of the operation.
  **/
-GList *
-rtm_glib_lists_get_list (RtmGlib *rtm, GError **error)
+void
+rtm_glib_tasks_set_tags_async (RtmGlib *rtm, gchar* timeline, RtmTask *task,
+                               gchar *tags, GCancellable *cancellable,
+                               GAsyncReadyCallback callback,
+                               gpointer user_data)
 {
-        g_return_val_if_fail (rtm != NULL, NULL);
-        g_return_val_if_fail (rtm->priv->auth_token != NULL, NULL);
-
-        RestXmlNode *root, *node;
-        GList *glist = NULL;
-        RtmList *rtmlist;
-        GError *tmp_error = NULL;
-
-        root = rtm_glib_call_method (rtm,
-                RTM_METHOD_LISTS_GET_LIST, &tmp_error,
-                "auth_token", rtm->priv->auth_token,
-                NULL);
-        if (tmp_error != NULL) {
-                g_propagate_error (error, tmp_error);
-                return NULL;
-        }
+        g_return_if_fail (rtm != NULL);
+        g_return_if_fail (rtm_glib_has_auth_token (rtm));
+        g_return_if_fail (timeline != NULL);
+        g_return_if_fail (task != NULL);
 
-        for (node = rest_xml_node_find (root, "list"); node; node = node->next) {
-                rtmlist = rtm_list_new ();
-                rtm_list_load_data (rtmlist, node);
-                glist = g_list_append (glist, rtmlist);
+        if (tags == NULL) {
+                tags = "";
         }
 
-        rest_xml_node_unref (root);
-
-        return glist;
+        rtm_glib_call_method_async (
+                rtm,
+                RTM_METHOD_TASKS_SET_TAGS, cancellable, callback, user_data,
+                "auth_token", RTM_GLIB_AUTH_TOKEN,
+                "timeline", timeline,
+                "list_id", rtm_task_get_list_id (task),
+                "taskseries_id", rtm_task_get_taskseries_id (task),
+                "task_id", rtm_task_get_id (task),
+                "tags", tags,
+                NULL);
 }
 
 /**
- * rtm_glib_timelines_create:
- * @rtm: a #RtmGlib object already authenticated.
+ * rtm_glib_tasks_set_tags_finish:
+ * @rtm: a #RtmGlib object.
+ * @result: the #GAsyncResult passed to the callback.
  * @error: location to store #GError or %NULL.
  *
- * Gets a new timeline.
+ * Finishes an operation started with rtm_glib_tasks_set_tags_async().
  *
- * Returns: A timeline.
+ * Returns: The transaction identifier or %NULL if it fails.
  **/
 gchar *
-rtm_glib_timelines_create (RtmGlib *rtm, GError **error)
+rtm_glib_tasks_set_tags_finish (RtmGlib *rtm, GAsyncResult *result,
+                                GError **error)
 {
         g_return_val_if_fail (rtm != NULL, NULL);
-        g_return_val_if_fail (rtm->priv->auth_token != NULL, NULL);
 
-        RestXmlNode *root, *node;
-        gchar *timeline;
-        GError *tmp_error = NULL;
+        RestXmlNode *root;
+        gchar *transaction_id;
 
-        root = rtm_glib_call_method (rtm,
-                RTM_METHOD_TIMELINES_CREATE, &tmp_error,
-                "auth_token", rtm->priv->auth_token,
-                NULL);
-        if (tmp_error != NULL) {
-                g_propagate_error (error, tmp_error);
+        root = rtm_glib_call_method_finish (rtm, result, error);
+        if (root == NULL) {
                 return NULL;
         }
 
-        node = rest_xml_node_find (root, "timeline");
-        timeline = g_strdup (node->content);
-        DEBUG_PRINT ("timeline: %s", timeline);
+        transaction_id = rtm_glib_parse_transaction_id (root);
 
         rest_xml_node_unref (root);
 
-        return timeline;
+        return transaction_id;
 }
 
 /**
- * rtm_glib_tasks_add:
+ * rtm_glib_tasks_add_tags:
  * @rtm: a #RtmGlib object already authenticated.
  * @timeline: the timeline within which to run a method.
- * @task_name: the desired task name.
- * @list_id: %NULL or the id of the list to perform an action on.
- * @parse: %FALSE or %TRUE to specify whether to process name using Smart Add.
- * @error: location to store #GError or %NULL.
+ * @task: a #RtmTask to be modified with the new name.
+ * @tags: A comma delimited list of tags.
  *
- * Adds a task to the list specified by @list_id or the default list if
- * @list_id is %NULL.
+ * Adds tags for a task.
  *
- * Returns: A #RtmTask with the data of the task added.
+ * Returns: The transaction identifier or %NULL if it fails.
  **/
-RtmTask *
-rtm_glib_tasks_add (RtmGlib *rtm, gchar* timeline, gchar *task_name,
-                    gchar *list_id, gboolean parse, GError **error)
+gchar *
+rtm_glib_tasks_add_tags (RtmGlib *rtm, gchar* timeline, RtmTask *task,
+                         gchar *tags, GError **error)
 {
         g_return_val_if_fail (rtm != NULL, NULL);
-        g_return_val_if_fail (rtm->priv->auth_token != NULL, NULL);
+        g_return_val_if_fail (rtm_glib_has_auth_token (rtm), NULL);
         g_return_val_if_fail (timeline != NULL, NULL);
-        g_return_val_if_fail (task_name != NULL, NULL);
+        g_return_val_if_fail (task != NULL, NULL);
+        g_return_val_if_fail (tags != NULL, NULL);
 
-        RestXmlNode *root, *node;
-        const gchar *task_list_id;
-        RtmTask *task;
+        RestXmlNode *root;
+        gchar *transaction_id;
         GError *tmp_error = NULL;
-        gchar *parse_smart_add = "0";
-
-        if (parse) {
-                parse_smart_add = "1";
-        }
 
-        if (list_id == NULL) {
-                root = rtm_glib_call_method (
-                        rtm,
-                        RTM_METHOD_TASKS_ADD, &tmp_error,
-                        "auth_token", rtm->priv->auth_token,
-                        "timeline", timeline,
-                        "name", task_name,
-                        "parse", parse_smart_add,
-                        NULL);
-        } else {
-                root = rtm_glib_call_method (
-                        rtm,
-                        RTM_METHOD_TASKS_ADD, &tmp_error,
-                        "auth_token", rtm->priv->auth_token,
-                        "timeline", timeline,
-                        "name", task_name,
-                        "list_id", list_id,
-                        "parse", parse_smart_add,
-                        NULL);
-        }
+        root = rtm_glib_call_method (
+                rtm,
+                RTM_METHOD_TASKS_ADD_TAGS, &tmp_error,
+                "auth_token", RTM_GLIB_AUTH_TOKEN,
+                "timeline", timeline,
+                "list_id", rtm_task_get_list_id (task),
+                "taskseries_id", rtm_task_get_taskseries_id (task),
+                "task_id", rtm_task_get_id (task),
+                "tags", tags,
+                NULL);
         if (tmp_error != NULL) {
                 g_propagate_error (error, tmp_error);
                 return NULL;
         }
 
-        node = rest_xml_node_find (root, "list");
-        task_list_id = rest_xml_node_get_attr (node, "id");
-
-        node = rest_xml_node_find (node, "taskseries");
-        task = rtm_task_new ();
-        rtm_task_load_data (task, node, task_list_id);
+        transaction_id = rtm_glib_parse_transaction_id (root);
 
         rest_xml_node_unref (root);
 
-        return task;
+        return transaction_id;
 }
 
 /**
- * rtm_glib_transactions_undo:
+ * rtm_glib_tasks_add_tags_async:
  * @rtm: a #RtmGlib object already authenticated.
  * @timeline: the timeline within which to run a method.
- * @transaction_id: the id of transaction within a timeline.
+ * @task: a #RtmTask to be modified with the new name.
+ * @tags: A comma delimited list of tags.
+ * @cancellable: optional #GCancellable object, %NULL to ignore.
+ * @callback: a #GAsyncReadyCallback to call when the request is satisfied.
+ * @user_data: the data to pass to callback function.
+ *
+ * Asynchronously adds tags for a task.
+ *
+ * When the operation is finished, @callback will be called. You can then call
+ * rtm_glib_tasks_add_tags_finish() to get the result of the operation.
+ **/
+void
+rtm_glib_tasks_add_tags_async (RtmGlib *rtm, gchar* timeline, RtmTask *task,
+                               gchar *tags, GCancellable *cancellable,
+                               GAsyncReadyCallback callback,
+                               gpointer user_data)
+{
+        g_return_if_fail (rtm != NULL);
+        g_return_if_fail (rtm_glib_has_auth_token (rtm));
+        g_return_if_fail (timeline != NULL);
+        g_return_if_fail (task != NULL);
+        g_return_if_fail (tags != NULL);
+
+        rtm_glib_call_method_async (
+                rtm,
+                RTM_METHOD_TASKS_ADD_TAGS, cancellable, callback, user_data,
+                "auth_token", RTM_GLIB_AUTH_TOKEN,
+                "timeline", timeline,
+                "list_id", rtm_task_get_list_id (task),
+                "taskseries_id", rtm_task_get_taskseries_id (task),
+                "task_id", rtm_task_get_id (task),
+                "tags", tags,
+                NULL);
+}
+
+/**
+ * rtm_glib_tasks_add_tags_finish:
+ * @rtm: a #RtmGlib object.
+ * @result: the #GAsyncResult passed to the callback.
  * @error: location to store #GError or %NULL.
  *
- * Reverts the affects of an action.
+ * Finishes an operation started with rtm_glib_tasks_add_tags_async().
  *
- * Returns: %TRUE if the transcation is undone successfuly.
+ * Returns: The transaction identifier or %NULL if it fails.
  **/
-gboolean
-rtm_glib_transactions_undo (RtmGlib *rtm, gchar *timeline,
-                            gchar* transaction_id, GError **error)
+gchar *
+rtm_glib_tasks_add_tags_finish (RtmGlib *rtm, GAsyncResult *result,
+                                GError **error)
 {
-        g_return_val_if_fail (rtm != NULL, FALSE);
-        g_return_val_if_fail (rtm->priv->auth_token != NULL, FALSE);
-        g_return_val_if_fail (timeline != NULL, FALSE);
-        g_return_val_if_fail (transaction_id != NULL, FALSE);
+        g_return_val_if_fail (rtm != NULL, NULL);
 
         RestXmlNode *root;
-        GError *tmp_error = NULL;
+        gchar *transaction_id;
 
-        root = rtm_glib_call_method (rtm,
-                RTM_METHOD_TRANSACTIONS_UNDO, &tmp_error,
-                "auth_token", rtm->priv->auth_token,
-                "timeline", timeline,
-                "transaction_id", transaction_id,
-                NULL);
-        if (tmp_error != NULL) {
-                g_propagate_error (error, tmp_error);
-                return FALSE;
+        root = rtm_glib_call_method_finish (rtm, result, error);
+        if (root == NULL) {
+                return NULL;
         }
 
+        transaction_id = rtm_glib_parse_transaction_id (root);
+
         rest_xml_node_unref (root);
 
-        return TRUE;
+        return transaction_id;
 }
 
 /**
- * rtm_glib_tasks_delete:
+ * rtm_glib_tasks_remove_tags:
  * @rtm: a #RtmGlib object already authenticated.
  * @timeline: the timeline within which to run a method.
- * @task: a #RtmTask to be deleted.
- * @error: location to store #GError or %NULL.
+ * @task: a #RtmTask to be modified with the new name.
+ * @tags: A comma delimited list of tags.
  *
- * Removes a task.
+ * Removes tags from a task.
  *
  * Returns: The transaction identifier or %NULL if it fails.
  **/
 gchar *
-rtm_glib_tasks_delete (RtmGlib *rtm, gchar* timeline, RtmTask *task,
-                       GError **error)
+rtm_glib_tasks_remove_tags (RtmGlib *rtm, gchar* timeline, RtmTask *task,
+                            gchar *tags, GError **error)
 {
         g_return_val_if_fail (rtm != NULL, NULL);
-        g_return_val_if_fail (rtm->priv->auth_token != NULL, NULL);
+        g_return_val_if_fail (rtm_glib_has_auth_token (rtm), NULL);
         g_return_val_if_fail (timeline != NULL, NULL);
         g_return_val_if_fail (task != NULL, NULL);
+        g_return_val_if_fail (tags != NULL, NULL);
 
-        RestXmlNode *root, *node;
+        RestXmlNode *root;
         gchar *transaction_id;
         GError *tmp_error = NULL;
 
         root = rtm_glib_call_method (
                 rtm,
-                RTM_METHOD_TASKS_DELETE, &tmp_error,
-                "auth_token", rtm->priv->auth_token,
+                RTM_METHOD_TASKS_REMOVE_TAGS, &tmp_error,
+                "auth_token", RTM_GLIB_AUTH_TOKEN,
                 "timeline", timeline,
                 "list_id", rtm_task_get_list_id (task),
                 "taskseries_id", rtm_task_get_taskseries_id (task),
                 "task_id", rtm_task_get_id (task),
+                "tags", tags,
                 NULL);
         if (tmp_error != NULL) {
                 g_propagate_error (error, tmp_error);
                 return NULL;
         }
 
-        node = rest_xml_node_find (root, "transaction");
-        transaction_id = g_strdup (rest_xml_node_get_attr (node, "id"));
-        DEBUG_PRINT ("transaction_id: %s", transaction_id);
+        transaction_id = rtm_glib_parse_transaction_id (root);
 
         rest_xml_node_unref (root);
 
@@ -1255,49 +7391,69 @@ rtm_glib_tasks_delete (RtmGlib *rtm, gchar* timeline, RtmTask *task,
 }
 
 /**
- * rtm_glib_tasks_set_name:
+ * rtm_glib_tasks_remove_tags_async:
  * @rtm: a #RtmGlib object already authenticated.
  * @timeline: the timeline within which to run a method.
  * @task: a #RtmTask to be modified with the new name.
- * @name: the desired name.
- * @error: location to store #GError or %NULL.
+ * @tags: A comma delimited list of tags.
+ * @cancellable: optional #GCancellable object, %NULL to ignore.
+ * @callback: a #GAsyncReadyCallback to call when the request is satisfied.
+ * @user_data: the data to pass to callback function.
  *
- * Renames a task.
+ * Asynchronously removes tags from a task.
  *
- * Returns: The transaction identifier or %NULL if it fails.
+ * When the operation is finished, @callback will be called. You can then call
+ * rtm_glib_tasks_remove_tags_finish() to get the result of the operation.
  **/
-gchar *
-rtm_glib_tasks_set_name (RtmGlib *rtm, gchar* timeline, RtmTask *task,
-                         gchar *name, GError **error)
+void
+rtm_glib_tasks_remove_tags_async (RtmGlib *rtm, gchar* timeline, RtmTask *task,
+                                  gchar *tags, GCancellable *cancellable,
+                                  GAsyncReadyCallback callback,
+                                  gpointer user_data)
 {
-        g_return_val_if_fail (rtm != NULL, NULL);
-        g_return_val_if_fail (rtm->priv->auth_token != NULL, NULL);
-        g_return_val_if_fail (timeline != NULL, NULL);
-        g_return_val_if_fail (task != NULL, NULL);
-        g_return_val_if_fail (name != NULL, NULL);
-
-        RestXmlNode *root, *node;
-        gchar *transaction_id;
-        GError *tmp_error = NULL;
+        g_return_if_fail (rtm != NULL);
+        g_return_if_fail (rtm_glib_has_auth_token (rtm));
+        g_return_if_fail (timeline != NULL);
+        g_return_if_fail (task != NULL);
+        g_return_if_fail (tags != NULL);
 
-        root = rtm_glib_call_method (
+        rtm_glib_call_method_async (
                 rtm,
-                RTM_METHOD_TASKS_SET_NAME, &tmp_error,
-                "auth_token", rtm->priv->auth_token,
+                RTM_METHOD_TASKS_REMOVE_TAGS, cancellable, callback, user_data,
+                "auth_token", RTM_GLIB_AUTH_TOKEN,
                 "timeline", timeline,
                 "list_id", rtm_task_get_list_id (task),
                 "taskseries_id", rtm_task_get_taskseries_id (task),
                 "task_id", rtm_task_get_id (task),
-                "name", name,
+                "tags", tags,
                 NULL);
-        if (tmp_error != NULL) {
-                g_propagate_error (error, tmp_error);
+}
+
+/**
+ * rtm_glib_tasks_remove_tags_finish:
+ * @rtm: a #RtmGlib object.
+ * @result: the #GAsyncResult passed to the callback.
+ * @error: location to store #GError or %NULL.
+ *
+ * Finishes an operation started with rtm_glib_tasks_remove_tags_async().
+ *
+ * Returns: The transaction identifier or %NULL if it fails.
+ **/
+gchar *
+rtm_glib_tasks_remove_tags_finish (RtmGlib *rtm, GAsyncResult *result,
+                                   GError **error)
+{
+        g_return_val_if_fail (rtm != NULL, NULL);
+
+        RestXmlNode *root;
+        gchar *transaction_id;
+
+        root = rtm_glib_call_method_finish (rtm, result, error);
+        if (root == NULL) {
                 return NULL;
         }
 
-        node = rest_xml_node_find (root, "transaction");
-        transaction_id = g_strdup (rest_xml_node_get_attr (node, "id"));
-        DEBUG_PRINT ("transaction_id: %s", transaction_id);
+        transaction_id = rtm_glib_parse_transaction_id (root);
 
         rest_xml_node_unref (root);
 
@@ -1305,96 +7461,118 @@ rtm_glib_tasks_set_name (RtmGlib *rtm, gchar* timeline, RtmTask *task,
 }
 
 /**
- * rtm_glib_lists_add:
+ * rtm_glib_tasks_set_location:
  * @rtm: a #RtmGlib object already authenticated.
  * @timeline: the timeline within which to run a method.
- * @list_name: the desired list name.
- * @filter: if specified, a smart list is created with the desired criteria.
+ * @task: a #RtmTask to be modified with the new location ID.
+ * @location_id: the ID of a location.
  * @error: location to store #GError or %NULL.
  *
- * Adds a new list.
+ * Sets the location ID of a task.
  *
- * Returns: A #RtmList with the data of the new list added.
+ * Returns: The transaction identifier or %NULL if it fails.
  **/
-RtmList *
-rtm_glib_lists_add (RtmGlib *rtm, gchar* timeline, gchar *list_name,
-                    gchar *filter, GError **error)
+gchar *
+rtm_glib_tasks_set_location (RtmGlib *rtm, gchar* timeline, RtmTask *task,
+                             gchar *location_id, GError **error)
 {
         g_return_val_if_fail (rtm != NULL, NULL);
-        g_return_val_if_fail (rtm->priv->auth_token != NULL, NULL);
+        g_return_val_if_fail (rtm_glib_has_auth_token (rtm), NULL);
         g_return_val_if_fail (timeline != NULL, NULL);
-        g_return_val_if_fail (list_name != NULL, NULL);
+        g_return_val_if_fail (task != NULL, NULL);
+        g_return_val_if_fail (location_id != NULL, NULL);
 
-        RestXmlNode *root, *node;
-        RtmList *list;
+        RestXmlNode *root;
+        gchar *transaction_id;
         GError *tmp_error = NULL;
 
-        if (filter == NULL) {
-                filter = "";
-        }
-
         root = rtm_glib_call_method (
                 rtm,
-                RTM_METHOD_LISTS_ADD, &tmp_error,
-                "auth_token", rtm->priv->auth_token,
+                RTM_METHOD_TASKS_SET_LOCATION, &tmp_error,
+                "auth_token", RTM_GLIB_AUTH_TOKEN,
                 "timeline", timeline,
-                "name", list_name,
-                "filter", filter,
+                "list_id", rtm_task_get_list_id (task),
+                "taskseries_id", rtm_task_get_taskseries_id (task),
+                "task_id", rtm_task_get_id (task),
+                "location_id", location_id,
                 NULL);
         if (tmp_error != NULL) {
                 g_propagate_error (error, tmp_error);
                 return NULL;
         }
 
-        node = rest_xml_node_find (root, "list");
-
-        list = rtm_list_new ();
-        rtm_list_load_data (list, node);
+        transaction_id = rtm_glib_parse_transaction_id (root);
 
         rest_xml_node_unref (root);
 
-        return list;
+        return transaction_id;
 }
 
 /**
- * rtm_glib_lists_delete:
+ * rtm_glib_tasks_set_location_async:
  * @rtm: a #RtmGlib object already authenticated.
  * @timeline: the timeline within which to run a method.
- * @list: a #RtmList to be deleted.
+ * @task: a #RtmTask to be modified with the new location ID.
+ * @location_id: the ID of a location.
+ * @cancellable: optional #GCancellable object, %NULL to ignore.
+ * @callback: a #GAsyncReadyCallback to call when the request is satisfied.
+ * @user_data: the data to pass to callback function.
+ *
+ * Asynchronously sets the location ID of a task.
+ *
+ * When the operation is finished, @callback will be called. You can then call
+ * rtm_glib_tasks_set_location_finish() to get the result of the operation.
+ **/
+void
+rtm_glib_tasks_set_location_async (RtmGlib *rtm, gchar* timeline,
+                                   RtmTask *task, gchar *location_id,
+                                   GCancellable *cancellable,
+                                   GAsyncReadyCallback callback,
+                                   gpointer user_data)
+{
+        g_return_if_fail (rtm != NULL);
+        g_return_if_fail (rtm_glib_has_auth_token (rtm));
+        g_return_if_fail (timeline != NULL);
+        g_return_if_fail (task != NULL);
+        g_return_if_fail (location_id != NULL);
+
+        rtm_glib_call_method_async (
+                rtm,
+                RTM_METHOD_TASKS_SET_LOCATION, cancellable, callback, user_data,
+                "auth_token", RTM_GLIB_AUTH_TOKEN,
+                "timeline", timeline,
+                "list_id", rtm_task_get_list_id (task),
+                "taskseries_id", rtm_task_get_taskseries_id (task),
+                "task_id", rtm_task_get_id (task),
+                "location_id", location_id,
+                NULL);
+}
+
+/**
+ * rtm_glib_tasks_set_location_finish:
+ * @rtm: a #RtmGlib object.
+ * @result: the #GAsyncResult passed to the callback.
  * @error: location to store #GError or %NULL.
  *
- * Removes a list.
+ * Finishes an operation started with rtm_glib_tasks_set_location_async().
  *
  * Returns: The transaction identifier or %NULL if it fails.
  **/
 gchar *
-rtm_glib_lists_delete (RtmGlib *rtm, gchar* timeline, RtmList *list,
-                       GError **error)
+rtm_glib_tasks_set_location_finish (RtmGlib *rtm, GAsyncResult *result,
+                                    GError **error)
 {
         g_return_val_if_fail (rtm != NULL, NULL);
-        g_return_val_if_fail (rtm->priv->auth_token != NULL, NULL);
-        g_return_val_if_fail (timeline != NULL, NULL);
-        g_return_val_if_fail (list != NULL, NULL);
 
-        RestXmlNode *root, *node;
+        RestXmlNode *root;
         gchar *transaction_id;
-        GError *tmp_error = NULL;
 
-        root = rtm_glib_call_method (
-                rtm,
-                RTM_METHOD_LISTS_DELETE, &tmp_error,
-                "auth_token", rtm->priv->auth_token,
-                "timeline", timeline,
-                "list_id", rtm_list_get_id (list),
-                NULL);
-        if (tmp_error != NULL) {
-                g_propagate_error (error, tmp_error);
+        root = rtm_glib_call_method_finish (rtm, result, error);
+        if (root == NULL) {
                 return NULL;
         }
 
-        node = rest_xml_node_find (root, "transaction");
-        transaction_id = g_strdup (rest_xml_node_get_attr (node, "id"));
-        DEBUG_PRINT ("transaction_id: %s", transaction_id);
+        transaction_id = rtm_glib_parse_transaction_id (root);
 
         rest_xml_node_unref (root);
 
@@ -1402,136 +7580,200 @@ rtm_glib_lists_delete (RtmGlib *rtm, gchar* timeline, RtmList *list,
 }
 
 /**
- * rtm_glib_lists_set_name:
+ * rtm_glib_locations_get_list:
  * @rtm: a #RtmGlib object already authenticated.
- * @timeline: the timeline within which to run a method.
- * @list: a #RtmList to be modified with the new name.
- * @name: the desired name.
  * @error: location to store #GError or %NULL.
  *
- * Renames a list. The new name can not be %Inbox or %Sent.
+ * Gets the list of locations.
  *
- * Returns: The transaction identifier or %NULL if it fails.
+ * Returns: A #GList of #RtmLocation objects.
  **/
-gchar *
-rtm_glib_lists_set_name (RtmGlib *rtm, gchar* timeline, RtmList *list,
-                         gchar *name, GError **error)
+GList *
+rtm_glib_locations_get_list (RtmGlib *rtm, GError **error)
 {
         g_return_val_if_fail (rtm != NULL, NULL);
-        g_return_val_if_fail (rtm->priv->auth_token != NULL, NULL);
-        g_return_val_if_fail (timeline != NULL, NULL);
-        g_return_val_if_fail (list != NULL, NULL);
-        g_return_val_if_fail (name != NULL, NULL);
-        g_return_val_if_fail (
-                (g_strcmp0 (name, "Inbox") != 0) ||
-                (g_strcmp0 (name, "Sent") != 0),
-                NULL);
+        g_return_val_if_fail (rtm_glib_has_auth_token (rtm), NULL);
 
-        RestXmlNode *root, *node;
-        gchar *transaction_id;
+        RestXmlNode *root;
+        GBytes *payload;
+        GList *list = NULL;
+        gint64 start;
         GError *tmp_error = NULL;
 
+        if (rtm->priv->use_json) {
+                payload = rtm_glib_call_method_json (
+                        rtm,
+                        RTM_METHOD_LOCATIONS_GET_LIST, &tmp_error,
+                        "auth_token", RTM_GLIB_AUTH_TOKEN,
+                        NULL);
+                if (tmp_error != NULL) {
+                        g_propagate_error (error, tmp_error);
+                        return NULL;
+                }
+
+                start = g_get_monotonic_time ();
+                list = rtm_glib_decode_locations (payload, error);
+                rtm_glib_record_load (rtm, RTM_METHOD_LOCATIONS_GET_LIST,
+                                      start);
+                g_bytes_unref (payload);
+
+                return list;
+        }
+
         root = rtm_glib_call_method (
                 rtm,
-                RTM_METHOD_LISTS_SET_NAME, &tmp_error,
-                "auth_token", rtm->priv->auth_token,
-                "timeline", timeline,
-                "list_id", rtm_list_get_id (list),
-                "name", name,
+                RTM_METHOD_LOCATIONS_GET_LIST, &tmp_error,
+                "auth_token", RTM_GLIB_AUTH_TOKEN,
                 NULL);
         if (tmp_error != NULL) {
                 g_propagate_error (error, tmp_error);
                 return NULL;
         }
 
-        node = rest_xml_node_find (root, "transaction");
-        transaction_id = g_strdup (rest_xml_node_get_attr (node, "id"));
-        DEBUG_PRINT ("transaction_id: %s", transaction_id);
+        start = g_get_monotonic_time ();
+        list = rtm_glib_parse_locations (root);
+        rtm_glib_record_load (rtm, RTM_METHOD_LOCATIONS_GET_LIST, start);
 
         rest_xml_node_unref (root);
 
-        return transaction_id;
+        return list;
 }
 
 /**
- * rtm_glib_lists_set_default_list:
+ * rtm_glib_locations_get_list_async:
  * @rtm: a #RtmGlib object already authenticated.
- * @timeline: the timeline within which to run a method.
- * @list: the #RtmList to set as default list.
+ * @cancellable: optional #GCancellable object, %NULL to ignore.
+ * @callback: a #GAsyncReadyCallback to call when the request is satisfied.
+ * @user_data: the data to pass to callback function.
+ *
+ * Asynchronously gets the list of locations.
+ *
+ * When the operation is finished, @callback will be called. You can then call
+ * rtm_glib_locations_get_list_finish() to get the result of the operation.
+ **/
+void
+rtm_glib_locations_get_list_async (RtmGlib *rtm, GCancellable *cancellable,
+                                   GAsyncReadyCallback callback,
+                                   gpointer user_data)
+{
+        g_return_if_fail (rtm != NULL);
+        g_return_if_fail (rtm_glib_has_auth_token (rtm));
+
+        if (rtm->priv->use_json) {
+                rtm_glib_call_method_json_async (
+                        rtm,
+                        RTM_METHOD_LOCATIONS_GET_LIST,
+                        cancellable, callback, user_data,
+                        "auth_token", RTM_GLIB_AUTH_TOKEN,
+                        NULL);
+        } else {
+                rtm_glib_call_method_async (
+                        rtm,
+                        RTM_METHOD_LOCATIONS_GET_LIST,
+                        cancellable, callback, user_data,
+                        "auth_token", RTM_GLIB_AUTH_TOKEN,
+                        NULL);
+        }
+}
+
+/**
+ * rtm_glib_locations_get_list_finish:
+ * @rtm: a #RtmGlib object.
+ * @result: the #GAsyncResult passed to the callback.
  * @error: location to store #GError or %NULL.
  *
- * Sets the default list.
+ * Finishes an operation started with rtm_glib_locations_get_list_async().
  *
- * Returns: %TRUE if the opration is successfuly.
+ * Returns: A #GList of #RtmLocation objects.
  **/
-gboolean
-rtm_glib_lists_set_default_list (RtmGlib *rtm, gchar* timeline, RtmList *list,
-                                 GError **error)
+GList *
+rtm_glib_locations_get_list_finish (RtmGlib *rtm, GAsyncResult *result,
+                                    GError **error)
 {
-        g_return_val_if_fail (rtm != NULL, FALSE);
-        g_return_val_if_fail (rtm->priv->auth_token != NULL, FALSE);
-        g_return_val_if_fail (timeline != NULL, FALSE);
-        g_return_val_if_fail (list != NULL, FALSE);
+        g_return_val_if_fail (rtm != NULL, NULL);
 
         RestXmlNode *root;
-        GError *tmp_error = NULL;
+        GBytes *payload;
+        GList *list;
+        gint64 start;
+
+        if (rtm_glib_call_method_is_json (result)) {
+                payload = rtm_glib_call_method_json_finish (rtm, result,
+                                                            error);
+                if (payload == NULL) {
+                        return NULL;
+                }
 
-        root = rtm_glib_call_method (
-                rtm,
-                RTM_METHOD_LISTS_SET_DEFAULT_LIST, &tmp_error,
-                "auth_token", rtm->priv->auth_token,
-                "timeline", timeline,
-                "list_id", rtm_list_get_id (list),
-                NULL);
-        if (tmp_error != NULL) {
-                g_propagate_error (error, tmp_error);
-                return FALSE;
+                start = g_get_monotonic_time ();
+                list = rtm_glib_decode_locations (payload, error);
+                rtm_glib_record_load (rtm, RTM_METHOD_LOCATIONS_GET_LIST,
+                                      start);
+                g_bytes_unref (payload);
+
+                return list;
         }
 
+        root = rtm_glib_call_method_finish (rtm, result, error);
+        if (root == NULL) {
+                return NULL;
+        }
+
+        start = g_get_monotonic_time ();
+        list = rtm_glib_parse_locations (root);
+        rtm_glib_record_load (rtm, RTM_METHOD_LOCATIONS_GET_LIST, start);
+
         rest_xml_node_unref (root);
 
-        return TRUE;
+        return list;
 }
 
 /**
- * rtm_glib_lists_archive:
+ * rtm_glib_tasks_set_priority:
  * @rtm: a #RtmGlib object already authenticated.
  * @timeline: the timeline within which to run a method.
- * @list: the #RtmList to be archived.
+ * @task: a #RtmTask to be modified with the new name.
+ * @priority: The desired priority of a task.
  * @error: location to store #GError or %NULL.
  *
- * Archives a list.
+ * Sets the priority of a task. Valid values are %1, %2 and %3. If priority is
+ * not specified or is an invalid value, the task is marked as having no
+ * priority.
  *
  * Returns: The transaction identifier or %NULL if it fails.
  **/
 gchar *
-rtm_glib_lists_archive (RtmGlib *rtm, gchar* timeline, RtmList *list,
-                        GError **error)
+rtm_glib_tasks_set_priority (RtmGlib *rtm, gchar* timeline, RtmTask *task,
+                             gchar *priority, GError **error)
 {
         g_return_val_if_fail (rtm != NULL, NULL);
-        g_return_val_if_fail (rtm->priv->auth_token != NULL, NULL);
+        g_return_val_if_fail (rtm_glib_has_auth_token (rtm), NULL);
         g_return_val_if_fail (timeline != NULL, NULL);
-        g_return_val_if_fail (list != NULL, NULL);
+        g_return_val_if_fail (task != NULL, NULL);
 
-        RestXmlNode *root, *node;
+        if (priority == NULL) {
+                priority = "";
+        }
+
+        RestXmlNode *root;
         gchar *transaction_id;
         GError *tmp_error = NULL;
 
         root = rtm_glib_call_method (
                 rtm,
-                RTM_METHOD_LISTS_ARCHIVE, &tmp_error,
-                "auth_token", rtm->priv->auth_token,
+                RTM_METHOD_TASKS_SET_PRIORITY, &tmp_error,
+                "auth_token", RTM_GLIB_AUTH_TOKEN,
                 "timeline", timeline,
-                "list_id", rtm_list_get_id (list),
+                "list_id", rtm_task_get_list_id (task),
+                "taskseries_id", rtm_task_get_taskseries_id (task),
+                "task_id", rtm_task_get_id (task),
+                "priority", priority,
                 NULL);
         if (tmp_error != NULL) {
                 g_propagate_error (error, tmp_error);
                 return NULL;
         }
 
-        node = rest_xml_node_find (root, "transaction");
-        transaction_id = g_strdup (rest_xml_node_get_attr (node, "id"));
-        DEBUG_PRINT ("transaction_id: %s", transaction_id);
+        transaction_id = rtm_glib_parse_transaction_id (root);
 
         rest_xml_node_unref (root);
 
@@ -1539,44 +7781,73 @@ rtm_glib_lists_archive (RtmGlib *rtm, gchar* timeline, RtmList *list,
 }
 
 /**
- * rtm_glib_lists_unarchive:
+ * rtm_glib_tasks_set_priority_async:
  * @rtm: a #RtmGlib object already authenticated.
  * @timeline: the timeline within which to run a method.
- * @list: the #RtmList to be unarchived.
+ * @task: a #RtmTask to be modified with the new name.
+ * @priority: The desired priority of a task.
+ * @cancellable: optional #GCancellable object, %NULL to ignore.
+ * @callback: a #GAsyncReadyCallback to call when the request is satisfied.
+ * @user_data: the data to pass to callback function.
+ *
+ * Asynchronously sets the priority of a task.
+ *
+ * When the operation is finished, @callback will be called. You can then call
+ * rtm_glib_tasks_set_priority_finish() to get the result of the operation.
+ **/
+void
+rtm_glib_tasks_set_priority_async (RtmGlib *rtm, gchar* timeline,
+                                   RtmTask *task, gchar *priority,
+                                   GCancellable *cancellable,
+                                   GAsyncReadyCallback callback,
+                                   gpointer user_data)
+{
+        g_return_if_fail (rtm != NULL);
+        g_return_if_fail (rtm_glib_has_auth_token (rtm));
+        g_return_if_fail (timeline != NULL);
+        g_return_if_fail (task != NULL);
+
+        if (priority == NULL) {
+                priority = "";
+        }
+
+        rtm_glib_call_method_async (
+                rtm,
+                RTM_METHOD_TASKS_SET_PRIORITY, cancellable, callback, user_data,
+                "auth_token", RTM_GLIB_AUTH_TOKEN,
+                "timeline", timeline,
+                "list_id", rtm_task_get_list_id (task),
+                "taskseries_id", rtm_task_get_taskseries_id (task),
+                "task_id", rtm_task_get_id (task),
+                "priority", priority,
+                NULL);
+}
+
+/**
+ * rtm_glib_tasks_set_priority_finish:
+ * @rtm: a #RtmGlib object.
+ * @result: the #GAsyncResult passed to the callback.
  * @error: location to store #GError or %NULL.
  *
- * Unarchives a list.
+ * Finishes an operation started with rtm_glib_tasks_set_priority_async().
  *
  * Returns: The transaction identifier or %NULL if it fails.
  **/
 gchar *
-rtm_glib_lists_unarchive (RtmGlib *rtm, gchar* timeline, RtmList *list,
-                          GError **error)
+rtm_glib_tasks_set_priority_finish (RtmGlib *rtm, GAsyncResult *result,
+                                    GError **error)
 {
         g_return_val_if_fail (rtm != NULL, NULL);
-        g_return_val_if_fail (rtm->priv->auth_token != NULL, NULL);
-        g_return_val_if_fail (timeline != NULL, NULL);
-        g_return_val_if_fail (list != NULL, NULL);
 
-        RestXmlNode *root, *node;
+        RestXmlNode *root;
         gchar *transaction_id;
-        GError *tmp_error = NULL;
 
-        root = rtm_glib_call_method (
-                rtm,
-                RTM_METHOD_LISTS_UNARCHIVE, &tmp_error,
-                "auth_token", rtm->priv->auth_token,
-                "timeline", timeline,
-                "list_id", rtm_list_get_id (list),
-                NULL);
-        if (tmp_error != NULL) {
-                g_propagate_error (error, tmp_error);
+        root = rtm_glib_call_method_finish (rtm, result, error);
+        if (root == NULL) {
                 return NULL;
         }
 
-        node = rest_xml_node_find (root, "transaction");
-        transaction_id = g_strdup (rest_xml_node_get_attr (node, "id"));
-        DEBUG_PRINT ("transaction_id: %s", transaction_id);
+        transaction_id = rtm_glib_parse_transaction_id (root);
 
         rest_xml_node_unref (root);
 
@@ -1584,53 +7855,44 @@ rtm_glib_lists_unarchive (RtmGlib *rtm, gchar* timeline, RtmList *list,
 }
 
 /**
- * rtm_glib_tasks_set_url:
+ * rtm_glib_tasks_complete:
  * @rtm: a #RtmGlib object already authenticated.
  * @timeline: the timeline within which to run a method.
  * @task: a #RtmTask to be modified with the new name.
- * @url: The URL associated with a task. Valid protocols are http, https, ftp
- * and file. If %NUL, any existing URL will be unset.
  * @error: location to store #GError or %NULL.
  *
- * Sets an URL for a task.
+ * Marks a task complete.
  *
  * Returns: The transaction identifier or %NULL if it fails.
  **/
 gchar *
-rtm_glib_tasks_set_url (RtmGlib *rtm, gchar* timeline, RtmTask *task,
-                        gchar *url, GError **error)
+rtm_glib_tasks_complete (RtmGlib *rtm, gchar* timeline, RtmTask *task,
+                         GError **error)
 {
         g_return_val_if_fail (rtm != NULL, NULL);
-        g_return_val_if_fail (rtm->priv->auth_token != NULL, NULL);
+        g_return_val_if_fail (rtm_glib_has_auth_token (rtm), NULL);
         g_return_val_if_fail (timeline != NULL, NULL);
         g_return_val_if_fail (task != NULL, NULL);
 
-        if (url == NULL) {
-                url = "";
-        }
-
-        RestXmlNode *root, *node;
+        RestXmlNode *root;
         gchar *transaction_id;
         GError *tmp_error = NULL;
 
         root = rtm_glib_call_method (
                 rtm,
-                RTM_METHOD_TASKS_SET_URL, &tmp_error,
-                "auth_token", rtm->priv->auth_token,
+                RTM_METHOD_TASKS_COMPLETE, &tmp_error,
+                "auth_token", RTM_GLIB_AUTH_TOKEN,
                 "timeline", timeline,
                 "list_id", rtm_task_get_list_id (task),
                 "taskseries_id", rtm_task_get_taskseries_id (task),
                 "task_id", rtm_task_get_id (task),
-                "url", url,
                 NULL);
         if (tmp_error != NULL) {
                 g_propagate_error (error, tmp_error);
                 return NULL;
         }
 
-        node = rest_xml_node_find (root, "transaction");
-        transaction_id = g_strdup (rest_xml_node_get_attr (node, "id"));
-        DEBUG_PRINT ("transaction_id: %s", transaction_id);
+        transaction_id = rtm_glib_parse_transaction_id (root);
 
         rest_xml_node_unref (root);
 
@@ -1638,52 +7900,66 @@ rtm_glib_tasks_set_url (RtmGlib *rtm, gchar* timeline, RtmTask *task,
 }
 
 /**
- * rtm_glib_tasks_set_tags:
+ * rtm_glib_tasks_complete_async:
  * @rtm: a #RtmGlib object already authenticated.
  * @timeline: the timeline within which to run a method.
  * @task: a #RtmTask to be modified with the new name.
- * @tags: A comma delimited list of tags. If %NULL, any existing tag will be
- * unset.
+ * @cancellable: optional #GCancellable object, %NULL to ignore.
+ * @callback: a #GAsyncReadyCallback to call when the request is satisfied.
+ * @user_data: the data to pass to callback function.
  *
- * Sets the tags of a task.
+ * Asynchronously marks a task complete.
  *
- * Returns: The transaction identifier or %NULL if it fails.
+ * When the operation is finished, @callback will be called. You can then call
+ * rtm_glib_tasks_complete_finish() to get the result of the operation.
  **/
-gchar *
-rtm_glib_tasks_set_tags (RtmGlib *rtm, gchar* timeline, RtmTask *task,
-                         gchar *tags, GError **error)
+void
+rtm_glib_tasks_complete_async (RtmGlib *rtm, gchar* timeline, RtmTask *task,
+                               GCancellable *cancellable,
+                               GAsyncReadyCallback callback,
+                               gpointer user_data)
 {
-        g_return_val_if_fail (rtm != NULL, NULL);
-        g_return_val_if_fail (rtm->priv->auth_token != NULL, NULL);
-        g_return_val_if_fail (timeline != NULL, NULL);
-        g_return_val_if_fail (task != NULL, NULL);
-
-        if (tags == NULL) {
-                tags = "";
-        }
-
-        RestXmlNode *root, *node;
-        gchar *transaction_id;
-        GError *tmp_error = NULL;
+        g_return_if_fail (rtm != NULL);
+        g_return_if_fail (rtm_glib_has_auth_token (rtm));
+        g_return_if_fail (timeline != NULL);
+        g_return_if_fail (task != NULL);
 
-        root = rtm_glib_call_method (
+        rtm_glib_call_method_async (
                 rtm,
-                RTM_METHOD_TASKS_SET_TAGS, &tmp_error,
-                "auth_token", rtm->priv->auth_token,
+                RTM_METHOD_TASKS_COMPLETE, cancellable, callback, user_data,
+                "auth_token", RTM_GLIB_AUTH_TOKEN,
                 "timeline", timeline,
                 "list_id", rtm_task_get_list_id (task),
                 "taskseries_id", rtm_task_get_taskseries_id (task),
                 "task_id", rtm_task_get_id (task),
-                "tags", tags,
                 NULL);
-        if (tmp_error != NULL) {
-                g_propagate_error (error, tmp_error);
+}
+
+/**
+ * rtm_glib_tasks_complete_finish:
+ * @rtm: a #RtmGlib object.
+ * @result: the #GAsyncResult passed to the callback.
+ * @error: location to store #GError or %NULL.
+ *
+ * Finishes an operation started with rtm_glib_tasks_complete_async().
+ *
+ * Returns: The transaction identifier or %NULL if it fails.
+ **/
+gchar *
+rtm_glib_tasks_complete_finish (RtmGlib *rtm, GAsyncResult *result,
+                                GError **error)
+{
+        g_return_val_if_fail (rtm != NULL, NULL);
+
+        RestXmlNode *root;
+        gchar *transaction_id;
+
+        root = rtm_glib_call_method_finish (rtm, result, error);
+        if (root == NULL) {
                 return NULL;
         }
 
-        node = rest_xml_node_find (root, "transaction");
-        transaction_id = g_strdup (rest_xml_node_get_attr (node, "id"));
-        DEBUG_PRINT ("transaction_id: %s", transaction_id);
+        transaction_id = rtm_glib_parse_transaction_id (root);
 
         rest_xml_node_unref (root);
 
@@ -1691,48 +7967,44 @@ rtm_glib_tasks_set_tags (RtmGlib *rtm, gchar* timeline, RtmTask *task,
 }
 
 /**
- * rtm_glib_tasks_add_tags:
+ * rtm_glib_tasks_uncomplete:
  * @rtm: a #RtmGlib object already authenticated.
  * @timeline: the timeline within which to run a method.
  * @task: a #RtmTask to be modified with the new name.
- * @tags: A comma delimited list of tags.
+ * @error: location to store #GError or %NULL.
  *
- * Adds tags for a task.
+ * Marks a task incomplete.
  *
  * Returns: The transaction identifier or %NULL if it fails.
  **/
-gchar *
-rtm_glib_tasks_add_tags (RtmGlib *rtm, gchar* timeline, RtmTask *task,
-                         gchar *tags, GError **error)
+gchar *
+rtm_glib_tasks_uncomplete (RtmGlib *rtm, gchar* timeline, RtmTask *task,
+                           GError **error)
 {
         g_return_val_if_fail (rtm != NULL, NULL);
-        g_return_val_if_fail (rtm->priv->auth_token != NULL, NULL);
+        g_return_val_if_fail (rtm_glib_has_auth_token (rtm), NULL);
         g_return_val_if_fail (timeline != NULL, NULL);
         g_return_val_if_fail (task != NULL, NULL);
-        g_return_val_if_fail (tags != NULL, NULL);
 
-        RestXmlNode *root, *node;
+        RestXmlNode *root;
         gchar *transaction_id;
         GError *tmp_error = NULL;
 
         root = rtm_glib_call_method (
                 rtm,
-                RTM_METHOD_TASKS_ADD_TAGS, &tmp_error,
-                "auth_token", rtm->priv->auth_token,
+                RTM_METHOD_TASKS_UNCOMPLETE, &tmp_error,
+                "auth_token", RTM_GLIB_AUTH_TOKEN,
                 "timeline", timeline,
                 "list_id", rtm_task_get_list_id (task),
                 "taskseries_id", rtm_task_get_taskseries_id (task),
                 "task_id", rtm_task_get_id (task),
-                "tags", tags,
                 NULL);
         if (tmp_error != NULL) {
                 g_propagate_error (error, tmp_error);
                 return NULL;
         }
 
-        node = rest_xml_node_find (root, "transaction");
-        transaction_id = g_strdup (rest_xml_node_get_attr (node, "id"));
-        DEBUG_PRINT ("transaction_id: %s", transaction_id);
+        transaction_id = rtm_glib_parse_transaction_id (root);
 
         rest_xml_node_unref (root);
 
@@ -1740,48 +8012,66 @@ rtm_glib_tasks_add_tags (RtmGlib *rtm, gchar* timeline, RtmTask *task,
 }
 
 /**
- * rtm_glib_tasks_remove_tags:
+ * rtm_glib_tasks_uncomplete_async:
  * @rtm: a #RtmGlib object already authenticated.
  * @timeline: the timeline within which to run a method.
  * @task: a #RtmTask to be modified with the new name.
- * @tags: A comma delimited list of tags.
+ * @cancellable: optional #GCancellable object, %NULL to ignore.
+ * @callback: a #GAsyncReadyCallback to call when the request is satisfied.
+ * @user_data: the data to pass to callback function.
  *
- * Removes tags from a task.
+ * Asynchronously marks a task incomplete.
  *
- * Returns: The transaction identifier or %NULL if it fails.
+ * When the operation is finished, @callback will be called. You can then call
+ * rtm_glib_tasks_uncomplete_finish() to get the result of the operation.
  **/
-gchar *
-rtm_glib_tasks_remove_tags (RtmGlib *rtm, gchar* timeline, RtmTask *task,
-                            gchar *tags, GError **error)
+void
+rtm_glib_tasks_uncomplete_async (RtmGlib *rtm, gchar* timeline, RtmTask *task,
+                                 GCancellable *cancellable,
+                                 GAsyncReadyCallback callback,
+                                 gpointer user_data)
 {
-        g_return_val_if_fail (rtm != NULL, NULL);
-        g_return_val_if_fail (rtm->priv->auth_token != NULL, NULL);
-        g_return_val_if_fail (timeline != NULL, NULL);
-        g_return_val_if_fail (task != NULL, NULL);
-        g_return_val_if_fail (tags != NULL, NULL);
+        g_return_if_fail (rtm != NULL);
+        g_return_if_fail (rtm_glib_has_auth_token (rtm));
+        g_return_if_fail (timeline != NULL);
+        g_return_if_fail (task != NULL);
 
-        RestXmlNode *root, *node;
-        gchar *transaction_id;
-        GError *tmp_error = NULL;
-
-        root = rtm_glib_call_method (
+        rtm_glib_call_method_async (
                 rtm,
-                RTM_METHOD_TASKS_REMOVE_TAGS, &tmp_error,
-                "auth_token", rtm->priv->auth_token,
+                RTM_METHOD_TASKS_UNCOMPLETE, cancellable, callback, user_data,
+                "auth_token", RTM_GLIB_AUTH_TOKEN,
                 "timeline", timeline,
                 "list_id", rtm_task_get_list_id (task),
                 "taskseries_id", rtm_task_get_taskseries_id (task),
                 "task_id", rtm_task_get_id (task),
-                "tags", tags,
                 NULL);
-        if (tmp_error != NULL) {
-                g_propagate_error (error, tmp_error);
+}
+
+/**
+ * rtm_glib_tasks_uncomplete_finish:
+ * @rtm: a #RtmGlib object.
+ * @result: the #GAsyncResult passed to the callback.
+ * @error: location to store #GError or %NULL.
+ *
+ * Finishes an operation started with rtm_glib_tasks_uncomplete_async().
+ *
+ * Returns: The transaction identifier or %NULL if it fails.
+ **/
+gchar *
+rtm_glib_tasks_uncomplete_finish (RtmGlib *rtm, GAsyncResult *result,
+                                  GError **error)
+{
+        g_return_val_if_fail (rtm != NULL, NULL);
+
+        RestXmlNode *root;
+        gchar *transaction_id;
+
+        root = rtm_glib_call_method_finish (rtm, result, error);
+        if (root == NULL) {
                 return NULL;
         }
 
-        node = rest_xml_node_find (root, "transaction");
-        transaction_id = g_strdup (rest_xml_node_get_attr (node, "id"));
-        DEBUG_PRINT ("transaction_id: %s", transaction_id);
+        transaction_id = rtm_glib_parse_transaction_id (root);
 
         rest_xml_node_unref (root);
 
@@ -1789,49 +8079,47 @@ rtm_glib_tasks_remove_tags (RtmGlib *rtm, gchar* timeline, RtmTask *task,
 }
 
 /**
- * rtm_glib_tasks_set_location:
+ * rtm_glib_tasks_move_priority:
  * @rtm: a #RtmGlib object already authenticated.
  * @timeline: the timeline within which to run a method.
- * @task: a #RtmTask to be modified with the new location ID.
- * @location_id: the ID of a location.
+ * @task: a #RtmTask to be modified with the new name.
+ * @direction: The direction to move a priority. Either "up" or "down".
  * @error: location to store #GError or %NULL.
  *
- * Sets the location ID of a task.
+ * Moves the priority of a task up or down depending on @direction.
  *
  * Returns: The transaction identifier or %NULL if it fails.
  **/
 gchar *
-rtm_glib_tasks_set_location (RtmGlib *rtm, gchar* timeline, RtmTask *task,
-                             gchar *location_id, GError **error)
+rtm_glib_tasks_move_priority (RtmGlib *rtm, gchar* timeline, RtmTask *task,
+                              gchar *direction, GError **error)
 {
         g_return_val_if_fail (rtm != NULL, NULL);
-        g_return_val_if_fail (rtm->priv->auth_token != NULL, NULL);
+        g_return_val_if_fail (rtm_glib_has_auth_token (rtm), NULL);
         g_return_val_if_fail (timeline != NULL, NULL);
         g_return_val_if_fail (task != NULL, NULL);
-        g_return_val_if_fail (location_id != NULL, NULL);
+        g_return_val_if_fail (direction != NULL, NULL);
 
-        RestXmlNode *root, *node;
+        RestXmlNode *root;
         gchar *transaction_id;
         GError *tmp_error = NULL;
 
         root = rtm_glib_call_method (
                 rtm,
-                RTM_METHOD_TASKS_SET_LOCATION, &tmp_error,
-                "auth_token", rtm->priv->auth_token,
+                RTM_METHOD_TASKS_MOVE_PRIORITY, &tmp_error,
+                "auth_token", RTM_GLIB_AUTH_TOKEN,
                 "timeline", timeline,
                 "list_id", rtm_task_get_list_id (task),
                 "taskseries_id", rtm_task_get_taskseries_id (task),
                 "task_id", rtm_task_get_id (task),
-                "location_id", location_id,
+                "direction", direction,
                 NULL);
         if (tmp_error != NULL) {
                 g_propagate_error (error, tmp_error);
                 return NULL;
         }
 
-        node = rest_xml_node_find (root, "transaction");
-        transaction_id = g_strdup (rest_xml_node_get_attr (node, "id"));
-        DEBUG_PRINT ("transaction_id: %s", transaction_id);
+        transaction_id = rtm_glib_parse_transaction_id (root);
 
         rest_xml_node_unref (root);
 
@@ -1839,95 +8127,72 @@ rtm_glib_tasks_set_location (RtmGlib *rtm, gchar* timeline, RtmTask *task,
 }
 
 /**
- * rtm_glib_locations_get_list:
+ * rtm_glib_tasks_move_priority_async:
  * @rtm: a #RtmGlib object already authenticated.
- * @error: location to store #GError or %NULL.
+ * @timeline: the timeline within which to run a method.
+ * @task: a #RtmTask to be modified with the new name.
+ * @direction: The direction to move a priority. Either "up" or "down".
+ * @cancellable: optional #GCancellable object, %NULL to ignore.
+ * @callback: a #GAsyncReadyCallback to call when the request is satisfied.
+ * @user_data: the data to pass to callback function.
  *
- * Gets the list of locations.
+ * Asynchronously moves the priority of a task up or down depending on
+ * @direction.
  *
- * Returns: A #GList of #RtmLocation objects.
+ * When the operation is finished, @callback will be called. You can then call
+ * rtm_glib_tasks_move_priority_finish() to get the result of the operation.
  **/
-GList *
-rtm_glib_locations_get_list (RtmGlib *rtm, GError **error)
+void
+rtm_glib_tasks_move_priority_async (RtmGlib *rtm, gchar* timeline,
+                                    RtmTask *task, gchar *direction,
+                                    GCancellable *cancellable,
+                                    GAsyncReadyCallback callback,
+                                    gpointer user_data)
 {
-        g_return_val_if_fail (rtm != NULL, NULL);
-        g_return_val_if_fail (rtm->priv->auth_token != NULL, NULL);
-
-        RestXmlNode *root, *node;
-        GList *list = NULL;
-        RtmLocation *location;
-        GError *tmp_error = NULL;
+        g_return_if_fail (rtm != NULL);
+        g_return_if_fail (rtm_glib_has_auth_token (rtm));
+        g_return_if_fail (timeline != NULL);
+        g_return_if_fail (task != NULL);
+        g_return_if_fail (direction != NULL);
 
-        root = rtm_glib_call_method (
+        rtm_glib_call_method_async (
                 rtm,
-                RTM_METHOD_LOCATIONS_GET_LIST, &tmp_error,
-                "auth_token", rtm->priv->auth_token,
+                RTM_METHOD_TASKS_MOVE_PRIORITY,
+                cancellable, callback, user_data,
+                "auth_token", RTM_GLIB_AUTH_TOKEN,
+                "timeline", timeline,
+                "list_id", rtm_task_get_list_id (task),
+                "taskseries_id", rtm_task_get_taskseries_id (task),
+                "task_id", rtm_task_get_id (task),
+                "direction", direction,
                 NULL);
-        if (tmp_error != NULL) {
-                g_propagate_error (error, tmp_error);
-                return NULL;
-        }
-
-        for (node = rest_xml_node_find (root, "location"); node; node = node->next) {
-                location = rtm_location_new ();
-                rtm_location_load_data (location, node);
-                list = g_list_append (list, location);
-        }
-
-        rest_xml_node_unref (root);
-
-        return list;
 }
 
 /**
- * rtm_glib_tasks_set_priority:
- * @rtm: a #RtmGlib object already authenticated.
- * @timeline: the timeline within which to run a method.
- * @task: a #RtmTask to be modified with the new name.
- * @priority: The desired priority of a task.
+ * rtm_glib_tasks_move_priority_finish:
+ * @rtm: a #RtmGlib object.
+ * @result: the #GAsyncResult passed to the callback.
  * @error: location to store #GError or %NULL.
  *
- * Sets the priority of a task. Valid values are %1, %2 and %3. If priority is
- * not specified or is an invalid value, the task is marked as having no
- * priority.
+ * Finishes an operation started with rtm_glib_tasks_move_priority_async().
  *
  * Returns: The transaction identifier or %NULL if it fails.
  **/
 gchar *
-rtm_glib_tasks_set_priority (RtmGlib *rtm, gchar* timeline, RtmTask *task,
-                             gchar *priority, GError **error)
+rtm_glib_tasks_move_priority_finish (RtmGlib *rtm, GAsyncResult *result,
+                                     GError **error)
 {
         g_return_val_if_fail (rtm != NULL, NULL);
-        g_return_val_if_fail (rtm->priv->auth_token != NULL, NULL);
-        g_return_val_if_fail (timeline != NULL, NULL);
-        g_return_val_if_fail (task != NULL, NULL);
-
-        if (priority == NULL) {
-                priority = "";
-        }
 
-        RestXmlNode *root, *node;
+        RestXmlNode *root;
         gchar *transaction_id;
-        GError *tmp_error = NULL;
 
-        root = rtm_glib_call_method (
-                rtm,
-                RTM_METHOD_TASKS_SET_PRIORITY, &tmp_error,
-                "auth_token", rtm->priv->auth_token,
-                "timeline", timeline,
-                "list_id", rtm_task_get_list_id (task),
-                "taskseries_id", rtm_task_get_taskseries_id (task),
-                "task_id", rtm_task_get_id (task),
-                "priority", priority,
-                NULL);
-        if (tmp_error != NULL) {
-                g_propagate_error (error, tmp_error);
+        root = rtm_glib_call_method_finish (rtm, result, error);
+        if (root == NULL) {
                 return NULL;
         }
 
-        node = rest_xml_node_find (root, "transaction");
-        transaction_id = g_strdup (rest_xml_node_get_attr (node, "id"));
-        DEBUG_PRINT ("transaction_id: %s", transaction_id);
+        transaction_id = rtm_glib_parse_transaction_id (root);
 
         rest_xml_node_unref (root);
 
@@ -1935,33 +8200,34 @@ rtm_glib_tasks_set_priority (RtmGlib *rtm, gchar* timeline, RtmTask *task,
 }
 
 /**
- * rtm_glib_tasks_complete:
+ * rtm_glib_tasks_postpone:
  * @rtm: a #RtmGlib object already authenticated.
  * @timeline: the timeline within which to run a method.
  * @task: a #RtmTask to be modified with the new name.
  * @error: location to store #GError or %NULL.
  *
- * Marks a task complete.
+ * Postpones a task. If the task has no due date or is overdue, its due date
+ * is set to today. Otherwise, the task due date is advanced a day.
  *
  * Returns: The transaction identifier or %NULL if it fails.
  **/
 gchar *
-rtm_glib_tasks_complete (RtmGlib *rtm, gchar* timeline, RtmTask *task,
+rtm_glib_tasks_postpone (RtmGlib *rtm, gchar* timeline, RtmTask *task,
                          GError **error)
 {
         g_return_val_if_fail (rtm != NULL, NULL);
-        g_return_val_if_fail (rtm->priv->auth_token != NULL, NULL);
+        g_return_val_if_fail (rtm_glib_has_auth_token (rtm), NULL);
         g_return_val_if_fail (timeline != NULL, NULL);
         g_return_val_if_fail (task != NULL, NULL);
 
-        RestXmlNode *root, *node;
+        RestXmlNode *root;
         gchar *transaction_id;
         GError *tmp_error = NULL;
 
         root = rtm_glib_call_method (
                 rtm,
-                RTM_METHOD_TASKS_COMPLETE, &tmp_error,
-                "auth_token", rtm->priv->auth_token,
+                RTM_METHOD_TASKS_POSTPONE, &tmp_error,
+                "auth_token", RTM_GLIB_AUTH_TOKEN,
                 "timeline", timeline,
                 "list_id", rtm_task_get_list_id (task),
                 "taskseries_id", rtm_task_get_taskseries_id (task),
@@ -1972,9 +8238,7 @@ rtm_glib_tasks_complete (RtmGlib *rtm, gchar* timeline, RtmTask *task,
                 return NULL;
         }
 
-        node = rest_xml_node_find (root, "transaction");
-        transaction_id = g_strdup (rest_xml_node_get_attr (node, "id"));
-        DEBUG_PRINT ("transaction_id: %s", transaction_id);
+        transaction_id = rtm_glib_parse_transaction_id (root);
 
         rest_xml_node_unref (root);
 
@@ -1982,46 +8246,66 @@ rtm_glib_tasks_complete (RtmGlib *rtm, gchar* timeline, RtmTask *task,
 }
 
 /**
- * rtm_glib_tasks_uncomplete:
+ * rtm_glib_tasks_postpone_async:
  * @rtm: a #RtmGlib object already authenticated.
  * @timeline: the timeline within which to run a method.
  * @task: a #RtmTask to be modified with the new name.
- * @error: location to store #GError or %NULL.
+ * @cancellable: optional #GCancellable object, %NULL to ignore.
+ * @callback: a #GAsyncReadyCallback to call when the request is satisfied.
+ * @user_data: the data to pass to callback function.
  *
- * Marks a task incomplete.
+ * Asynchronously postpones a task.
  *
- * Returns: The transaction identifier or %NULL if it fails.
+ * When the operation is finished, @callback will be called. You can then call
+ * rtm_glib_tasks_postpone_finish() to get the result of the operation.
  **/
-gchar *
-rtm_glib_tasks_uncomplete (RtmGlib *rtm, gchar* timeline, RtmTask *task,
-                           GError **error)
+void
+rtm_glib_tasks_postpone_async (RtmGlib *rtm, gchar* timeline, RtmTask *task,
+                               GCancellable *cancellable,
+                               GAsyncReadyCallback callback,
+                               gpointer user_data)
 {
-        g_return_val_if_fail (rtm != NULL, NULL);
-        g_return_val_if_fail (rtm->priv->auth_token != NULL, NULL);
-        g_return_val_if_fail (timeline != NULL, NULL);
-        g_return_val_if_fail (task != NULL, NULL);
-
-        RestXmlNode *root, *node;
-        gchar *transaction_id;
-        GError *tmp_error = NULL;
+        g_return_if_fail (rtm != NULL);
+        g_return_if_fail (rtm_glib_has_auth_token (rtm));
+        g_return_if_fail (timeline != NULL);
+        g_return_if_fail (task != NULL);
 
-        root = rtm_glib_call_method (
+        rtm_glib_call_method_async (
                 rtm,
-                RTM_METHOD_TASKS_UNCOMPLETE, &tmp_error,
-                "auth_token", rtm->priv->auth_token,
+                RTM_METHOD_TASKS_POSTPONE, cancellable, callback, user_data,
+                "auth_token", RTM_GLIB_AUTH_TOKEN,
                 "timeline", timeline,
                 "list_id", rtm_task_get_list_id (task),
                 "taskseries_id", rtm_task_get_taskseries_id (task),
                 "task_id", rtm_task_get_id (task),
                 NULL);
-        if (tmp_error != NULL) {
-                g_propagate_error (error, tmp_error);
+}
+
+/**
+ * rtm_glib_tasks_postpone_finish:
+ * @rtm: a #RtmGlib object.
+ * @result: the #GAsyncResult passed to the callback.
+ * @error: location to store #GError or %NULL.
+ *
+ * Finishes an operation started with rtm_glib_tasks_postpone_async().
+ *
+ * Returns: The transaction identifier or %NULL if it fails.
+ **/
+gchar *
+rtm_glib_tasks_postpone_finish (RtmGlib *rtm, GAsyncResult *result,
+                                GError **error)
+{
+        g_return_val_if_fail (rtm != NULL, NULL);
+
+        RestXmlNode *root;
+        gchar *transaction_id;
+
+        root = rtm_glib_call_method_finish (rtm, result, error);
+        if (root == NULL) {
                 return NULL;
         }
 
-        node = rest_xml_node_find (root, "transaction");
-        transaction_id = g_strdup (rest_xml_node_get_attr (node, "id"));
-        DEBUG_PRINT ("transaction_id: %s", transaction_id);
+        transaction_id = rtm_glib_parse_transaction_id (root);
 
         rest_xml_node_unref (root);
 
@@ -2029,49 +8313,47 @@ rtm_glib_tasks_uncomplete (RtmGlib *rtm, gchar* timeline, RtmTask *task,
 }
 
 /**
- * rtm_glib_tasks_move_priority:
+ * rtm_glib_tasks_move_to:
  * @rtm: a #RtmGlib object already authenticated.
  * @timeline: the timeline within which to run a method.
  * @task: a #RtmTask to be modified with the new name.
- * @direction: The direction to move a priority. Either "up" or "down".
+ * @list_id: The target list id.
  * @error: location to store #GError or %NULL.
  *
- * Moves the priority of a task up or down depending on @direction.
+ * Move a task between lists.
  *
  * Returns: The transaction identifier or %NULL if it fails.
  **/
 gchar *
-rtm_glib_tasks_move_priority (RtmGlib *rtm, gchar* timeline, RtmTask *task,
-                              gchar *direction, GError **error)
+rtm_glib_tasks_move_to (RtmGlib *rtm, gchar* timeline, RtmTask *task,
+                        gchar *list_id, GError **error)
 {
         g_return_val_if_fail (rtm != NULL, NULL);
-        g_return_val_if_fail (rtm->priv->auth_token != NULL, NULL);
+        g_return_val_if_fail (rtm_glib_has_auth_token (rtm), NULL);
         g_return_val_if_fail (timeline != NULL, NULL);
         g_return_val_if_fail (task != NULL, NULL);
-        g_return_val_if_fail (direction != NULL, NULL);
+        g_return_val_if_fail (list_id != NULL, NULL);
 
-        RestXmlNode *root, *node;
+        RestXmlNode *root;
         gchar *transaction_id;
         GError *tmp_error = NULL;
 
         root = rtm_glib_call_method (
                 rtm,
-                RTM_METHOD_TASKS_MOVE_PRIORITY, &tmp_error,
-                "auth_token", rtm->priv->auth_token,
+                RTM_METHOD_TASKS_MOVE_TO, &tmp_error,
+                "auth_token", RTM_GLIB_AUTH_TOKEN,
                 "timeline", timeline,
-                "list_id", rtm_task_get_list_id (task),
+                "from_list_id", rtm_task_get_list_id (task),
+                "to_list_id", list_id,
                 "taskseries_id", rtm_task_get_taskseries_id (task),
                 "task_id", rtm_task_get_id (task),
-                "direction", direction,
                 NULL);
         if (tmp_error != NULL) {
                 g_propagate_error (error, tmp_error);
                 return NULL;
         }
 
-        node = rest_xml_node_find (root, "transaction");
-        transaction_id = g_strdup (rest_xml_node_get_attr (node, "id"));
-        DEBUG_PRINT ("transaction_id: %s", transaction_id);
+        transaction_id = rtm_glib_parse_transaction_id (root);
 
         rest_xml_node_unref (root);
 
@@ -2079,47 +8361,68 @@ rtm_glib_tasks_move_priority (RtmGlib *rtm, gchar* timeline, RtmTask *task,
 }
 
 /**
- * rtm_glib_tasks_postpone:
+ * rtm_glib_tasks_move_to_async:
  * @rtm: a #RtmGlib object already authenticated.
  * @timeline: the timeline within which to run a method.
  * @task: a #RtmTask to be modified with the new name.
- * @error: location to store #GError or %NULL.
+ * @list_id: The target list id.
+ * @cancellable: optional #GCancellable object, %NULL to ignore.
+ * @callback: a #GAsyncReadyCallback to call when the request is satisfied.
+ * @user_data: the data to pass to callback function.
  *
- * Postpones a task. If the task has no due date or is overdue, its due date
- * is set to today. Otherwise, the task due date is advanced a day.
+ * Asynchronously move a task between lists.
  *
- * Returns: The transaction identifier or %NULL if it fails.
+ * When the operation is finished, @callback will be called. You can then call
+ * rtm_glib_tasks_move_to_finish() to get the result of the operation.
  **/
-gchar *
-rtm_glib_tasks_postpone (RtmGlib *rtm, gchar* timeline, RtmTask *task,
-                         GError **error)
+void
+rtm_glib_tasks_move_to_async (RtmGlib *rtm, gchar* timeline, RtmTask *task,
+                              gchar *list_id, GCancellable *cancellable,
+                              GAsyncReadyCallback callback, gpointer user_data)
 {
-        g_return_val_if_fail (rtm != NULL, NULL);
-        g_return_val_if_fail (rtm->priv->auth_token != NULL, NULL);
-        g_return_val_if_fail (timeline != NULL, NULL);
-        g_return_val_if_fail (task != NULL, NULL);
-
-        RestXmlNode *root, *node;
-        gchar *transaction_id;
-        GError *tmp_error = NULL;
+        g_return_if_fail (rtm != NULL);
+        g_return_if_fail (rtm_glib_has_auth_token (rtm));
+        g_return_if_fail (timeline != NULL);
+        g_return_if_fail (task != NULL);
+        g_return_if_fail (list_id != NULL);
 
-        root = rtm_glib_call_method (
+        rtm_glib_call_method_async (
                 rtm,
-                RTM_METHOD_TASKS_POSTPONE, &tmp_error,
-                "auth_token", rtm->priv->auth_token,
+                RTM_METHOD_TASKS_MOVE_TO, cancellable, callback, user_data,
+                "auth_token", RTM_GLIB_AUTH_TOKEN,
                 "timeline", timeline,
-                "list_id", rtm_task_get_list_id (task),
+                "from_list_id", rtm_task_get_list_id (task),
+                "to_list_id", list_id,
                 "taskseries_id", rtm_task_get_taskseries_id (task),
                 "task_id", rtm_task_get_id (task),
                 NULL);
-        if (tmp_error != NULL) {
-                g_propagate_error (error, tmp_error);
+}
+
+/**
+ * rtm_glib_tasks_move_to_finish:
+ * @rtm: a #RtmGlib object.
+ * @result: the #GAsyncResult passed to the callback.
+ * @error: location to store #GError or %NULL.
+ *
+ * Finishes an operation started with rtm_glib_tasks_move_to_async().
+ *
+ * Returns: The transaction identifier or %NULL if it fails.
+ **/
+gchar *
+rtm_glib_tasks_move_to_finish (RtmGlib *rtm, GAsyncResult *result,
+                               GError **error)
+{
+        g_return_val_if_fail (rtm != NULL, NULL);
+
+        RestXmlNode *root;
+        gchar *transaction_id;
+
+        root = rtm_glib_call_method_finish (rtm, result, error);
+        if (root == NULL) {
                 return NULL;
         }
 
-        node = rest_xml_node_find (root, "transaction");
-        transaction_id = g_strdup (rest_xml_node_get_attr (node, "id"));
-        DEBUG_PRINT ("transaction_id: %s", transaction_id);
+        transaction_id = rtm_glib_parse_transaction_id (root);
 
         rest_xml_node_unref (root);
 
@@ -2127,49 +8430,52 @@ rtm_glib_tasks_postpone (RtmGlib *rtm, gchar* timeline, RtmTask *task,
 }
 
 /**
- * rtm_glib_tasks_move_to:
+ * rtm_glib_tasks_set_recurrence:
  * @rtm: a #RtmGlib object already authenticated.
  * @timeline: the timeline within which to run a method.
  * @task: a #RtmTask to be modified with the new name.
- * @list_id: The target list id.
+ * @repeat: The recurrence pattern for a task.
  * @error: location to store #GError or %NULL.
  *
- * Move a task between lists.
+ * Sets the recurrence pattern for a task. Valid values are detailed
+ * <ulink url="http://www.rememberthemilk.com/help/answers/basics/repeatformat.rtm">here</ulink>.
+ * An empty value unsets any existing recurrence pattern.
  *
  * Returns: The transaction identifier or %NULL if it fails.
  **/
 gchar *
-rtm_glib_tasks_move_to (RtmGlib *rtm, gchar* timeline, RtmTask *task,
-                        gchar *list_id, GError **error)
+rtm_glib_tasks_set_recurrence (RtmGlib *rtm, gchar* timeline, RtmTask *task,
+                               gchar *repeat, GError **error)
 {
         g_return_val_if_fail (rtm != NULL, NULL);
-        g_return_val_if_fail (rtm->priv->auth_token != NULL, NULL);
+        g_return_val_if_fail (rtm_glib_has_auth_token (rtm), NULL);
         g_return_val_if_fail (timeline != NULL, NULL);
         g_return_val_if_fail (task != NULL, NULL);
-        g_return_val_if_fail (list_id != NULL, NULL);
 
-        RestXmlNode *root, *node;
+        if (repeat == NULL) {
+                repeat = "";
+        }
+
+        RestXmlNode *root;
         gchar *transaction_id;
         GError *tmp_error = NULL;
 
         root = rtm_glib_call_method (
                 rtm,
-                RTM_METHOD_TASKS_MOVE_TO, &tmp_error,
-                "auth_token", rtm->priv->auth_token,
+                RTM_METHOD_TASKS_SET_RECURRENCE, &tmp_error,
+                "auth_token", RTM_GLIB_AUTH_TOKEN,
                 "timeline", timeline,
-                "from_list_id", rtm_task_get_list_id (task),
-                "to_list_id", list_id,
+                "list_id", rtm_task_get_list_id (task),
                 "taskseries_id", rtm_task_get_taskseries_id (task),
                 "task_id", rtm_task_get_id (task),
+                "repeat", repeat,
                 NULL);
         if (tmp_error != NULL) {
                 g_propagate_error (error, tmp_error);
                 return NULL;
         }
 
-        node = rest_xml_node_find (root, "transaction");
-        transaction_id = g_strdup (rest_xml_node_get_attr (node, "id"));
-        DEBUG_PRINT ("transaction_id: %s", transaction_id);
+        transaction_id = rtm_glib_parse_transaction_id (root);
 
         rest_xml_node_unref (root);
 
@@ -2177,54 +8483,74 @@ rtm_glib_tasks_move_to (RtmGlib *rtm, gchar* timeline, RtmTask *task,
 }
 
 /**
- * rtm_glib_tasks_set_recurrence:
+ * rtm_glib_tasks_set_recurrence_async:
  * @rtm: a #RtmGlib object already authenticated.
  * @timeline: the timeline within which to run a method.
  * @task: a #RtmTask to be modified with the new name.
  * @repeat: The recurrence pattern for a task.
- * @error: location to store #GError or %NULL.
+ * @cancellable: optional #GCancellable object, %NULL to ignore.
+ * @callback: a #GAsyncReadyCallback to call when the request is satisfied.
+ * @user_data: the data to pass to callback function.
  *
- * Sets the recurrence pattern for a task. Valid values are detailed
- * <ulink url="http://www.rememberthemilk.com/help/answers/basics/repeatformat.rtm">here</ulink>.
- * An empty value unsets any existing recurrence pattern.
+ * Asynchronously sets the recurrence pattern for a task.
  *
- * Returns: The transaction identifier or %NULL if it fails.
+ * When the operation is finished, @callback will be called. You can then call
+ * rtm_glib_tasks_set_recurrence_finish() to get the result of the operation.
  **/
-gchar *
-rtm_glib_tasks_set_recurrence (RtmGlib *rtm, gchar* timeline, RtmTask *task,
-                               gchar *repeat, GError **error)
+void
+rtm_glib_tasks_set_recurrence_async (RtmGlib *rtm, gchar* timeline,
+                                     RtmTask *task, gchar *repeat,
+                                     GCancellable *cancellable,
+                                     GAsyncReadyCallback callback,
+                                     gpointer user_data)
 {
-        g_return_val_if_fail (rtm != NULL, NULL);
-        g_return_val_if_fail (rtm->priv->auth_token != NULL, NULL);
-        g_return_val_if_fail (timeline != NULL, NULL);
-        g_return_val_if_fail (task != NULL, NULL);
+        g_return_if_fail (rtm != NULL);
+        g_return_if_fail (rtm_glib_has_auth_token (rtm));
+        g_return_if_fail (timeline != NULL);
+        g_return_if_fail (task != NULL);
 
         if (repeat == NULL) {
                 repeat = "";
         }
 
-        RestXmlNode *root, *node;
-        gchar *transaction_id;
-        GError *tmp_error = NULL;
-
-        root = rtm_glib_call_method (
+        rtm_glib_call_method_async (
                 rtm,
-                RTM_METHOD_TASKS_SET_RECURRENCE, &tmp_error,
-                "auth_token", rtm->priv->auth_token,
+                RTM_METHOD_TASKS_SET_RECURRENCE,
+                cancellable, callback, user_data,
+                "auth_token", RTM_GLIB_AUTH_TOKEN,
                 "timeline", timeline,
                 "list_id", rtm_task_get_list_id (task),
                 "taskseries_id", rtm_task_get_taskseries_id (task),
                 "task_id", rtm_task_get_id (task),
                 "repeat", repeat,
                 NULL);
-        if (tmp_error != NULL) {
-                g_propagate_error (error, tmp_error);
+}
+
+/**
+ * rtm_glib_tasks_set_recurrence_finish:
+ * @rtm: a #RtmGlib object.
+ * @result: the #GAsyncResult passed to the callback.
+ * @error: location to store #GError or %NULL.
+ *
+ * Finishes an operation started with rtm_glib_tasks_set_recurrence_async().
+ *
+ * Returns: The transaction identifier or %NULL if it fails.
+ **/
+gchar *
+rtm_glib_tasks_set_recurrence_finish (RtmGlib *rtm, GAsyncResult *result,
+                                      GError **error)
+{
+        g_return_val_if_fail (rtm != NULL, NULL);
+
+        RestXmlNode *root;
+        gchar *transaction_id;
+
+        root = rtm_glib_call_method_finish (rtm, result, error);
+        if (root == NULL) {
                 return NULL;
         }
 
-        node = rest_xml_node_find (root, "transaction");
-        transaction_id = g_strdup (rest_xml_node_get_attr (node, "id"));
-        DEBUG_PRINT ("transaction_id: %s", transaction_id);
+        transaction_id = rtm_glib_parse_transaction_id (root);
 
         rest_xml_node_unref (root);
 
@@ -2249,7 +8575,7 @@ rtm_glib_tasks_set_estimate (RtmGlib *rtm, gchar* timeline, RtmTask *task,
                              gchar *estimate, GError **error)
 {
         g_return_val_if_fail (rtm != NULL, NULL);
-        g_return_val_if_fail (rtm->priv->auth_token != NULL, NULL);
+        g_return_val_if_fail (rtm_glib_has_auth_token (rtm), NULL);
         g_return_val_if_fail (timeline != NULL, NULL);
         g_return_val_if_fail (task != NULL, NULL);
 
@@ -2257,14 +8583,14 @@ rtm_glib_tasks_set_estimate (RtmGlib *rtm, gchar* timeline, RtmTask *task,
                 estimate = "";
         }
 
-        RestXmlNode *root, *node;
+        RestXmlNode *root;
         gchar *transaction_id;
         GError *tmp_error = NULL;
 
         root = rtm_glib_call_method (
                 rtm,
                 RTM_METHOD_TASKS_SET_ESTIMATE, &tmp_error,
-                "auth_token", rtm->priv->auth_token,
+                "auth_token", RTM_GLIB_AUTH_TOKEN,
                 "timeline", timeline,
                 "list_id", rtm_task_get_list_id (task),
                 "taskseries_id", rtm_task_get_taskseries_id (task),
@@ -2276,9 +8602,81 @@ rtm_glib_tasks_set_estimate (RtmGlib *rtm, gchar* timeline, RtmTask *task,
                 return NULL;
         }
 
-        node = rest_xml_node_find (root, "transaction");
-        transaction_id = g_strdup (rest_xml_node_get_attr (node, "id"));
-        DEBUG_PRINT ("transaction_id: %s", transaction_id);
+        transaction_id = rtm_glib_parse_transaction_id (root);
+
+        rest_xml_node_unref (root);
+
+        return transaction_id;
+}
+
+/**
+ * rtm_glib_tasks_set_estimate_async:
+ * @rtm: a #RtmGlib object already authenticated.
+ * @timeline: the timeline within which to run a method.
+ * @task: a #RtmTask to be modified with the new name.
+ * @estimate: The time estimate for a task.
+ * @cancellable: optional #GCancellable object, %NULL to ignore.
+ * @callback: a #GAsyncReadyCallback to call when the request is satisfied.
+ * @user_data: the data to pass to callback function.
+ *
+ * Asynchronously sets a time estimate for a task.
+ *
+ * When the operation is finished, @callback will be called. You can then call
+ * rtm_glib_tasks_set_estimate_finish() to get the result of the operation.
+ **/
+void
+rtm_glib_tasks_set_estimate_async (RtmGlib *rtm, gchar* timeline,
+                                   RtmTask *task, gchar *estimate,
+                                   GCancellable *cancellable,
+                                   GAsyncReadyCallback callback,
+                                   gpointer user_data)
+{
+        g_return_if_fail (rtm != NULL);
+        g_return_if_fail (rtm_glib_has_auth_token (rtm));
+        g_return_if_fail (timeline != NULL);
+        g_return_if_fail (task != NULL);
+
+        if (estimate == NULL) {
+                estimate = "";
+        }
+
+        rtm_glib_call_method_async (
+                rtm,
+                RTM_METHOD_TASKS_SET_ESTIMATE, cancellable, callback, user_data,
+                "auth_token", RTM_GLIB_AUTH_TOKEN,
+                "timeline", timeline,
+                "list_id", rtm_task_get_list_id (task),
+                "taskseries_id", rtm_task_get_taskseries_id (task),
+                "task_id", rtm_task_get_id (task),
+                "estimate", estimate,
+                NULL);
+}
+
+/**
+ * rtm_glib_tasks_set_estimate_finish:
+ * @rtm: a #RtmGlib object.
+ * @result: the #GAsyncResult passed to the callback.
+ * @error: location to store #GError or %NULL.
+ *
+ * Finishes an operation started with rtm_glib_tasks_set_estimate_async().
+ *
+ * Returns: The transaction identifier or %NULL if it fails.
+ **/
+gchar *
+rtm_glib_tasks_set_estimate_finish (RtmGlib *rtm, GAsyncResult *result,
+                                    GError **error)
+{
+        g_return_val_if_fail (rtm != NULL, NULL);
+
+        RestXmlNode *root;
+        gchar *transaction_id;
+
+        root = rtm_glib_call_method_finish (rtm, result, error);
+        if (root == NULL) {
+                return NULL;
+        }
+
+        transaction_id = rtm_glib_parse_transaction_id (root);
 
         rest_xml_node_unref (root);
 
@@ -2307,7 +8705,7 @@ rtm_glib_tasks_set_due_date (RtmGlib *rtm, gchar* timeline, RtmTask *task,
                              gboolean parse, GError **error)
 {
         g_return_val_if_fail (rtm != NULL, NULL);
-        g_return_val_if_fail (rtm->priv->auth_token != NULL, NULL);
+        g_return_val_if_fail (rtm_glib_has_auth_token (rtm), NULL);
         g_return_val_if_fail (timeline != NULL, NULL);
         g_return_val_if_fail (task != NULL, NULL);
 
@@ -2315,7 +8713,7 @@ rtm_glib_tasks_set_due_date (RtmGlib *rtm, gchar* timeline, RtmTask *task,
                 due = "";
         }
 
-        RestXmlNode *root, *node;
+        RestXmlNode *root;
         gchar *transaction_id;
         GError *tmp_error = NULL;
         gchar *has_due_time_value, *parse_value;
@@ -2335,7 +8733,7 @@ rtm_glib_tasks_set_due_date (RtmGlib *rtm, gchar* timeline, RtmTask *task,
         root = rtm_glib_call_method (
                 rtm,
                 RTM_METHOD_TASKS_SET_DUE_DATE, &tmp_error,
-                "auth_token", rtm->priv->auth_token,
+                "auth_token", RTM_GLIB_AUTH_TOKEN,
                 "timeline", timeline,
                 "list_id", rtm_task_get_list_id (task),
                 "taskseries_id", rtm_task_get_taskseries_id (task),
@@ -2349,9 +8747,100 @@ rtm_glib_tasks_set_due_date (RtmGlib *rtm, gchar* timeline, RtmTask *task,
                 return NULL;
         }
 
-        node = rest_xml_node_find (root, "transaction");
-        transaction_id = g_strdup (rest_xml_node_get_attr (node, "id"));
-        DEBUG_PRINT ("transaction_id: %s", transaction_id);
+        transaction_id = rtm_glib_parse_transaction_id (root);
+
+        rest_xml_node_unref (root);
+
+        return transaction_id;
+}
+
+/**
+ * rtm_glib_tasks_set_due_date_async:
+ * @rtm: a #RtmGlib object already authenticated.
+ * @timeline: the timeline within which to run a method.
+ * @task: a #RtmTask to be modified with the new name.
+ * @due: Due date for a task, in ISO 8601 format.
+ * @has_due_time: Specifies whether the due date has a due time.
+ * @parse: Specifies whether to parse due as per rtm.time.parse.
+ * @cancellable: optional #GCancellable object, %NULL to ignore.
+ * @callback: a #GAsyncReadyCallback to call when the request is satisfied.
+ * @user_data: the data to pass to callback function.
+ *
+ * Asynchronously sets the due date of a task.
+ *
+ * When the operation is finished, @callback will be called. You can then call
+ * rtm_glib_tasks_set_due_date_finish() to get the result of the operation.
+ **/
+void
+rtm_glib_tasks_set_due_date_async (RtmGlib *rtm, gchar* timeline,
+                                   RtmTask *task, gchar *due,
+                                   gboolean has_due_time, gboolean parse,
+                                   GCancellable *cancellable,
+                                   GAsyncReadyCallback callback,
+                                   gpointer user_data)
+{
+        g_return_if_fail (rtm != NULL);
+        g_return_if_fail (rtm_glib_has_auth_token (rtm));
+        g_return_if_fail (timeline != NULL);
+        g_return_if_fail (task != NULL);
+
+        if (due == NULL) {
+                due = "";
+        }
+
+        gchar *has_due_time_value, *parse_value;
+
+        if (has_due_time) {
+                has_due_time_value = "1";
+        } else {
+                has_due_time_value = "0";
+        }
+
+        if (parse) {
+                parse_value = "1";
+        } else {
+                parse_value = "0";
+        }
+
+        rtm_glib_call_method_async (
+                rtm,
+                RTM_METHOD_TASKS_SET_DUE_DATE, cancellable, callback, user_data,
+                "auth_token", RTM_GLIB_AUTH_TOKEN,
+                "timeline", timeline,
+                "list_id", rtm_task_get_list_id (task),
+                "taskseries_id", rtm_task_get_taskseries_id (task),
+                "task_id", rtm_task_get_id (task),
+                "due", due,
+                "has_due_time", has_due_time_value,
+                "parse", parse_value,
+                NULL);
+}
+
+/**
+ * rtm_glib_tasks_set_due_date_finish:
+ * @rtm: a #RtmGlib object.
+ * @result: the #GAsyncResult passed to the callback.
+ * @error: location to store #GError or %NULL.
+ *
+ * Finishes an operation started with rtm_glib_tasks_set_due_date_async().
+ *
+ * Returns: The transaction identifier or %NULL if it fails.
+ **/
+gchar *
+rtm_glib_tasks_set_due_date_finish (RtmGlib *rtm, GAsyncResult *result,
+                                    GError **error)
+{
+        g_return_val_if_fail (rtm != NULL, NULL);
+
+        RestXmlNode *root;
+        gchar *transaction_id;
+
+        root = rtm_glib_call_method_finish (rtm, result, error);
+        if (root == NULL) {
+                return NULL;
+        }
+
+        transaction_id = rtm_glib_parse_transaction_id (root);
 
         rest_xml_node_unref (root);
 
@@ -2372,25 +8861,128 @@ rtm_glib_time_zones_get_list (RtmGlib *rtm, GError **error)
 {
         g_return_val_if_fail (rtm != NULL, NULL);
 
-        RestXmlNode *root, *node;
+        RestXmlNode *root;
+        GBytes *payload;
         GList *list = NULL;
-        RtmTimeZone *time_zone;
+        gint64 start;
         GError *tmp_error = NULL;
 
-        root = rtm_glib_call_method (
-                rtm,
-                RTM_METHOD_TIME_ZONES_GET_LIST, &tmp_error,
-                NULL);
-        if (tmp_error != NULL) {
-                g_propagate_error (error, tmp_error);
+        if (rtm->priv->use_json) {
+                payload = rtm_glib_call_method_json (
+                        rtm,
+                        RTM_METHOD_TIME_ZONES_GET_LIST, &tmp_error,
+                        NULL);
+                if (tmp_error != NULL) {
+                        g_propagate_error (error, tmp_error);
+                        return NULL;
+                }
+
+                start = g_get_monotonic_time ();
+                list = rtm_glib_decode_time_zones (payload, error);
+                rtm_glib_record_load (rtm, RTM_METHOD_TIME_ZONES_GET_LIST,
+                                      start);
+                g_bytes_unref (payload);
+
+                return list;
+        }
+
+        root = rtm_glib_call_method (
+                rtm,
+                RTM_METHOD_TIME_ZONES_GET_LIST, &tmp_error,
+                NULL);
+        if (tmp_error != NULL) {
+                g_propagate_error (error, tmp_error);
+                return NULL;
+        }
+
+        start = g_get_monotonic_time ();
+        list = rtm_glib_parse_time_zones (root);
+        rtm_glib_record_load (rtm, RTM_METHOD_TIME_ZONES_GET_LIST, start);
+
+        rest_xml_node_unref (root);
+
+        return list;
+}
+
+/**
+ * rtm_glib_time_zones_get_list_async:
+ * @rtm: a #RtmGlib object.
+ * @cancellable: optional #GCancellable object, %NULL to ignore.
+ * @callback: a #GAsyncReadyCallback to call when the request is satisfied.
+ * @user_data: the data to pass to callback function.
+ *
+ * Asynchronously gets the list of time zones.
+ *
+ * When the operation is finished, @callback will be called. You can then call
+ * rtm_glib_time_zones_get_list_finish() to get the result of the operation.
+ **/
+void
+rtm_glib_time_zones_get_list_async (RtmGlib *rtm, GCancellable *cancellable,
+                                    GAsyncReadyCallback callback,
+                                    gpointer user_data)
+{
+        g_return_if_fail (rtm != NULL);
+
+        if (rtm->priv->use_json) {
+                rtm_glib_call_method_json_async (
+                        rtm,
+                        RTM_METHOD_TIME_ZONES_GET_LIST,
+                        cancellable, callback, user_data,
+                        NULL);
+        } else {
+                rtm_glib_call_method_async (
+                        rtm,
+                        RTM_METHOD_TIME_ZONES_GET_LIST,
+                        cancellable, callback, user_data,
+                        NULL);
+        }
+}
+
+/**
+ * rtm_glib_time_zones_get_list_finish:
+ * @rtm: a #RtmGlib object.
+ * @result: the #GAsyncResult passed to the callback.
+ * @error: location to store #GError or %NULL.
+ *
+ * Finishes an operation started with rtm_glib_time_zones_get_list_async().
+ *
+ * Returns: A #GList of #RtmTimeZone objects.
+ **/
+GList *
+rtm_glib_time_zones_get_list_finish (RtmGlib *rtm, GAsyncResult *result,
+                                     GError **error)
+{
+        g_return_val_if_fail (rtm != NULL, NULL);
+
+        RestXmlNode *root;
+        GBytes *payload;
+        GList *list;
+        gint64 start;
+
+        if (rtm_glib_call_method_is_json (result)) {
+                payload = rtm_glib_call_method_json_finish (rtm, result,
+                                                            error);
+                if (payload == NULL) {
+                        return NULL;
+                }
+
+                start = g_get_monotonic_time ();
+                list = rtm_glib_decode_time_zones (payload, error);
+                rtm_glib_record_load (rtm, RTM_METHOD_TIME_ZONES_GET_LIST,
+                                      start);
+                g_bytes_unref (payload);
+
+                return list;
+        }
+
+        root = rtm_glib_call_method_finish (rtm, result, error);
+        if (root == NULL) {
                 return NULL;
         }
 
-        for (node = rest_xml_node_find (root, "timezone"); node; node = node->next) {
-                time_zone = rtm_time_zone_new ();
-                rtm_time_zone_load_data (time_zone, node);
-                list = g_list_append (list, time_zone);
-        }
+        start = g_get_monotonic_time ();
+        list = rtm_glib_parse_time_zones (root);
+        rtm_glib_record_load (rtm, RTM_METHOD_TIME_ZONES_GET_LIST, start);
 
         rest_xml_node_unref (root);
 
@@ -2417,7 +9009,7 @@ rtm_glib_time_parse (RtmGlib *rtm, gchar* text, gchar *timezone_name,
         g_return_val_if_fail (rtm != NULL, NULL);
         g_return_val_if_fail (text != NULL, NULL);
 
-        RestXmlNode *root, *node;
+        RestXmlNode *root;
         GError *tmp_error = NULL;
         gchar *time;
         gchar *dateformat_value;
@@ -2444,9 +9036,83 @@ rtm_glib_time_parse (RtmGlib *rtm, gchar* text, gchar *timezone_name,
                 return NULL;
         }
 
-        node = rest_xml_node_find (root, "time");
-        time = g_strdup (node->content);
-        DEBUG_PRINT ("time: %s", time);
+        time = rtm_glib_parse_content (root, "time");
+
+        rest_xml_node_unref (root);
+
+        return time;
+}
+
+/**
+ * rtm_glib_time_parse_async:
+ * @rtm: a #RtmGlib object.
+ * @text: text to parse.
+ * @timezone_name: if specified, text is parsed in the context of #RtmTimeZone.
+ * @dateformat: %TRUE for American format (02/14/2009) and %FALSE for European
+ * format (14/02/2009). This value is used in case a date is ambiguous.
+ * @cancellable: optional #GCancellable object, %NULL to ignore.
+ * @callback: a #GAsyncReadyCallback to call when the request is satisfied.
+ * @user_data: the data to pass to callback function.
+ *
+ * Asynchronously returns the time, in UTC (or the #RtmTimeZone specified),
+ * for the parsed input.
+ *
+ * When the operation is finished, @callback will be called. You can then call
+ * rtm_glib_time_parse_finish() to get the result of the operation.
+ **/
+void
+rtm_glib_time_parse_async (RtmGlib *rtm, gchar* text, gchar *timezone_name,
+                           gboolean dateformat, GCancellable *cancellable,
+                           GAsyncReadyCallback callback, gpointer user_data)
+{
+        g_return_if_fail (rtm != NULL);
+        g_return_if_fail (text != NULL);
+
+        gchar *dateformat_value;
+
+        if (timezone_name == NULL) {
+                timezone_name = "UTC";
+        }
+
+        if (dateformat) {
+                dateformat_value = "1";
+        } else {
+                dateformat_value = "0";
+        }
+
+        rtm_glib_call_method_async (
+                rtm,
+                RTM_METHOD_TIME_PARSE, cancellable, callback, user_data,
+                "text", text,
+                "timezone", timezone_name,
+                "dateformat", dateformat_value,
+                NULL);
+}
+
+/**
+ * rtm_glib_time_parse_finish:
+ * @rtm: a #RtmGlib object.
+ * @result: the #GAsyncResult passed to the callback.
+ * @error: location to store #GError or %NULL.
+ *
+ * Finishes an operation started with rtm_glib_time_parse_async().
+ *
+ * Returns: The time in ISO 8601 format.
+ **/
+gchar *
+rtm_glib_time_parse_finish (RtmGlib *rtm, GAsyncResult *result, GError **error)
+{
+        g_return_val_if_fail (rtm != NULL, NULL);
+
+        RestXmlNode *root;
+        gchar *time;
+
+        root = rtm_glib_call_method_finish (rtm, result, error);
+        if (root == NULL) {
+                return NULL;
+        }
+
+        time = rtm_glib_parse_content (root, "time");
 
         rest_xml_node_unref (root);
 
@@ -2472,7 +9138,7 @@ rtm_glib_time_convert (RtmGlib *rtm, gchar* to_timezone_name,
         g_return_val_if_fail (rtm != NULL, NULL);
         g_return_val_if_fail (to_timezone_name != NULL, NULL);
 
-        RestXmlNode *root, *node;
+        RestXmlNode *root;
         GError *tmp_error = NULL;
         gchar *result;
 
@@ -2496,15 +9162,85 @@ rtm_glib_time_convert (RtmGlib *rtm, gchar* to_timezone_name,
                 return NULL;
         }
 
-        node = rest_xml_node_find (root, "time");
-        result = g_strdup (node->content);
-        DEBUG_PRINT ("result: %s", result);
+        result = rtm_glib_parse_content (root, "time");
 
         rest_xml_node_unref (root);
 
         return result;
 }
 
+/**
+ * rtm_glib_time_convert_async:
+ * @rtm: a #RtmGlib object.
+ * @to_timezone_name: target #RtmTimeZone name.
+ * @from_timezone_name: originating #RtmTimeZone name. Defaults to "UTC".
+ * @time: time to convert in ISO 8601 format. Defaults to "now".
+ * @cancellable: optional #GCancellable object, %NULL to ignore.
+ * @callback: a #GAsyncReadyCallback to call when the request is satisfied.
+ * @user_data: the data to pass to callback function.
+ *
+ * Asynchronously returns the specified time in the desired #RtmTimeZone.
+ *
+ * When the operation is finished, @callback will be called. You can then call
+ * rtm_glib_time_convert_finish() to get the result of the operation.
+ **/
+void
+rtm_glib_time_convert_async (RtmGlib *rtm, gchar* to_timezone_name,
+                             gchar *from_timezone_name, gchar *time,
+                             GCancellable *cancellable,
+                             GAsyncReadyCallback callback, gpointer user_data)
+{
+        g_return_if_fail (rtm != NULL);
+        g_return_if_fail (to_timezone_name != NULL);
+
+        if (from_timezone_name == NULL) {
+                from_timezone_name = "UTC";
+        }
+
+        if (time == NULL) {
+                time = "now";
+        }
+
+        rtm_glib_call_method_async (
+                rtm,
+                RTM_METHOD_TIME_CONVERT, cancellable, callback, user_data,
+                "to_timezone", to_timezone_name,
+                "from_timezone", from_timezone_name,
+                "time", time,
+                NULL);
+}
+
+/**
+ * rtm_glib_time_convert_finish:
+ * @rtm: a #RtmGlib object.
+ * @result: the #GAsyncResult passed to the callback.
+ * @error: location to store #GError or %NULL.
+ *
+ * Finishes an operation started with rtm_glib_time_convert_async().
+ *
+ * Returns: The time in ISO 8601 format.
+ **/
+gchar *
+rtm_glib_time_convert_finish (RtmGlib *rtm, GAsyncResult *result,
+                              GError **error)
+{
+        g_return_val_if_fail (rtm != NULL, NULL);
+
+        RestXmlNode *root;
+        gchar *time;
+
+        root = rtm_glib_call_method_finish (rtm, result, error);
+        if (root == NULL) {
+                return NULL;
+        }
+
+        time = rtm_glib_parse_content (root, "time");
+
+        rest_xml_node_unref (root);
+
+        return time;
+}
+
 /**
  * rtm_glib_contacts_get_contact:
  * @rtm: a #RtmGlib object already authenticated.
@@ -2518,28 +9254,130 @@ GList *
 rtm_glib_contacts_get_list (RtmGlib *rtm, GError **error)
 {
         g_return_val_if_fail (rtm != NULL, NULL);
-        g_return_val_if_fail (rtm->priv->auth_token != NULL, NULL);
+        g_return_val_if_fail (rtm_glib_has_auth_token (rtm), NULL);
 
-        RestXmlNode *root, *node;
+        RestXmlNode *root;
+        GBytes *payload;
         GList *glist = NULL;
-        RtmContact *contact;
+        gint64 start;
         GError *tmp_error = NULL;
 
+        if (rtm->priv->use_json) {
+                payload = rtm_glib_call_method_json (rtm,
+                        RTM_METHOD_CONTACTS_GET_LIST, &tmp_error,
+                        "auth_token", RTM_GLIB_AUTH_TOKEN,
+                        NULL);
+                if (tmp_error != NULL) {
+                        g_propagate_error (error, tmp_error);
+                        return NULL;
+                }
+
+                start = g_get_monotonic_time ();
+                glist = rtm_glib_decode_contacts (payload, error);
+                rtm_glib_record_load (rtm, RTM_METHOD_CONTACTS_GET_LIST, start);
+                g_bytes_unref (payload);
+
+                return glist;
+        }
+
         root = rtm_glib_call_method (rtm,
                 RTM_METHOD_CONTACTS_GET_LIST, &tmp_error,
-                "auth_token", rtm->priv->auth_token,
+                "auth_token", RTM_GLIB_AUTH_TOKEN,
                 NULL);
         if (tmp_error != NULL) {
                 g_propagate_error (error, tmp_error);
                 return NULL;
         }
 
-        for (node = rest_xml_node_find (root, "contact"); node; node = node->next) {
-                contact = rtm_contact_new ();
-                rtm_contact_load_data (contact, node);
-                glist = g_list_append (glist, contact);
+        start = g_get_monotonic_time ();
+        glist = rtm_glib_parse_contacts (root);
+        rtm_glib_record_load (rtm, RTM_METHOD_CONTACTS_GET_LIST, start);
+
+        rest_xml_node_unref (root);
+
+        return glist;
+}
+
+/**
+ * rtm_glib_contacts_get_list_async:
+ * @rtm: a #RtmGlib object already authenticated.
+ * @cancellable: optional #GCancellable object, %NULL to ignore.
+ * @callback: a #GAsyncReadyCallback to call when the request is satisfied.
+ * @user_data: the data to pass to callback function.
+ *
+ * Asynchronously gets the list of contacts.
+ *
+ * When the operation is finished, @callback will be called. You can then call
+ * rtm_glib_contacts_get_list_finish() to get the result of the operation.
+ **/
+void
+rtm_glib_contacts_get_list_async (RtmGlib *rtm, GCancellable *cancellable,
+                                  GAsyncReadyCallback callback,
+                                  gpointer user_data)
+{
+        g_return_if_fail (rtm != NULL);
+        g_return_if_fail (rtm_glib_has_auth_token (rtm));
+
+        if (rtm->priv->use_json) {
+                rtm_glib_call_method_json_async (rtm,
+                        RTM_METHOD_CONTACTS_GET_LIST,
+                        cancellable, callback, user_data,
+                        "auth_token", RTM_GLIB_AUTH_TOKEN,
+                        NULL);
+        } else {
+                rtm_glib_call_method_async (rtm,
+                        RTM_METHOD_CONTACTS_GET_LIST,
+                        cancellable, callback, user_data,
+                        "auth_token", RTM_GLIB_AUTH_TOKEN,
+                        NULL);
+        }
+}
+
+/**
+ * rtm_glib_contacts_get_list_finish:
+ * @rtm: a #RtmGlib object.
+ * @result: the #GAsyncResult passed to the callback.
+ * @error: location to store #GError or %NULL.
+ *
+ * Finishes an operation started with rtm_glib_contacts_get_list_async().
+ *
+ * Returns: A #GList of #RtmContact objects.
+ **/
+GList *
+rtm_glib_contacts_get_list_finish (RtmGlib *rtm, GAsyncResult *result,
+                                   GError **error)
+{
+        g_return_val_if_fail (rtm != NULL, NULL);
+
+        RestXmlNode *root;
+        GBytes *payload;
+        GList *glist;
+        gint64 start;
+
+        if (rtm_glib_call_method_is_json (result)) {
+                payload = rtm_glib_call_method_json_finish (rtm, result,
+                                                            error);
+                if (payload == NULL) {
+                        return NULL;
+                }
+
+                start = g_get_monotonic_time ();
+                glist = rtm_glib_decode_contacts (payload, error);
+                rtm_glib_record_load (rtm, RTM_METHOD_CONTACTS_GET_LIST, start);
+                g_bytes_unref (payload);
+
+                return glist;
+        }
+
+        root = rtm_glib_call_method_finish (rtm, result, error);
+        if (root == NULL) {
+                return NULL;
         }
 
+        start = g_get_monotonic_time ();
+        glist = rtm_glib_parse_contacts (root);
+        rtm_glib_record_load (rtm, RTM_METHOD_CONTACTS_GET_LIST, start);
+
         rest_xml_node_unref (root);
 
         return glist;
@@ -2562,17 +9400,17 @@ rtm_glib_contacts_add (RtmGlib *rtm, gchar* timeline, gchar *contact,
                        GError **error)
 {
         g_return_val_if_fail (rtm != NULL, NULL);
-        g_return_val_if_fail (rtm->priv->auth_token != NULL, NULL);
+        g_return_val_if_fail (rtm_glib_has_auth_token (rtm), NULL);
         g_return_val_if_fail (contact != NULL, NULL);
 
-        RestXmlNode *root, *node;
+        RestXmlNode *root;
         RtmContact *rtmcontact;
         GError *tmp_error = NULL;
 
         root = rtm_glib_call_method (
                 rtm,
                 RTM_METHOD_CONTACTS_ADD, &tmp_error,
-                "auth_token", rtm->priv->auth_token,
+                "auth_token", RTM_GLIB_AUTH_TOKEN,
                 "timeline", timeline,
                 "contact", contact,
                 NULL);
@@ -2581,10 +9419,71 @@ rtm_glib_contacts_add (RtmGlib *rtm, gchar* timeline, gchar *contact,
                 return NULL;
         }
 
-        node = rest_xml_node_find (root, "contact");
+        rtmcontact = rtm_glib_parse_contact (root);
+
+        rest_xml_node_unref (root);
+
+        return rtmcontact;
+}
+
+/**
+ * rtm_glib_contacts_add_async:
+ * @rtm: a #RtmGlib object already authenticated.
+ * @timeline: the timeline within which to run a method.
+ * @contact: The contact to add. Can be a username or an email address of a
+ * registered Remember The Milk user.
+ * @cancellable: optional #GCancellable object, %NULL to ignore.
+ * @callback: a #GAsyncReadyCallback to call when the request is satisfied.
+ * @user_data: the data to pass to callback function.
+ *
+ * Asynchronously adds a new contact.
+ *
+ * When the operation is finished, @callback will be called. You can then call
+ * rtm_glib_contacts_add_finish() to get the result of the operation.
+ **/
+void
+rtm_glib_contacts_add_async (RtmGlib *rtm, gchar* timeline, gchar *contact,
+                             GCancellable *cancellable,
+                             GAsyncReadyCallback callback, gpointer user_data)
+{
+        g_return_if_fail (rtm != NULL);
+        g_return_if_fail (rtm_glib_has_auth_token (rtm));
+        g_return_if_fail (contact != NULL);
+
+        rtm_glib_call_method_async (
+                rtm,
+                RTM_METHOD_CONTACTS_ADD, cancellable, callback, user_data,
+                "auth_token", RTM_GLIB_AUTH_TOKEN,
+                "timeline", timeline,
+                "contact", contact,
+                NULL);
+}
+
+/**
+ * rtm_glib_contacts_add_finish:
+ * @rtm: a #RtmGlib object.
+ * @result: the #GAsyncResult passed to the callback.
+ * @error: location to store #GError or %NULL.
+ *
+ * Finishes an operation started with rtm_glib_contacts_add_async().
+ *
+ * Returns: A #RtmContact with the data of the new contact added.
+ **/
+RtmContact *
+rtm_glib_contacts_add_finish (RtmGlib *rtm, GAsyncResult *result,
+                              GError **error)
+{
+        g_return_val_if_fail (rtm != NULL, NULL);
+
+        RestXmlNode *root;
+        RtmContact *rtmcontact;
 
-        rtmcontact = rtm_contact_new ();
-        rtm_contact_load_data (rtmcontact, node);
+        root = rtm_glib_call_method_finish (rtm, result, error);
+        if (root == NULL) {
+                return NULL;
+        }
+
+        rtmcontact = rtm_glib_parse_contact (root);
 
         rest_xml_node_unref (root);
 
@@ -2607,18 +9506,18 @@ rtm_glib_contacts_delete (RtmGlib *rtm, gchar* timeline, RtmContact *contact,
                           GError **error)
 {
         g_return_val_if_fail (rtm != NULL, NULL);
-        g_return_val_if_fail (rtm->priv->auth_token != NULL, NULL);
+        g_return_val_if_fail (rtm_glib_has_auth_token (rtm), NULL);
         g_return_val_if_fail (timeline != NULL, NULL);
         g_return_val_if_fail (contact != NULL, NULL);
 
-        RestXmlNode *root, *node;
+        RestXmlNode *root;
         gchar *transaction_id;
         GError *tmp_error = NULL;
 
         root = rtm_glib_call_method (
                 rtm,
                 RTM_METHOD_CONTACTS_DELETE, &tmp_error,
-                "auth_token", rtm->priv->auth_token,
+                "auth_token", RTM_GLIB_AUTH_TOKEN,
                 "timeline", timeline,
                 "contact_id", rtm_contact_get_id (contact),
                 NULL);
@@ -2627,9 +9526,72 @@ rtm_glib_contacts_delete (RtmGlib *rtm, gchar* timeline, RtmContact *contact,
                 return NULL;
         }
 
-        node = rest_xml_node_find (root, "transaction");
-        transaction_id = g_strdup (rest_xml_node_get_attr (node, "id"));
-        DEBUG_PRINT ("transaction_id: %s", transaction_id);
+        transaction_id = rtm_glib_parse_transaction_id (root);
+
+        rest_xml_node_unref (root);
+
+        return transaction_id;
+}
+
+/**
+ * rtm_glib_contacts_delete_async:
+ * @rtm: a #RtmGlib object already authenticated.
+ * @timeline: the timeline within which to run a method.
+ * @contact: a #RtmContact to be deleted.
+ * @cancellable: optional #GCancellable object, %NULL to ignore.
+ * @callback: a #GAsyncReadyCallback to call when the request is satisfied.
+ * @user_data: the data to pass to callback function.
+ *
+ * Asynchronously removes a contact.
+ *
+ * When the operation is finished, @callback will be called. You can then call
+ * rtm_glib_contacts_delete_finish() to get the result of the operation.
+ **/
+void
+rtm_glib_contacts_delete_async (RtmGlib *rtm, gchar* timeline,
+                                RtmContact *contact, GCancellable *cancellable,
+                                GAsyncReadyCallback callback,
+                                gpointer user_data)
+{
+        g_return_if_fail (rtm != NULL);
+        g_return_if_fail (rtm_glib_has_auth_token (rtm));
+        g_return_if_fail (timeline != NULL);
+        g_return_if_fail (contact != NULL);
+
+        rtm_glib_call_method_async (
+                rtm,
+                RTM_METHOD_CONTACTS_DELETE, cancellable, callback, user_data,
+                "auth_token", RTM_GLIB_AUTH_TOKEN,
+                "timeline", timeline,
+                "contact_id", rtm_contact_get_id (contact),
+                NULL);
+}
+
+/**
+ * rtm_glib_contacts_delete_finish:
+ * @rtm: a #RtmGlib object.
+ * @result: the #GAsyncResult passed to the callback.
+ * @error: location to store #GError or %NULL.
+ *
+ * Finishes an operation started with rtm_glib_contacts_delete_async().
+ *
+ * Returns: The transaction identifier or %NULL if it fails.
+ **/
+gchar *
+rtm_glib_contacts_delete_finish (RtmGlib *rtm, GAsyncResult *result,
+                                 GError **error)
+{
+        g_return_val_if_fail (rtm != NULL, NULL);
+
+        RestXmlNode *root;
+        gchar *transaction_id;
+
+        root = rtm_glib_call_method_finish (rtm, result, error);
+        if (root == NULL) {
+                return NULL;
+        }
+
+        transaction_id = rtm_glib_parse_transaction_id (root);
 
         rest_xml_node_unref (root);
 
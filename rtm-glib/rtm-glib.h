@@ -22,10 +22,14 @@
 #define __RTM_GLIB_H__
 
 #include <glib-object.h>
+#include <gio/gio.h>
 #include <rest/rest-xml-parser.h>
 #include <rtm-glib/rtm-task.h>
+#include <rtm-glib/rtm-task-batch.h>
 #include <rtm-glib/rtm-list.h>
 #include <rtm-glib/rtm-contact.h>
+#include <rtm-glib/rtm-method-stats.h>
+#include <rtm-glib/rtm-transport.h>
 
 
 G_BEGIN_DECLS
@@ -57,27 +61,149 @@ struct _RtmGlibClass {
         GObjectClass parent_class;
 };
 
+/**
+ * RtmGlibTaskFunc:
+ * @rtm: the #RtmGlib.
+ * @task: the #RtmTask just parsed. It is only valid during the call, use
+ * g_object_ref() to keep it.
+ * @user_data: the data passed to rtm_glib_tasks_foreach_async().
+ *
+ * Called for each task of a response as soon as it is downloaded.
+ */
+typedef void (*RtmGlibTaskFunc) (RtmGlib *rtm, RtmTask *task,
+                                 gpointer user_data);
+
 GType
 rtm_glib_get_type (void) G_GNUC_CONST;
 
 RtmGlib *
 rtm_glib_new (gchar *api_key, gchar *shared_secret);
 
+void
+rtm_glib_set_transport (RtmGlib *rtm, RtmTransport *transport);
+
+RtmTransport *
+rtm_glib_get_transport (RtmGlib *rtm);
+
+void
+rtm_glib_get_connection_stats (RtmGlib *rtm, guint *sessions, guint *reused);
+
+void
+rtm_glib_get_transfer_stats (RtmGlib *rtm, guint64 *compressed,
+                             guint64 *uncompressed);
+
+void
+rtm_glib_set_rate_limit (RtmGlib *rtm, gdouble rate, guint burst);
+
+void
+rtm_glib_get_rate_limit (RtmGlib *rtm, gdouble *rate, guint *burst);
+
+void
+rtm_glib_set_retry_policy (RtmGlib *rtm, guint max_retries, guint base_delay,
+                           guint max_delay);
+
+void
+rtm_glib_get_retry_policy (RtmGlib *rtm, guint *max_retries,
+                           guint *base_delay, guint *max_delay);
+
+/*
+ * The synchronous methods take no #GCancellable. They are interrupted by the
+ * one pushed with g_cancellable_push_current() in the calling thread, if any,
+ * which another thread can cancel. Either way each attempt fails with
+ * %RTM_ERROR_TIMED_OUT after the timeout of the #RtmGlib without response.
+ */
+void
+rtm_glib_set_timeout (RtmGlib *rtm, guint timeout);
+
+guint
+rtm_glib_get_timeout (RtmGlib *rtm);
+
+void
+rtm_glib_set_use_json (RtmGlib *rtm, gboolean use_json);
+
+gboolean
+rtm_glib_get_use_json (RtmGlib *rtm);
+
+void
+rtm_glib_set_lazy_tasks (RtmGlib *rtm, gboolean lazy_tasks);
+
+gboolean
+rtm_glib_get_lazy_tasks (RtmGlib *rtm);
+
+void
+rtm_glib_set_io_thread (RtmGlib *rtm, gboolean io_thread);
+
+gboolean
+rtm_glib_get_io_thread (RtmGlib *rtm);
+
+void
+rtm_glib_prewarm (RtmGlib *rtm, guint keepalive);
+
+GList *
+rtm_glib_get_method_stats (RtmGlib *rtm);
+
+void
+rtm_glib_reset_method_stats (RtmGlib *rtm);
+
 gboolean
 rtm_glib_test_echo (RtmGlib *rtm, GError **error);
 
+void
+rtm_glib_test_echo_async (RtmGlib *rtm, GCancellable *cancellable,
+                          GAsyncReadyCallback callback, gpointer user_data);
+
+gboolean
+rtm_glib_test_echo_finish (RtmGlib *rtm, GAsyncResult *result, GError **error);
+
 gchar *
 rtm_glib_test_login (RtmGlib *rtm, gchar *auth_token, GError **error);
 
+void
+rtm_glib_test_login_async (RtmGlib *rtm, gchar *auth_token,
+                           GCancellable *cancellable,
+                           GAsyncReadyCallback callback, gpointer user_data);
+
+gchar *
+rtm_glib_test_login_finish (RtmGlib *rtm, GAsyncResult *result,
+                            GError **error);
+
 gchar *
 rtm_glib_auth_get_frob (RtmGlib *rtm, GError **error);
 
+void
+rtm_glib_auth_get_frob_async (RtmGlib *rtm, GCancellable *cancellable,
+                              GAsyncReadyCallback callback, gpointer user_data);
+
+gchar *
+rtm_glib_auth_get_frob_finish (RtmGlib *rtm, GAsyncResult *result,
+                               GError **error);
+
 gchar *
 rtm_glib_auth_get_token (RtmGlib *rtm, gchar *frob, GError **error);
 
+void
+rtm_glib_auth_get_token_async (RtmGlib *rtm, gchar *frob,
+                               GCancellable *cancellable,
+                               GAsyncReadyCallback callback,
+                               gpointer user_data);
+
+gchar *
+rtm_glib_auth_get_token_finish (RtmGlib *rtm, GAsyncResult *result,
+                                GError **error);
+
 gboolean
 rtm_glib_auth_check_token (RtmGlib *rtm, gchar *auth_token, GError **error);
 
+void
+rtm_glib_auth_check_token_async (RtmGlib *rtm, gchar *auth_token,
+                                 GCancellable *cancellable,
+                                 GAsyncReadyCallback callback,
+                                 gpointer user_data);
+
+gboolean
+rtm_glib_auth_check_token_finish (RtmGlib *rtm, GAsyncResult *result,
+                                  GError **error);
+
 gchar *
 rtm_glib_auth_get_login_url (RtmGlib *rtm, gchar *frob, gchar *perms);
 
@@ -85,132 +211,490 @@ GList *
 rtm_glib_tasks_get_list (RtmGlib *rtm, gchar *list_id, gchar *filter,
                          gchar *last_sync, GError **error);
 
+void
+rtm_glib_tasks_get_list_async (RtmGlib *rtm, gchar *list_id, gchar *filter,
+                               gchar *last_sync, GCancellable *cancellable,
+                               GAsyncReadyCallback callback,
+                               gpointer user_data);
+
+GList *
+rtm_glib_tasks_get_list_finish (RtmGlib *rtm, GAsyncResult *result,
+                                GError **error);
+
+RtmTaskBatch *
+rtm_glib_tasks_get_batch (RtmGlib *rtm, gchar *list_id, gchar *filter,
+                          gchar *last_sync, GError **error);
+
+void
+rtm_glib_tasks_get_batch_async (RtmGlib *rtm, gchar *list_id, gchar *filter,
+                                gchar *last_sync, GCancellable *cancellable,
+                                GAsyncReadyCallback callback,
+                                gpointer user_data);
+
+RtmTaskBatch *
+rtm_glib_tasks_get_batch_finish (RtmGlib *rtm, GAsyncResult *result,
+                                 GError **error);
+
+void
+rtm_glib_tasks_foreach_async (RtmGlib *rtm, gchar *list_id, gchar *filter,
+                              gchar *last_sync, RtmGlibTaskFunc func,
+                              gpointer func_data, GCancellable *cancellable,
+                              GAsyncReadyCallback callback,
+                              gpointer user_data);
+
+gboolean
+rtm_glib_tasks_foreach_finish (RtmGlib *rtm, GAsyncResult *result,
+                               GError **error);
+
 GList *
 rtm_glib_lists_get_list (RtmGlib *rtm, GError **error);
 
+void
+rtm_glib_lists_get_list_async (RtmGlib *rtm, GCancellable *cancellable,
+                               GAsyncReadyCallback callback,
+                               gpointer user_data);
+
+GList *
+rtm_glib_lists_get_list_finish (RtmGlib *rtm, GAsyncResult *result,
+                                GError **error);
+
 gchar *
 rtm_glib_timelines_create (RtmGlib *rtm, GError **error);
 
+void
+rtm_glib_timelines_create_async (RtmGlib *rtm, GCancellable *cancellable,
+                                 GAsyncReadyCallback callback,
+                                 gpointer user_data);
+
+gchar *
+rtm_glib_timelines_create_finish (RtmGlib *rtm, GAsyncResult *result,
+                                  GError **error);
+
 RtmTask *
 rtm_glib_tasks_add (RtmGlib *rtm, gchar* timeline, gchar *task_name,
                     gchar *list_id, gboolean parse, GError **error);
 
+void
+rtm_glib_tasks_add_async (RtmGlib *rtm, gchar* timeline, gchar *task_name,
+                          gchar *list_id, gboolean parse,
+                          GCancellable *cancellable,
+                          GAsyncReadyCallback callback, gpointer user_data);
+
+RtmTask *
+rtm_glib_tasks_add_finish (RtmGlib *rtm, GAsyncResult *result, GError **error);
+
 gboolean
 rtm_glib_transactions_undo (RtmGlib *rtm, gchar *timeline,
                             gchar* transaction_id, GError **error);
 
+void
+rtm_glib_transactions_undo_async (RtmGlib *rtm, gchar *timeline,
+                                  gchar* transaction_id,
+                                  GCancellable *cancellable,
+                                  GAsyncReadyCallback callback,
+                                  gpointer user_data);
+
+gboolean
+rtm_glib_transactions_undo_finish (RtmGlib *rtm, GAsyncResult *result,
+                                   GError **error);
+
 gchar *
 rtm_glib_tasks_delete (RtmGlib *rtm, gchar* timeline, RtmTask *task,
                        GError **error);
 
+void
+rtm_glib_tasks_delete_async (RtmGlib *rtm, gchar* timeline, RtmTask *task,
+                             GCancellable *cancellable,
+                             GAsyncReadyCallback callback, gpointer user_data);
+
+gchar *
+rtm_glib_tasks_delete_finish (RtmGlib *rtm, GAsyncResult *result,
+                              GError **error);
+
 gchar *
 rtm_glib_tasks_set_name (RtmGlib *rtm, gchar* timeline, RtmTask *task,
                          gchar *name, GError **error);
 
+void
+rtm_glib_tasks_set_name_async (RtmGlib *rtm, gchar* timeline, RtmTask *task,
+                               gchar *name, GCancellable *cancellable,
+                               GAsyncReadyCallback callback,
+                               gpointer user_data);
+
+gchar *
+rtm_glib_tasks_set_name_finish (RtmGlib *rtm, GAsyncResult *result,
+                                GError **error);
+
 RtmList *
 rtm_glib_lists_add (RtmGlib *rtm, gchar* timeline, gchar *list_name,
                     gchar *filter, GError **error);
 
+void
+rtm_glib_lists_add_async (RtmGlib *rtm, gchar* timeline, gchar *list_name,
+                          gchar *filter, GCancellable *cancellable,
+                          GAsyncReadyCallback callback, gpointer user_data);
+
+RtmList *
+rtm_glib_lists_add_finish (RtmGlib *rtm, GAsyncResult *result, GError **error);
+
 gchar *
 rtm_glib_lists_delete (RtmGlib *rtm, gchar* timeline, RtmList *list,
                        GError **error);
 
+void
+rtm_glib_lists_delete_async (RtmGlib *rtm, gchar* timeline, RtmList *list,
+                             GCancellable *cancellable,
+                             GAsyncReadyCallback callback, gpointer user_data);
+
+gchar *
+rtm_glib_lists_delete_finish (RtmGlib *rtm, GAsyncResult *result,
+                              GError **error);
+
 gchar *
 rtm_glib_lists_set_name (RtmGlib *rtm, gchar* timeline, RtmList *list,
                          gchar *name, GError **error);
 
+void
+rtm_glib_lists_set_name_async (RtmGlib *rtm, gchar* timeline, RtmList *list,
+                               gchar *name, GCancellable *cancellable,
+                               GAsyncReadyCallback callback,
+                               gpointer user_data);
+
+gchar *
+rtm_glib_lists_set_name_finish (RtmGlib *rtm, GAsyncResult *result,
+                                GError **error);
+
 gboolean
 rtm_glib_lists_set_default_list (RtmGlib *rtm, gchar* timeline, RtmList *list,
                                  GError **error);
 
+void
+rtm_glib_lists_set_default_list_async (RtmGlib *rtm, gchar* timeline,
+                                       RtmList *list,
+                                       GCancellable *cancellable,
+                                       GAsyncReadyCallback callback,
+                                       gpointer user_data);
+
+gboolean
+rtm_glib_lists_set_default_list_finish (RtmGlib *rtm, GAsyncResult *result,
+                                        GError **error);
+
 gchar *
 rtm_glib_lists_archive (RtmGlib *rtm, gchar* timeline, RtmList *list,
                         GError **error);
 
+void
+rtm_glib_lists_archive_async (RtmGlib *rtm, gchar* timeline, RtmList *list,
+                              GCancellable *cancellable,
+                              GAsyncReadyCallback callback, gpointer user_data);
+
+gchar *
+rtm_glib_lists_archive_finish (RtmGlib *rtm, GAsyncResult *result,
+                               GError **error);
+
 gchar *
 rtm_glib_lists_unarchive (RtmGlib *rtm, gchar* timeline, RtmList *list,
                           GError **error);
 
+void
+rtm_glib_lists_unarchive_async (RtmGlib *rtm, gchar* timeline, RtmList *list,
+                                GCancellable *cancellable,
+                                GAsyncReadyCallback callback,
+                                gpointer user_data);
+
+gchar *
+rtm_glib_lists_unarchive_finish (RtmGlib *rtm, GAsyncResult *result,
+                                 GError **error);
+
 gchar *
 rtm_glib_tasks_set_url (RtmGlib *rtm, gchar* timeline, RtmTask *task,
                         gchar *url, GError **error);
 
+void
+rtm_glib_tasks_set_url_async (RtmGlib *rtm, gchar* timeline, RtmTask *task,
+                              gchar *url, GCancellable *cancellable,
+                              GAsyncReadyCallback callback, gpointer user_data);
+
+gchar *
+rtm_glib_tasks_set_url_finish (RtmGlib *rtm, GAsyncResult *result,
+                               GError **error);
+
 gchar *
 rtm_glib_tasks_set_tags (RtmGlib *rtm, gchar* timeline, RtmTask *task,
                          gchar *tags, GError **error);
 
+void
+rtm_glib_tasks_set_tags_async (RtmGlib *rtm, gchar* timeline, RtmTask *task,
+                               gchar *tags, GCancellable *cancellable,
+                               GAsyncReadyCallback callback,
+                               gpointer user_data);
+
+gchar *
+rtm_glib_tasks_set_tags_finish (RtmGlib *rtm, GAsyncResult *result,
+                                GError **error);
+
 gchar *
 rtm_glib_tasks_add_tags (RtmGlib *rtm, gchar* timeline, RtmTask *task,
                          gchar *tags, GError **error);
 
+void
+rtm_glib_tasks_add_tags_async (RtmGlib *rtm, gchar* timeline, RtmTask *task,
+                               gchar *tags, GCancellable *cancellable,
+                               GAsyncReadyCallback callback,
+                               gpointer user_data);
+
+gchar *
+rtm_glib_tasks_add_tags_finish (RtmGlib *rtm, GAsyncResult *result,
+                                GError **error);
+
 gchar *
 rtm_glib_tasks_remove_tags (RtmGlib *rtm, gchar* timeline, RtmTask *task,
                             gchar *tags, GError **error);
 
+void
+rtm_glib_tasks_remove_tags_async (RtmGlib *rtm, gchar* timeline, RtmTask *task,
+                                  gchar *tags, GCancellable *cancellable,
+                                  GAsyncReadyCallback callback,
+                                  gpointer user_data);
+
+gchar *
+rtm_glib_tasks_remove_tags_finish (RtmGlib *rtm, GAsyncResult *result,
+                                   GError **error);
+
 gchar *
 rtm_glib_tasks_set_location (RtmGlib *rtm, gchar* timeline, RtmTask *task,
                              gchar *location_id, GError **error);
 
+void
+rtm_glib_tasks_set_location_async (RtmGlib *rtm, gchar* timeline,
+                                   RtmTask *task, gchar *location_id,
+                                   GCancellable *cancellable,
+                                   GAsyncReadyCallback callback,
+                                   gpointer user_data);
+
+gchar *
+rtm_glib_tasks_set_location_finish (RtmGlib *rtm, GAsyncResult *result,
+                                    GError **error);
+
 GList *
 rtm_glib_locations_get_list (RtmGlib *rtm, GError **error);
 
+void
+rtm_glib_locations_get_list_async (RtmGlib *rtm, GCancellable *cancellable,
+                                   GAsyncReadyCallback callback,
+                                   gpointer user_data);
+
+GList *
+rtm_glib_locations_get_list_finish (RtmGlib *rtm, GAsyncResult *result,
+                                    GError **error);
+
 gchar *
 rtm_glib_tasks_set_priority (RtmGlib *rtm, gchar* timeline, RtmTask *task,
                              gchar *priority, GError **error);
 
+void
+rtm_glib_tasks_set_priority_async (RtmGlib *rtm, gchar* timeline,
+                                   RtmTask *task, gchar *priority,
+                                   GCancellable *cancellable,
+                                   GAsyncReadyCallback callback,
+                                   gpointer user_data);
+
+gchar *
+rtm_glib_tasks_set_priority_finish (RtmGlib *rtm, GAsyncResult *result,
+                                    GError **error);
+
 gchar *
 rtm_glib_tasks_complete (RtmGlib *rtm, gchar* timeline, RtmTask *task,
                          GError **error);
 
+void
+rtm_glib_tasks_complete_async (RtmGlib *rtm, gchar* timeline, RtmTask *task,
+                               GCancellable *cancellable,
+                               GAsyncReadyCallback callback,
+                               gpointer user_data);
+
+gchar *
+rtm_glib_tasks_complete_finish (RtmGlib *rtm, GAsyncResult *result,
+                                GError **error);
+
 gchar *
 rtm_glib_tasks_uncomplete (RtmGlib *rtm, gchar* timeline, RtmTask *task,
                            GError **error);
 
+void
+rtm_glib_tasks_uncomplete_async (RtmGlib *rtm, gchar* timeline, RtmTask *task,
+                                 GCancellable *cancellable,
+                                 GAsyncReadyCallback callback,
+                                 gpointer user_data);
+
+gchar *
+rtm_glib_tasks_uncomplete_finish (RtmGlib *rtm, GAsyncResult *result,
+                                  GError **error);
+
 gchar *
 rtm_glib_tasks_move_priority (RtmGlib *rtm, gchar* timeline, RtmTask *task,
                               gchar *direction, GError **error);
 
+void
+rtm_glib_tasks_move_priority_async (RtmGlib *rtm, gchar* timeline,
+                                    RtmTask *task, gchar *direction,
+                                    GCancellable *cancellable,
+                                    GAsyncReadyCallback callback,
+                                    gpointer user_data);
+
+gchar *
+rtm_glib_tasks_move_priority_finish (RtmGlib *rtm, GAsyncResult *result,
+                                     GError **error);
+
 gchar *
 rtm_glib_tasks_postpone (RtmGlib *rtm, gchar* timeline, RtmTask *task,
                          GError **error);
 
+void
+rtm_glib_tasks_postpone_async (RtmGlib *rtm, gchar* timeline, RtmTask *task,
+                               GCancellable *cancellable,
+                               GAsyncReadyCallback callback,
+                               gpointer user_data);
+
+gchar *
+rtm_glib_tasks_postpone_finish (RtmGlib *rtm, GAsyncResult *result,
+                                GError **error);
+
 gchar *
 rtm_glib_tasks_move_to (RtmGlib *rtm, gchar* timeline, RtmTask *task,
                         gchar *list_id, GError **error);
 
+void
+rtm_glib_tasks_move_to_async (RtmGlib *rtm, gchar* timeline, RtmTask *task,
+                              gchar *list_id, GCancellable *cancellable,
+                              GAsyncReadyCallback callback, gpointer user_data);
+
+gchar *
+rtm_glib_tasks_move_to_finish (RtmGlib *rtm, GAsyncResult *result,
+                               GError **error);
+
 gchar *
 rtm_glib_tasks_set_recurrence (RtmGlib *rtm, gchar* timeline, RtmTask *task,
                                gchar *repeat, GError **error);
 
+void
+rtm_glib_tasks_set_recurrence_async (RtmGlib *rtm, gchar* timeline,
+                                     RtmTask *task, gchar *repeat,
+                                     GCancellable *cancellable,
+                                     GAsyncReadyCallback callback,
+                                     gpointer user_data);
+
+gchar *
+rtm_glib_tasks_set_recurrence_finish (RtmGlib *rtm, GAsyncResult *result,
+                                      GError **error);
+
 gchar *
 rtm_glib_tasks_set_estimate (RtmGlib *rtm, gchar* timeline, RtmTask *task,
                              gchar *estimate, GError **error);
 
+void
+rtm_glib_tasks_set_estimate_async (RtmGlib *rtm, gchar* timeline,
+                                   RtmTask *task, gchar *estimate,
+                                   GCancellable *cancellable,
+                                   GAsyncReadyCallback callback,
+                                   gpointer user_data);
+
+gchar *
+rtm_glib_tasks_set_estimate_finish (RtmGlib *rtm, GAsyncResult *result,
+                                    GError **error);
+
 gchar *
 rtm_glib_tasks_set_due_date (RtmGlib *rtm, gchar* timeline, RtmTask *task,
                              gchar *due, gboolean has_due_time,
                              gboolean parse, GError **error);
 
+void
+rtm_glib_tasks_set_due_date_async (RtmGlib *rtm, gchar* timeline,
+                                   RtmTask *task, gchar *due,
+                                   gboolean has_due_time, gboolean parse,
+                                   GCancellable *cancellable,
+                                   GAsyncReadyCallback callback,
+                                   gpointer user_data);
+
+gchar *
+rtm_glib_tasks_set_due_date_finish (RtmGlib *rtm, GAsyncResult *result,
+                                    GError **error);
+
 GList *
 rtm_glib_time_zones_get_list (RtmGlib *rtm, GError **error);
 
+void
+rtm_glib_time_zones_get_list_async (RtmGlib *rtm, GCancellable *cancellable,
+                                    GAsyncReadyCallback callback,
+                                    gpointer user_data);
+
+GList *
+rtm_glib_time_zones_get_list_finish (RtmGlib *rtm, GAsyncResult *result,
+                                     GError **error);
+
 gchar *
 rtm_glib_time_parse (RtmGlib *rtm, gchar* text, gchar *timezone_id,
                      gboolean dateformat, GError **error);
 
+void
+rtm_glib_time_parse_async (RtmGlib *rtm, gchar* text, gchar *timezone_name,
+                           gboolean dateformat, GCancellable *cancellable,
+                           GAsyncReadyCallback callback, gpointer user_data);
+
+gchar *
+rtm_glib_time_parse_finish (RtmGlib *rtm, GAsyncResult *result, GError **error);
+
 gchar *
 rtm_glib_time_convert (RtmGlib *rtm, gchar* to_timezone_id,
                        gchar *from_timezone_id, gchar *time, GError **error);
 
+void
+rtm_glib_time_convert_async (RtmGlib *rtm, gchar* to_timezone_name,
+                             gchar *from_timezone_name, gchar *time,
+                             GCancellable *cancellable,
+                             GAsyncReadyCallback callback, gpointer user_data);
+
+gchar *
+rtm_glib_time_convert_finish (RtmGlib *rtm, GAsyncResult *result,
+                              GError **error);
+
 GList *
 rtm_glib_contacts_get_list (RtmGlib *rtm, GError **error);
 
+void
+rtm_glib_contacts_get_list_async (RtmGlib *rtm, GCancellable *cancellable,
+                                  GAsyncReadyCallback callback,
+                                  gpointer user_data);
+
+GList *
+rtm_glib_contacts_get_list_finish (RtmGlib *rtm, GAsyncResult *result,
+                                   GError **error);
+
 RtmContact *
 rtm_glib_contacts_add (RtmGlib *rtm, gchar* timeline, gchar *contact,
                        GError **error);
 
+void
+rtm_glib_contacts_add_async (RtmGlib *rtm, gchar* timeline, gchar *contact,
+                             GCancellable *cancellable,
+                             GAsyncReadyCallback callback, gpointer user_data);
+
+RtmContact *
+rtm_glib_contacts_add_finish (RtmGlib *rtm, GAsyncResult *result,
+                              GError **error);
+
 gchar *
 rtm_glib_contacts_delete (RtmGlib *rtm, gchar* timeline, RtmContact *contact,
                           GError **error);
 
+void
+rtm_glib_contacts_delete_async (RtmGlib *rtm, gchar* timeline,
+                                RtmContact *contact, GCancellable *cancellable,
+                                GAsyncReadyCallback callback,
+                                gpointer user_data);
+
+gchar *
+rtm_glib_contacts_delete_finish (RtmGlib *rtm, GAsyncResult *result,
+                                 GError **error);
+
 #endif /* __RTM_GLIB_H__ */
@@ -0,0 +1,254 @@
+/*
+ * rtm-inflater.c: Incremental decoder of compressed responses
+ *
+ * Copyright (C) 2009 Manuel Rego Casasnovas <mrego@igalia.com>
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301 USA
+ */
+
+/*
+ * Decodes the gzip and deflate content codings of HTTP responses with a
+ * #GZlibDecompressor. The body can be fed in as many chunks as it arrives,
+ * only a small fixed buffer is used besides the output.
+ *
+ * The first two bytes of the body decide the format, whatever the header
+ * says: the gzip magic number, or a valid zlib header. Anything else is
+ * copied as is, as the HTTP session could have already decoded it and the
+ * body is then plain XML or JSON.
+ */
+
+#include <gio/gio.h>
+#include <rtm-inflater.h>
+
+#define RTM_INFLATER_BUFFER_SIZE 16384
+
+/* Bytes of the body needed to tell its format */
+#define RTM_INFLATER_HEADER_SIZE 2
+
+struct _RtmInflater {
+        guchar header[RTM_INFLATER_HEADER_SIZE];
+        gsize header_length;
+        gboolean started;
+        GConverter *converter;
+};
+
+/**
+ * rtm_inflater_new:
+ * @content_encoding: the value of the Content-Encoding header, or %NULL.
+ *
+ * Creates a decoder for a response body with @content_encoding.
+ *
+ * Returns: a new #RtmInflater, or %NULL if the body is not compressed.
+ */
+RtmInflater *
+rtm_inflater_new (const gchar *content_encoding)
+{
+        if (content_encoding == NULL) {
+                return NULL;
+        }
+
+        if (g_ascii_strcasecmp (content_encoding, "gzip") != 0 &&
+            g_ascii_strcasecmp (content_encoding, "x-gzip") != 0 &&
+            g_ascii_strcasecmp (content_encoding, "deflate") != 0) {
+                return NULL;
+        }
+
+        return rtm_inflater_new_any ();
+}
+
+/**
+ * rtm_inflater_new_any:
+ *
+ * Creates a decoder for a response body whose Content-Encoding is not known
+ * yet, as the format is told from the body itself.
+ *
+ * Returns: a new #RtmInflater.
+ */
+RtmInflater *
+rtm_inflater_new_any (void)
+{
+        return g_slice_new0 (RtmInflater);
+}
+
+/**
+ * rtm_inflater_start:
+ * @inflater: a #RtmInflater.
+ *
+ * Chooses the decoder from the first bytes of the body: 0x1f 0x8b for gzip,
+ * or a zlib header, whose compression method is 8 and whose two bytes are
+ * a multiple of 31. Otherwise the body is not compressed.
+ */
+static void
+rtm_inflater_start (RtmInflater *inflater)
+{
+        GZlibCompressorFormat format;
+        guchar cmf, flg;
+
+        inflater->started = TRUE;
+
+        if (inflater->header_length < RTM_INFLATER_HEADER_SIZE) {
+                return;
+        }
+
+        cmf = inflater->header[0];
+        flg = inflater->header[1];
+
+        if (cmf == 0x1f && flg == 0x8b) {
+                format = G_ZLIB_COMPRESSOR_FORMAT_GZIP;
+        } else if ((cmf & 0x0f) == 8 && (cmf >> 4) <= 7 &&
+                   ((cmf << 8) | flg) % 31 == 0) {
+                format = G_ZLIB_COMPRESSOR_FORMAT_ZLIB;
+        } else {
+                /* Already decoded */
+                return;
+        }
+
+        inflater->converter = G_CONVERTER (g_zlib_decompressor_new (format));
+}
+
+static gboolean
+rtm_inflater_convert (RtmInflater *inflater, const gchar *data, gsize length,
+                      GConverterFlags flags, GByteArray *output,
+                      GError **error)
+{
+        if (inflater->converter == NULL) {
+                g_byte_array_append (output, (guint8 *) data, length);
+                return TRUE;
+        }
+
+        gchar buffer[RTM_INFLATER_BUFFER_SIZE];
+        gsize bytes_read, bytes_written;
+        GConverterResult result;
+
+        do {
+                result = g_converter_convert (inflater->converter,
+                                              data, length,
+                                              buffer, sizeof (buffer),
+                                              flags,
+                                              &bytes_read, &bytes_written,
+                                              error);
+                if (result == G_CONVERTER_ERROR) {
+                        return FALSE;
+                }
+
+                g_byte_array_append (output, (guint8 *) buffer, bytes_written);
+                data += bytes_read;
+                length -= bytes_read;
+        } while (result != G_CONVERTER_FINISHED &&
+                 (length > 0 || (flags & G_CONVERTER_INPUT_AT_END)));
+
+        return TRUE;
+}
+
+/**
+ * rtm_inflater_feed:
+ * @inflater: a #RtmInflater.
+ * @data: the next chunk of the response body.
+ * @length: the length of @data.
+ * @output: a #GByteArray where the decoded data is appended.
+ * @error: location to store #GError or %NULL.
+ *
+ * Decodes a chunk of the response body.
+ *
+ * Returns: %TRUE if the chunk was decoded, %FALSE if the body is corrupt.
+ */
+gboolean
+rtm_inflater_feed (RtmInflater *inflater, const gchar *data, gsize length,
+                   GByteArray *output, GError **error)
+{
+        g_assert (inflater != NULL);
+        g_assert (output != NULL);
+
+        if (length == 0) {
+                return TRUE;
+        }
+
+        /* The header can come split across chunks */
+        if (!inflater->started) {
+                while (length > 0 &&
+                       inflater->header_length < RTM_INFLATER_HEADER_SIZE) {
+                        inflater->header[inflater->header_length++] = *data;
+                        data++;
+                        length--;
+                }
+                if (inflater->header_length < RTM_INFLATER_HEADER_SIZE) {
+                        return TRUE;
+                }
+
+                rtm_inflater_start (inflater);
+                if (!rtm_inflater_convert (inflater,
+                                           (const gchar *) inflater->header,
+                                           inflater->header_length,
+                                           G_CONVERTER_NO_FLAGS, output,
+                                           error)) {
+                        return FALSE;
+                }
+        }
+
+        if (length == 0) {
+                return TRUE;
+        }
+
+        return rtm_inflater_convert (inflater, data, length,
+                                     G_CONVERTER_NO_FLAGS, output, error);
+}
+
+/**
+ * rtm_inflater_finish:
+ * @inflater: a #RtmInflater.
+ * @output: a #GByteArray where the decoded data is appended.
+ * @error: location to store #GError or %NULL.
+ *
+ * Flushes the data still buffered once the whole body has been fed.
+ *
+ * Returns: %TRUE on success, %FALSE if the body is truncated.
+ */
+gboolean
+rtm_inflater_finish (RtmInflater *inflater, GByteArray *output,
+                     GError **error)
+{
+        g_assert (inflater != NULL);
+        g_assert (output != NULL);
+
+        /* A body shorter than the header is not compressed */
+        if (!inflater->started) {
+                rtm_inflater_start (inflater);
+                g_byte_array_append (output, inflater->header,
+                                     inflater->header_length);
+        }
+
+        if (inflater->converter == NULL) {
+                return TRUE;
+        }
+
+        return rtm_inflater_convert (inflater, NULL, 0,
+                                     G_CONVERTER_INPUT_AT_END, output, error);
+}
+
+/**
+ * rtm_inflater_free:
+ * @inflater: a #RtmInflater.
+ *
+ * Frees @inflater.
+ */
+void
+rtm_inflater_free (RtmInflater *inflater)
+{
+        if (inflater->converter) {
+                g_object_unref (inflater->converter);
+        }
+
+        g_slice_free (RtmInflater, inflater);
+}
@@ -0,0 +1,53 @@
+/*
+ * rtm-inflater.h: Incremental decoder of compressed responses
+ *
+ * Copyright (C) 2009 Manuel Rego Casasnovas <mrego@igalia.com>
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301 USA
+ */
+
+#ifndef __RTM_INFLATER_H__
+#define __RTM_INFLATER_H__
+
+#include <glib.h>
+
+
+G_BEGIN_DECLS
+
+/* Value of the Accept-Encoding header sent with every call */
+#define RTM_INFLATER_ACCEPT_ENCODING "gzip, deflate"
+
+typedef struct _RtmInflater RtmInflater;
+
+RtmInflater *
+rtm_inflater_new (const gchar *content_encoding);
+
+RtmInflater *
+rtm_inflater_new_any (void);
+
+gboolean
+rtm_inflater_feed (RtmInflater *inflater, const gchar *data, gsize length,
+                   GByteArray *output, GError **error);
+
+gboolean
+rtm_inflater_finish (RtmInflater *inflater, GByteArray *output,
+                     GError **error);
+
+void
+rtm_inflater_free (RtmInflater *inflater);
+
+G_END_DECLS
+
+#endif /* __RTM_INFLATER_H__ */
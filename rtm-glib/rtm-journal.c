@@ -0,0 +1,1058 @@
+/*
+ * rtm-journal.c: On-disk journal of modifications replayed when online
+ *
+ * Copyright (C) 2009 Manuel Rego Casasnovas <mrego@igalia.com>
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301 USA
+ */
+
+/**
+ * SECTION:rtm-journal
+ * @short_description: On-disk journal of modifications replayed when online
+ *
+ * #RtmJournal writes each modification appended to a file before sending
+ * it, so it is not lost if Remember The Milk can not be reached. The
+ * modifications are sent one after another in append order. When one fails
+ * because the service is unreachable, the journal goes offline and tries
+ * again when the network changes or after #RtmJournal:retry_interval
+ * seconds, starting from the same modification. Modifications rejected by
+ * the service are dropped and reported to their callback.
+ *
+ * The file is only appended to. Records are written and synced to disk in
+ * batches, every #RtmJournal:sync_interval milliseconds, right away with
+ * rtm_journal_sync(), or before the first modification not synced yet is
+ * sent, so the ones appended while another is being sent share a sync.
+ * If the file can not be written, the journal goes offline. Acknowledged
+ * modifications are removed by rewriting the file once enough of them pile
+ * up. A modification acknowledged just before a crash could be sent again
+ * when the journal is opened.
+ *
+ * The authentication token is not written to the file, the current one of
+ * the #RtmGlib is used when sending. A timeline parameter is replaced by a
+ * timeline created when replaying, as the original one could be expired.
+ *
+ * The journal works in the thread-default main context of the thread that
+ * created it, where a main loop must be running.
+ */
+
+#include <errno.h>
+#include <fcntl.h>
+#include <stdio.h>
+#include <string.h>
+#include <unistd.h>
+#include <gio/gio.h>
+#include <rtm-journal.h>
+#include <rtm-error.h>
+#include <rtm-glib-private.h>
+#include <rtm-util.h>
+
+#define RTM_JOURNAL_GET_PRIVATE(obj) (G_TYPE_INSTANCE_GET_PRIVATE (         \
+                                           (obj), RTM_TYPE_JOURNAL, RtmJournalPrivate))
+
+#define RTM_JOURNAL_DEFAULT_SYNC_INTERVAL 100
+#define RTM_JOURNAL_DEFAULT_RETRY_INTERVAL 30
+
+/* Records written right away instead of waiting for the sync interval */
+#define RTM_JOURNAL_MAX_BUFFER (64 * 1024)
+
+/* Acknowledgements in the file before it is compacted */
+#define RTM_JOURNAL_COMPACT_THRESHOLD 256
+
+struct _RtmJournalPrivate {
+        RtmGlib *rtm;
+        gchar *path;
+        gint fd;
+        GQueue *entries;
+        guint64 next_seq;
+        guint64 unsynced_seq;
+        guint n_acks;
+        GString *buffer;
+        GSource *sync_source;
+        guint sync_interval;
+        GSource *retry_source;
+        guint retry_interval;
+        gchar *timeline;
+        gboolean replaying;
+        gboolean offline;
+        GNetworkMonitor *monitor;
+        gulong network_changed_id;
+        GMainContext *context;
+};
+
+enum {
+        PROP_0,
+
+        PROP_RTM,
+        PROP_PATH,
+        PROP_SYNC_INTERVAL,
+        PROP_RETRY_INTERVAL,
+};
+
+typedef struct {
+        guint64 seq;
+        gchar *method;
+        gchar **params;
+        RtmJournalCallback callback;
+        gpointer user_data;
+} RtmJournalEntry;
+
+G_DEFINE_TYPE (RtmJournal, rtm_journal, G_TYPE_OBJECT);
+
+static void
+rtm_journal_entry_free (RtmJournalEntry *entry)
+{
+        g_free (entry->method);
+        g_strfreev (entry->params);
+
+        g_slice_free (RtmJournalEntry, entry);
+}
+
+static void
+rtm_journal_get_property (GObject *gobject, guint prop_id, GValue *value,
+                          GParamSpec *pspec)
+{
+        RtmJournalPrivate *priv = RTM_JOURNAL_GET_PRIVATE (RTM_JOURNAL (gobject));
+
+        switch (prop_id) {
+        case PROP_RTM:
+                g_value_set_object (value, priv->rtm);
+                break;
+
+        case PROP_PATH:
+                g_value_set_string (value, priv->path);
+                break;
+
+        case PROP_SYNC_INTERVAL:
+                g_value_set_uint (value, priv->sync_interval);
+                break;
+
+        case PROP_RETRY_INTERVAL:
+                g_value_set_uint (value, priv->retry_interval);
+                break;
+
+        default:
+                G_OBJECT_WARN_INVALID_PROPERTY_ID (gobject, prop_id,
+                                                   pspec);
+                break;
+        }
+}
+
+static void
+rtm_journal_set_property (GObject *gobject, guint prop_id,
+                          const GValue *value, GParamSpec *pspec)
+{
+        RtmJournalPrivate *priv = RTM_JOURNAL_GET_PRIVATE (RTM_JOURNAL (gobject));
+
+        switch (prop_id) {
+        case PROP_RTM:
+                priv->rtm = g_value_dup_object (value);
+                break;
+
+        case PROP_PATH:
+                g_free (priv->path);
+                priv->path = g_value_dup_string (value);
+                break;
+
+        case PROP_SYNC_INTERVAL:
+                priv->sync_interval = g_value_get_uint (value);
+                break;
+
+        case PROP_RETRY_INTERVAL:
+                priv->retry_interval = g_value_get_uint (value);
+                break;
+
+        default:
+                G_OBJECT_WARN_INVALID_PROPERTY_ID (gobject, prop_id,
+                                                   pspec);
+                break;
+        }
+}
+
+static void
+rtm_journal_dispose (GObject *gobject)
+{
+        RtmJournal *journal = RTM_JOURNAL (gobject);
+        RtmJournalPrivate *priv = RTM_JOURNAL_GET_PRIVATE (journal);
+
+        /* Calls in flight keep a reference to the journal, so the only thing
+         * left to do is writing the last records */
+        if (priv->fd >= 0) {
+                rtm_journal_sync (journal, NULL);
+        }
+
+        if (priv->retry_source) {
+                g_source_destroy (priv->retry_source);
+                g_source_unref (priv->retry_source);
+                priv->retry_source = NULL;
+        }
+
+        if (priv->monitor) {
+                g_signal_handler_disconnect (priv->monitor,
+                                             priv->network_changed_id);
+                g_object_unref (priv->monitor);
+                priv->monitor = NULL;
+        }
+
+        if (priv->rtm) {
+                g_object_unref (priv->rtm);
+                priv->rtm = NULL;
+        }
+
+        G_OBJECT_CLASS (rtm_journal_parent_class)->dispose (gobject);
+}
+
+static void
+rtm_journal_finalize (GObject *gobject)
+{
+        RtmJournalPrivate *priv = RTM_JOURNAL_GET_PRIVATE (RTM_JOURNAL (gobject));
+
+        if (priv->fd >= 0) {
+                close (priv->fd);
+        }
+        g_free (priv->path);
+        g_free (priv->timeline);
+        g_queue_free_full (priv->entries,
+                           (GDestroyNotify) rtm_journal_entry_free);
+        g_string_free (priv->buffer, TRUE);
+        g_main_context_unref (priv->context);
+
+        G_OBJECT_CLASS (rtm_journal_parent_class)->finalize (gobject);
+}
+
+static void
+rtm_journal_class_init (RtmJournalClass *klass)
+{
+        GObjectClass *gobject_class = G_OBJECT_CLASS (klass);
+
+        g_type_class_add_private (klass, sizeof (RtmJournalPrivate));
+
+        gobject_class->get_property = rtm_journal_get_property;
+        gobject_class->set_property = rtm_journal_set_property;
+        gobject_class->dispose = rtm_journal_dispose;
+        gobject_class->finalize = rtm_journal_finalize;
+
+        g_object_class_install_property (
+                gobject_class,
+                PROP_RTM,
+                g_param_spec_object (
+                        "rtm",
+                        "Rtm",
+                        "The RtmGlib object used to call the methods",
+                        RTM_TYPE_GLIB,
+                        G_PARAM_READWRITE | G_PARAM_CONSTRUCT_ONLY));
+
+        g_object_class_install_property (
+                gobject_class,
+                PROP_PATH,
+                g_param_spec_string (
+                        "path",
+                        "Path",
+                        "The file where the modifications are written",
+                        NULL,
+                        G_PARAM_READWRITE | G_PARAM_CONSTRUCT_ONLY));
+
+        g_object_class_install_property (
+                gobject_class,
+                PROP_SYNC_INTERVAL,
+                g_param_spec_uint (
+                        "sync_interval",
+                        "Sync Interval",
+                        "Milliseconds the records are batched before being "
+                        "synced to disk",
+                        0,
+                        G_MAXUINT,
+                        RTM_JOURNAL_DEFAULT_SYNC_INTERVAL,
+                        G_PARAM_READWRITE | G_PARAM_CONSTRUCT));
+
+        g_object_class_install_property (
+                gobject_class,
+                PROP_RETRY_INTERVAL,
+                g_param_spec_uint (
+                        "retry_interval",
+                        "Retry Interval",
+                        "Seconds to wait before trying again when offline",
+                        1,
+                        G_MAXUINT,
+                        RTM_JOURNAL_DEFAULT_RETRY_INTERVAL,
+                        G_PARAM_READWRITE | G_PARAM_CONSTRUCT));
+
+}
+
+static void
+rtm_journal_init (RtmJournal *journal)
+{
+        journal->priv = RTM_JOURNAL_GET_PRIVATE (journal);
+
+        journal->priv->fd = -1;
+        journal->priv->entries = g_queue_new ();
+        journal->priv->next_seq = 1;
+        journal->priv->unsynced_seq = 1;
+        journal->priv->buffer = g_string_new (NULL);
+        journal->priv->context = g_main_context_ref_thread_default ();
+}
+
+static void
+rtm_journal_set_io_error (GError **error, const gchar *path, gint errsv)
+{
+        g_set_error (error, G_IO_ERROR, g_io_error_from_errno (errsv),
+                     "Error writing journal %s: %s", path,
+                     g_strerror (errsv));
+}
+
+/**
+ * rtm_journal_write_all:
+ * @fd: a file descriptor.
+ * @data: the data to write.
+ * @length: the length of @data.
+ * @bytes_written: location to store the number of bytes written, even on
+ * failure.
+ *
+ * Writes the whole @data to @fd.
+ *
+ * Returns: 0 on success, or the errno of the failure.
+ */
+static gint
+rtm_journal_write_all (gint fd, const gchar *data, gsize length,
+                       gsize *bytes_written)
+{
+        gssize written;
+
+        *bytes_written = 0;
+        while (length > 0) {
+                written = write (fd, data, length);
+                if (written < 0) {
+                        if (errno == EINTR) {
+                                continue;
+                        }
+                        return errno;
+                }
+                data += written;
+                length -= written;
+                *bytes_written += written;
+        }
+
+        return 0;
+}
+
+/**
+ * rtm_journal_encode_entry:
+ * @entry: a #RtmJournalEntry.
+ * @record: a #GString to append the record to.
+ *
+ * Appends the record of @entry, a line with its sequence number, the method
+ * name and the parameters encoded as a query string.
+ */
+static void
+rtm_journal_encode_entry (RtmJournalEntry *entry, GString *record)
+{
+        gchar *escaped;
+        guint i;
+
+        g_string_append_printf (record, "+ %" G_GUINT64_FORMAT " %s ",
+                                entry->seq, entry->method);
+
+        for (i = 0; entry->params[i] != NULL; i += 2) {
+                if (i > 0) {
+                        g_string_append_c (record, '&');
+                }
+                escaped = g_uri_escape_string (entry->params[i], NULL, FALSE);
+                g_string_append (record, escaped);
+                g_free (escaped);
+
+                g_string_append_c (record, '=');
+
+                escaped = g_uri_escape_string (entry->params[i + 1], NULL,
+                                               FALSE);
+                g_string_append (record, escaped);
+                g_free (escaped);
+        }
+
+        g_string_append_c (record, '\n');
+}
+
+/**
+ * rtm_journal_decode_entry:
+ * @line: a record of an appended modification, without the leading "+ ".
+ *
+ * Parses the record written by rtm_journal_encode_entry().
+ *
+ * Returns: a new #RtmJournalEntry, or %NULL if @line is corrupt.
+ */
+static RtmJournalEntry *
+rtm_journal_decode_entry (const gchar *line)
+{
+        RtmJournalEntry *entry;
+        GPtrArray *params;
+        gchar **fields, **pairs, *value;
+        guint i;
+
+        fields = g_strsplit (line, " ", 3);
+        if (g_strv_length (fields) != 3) {
+                g_strfreev (fields);
+                return NULL;
+        }
+
+        params = g_ptr_array_new ();
+        pairs = g_strsplit (fields[2], "&", -1);
+        for (i = 0; pairs[i] != NULL && pairs[i][0] != '\0'; i++) {
+                value = strchr (pairs[i], '=');
+                if (value == NULL) {
+                        continue;
+                }
+                *value++ = '\0';
+                g_ptr_array_add (params, g_uri_unescape_string (pairs[i],
+                                                                NULL));
+                g_ptr_array_add (params, g_uri_unescape_string (value, NULL));
+        }
+        g_ptr_array_add (params, NULL);
+        g_strfreev (pairs);
+
+        entry = g_slice_new0 (RtmJournalEntry);
+        entry->seq = g_ascii_strtoull (fields[0], NULL, 10);
+        entry->method = g_strdup (fields[1]);
+        entry->params = (gchar **) g_ptr_array_free (params, FALSE);
+
+        g_strfreev (fields);
+
+        return entry;
+}
+
+/**
+ * rtm_journal_load:
+ * @journal: a #RtmJournal object.
+ * @error: location to store #GError or %NULL.
+ *
+ * Reads the modifications not acknowledged yet from the file, if it
+ * exists. A last line without end, interrupted by a crash, is ignored.
+ *
+ * Returns: %TRUE on success.
+ */
+static gboolean
+rtm_journal_load (RtmJournal *journal, GError **error)
+{
+        RtmJournalPrivate *priv = journal->priv;
+        RtmJournalEntry *entry;
+        GList *item;
+        gchar *contents, **lines;
+        guint64 seq;
+        guint i, n_lines;
+        GError *tmp_error = NULL;
+
+        if (!g_file_get_contents (priv->path, &contents, NULL, &tmp_error)) {
+                if (g_error_matches (tmp_error, G_FILE_ERROR,
+                                     G_FILE_ERROR_NOENT)) {
+                        g_error_free (tmp_error);
+                        return TRUE;
+                }
+                g_propagate_error (error, tmp_error);
+                return FALSE;
+        }
+
+        lines = g_strsplit (contents, "\n", -1);
+        n_lines = g_strv_length (lines);
+        g_free (contents);
+
+        for (i = 0; i + 1 < n_lines; i++) {
+                if (g_str_has_prefix (lines[i], "+ ")) {
+                        entry = rtm_journal_decode_entry (lines[i] + 2);
+                        if (entry == NULL) {
+                                continue;
+                        }
+                        g_queue_push_tail (priv->entries, entry);
+                        priv->next_seq = MAX (priv->next_seq, entry->seq + 1);
+                } else if (g_str_has_prefix (lines[i], "- ")) {
+                        seq = g_ascii_strtoull (lines[i] + 2, NULL, 10);
+                        /* Usually the first one */
+                        for (item = priv->entries->head; item;
+                             item = item->next) {
+                                entry = item->data;
+                                if (entry->seq == seq) {
+                                        g_queue_delete_link (priv->entries,
+                                                             item);
+                                        rtm_journal_entry_free (entry);
+                                        priv->n_acks++;
+                                        break;
+                                }
+                        }
+                }
+        }
+
+        g_strfreev (lines);
+
+        DEBUG_PRINT ("rtm_journal: %u modifications pending in %s",
+                     g_queue_get_length (priv->entries), priv->path);
+
+        return TRUE;
+}
+
+/**
+ * rtm_journal_compact:
+ * @journal: a #RtmJournal object.
+ * @error: location to store #GError or %NULL.
+ *
+ * Rewrites the file of @journal with only the modifications not
+ * acknowledged yet. The new file is synced to disk before it replaces the
+ * old one, so a crash leaves one of them complete.
+ *
+ * Returns: %TRUE on success.
+ */
+gboolean
+rtm_journal_compact (RtmJournal *journal, GError **error)
+{
+        g_return_val_if_fail (journal != NULL, FALSE);
+
+        RtmJournalPrivate *priv = journal->priv;
+        GString *contents;
+        GList *item;
+        gchar *tmp_path;
+        gsize written;
+        gint fd, errsv;
+
+        if (priv->fd >= 0 && !rtm_journal_sync (journal, error)) {
+                return FALSE;
+        }
+
+        contents = g_string_new (NULL);
+        for (item = priv->entries->head; item; item = item->next) {
+                rtm_journal_encode_entry (item->data, contents);
+        }
+
+        tmp_path = g_strconcat (priv->path, ".tmp", NULL);
+        fd = open (tmp_path, O_WRONLY | O_CREAT | O_TRUNC, 0600);
+        errsv = fd < 0 ? errno : 0;
+        if (errsv == 0) {
+                errsv = rtm_journal_write_all (fd, contents->str,
+                                               contents->len, &written);
+        }
+        if (errsv == 0 && fsync (fd) < 0) {
+                errsv = errno;
+        }
+        if (fd >= 0 && close (fd) < 0 && errsv == 0) {
+                errsv = errno;
+        }
+        if (errsv == 0 && rename (tmp_path, priv->path) < 0) {
+                errsv = errno;
+        }
+        g_string_free (contents, TRUE);
+
+        if (errsv != 0) {
+                rtm_journal_set_io_error (error, tmp_path, errsv);
+                unlink (tmp_path);
+                g_free (tmp_path);
+                return FALSE;
+        }
+        g_free (tmp_path);
+
+        if (priv->fd >= 0) {
+                close (priv->fd);
+        }
+        priv->fd = open (priv->path, O_WRONLY | O_APPEND | O_CREAT, 0600);
+        if (priv->fd < 0) {
+                rtm_journal_set_io_error (error, priv->path, errno);
+                return FALSE;
+        }
+        priv->n_acks = 0;
+        priv->unsynced_seq = priv->next_seq;
+
+        return TRUE;
+}
+
+/**
+ * rtm_journal_new:
+ * @rtm: a #RtmGlib object already authenticated, used to call the methods.
+ * @path: the file where the modifications are written.
+ * @error: location to store #GError or %NULL.
+ *
+ * Creates a new instance of this class, reading the modifications left
+ * pending in @path by a previous one. Call rtm_journal_replay() to send
+ * them.
+ *
+ * Returns: a new #RtmJournal object, or %NULL if @path can not be used.
+ */
+RtmJournal *
+rtm_journal_new (RtmGlib *rtm, const gchar *path, GError **error)
+{
+        g_return_val_if_fail (rtm != NULL, NULL);
+        g_return_val_if_fail (path != NULL, NULL);
+
+        RtmJournal *journal;
+
+        journal = g_object_new (RTM_TYPE_JOURNAL,
+                                "rtm", rtm,
+                                "path", path,
+                                NULL);
+
+        /* Compacting drops a record interrupted by a crash, so it is not
+         * followed by new ones, and opens the file for appending */
+        if (!rtm_journal_load (journal, error) ||
+            !rtm_journal_compact (journal, error)) {
+                g_object_unref (journal);
+                return NULL;
+        }
+
+        return journal;
+}
+
+/**
+ * rtm_journal_sync:
+ * @journal: a #RtmJournal object.
+ * @error: location to store #GError or %NULL.
+ *
+ * Writes the records batched so far and syncs the file to disk.
+ *
+ * Returns: %TRUE on success.
+ */
+gboolean
+rtm_journal_sync (RtmJournal *journal, GError **error)
+{
+        g_return_val_if_fail (journal != NULL, FALSE);
+
+        RtmJournalPrivate *priv = journal->priv;
+        gsize written;
+        gint errsv;
+
+        if (priv->sync_source) {
+                g_source_destroy (priv->sync_source);
+                g_source_unref (priv->sync_source);
+                priv->sync_source = NULL;
+        }
+
+        if (priv->buffer->len == 0) {
+                return TRUE;
+        }
+
+        errsv = rtm_journal_write_all (priv->fd, priv->buffer->str,
+                                       priv->buffer->len, &written);
+
+        /* What reached the file is not written again on the next try */
+        g_string_erase (priv->buffer, 0, written);
+
+        if (errsv == 0 && fsync (priv->fd) < 0) {
+                errsv = errno;
+        }
+        if (errsv != 0) {
+                rtm_journal_set_io_error (error, priv->path, errsv);
+                return FALSE;
+        }
+
+        priv->unsynced_seq = priv->next_seq;
+
+        return TRUE;
+}
+
+static gboolean
+rtm_journal_sync_cb (gpointer user_data)
+{
+        RtmJournal *journal = RTM_JOURNAL (user_data);
+        GError *error = NULL;
+
+        if (!rtm_journal_sync (journal, &error)) {
+                g_warning ("%s", error->message);
+                g_error_free (error);
+        }
+
+        return FALSE;
+}
+
+/**
+ * rtm_journal_schedule_sync:
+ * @journal: a #RtmJournal object.
+ *
+ * Syncs the records batched at the end of the sync interval, or right away
+ * if too many are waiting.
+ */
+static void
+rtm_journal_schedule_sync (RtmJournal *journal)
+{
+        RtmJournalPrivate *priv = journal->priv;
+
+        if (priv->buffer->len >= RTM_JOURNAL_MAX_BUFFER) {
+                rtm_journal_sync_cb (journal);
+                return;
+        }
+
+        if (priv->sync_source == NULL) {
+                priv->sync_source = g_timeout_source_new (priv->sync_interval);
+                g_source_set_callback (priv->sync_source,
+                                       rtm_journal_sync_cb, journal, NULL);
+                g_source_attach (priv->sync_source, priv->context);
+        }
+}
+
+/**
+ * rtm_journal_acknowledge:
+ * @journal: a #RtmJournal object.
+ * @entry: the #RtmJournalEntry the service answered.
+ *
+ * Records that @entry must not be sent again, compacting the file if there
+ * are enough acknowledgements.
+ */
+static void
+rtm_journal_acknowledge (RtmJournal *journal, RtmJournalEntry *entry)
+{
+        RtmJournalPrivate *priv = journal->priv;
+        GError *error = NULL;
+
+        g_string_append_printf (priv->buffer, "- %" G_GUINT64_FORMAT "\n",
+                                entry->seq);
+        priv->n_acks++;
+
+        if (priv->n_acks >= RTM_JOURNAL_COMPACT_THRESHOLD &&
+            priv->n_acks >= g_queue_get_length (priv->entries)) {
+                if (!rtm_journal_compact (journal, &error)) {
+                        g_warning ("%s", error->message);
+                        g_error_free (error);
+                }
+                return;
+        }
+
+        rtm_journal_schedule_sync (journal);
+}
+
+/**
+ * rtm_journal_build_params:
+ * @journal: a #RtmJournal object.
+ * @entry: a #RtmJournalEntry.
+ *
+ * Gets the parameters to send @entry, with the current authentication token
+ * and timeline.
+ *
+ * Returns: a %NULL-terminated array alternating names and values.
+ */
+static gchar **
+rtm_journal_build_params (RtmJournal *journal, RtmJournalEntry *entry)
+{
+        GPtrArray *params;
+        gchar *auth_token = NULL;
+        guint i;
+
+        g_object_get (journal->priv->rtm, "auth_token", &auth_token, NULL);
+
+        params = g_ptr_array_new ();
+        g_ptr_array_add (params, g_strdup ("auth_token"));
+        g_ptr_array_add (params, auth_token);
+
+        for (i = 0; entry->params[i] != NULL; i += 2) {
+                g_ptr_array_add (params, g_strdup (entry->params[i]));
+                if (strcmp (entry->params[i], "timeline") == 0) {
+                        g_ptr_array_add (params,
+                                         g_strdup (journal->priv->timeline));
+                } else {
+                        g_ptr_array_add (params,
+                                         g_strdup (entry->params[i + 1]));
+                }
+        }
+        g_ptr_array_add (params, NULL);
+
+        return (gchar **) g_ptr_array_free (params, FALSE);
+}
+
+/**
+ * rtm_journal_must_keep:
+ * @error: the #GError of a failed call.
+ *
+ * Checks if the modification could succeed later, because the service was
+ * not reached or did not accept the credentials.
+ *
+ * Returns: %TRUE if the modification must be kept.
+ */
+static gboolean
+rtm_journal_must_keep (const GError *error)
+{
+        if (rtm_error_is_transient (error)) {
+                return TRUE;
+        }
+
+        return error->domain == RTM_ERROR_DOMAIN &&
+                (error->code == RTM_ERROR_INVALID_SIGNATURE ||
+                 error->code == RTM_ERROR_LOGIN_FAILED ||
+                 error->code == RTM_ERROR_INVALID_API_KEY);
+}
+
+static gboolean
+rtm_journal_retry_cb (gpointer user_data)
+{
+        RtmJournal *journal = RTM_JOURNAL (user_data);
+
+        g_source_unref (journal->priv->retry_source);
+        journal->priv->retry_source = NULL;
+
+        rtm_journal_replay (journal);
+
+        return FALSE;
+}
+
+/**
+ * rtm_journal_go_offline:
+ * @journal: a #RtmJournal object.
+ * @error: the #GError that stopped the replay.
+ *
+ * Stops sending modifications until the network changes or the retry
+ * interval is over.
+ */
+static void
+rtm_journal_go_offline (RtmJournal *journal, const GError *error)
+{
+        RtmJournalPrivate *priv = journal->priv;
+
+        DEBUG_PRINT ("rtm_journal: offline, %u modifications pending: %s",
+                     g_queue_get_length (priv->entries), error->message);
+
+        priv->replaying = FALSE;
+        priv->offline = TRUE;
+
+        /* It could be expired when the service is reached again */
+        g_free (priv->timeline);
+        priv->timeline = NULL;
+
+        if (priv->retry_source == NULL) {
+                priv->retry_source = g_timeout_source_new_seconds (
+                        priv->retry_interval);
+                g_source_set_callback (priv->retry_source,
+                                       rtm_journal_retry_cb, journal, NULL);
+                g_source_attach (priv->retry_source, priv->context);
+        }
+}
+
+static void
+rtm_journal_send_next (RtmJournal *journal);
+
+static void
+rtm_journal_call_cb (GObject *source_object, GAsyncResult *result,
+                     gpointer user_data)
+{
+        RtmJournal *journal = RTM_JOURNAL (user_data);
+        RtmJournalPrivate *priv = journal->priv;
+        RtmJournalEntry *entry;
+        RestXmlNode *root;
+        GError *error = NULL;
+
+        root = rtm_glib_call_method_finish (RTM_GLIB (source_object), result,
+                                            &error);
+
+        if (error != NULL && rtm_journal_must_keep (error)) {
+                rtm_journal_go_offline (journal, error);
+                g_error_free (error);
+                g_object_unref (journal);
+                return;
+        }
+
+        entry = g_queue_pop_head (priv->entries);
+        rtm_journal_acknowledge (journal, entry);
+
+        if (entry->callback) {
+                entry->callback (journal, entry->method, root, error,
+                                 entry->user_data);
+        }
+
+        if (root != NULL) {
+                rest_xml_node_unref (root);
+        }
+        if (error != NULL) {
+                g_error_free (error);
+        }
+        rtm_journal_entry_free (entry);
+
+        rtm_journal_send_next (journal);
+
+        g_object_unref (journal);
+}
+
+/**
+ * rtm_journal_send_next:
+ * @journal: a #RtmJournal object.
+ *
+ * Sends the oldest modification pending, if any.
+ */
+static void
+rtm_journal_send_next (RtmJournal *journal)
+{
+        RtmJournalPrivate *priv = journal->priv;
+        RtmJournalEntry *entry;
+        gchar **params;
+        GError *error = NULL;
+
+        entry = g_queue_peek_head (priv->entries);
+        if (entry == NULL || priv->rtm == NULL) {
+                priv->replaying = FALSE;
+                return;
+        }
+
+        /* The record must be on disk before the service can apply it */
+        if (entry->seq >= priv->unsynced_seq &&
+            !rtm_journal_sync (journal, &error)) {
+                g_warning ("%s", error->message);
+                rtm_journal_go_offline (journal, error);
+                g_error_free (error);
+                return;
+        }
+
+        params = rtm_journal_build_params (journal, entry);
+        rtm_glib_call_method_params_async (priv->rtm, entry->method, params,
+                                           NULL, rtm_journal_call_cb,
+                                           g_object_ref (journal));
+        g_strfreev (params);
+}
+
+static void
+rtm_journal_timeline_cb (GObject *source_object, GAsyncResult *result,
+                         gpointer user_data)
+{
+        RtmJournal *journal = RTM_JOURNAL (user_data);
+        GError *error = NULL;
+
+        journal->priv->timeline = rtm_glib_timelines_create_finish (
+                RTM_GLIB (source_object), result, &error);
+        if (journal->priv->timeline == NULL) {
+                if (error == NULL) {
+                        g_set_error (&error, RTM_ERROR_DOMAIN,
+                                     RTM_ERROR_RESPONSE_FAIL,
+                                     "No timeline in the response");
+                }
+                rtm_journal_go_offline (journal, error);
+                g_error_free (error);
+        } else {
+                rtm_journal_send_next (journal);
+        }
+
+        g_object_unref (journal);
+}
+
+/**
+ * rtm_journal_replay:
+ * @journal: a #RtmJournal object.
+ *
+ * Starts sending the pending modifications in append order, even if the
+ * journal is offline. A timeline is created first the first time.
+ */
+void
+rtm_journal_replay (RtmJournal *journal)
+{
+        g_return_if_fail (journal != NULL);
+
+        RtmJournalPrivate *priv = journal->priv;
+
+        if (priv->retry_source) {
+                g_source_destroy (priv->retry_source);
+                g_source_unref (priv->retry_source);
+                priv->retry_source = NULL;
+        }
+
+        if (priv->replaying || g_queue_is_empty (priv->entries)) {
+                return;
+        }
+        priv->replaying = TRUE;
+        priv->offline = FALSE;
+
+        if (priv->timeline == NULL) {
+                rtm_glib_timelines_create_async (priv->rtm, NULL,
+                                                 rtm_journal_timeline_cb,
+                                                 g_object_ref (journal));
+        } else {
+                rtm_journal_send_next (journal);
+        }
+}
+
+static void
+rtm_journal_network_changed_cb (GNetworkMonitor *monitor, gboolean available,
+                                RtmJournal *journal)
+{
+        if (available && journal->priv->offline) {
+                DEBUG_PRINT ("rtm_journal: network changed, replaying");
+                rtm_journal_replay (journal);
+        }
+}
+
+/**
+ * rtm_journal_append:
+ * @journal: a #RtmJournal object.
+ * @method: the method name to be called.
+ * @callback: optional #RtmJournalCallback called with the result.
+ * @user_data: the data to pass to callback function.
+ * @Varargs: list of parameters (pairs of name and value) terminated by %NULL.
+ *
+ * Appends a modification to @journal, which is sent as soon as the ones
+ * before it are acknowledged and the service can be reached. The method
+ * name and parameters are the same ones the web service expects, without
+ * the auth_token. A format parameter is ignored.
+ */
+void
+rtm_journal_append (RtmJournal *journal, const gchar *method,
+                    RtmJournalCallback callback, gpointer user_data, ...)
+{
+        g_return_if_fail (journal != NULL);
+        g_return_if_fail (method != NULL);
+
+        RtmJournalPrivate *priv = journal->priv;
+        RtmJournalEntry *entry;
+        va_list args;
+
+        entry = g_slice_new0 (RtmJournalEntry);
+        entry->seq = priv->next_seq++;
+        entry->method = g_strdup (method);
+        entry->callback = callback;
+        entry->user_data = user_data;
+
+        va_start (args, user_data);
+        entry->params = rtm_glib_collect_params (args);
+        va_end (args);
+
+        rtm_journal_encode_entry (entry, priv->buffer);
+        g_queue_push_tail (priv->entries, entry);
+        rtm_journal_schedule_sync (journal);
+
+        if (priv->monitor == NULL) {
+                priv->monitor = g_object_ref (g_network_monitor_get_default ());
+                priv->network_changed_id = g_signal_connect (
+                        priv->monitor, "network-changed",
+                        G_CALLBACK (rtm_journal_network_changed_cb), journal);
+        }
+
+        if (!priv->offline) {
+                rtm_journal_replay (journal);
+        }
+}
+
+/**
+ * rtm_journal_get_n_pending:
+ * @journal: a #RtmJournal object.
+ *
+ * Gets the number of modifications not acknowledged yet.
+ *
+ * Returns: the number of modifications pending.
+ */
+guint
+rtm_journal_get_n_pending (RtmJournal *journal)
+{
+        g_return_val_if_fail (journal != NULL, 0);
+
+        return g_queue_get_length (journal->priv->entries);
+}
+
+/**
+ * rtm_journal_is_offline:
+ * @journal: a #RtmJournal object.
+ *
+ * Checks if the last modification sent failed to reach the service.
+ *
+ * Returns: %TRUE if the journal is waiting to try again.
+ */
+gboolean
+rtm_journal_is_offline (RtmJournal *journal)
+{
+        g_return_val_if_fail (journal != NULL, FALSE);
+
+        return journal->priv->offline;
+}
@@ -0,0 +1,105 @@
+/*
+ * rtm-journal.h: On-disk journal of modifications replayed when online
+ *
+ * Copyright (C) 2009 Manuel Rego Casasnovas <mrego@igalia.com>
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301 USA
+ */
+
+#ifndef __RTM_JOURNAL_H__
+#define __RTM_JOURNAL_H__
+
+#include <glib-object.h>
+#include <rest/rest-xml-parser.h>
+#include <rtm-glib/rtm-glib.h>
+
+
+G_BEGIN_DECLS
+
+#define RTM_TYPE_JOURNAL (rtm_journal_get_type ())
+#define RTM_JOURNAL(obj)                                                    \
+        (G_TYPE_CHECK_INSTANCE_CAST ((obj), RTM_TYPE_JOURNAL, RtmJournal))
+#define RTM_IS_JOURNAL(obj)                                         \
+        (G_TYPE_CHECK_INSTANCE_TYPE ((obj), RTM_TYPE_JOURNAL))
+#define RTM_JOURNAL_CLASS(klass)                                            \
+        (G_TYPE_CHECK_CLASS_CAST ((klass), RTM_TYPE_JOURNAL, RtmJournalClass))
+#define RTM_IS_JOURNAL_CLASS(klass)                                 \
+        (G_TYPE_CHECK_CLASS_TYPE ((klass), RTM_TYPE_JOURNAL))
+#define RTM_JOURNAL_GET_CLASS(obj)                                          \
+        (G_TYPE_INSTANCE_GET_CLASS ((obj), RTM_TYPE_JOURNAL, RtmJournalClass))
+
+typedef struct _RtmJournal RtmJournal;
+typedef struct _RtmJournalClass RtmJournalClass;
+typedef struct _RtmJournalPrivate RtmJournalPrivate;
+
+struct _RtmJournal {
+        GObject parent_instance;
+
+        /*< private >*/
+        RtmJournalPrivate *priv;
+};
+
+struct _RtmJournalClass {
+        GObjectClass parent_class;
+};
+
+/**
+ * RtmJournalCallback:
+ * @journal: the #RtmJournal.
+ * @method: the method name that was called.
+ * @root: the #RestXmlNode with the method response, or %NULL on error. It is
+ * only valid during the callback, use rest_xml_node_ref() to keep it.
+ * @error: the #GError if the service rejected the call, or %NULL.
+ * @user_data: the data passed to rtm_journal_append().
+ *
+ * Called once the modification is acknowledged by the service, maybe long
+ * after it was appended. Never called for failures to reach the service,
+ * the modification is kept and sent again later instead.
+ */
+typedef void (*RtmJournalCallback) (RtmJournal *journal,
+                                    const gchar *method,
+                                    RestXmlNode *root,
+                                    const GError *error,
+                                    gpointer user_data);
+
+GType
+rtm_journal_get_type (void) G_GNUC_CONST;
+
+RtmJournal *
+rtm_journal_new (RtmGlib *rtm, const gchar *path, GError **error);
+
+void
+rtm_journal_append (RtmJournal *journal, const gchar *method,
+                    RtmJournalCallback callback, gpointer user_data,
+                    ...) G_GNUC_NULL_TERMINATED;
+
+gboolean
+rtm_journal_sync (RtmJournal *journal, GError **error);
+
+gboolean
+rtm_journal_compact (RtmJournal *journal, GError **error);
+
+void
+rtm_journal_replay (RtmJournal *journal);
+
+guint
+rtm_journal_get_n_pending (RtmJournal *journal);
+
+gboolean
+rtm_journal_is_offline (RtmJournal *journal);
+
+G_END_DECLS
+
+#endif /* __RTM_JOURNAL_H__ */
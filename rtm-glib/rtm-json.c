@@ -0,0 +1,521 @@
+/*
+ * rtm-json.c: Streaming reader of JSON responses
+ *
+ * Copyright (C) 2009 Manuel Rego Casasnovas <mrego@igalia.com>
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301 USA
+ */
+
+
+/*
+ * A pull reader of JSON documents. Each call to rtm_json_reader_next()
+ * returns the next token, so responses are decoded straight into the
+ * objects they describe instead of being loaded into a tree first.
+ *
+ * Object member names are returned as %RTM_JSON_TOKEN_MEMBER tokens, before
+ * the token of their value, and are kept until the next member is read. The
+ * text of strings and numbers is kept in a buffer reused for every value, so
+ * it is only valid until the next call.
+ */
+
+#include <string.h>
+#include <rtm-json.h>
+#include <rtm-error.h>
+
+struct _RtmJsonReader {
+        const gchar *data;
+        const gchar *pos;
+        const gchar *end;
+        GString *member;
+        GString *string;
+        guint depth;
+        gchar stack[RTM_JSON_MAX_DEPTH];
+        gboolean after_value;
+        gboolean after_member;
+};
+
+/**
+ * rtm_json_reader_new:
+ * @data: the JSON document.
+ * @length: the length of @data.
+ *
+ * Creates a reader of @data, which must be kept alive while it is used.
+ *
+ * Returns: a new #RtmJsonReader.
+ */
+RtmJsonReader *
+rtm_json_reader_new (const gchar *data, gsize length)
+{
+        RtmJsonReader *reader;
+
+        reader = g_slice_new0 (RtmJsonReader);
+        reader->data = data;
+        reader->pos = data;
+        reader->end = data + length;
+        reader->member = g_string_sized_new (32);
+        reader->string = g_string_sized_new (64);
+
+        return reader;
+}
+
+static RtmJsonToken
+rtm_json_reader_fail (RtmJsonReader *reader, GError **error,
+                      const gchar *message)
+{
+        g_set_error (error,
+                     RTM_ERROR_DOMAIN,
+                     RTM_UNKNOWN_ERROR,
+                     "Invalid JSON response at offset %" G_GSIZE_FORMAT
+                     ": %s",
+                     (gsize) (reader->pos - reader->data), message);
+
+        return RTM_JSON_TOKEN_ERROR;
+}
+
+static void
+rtm_json_reader_skip_whitespace (RtmJsonReader *reader)
+{
+        while (reader->pos < reader->end &&
+               (*reader->pos == ' ' || *reader->pos == '\t' ||
+                *reader->pos == '\n' || *reader->pos == '\r')) {
+                reader->pos++;
+        }
+}
+
+static gint
+rtm_json_reader_read_hex (RtmJsonReader *reader)
+{
+        gint value = 0;
+        gint digit;
+        guint i;
+
+        if (reader->end - reader->pos < 4) {
+                return -1;
+        }
+
+        for (i = 0; i < 4; i++) {
+                digit = g_ascii_xdigit_value (reader->pos[i]);
+                if (digit < 0) {
+                        return -1;
+                }
+                value = value * 16 + digit;
+        }
+        reader->pos += 4;
+
+        return value;
+}
+
+/**
+ * rtm_json_reader_read_escape:
+ * @reader: a #RtmJsonReader placed after a backslash.
+ * @string: the buffer of the string being read.
+ *
+ * Appends the character of an escape sequence to the string buffer.
+ *
+ * Returns: %FALSE if the escape sequence is not valid.
+ */
+static gboolean
+rtm_json_reader_read_escape (RtmJsonReader *reader, GString *string)
+{
+        gchar utf8[6];
+        gint unichar, low;
+
+        if (reader->pos >= reader->end) {
+                return FALSE;
+        }
+
+        switch (*reader->pos++) {
+        case '"':
+                g_string_append_c (string, '"');
+                return TRUE;
+        case '\\':
+                g_string_append_c (string, '\\');
+                return TRUE;
+        case '/':
+                g_string_append_c (string, '/');
+                return TRUE;
+        case 'b':
+                g_string_append_c (string, '\b');
+                return TRUE;
+        case 'f':
+                g_string_append_c (string, '\f');
+                return TRUE;
+        case 'n':
+                g_string_append_c (string, '\n');
+                return TRUE;
+        case 'r':
+                g_string_append_c (string, '\r');
+                return TRUE;
+        case 't':
+                g_string_append_c (string, '\t');
+                return TRUE;
+        case 'u':
+                unichar = rtm_json_reader_read_hex (reader);
+                if (unichar < 0) {
+                        return FALSE;
+                }
+
+                /* Characters outside the BMP come as a surrogate pair */
+                if (unichar >= 0xd800 && unichar <= 0xdbff) {
+                        if (reader->end - reader->pos < 2 ||
+                            reader->pos[0] != '\\' || reader->pos[1] != 'u') {
+                                return FALSE;
+                        }
+                        reader->pos += 2;
+                        low = rtm_json_reader_read_hex (reader);
+                        if (low < 0xdc00 || low > 0xdfff) {
+                                return FALSE;
+                        }
+                        unichar = 0x10000 + ((unichar - 0xd800) << 10) +
+                                (low - 0xdc00);
+                } else if (unichar >= 0xdc00 && unichar <= 0xdfff) {
+                        return FALSE;
+                }
+
+                g_string_append_len (string, utf8,
+                                     g_unichar_to_utf8 (unichar, utf8));
+                return TRUE;
+        default:
+                return FALSE;
+        }
+}
+
+static RtmJsonToken
+rtm_json_reader_read_string (RtmJsonReader *reader, GString *string,
+                             RtmJsonToken token, GError **error)
+{
+        const gchar *start;
+
+        g_string_truncate (string, 0);
+        reader->pos++;
+
+        while (TRUE) {
+                /* Copy the runs without escapes at once */
+                start = reader->pos;
+                while (reader->pos < reader->end && *reader->pos != '"' &&
+                       *reader->pos != '\\' &&
+                       (guchar) *reader->pos >= 0x20) {
+                        reader->pos++;
+                }
+                g_string_append_len (string, start, reader->pos - start);
+
+                if (reader->pos >= reader->end) {
+                        return rtm_json_reader_fail (reader, error,
+                                                     "unterminated string");
+                }
+
+                switch (*reader->pos) {
+                case '"':
+                        reader->pos++;
+                        return token;
+                case '\\':
+                        reader->pos++;
+                        if (!rtm_json_reader_read_escape (reader, string)) {
+                                return rtm_json_reader_fail (
+                                        reader, error,
+                                        "invalid escape sequence");
+                        }
+                        break;
+                default:
+                        return rtm_json_reader_fail (
+                                reader, error,
+                                "control character in string");
+                }
+        }
+}
+
+static RtmJsonToken
+rtm_json_reader_read_number (RtmJsonReader *reader, GError **error)
+{
+        const gchar *start = reader->pos;
+
+        while (reader->pos < reader->end &&
+               (g_ascii_isdigit (*reader->pos) || *reader->pos == '-' ||
+                *reader->pos == '+' || *reader->pos == '.' ||
+                *reader->pos == 'e' || *reader->pos == 'E')) {
+                reader->pos++;
+        }
+
+        g_string_truncate (reader->string, 0);
+        g_string_append_len (reader->string, start, reader->pos - start);
+
+        return RTM_JSON_TOKEN_NUMBER;
+}
+
+static RtmJsonToken
+rtm_json_reader_read_literal (RtmJsonReader *reader, const gchar *literal,
+                              RtmJsonToken token, GError **error)
+{
+        gsize length = strlen (literal);
+
+        if ((gsize) (reader->end - reader->pos) < length ||
+            strncmp (reader->pos, literal, length) != 0) {
+                return rtm_json_reader_fail (reader, error,
+                                             "unexpected character");
+        }
+        reader->pos += length;
+
+        return token;
+}
+
+static RtmJsonToken
+rtm_json_reader_push (RtmJsonReader *reader, gchar container,
+                      RtmJsonToken token, GError **error)
+{
+        if (reader->depth == RTM_JSON_MAX_DEPTH) {
+                return rtm_json_reader_fail (reader, error,
+                                             "nested too deeply");
+        }
+
+        reader->stack[reader->depth++] = container;
+        reader->pos++;
+        reader->after_value = FALSE;
+
+        return token;
+}
+
+static RtmJsonToken
+rtm_json_reader_pop (RtmJsonReader *reader, gchar container,
+                     RtmJsonToken token, GError **error)
+{
+        if (reader->depth == 0 ||
+            reader->stack[reader->depth - 1] != container ||
+            reader->after_member) {
+                return rtm_json_reader_fail (reader, error,
+                                             "unexpected character");
+        }
+
+        reader->depth--;
+        reader->pos++;
+        reader->after_value = TRUE;
+
+        return token;
+}
+
+/**
+ * rtm_json_reader_next:
+ * @reader: a #RtmJsonReader.
+ * @error: location to store #GError or %NULL.
+ *
+ * Reads the next token of the document.
+ *
+ * Returns: the token read, %RTM_JSON_TOKEN_END at the end of the document,
+ * or %RTM_JSON_TOKEN_ERROR if it is not valid JSON.
+ */
+RtmJsonToken
+rtm_json_reader_next (RtmJsonReader *reader, GError **error)
+{
+        RtmJsonToken token;
+        gchar container;
+
+        g_assert (reader != NULL);
+
+        rtm_json_reader_skip_whitespace (reader);
+
+        if (reader->pos >= reader->end) {
+                if (reader->depth == 0 && reader->after_value) {
+                        return RTM_JSON_TOKEN_END;
+                }
+                return rtm_json_reader_fail (reader, error,
+                                             "unexpected end of document");
+        }
+
+        if (*reader->pos == '}') {
+                return rtm_json_reader_pop (reader, '{',
+                                            RTM_JSON_TOKEN_END_OBJECT, error);
+        }
+        if (*reader->pos == ']') {
+                return rtm_json_reader_pop (reader, '[',
+                                            RTM_JSON_TOKEN_END_ARRAY, error);
+        }
+
+        if (reader->after_value) {
+                if (reader->depth == 0 || *reader->pos != ',') {
+                        return rtm_json_reader_fail (reader, error,
+                                                     "expected ','");
+                }
+                reader->pos++;
+                reader->after_value = FALSE;
+                rtm_json_reader_skip_whitespace (reader);
+                if (reader->pos >= reader->end) {
+                        return rtm_json_reader_fail (
+                                reader, error, "unexpected end of document");
+                }
+        }
+
+        container = reader->depth > 0 ? reader->stack[reader->depth - 1] : 0;
+
+        if (container == '{' && !reader->after_member) {
+                if (*reader->pos != '"') {
+                        return rtm_json_reader_fail (reader, error,
+                                                     "expected member name");
+                }
+                token = rtm_json_reader_read_string (
+                        reader, reader->member, RTM_JSON_TOKEN_MEMBER, error);
+                if (token == RTM_JSON_TOKEN_ERROR) {
+                        return token;
+                }
+
+                rtm_json_reader_skip_whitespace (reader);
+                if (reader->pos >= reader->end || *reader->pos != ':') {
+                        return rtm_json_reader_fail (reader, error,
+                                                     "expected ':'");
+                }
+                reader->pos++;
+                reader->after_member = TRUE;
+
+                return RTM_JSON_TOKEN_MEMBER;
+        }
+        reader->after_member = FALSE;
+
+        switch (*reader->pos) {
+        case '{':
+                return rtm_json_reader_push (reader, '{',
+                                             RTM_JSON_TOKEN_BEGIN_OBJECT,
+                                             error);
+        case '[':
+                return rtm_json_reader_push (reader, '[',
+                                             RTM_JSON_TOKEN_BEGIN_ARRAY,
+                                             error);
+        case '"':
+                token = rtm_json_reader_read_string (
+                        reader, reader->string, RTM_JSON_TOKEN_STRING, error);
+                break;
+        case 't':
+                token = rtm_json_reader_read_literal (
+                        reader, "true", RTM_JSON_TOKEN_TRUE, error);
+                break;
+        case 'f':
+                token = rtm_json_reader_read_literal (
+                        reader, "false", RTM_JSON_TOKEN_FALSE, error);
+                break;
+        case 'n':
+                token = rtm_json_reader_read_literal (
+                        reader, "null", RTM_JSON_TOKEN_NULL, error);
+                break;
+        default:
+                if (*reader->pos != '-' && !g_ascii_isdigit (*reader->pos)) {
+                        return rtm_json_reader_fail (reader, error,
+                                                     "unexpected character");
+                }
+                token = rtm_json_reader_read_number (reader, error);
+                break;
+        }
+
+        reader->after_value = (token != RTM_JSON_TOKEN_ERROR);
+
+        return token;
+}
+
+/**
+ * rtm_json_reader_get_member:
+ * @reader: a #RtmJsonReader.
+ *
+ * Gets the name of the last object member read.
+ *
+ * Returns: the name, valid until the next member is read.
+ */
+const gchar *
+rtm_json_reader_get_member (RtmJsonReader *reader)
+{
+        g_assert (reader != NULL);
+
+        return reader->member->str;
+}
+
+/**
+ * rtm_json_reader_get_string:
+ * @reader: a #RtmJsonReader.
+ *
+ * Gets the text of the last string or number read.
+ *
+ * Returns: the text, valid until the next call to rtm_json_reader_next().
+ */
+const gchar *
+rtm_json_reader_get_string (RtmJsonReader *reader)
+{
+        g_assert (reader != NULL);
+
+        return reader->string->str;
+}
+
+/**
+ * rtm_json_reader_get_depth:
+ * @reader: a #RtmJsonReader.
+ *
+ * Gets the number of objects and arrays open at the current position.
+ *
+ * Returns: the nesting depth.
+ */
+guint
+rtm_json_reader_get_depth (RtmJsonReader *reader)
+{
+        g_assert (reader != NULL);
+
+        return reader->depth;
+}
+
+/**
+ * rtm_json_reader_skip:
+ * @reader: a #RtmJsonReader.
+ * @token: the first token of the value to skip, just read.
+ * @error: location to store #GError or %NULL.
+ *
+ * Skips the rest of a value, which is only needed if it is an object or an
+ * array.
+ *
+ * Returns: %TRUE on success, %FALSE if the document is not valid JSON.
+ */
+gboolean
+rtm_json_reader_skip (RtmJsonReader *reader, RtmJsonToken token,
+                      GError **error)
+{
+        guint depth;
+
+        g_assert (reader != NULL);
+
+        if (token == RTM_JSON_TOKEN_ERROR) {
+                return FALSE;
+        }
+        if (token != RTM_JSON_TOKEN_BEGIN_OBJECT &&
+            token != RTM_JSON_TOKEN_BEGIN_ARRAY) {
+                return TRUE;
+        }
+
+        depth = reader->depth - 1;
+        while (reader->depth > depth) {
+                if (rtm_json_reader_next (reader, error) ==
+                    RTM_JSON_TOKEN_ERROR) {
+                        return FALSE;
+                }
+        }
+
+        return TRUE;
+}
+
+/**
+ * rtm_json_reader_free:
+ * @reader: a #RtmJsonReader.
+ *
+ * Frees @reader.
+ */
+void
+rtm_json_reader_free (RtmJsonReader *reader)
+{
+        g_string_free (reader->member, TRUE);
+        g_string_free (reader->string, TRUE);
+
+        g_slice_free (RtmJsonReader, reader);
+}
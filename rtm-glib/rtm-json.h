@@ -0,0 +1,74 @@
+/*
+ * rtm-json.h: Streaming reader of JSON responses
+ *
+ * Copyright (C) 2009 Manuel Rego Casasnovas <mrego@igalia.com>
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301 USA
+ */
+
+
+#ifndef __RTM_JSON_H__
+#define __RTM_JSON_H__
+
+#include <glib.h>
+
+
+G_BEGIN_DECLS
+
+/* Maximum nesting of objects and arrays */
+#define RTM_JSON_MAX_DEPTH 64
+
+typedef enum {
+        RTM_JSON_TOKEN_ERROR,
+        RTM_JSON_TOKEN_END,
+        RTM_JSON_TOKEN_BEGIN_OBJECT,
+        RTM_JSON_TOKEN_END_OBJECT,
+        RTM_JSON_TOKEN_BEGIN_ARRAY,
+        RTM_JSON_TOKEN_END_ARRAY,
+        RTM_JSON_TOKEN_MEMBER,
+        RTM_JSON_TOKEN_STRING,
+        RTM_JSON_TOKEN_NUMBER,
+        RTM_JSON_TOKEN_TRUE,
+        RTM_JSON_TOKEN_FALSE,
+        RTM_JSON_TOKEN_NULL,
+} RtmJsonToken;
+
+typedef struct _RtmJsonReader RtmJsonReader;
+
+RtmJsonReader *
+rtm_json_reader_new (const gchar *data, gsize length);
+
+RtmJsonToken
+rtm_json_reader_next (RtmJsonReader *reader, GError **error);
+
+const gchar *
+rtm_json_reader_get_member (RtmJsonReader *reader);
+
+const gchar *
+rtm_json_reader_get_string (RtmJsonReader *reader);
+
+guint
+rtm_json_reader_get_depth (RtmJsonReader *reader);
+
+gboolean
+rtm_json_reader_skip (RtmJsonReader *reader, RtmJsonToken token,
+                      GError **error);
+
+void
+rtm_json_reader_free (RtmJsonReader *reader);
+
+G_END_DECLS
+
+#endif /* __RTM_JSON_H__ */
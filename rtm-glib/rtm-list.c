@@ -28,6 +28,7 @@
 #include <rtm-list.h>
 #include <rtm-util.h>
 #include <rtm-error.h>
+#include <rtm-attributes.h>
 
 #define RTM_LIST_GET_PRIVATE(obj) (G_TYPE_INSTANCE_GET_PRIVATE (        \
                                            (obj), RTM_TYPE_LIST, RtmListPrivate))
@@ -59,6 +60,35 @@ enum {
         PROP_FILTER,
 };
 
+/* Attributes of the list element, in the order of rtm_list_attribute_names */
+enum {
+        ATTRIBUTE_ID,
+        ATTRIBUTE_NAME,
+        ATTRIBUTE_DELETED,
+        ATTRIBUTE_LOCKED,
+        ATTRIBUTE_ARCHIVED,
+        ATTRIBUTE_POSITION,
+        ATTRIBUTE_SMART,
+        ATTRIBUTE_SORT_ORDER,
+        ATTRIBUTE_FILTER,
+};
+
+static const gchar * const rtm_list_attribute_names[] = {
+        "id",
+        "name",
+        "deleted",
+        "locked",
+        "archived",
+        "position",
+        "smart",
+        "sort_order",
+        "filter",
+        NULL
+};
+
+static RtmAttributes rtm_list_attributes =
+        RTM_ATTRIBUTES_INIT (rtm_list_attribute_names);
+
 G_DEFINE_TYPE (RtmList, rtm_list, G_TYPE_OBJECT);
 
 static void
@@ -641,6 +671,47 @@ rtm_list_set_filter (RtmList *list, gchar* filter)
         return TRUE;
 }
 
+static void
+rtm_list_set_attribute (RtmList *list, gint id, const gchar *value)
+{
+        RtmListPrivate *priv = list->priv;
+
+        switch (id) {
+        case ATTRIBUTE_ID:
+                g_free (priv->id);
+                priv->id = g_strdup (value);
+                break;
+        case ATTRIBUTE_NAME:
+                g_free (priv->name);
+                priv->name = g_strdup (value);
+                break;
+        case ATTRIBUTE_DELETED:
+                priv->deleted = (g_strcmp0 (value, "1") == 0);
+                break;
+        case ATTRIBUTE_LOCKED:
+                priv->locked = (g_strcmp0 (value, "1") == 0);
+                break;
+        case ATTRIBUTE_ARCHIVED:
+                priv->archived = (g_strcmp0 (value, "1") == 0);
+                break;
+        case ATTRIBUTE_POSITION:
+                g_free (priv->position);
+                priv->position = g_strdup (value);
+                break;
+        case ATTRIBUTE_SMART:
+                priv->smart = (g_strcmp0 (value, "1") == 0);
+                break;
+        case ATTRIBUTE_SORT_ORDER:
+                g_free (priv->sort_order);
+                priv->sort_order = g_strdup (value);
+                break;
+        case ATTRIBUTE_FILTER:
+                g_free (priv->filter);
+                priv->filter = g_strdup (value);
+                break;
+        }
+}
+
 /**
  * rtm_list_load_data:
  * @list: a #RtmList.
@@ -656,21 +727,38 @@ rtm_list_load_data (RtmList *list, RestXmlNode *node)
 
         RestXmlNode *node_tmp;
 
-        list->priv->id = g_strdup (rest_xml_node_get_attr (node, "id"));
-        list->priv->name = g_strdup (rest_xml_node_get_attr (node, "name"));
-        list->priv->deleted = (g_strcmp0 (rest_xml_node_get_attr (node, "deleted"), "1") == 0);
-        list->priv->locked = (g_strcmp0 (rest_xml_node_get_attr (node, "locked"), "1") == 0);
-        list->priv->archived = (g_strcmp0 (rest_xml_node_get_attr (node, "archived"), "1") == 0);
-        list->priv->position = g_strdup (rest_xml_node_get_attr (node, "position"));
-        list->priv->smart = (g_strcmp0 (rest_xml_node_get_attr (node, "smart"), "1") == 0);
-        list->priv->sort_order = g_strdup (rest_xml_node_get_attr (node, "sort_order"));
+        rtm_attributes_load_node (&rtm_list_attributes, node,
+                                  (RtmAttributesSetFunc) rtm_list_set_attribute,
+                                  list);
 
         node_tmp = rest_xml_node_find (node, "filter");
         if (node_tmp) {
-                list->priv->filter = g_strdup (node_tmp->content);
+                rtm_list_set_attribute (list, ATTRIBUTE_FILTER,
+                                        node_tmp->content);
         }
 }
 
+/**
+ * rtm_list_load_attribute:
+ * @list: a #RtmList.
+ * @name: the name of an attribute of the list element.
+ * @value: the value of the attribute.
+ *
+ * Sets one field of the #RtmList object, as found in a response. Unknown
+ * attributes are ignored.
+ */
+void
+rtm_list_load_attribute (RtmList *list, const gchar *name, const gchar *value)
+{
+        g_return_if_fail (list != NULL);
+        g_return_if_fail (name != NULL);
+
+        rtm_list_set_attribute (list,
+                                rtm_attributes_lookup (&rtm_list_attributes,
+                                                       name),
+                                value);
+}
+
 /**
  * rtm_list_to_string:
  * @list: a #RtmList.
@@ -118,6 +118,9 @@ rtm_list_set_filter (RtmList *list, gchar* filter);
 void
 rtm_list_load_data (RtmList *list, RestXmlNode *node);
 
+void
+rtm_list_load_attribute (RtmList *list, const gchar *name, const gchar *value);
+
 gchar *
 rtm_list_to_string (RtmList *list);
 
@@ -27,6 +27,7 @@
 
 #include <rtm-location.h>
 #include <rtm-util.h>
+#include <rtm-attributes.h>
 
 #define RTM_LOCATION_GET_PRIVATE(obj) (G_TYPE_INSTANCE_GET_PRIVATE (        \
                                            (obj), RTM_TYPE_LOCATION, RtmLocationPrivate))
@@ -53,6 +54,31 @@ enum {
         PROP_VIEWABLE,
 };
 
+/* Attributes of the location element, in the order of rtm_location_attribute_names */
+enum {
+        ATTRIBUTE_ID,
+        ATTRIBUTE_NAME,
+        ATTRIBUTE_LONGITUDE,
+        ATTRIBUTE_LATITUDE,
+        ATTRIBUTE_ZOOM,
+        ATTRIBUTE_ADDRESS,
+        ATTRIBUTE_VIEWABLE,
+};
+
+static const gchar * const rtm_location_attribute_names[] = {
+        "id",
+        "name",
+        "longitude",
+        "latitude",
+        "zoom",
+        "address",
+        "viewable",
+        NULL
+};
+
+static RtmAttributes rtm_location_attributes =
+        RTM_ATTRIBUTES_INIT (rtm_location_attribute_names);
+
 G_DEFINE_TYPE (RtmLocation, rtm_location, G_TYPE_OBJECT);
 
 static void
@@ -505,6 +531,42 @@ rtm_location_set_viewable (RtmLocation *location, gboolean viewable)
         return TRUE;
 }
 
+static void
+rtm_location_set_attribute (RtmLocation *location, gint id, const gchar *value)
+{
+        RtmLocationPrivate *priv = location->priv;
+
+        switch (id) {
+        case ATTRIBUTE_ID:
+                g_free (priv->id);
+                priv->id = g_strdup (value);
+                break;
+        case ATTRIBUTE_NAME:
+                g_free (priv->name);
+                priv->name = g_strdup (value);
+                break;
+        case ATTRIBUTE_LONGITUDE:
+                g_free (priv->longitude);
+                priv->longitude = g_strdup (value);
+                break;
+        case ATTRIBUTE_LATITUDE:
+                g_free (priv->latitude);
+                priv->latitude = g_strdup (value);
+                break;
+        case ATTRIBUTE_ZOOM:
+                g_free (priv->zoom);
+                priv->zoom = g_strdup (value);
+                break;
+        case ATTRIBUTE_ADDRESS:
+                g_free (priv->address);
+                priv->address = g_strdup (value);
+                break;
+        case ATTRIBUTE_VIEWABLE:
+                priv->viewable = (g_strcmp0 (value, "1") == 0);
+                break;
+        }
+}
+
 /**
  * rtm_location_load_data:
  * @location: a #RtmLocation.
@@ -518,13 +580,30 @@ rtm_location_load_data (RtmLocation *location, RestXmlNode *node)
         g_return_if_fail (location != NULL);
         g_return_if_fail (node != NULL);
 
-        location->priv->id = g_strdup (rest_xml_node_get_attr (node, "id"));
-        location->priv->name = g_strdup (rest_xml_node_get_attr (node, "name"));
-        location->priv->longitude = g_strdup (rest_xml_node_get_attr (node, "longitude"));
-        location->priv->latitude = g_strdup (rest_xml_node_get_attr (node, "latitude"));
-        location->priv->zoom = g_strdup (rest_xml_node_get_attr (node, "zoom"));
-        location->priv->address = g_strdup (rest_xml_node_get_attr (node, "address"));
-        location->priv->viewable = (g_strcmp0 (rest_xml_node_get_attr (node, "viewable"), "1") == 0);
+        rtm_attributes_load_node (&rtm_location_attributes, node,
+                                  (RtmAttributesSetFunc) rtm_location_set_attribute,
+                                  location);
+}
+
+/**
+ * rtm_location_load_attribute:
+ * @location: a #RtmLocation.
+ * @name: the name of an attribute of the location element.
+ * @value: the value of the attribute.
+ *
+ * Sets one field of the #RtmLocation object, as found in a response. Unknown
+ * attributes are ignored.
+ */
+void
+rtm_location_load_attribute (RtmLocation *location, const gchar *name,
+                             const gchar *value)
+{
+        g_return_if_fail (location != NULL);
+        g_return_if_fail (name != NULL);
+
+        rtm_location_set_attribute (
+                location, rtm_attributes_lookup (&rtm_location_attributes, name),
+                value);
 }
 
 /**
@@ -106,6 +106,10 @@ rtm_location_set_viewable (RtmLocation *location, gboolean viewable);
 void
 rtm_location_load_data (RtmLocation *location, RestXmlNode *node);
 
+void
+rtm_location_load_attribute (RtmLocation *location, const gchar *name,
+                             const gchar *value);
+
 gchar *
 rtm_location_to_string (RtmLocation *location);
 
@@ -0,0 +1,497 @@
+/*
+ * rtm-loopback-transport.c: Transport serving canned responses from memory
+ *
+ * Copyright (C) 2009 Manuel Rego Casasnovas <mrego@igalia.com>
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301 USA
+ */
+
+/**
+ * SECTION:rtm-loopback-transport
+ * @short_description: A transport serving canned responses from memory
+ *
+ * #RtmLoopbackTransport answers each method with the payload registered with
+ * rtm_loopback_transport_add_response(), without any network access. It is
+ * meant for tests and for benchmarking the signing, parsing and model code.
+ *
+ * Methods without a registered payload get the failed response Remember The
+ * Milk sends for unknown methods.
+ *
+ * Streamed calls get their payload in small pieces, one per iteration of the
+ * main loop, as if it was being downloaded.
+ *
+ * rtm_loopback_transport_set_latency() delays every response, as the round
+ * trip to the web service would, so calls stay in flight for a while, and
+ * rtm_loopback_transport_fail_next() makes the next requests fail as if the
+ * connection was lost.
+ */
+
+#include <string.h>
+#include <rtm-loopback-transport.h>
+#include <rtm-error.h>
+#include <rtm-timeout.h>
+
+#define RTM_LOOPBACK_TRANSPORT_GET_PRIVATE(obj) (G_TYPE_INSTANCE_GET_PRIVATE ( \
+                                           (obj), RTM_TYPE_LOOPBACK_TRANSPORT, RtmLoopbackTransportPrivate))
+
+#define RTM_LOOPBACK_TRANSPORT_METHOD_NOT_FOUND                         \
+        "<?xml version=\"1.0\" encoding=\"UTF-8\"?>"                    \
+        "<rsp stat=\"fail\"><err code=\"112\" msg=\"Method not found\"/></rsp>"
+
+/* Size of the pieces of a streamed payload */
+#define RTM_LOOPBACK_TRANSPORT_CHUNK_SIZE 256
+
+struct _RtmLoopbackTransportPrivate {
+        GHashTable *responses;
+        GBytes *method_not_found;
+        gint n_requests;
+        gint latency;
+        gint n_failures;
+        gint n_in_flight;
+        gint max_in_flight;
+};
+
+static void
+rtm_loopback_transport_transport_init (RtmTransportInterface *iface);
+
+G_DEFINE_TYPE_WITH_CODE (RtmLoopbackTransport, rtm_loopback_transport,
+                         G_TYPE_OBJECT,
+                         G_IMPLEMENT_INTERFACE (RTM_TYPE_TRANSPORT,
+                                                rtm_loopback_transport_transport_init));
+
+static void
+rtm_loopback_transport_finalize (GObject *gobject)
+{
+        RtmLoopbackTransportPrivate *priv = RTM_LOOPBACK_TRANSPORT_GET_PRIVATE (RTM_LOOPBACK_TRANSPORT (gobject));
+
+        g_hash_table_destroy (priv->responses);
+        g_bytes_unref (priv->method_not_found);
+
+        G_OBJECT_CLASS (rtm_loopback_transport_parent_class)->finalize (gobject);
+}
+
+static void
+rtm_loopback_transport_class_init (RtmLoopbackTransportClass *klass)
+{
+        GObjectClass *gobject_class = G_OBJECT_CLASS (klass);
+
+        g_type_class_add_private (klass, sizeof (RtmLoopbackTransportPrivate));
+
+        gobject_class->finalize = rtm_loopback_transport_finalize;
+}
+
+static void
+rtm_loopback_transport_init (RtmLoopbackTransport *transport)
+{
+        transport->priv = RTM_LOOPBACK_TRANSPORT_GET_PRIVATE (transport);
+
+        transport->priv->responses = g_hash_table_new_full (
+                g_str_hash, g_str_equal,
+                g_free, (GDestroyNotify) g_bytes_unref);
+        transport->priv->method_not_found = g_bytes_new_static (
+                RTM_LOOPBACK_TRANSPORT_METHOD_NOT_FOUND,
+                sizeof (RTM_LOOPBACK_TRANSPORT_METHOD_NOT_FOUND) - 1);
+}
+
+/**
+ * rtm_loopback_transport_new:
+ *
+ * Creates a new instance of this class.
+ *
+ * Returns: a new #RtmLoopbackTransport object.
+ */
+RtmLoopbackTransport *
+rtm_loopback_transport_new ()
+{
+        return g_object_new (RTM_TYPE_LOOPBACK_TRANSPORT, NULL);
+}
+
+/**
+ * rtm_loopback_transport_add_response:
+ * @transport: a #RtmLoopbackTransport object.
+ * @method: the method name, for example "rtm.tasks.getList".
+ * @payload: the response returned for every call to @method.
+ *
+ * Sets the response payload of @method, replacing any previous one.
+ */
+void
+rtm_loopback_transport_add_response (RtmLoopbackTransport *transport,
+                                     const gchar *method,
+                                     const gchar *payload)
+{
+        g_return_if_fail (transport != NULL);
+        g_return_if_fail (method != NULL);
+        g_return_if_fail (payload != NULL);
+
+        g_hash_table_replace (transport->priv->responses,
+                              g_strdup (method),
+                              g_bytes_new (payload, strlen (payload)));
+}
+
+/**
+ * rtm_loopback_transport_set_latency:
+ * @transport: a #RtmLoopbackTransport object.
+ * @latency: the time to wait before each response in milliseconds, or 0.
+ *
+ * Sets how long every call waits for its response. Cancelling the call
+ * stops the wait.
+ */
+void
+rtm_loopback_transport_set_latency (RtmLoopbackTransport *transport,
+                                    guint latency)
+{
+        g_return_if_fail (transport != NULL);
+
+        g_atomic_int_set (&transport->priv->latency, latency);
+}
+
+/**
+ * rtm_loopback_transport_fail_next:
+ * @transport: a #RtmLoopbackTransport object.
+ * @n_failures: the number of requests to fail.
+ *
+ * Makes the next @n_failures requests fail with %RTM_ERROR_NETWORK. They are
+ * still counted by rtm_loopback_transport_get_n_requests().
+ */
+void
+rtm_loopback_transport_fail_next (RtmLoopbackTransport *transport,
+                                  guint n_failures)
+{
+        g_return_if_fail (transport != NULL);
+
+        g_atomic_int_set (&transport->priv->n_failures, n_failures);
+}
+
+/**
+ * rtm_loopback_transport_get_max_in_flight:
+ * @transport: a #RtmLoopbackTransport object.
+ *
+ * Gets the largest number of requests that were waiting for their response
+ * at the same time.
+ *
+ * Returns: the maximum number of requests in flight.
+ */
+guint
+rtm_loopback_transport_get_max_in_flight (RtmLoopbackTransport *transport)
+{
+        g_return_val_if_fail (transport != NULL, 0);
+
+        return g_atomic_int_get (&transport->priv->max_in_flight);
+}
+
+/**
+ * rtm_loopback_transport_get_n_requests:
+ * @transport: a #RtmLoopbackTransport object.
+ *
+ * Gets the number of calls sent to @transport.
+ *
+ * Returns: the number of calls.
+ */
+guint
+rtm_loopback_transport_get_n_requests (RtmLoopbackTransport *transport)
+{
+        g_return_val_if_fail (transport != NULL, 0);
+
+        return g_atomic_int_get (&transport->priv->n_requests);
+}
+
+static void
+rtm_loopback_transport_begin (RtmLoopbackTransportPrivate *priv)
+{
+        gint n_in_flight, max_in_flight;
+
+        n_in_flight = g_atomic_int_add (&priv->n_in_flight, 1) + 1;
+        do {
+                max_in_flight = g_atomic_int_get (&priv->max_in_flight);
+        } while (n_in_flight > max_in_flight &&
+                 !g_atomic_int_compare_and_exchange (&priv->max_in_flight,
+                                                     max_in_flight,
+                                                     n_in_flight));
+}
+
+static void
+rtm_loopback_transport_end (RtmLoopbackTransportPrivate *priv)
+{
+        g_atomic_int_add (&priv->n_in_flight, -1);
+}
+
+static GBytes *
+rtm_loopback_transport_lookup (RtmTransport *transport, gchar **params,
+                               GError **error)
+{
+        RtmLoopbackTransportPrivate *priv = RTM_LOOPBACK_TRANSPORT (transport)->priv;
+        GBytes *payload;
+        gint n_failures;
+
+        g_atomic_int_inc (&priv->n_requests);
+
+        do {
+                n_failures = g_atomic_int_get (&priv->n_failures);
+        } while (n_failures > 0 &&
+                 !g_atomic_int_compare_and_exchange (&priv->n_failures,
+                                                     n_failures,
+                                                     n_failures - 1));
+        if (n_failures > 0) {
+                g_set_error (error,
+                             RTM_ERROR_DOMAIN,
+                             RTM_ERROR_NETWORK,
+                             "Connection lost");
+                return NULL;
+        }
+
+        payload = g_hash_table_lookup (
+                priv->responses,
+                rtm_transport_lookup_param (params, "method"));
+        if (payload == NULL) {
+                payload = priv->method_not_found;
+        }
+
+        return g_bytes_ref (payload);
+}
+
+static GBytes *
+rtm_loopback_transport_send (RtmTransport *transport, gchar **params,
+                             GCancellable *cancellable, GError **error)
+{
+        RtmLoopbackTransportPrivate *priv = RTM_LOOPBACK_TRANSPORT (transport)->priv;
+        GBytes *payload;
+        gboolean slept;
+
+        if (g_cancellable_set_error_if_cancelled (cancellable, error)) {
+                return NULL;
+        }
+
+        payload = rtm_loopback_transport_lookup (transport, params, error);
+        if (payload == NULL) {
+                return NULL;
+        }
+
+        rtm_loopback_transport_begin (priv);
+        slept = rtm_timeout_sleep ((gint64) g_atomic_int_get (&priv->latency) *
+                                   1000, cancellable);
+        rtm_loopback_transport_end (priv);
+
+        if (!slept) {
+                g_bytes_unref (payload);
+                g_cancellable_set_error_if_cancelled (cancellable, error);
+                return NULL;
+        }
+
+        return payload;
+}
+
+static void
+rtm_loopback_transport_send_thread (GTask *task, gpointer source_object,
+                                    gpointer task_data,
+                                    GCancellable *cancellable)
+{
+        GBytes *payload;
+        GError *error = NULL;
+
+        payload = rtm_loopback_transport_send (RTM_TRANSPORT (source_object),
+                                               task_data, cancellable,
+                                               &error);
+        if (payload == NULL) {
+                g_task_return_error (task, error);
+        } else {
+                g_task_return_pointer (task, payload,
+                                       (GDestroyNotify) g_bytes_unref);
+        }
+}
+
+static void
+rtm_loopback_transport_send_async (RtmTransport *transport, gchar **params,
+                                   GCancellable *cancellable,
+                                   GAsyncReadyCallback callback,
+                                   gpointer user_data)
+{
+        RtmLoopbackTransportPrivate *priv = RTM_LOOPBACK_TRANSPORT (transport)->priv;
+        GTask *task;
+        GBytes *payload;
+        GError *error = NULL;
+
+        task = g_task_new (transport, cancellable, callback, user_data);
+        g_task_set_source_tag (task, rtm_loopback_transport_send_async);
+
+        /* Waiting for the latency blocks, so it is done in a thread */
+        if (g_atomic_int_get (&priv->latency) > 0) {
+                g_task_set_task_data (task, g_strdupv (params),
+                                      (GDestroyNotify) g_strfreev);
+                g_task_run_in_thread (task,
+                                      rtm_loopback_transport_send_thread);
+                g_object_unref (task);
+                return;
+        }
+
+        /* The callback is run from the main loop, never from here */
+        payload = rtm_loopback_transport_send (transport, params, cancellable,
+                                               &error);
+        if (payload == NULL) {
+                g_task_return_error (task, error);
+        } else {
+                g_task_return_pointer (task, payload,
+                                       (GDestroyNotify) g_bytes_unref);
+        }
+
+        g_object_unref (task);
+}
+
+static GBytes *
+rtm_loopback_transport_send_finish (RtmTransport *transport,
+                                    GAsyncResult *result, GError **error)
+{
+        g_return_val_if_fail (g_task_is_valid (result, transport), NULL);
+
+        return g_task_propagate_pointer (G_TASK (result), error);
+}
+
+typedef struct {
+        GBytes *payload;
+        gsize offset;
+        RtmTransportChunkFunc chunk_func;
+        gpointer chunk_data;
+} RtmLoopbackTransportStream;
+
+static void
+rtm_loopback_transport_stream_free (gpointer user_data)
+{
+        RtmLoopbackTransportStream *stream = user_data;
+
+        g_bytes_unref (stream->payload);
+
+        g_slice_free (RtmLoopbackTransportStream, stream);
+}
+
+static gboolean
+rtm_loopback_transport_stream_idle (gpointer user_data)
+{
+        GTask *task = G_TASK (user_data);
+        RtmLoopbackTransportStream *stream = g_task_get_task_data (task);
+        RtmLoopbackTransport *transport = g_task_get_source_object (task);
+        const gchar *data;
+        gsize length;
+
+        if (g_task_return_error_if_cancelled (task)) {
+                rtm_loopback_transport_end (transport->priv);
+                return FALSE;
+        }
+
+        data = g_bytes_get_data (stream->payload, &length);
+        if (stream->offset == length) {
+                rtm_loopback_transport_end (transport->priv);
+                g_task_return_boolean (task, TRUE);
+                return FALSE;
+        }
+
+        length = MIN (length - stream->offset,
+                      RTM_LOOPBACK_TRANSPORT_CHUNK_SIZE);
+        stream->chunk_func (data + stream->offset, length,
+                            stream->chunk_data);
+        stream->offset += length;
+
+        return TRUE;
+}
+
+static gboolean
+rtm_loopback_transport_stream_start (gpointer user_data)
+{
+        GTask *task = user_data;
+        GSource *source;
+
+        source = g_idle_source_new ();
+        g_source_set_callback (source, rtm_loopback_transport_stream_idle,
+                               g_object_ref (task), g_object_unref);
+        g_source_attach (source, g_task_get_context (task));
+        g_source_unref (source);
+
+        return FALSE;
+}
+
+static void
+rtm_loopback_transport_send_stream_async (RtmTransport *transport,
+                                          gchar **params,
+                                          RtmTransportChunkFunc chunk_func,
+                                          gpointer chunk_data,
+                                          GCancellable *cancellable,
+                                          GAsyncReadyCallback callback,
+                                          gpointer user_data)
+{
+        GTask *task;
+        GSource *source;
+        RtmLoopbackTransportPrivate *priv = RTM_LOOPBACK_TRANSPORT (transport)->priv;
+        RtmLoopbackTransportStream *stream;
+        GBytes *payload;
+        gint latency;
+        GError *error = NULL;
+
+        task = g_task_new (transport, cancellable, callback, user_data);
+        g_task_set_source_tag (task, rtm_loopback_transport_send_stream_async);
+
+        if (g_task_return_error_if_cancelled (task)) {
+                g_object_unref (task);
+                return;
+        }
+
+        payload = rtm_loopback_transport_lookup (transport, params, &error);
+        if (payload == NULL) {
+                g_task_return_error (task, error);
+                g_object_unref (task);
+                return;
+        }
+        rtm_loopback_transport_begin (priv);
+
+        stream = g_slice_new0 (RtmLoopbackTransportStream);
+        stream->payload = payload;
+        stream->chunk_func = chunk_func;
+        stream->chunk_data = chunk_data;
+        g_task_set_task_data (task, stream,
+                              rtm_loopback_transport_stream_free);
+
+        /* The latency is waited for by the main loop, before any piece */
+        latency = g_atomic_int_get (&priv->latency);
+        if (latency > 0) {
+                source = g_timeout_source_new (latency);
+                g_source_set_callback (source,
+                                       rtm_loopback_transport_stream_start,
+                                       task, g_object_unref);
+        } else {
+                source = g_idle_source_new ();
+                g_source_set_callback (source,
+                                       rtm_loopback_transport_stream_idle,
+                                       task, g_object_unref);
+        }
+        g_source_attach (source, g_task_get_context (task));
+        g_source_unref (source);
+}
+
+static gboolean
+rtm_loopback_transport_send_stream_finish (RtmTransport *transport,
+                                           GAsyncResult *result,
+                                           GError **error)
+{
+        g_return_val_if_fail (g_task_is_valid (result, transport), FALSE);
+
+        return g_task_propagate_boolean (G_TASK (result), error);
+}
+
+static void
+rtm_loopback_transport_transport_init (RtmTransportInterface *iface)
+{
+        iface->send = rtm_loopback_transport_send;
+        iface->send_async = rtm_loopback_transport_send_async;
+        iface->send_finish = rtm_loopback_transport_send_finish;
+        iface->send_stream_async = rtm_loopback_transport_send_stream_async;
+        iface->send_stream_finish = rtm_loopback_transport_send_stream_finish;
+}
@@ -0,0 +1,84 @@
+/*
+ * rtm-loopback-transport.h: Transport serving canned responses from memory
+ *
+ * Copyright (C) 2009 Manuel Rego Casasnovas <mrego@igalia.com>
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301 USA
+ */
+
+#ifndef __RTM_LOOPBACK_TRANSPORT_H__
+#define __RTM_LOOPBACK_TRANSPORT_H__
+
+#include <glib-object.h>
+#include <rtm-glib/rtm-transport.h>
+
+
+G_BEGIN_DECLS
+
+#define RTM_TYPE_LOOPBACK_TRANSPORT (rtm_loopback_transport_get_type ())
+#define RTM_LOOPBACK_TRANSPORT(obj)                                         \
+        (G_TYPE_CHECK_INSTANCE_CAST ((obj), RTM_TYPE_LOOPBACK_TRANSPORT, RtmLoopbackTransport))
+#define RTM_IS_LOOPBACK_TRANSPORT(obj)                              \
+        (G_TYPE_CHECK_INSTANCE_TYPE ((obj), RTM_TYPE_LOOPBACK_TRANSPORT))
+#define RTM_LOOPBACK_TRANSPORT_CLASS(klass)                                 \
+        (G_TYPE_CHECK_CLASS_CAST ((klass), RTM_TYPE_LOOPBACK_TRANSPORT, RtmLoopbackTransportClass))
+#define RTM_IS_LOOPBACK_TRANSPORT_CLASS(klass)                      \
+        (G_TYPE_CHECK_CLASS_TYPE ((klass), RTM_TYPE_LOOPBACK_TRANSPORT))
+#define RTM_LOOPBACK_TRANSPORT_GET_CLASS(obj)                               \
+        (G_TYPE_INSTANCE_GET_CLASS ((obj), RTM_TYPE_LOOPBACK_TRANSPORT, RtmLoopbackTransportClass))
+
+typedef struct _RtmLoopbackTransport RtmLoopbackTransport;
+typedef struct _RtmLoopbackTransportClass RtmLoopbackTransportClass;
+typedef struct _RtmLoopbackTransportPrivate RtmLoopbackTransportPrivate;
+
+struct _RtmLoopbackTransport {
+        GObject parent_instance;
+
+        /*< private >*/
+        RtmLoopbackTransportPrivate *priv;
+};
+
+struct _RtmLoopbackTransportClass {
+        GObjectClass parent_class;
+};
+
+GType
+rtm_loopback_transport_get_type (void) G_GNUC_CONST;
+
+RtmLoopbackTransport *
+rtm_loopback_transport_new (void);
+
+void
+rtm_loopback_transport_add_response (RtmLoopbackTransport *transport,
+                                     const gchar *method,
+                                     const gchar *payload);
+
+void
+rtm_loopback_transport_set_latency (RtmLoopbackTransport *transport,
+                                    guint latency);
+
+void
+rtm_loopback_transport_fail_next (RtmLoopbackTransport *transport,
+                                  guint n_failures);
+
+guint
+rtm_loopback_transport_get_max_in_flight (RtmLoopbackTransport *transport);
+
+guint
+rtm_loopback_transport_get_n_requests (RtmLoopbackTransport *transport);
+
+G_END_DECLS
+
+#endif /* __RTM_LOOPBACK_TRANSPORT_H__ */
@@ -0,0 +1,351 @@
+/*
+ * rtm-method-stats.c: Latency and payload size statistics of a method
+ *
+ * Copyright (C) 2009 Manuel Rego Casasnovas <mrego@igalia.com>
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301 USA
+ */
+
+/**
+ * SECTION:rtm-method-stats
+ * @short_description: Latency and payload size statistics of a method
+ *
+ * A snapshot of the calls made to a method of Remember The Milk API, got
+ * with rtm_glib_get_method_stats().
+ *
+ * The latency of each #RtmMethodPhase of a call, in microseconds, and the
+ * size of the response payload, in bytes, are counted in histograms of
+ * %RTM_METHOD_STATS_N_BUCKETS buckets whose limits grow in powers of two:
+ * bucket 0 counts the zeros and bucket @i the values from 2^(@i - 1) up to
+ * rtm_method_stats_get_bucket_limit(@i). The last bucket also counts every
+ * greater value.
+ */
+
+#include <string.h>
+#include <rtm-method-stats.h>
+#include <rtm-glib-private.h>
+
+struct _RtmMethodStats {
+        gchar *method;
+        guint64 n_calls;
+        guint64 n_errors;
+        guint64 latency[RTM_METHOD_N_PHASES][RTM_METHOD_STATS_N_BUCKETS];
+        guint64 latency_sum[RTM_METHOD_N_PHASES];
+        guint64 payload_size[RTM_METHOD_STATS_N_BUCKETS];
+        guint64 payload_size_sum;
+};
+
+G_DEFINE_BOXED_TYPE (RtmMethodStats, rtm_method_stats,
+                     rtm_method_stats_copy, rtm_method_stats_free);
+
+static guint
+rtm_method_stats_get_bucket (guint64 value)
+{
+        guint bucket = 0;
+
+        while (value > 0 && bucket < RTM_METHOD_STATS_N_BUCKETS - 1) {
+                value >>= 1;
+                bucket++;
+        }
+
+        return bucket;
+}
+
+/**
+ * rtm_method_stats_new:
+ * @method: the method name.
+ *
+ * Creates the empty statistics of @method.
+ *
+ * Returns: a new #RtmMethodStats.
+ */
+RtmMethodStats *
+rtm_method_stats_new (const gchar *method)
+{
+        RtmMethodStats *stats;
+
+        stats = g_slice_new0 (RtmMethodStats);
+        stats->method = g_strdup (method);
+
+        return stats;
+}
+
+/**
+ * rtm_method_stats_add_call:
+ * @stats: a #RtmMethodStats.
+ * @failed: whether the call failed.
+ *
+ * Counts a finished call.
+ */
+void
+rtm_method_stats_add_call (RtmMethodStats *stats, gboolean failed)
+{
+        stats->n_calls++;
+        if (failed) {
+                stats->n_errors++;
+        }
+}
+
+/**
+ * rtm_method_stats_add_latency:
+ * @stats: a #RtmMethodStats.
+ * @phase: the phase of the call.
+ * @latency: the time spent in @phase, in microseconds.
+ *
+ * Counts the latency of a phase of a call.
+ */
+void
+rtm_method_stats_add_latency (RtmMethodStats *stats, RtmMethodPhase phase,
+                              gint64 latency)
+{
+        latency = MAX (latency, 0);
+
+        stats->latency[phase][rtm_method_stats_get_bucket (latency)]++;
+        stats->latency_sum[phase] += latency;
+}
+
+/**
+ * rtm_method_stats_add_payload_size:
+ * @stats: a #RtmMethodStats.
+ * @size: the size of the response payload, in bytes.
+ *
+ * Counts the size of a response.
+ */
+void
+rtm_method_stats_add_payload_size (RtmMethodStats *stats, gsize size)
+{
+        stats->payload_size[rtm_method_stats_get_bucket (size)]++;
+        stats->payload_size_sum += size;
+}
+
+/**
+ * rtm_method_stats_copy:
+ * @stats: a #RtmMethodStats.
+ *
+ * Copies @stats.
+ *
+ * Returns: a new #RtmMethodStats. Free with rtm_method_stats_free().
+ */
+RtmMethodStats *
+rtm_method_stats_copy (const RtmMethodStats *stats)
+{
+        g_return_val_if_fail (stats != NULL, NULL);
+
+        RtmMethodStats *copy;
+
+        copy = g_slice_dup (RtmMethodStats, stats);
+        copy->method = g_strdup (stats->method);
+
+        return copy;
+}
+
+/**
+ * rtm_method_stats_free:
+ * @stats: a #RtmMethodStats.
+ *
+ * Frees @stats.
+ */
+void
+rtm_method_stats_free (RtmMethodStats *stats)
+{
+        g_return_if_fail (stats != NULL);
+
+        g_free (stats->method);
+        g_slice_free (RtmMethodStats, stats);
+}
+
+/**
+ * rtm_method_stats_get_method:
+ * @stats: a #RtmMethodStats.
+ *
+ * Gets the name of the method, for example "rtm.tasks.getList".
+ *
+ * Returns: the method name.
+ */
+const gchar *
+rtm_method_stats_get_method (const RtmMethodStats *stats)
+{
+        g_return_val_if_fail (stats != NULL, NULL);
+
+        return stats->method;
+}
+
+/**
+ * rtm_method_stats_get_n_calls:
+ * @stats: a #RtmMethodStats.
+ *
+ * Gets the number of calls finished. Concurrent calls sharing a request
+ * count as one, and a call retried after an error counts once.
+ *
+ * Returns: the number of calls.
+ */
+guint64
+rtm_method_stats_get_n_calls (const RtmMethodStats *stats)
+{
+        g_return_val_if_fail (stats != NULL, 0);
+
+        return stats->n_calls;
+}
+
+/**
+ * rtm_method_stats_get_n_errors:
+ * @stats: a #RtmMethodStats.
+ *
+ * Gets the number of calls which failed.
+ *
+ * Returns: the number of failed calls.
+ */
+guint64
+rtm_method_stats_get_n_errors (const RtmMethodStats *stats)
+{
+        g_return_val_if_fail (stats != NULL, 0);
+
+        return stats->n_errors;
+}
+
+/**
+ * rtm_method_stats_get_latency_histogram:
+ * @stats: a #RtmMethodStats.
+ * @phase: a #RtmMethodPhase.
+ *
+ * Gets the histogram of the latency of @phase. A call only counts in the
+ * phases it reached.
+ *
+ * Returns: an array of %RTM_METHOD_STATS_N_BUCKETS counters, owned by
+ * @stats.
+ */
+const guint64 *
+rtm_method_stats_get_latency_histogram (const RtmMethodStats *stats,
+                                        RtmMethodPhase phase)
+{
+        g_return_val_if_fail (stats != NULL, NULL);
+        g_return_val_if_fail (phase < RTM_METHOD_N_PHASES, NULL);
+
+        return stats->latency[phase];
+}
+
+/**
+ * rtm_method_stats_get_latency_sum:
+ * @stats: a #RtmMethodStats.
+ * @phase: a #RtmMethodPhase.
+ *
+ * Gets the total time spent in @phase, to compute the mean latency.
+ *
+ * Returns: the time in microseconds.
+ */
+guint64
+rtm_method_stats_get_latency_sum (const RtmMethodStats *stats,
+                                  RtmMethodPhase phase)
+{
+        g_return_val_if_fail (stats != NULL, 0);
+        g_return_val_if_fail (phase < RTM_METHOD_N_PHASES, 0);
+
+        return stats->latency_sum[phase];
+}
+
+/**
+ * rtm_method_stats_get_latency_percentile:
+ * @stats: a #RtmMethodStats.
+ * @phase: a #RtmMethodPhase.
+ * @percentile: the percentile, from 0 to 100.
+ *
+ * Estimates a percentile of the latency of @phase from its histogram.
+ *
+ * Returns: the limit in microseconds of the bucket holding @percentile, or 0
+ * if no call reached @phase.
+ */
+guint64
+rtm_method_stats_get_latency_percentile (const RtmMethodStats *stats,
+                                         RtmMethodPhase phase,
+                                         gdouble percentile)
+{
+        g_return_val_if_fail (stats != NULL, 0);
+        g_return_val_if_fail (phase < RTM_METHOD_N_PHASES, 0);
+        g_return_val_if_fail (percentile >= 0 && percentile <= 100, 0);
+
+        guint64 total = 0, count = 0;
+        gdouble rank;
+        guint bucket;
+
+        for (bucket = 0; bucket < RTM_METHOD_STATS_N_BUCKETS; bucket++) {
+                total += stats->latency[phase][bucket];
+        }
+        if (total == 0) {
+                return 0;
+        }
+
+        rank = total * percentile / 100;
+        for (bucket = 0; bucket < RTM_METHOD_STATS_N_BUCKETS - 1; bucket++) {
+                count += stats->latency[phase][bucket];
+                if (count > 0 && count >= rank) {
+                        break;
+                }
+        }
+
+        return rtm_method_stats_get_bucket_limit (bucket);
+}
+
+/**
+ * rtm_method_stats_get_payload_size_histogram:
+ * @stats: a #RtmMethodStats.
+ *
+ * Gets the histogram of the size of the responses received.
+ *
+ * Returns: an array of %RTM_METHOD_STATS_N_BUCKETS counters, owned by
+ * @stats.
+ */
+const guint64 *
+rtm_method_stats_get_payload_size_histogram (const RtmMethodStats *stats)
+{
+        g_return_val_if_fail (stats != NULL, NULL);
+
+        return stats->payload_size;
+}
+
+/**
+ * rtm_method_stats_get_payload_size_sum:
+ * @stats: a #RtmMethodStats.
+ *
+ * Gets the total size of the responses received.
+ *
+ * Returns: the size in bytes.
+ */
+guint64
+rtm_method_stats_get_payload_size_sum (const RtmMethodStats *stats)
+{
+        g_return_val_if_fail (stats != NULL, 0);
+
+        return stats->payload_size_sum;
+}
+
+/**
+ * rtm_method_stats_get_bucket_limit:
+ * @bucket: the index of a bucket of the histograms.
+ *
+ * Gets the upper limit of a bucket, which counts the values lower than it.
+ *
+ * Returns: the limit, or %G_MAXUINT64 for the last bucket.
+ */
+guint64
+rtm_method_stats_get_bucket_limit (guint bucket)
+{
+        g_return_val_if_fail (bucket < RTM_METHOD_STATS_N_BUCKETS, 0);
+
+        if (bucket == RTM_METHOD_STATS_N_BUCKETS - 1) {
+                return G_MAXUINT64;
+        }
+
+        return G_GUINT64_CONSTANT (1) << bucket;
+}
@@ -0,0 +1,96 @@
+/*
+ * rtm-method-stats.h: Latency and payload size statistics of a method
+ *
+ * Copyright (C) 2009 Manuel Rego Casasnovas <mrego@igalia.com>
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301 USA
+ */
+
+#ifndef __RTM_METHOD_STATS_H__
+#define __RTM_METHOD_STATS_H__
+
+#include <glib-object.h>
+
+
+G_BEGIN_DECLS
+
+#define RTM_TYPE_METHOD_STATS (rtm_method_stats_get_type ())
+
+/* Number of buckets of the histograms, the last one has no upper limit */
+#define RTM_METHOD_STATS_N_BUCKETS 32
+
+/**
+ * RtmMethodPhase:
+ * @RTM_METHOD_PHASE_QUEUE: waiting for the rate limit and the retry backoff.
+ * @RTM_METHOD_PHASE_NETWORK: sending the request and receiving the response.
+ * @RTM_METHOD_PHASE_PARSE: parsing and checking the response.
+ * @RTM_METHOD_PHASE_LOAD: creating the objects from the response.
+ * @RTM_METHOD_N_PHASES: the number of phases.
+ *
+ * The phases of a call whose latency is measured.
+ */
+typedef enum {
+        RTM_METHOD_PHASE_QUEUE,
+        RTM_METHOD_PHASE_NETWORK,
+        RTM_METHOD_PHASE_PARSE,
+        RTM_METHOD_PHASE_LOAD,
+        RTM_METHOD_N_PHASES
+} RtmMethodPhase;
+
+typedef struct _RtmMethodStats RtmMethodStats;
+
+GType
+rtm_method_stats_get_type (void) G_GNUC_CONST;
+
+RtmMethodStats *
+rtm_method_stats_copy (const RtmMethodStats *stats);
+
+void
+rtm_method_stats_free (RtmMethodStats *stats);
+
+const gchar *
+rtm_method_stats_get_method (const RtmMethodStats *stats);
+
+guint64
+rtm_method_stats_get_n_calls (const RtmMethodStats *stats);
+
+guint64
+rtm_method_stats_get_n_errors (const RtmMethodStats *stats);
+
+const guint64 *
+rtm_method_stats_get_latency_histogram (const RtmMethodStats *stats,
+                                        RtmMethodPhase phase);
+
+guint64
+rtm_method_stats_get_latency_sum (const RtmMethodStats *stats,
+                                  RtmMethodPhase phase);
+
+guint64
+rtm_method_stats_get_latency_percentile (const RtmMethodStats *stats,
+                                         RtmMethodPhase phase,
+                                         gdouble percentile);
+
+const guint64 *
+rtm_method_stats_get_payload_size_histogram (const RtmMethodStats *stats);
+
+guint64
+rtm_method_stats_get_payload_size_sum (const RtmMethodStats *stats);
+
+guint64
+rtm_method_stats_get_bucket_limit (guint bucket);
+
+G_END_DECLS
+
+#endif /* __RTM_METHOD_STATS_H__ */
@@ -0,0 +1,204 @@
+/*
+ * rtm-rate-limiter.c: Process-wide rate limiter for API calls
+ *
+ * Copyright (C) 2009 Manuel Rego Casasnovas <mrego@igalia.com>
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301 USA
+ */
+
+/*
+ * Remember The Milk limits the request rate per API key, so every #RtmGlib
+ * object in the process with the same API key shares one token bucket.
+ *
+ * Each call reserves a token and gets back how long it has to wait before
+ * being sent. Tokens can go below zero, so calls made in a burst are spread
+ * out at the configured rate in the order they were reserved instead of all
+ * retrying at the same time. A call dropped before being sent gives its
+ * token back, so the calls reserved after it do not wait for nothing.
+ */
+
+#include <rtm-rate-limiter.h>
+#include <rtm-util.h>
+
+typedef struct {
+        gdouble rate;
+        gdouble burst;
+        gdouble tokens;
+        gint64 last;
+} RtmRateLimiter;
+
+static GMutex rtm_rate_limiter_mutex;
+static GHashTable *rtm_rate_limiters = NULL;
+
+/**
+ * rtm_rate_limiter_lookup:
+ * @key: the API key.
+ *
+ * Gets the token bucket for @key, creating it with the default rate if
+ * needed. Must be called with the mutex held.
+ *
+ * Returns: the #RtmRateLimiter of @key.
+ */
+static RtmRateLimiter *
+rtm_rate_limiter_lookup (const gchar *key)
+{
+        RtmRateLimiter *limiter;
+
+        if (key == NULL) {
+                key = "";
+        }
+
+        if (rtm_rate_limiters == NULL) {
+                rtm_rate_limiters = g_hash_table_new_full (g_str_hash,
+                                                           g_str_equal,
+                                                           g_free, g_free);
+        }
+
+        limiter = g_hash_table_lookup (rtm_rate_limiters, key);
+        if (limiter == NULL) {
+                limiter = g_new0 (RtmRateLimiter, 1);
+                limiter->rate = RTM_RATE_LIMITER_DEFAULT_RATE;
+                limiter->burst = RTM_RATE_LIMITER_DEFAULT_BURST;
+                limiter->tokens = limiter->burst;
+                limiter->last = g_get_monotonic_time ();
+                g_hash_table_insert (rtm_rate_limiters, g_strdup (key),
+                                     limiter);
+        }
+
+        return limiter;
+}
+
+static void
+rtm_rate_limiter_refill (RtmRateLimiter *limiter)
+{
+        gint64 now;
+
+        now = g_get_monotonic_time ();
+        limiter->tokens += (now - limiter->last) * limiter->rate /
+                G_USEC_PER_SEC;
+        limiter->tokens = MIN (limiter->tokens, limiter->burst);
+        limiter->last = now;
+}
+
+/**
+ * rtm_rate_limiter_set_rate:
+ * @key: the API key.
+ * @rate: the average number of requests per second, or 0 for no limit.
+ * @burst: the number of requests that can be sent at once after being idle.
+ *
+ * Sets the rate limit of every call made with @key.
+ */
+void
+rtm_rate_limiter_set_rate (const gchar *key, gdouble rate, guint burst)
+{
+        RtmRateLimiter *limiter;
+
+        g_mutex_lock (&rtm_rate_limiter_mutex);
+
+        limiter = rtm_rate_limiter_lookup (key);
+        rtm_rate_limiter_refill (limiter);
+
+        limiter->rate = MAX (rate, 0);
+        limiter->burst = MAX (burst, 1);
+        limiter->tokens = MIN (limiter->tokens, limiter->burst);
+
+        g_mutex_unlock (&rtm_rate_limiter_mutex);
+}
+
+/**
+ * rtm_rate_limiter_get_rate:
+ * @key: the API key.
+ * @rate: location to store the average number of requests per second, or
+ * %NULL.
+ * @burst: location to store the burst size, or %NULL.
+ *
+ * Gets the rate limit of every call made with @key.
+ */
+void
+rtm_rate_limiter_get_rate (const gchar *key, gdouble *rate, guint *burst)
+{
+        RtmRateLimiter *limiter;
+
+        g_mutex_lock (&rtm_rate_limiter_mutex);
+
+        limiter = rtm_rate_limiter_lookup (key);
+        if (rate) {
+                *rate = limiter->rate;
+        }
+        if (burst) {
+                *burst = (guint) limiter->burst;
+        }
+
+        g_mutex_unlock (&rtm_rate_limiter_mutex);
+}
+
+/**
+ * rtm_rate_limiter_reserve:
+ * @key: the API key.
+ *
+ * Reserves a token for a call made with @key.
+ *
+ * Returns: the time in microseconds the call has to wait before being sent.
+ */
+gint64
+rtm_rate_limiter_reserve (const gchar *key)
+{
+        RtmRateLimiter *limiter;
+        gint64 delay = 0;
+
+        g_mutex_lock (&rtm_rate_limiter_mutex);
+
+        limiter = rtm_rate_limiter_lookup (key);
+        if (limiter->rate > 0) {
+                rtm_rate_limiter_refill (limiter);
+                limiter->tokens -= 1;
+                if (limiter->tokens < 0) {
+                        delay = (gint64) (-limiter->tokens * G_USEC_PER_SEC /
+                                          limiter->rate);
+                }
+        }
+
+        g_mutex_unlock (&rtm_rate_limiter_mutex);
+
+        if (delay > 0) {
+                DEBUG_PRINT ("rtm_rate_limiter: call delayed %" G_GINT64_FORMAT
+                             " us", delay);
+        }
+
+        return delay;
+}
+
+/**
+ * rtm_rate_limiter_refund:
+ * @key: the API key.
+ *
+ * Gives back a token reserved with rtm_rate_limiter_reserve() by a call that
+ * was not sent.
+ */
+void
+rtm_rate_limiter_refund (const gchar *key)
+{
+        RtmRateLimiter *limiter;
+
+        g_mutex_lock (&rtm_rate_limiter_mutex);
+
+        limiter = rtm_rate_limiter_lookup (key);
+        if (limiter->rate > 0) {
+                rtm_rate_limiter_refill (limiter);
+                limiter->tokens = MIN (limiter->tokens + 1, limiter->burst);
+        }
+
+        g_mutex_unlock (&rtm_rate_limiter_mutex);
+}
@@ -0,0 +1,47 @@
+/*
+ * rtm-rate-limiter.h: Process-wide rate limiter for API calls
+ *
+ * Copyright (C) 2009 Manuel Rego Casasnovas <mrego@igalia.com>
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301 USA
+ */
+
+#ifndef __RTM_RATE_LIMITER_H__
+#define __RTM_RATE_LIMITER_H__
+
+#include <glib.h>
+
+
+G_BEGIN_DECLS
+
+/* Remember The Milk asks for an average of one request per second */
+#define RTM_RATE_LIMITER_DEFAULT_RATE 1.0
+#define RTM_RATE_LIMITER_DEFAULT_BURST 3
+
+void
+rtm_rate_limiter_set_rate (const gchar *key, gdouble rate, guint burst);
+
+void
+rtm_rate_limiter_get_rate (const gchar *key, gdouble *rate, guint *burst);
+
+gint64
+rtm_rate_limiter_reserve (const gchar *key);
+
+void
+rtm_rate_limiter_refund (const gchar *key);
+
+G_END_DECLS
+
+#endif /* __RTM_RATE_LIMITER_H__ */
@@ -0,0 +1,502 @@
+/*
+ * rtm-request-queue.c: Queue of API calls with bounded concurrency
+ *
+ * Copyright (C) 2009 Manuel Rego Casasnovas <mrego@igalia.com>
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301 USA
+ */
+
+/**
+ * SECTION:rtm-request-queue
+ * @short_description: A queue of API calls with bounded concurrency
+ *
+ * #RtmRequestQueue accepts any number of method calls of Remember The Milk
+ * API and runs them asynchronously, keeping at most
+ * #RtmRequestQueue:max_in_flight of them in flight at the same time. The
+ * callback of each request is called in completion order.
+ *
+ * Requests are run in the thread-default main context of the thread that
+ * created the queue, so a main loop must be running there, or
+ * rtm_request_queue_wait() must be called to drain the queue.
+ *
+ * Requests are signed when sent, one after another. For large batches,
+ * rtm_request_queue_presign() signs all the pending ones at once using
+ * every processor.
+ */
+
+#include <gio/gio.h>
+#include <rtm-request-queue.h>
+#include <rtm-glib-private.h>
+#include <rtm-util.h>
+
+#define RTM_REQUEST_QUEUE_GET_PRIVATE(obj) (G_TYPE_INSTANCE_GET_PRIVATE (   \
+                                           (obj), RTM_TYPE_REQUEST_QUEUE, RtmRequestQueuePrivate))
+
+#define RTM_REQUEST_QUEUE_DEFAULT_MAX_IN_FLIGHT 4
+
+struct _RtmRequestQueuePrivate {
+        RtmGlib *rtm;
+        guint max_in_flight;
+        guint n_in_flight;
+        GQueue *pending;
+        GCancellable *cancellable;
+        GMainContext *context;
+};
+
+enum {
+        PROP_0,
+
+        PROP_RTM,
+        PROP_MAX_IN_FLIGHT,
+};
+
+typedef struct {
+        RtmRequestQueue *queue;
+        gchar *method;
+        gchar **params;
+        RtmSignature signature;
+        RtmRequestQueueCallback callback;
+        gpointer user_data;
+} RtmRequestQueueItem;
+
+G_DEFINE_TYPE (RtmRequestQueue, rtm_request_queue, G_TYPE_OBJECT);
+
+static void
+rtm_request_queue_item_free (RtmRequestQueueItem *item)
+{
+        g_free (item->method);
+        g_strfreev (item->params);
+        rtm_signature_clear (&item->signature);
+
+        g_slice_free (RtmRequestQueueItem, item);
+}
+
+static void
+rtm_request_queue_get_property (GObject *gobject, guint prop_id, GValue *value,
+                                GParamSpec *pspec)
+{
+        RtmRequestQueuePrivate *priv = RTM_REQUEST_QUEUE_GET_PRIVATE (RTM_REQUEST_QUEUE (gobject));
+
+        switch (prop_id) {
+        case PROP_RTM:
+                g_value_set_object (value, priv->rtm);
+                break;
+
+        case PROP_MAX_IN_FLIGHT:
+                g_value_set_uint (value, priv->max_in_flight);
+                break;
+
+        default:
+                G_OBJECT_WARN_INVALID_PROPERTY_ID (gobject, prop_id,
+                                                   pspec);
+                break;
+        }
+}
+
+static void
+rtm_request_queue_set_property (GObject *gobject, guint prop_id,
+                                const GValue *value, GParamSpec *pspec)
+{
+        RtmRequestQueue *queue = RTM_REQUEST_QUEUE (gobject);
+        RtmRequestQueuePrivate *priv = RTM_REQUEST_QUEUE_GET_PRIVATE (queue);
+
+        switch (prop_id) {
+        case PROP_RTM:
+                priv->rtm = g_value_dup_object (value);
+                break;
+
+        case PROP_MAX_IN_FLIGHT:
+                rtm_request_queue_set_max_in_flight (
+                        queue, g_value_get_uint (value));
+                break;
+
+        default:
+                G_OBJECT_WARN_INVALID_PROPERTY_ID (gobject, prop_id,
+                                                   pspec);
+                break;
+        }
+}
+
+static void
+rtm_request_queue_dispose (GObject *gobject)
+{
+        RtmRequestQueuePrivate *priv = RTM_REQUEST_QUEUE_GET_PRIVATE (RTM_REQUEST_QUEUE (gobject));
+
+        if (priv->rtm) {
+                g_object_unref (priv->rtm);
+                priv->rtm = NULL;
+        }
+
+        if (priv->cancellable) {
+                g_object_unref (priv->cancellable);
+                priv->cancellable = NULL;
+        }
+
+        G_OBJECT_CLASS (rtm_request_queue_parent_class)->dispose (gobject);
+}
+
+static void
+rtm_request_queue_finalize (GObject *gobject)
+{
+        RtmRequestQueuePrivate *priv = RTM_REQUEST_QUEUE_GET_PRIVATE (RTM_REQUEST_QUEUE (gobject));
+
+        /* Requests in flight keep a reference to the queue, so only requests
+         * never dispatched could be here */
+        g_queue_free_full (priv->pending,
+                           (GDestroyNotify) rtm_request_queue_item_free);
+        g_main_context_unref (priv->context);
+
+        G_OBJECT_CLASS (rtm_request_queue_parent_class)->finalize (gobject);
+}
+
+static void
+rtm_request_queue_class_init (RtmRequestQueueClass *klass)
+{
+        GObjectClass *gobject_class = G_OBJECT_CLASS (klass);
+
+        g_type_class_add_private (klass, sizeof (RtmRequestQueuePrivate));
+
+        gobject_class->get_property = rtm_request_queue_get_property;
+        gobject_class->set_property = rtm_request_queue_set_property;
+        gobject_class->dispose = rtm_request_queue_dispose;
+        gobject_class->finalize = rtm_request_queue_finalize;
+
+        g_object_class_install_property (
+                gobject_class,
+                PROP_RTM,
+                g_param_spec_object (
+                        "rtm",
+                        "Rtm",
+                        "The RtmGlib object used to call the methods",
+                        RTM_TYPE_GLIB,
+                        G_PARAM_READWRITE | G_PARAM_CONSTRUCT_ONLY));
+
+        g_object_class_install_property (
+                gobject_class,
+                PROP_MAX_IN_FLIGHT,
+                g_param_spec_uint (
+                        "max_in_flight",
+                        "Max In Flight",
+                        "Maximum number of requests in flight at the same time",
+                        1,
+                        G_MAXUINT,
+                        RTM_REQUEST_QUEUE_DEFAULT_MAX_IN_FLIGHT,
+                        G_PARAM_READWRITE | G_PARAM_CONSTRUCT));
+
+}
+
+static void
+rtm_request_queue_init (RtmRequestQueue *queue)
+{
+        queue->priv = RTM_REQUEST_QUEUE_GET_PRIVATE (queue);
+
+        queue->priv->pending = g_queue_new ();
+        queue->priv->cancellable = g_cancellable_new ();
+        queue->priv->context = g_main_context_ref_thread_default ();
+}
+
+/**
+ * rtm_request_queue_new:
+ * @rtm: a #RtmGlib object used to call the methods.
+ * @max_in_flight: maximum number of requests in flight at the same time.
+ *
+ * Creates a new instance of this class.
+ *
+ * Returns: a new #RtmRequestQueue object.
+ */
+RtmRequestQueue *
+rtm_request_queue_new (RtmGlib *rtm, guint max_in_flight)
+{
+        g_return_val_if_fail (rtm != NULL, NULL);
+        g_return_val_if_fail (max_in_flight > 0, NULL);
+
+        return g_object_new (RTM_TYPE_REQUEST_QUEUE,
+                             "rtm", rtm,
+                             "max_in_flight", max_in_flight,
+                             NULL);
+}
+
+static void
+rtm_request_queue_dispatch (RtmRequestQueue *queue);
+
+static void
+rtm_request_queue_call_cb (GObject *source_object, GAsyncResult *result,
+                           gpointer user_data)
+{
+        RtmRequestQueueItem *item = user_data;
+        RtmRequestQueue *queue = item->queue;
+        RestXmlNode *root;
+        GError *error = NULL;
+
+        root = rtm_glib_call_method_finish (RTM_GLIB (source_object), result,
+                                            &error);
+
+        queue->priv->n_in_flight--;
+        rtm_request_queue_dispatch (queue);
+
+        DEBUG_PRINT ("rtm_request_queue: %s finished, %u in flight",
+                     item->method, queue->priv->n_in_flight);
+
+        item->callback (queue, item->method, root, error, item->user_data);
+
+        if (root != NULL) {
+                rest_xml_node_unref (root);
+        }
+        if (error != NULL) {
+                g_error_free (error);
+        }
+        rtm_request_queue_item_free (item);
+
+        g_object_unref (queue);
+}
+
+/**
+ * rtm_request_queue_dispatch:
+ * @queue: a #RtmRequestQueue object.
+ *
+ * Starts pending requests in push order until the maximum number of requests
+ * in flight is reached.
+ */
+static void
+rtm_request_queue_dispatch (RtmRequestQueue *queue)
+{
+        RtmRequestQueuePrivate *priv = queue->priv;
+        RtmRequestQueueItem *item;
+
+        while (priv->n_in_flight < priv->max_in_flight &&
+               !g_queue_is_empty (priv->pending)) {
+                item = g_queue_pop_head (priv->pending);
+                item->queue = g_object_ref (queue);
+                priv->n_in_flight++;
+
+                if (item->signature.request != NULL) {
+                        rtm_glib_call_method_signed_async (
+                                priv->rtm, item->method, item->params,
+                                &item->signature, priv->cancellable,
+                                rtm_request_queue_call_cb, item);
+                } else {
+                        rtm_glib_call_method_params_async (
+                                priv->rtm, item->method, item->params,
+                                priv->cancellable, rtm_request_queue_call_cb,
+                                item);
+                }
+        }
+}
+
+/**
+ * rtm_request_queue_get_max_in_flight:
+ * @queue: a #RtmRequestQueue object.
+ *
+ * Gets the maximum number of requests in flight at the same time.
+ *
+ * Returns: the maximum number of requests in flight.
+ */
+guint
+rtm_request_queue_get_max_in_flight (RtmRequestQueue *queue)
+{
+        g_return_val_if_fail (queue != NULL, 0);
+
+        return queue->priv->max_in_flight;
+}
+
+/**
+ * rtm_request_queue_set_max_in_flight:
+ * @queue: a #RtmRequestQueue object.
+ * @max_in_flight: maximum number of requests in flight at the same time.
+ *
+ * Sets the maximum number of requests in flight at the same time. If it is
+ * increased, pending requests are started right away. If it is decreased,
+ * requests already in flight are not affected.
+ */
+void
+rtm_request_queue_set_max_in_flight (RtmRequestQueue *queue,
+                                     guint max_in_flight)
+{
+        g_return_if_fail (queue != NULL);
+        g_return_if_fail (max_in_flight > 0);
+
+        queue->priv->max_in_flight = max_in_flight;
+
+        if (queue->priv->rtm != NULL) {
+                rtm_request_queue_dispatch (queue);
+        }
+}
+
+/**
+ * rtm_request_queue_get_n_pending:
+ * @queue: a #RtmRequestQueue object.
+ *
+ * Gets the number of requests whose callback has not been called yet.
+ *
+ * Returns: the number of requests waiting or in flight.
+ */
+guint
+rtm_request_queue_get_n_pending (RtmRequestQueue *queue)
+{
+        g_return_val_if_fail (queue != NULL, 0);
+
+        return queue->priv->n_in_flight +
+                g_queue_get_length (queue->priv->pending);
+}
+
+/**
+ * rtm_request_queue_push:
+ * @queue: a #RtmRequestQueue object.
+ * @method: the method name to be called.
+ * @callback: a #RtmRequestQueueCallback called with the result.
+ * @user_data: the data to pass to callback function.
+ * @Varargs: list of parameters (pairs of name and value) terminated by %NULL.
+ *
+ * Queues a call to a method of Remember The Milk API with the arguments
+ * passed. The method name and parameters are the same ones the web service
+ * expects, the api_key and api_sig parameters are added when sent. The
+ * response is always XML parsed into a tree, a format parameter is ignored.
+ */
+void
+rtm_request_queue_push (RtmRequestQueue *queue, const gchar *method,
+                        RtmRequestQueueCallback callback, gpointer user_data,
+                        ...)
+{
+        g_return_if_fail (queue != NULL);
+        g_return_if_fail (method != NULL);
+        g_return_if_fail (callback != NULL);
+
+        RtmRequestQueueItem *item;
+        va_list args;
+
+        item = g_slice_new0 (RtmRequestQueueItem);
+        item->method = g_strdup (method);
+        item->callback = callback;
+        item->user_data = user_data;
+
+        va_start (args, user_data);
+        item->params = rtm_glib_collect_params (args);
+        va_end (args);
+
+        g_queue_push_tail (queue->priv->pending, item);
+
+        rtm_request_queue_dispatch (queue);
+}
+
+/**
+ * rtm_request_queue_presign:
+ * @queue: a #RtmRequestQueue object.
+ *
+ * Signs every pending request at once, spreading the work over the
+ * processors, so they are sent without signing them one by one. Useful
+ * after pushing a large batch of requests, before running the main loop.
+ */
+void
+rtm_request_queue_presign (RtmRequestQueue *queue)
+{
+        g_return_if_fail (queue != NULL);
+
+        RtmRequestQueuePrivate *priv = queue->priv;
+        RtmRequestQueueItem *item;
+        RtmSignature *signatures;
+        gchar **methods, ***params;
+        GList *link;
+        guint n, i;
+
+        methods = g_new (gchar *, g_queue_get_length (priv->pending));
+        params = g_new (gchar **, g_queue_get_length (priv->pending));
+
+        n = 0;
+        for (link = priv->pending->head; link; link = link->next) {
+                item = link->data;
+                if (item->signature.request == NULL) {
+                        methods[n] = item->method;
+                        params[n] = item->params;
+                        n++;
+                }
+        }
+
+        DEBUG_PRINT ("rtm_request_queue: signing %u requests", n);
+
+        signatures = g_new0 (RtmSignature, n);
+        rtm_glib_presign (priv->rtm, methods, params, signatures, n);
+
+        i = 0;
+        for (link = priv->pending->head; link; link = link->next) {
+                item = link->data;
+                if (item->signature.request == NULL) {
+                        item->signature = signatures[i++];
+                }
+        }
+
+        g_free (signatures);
+        g_free (params);
+        g_free (methods);
+}
+
+/**
+ * rtm_request_queue_cancel:
+ * @queue: a #RtmRequestQueue object.
+ *
+ * Cancels all the requests pushed so far. The callback of every request is
+ * still called, with a %G_IO_ERROR_CANCELLED error. The queue can be used
+ * again afterwards.
+ */
+void
+rtm_request_queue_cancel (RtmRequestQueue *queue)
+{
+        g_return_if_fail (queue != NULL);
+
+        RtmRequestQueuePrivate *priv = queue->priv;
+        RtmRequestQueueItem *item;
+        GQueue *pending;
+        GError *error = NULL;
+
+        g_cancellable_cancel (priv->cancellable);
+        g_object_unref (priv->cancellable);
+        priv->cancellable = g_cancellable_new ();
+
+        /* Callbacks could push new requests, which must not be cancelled */
+        pending = priv->pending;
+        priv->pending = g_queue_new ();
+
+        g_set_error (&error, G_IO_ERROR, G_IO_ERROR_CANCELLED,
+                     "Operation was cancelled");
+
+        g_object_ref (queue);
+        while ((item = g_queue_pop_head (pending)) != NULL) {
+                item->callback (queue, item->method, NULL, error,
+                                item->user_data);
+                rtm_request_queue_item_free (item);
+        }
+        g_object_unref (queue);
+
+        g_queue_free (pending);
+        g_error_free (error);
+}
+
+/**
+ * rtm_request_queue_wait:
+ * @queue: a #RtmRequestQueue object.
+ *
+ * Runs the main context of @queue until the callback of every request pushed
+ * has been called. Useful for programs without a main loop.
+ */
+void
+rtm_request_queue_wait (RtmRequestQueue *queue)
+{
+        g_return_if_fail (queue != NULL);
+
+        g_object_ref (queue);
+        while (rtm_request_queue_get_n_pending (queue) > 0) {
+                g_main_context_iteration (queue->priv->context, TRUE);
+        }
+        g_object_unref (queue);
+}
@@ -0,0 +1,107 @@
+/*
+ * rtm-request-queue.h: Queue of API calls with bounded concurrency
+ *
+ * Copyright (C) 2009 Manuel Rego Casasnovas <mrego@igalia.com>
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301 USA
+ */
+
+#ifndef __RTM_REQUEST_QUEUE_H__
+#define __RTM_REQUEST_QUEUE_H__
+
+#include <glib-object.h>
+#include <rest/rest-xml-parser.h>
+#include <rtm-glib/rtm-glib.h>
+
+
+G_BEGIN_DECLS
+
+#define RTM_TYPE_REQUEST_QUEUE (rtm_request_queue_get_type ())
+#define RTM_REQUEST_QUEUE(obj)                                              \
+        (G_TYPE_CHECK_INSTANCE_CAST ((obj), RTM_TYPE_REQUEST_QUEUE, RtmRequestQueue))
+#define RTM_IS_REQUEST_QUEUE(obj)                                   \
+        (G_TYPE_CHECK_INSTANCE_TYPE ((obj), RTM_TYPE_REQUEST_QUEUE))
+#define RTM_REQUEST_QUEUE_CLASS(klass)                                      \
+        (G_TYPE_CHECK_CLASS_CAST ((klass), RTM_TYPE_REQUEST_QUEUE, RtmRequestQueueClass))
+#define RTM_IS_REQUEST_QUEUE_CLASS(klass)                           \
+        (G_TYPE_CHECK_CLASS_TYPE ((klass), RTM_TYPE_REQUEST_QUEUE))
+#define RTM_REQUEST_QUEUE_GET_CLASS(obj)                                    \
+        (G_TYPE_INSTANCE_GET_CLASS ((obj), RTM_TYPE_REQUEST_QUEUE, RtmRequestQueueClass))
+
+typedef struct _RtmRequestQueue RtmRequestQueue;
+typedef struct _RtmRequestQueueClass RtmRequestQueueClass;
+typedef struct _RtmRequestQueuePrivate RtmRequestQueuePrivate;
+
+struct _RtmRequestQueue {
+        GObject parent_instance;
+
+        /*< private >*/
+        RtmRequestQueuePrivate *priv;
+};
+
+struct _RtmRequestQueueClass {
+        GObjectClass parent_class;
+};
+
+/**
+ * RtmRequestQueueCallback:
+ * @queue: the #RtmRequestQueue.
+ * @method: the method name that was called.
+ * @root: the #RestXmlNode with the method response, or %NULL on error. It is
+ * only valid during the callback, use rest_xml_node_ref() to keep it.
+ * @error: the #GError if the call failed, or %NULL.
+ * @user_data: the data passed to rtm_request_queue_push().
+ *
+ * Called once for each request pushed, in completion order.
+ */
+typedef void (*RtmRequestQueueCallback) (RtmRequestQueue *queue,
+                                         const gchar *method,
+                                         RestXmlNode *root,
+                                         const GError *error,
+                                         gpointer user_data);
+
+GType
+rtm_request_queue_get_type (void) G_GNUC_CONST;
+
+RtmRequestQueue *
+rtm_request_queue_new (RtmGlib *rtm, guint max_in_flight);
+
+guint
+rtm_request_queue_get_max_in_flight (RtmRequestQueue *queue);
+
+void
+rtm_request_queue_set_max_in_flight (RtmRequestQueue *queue,
+                                     guint max_in_flight);
+
+guint
+rtm_request_queue_get_n_pending (RtmRequestQueue *queue);
+
+void
+rtm_request_queue_push (RtmRequestQueue *queue, const gchar *method,
+                        RtmRequestQueueCallback callback, gpointer user_data,
+                        ...) G_GNUC_NULL_TERMINATED;
+
+void
+rtm_request_queue_presign (RtmRequestQueue *queue);
+
+void
+rtm_request_queue_cancel (RtmRequestQueue *queue);
+
+void
+rtm_request_queue_wait (RtmRequestQueue *queue);
+
+G_END_DECLS
+
+#endif /* __RTM_REQUEST_QUEUE_H__ */
@@ -0,0 +1,546 @@
+/*
+ * rtm-request.c: Signed parameters of API calls
+ *
+ * Copyright (C) 2009 Manuel Rego Casasnovas <mrego@igalia.com>
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301 USA
+ */
+
+/*
+ * The api_sig of a call is the MD5 of the shared secret followed by every
+ * parameter name and value, sorted by name, as described at:
+ * http://www.rememberthemilk.com/services/api/authentication.rtm
+ *
+ * A #RtmRequest is the template of the calls to one method with the same
+ * credentials. It keeps its static parameters (the API key, the auth token
+ * and the method name) sorted, together with the checksum state after the
+ * shared secret and each of them. Signing a call sorts the other
+ * parameters in an array on the stack, on the heap if there are more than
+ * %RTM_REQUEST_STACK_PARAMS, and resumes from a copy of the checksum of the
+ * static parameters sorted before all of them, which are usually the API
+ * key and the auth token. No string is copied: the signed parameters are an
+ * array of pointers to the ones of the template, the call and the
+ * signature, so signing costs that array and the checksum copy.
+ */
+
+#include <string.h>
+#include <rtm-request.h>
+#include <rtm-util.h>
+
+/* At most the API key, the auth token and the method name */
+#define RTM_REQUEST_MAX_STATIC 3
+
+/* Parameters of a call sorted on the stack, more are sorted on the heap */
+#define RTM_REQUEST_STACK_PARAMS 16
+
+/* Calls signed by each thread at least, smaller batches are not split */
+#define RTM_REQUEST_BATCH_MIN_RANGE 64
+
+typedef struct {
+        const gchar *name;
+        const gchar *value;
+} RtmRequestParam;
+
+struct _RtmRequest {
+        gint ref_count;
+        gchar *api_key;
+        gchar *method;
+        gchar *auth_token;
+        RtmRequestParam statics[RTM_REQUEST_MAX_STATIC];
+        guint n_statics;
+        GChecksum *prefixes[RTM_REQUEST_MAX_STATIC + 1];
+};
+
+/**
+ * rtm_request_update:
+ * @checksum: a #GChecksum.
+ * @param: a #RtmRequestParam.
+ *
+ * Adds the name and value of @param to @checksum.
+ */
+static void
+rtm_request_update (GChecksum *checksum, const RtmRequestParam *param)
+{
+        g_checksum_update (checksum, (const guchar *) param->name, -1);
+        if (param->value != NULL) {
+                g_checksum_update (checksum, (const guchar *) param->value,
+                                   -1);
+        }
+}
+
+/**
+ * rtm_request_add_static:
+ * @request: a #RtmRequest.
+ * @name: the parameter name.
+ * @value: the parameter value, owned by @request, or %NULL to skip it.
+ *
+ * Inserts a static parameter keeping them sorted by name.
+ */
+static void
+rtm_request_add_static (RtmRequest *request, const gchar *name,
+                        const gchar *value)
+{
+        guint i;
+
+        if (value == NULL) {
+                return;
+        }
+
+        i = request->n_statics++;
+        while (i > 0 && strcmp (request->statics[i - 1].name, name) > 0) {
+                request->statics[i] = request->statics[i - 1];
+                i--;
+        }
+        request->statics[i].name = name;
+        request->statics[i].value = value;
+}
+
+/**
+ * rtm_request_new:
+ * @shared_secret: the shared secret used to sign the calls.
+ * @api_key: the API key.
+ * @method: the method name, or %NULL for a call without it like the login
+ * URL.
+ * @auth_token: the authentication token, or %NULL if the calls do not need
+ * one.
+ *
+ * Creates the template of the calls to @method.
+ *
+ * Returns: a new #RtmRequest. Free with rtm_request_unref().
+ */
+RtmRequest *
+rtm_request_new (const gchar *shared_secret, const gchar *api_key,
+                 const gchar *method, const gchar *auth_token)
+{
+        RtmRequest *request;
+        guint i;
+
+        request = g_slice_new0 (RtmRequest);
+        request->ref_count = 1;
+        request->api_key = g_strdup (api_key);
+        request->method = g_strdup (method);
+        request->auth_token = g_strdup (auth_token);
+
+        rtm_request_add_static (request, "api_key", request->api_key);
+        rtm_request_add_static (request, "auth_token", request->auth_token);
+        rtm_request_add_static (request, "method", request->method);
+
+        request->prefixes[0] = g_checksum_new (G_CHECKSUM_MD5);
+        if (shared_secret != NULL) {
+                g_checksum_update (request->prefixes[0],
+                                   (const guchar *) shared_secret, -1);
+        }
+        for (i = 0; i < request->n_statics; i++) {
+                request->prefixes[i + 1] = g_checksum_copy (
+                        request->prefixes[i]);
+                rtm_request_update (request->prefixes[i + 1],
+                                    &request->statics[i]);
+        }
+
+        return request;
+}
+
+RtmRequest *
+rtm_request_ref (RtmRequest *request)
+{
+        g_atomic_int_inc (&request->ref_count);
+
+        return request;
+}
+
+void
+rtm_request_unref (RtmRequest *request)
+{
+        guint i;
+
+        if (!g_atomic_int_dec_and_test (&request->ref_count)) {
+                return;
+        }
+
+        for (i = 0; i <= request->n_statics; i++) {
+                g_checksum_free (request->prefixes[i]);
+        }
+        g_free (request->api_key);
+        g_free (request->method);
+        g_free (request->auth_token);
+
+        g_slice_free (RtmRequest, request);
+}
+
+/**
+ * rtm_request_get_auth_token:
+ * @request: a #RtmRequest.
+ *
+ * Gets the authentication token of the calls signed with @request.
+ *
+ * Returns: the auth token, or %NULL.
+ */
+const gchar *
+rtm_request_get_auth_token (RtmRequest *request)
+{
+        return request->auth_token;
+}
+
+/**
+ * rtm_request_is_static:
+ * @request: a #RtmRequest.
+ * @name: a parameter name.
+ *
+ * Checks if @name is one of the static parameters of @request, which are
+ * taken from it instead of from the call.
+ *
+ * Returns: %TRUE if @name is static.
+ */
+static gboolean
+rtm_request_is_static (RtmRequest *request, const gchar *name)
+{
+        guint i;
+
+        for (i = 0; i < request->n_statics; i++) {
+                if (strcmp (request->statics[i].name, name) == 0) {
+                        return TRUE;
+                }
+        }
+
+        return FALSE;
+}
+
+/**
+ * rtm_request_digest:
+ * @request: a #RtmRequest.
+ * @params: %NULL-terminated array alternating names and values.
+ * @output: an array with room for every parameter, to fill with them
+ * sorted, or %NULL.
+ * @api_sig: a buffer of %RTM_REQUEST_SIG_LENGTH to fill with the signature.
+ *
+ * Signs a call to @request with @params. Parameters of @params with the
+ * name of a static one are left out. The only allocation is the copy of
+ * the checksum, and the sorting array when there are too many parameters.
+ *
+ * Returns: the number of strings written to @output.
+ */
+static guint
+rtm_request_digest (RtmRequest *request, gchar **params, gchar **output,
+                    gchar *api_sig)
+{
+        RtmRequestParam stack[RTM_REQUEST_STACK_PARAMS];
+        RtmRequestParam *dynamic, *param;
+        GChecksum *checksum;
+        guint n_params, n_dynamic, i, j, k, n;
+
+        n_params = params != NULL ? g_strv_length (params) / 2 : 0;
+        dynamic = n_params <= RTM_REQUEST_STACK_PARAMS ?
+                stack : g_new (RtmRequestParam, n_params);
+
+        /* Insertion sort, calls have a handful of parameters */
+        n_dynamic = 0;
+        for (i = 0; i < n_params; i++) {
+                if (rtm_request_is_static (request, params[2 * i])) {
+                        continue;
+                }
+                j = n_dynamic++;
+                while (j > 0 && strcmp (dynamic[j - 1].name,
+                                        params[2 * i]) > 0) {
+                        dynamic[j] = dynamic[j - 1];
+                        j--;
+                }
+                dynamic[j].name = params[2 * i];
+                dynamic[j].value = params[2 * i + 1];
+        }
+
+        /* Static parameters before every other one are already summed */
+        for (k = 0; k < request->n_statics; k++) {
+                if (n_dynamic > 0 && strcmp (request->statics[k].name,
+                                             dynamic[0].name) > 0) {
+                        break;
+                }
+        }
+        checksum = g_checksum_copy (request->prefixes[k]);
+
+        n = 0;
+        for (i = 0; output != NULL && i < k; i++) {
+                output[n++] = (gchar *) request->statics[i].name;
+                output[n++] = (gchar *) request->statics[i].value;
+        }
+        for (i = 0, j = k; i < n_dynamic || j < request->n_statics; ) {
+                if (i == n_dynamic ||
+                    (j < request->n_statics &&
+                     strcmp (request->statics[j].name,
+                             dynamic[i].name) <= 0)) {
+                        param = &request->statics[j++];
+                } else {
+                        param = &dynamic[i++];
+                }
+                rtm_request_update (checksum, param);
+                if (output != NULL) {
+                        output[n++] = (gchar *) param->name;
+                        output[n++] = (gchar *) param->value;
+                }
+        }
+
+        g_strlcpy (api_sig, g_checksum_get_string (checksum),
+                   RTM_REQUEST_SIG_LENGTH);
+        g_checksum_free (checksum);
+
+        if (dynamic != stack) {
+                g_free (dynamic);
+        }
+
+        return n;
+}
+
+/**
+ * rtm_request_sign:
+ * @request: a #RtmRequest.
+ * @params: %NULL-terminated array alternating names and values.
+ * @signed_params: the #RtmSignedParams to fill.
+ *
+ * Builds the full list of parameters of a call, the static ones of
+ * @request, @params and the api_sig with the signature of all of them.
+ * Parameters of @params with the name of a static one are left out.
+ *
+ * The signed parameters are a newly allocated array pointing to the
+ * strings of @request, @params and @signed_params itself, so @params must
+ * be kept and @signed_params must not be moved until it is cleared with
+ * rtm_signed_params_clear().
+ */
+void
+rtm_request_sign (RtmRequest *request, gchar **params,
+                  RtmSignedParams *signed_params)
+{
+        gchar **output;
+        guint n;
+
+        output = g_new (gchar *, (params != NULL ? g_strv_length (params) : 0)
+                        + 2 * request->n_statics + 3);
+        n = rtm_request_digest (request, params, output,
+                                signed_params->api_sig);
+
+        output[n++] = "api_sig";
+        output[n++] = signed_params->api_sig;
+        output[n] = NULL;
+
+        signed_params->request = rtm_request_ref (request);
+        signed_params->params = output;
+}
+
+/**
+ * rtm_request_assemble:
+ * @signature: a #RtmSignature filled by rtm_request_sign_batch().
+ * @params: the same parameters signed.
+ * @signed_params: the #RtmSignedParams to fill.
+ *
+ * Builds the full list of parameters of a call already signed, like
+ * rtm_request_sign() does but without computing the signature again. The
+ * service does not mind the order of the parameters, so they are not
+ * sorted.
+ */
+void
+rtm_request_assemble (RtmSignature *signature, gchar **params,
+                      RtmSignedParams *signed_params)
+{
+        RtmRequest *request = signature->request;
+        gchar **output;
+        guint i, n;
+
+        output = g_new (gchar *, (params != NULL ? g_strv_length (params) : 0)
+                        + 2 * request->n_statics + 3);
+        n = 0;
+        for (i = 0; i < request->n_statics; i++) {
+                output[n++] = (gchar *) request->statics[i].name;
+                output[n++] = (gchar *) request->statics[i].value;
+        }
+        for (i = 0; params != NULL && params[i] != NULL; i += 2) {
+                if (!rtm_request_is_static (request, params[i])) {
+                        output[n++] = params[i];
+                        output[n++] = params[i + 1];
+                }
+        }
+
+        g_strlcpy (signed_params->api_sig, signature->api_sig,
+                   RTM_REQUEST_SIG_LENGTH);
+        output[n++] = "api_sig";
+        output[n++] = signed_params->api_sig;
+        output[n] = NULL;
+
+        signed_params->request = rtm_request_ref (request);
+        signed_params->params = output;
+}
+
+/*
+ * A batch is split in ranges of calls signed by the workers of a thread
+ * pool shared by the whole process, while the calling thread signs the
+ * last range and waits for the rest.
+ */
+typedef struct {
+        GMutex mutex;
+        GCond cond;
+        guint n_running;
+} RtmRequestBatch;
+
+typedef struct {
+        RtmRequestBatch *batch;
+        gchar ***params;
+        RtmSignature *signatures;
+        guint n;
+} RtmRequestRange;
+
+static void
+rtm_request_sign_range (RtmRequestRange *range)
+{
+        guint i;
+
+        for (i = 0; i < range->n; i++) {
+                rtm_request_digest (range->signatures[i].request,
+                                    range->params[i], NULL,
+                                    range->signatures[i].api_sig);
+        }
+}
+
+static void
+rtm_request_sign_worker (gpointer data, gpointer user_data)
+{
+        RtmRequestRange *range = data;
+        RtmRequestBatch *batch = range->batch;
+
+        rtm_request_sign_range (range);
+
+        g_mutex_lock (&batch->mutex);
+        if (--batch->n_running == 0) {
+                g_cond_signal (&batch->cond);
+        }
+        g_mutex_unlock (&batch->mutex);
+}
+
+/**
+ * rtm_request_get_pool:
+ *
+ * Gets the thread pool that signs batches, creating it the first time with
+ * one thread per processor.
+ *
+ * Returns: the #GThreadPool, or %NULL if there is only one processor.
+ */
+static GThreadPool *
+rtm_request_get_pool (void)
+{
+        static GThreadPool *pool = NULL;
+        static gsize initialized = 0;
+        guint n_processors;
+
+        if (g_once_init_enter (&initialized)) {
+                n_processors = g_get_num_processors ();
+                if (n_processors > 1) {
+                        pool = g_thread_pool_new (rtm_request_sign_worker,
+                                                  NULL, n_processors - 1,
+                                                  FALSE, NULL);
+                }
+                g_once_init_leave (&initialized, 1);
+        }
+
+        return pool;
+}
+
+/**
+ * rtm_request_sign_batch:
+ * @params: the %NULL-terminated arrays alternating names and values of
+ * each call.
+ * @signatures: the #RtmSignature of each call, with the #RtmRequest to sign
+ * it already set.
+ * @n: the number of calls.
+ *
+ * Computes the signature of many calls at once, in parallel when there are
+ * enough of them. Use rtm_request_assemble() to build the parameters to
+ * send.
+ */
+void
+rtm_request_sign_batch (gchar ***params, RtmSignature *signatures, guint n)
+{
+        RtmRequestBatch batch;
+        RtmRequestRange *ranges;
+        GThreadPool *pool;
+        guint n_ranges, size, i;
+
+        pool = rtm_request_get_pool ();
+        n_ranges = pool != NULL ?
+                MIN (g_thread_pool_get_max_threads (pool) + 1,
+                     n / RTM_REQUEST_BATCH_MIN_RANGE) : 1;
+        if (n_ranges <= 1) {
+                RtmRequestRange range = { NULL, params, signatures, n };
+
+                rtm_request_sign_range (&range);
+                return;
+        }
+
+        g_mutex_init (&batch.mutex);
+        g_cond_init (&batch.cond);
+        batch.n_running = n_ranges - 1;
+
+        ranges = g_new (RtmRequestRange, n_ranges);
+        size = (n + n_ranges - 1) / n_ranges;
+        for (i = 0; i < n_ranges; i++) {
+                ranges[i].batch = &batch;
+                ranges[i].params = params + i * size;
+                ranges[i].signatures = signatures + i * size;
+                ranges[i].n = MIN (size, n - i * size);
+        }
+
+        for (i = 0; i < n_ranges - 1; i++) {
+                g_thread_pool_push (pool, &ranges[i], NULL);
+        }
+        rtm_request_sign_range (&ranges[n_ranges - 1]);
+
+        g_mutex_lock (&batch.mutex);
+        while (batch.n_running > 0) {
+                g_cond_wait (&batch.cond, &batch.mutex);
+        }
+        g_mutex_unlock (&batch.mutex);
+
+        g_free (ranges);
+        g_cond_clear (&batch.cond);
+        g_mutex_clear (&batch.mutex);
+}
+
+/**
+ * rtm_signature_clear:
+ * @signature: a #RtmSignature.
+ *
+ * Frees the resources of @signature.
+ */
+void
+rtm_signature_clear (RtmSignature *signature)
+{
+        if (signature->request != NULL) {
+                rtm_request_unref (signature->request);
+                signature->request = NULL;
+        }
+}
+
+/**
+ * rtm_signed_params_clear:
+ * @signed_params: a #RtmSignedParams filled by rtm_request_sign().
+ *
+ * Frees the resources of @signed_params.
+ */
+void
+rtm_signed_params_clear (RtmSignedParams *signed_params)
+{
+        g_free (signed_params->params);
+        signed_params->params = NULL;
+
+        if (signed_params->request != NULL) {
+                rtm_request_unref (signed_params->request);
+                signed_params->request = NULL;
+        }
+}
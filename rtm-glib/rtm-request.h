@@ -0,0 +1,77 @@
+/*
+ * rtm-request.h: Signed parameters of API calls
+ *
+ * Copyright (C) 2009 Manuel Rego Casasnovas <mrego@igalia.com>
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301 USA
+ */
+
+#ifndef __RTM_REQUEST_H__
+#define __RTM_REQUEST_H__
+
+#include <glib.h>
+
+
+G_BEGIN_DECLS
+
+/* Length of an api_sig, an MD5 in hexadecimal, with the ending nul */
+#define RTM_REQUEST_SIG_LENGTH 33
+
+typedef struct _RtmRequest RtmRequest;
+
+typedef struct {
+        RtmRequest *request;
+        gchar **params;
+        gchar api_sig[RTM_REQUEST_SIG_LENGTH];
+} RtmSignedParams;
+
+typedef struct {
+        RtmRequest *request;
+        gchar api_sig[RTM_REQUEST_SIG_LENGTH];
+} RtmSignature;
+
+RtmRequest *
+rtm_request_new (const gchar *shared_secret, const gchar *api_key,
+                 const gchar *method, const gchar *auth_token);
+
+RtmRequest *
+rtm_request_ref (RtmRequest *request);
+
+void
+rtm_request_unref (RtmRequest *request);
+
+const gchar *
+rtm_request_get_auth_token (RtmRequest *request);
+
+void
+rtm_request_sign (RtmRequest *request, gchar **params,
+                  RtmSignedParams *signed_params);
+
+void
+rtm_signed_params_clear (RtmSignedParams *signed_params);
+
+void
+rtm_request_sign_batch (gchar ***params, RtmSignature *signatures, guint n);
+
+void
+rtm_request_assemble (RtmSignature *signature, gchar **params,
+                      RtmSignedParams *signed_params);
+
+void
+rtm_signature_clear (RtmSignature *signature);
+
+G_END_DECLS
+
+#endif /* __RTM_REQUEST_H__ */
@@ -0,0 +1,1057 @@
+/*
+ * rtm-rest-transport.c: Transport over HTTP with librest
+ *
+ * Copyright (C) 2009 Manuel Rego Casasnovas <mrego@igalia.com>
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301 USA
+ */
+
+/**
+ * SECTION:rtm-rest-transport
+ * @short_description: A transport over HTTP with librest
+ *
+ * #RtmRestTransport sends the calls to the Remember The Milk REST endpoint.
+ * Each call takes an HTTP session from a pool and gives it back once the
+ * response is received, so the sessions keep their connections alive
+ * between calls and concurrent calls do not share one. Responses are
+ * requested with gzip or deflate compression and decoded as needed.
+ *
+ * The calls can be sent from any thread. librest handles the sessions from
+ * a main context, so the calls are run there. By default it is the default
+ * main context: a synchronous call iterates it if no other thread owns it,
+ * otherwise it waits for the thread that does to run it. When a
+ * #RtmRestTransport:context is given, the thread iterating it runs the
+ * calls and synchronous calls only wait for them to be done.
+ *
+ * Streamed calls hand out each piece of the payload as libsoup reads it,
+ * without keeping the whole payload. librest only gets the response headers
+ * once the call is finished, so the pieces are decoded as the format of the
+ * body tells, whatever its Content-Encoding.
+ */
+
+#include <rest/rest-proxy.h>
+#include <rtm-rest-transport.h>
+#include <rtm-error.h>
+#include <rtm-inflater.h>
+#include <rtm-util.h>
+
+#define RTM_REST_TRANSPORT_GET_PRIVATE(obj) (G_TYPE_INSTANCE_GET_PRIVATE (  \
+                                           (obj), RTM_TYPE_REST_TRANSPORT, RtmRestTransportPrivate))
+
+#define RTM_REST_TRANSPORT_URL "http://api.rememberthemilk.com/services/rest/"
+
+/* The mutex guards the sessions in the pool and the statistics */
+struct _RtmRestTransportPrivate {
+        gchar *url;
+        GMainContext *context;
+        GMutex mutex;
+        GQueue proxies;
+        guint n_sessions;
+        guint n_sessions_reused;
+        guint64 bytes_received;
+        guint64 bytes_decoded;
+};
+
+enum {
+        PROP_0,
+
+        PROP_URL,
+        PROP_CONTEXT,
+};
+
+/* Only touched from the main context of the sessions, except the result of
+ * a synchronous call, which is guarded by the wait mutex */
+typedef struct {
+        volatile gint ref_count;
+        RtmRestTransport *transport;
+        gchar **params;
+        RestProxy *proxy;
+        RestProxyCall *call;
+        GCancellable *cancellable;
+        gulong cancelled_id;
+        GTask *task;
+        RtmTransportChunkFunc chunk_func;
+        gpointer chunk_data;
+        RtmInflater *inflater;
+        GByteArray *decoded;
+        gboolean completed;
+        gboolean done;
+        GBytes *payload;
+        GError *error;
+} RtmRestTransportCall;
+
+/* Wakes up the threads waiting for a synchronous call */
+static GMutex rtm_rest_transport_wait_mutex;
+static GCond rtm_rest_transport_wait_cond;
+
+/* Checks again if the default main context can be acquired, in case the
+ * thread owning it stops iterating it */
+#define RTM_REST_TRANSPORT_WAIT_INTERVAL (100 * G_TIME_SPAN_MILLISECOND)
+
+static void
+rtm_rest_transport_transport_init (RtmTransportInterface *iface);
+
+G_DEFINE_TYPE_WITH_CODE (RtmRestTransport, rtm_rest_transport, G_TYPE_OBJECT,
+                         G_IMPLEMENT_INTERFACE (RTM_TYPE_TRANSPORT,
+                                                rtm_rest_transport_transport_init));
+
+static void
+rtm_rest_transport_get_property (GObject *gobject, guint prop_id,
+                                 GValue *value, GParamSpec *pspec)
+{
+        RtmRestTransportPrivate *priv = RTM_REST_TRANSPORT_GET_PRIVATE (RTM_REST_TRANSPORT (gobject));
+
+        switch (prop_id) {
+        case PROP_URL:
+                g_value_set_string (value, priv->url);
+                break;
+
+        case PROP_CONTEXT:
+                g_value_set_boxed (value, priv->context);
+                break;
+
+        default:
+                G_OBJECT_WARN_INVALID_PROPERTY_ID (gobject, prop_id,
+                                                   pspec);
+                break;
+        }
+}
+
+static void
+rtm_rest_transport_set_property (GObject *gobject, guint prop_id,
+                                 const GValue *value, GParamSpec *pspec)
+{
+        RtmRestTransportPrivate *priv = RTM_REST_TRANSPORT_GET_PRIVATE (RTM_REST_TRANSPORT (gobject));
+
+        switch (prop_id) {
+        case PROP_URL:
+                g_free (priv->url);
+                priv->url = g_value_dup_string (value);
+                break;
+
+        case PROP_CONTEXT:
+                priv->context = g_value_dup_boxed (value);
+                break;
+
+        default:
+                G_OBJECT_WARN_INVALID_PROPERTY_ID (gobject, prop_id,
+                                                   pspec);
+                break;
+        }
+}
+
+static void
+rtm_rest_transport_dispose (GObject *gobject)
+{
+        RtmRestTransportPrivate *priv = RTM_REST_TRANSPORT_GET_PRIVATE (RTM_REST_TRANSPORT (gobject));
+        RestProxy *proxy;
+
+        while ((proxy = g_queue_pop_head (&priv->proxies)) != NULL) {
+                g_object_unref (proxy);
+        }
+
+        G_OBJECT_CLASS (rtm_rest_transport_parent_class)->dispose (gobject);
+}
+
+static void
+rtm_rest_transport_finalize (GObject *gobject)
+{
+        RtmRestTransportPrivate *priv = RTM_REST_TRANSPORT_GET_PRIVATE (RTM_REST_TRANSPORT (gobject));
+
+        g_free (priv->url);
+        if (priv->context) {
+                g_main_context_unref (priv->context);
+        }
+        g_mutex_clear (&priv->mutex);
+
+        G_OBJECT_CLASS (rtm_rest_transport_parent_class)->finalize (gobject);
+}
+
+static void
+rtm_rest_transport_class_init (RtmRestTransportClass *klass)
+{
+        GObjectClass *gobject_class = G_OBJECT_CLASS (klass);
+
+        g_type_class_add_private (klass, sizeof (RtmRestTransportPrivate));
+
+        gobject_class->get_property = rtm_rest_transport_get_property;
+        gobject_class->set_property = rtm_rest_transport_set_property;
+        gobject_class->dispose = rtm_rest_transport_dispose;
+        gobject_class->finalize = rtm_rest_transport_finalize;
+
+        g_object_class_install_property (
+                gobject_class,
+                PROP_URL,
+                g_param_spec_string (
+                        "url",
+                        "URL",
+                        "The URL of the REST endpoint",
+                        RTM_REST_TRANSPORT_URL,
+                        G_PARAM_READWRITE | G_PARAM_CONSTRUCT_ONLY));
+
+        g_object_class_install_property (
+                gobject_class,
+                PROP_CONTEXT,
+                g_param_spec_boxed (
+                        "context",
+                        "Context",
+                        "The main context running the HTTP sessions, "
+                        "NULL for the default one",
+                        G_TYPE_MAIN_CONTEXT,
+                        G_PARAM_READWRITE | G_PARAM_CONSTRUCT_ONLY));
+
+}
+
+static void
+rtm_rest_transport_init (RtmRestTransport *transport)
+{
+        transport->priv = RTM_REST_TRANSPORT_GET_PRIVATE (transport);
+
+        g_mutex_init (&transport->priv->mutex);
+        g_queue_init (&transport->priv->proxies);
+}
+
+/**
+ * rtm_rest_transport_new:
+ * @url: the URL of the REST endpoint, or %NULL for the Remember The Milk one.
+ *
+ * Creates a new instance of this class.
+ *
+ * Returns: a new #RtmRestTransport object.
+ */
+RtmRestTransport *
+rtm_rest_transport_new (const gchar *url)
+{
+        return g_object_new (RTM_TYPE_REST_TRANSPORT,
+                             "url", url ? url : RTM_REST_TRANSPORT_URL,
+                             NULL);
+}
+
+/**
+ * rtm_rest_transport_new_full:
+ * @url: the URL of the REST endpoint, or %NULL for the Remember The Milk one.
+ * @context: the #GMainContext running the HTTP sessions, or %NULL for the
+ * default one.
+ *
+ * Creates a new instance of this class whose calls are run from @context.
+ * Some thread must be iterating @context, synchronous calls never do.
+ *
+ * Returns: a new #RtmRestTransport object.
+ */
+RtmRestTransport *
+rtm_rest_transport_new_full (const gchar *url, GMainContext *context)
+{
+        return g_object_new (RTM_TYPE_REST_TRANSPORT,
+                             "url", url ? url : RTM_REST_TRANSPORT_URL,
+                             "context", context,
+                             NULL);
+}
+
+/**
+ * rtm_rest_transport_get_connection_stats:
+ * @transport: a #RtmRestTransport object.
+ * @sessions: location to store the number of HTTP sessions created, or
+ * %NULL.
+ * @reused: location to store the number of calls that took an already
+ * created HTTP session from the pool, or %NULL.
+ *
+ * Gets the session statistics of @transport. A new session is only created
+ * when all the sessions in the pool are busy and after a transport error.
+ *
+ * These count the #RestProxy sessions of the pool, not TCP connections: a
+ * reused session only keeps its connection if the server left it open.
+ */
+void
+rtm_rest_transport_get_connection_stats (RtmRestTransport *transport,
+                                         guint *sessions, guint *reused)
+{
+        g_return_if_fail (transport != NULL);
+
+        g_mutex_lock (&transport->priv->mutex);
+
+        if (sessions) {
+                *sessions = transport->priv->n_sessions;
+        }
+        if (reused) {
+                *reused = transport->priv->n_sessions_reused;
+        }
+
+        g_mutex_unlock (&transport->priv->mutex);
+}
+
+/**
+ * rtm_rest_transport_get_transfer_stats:
+ * @transport: a #RtmRestTransport object.
+ * @compressed: location to store the number of bytes received, or %NULL.
+ * @uncompressed: location to store the number of bytes once decompressed,
+ * or %NULL.
+ *
+ * Gets the size of all the responses received by @transport.
+ */
+void
+rtm_rest_transport_get_transfer_stats (RtmRestTransport *transport,
+                                       guint64 *compressed,
+                                       guint64 *uncompressed)
+{
+        g_return_if_fail (transport != NULL);
+
+        g_mutex_lock (&transport->priv->mutex);
+
+        if (compressed) {
+                *compressed = transport->priv->bytes_received;
+        }
+        if (uncompressed) {
+                *uncompressed = transport->priv->bytes_decoded;
+        }
+
+        g_mutex_unlock (&transport->priv->mutex);
+}
+
+/**
+ * rtm_rest_transport_take_proxy:
+ * @transport: a #RtmRestTransport object.
+ *
+ * Takes an idle session from the pool, or opens a new one if all of them are
+ * busy.
+ *
+ * Returns: a #RestProxy to be given back with
+ * rtm_rest_transport_release_proxy().
+ */
+static RestProxy *
+rtm_rest_transport_take_proxy (RtmRestTransport *transport)
+{
+        RtmRestTransportPrivate *priv = transport->priv;
+        RestProxy *proxy;
+
+        g_mutex_lock (&priv->mutex);
+
+        proxy = g_queue_pop_head (&priv->proxies);
+        if (proxy == NULL) {
+                priv->n_sessions++;
+        } else {
+                priv->n_sessions_reused++;
+        }
+
+        g_mutex_unlock (&priv->mutex);
+
+        if (proxy == NULL) {
+                proxy = rest_proxy_new (priv->url, FALSE);
+        }
+
+        return proxy;
+}
+
+/**
+ * rtm_rest_transport_release_proxy:
+ * @transport: a #RtmRestTransport object.
+ * @proxy: a #RestProxy taken with rtm_rest_transport_take_proxy().
+ *
+ * Puts @proxy back in the pool. The most recently used session is the
+ * first one taken, as its connection is the most likely to be still open.
+ */
+static void
+rtm_rest_transport_release_proxy (RtmRestTransport *transport,
+                                  RestProxy *proxy)
+{
+        g_mutex_lock (&transport->priv->mutex);
+        g_queue_push_head (&transport->priv->proxies, proxy);
+        g_mutex_unlock (&transport->priv->mutex);
+}
+
+/**
+ * rtm_rest_transport_new_call:
+ * @proxy: the #RestProxy of the session.
+ * @params: %NULL-terminated array alternating names and values.
+ *
+ * Creates a #RestProxyCall on @proxy, asking for a compressed response.
+ *
+ * Returns: a new #RestProxyCall ready to be run.
+ */
+static RestProxyCall *
+rtm_rest_transport_new_call (RestProxy *proxy, gchar **params)
+{
+        RestProxyCall *call;
+        guint i;
+
+        call = rest_proxy_new_call (proxy);
+
+        rest_proxy_call_add_header (call, "Accept-Encoding",
+                                    RTM_INFLATER_ACCEPT_ENCODING);
+
+        for (i = 0; params[i] != NULL; i += 2) {
+                rest_proxy_call_add_param (call, params[i], params[i + 1]);
+        }
+
+        return call;
+}
+
+/**
+ * rtm_rest_transport_fail:
+ * @error: a #GError to be filled.
+ * @call_error: the #GError returned by the #RestProxyCall.
+ *
+ * Translates an error of the HTTP transport into a #RtmError.
+ */
+static void
+rtm_rest_transport_fail (GError **error, const GError *call_error)
+{
+        RtmError code = RTM_ERROR_NETWORK;
+
+        if (call_error->domain == REST_PROXY_ERROR &&
+            call_error->code >= REST_PROXY_ERROR_HTTP_INTERNAL_SERVER_ERROR) {
+                code = RTM_ERROR_SERVICE_UNAVAILABLE;
+        } else if (call_error->domain == REST_PROXY_ERROR &&
+                   call_error->code > REST_PROXY_ERROR_FAILED) {
+                code = RTM_ERROR_RESPONSE_FAIL;
+        }
+
+        g_set_error (error, RTM_ERROR_DOMAIN, code, "%s",
+                     call_error->message);
+}
+
+/**
+ * rtm_rest_transport_get_payload:
+ * @transport: a #RtmRestTransport object.
+ * @call: a #RestProxyCall already run.
+ * @error: location to store #GError or %NULL.
+ *
+ * Gets the payload of @call, decompressing it if needed.
+ *
+ * Returns: the response payload, or %NULL if it is corrupt.
+ */
+static GBytes *
+rtm_rest_transport_get_payload (RtmRestTransport *transport,
+                                RestProxyCall *call, GError **error)
+{
+        RtmRestTransportPrivate *priv = transport->priv;
+        RtmInflater *inflater;
+        GByteArray *decoded;
+        const gchar *payload;
+        gsize length;
+        GError *tmp_error = NULL;
+
+        payload = rest_proxy_call_get_payload (call);
+        length = rest_proxy_call_get_payload_length (call);
+
+        inflater = rtm_inflater_new (
+                rest_proxy_call_lookup_response_header (call,
+                                                        "Content-Encoding"));
+        if (inflater == NULL) {
+                g_mutex_lock (&priv->mutex);
+                priv->bytes_received += length;
+                priv->bytes_decoded += length;
+                g_mutex_unlock (&priv->mutex);
+
+                return g_bytes_new (payload, length);
+        }
+
+        decoded = g_byte_array_sized_new (length * 4);
+        if (!rtm_inflater_feed (inflater, payload, length, decoded,
+                                &tmp_error) ||
+            !rtm_inflater_finish (inflater, decoded, &tmp_error)) {
+                rtm_inflater_free (inflater);
+                g_byte_array_free (decoded, TRUE);
+
+                g_set_error (error,
+                             RTM_ERROR_DOMAIN,
+                             RTM_ERROR_NETWORK,
+                             "Corrupt compressed response: %s",
+                             tmp_error->message);
+                g_error_free (tmp_error);
+                return NULL;
+        }
+        rtm_inflater_free (inflater);
+
+        g_mutex_lock (&priv->mutex);
+        priv->bytes_received += length;
+        priv->bytes_decoded += decoded->len;
+        g_mutex_unlock (&priv->mutex);
+
+        return g_byte_array_free_to_bytes (decoded);
+}
+
+static RtmRestTransportCall *
+rtm_rest_transport_call_new (RtmRestTransport *transport, gchar **params,
+                             GCancellable *cancellable)
+{
+        RtmRestTransportCall *data;
+
+        data = g_slice_new0 (RtmRestTransportCall);
+        data->ref_count = 1;
+        data->transport = g_object_ref (transport);
+        data->params = g_strdupv (params);
+        if (cancellable) {
+                data->cancellable = g_object_ref (cancellable);
+        }
+
+        return data;
+}
+
+static RtmRestTransportCall *
+rtm_rest_transport_call_ref (RtmRestTransportCall *data)
+{
+        g_atomic_int_inc (&data->ref_count);
+
+        return data;
+}
+
+static void
+rtm_rest_transport_call_unref (RtmRestTransportCall *data)
+{
+        if (!g_atomic_int_dec_and_test (&data->ref_count)) {
+                return;
+        }
+
+        if (data->cancellable) {
+                g_object_unref (data->cancellable);
+        }
+        if (data->call) {
+                g_object_unref (data->call);
+        }
+        if (data->proxy) {
+                g_object_unref (data->proxy);
+        }
+        if (data->payload) {
+                g_bytes_unref (data->payload);
+        }
+        if (data->error) {
+                g_error_free (data->error);
+        }
+        if (data->inflater) {
+                rtm_inflater_free (data->inflater);
+        }
+        if (data->decoded) {
+                g_byte_array_free (data->decoded, TRUE);
+        }
+        g_strfreev (data->params);
+        g_object_unref (data->transport);
+
+        g_slice_free (RtmRestTransportCall, data);
+}
+
+/**
+ * rtm_rest_transport_call_complete:
+ * @data: a #RtmRestTransportCall.
+ * @call_error: the #GError returned by the #RestProxyCall, or %NULL.
+ *
+ * Gets the result of @data and hands it to the caller, only once. The
+ * session goes back to the pool if the call succeeded; otherwise it is
+ * dropped, so a connection that could be broken is not reused. Runs in the
+ * main context of the sessions.
+ */
+static void
+rtm_rest_transport_call_complete (RtmRestTransportCall *data,
+                                  const GError *call_error)
+{
+        GBytes *payload = NULL;
+        GError *error = NULL;
+
+        if (data->completed) {
+                return;
+        }
+        data->completed = TRUE;
+
+        if (data->cancelled_id) {
+                g_cancellable_disconnect (data->cancellable,
+                                          data->cancelled_id);
+                data->cancelled_id = 0;
+        }
+
+        if (g_cancellable_set_error_if_cancelled (data->cancellable,
+                                                  &error)) {
+                if (data->call) {
+                        rest_proxy_call_cancel (data->call);
+                }
+        } else if (call_error != NULL) {
+                rtm_rest_transport_fail (&error, call_error);
+        } else if (data->chunk_func != NULL) {
+                rtm_rest_transport_release_proxy (data->transport,
+                                                  data->proxy);
+                data->proxy = NULL;
+        } else {
+                payload = rtm_rest_transport_get_payload (data->transport,
+                                                          data->call,
+                                                          &error);
+                rtm_rest_transport_release_proxy (data->transport,
+                                                  data->proxy);
+                data->proxy = NULL;
+        }
+
+        /* The payload of a streamed call has already been handed out */
+        if (data->chunk_func != NULL) {
+                if (error != NULL) {
+                        g_task_return_error (data->task, error);
+                } else {
+                        g_task_return_boolean (data->task, TRUE);
+                }
+                g_object_unref (data->task);
+                data->task = NULL;
+                return;
+        }
+
+        if (data->task) {
+                /* The task returns in the main context of its caller */
+                if (payload == NULL) {
+                        g_task_return_error (data->task, error);
+                } else {
+                        g_task_return_pointer (data->task, payload,
+                                               (GDestroyNotify) g_bytes_unref);
+                }
+                g_object_unref (data->task);
+                data->task = NULL;
+                return;
+        }
+
+        g_mutex_lock (&rtm_rest_transport_wait_mutex);
+        data->payload = payload;
+        data->error = error;
+        data->done = TRUE;
+        g_cond_broadcast (&rtm_rest_transport_wait_cond);
+        g_mutex_unlock (&rtm_rest_transport_wait_mutex);
+}
+
+static gboolean
+rtm_rest_transport_cancel_idle (gpointer user_data)
+{
+        rtm_rest_transport_call_complete (user_data, NULL);
+
+        return FALSE;
+}
+
+static void
+rtm_rest_transport_cancelled_cb (GCancellable *cancellable,
+                                 RtmRestTransportCall *data)
+{
+        GSource *source;
+
+        /* Cancelled from any thread, so the call is aborted in the main
+         * context of the sessions. It can not be completed from inside the
+         * "cancelled" handler either, as that would disconnect the handler
+         * while it is running */
+        source = g_idle_source_new ();
+        g_source_set_callback (source, rtm_rest_transport_cancel_idle,
+                               rtm_rest_transport_call_ref (data),
+                               (GDestroyNotify) rtm_rest_transport_call_unref);
+        g_source_attach (source, data->transport->priv->context);
+        g_source_unref (source);
+}
+
+static void
+rtm_rest_transport_call_cb (RestProxyCall *call, const GError *error,
+                            GObject *weak_object, gpointer user_data)
+{
+        RtmRestTransportCall *data = user_data;
+
+        rtm_rest_transport_call_complete (data, error);
+        rtm_rest_transport_call_unref (data);
+}
+
+/* A piece of the payload of a streamed call, handed out in the main context
+ * of the caller */
+typedef struct {
+        RtmRestTransportCall *data;
+        GBytes *chunk;
+} RtmRestTransportChunk;
+
+static gboolean
+rtm_rest_transport_chunk_idle (gpointer user_data)
+{
+        RtmRestTransportChunk *chunk = user_data;
+        gconstpointer data;
+        gsize length;
+
+        data = g_bytes_get_data (chunk->chunk, &length);
+        chunk->data->chunk_func (data, length, chunk->data->chunk_data);
+
+        return FALSE;
+}
+
+static void
+rtm_rest_transport_chunk_free (gpointer user_data)
+{
+        RtmRestTransportChunk *chunk = user_data;
+
+        rtm_rest_transport_call_unref (chunk->data);
+        g_bytes_unref (chunk->chunk);
+
+        g_slice_free (RtmRestTransportChunk, chunk);
+}
+
+/**
+ * rtm_rest_transport_hand_out:
+ * @data: a streamed #RtmRestTransportCall.
+ * @buf: the piece of the payload just read.
+ * @len: the length of @buf.
+ *
+ * Hands @buf out to the caller. It is copied if the caller runs in another
+ * main context than the sessions; the pieces and the result are then
+ * queued in order there.
+ */
+static void
+rtm_rest_transport_hand_out (RtmRestTransportCall *data, const gchar *buf,
+                             gsize len)
+{
+        RtmRestTransportPrivate *priv = data->transport->priv;
+        RtmRestTransportChunk *chunk;
+        GMainContext *context;
+        GSource *source;
+
+        context = g_task_get_context (data->task);
+        if (context == priv->context ||
+            (priv->context == NULL && context == g_main_context_default ())) {
+                data->chunk_func (buf, len, data->chunk_data);
+                return;
+        }
+
+        chunk = g_slice_new (RtmRestTransportChunk);
+        chunk->data = rtm_rest_transport_call_ref (data);
+        chunk->chunk = g_bytes_new (buf, len);
+
+        source = g_idle_source_new ();
+        g_source_set_callback (source, rtm_rest_transport_chunk_idle, chunk,
+                               rtm_rest_transport_chunk_free);
+        g_source_attach (source, context);
+        g_source_unref (source);
+}
+
+/**
+ * rtm_rest_transport_decode:
+ * @data: a streamed #RtmRestTransportCall.
+ * @buf: the piece of the payload just read, or %NULL at the end.
+ * @len: the length of @buf.
+ * @error: location to store #GError or %NULL.
+ *
+ * Decodes @buf and hands out what it decodes to, if anything. At the end
+ * the data still buffered by the decoder is handed out.
+ *
+ * Returns: %TRUE on success, %FALSE if the payload is corrupt.
+ */
+static gboolean
+rtm_rest_transport_decode (RtmRestTransportCall *data, const gchar *buf,
+                           gsize len, GError **error)
+{
+        RtmRestTransportPrivate *priv = data->transport->priv;
+        gboolean decoded;
+        GError *tmp_error = NULL;
+
+        g_byte_array_set_size (data->decoded, 0);
+        if (buf != NULL) {
+                decoded = rtm_inflater_feed (data->inflater, buf, len,
+                                             data->decoded, &tmp_error);
+        } else {
+                decoded = rtm_inflater_finish (data->inflater, data->decoded,
+                                               &tmp_error);
+        }
+
+        g_mutex_lock (&priv->mutex);
+        priv->bytes_received += len;
+        priv->bytes_decoded += data->decoded->len;
+        g_mutex_unlock (&priv->mutex);
+
+        if (!decoded) {
+                g_set_error (error,
+                             RTM_ERROR_DOMAIN,
+                             RTM_ERROR_NETWORK,
+                             "Corrupt compressed response: %s",
+                             tmp_error->message);
+                g_error_free (tmp_error);
+                return FALSE;
+        }
+
+        if (data->decoded->len > 0) {
+                rtm_rest_transport_hand_out (data,
+                                             (const gchar *) data->decoded->data,
+                                             data->decoded->len);
+        }
+
+        return TRUE;
+}
+
+static void
+rtm_rest_transport_stream_cb (RestProxyCall *call, const gchar *buf,
+                              gsize len, const GError *error,
+                              GObject *weak_object, gpointer user_data)
+{
+        RtmRestTransportCall *data = user_data;
+        GError *decode_error = NULL;
+
+        /* librest ends the call with an empty piece. A corrupt piece ends
+         * the call at once, the rest of the payload is ignored */
+        if (buf != NULL && len > 0) {
+                if (!data->completed &&
+                    !rtm_rest_transport_decode (data, buf, len,
+                                                &decode_error)) {
+                        rtm_rest_transport_call_complete (data, decode_error);
+                        g_error_free (decode_error);
+                }
+                return;
+        }
+
+        if (error == NULL && !data->completed &&
+            !rtm_rest_transport_decode (data, NULL, 0, &decode_error)) {
+                error = decode_error;
+        }
+
+        rtm_rest_transport_call_complete (data, error);
+        rtm_rest_transport_call_unref (data);
+
+        if (decode_error) {
+                g_error_free (decode_error);
+        }
+}
+
+/**
+ * rtm_rest_transport_call_start:
+ * @user_data: a #RtmRestTransportCall.
+ *
+ * Takes a session and starts the call. Runs in the main context of the
+ * sessions, as librest does not allow to use them from other threads. It is
+ * made the thread-default context meanwhile, so the session queues the
+ * call there.
+ *
+ * Returns: %FALSE, to be used as a #GSourceFunc.
+ */
+static gboolean
+rtm_rest_transport_call_start (gpointer user_data)
+{
+        RtmRestTransportCall *data = user_data;
+        GMainContext *context = data->transport->priv->context;
+        gboolean started;
+        GError *tmp_error = NULL;
+
+        if (data->completed ||
+            g_cancellable_is_cancelled (data->cancellable)) {
+                rtm_rest_transport_call_complete (data, NULL);
+                return FALSE;
+        }
+
+        if (context) {
+                g_main_context_push_thread_default (context);
+        }
+
+        data->proxy = rtm_rest_transport_take_proxy (data->transport);
+        data->call = rtm_rest_transport_new_call (data->proxy, data->params);
+
+        if (data->chunk_func != NULL) {
+                data->inflater = rtm_inflater_new_any ();
+                data->decoded = g_byte_array_new ();
+                started = rest_proxy_call_continuous (
+                        data->call, rtm_rest_transport_stream_cb, NULL,
+                        rtm_rest_transport_call_ref (data), &tmp_error);
+        } else {
+                started = rest_proxy_call_async (
+                        data->call, rtm_rest_transport_call_cb, NULL,
+                        rtm_rest_transport_call_ref (data), &tmp_error);
+        }
+
+        if (!started) {
+                /* Drop the reference passed to the callback */
+                rtm_rest_transport_call_unref (data);
+
+                rtm_rest_transport_call_complete (data, tmp_error);
+                g_error_free (tmp_error);
+        }
+
+        if (context) {
+                g_main_context_pop_thread_default (context);
+        }
+
+        return FALSE;
+}
+
+/**
+ * rtm_rest_transport_call_is_done:
+ * @data: a synchronous #RtmRestTransportCall.
+ *
+ * Checks if @data has got its result, maybe from another thread.
+ *
+ * Returns: %TRUE if the call is done.
+ */
+static gboolean
+rtm_rest_transport_call_is_done (RtmRestTransportCall *data)
+{
+        gboolean done;
+
+        g_mutex_lock (&rtm_rest_transport_wait_mutex);
+        done = data->done;
+        g_mutex_unlock (&rtm_rest_transport_wait_mutex);
+
+        return done;
+}
+
+/**
+ * rtm_rest_transport_call_wait:
+ * @data: a synchronous #RtmRestTransportCall already started.
+ *
+ * Waits for @data to be done. The default main context is iterated if no
+ * other thread owns it, which runs the calls of all the threads; the others
+ * sleep until their call is done or the context is released. A context
+ * given to the transport is never iterated here.
+ */
+static void
+rtm_rest_transport_call_wait (RtmRestTransportCall *data)
+{
+        gboolean iterate = (data->transport->priv->context == NULL);
+
+        g_mutex_lock (&rtm_rest_transport_wait_mutex);
+
+        while (!data->done) {
+                if (iterate && g_main_context_acquire (NULL)) {
+                        g_mutex_unlock (&rtm_rest_transport_wait_mutex);
+
+                        while (!rtm_rest_transport_call_is_done (data)) {
+                                g_main_context_iteration (NULL, TRUE);
+                        }
+                        g_main_context_release (NULL);
+
+                        /* Another thread can iterate it now */
+                        g_mutex_lock (&rtm_rest_transport_wait_mutex);
+                        g_cond_broadcast (&rtm_rest_transport_wait_cond);
+                } else {
+                        g_cond_wait_until (
+                                &rtm_rest_transport_wait_cond,
+                                &rtm_rest_transport_wait_mutex,
+                                g_get_monotonic_time () +
+                                RTM_REST_TRANSPORT_WAIT_INTERVAL);
+                }
+        }
+
+        g_mutex_unlock (&rtm_rest_transport_wait_mutex);
+}
+
+/**
+ * rtm_rest_transport_call_dispatch:
+ * @data: a #RtmRestTransportCall.
+ *
+ * Starts @data from the main context of the sessions, right away if the
+ * current thread can own it.
+ */
+static void
+rtm_rest_transport_call_dispatch (RtmRestTransportCall *data)
+{
+        if (data->cancellable) {
+                data->cancelled_id = g_cancellable_connect (
+                        data->cancellable,
+                        G_CALLBACK (rtm_rest_transport_cancelled_cb),
+                        data, NULL);
+        }
+
+        g_main_context_invoke_full (
+                data->transport->priv->context, G_PRIORITY_DEFAULT,
+                rtm_rest_transport_call_start,
+                rtm_rest_transport_call_ref (data),
+                (GDestroyNotify) rtm_rest_transport_call_unref);
+}
+
+static GBytes *
+rtm_rest_transport_send (RtmTransport *transport, gchar **params,
+                         GCancellable *cancellable, GError **error)
+{
+        RtmRestTransportCall *data;
+        GBytes *payload;
+
+        if (g_cancellable_set_error_if_cancelled (cancellable, error)) {
+                return NULL;
+        }
+
+        data = rtm_rest_transport_call_new (RTM_REST_TRANSPORT (transport),
+                                            params, cancellable);
+
+        rtm_rest_transport_call_dispatch (data);
+        rtm_rest_transport_call_wait (data);
+
+        payload = data->payload;
+        data->payload = NULL;
+        if (payload == NULL) {
+                g_propagate_error (error, data->error);
+                data->error = NULL;
+        }
+
+        rtm_rest_transport_call_unref (data);
+
+        return payload;
+}
+
+static void
+rtm_rest_transport_send_async (RtmTransport *transport, gchar **params,
+                               GCancellable *cancellable,
+                               GAsyncReadyCallback callback,
+                               gpointer user_data)
+{
+        GTask *task;
+        RtmRestTransportCall *data;
+
+        task = g_task_new (transport, cancellable, callback, user_data);
+        g_task_set_source_tag (task, rtm_rest_transport_send_async);
+
+        data = rtm_rest_transport_call_new (RTM_REST_TRANSPORT (transport),
+                                            params, cancellable);
+        data->task = task;
+
+        rtm_rest_transport_call_dispatch (data);
+        rtm_rest_transport_call_unref (data);
+}
+
+static GBytes *
+rtm_rest_transport_send_finish (RtmTransport *transport,
+                                GAsyncResult *result, GError **error)
+{
+        g_return_val_if_fail (g_task_is_valid (result, transport), NULL);
+
+        return g_task_propagate_pointer (G_TASK (result), error);
+}
+
+static void
+rtm_rest_transport_send_stream_async (RtmTransport *transport, gchar **params,
+                                      RtmTransportChunkFunc chunk_func,
+                                      gpointer chunk_data,
+                                      GCancellable *cancellable,
+                                      GAsyncReadyCallback callback,
+                                      gpointer user_data)
+{
+        GTask *task;
+        RtmRestTransportCall *data;
+
+        task = g_task_new (transport, cancellable, callback, user_data);
+        g_task_set_source_tag (task, rtm_rest_transport_send_stream_async);
+
+        data = rtm_rest_transport_call_new (RTM_REST_TRANSPORT (transport),
+                                            params, cancellable);
+        data->task = task;
+        data->chunk_func = chunk_func;
+        data->chunk_data = chunk_data;
+
+        rtm_rest_transport_call_dispatch (data);
+        rtm_rest_transport_call_unref (data);
+}
+
+static gboolean
+rtm_rest_transport_send_stream_finish (RtmTransport *transport,
+                                       GAsyncResult *result, GError **error)
+{
+        g_return_val_if_fail (g_task_is_valid (result, transport), FALSE);
+
+        return g_task_propagate_boolean (G_TASK (result), error);
+}
+
+static void
+rtm_rest_transport_transport_init (RtmTransportInterface *iface)
+{
+        iface->send = rtm_rest_transport_send;
+        iface->send_async = rtm_rest_transport_send_async;
+        iface->send_finish = rtm_rest_transport_send_finish;
+        iface->send_stream_async = rtm_rest_transport_send_stream_async;
+        iface->send_stream_finish = rtm_rest_transport_send_stream_finish;
+}
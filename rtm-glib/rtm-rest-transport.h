@@ -0,0 +1,77 @@
+/*
+ * rtm-rest-transport.h: Transport over HTTP with librest
+ *
+ * Copyright (C) 2009 Manuel Rego Casasnovas <mrego@igalia.com>
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301 USA
+ */
+
+#ifndef __RTM_REST_TRANSPORT_H__
+#define __RTM_REST_TRANSPORT_H__
+
+#include <glib-object.h>
+#include <rtm-glib/rtm-transport.h>
+
+
+G_BEGIN_DECLS
+
+#define RTM_TYPE_REST_TRANSPORT (rtm_rest_transport_get_type ())
+#define RTM_REST_TRANSPORT(obj)                                             \
+        (G_TYPE_CHECK_INSTANCE_CAST ((obj), RTM_TYPE_REST_TRANSPORT, RtmRestTransport))
+#define RTM_IS_REST_TRANSPORT(obj)                                  \
+        (G_TYPE_CHECK_INSTANCE_TYPE ((obj), RTM_TYPE_REST_TRANSPORT))
+#define RTM_REST_TRANSPORT_CLASS(klass)                                     \
+        (G_TYPE_CHECK_CLASS_CAST ((klass), RTM_TYPE_REST_TRANSPORT, RtmRestTransportClass))
+#define RTM_IS_REST_TRANSPORT_CLASS(klass)                          \
+        (G_TYPE_CHECK_CLASS_TYPE ((klass), RTM_TYPE_REST_TRANSPORT))
+#define RTM_REST_TRANSPORT_GET_CLASS(obj)                                   \
+        (G_TYPE_INSTANCE_GET_CLASS ((obj), RTM_TYPE_REST_TRANSPORT, RtmRestTransportClass))
+
+typedef struct _RtmRestTransport RtmRestTransport;
+typedef struct _RtmRestTransportClass RtmRestTransportClass;
+typedef struct _RtmRestTransportPrivate RtmRestTransportPrivate;
+
+struct _RtmRestTransport {
+        GObject parent_instance;
+
+        /*< private >*/
+        RtmRestTransportPrivate *priv;
+};
+
+struct _RtmRestTransportClass {
+        GObjectClass parent_class;
+};
+
+GType
+rtm_rest_transport_get_type (void) G_GNUC_CONST;
+
+RtmRestTransport *
+rtm_rest_transport_new (const gchar *url);
+
+RtmRestTransport *
+rtm_rest_transport_new_full (const gchar *url, GMainContext *context);
+
+void
+rtm_rest_transport_get_connection_stats (RtmRestTransport *transport,
+                                         guint *sessions, guint *reused);
+
+void
+rtm_rest_transport_get_transfer_stats (RtmRestTransport *transport,
+                                       guint64 *compressed,
+                                       guint64 *uncompressed);
+
+G_END_DECLS
+
+#endif /* __RTM_REST_TRANSPORT_H__ */
@@ -0,0 +1,963 @@
+/*
+ * rtm-task-batch.c: Tasks of a tasks.getList response sharing one arena
+ *
+ * Copyright (C) 2009 Manuel Rego Casasnovas <mrego@igalia.com>
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301 USA
+ */
+
+/**
+ * SECTION:rtm-task-batch
+ * @short_description: Tasks of a tasks.getList response sharing one arena
+ *
+ * A #RtmTaskBatch holds every task of a tasks.getList response, got with
+ * rtm_glib_tasks_get_batch(). Unlike a #GList of #RtmTask objects, the
+ * tasks are plain records in one array, their strings are copied into a
+ * single #GStringChunk and their dates are stored inline. Loading a batch
+ * makes a few allocations per thousands of tasks, and freeing it does not
+ * walk the tasks at all.
+ *
+ * The tasks are read by index, from 0 to rtm_task_batch_get_length() - 1.
+ * Every string and date returned is owned by the batch and valid while it
+ * is referenced. rtm_task_batch_get_task() creates a #RtmTask from a task
+ * when an object is needed.
+ */
+
+#include <string.h>
+#include <rtm-task-batch.h>
+#include <rtm-util.h>
+#include <rtm-attributes.h>
+#include <rtm-glib-private.h>
+
+/* Strings of a task */
+enum {
+        STRING_ID,
+        STRING_TASKSERIES_ID,
+        STRING_LIST_ID,
+        STRING_NAME,
+        STRING_PRIORITY,
+        STRING_URL,
+        STRING_LOCATION_ID,
+        STRING_ESTIMATE,
+        STRING_SOURCE,
+        STRING_RECURRENCE,
+        N_STRINGS
+};
+
+/* Dates of a task */
+enum {
+        DATE_DUE,
+        DATE_ADDED,
+        DATE_COMPLETED,
+        DATE_DELETED,
+        DATE_CREATED,
+        DATE_MODIFIED,
+        N_DATES
+};
+
+typedef struct {
+        const gchar *strings[N_STRINGS];
+        GTimeVal dates[N_DATES];
+        guint has_dates;
+        gboolean has_due_time;
+        gboolean recurrence_every;
+        guint postponed;
+        guint tags;
+} RtmTaskBatchEntry;
+
+struct _RtmTaskBatch {
+        volatile gint ref_count;
+        GStringChunk *arena;
+        GArray *entries;
+        GPtrArray *tags;
+        guint series;
+        guint series_tags;
+        gboolean seen_task;
+};
+
+/* Elements of a taskseries, in the order of rtm_task_batch_element_names */
+enum {
+        ELEMENT_TASKSERIES,
+        ELEMENT_TASK,
+        ELEMENT_RRULE,
+        ELEMENT_TAG,
+        ELEMENT_LIST,
+};
+
+static const gchar * const rtm_task_batch_element_names[] = {
+        "taskseries",
+        "task",
+        "rrule",
+        "tag",
+        "list",
+        NULL
+};
+
+/* Attributes of the taskseries element */
+enum {
+        SERIES_ID,
+        SERIES_NAME,
+        SERIES_URL,
+        SERIES_LOCATION_ID,
+        SERIES_SOURCE,
+        SERIES_CREATED,
+        SERIES_MODIFIED,
+};
+
+static const gchar * const rtm_task_batch_series_attribute_names[] = {
+        "id",
+        "name",
+        "url",
+        "location_id",
+        "source",
+        "created",
+        "modified",
+        NULL
+};
+
+/* Attributes of the task element */
+enum {
+        TASK_ID,
+        TASK_PRIORITY,
+        TASK_DUE,
+        TASK_HAS_DUE_TIME,
+        TASK_ADDED,
+        TASK_COMPLETED,
+        TASK_DELETED,
+        TASK_ESTIMATE,
+        TASK_POSTPONED,
+};
+
+static const gchar * const rtm_task_batch_task_attribute_names[] = {
+        "id",
+        "priority",
+        "due",
+        "has_due_time",
+        "added",
+        "completed",
+        "deleted",
+        "estimate",
+        "postponed",
+        NULL
+};
+
+static RtmAttributes rtm_task_batch_elements =
+        RTM_ATTRIBUTES_INIT (rtm_task_batch_element_names);
+static RtmAttributes rtm_task_batch_series_attributes =
+        RTM_ATTRIBUTES_INIT (rtm_task_batch_series_attribute_names);
+static RtmAttributes rtm_task_batch_task_attributes =
+        RTM_ATTRIBUTES_INIT (rtm_task_batch_task_attribute_names);
+
+/* Strings shared by all the tasks of a taskseries */
+static const gint rtm_task_batch_series_strings[] = {
+        STRING_TASKSERIES_ID,
+        STRING_LIST_ID,
+        STRING_NAME,
+        STRING_URL,
+        STRING_LOCATION_ID,
+        STRING_SOURCE,
+        STRING_RECURRENCE,
+};
+
+G_DEFINE_BOXED_TYPE (RtmTaskBatch, rtm_task_batch,
+                     rtm_task_batch_ref, rtm_task_batch_unref);
+
+static RtmTaskBatchEntry *
+rtm_task_batch_get_entry (const RtmTaskBatch *batch, guint index)
+{
+        return &g_array_index (batch->entries, RtmTaskBatchEntry, index);
+}
+
+static const GTimeVal *
+rtm_task_batch_get_date (const RtmTaskBatch *batch, guint index, gint date)
+{
+        RtmTaskBatchEntry *entry = rtm_task_batch_get_entry (batch, index);
+
+        if ((entry->has_dates & (1 << date)) == 0) {
+                return NULL;
+        }
+
+        return &entry->dates[date];
+}
+
+/**
+ * rtm_task_batch_new:
+ *
+ * Creates an empty batch, to be loaded from a response.
+ *
+ * Returns: a new #RtmTaskBatch.
+ */
+RtmTaskBatch *
+rtm_task_batch_new (void)
+{
+        RtmTaskBatch *batch;
+
+        batch = g_slice_new0 (RtmTaskBatch);
+        batch->ref_count = 1;
+        batch->arena = g_string_chunk_new (16384);
+        batch->entries = g_array_new (FALSE, TRUE,
+                                      sizeof (RtmTaskBatchEntry));
+        batch->tags = g_ptr_array_new ();
+
+        return batch;
+}
+
+/**
+ * rtm_task_batch_ref:
+ * @batch: a #RtmTaskBatch.
+ *
+ * Increases the reference count of @batch.
+ *
+ * Returns: @batch.
+ */
+RtmTaskBatch *
+rtm_task_batch_ref (RtmTaskBatch *batch)
+{
+        g_return_val_if_fail (batch != NULL, NULL);
+
+        g_atomic_int_inc (&batch->ref_count);
+
+        return batch;
+}
+
+/**
+ * rtm_task_batch_unref:
+ * @batch: a #RtmTaskBatch.
+ *
+ * Decreases the reference count of @batch, freeing all its tasks at once
+ * when it drops to zero.
+ */
+void
+rtm_task_batch_unref (RtmTaskBatch *batch)
+{
+        g_return_if_fail (batch != NULL);
+
+        if (!g_atomic_int_dec_and_test (&batch->ref_count)) {
+                return;
+        }
+
+        g_string_chunk_free (batch->arena);
+        g_array_free (batch->entries, TRUE);
+        g_ptr_array_free (batch->tags, TRUE);
+
+        g_slice_free (RtmTaskBatch, batch);
+}
+
+/**
+ * rtm_task_batch_begin_series:
+ * @batch: a #RtmTaskBatch being loaded.
+ *
+ * Adds a task for a new taskseries, which gets the attributes loaded until
+ * rtm_task_batch_end_series().
+ */
+void
+rtm_task_batch_begin_series (RtmTaskBatch *batch)
+{
+        batch->series = batch->entries->len;
+        batch->series_tags = batch->tags->len;
+        batch->seen_task = FALSE;
+        g_array_set_size (batch->entries, batch->entries->len + 1);
+}
+
+/**
+ * rtm_task_batch_begin_task:
+ * @batch: a #RtmTaskBatch being loaded.
+ *
+ * Starts a task element of the current taskseries. The first one is loaded
+ * into the task of the taskseries, each other one into a new task.
+ */
+void
+rtm_task_batch_begin_task (RtmTaskBatch *batch)
+{
+        if (!batch->seen_task) {
+                batch->seen_task = TRUE;
+                return;
+        }
+
+        g_array_set_size (batch->entries, batch->entries->len + 1);
+}
+
+static void
+rtm_task_batch_set_string (RtmTaskBatch *batch, RtmTaskBatchEntry *entry,
+                           gint string, const gchar *value)
+{
+        entry->strings[string] = value ?
+                g_string_chunk_insert (batch->arena, value) : NULL;
+}
+
+/* For the values repeated all over a response */
+static void
+rtm_task_batch_set_const_string (RtmTaskBatch *batch,
+                                 RtmTaskBatchEntry *entry, gint string,
+                                 const gchar *value)
+{
+        entry->strings[string] = value ?
+                g_string_chunk_insert_const (batch->arena, value) : NULL;
+}
+
+static void
+rtm_task_batch_set_date (RtmTaskBatchEntry *entry, gint date,
+                         const gchar *value)
+{
+        if (value && (g_strcmp0 (value, "") != 0) &&
+            rtm_util_g_time_val_from_iso8601 (value, &entry->dates[date])) {
+                entry->has_dates |= 1 << date;
+        } else {
+                entry->has_dates &= ~(1 << date);
+        }
+}
+
+static void
+rtm_task_batch_add_tag (RtmTaskBatch *batch, const gchar *tag)
+{
+        guint i;
+
+        for (i = batch->series_tags; i < batch->tags->len; i++) {
+                if (strcmp (g_ptr_array_index (batch->tags, i), tag) == 0) {
+                        return;
+                }
+        }
+
+        g_ptr_array_add (batch->tags,
+                         g_string_chunk_insert_const (batch->arena, tag));
+}
+
+static void
+rtm_task_batch_load_series_attribute (RtmTaskBatch *batch,
+                                      RtmTaskBatchEntry *entry, gint id,
+                                      const gchar *value)
+{
+        switch (id) {
+        case SERIES_ID:
+                rtm_task_batch_set_string (batch, entry,
+                                           STRING_TASKSERIES_ID, value);
+                break;
+        case SERIES_NAME:
+                rtm_task_batch_set_string (batch, entry, STRING_NAME, value);
+                break;
+        case SERIES_URL:
+                rtm_task_batch_set_string (batch, entry, STRING_URL, value);
+                break;
+        case SERIES_LOCATION_ID:
+                rtm_task_batch_set_const_string (batch, entry,
+                                                 STRING_LOCATION_ID, value);
+                break;
+        case SERIES_SOURCE:
+                rtm_task_batch_set_const_string (batch, entry,
+                                                 STRING_SOURCE, value);
+                break;
+        case SERIES_CREATED:
+                rtm_task_batch_set_date (entry, DATE_CREATED, value);
+                break;
+        case SERIES_MODIFIED:
+                rtm_task_batch_set_date (entry, DATE_MODIFIED, value);
+                break;
+        }
+}
+
+static void
+rtm_task_batch_load_task_attribute (RtmTaskBatch *batch,
+                                    RtmTaskBatchEntry *entry, gint id,
+                                    const gchar *value)
+{
+        switch (id) {
+        case TASK_ID:
+                rtm_task_batch_set_string (batch, entry, STRING_ID, value);
+                break;
+        case TASK_PRIORITY:
+                rtm_task_batch_set_const_string (batch, entry,
+                                                 STRING_PRIORITY, value);
+                break;
+        case TASK_DUE:
+                rtm_task_batch_set_date (entry, DATE_DUE, value);
+                break;
+        case TASK_HAS_DUE_TIME:
+                entry->has_due_time = (g_strcmp0 (value, "1") == 0);
+                break;
+        case TASK_ADDED:
+                rtm_task_batch_set_date (entry, DATE_ADDED, value);
+                break;
+        case TASK_COMPLETED:
+                rtm_task_batch_set_date (entry, DATE_COMPLETED, value);
+                break;
+        case TASK_DELETED:
+                rtm_task_batch_set_date (entry, DATE_DELETED, value);
+                break;
+        case TASK_ESTIMATE:
+                rtm_task_batch_set_const_string (batch, entry,
+                                                 STRING_ESTIMATE, value);
+                break;
+        case TASK_POSTPONED:
+                if (value && (g_strcmp0 (value, "") != 0)) {
+                        entry->postponed = (guint) g_strtod (value, NULL);
+                }
+                break;
+        }
+}
+
+/**
+ * rtm_task_batch_load_attribute:
+ * @batch: a #RtmTaskBatch being loaded.
+ * @element: the element of the response with the attribute, as in
+ * rtm_task_load_attribute().
+ * @name: the name of the attribute, or "$t" for the content of @element.
+ * @value: the value of the attribute.
+ *
+ * Sets one field of the current taskseries, or of its current task for the
+ * attributes of the task element. Unknown attributes are ignored.
+ */
+void
+rtm_task_batch_load_attribute (RtmTaskBatch *batch, const gchar *element,
+                               const gchar *name, const gchar *value)
+{
+        RtmTaskBatchEntry *series, *entry;
+
+        g_return_if_fail (batch->series < batch->entries->len);
+
+        series = rtm_task_batch_get_entry (batch, batch->series);
+        entry = rtm_task_batch_get_entry (batch, batch->entries->len - 1);
+
+        switch (rtm_attributes_lookup (&rtm_task_batch_elements, element)) {
+        case ELEMENT_TASKSERIES:
+                rtm_task_batch_load_series_attribute (
+                        batch, series,
+                        rtm_attributes_lookup (
+                                &rtm_task_batch_series_attributes, name),
+                        value);
+                break;
+        case ELEMENT_TASK:
+                rtm_task_batch_load_task_attribute (
+                        batch, entry,
+                        rtm_attributes_lookup (
+                                &rtm_task_batch_task_attributes, name),
+                        value);
+                break;
+        case ELEMENT_RRULE:
+                if (g_strcmp0 (name, "every") == 0) {
+                        series->recurrence_every =
+                                (g_strcmp0 (value, "1") == 0);
+                } else if (g_strcmp0 (name, "$t") == 0) {
+                        rtm_task_batch_set_const_string (
+                                batch, series, STRING_RECURRENCE, value);
+                }
+                break;
+        case ELEMENT_TAG:
+                if (g_strcmp0 (name, "$t") == 0 && value != NULL) {
+                        rtm_task_batch_add_tag (batch, value);
+                }
+                break;
+        case ELEMENT_LIST:
+                if (g_strcmp0 (name, "id") == 0) {
+                        rtm_task_batch_set_const_string (
+                                batch, series, STRING_LIST_ID, value);
+                }
+                break;
+        }
+}
+
+/**
+ * rtm_task_batch_end_series:
+ * @batch: a #RtmTaskBatch being loaded.
+ *
+ * Finishes the current taskseries, sharing its fields and tags with all
+ * its tasks.
+ */
+void
+rtm_task_batch_end_series (RtmTaskBatch *batch)
+{
+        RtmTaskBatchEntry *series, *entry;
+        guint i, j;
+
+        g_ptr_array_add (batch->tags, NULL);
+
+        series = rtm_task_batch_get_entry (batch, batch->series);
+        series->tags = batch->series_tags;
+
+        for (i = batch->series + 1; i < batch->entries->len; i++) {
+                entry = rtm_task_batch_get_entry (batch, i);
+                for (j = 0; j < G_N_ELEMENTS (rtm_task_batch_series_strings);
+                     j++) {
+                        entry->strings[rtm_task_batch_series_strings[j]] =
+                                series->strings[rtm_task_batch_series_strings[j]];
+                }
+                entry->dates[DATE_CREATED] = series->dates[DATE_CREATED];
+                entry->dates[DATE_MODIFIED] = series->dates[DATE_MODIFIED];
+                entry->has_dates |= series->has_dates &
+                        ((1 << DATE_CREATED) | (1 << DATE_MODIFIED));
+                entry->recurrence_every = series->recurrence_every;
+                entry->tags = series->tags;
+        }
+}
+
+/**
+ * rtm_task_batch_set_list_id:
+ * @batch: a #RtmTaskBatch being loaded.
+ * @first: the index of the first task of the list.
+ * @list_id: the list ID.
+ *
+ * Sets the list of the tasks loaded since @first, for the responses where
+ * the ID of a list can come after its tasks.
+ */
+void
+rtm_task_batch_set_list_id (RtmTaskBatch *batch, guint first,
+                            const gchar *list_id)
+{
+        guint i;
+
+        for (i = first; i < batch->entries->len; i++) {
+                rtm_task_batch_set_const_string (
+                        batch, rtm_task_batch_get_entry (batch, i),
+                        STRING_LIST_ID, list_id);
+        }
+}
+
+/**
+ * rtm_task_batch_get_length:
+ * @batch: a #RtmTaskBatch.
+ *
+ * Gets the number of tasks of the batch.
+ *
+ * Returns: the number of tasks.
+ */
+guint
+rtm_task_batch_get_length (const RtmTaskBatch *batch)
+{
+        g_return_val_if_fail (batch != NULL, 0);
+
+        return batch->entries->len;
+}
+
+/**
+ * rtm_task_batch_get_id:
+ * @batch: a #RtmTaskBatch.
+ * @index: the index of a task in @batch.
+ *
+ * Gets the ID of a task of the batch.
+ *
+ * Returns: the ID of the task, owned by @batch.
+ */
+const gchar *
+rtm_task_batch_get_id (const RtmTaskBatch *batch, guint index)
+{
+        g_return_val_if_fail (batch != NULL, NULL);
+        g_return_val_if_fail (index < batch->entries->len, NULL);
+
+        return rtm_task_batch_get_entry (batch, index)->strings[STRING_ID];
+}
+
+/**
+ * rtm_task_batch_get_taskseries_id:
+ * @batch: a #RtmTaskBatch.
+ * @index: the index of a task in @batch.
+ *
+ * Gets the taskseries ID of a task of the batch.
+ *
+ * Returns: the taskseries ID of the task, owned by @batch.
+ */
+const gchar *
+rtm_task_batch_get_taskseries_id (const RtmTaskBatch *batch, guint index)
+{
+        g_return_val_if_fail (batch != NULL, NULL);
+        g_return_val_if_fail (index < batch->entries->len, NULL);
+
+        return rtm_task_batch_get_entry (batch, index)->strings[STRING_TASKSERIES_ID];
+}
+
+/**
+ * rtm_task_batch_get_list_id:
+ * @batch: a #RtmTaskBatch.
+ * @index: the index of a task in @batch.
+ *
+ * Gets the list ID of a task of the batch.
+ *
+ * Returns: the list ID of the task, owned by @batch.
+ */
+const gchar *
+rtm_task_batch_get_list_id (const RtmTaskBatch *batch, guint index)
+{
+        g_return_val_if_fail (batch != NULL, NULL);
+        g_return_val_if_fail (index < batch->entries->len, NULL);
+
+        return rtm_task_batch_get_entry (batch, index)->strings[STRING_LIST_ID];
+}
+
+/**
+ * rtm_task_batch_get_name:
+ * @batch: a #RtmTaskBatch.
+ * @index: the index of a task in @batch.
+ *
+ * Gets the name of a task of the batch.
+ *
+ * Returns: the name of the task, owned by @batch.
+ */
+const gchar *
+rtm_task_batch_get_name (const RtmTaskBatch *batch, guint index)
+{
+        g_return_val_if_fail (batch != NULL, NULL);
+        g_return_val_if_fail (index < batch->entries->len, NULL);
+
+        return rtm_task_batch_get_entry (batch, index)->strings[STRING_NAME];
+}
+
+/**
+ * rtm_task_batch_get_priority:
+ * @batch: a #RtmTaskBatch.
+ * @index: the index of a task in @batch.
+ *
+ * Gets the priority of a task of the batch.
+ *
+ * Returns: the priority of the task, owned by @batch.
+ */
+const gchar *
+rtm_task_batch_get_priority (const RtmTaskBatch *batch, guint index)
+{
+        g_return_val_if_fail (batch != NULL, NULL);
+        g_return_val_if_fail (index < batch->entries->len, NULL);
+
+        return rtm_task_batch_get_entry (batch, index)->strings[STRING_PRIORITY];
+}
+
+/**
+ * rtm_task_batch_get_url:
+ * @batch: a #RtmTaskBatch.
+ * @index: the index of a task in @batch.
+ *
+ * Gets the URL of a task of the batch.
+ *
+ * Returns: the URL of the task, owned by @batch.
+ */
+const gchar *
+rtm_task_batch_get_url (const RtmTaskBatch *batch, guint index)
+{
+        g_return_val_if_fail (batch != NULL, NULL);
+        g_return_val_if_fail (index < batch->entries->len, NULL);
+
+        return rtm_task_batch_get_entry (batch, index)->strings[STRING_URL];
+}
+
+/**
+ * rtm_task_batch_get_location_id:
+ * @batch: a #RtmTaskBatch.
+ * @index: the index of a task in @batch.
+ *
+ * Gets the location ID of a task of the batch.
+ *
+ * Returns: the location ID of the task, owned by @batch.
+ */
+const gchar *
+rtm_task_batch_get_location_id (const RtmTaskBatch *batch, guint index)
+{
+        g_return_val_if_fail (batch != NULL, NULL);
+        g_return_val_if_fail (index < batch->entries->len, NULL);
+
+        return rtm_task_batch_get_entry (batch, index)->strings[STRING_LOCATION_ID];
+}
+
+/**
+ * rtm_task_batch_get_estimate:
+ * @batch: a #RtmTaskBatch.
+ * @index: the index of a task in @batch.
+ *
+ * Gets the estimate duration of a task of the batch.
+ *
+ * Returns: the estimate duration of the task, owned by @batch.
+ */
+const gchar *
+rtm_task_batch_get_estimate (const RtmTaskBatch *batch, guint index)
+{
+        g_return_val_if_fail (batch != NULL, NULL);
+        g_return_val_if_fail (index < batch->entries->len, NULL);
+
+        return rtm_task_batch_get_entry (batch, index)->strings[STRING_ESTIMATE];
+}
+
+/**
+ * rtm_task_batch_get_source:
+ * @batch: a #RtmTaskBatch.
+ * @index: the index of a task in @batch.
+ *
+ * Gets the source of a task of the batch.
+ *
+ * Returns: the source of the task, owned by @batch.
+ */
+const gchar *
+rtm_task_batch_get_source (const RtmTaskBatch *batch, guint index)
+{
+        g_return_val_if_fail (batch != NULL, NULL);
+        g_return_val_if_fail (index < batch->entries->len, NULL);
+
+        return rtm_task_batch_get_entry (batch, index)->strings[STRING_SOURCE];
+}
+
+/**
+ * rtm_task_batch_get_recurrence:
+ * @batch: a #RtmTaskBatch.
+ * @index: the index of a task in @batch.
+ *
+ * Gets the recurrence rule of a task of the batch.
+ *
+ * Returns: the recurrence rule of the task, owned by @batch.
+ */
+const gchar *
+rtm_task_batch_get_recurrence (const RtmTaskBatch *batch, guint index)
+{
+        g_return_val_if_fail (batch != NULL, NULL);
+        g_return_val_if_fail (index < batch->entries->len, NULL);
+
+        return rtm_task_batch_get_entry (batch, index)->strings[STRING_RECURRENCE];
+}
+
+/**
+ * rtm_task_batch_get_due_date:
+ * @batch: a #RtmTaskBatch.
+ * @index: the index of a task in @batch.
+ *
+ * Gets the due date of a task of the batch.
+ *
+ * Returns: the due date of the task, owned by @batch, or %NULL if it has none.
+ */
+const GTimeVal *
+rtm_task_batch_get_due_date (const RtmTaskBatch *batch, guint index)
+{
+        g_return_val_if_fail (batch != NULL, NULL);
+        g_return_val_if_fail (index < batch->entries->len, NULL);
+
+        return rtm_task_batch_get_date (batch, index, DATE_DUE);
+}
+
+/**
+ * rtm_task_batch_get_added_date:
+ * @batch: a #RtmTaskBatch.
+ * @index: the index of a task in @batch.
+ *
+ * Gets the added date of a task of the batch.
+ *
+ * Returns: the added date of the task, owned by @batch, or %NULL if it has none.
+ */
+const GTimeVal *
+rtm_task_batch_get_added_date (const RtmTaskBatch *batch, guint index)
+{
+        g_return_val_if_fail (batch != NULL, NULL);
+        g_return_val_if_fail (index < batch->entries->len, NULL);
+
+        return rtm_task_batch_get_date (batch, index, DATE_ADDED);
+}
+
+/**
+ * rtm_task_batch_get_completed_date:
+ * @batch: a #RtmTaskBatch.
+ * @index: the index of a task in @batch.
+ *
+ * Gets the completed date of a task of the batch.
+ *
+ * Returns: the completed date of the task, owned by @batch, or %NULL if it has none.
+ */
+const GTimeVal *
+rtm_task_batch_get_completed_date (const RtmTaskBatch *batch, guint index)
+{
+        g_return_val_if_fail (batch != NULL, NULL);
+        g_return_val_if_fail (index < batch->entries->len, NULL);
+
+        return rtm_task_batch_get_date (batch, index, DATE_COMPLETED);
+}
+
+/**
+ * rtm_task_batch_get_deleted_date:
+ * @batch: a #RtmTaskBatch.
+ * @index: the index of a task in @batch.
+ *
+ * Gets the deleted date of a task of the batch.
+ *
+ * Returns: the deleted date of the task, owned by @batch, or %NULL if it has none.
+ */
+const GTimeVal *
+rtm_task_batch_get_deleted_date (const RtmTaskBatch *batch, guint index)
+{
+        g_return_val_if_fail (batch != NULL, NULL);
+        g_return_val_if_fail (index < batch->entries->len, NULL);
+
+        return rtm_task_batch_get_date (batch, index, DATE_DELETED);
+}
+
+/**
+ * rtm_task_batch_get_created_date:
+ * @batch: a #RtmTaskBatch.
+ * @index: the index of a task in @batch.
+ *
+ * Gets the created date of a task of the batch.
+ *
+ * Returns: the created date of the task, owned by @batch, or %NULL if it has none.
+ */
+const GTimeVal *
+rtm_task_batch_get_created_date (const RtmTaskBatch *batch, guint index)
+{
+        g_return_val_if_fail (batch != NULL, NULL);
+        g_return_val_if_fail (index < batch->entries->len, NULL);
+
+        return rtm_task_batch_get_date (batch, index, DATE_CREATED);
+}
+
+/**
+ * rtm_task_batch_get_modified_date:
+ * @batch: a #RtmTaskBatch.
+ * @index: the index of a task in @batch.
+ *
+ * Gets the modified date of a task of the batch.
+ *
+ * Returns: the modified date of the task, owned by @batch, or %NULL if it has none.
+ */
+const GTimeVal *
+rtm_task_batch_get_modified_date (const RtmTaskBatch *batch, guint index)
+{
+        g_return_val_if_fail (batch != NULL, NULL);
+        g_return_val_if_fail (index < batch->entries->len, NULL);
+
+        return rtm_task_batch_get_date (batch, index, DATE_MODIFIED);
+}
+
+/**
+ * rtm_task_batch_has_due_time:
+ * @batch: a #RtmTaskBatch.
+ * @index: the index of a task in @batch.
+ *
+ * Gets whether the due date of a task of the batch has a time.
+ *
+ * Returns: %TRUE if the task has a due time.
+ */
+gboolean
+rtm_task_batch_has_due_time (const RtmTaskBatch *batch, guint index)
+{
+        g_return_val_if_fail (batch != NULL, FALSE);
+        g_return_val_if_fail (index < batch->entries->len, FALSE);
+
+        return rtm_task_batch_get_entry (batch, index)->has_due_time;
+}
+
+/**
+ * rtm_task_batch_get_postponed:
+ * @batch: a #RtmTaskBatch.
+ * @index: the index of a task in @batch.
+ *
+ * Gets the times a task of the batch was postponed.
+ *
+ * Returns: the postponed count of the task.
+ */
+guint
+rtm_task_batch_get_postponed (const RtmTaskBatch *batch, guint index)
+{
+        g_return_val_if_fail (batch != NULL, 0);
+        g_return_val_if_fail (index < batch->entries->len, 0);
+
+        return rtm_task_batch_get_entry (batch, index)->postponed;
+}
+
+/**
+ * rtm_task_batch_is_recurrence_every:
+ * @batch: a #RtmTaskBatch.
+ * @index: the index of a task in @batch.
+ *
+ * Gets whether the recurrence of a task of the batch is an every one, as
+ * opposed to an after one.
+ *
+ * Returns: %TRUE if the recurrence is an every one.
+ */
+gboolean
+rtm_task_batch_is_recurrence_every (const RtmTaskBatch *batch, guint index)
+{
+        g_return_val_if_fail (batch != NULL, FALSE);
+        g_return_val_if_fail (index < batch->entries->len, FALSE);
+
+        return rtm_task_batch_get_entry (batch, index)->recurrence_every;
+}
+
+/**
+ * rtm_task_batch_get_tags:
+ * @batch: a #RtmTaskBatch.
+ * @index: the index of a task in @batch.
+ *
+ * Gets the tags of a task of the batch. The tasks of a taskseries share
+ * the same array.
+ *
+ * Returns: a %NULL-terminated array of tags, owned by @batch.
+ */
+const gchar * const *
+rtm_task_batch_get_tags (const RtmTaskBatch *batch, guint index)
+{
+        g_return_val_if_fail (batch != NULL, NULL);
+        g_return_val_if_fail (index < batch->entries->len, NULL);
+
+        return (const gchar * const *) &g_ptr_array_index (
+                batch->tags, rtm_task_batch_get_entry (batch, index)->tags);
+}
+
+/**
+ * rtm_task_batch_get_task:
+ * @batch: a #RtmTaskBatch.
+ * @index: the index of a task in @batch.
+ *
+ * Creates a #RtmTask with a copy of the fields of a task of the batch.
+ *
+ * Returns: a new #RtmTask.
+ */
+RtmTask *
+rtm_task_batch_get_task (const RtmTaskBatch *batch, guint index)
+{
+        g_return_val_if_fail (batch != NULL, NULL);
+        g_return_val_if_fail (index < batch->entries->len, NULL);
+
+        RtmTaskBatchEntry *entry;
+        RtmTask *task;
+        const gchar * const *tag;
+        gint date;
+        gboolean (*set_date[N_DATES]) (RtmTask *, GTimeVal *) = {
+                rtm_task_set_due_date,
+                rtm_task_set_added_date,
+                rtm_task_set_completed_date,
+                rtm_task_set_deleted_date,
+                rtm_task_set_created_date,
+                rtm_task_set_modified_date,
+        };
+
+        entry = rtm_task_batch_get_entry (batch, index);
+        task = rtm_task_new ();
+
+        g_object_set (task,
+                      "id", entry->strings[STRING_ID],
+                      "taskseries_id", entry->strings[STRING_TASKSERIES_ID],
+                      "list_id", entry->strings[STRING_LIST_ID],
+                      "name", entry->strings[STRING_NAME],
+                      "priority", entry->strings[STRING_PRIORITY],
+                      "url", entry->strings[STRING_URL],
+                      "location_id", entry->strings[STRING_LOCATION_ID],
+                      "has_due_time", entry->has_due_time,
+                      "estimate", entry->strings[STRING_ESTIMATE],
+                      "postponed", entry->postponed,
+                      "source", entry->strings[STRING_SOURCE],
+                      "recurrence", entry->strings[STRING_RECURRENCE],
+                      "recurrence_every", entry->recurrence_every,
+                      NULL);
+
+        for (date = 0; date < N_DATES; date++) {
+                if (entry->has_dates & (1 << date)) {
+                        set_date[date] (task, &entry->dates[date]);
+                }
+        }
+
+        for (tag = rtm_task_batch_get_tags (batch, index); *tag; tag++) {
+                rtm_task_add_tag (task, g_strdup (*tag), NULL);
+        }
+
+        return task;
+}
@@ -0,0 +1,111 @@
+/*
+ * rtm-task-batch.h: Tasks of a tasks.getList response sharing one arena
+ *
+ * Copyright (C) 2009 Manuel Rego Casasnovas <mrego@igalia.com>
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301 USA
+ */
+
+#ifndef __RTM_TASK_BATCH_H__
+#define __RTM_TASK_BATCH_H__
+
+#include <glib-object.h>
+#include <rtm-glib/rtm-task.h>
+
+
+G_BEGIN_DECLS
+
+#define RTM_TYPE_TASK_BATCH (rtm_task_batch_get_type ())
+
+typedef struct _RtmTaskBatch RtmTaskBatch;
+
+GType
+rtm_task_batch_get_type (void) G_GNUC_CONST;
+
+RtmTaskBatch *
+rtm_task_batch_ref (RtmTaskBatch *batch);
+
+void
+rtm_task_batch_unref (RtmTaskBatch *batch);
+
+guint
+rtm_task_batch_get_length (const RtmTaskBatch *batch);
+
+const gchar *
+rtm_task_batch_get_id (const RtmTaskBatch *batch, guint index);
+
+const gchar *
+rtm_task_batch_get_taskseries_id (const RtmTaskBatch *batch, guint index);
+
+const gchar *
+rtm_task_batch_get_list_id (const RtmTaskBatch *batch, guint index);
+
+const gchar *
+rtm_task_batch_get_name (const RtmTaskBatch *batch, guint index);
+
+const gchar *
+rtm_task_batch_get_priority (const RtmTaskBatch *batch, guint index);
+
+const gchar *
+rtm_task_batch_get_url (const RtmTaskBatch *batch, guint index);
+
+const gchar *
+rtm_task_batch_get_location_id (const RtmTaskBatch *batch, guint index);
+
+const gchar *
+rtm_task_batch_get_estimate (const RtmTaskBatch *batch, guint index);
+
+const gchar *
+rtm_task_batch_get_source (const RtmTaskBatch *batch, guint index);
+
+const gchar *
+rtm_task_batch_get_recurrence (const RtmTaskBatch *batch, guint index);
+
+const GTimeVal *
+rtm_task_batch_get_due_date (const RtmTaskBatch *batch, guint index);
+
+const GTimeVal *
+rtm_task_batch_get_added_date (const RtmTaskBatch *batch, guint index);
+
+const GTimeVal *
+rtm_task_batch_get_completed_date (const RtmTaskBatch *batch, guint index);
+
+const GTimeVal *
+rtm_task_batch_get_deleted_date (const RtmTaskBatch *batch, guint index);
+
+const GTimeVal *
+rtm_task_batch_get_created_date (const RtmTaskBatch *batch, guint index);
+
+const GTimeVal *
+rtm_task_batch_get_modified_date (const RtmTaskBatch *batch, guint index);
+
+gboolean
+rtm_task_batch_has_due_time (const RtmTaskBatch *batch, guint index);
+
+guint
+rtm_task_batch_get_postponed (const RtmTaskBatch *batch, guint index);
+
+gboolean
+rtm_task_batch_is_recurrence_every (const RtmTaskBatch *batch, guint index);
+
+const gchar * const *
+rtm_task_batch_get_tags (const RtmTaskBatch *batch, guint index);
+
+RtmTask *
+rtm_task_batch_get_task (const RtmTaskBatch *batch, guint index);
+
+G_END_DECLS
+
+#endif /* __RTM_TASK_BATCH_H__ */
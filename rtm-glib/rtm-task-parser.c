@@ -0,0 +1,416 @@
+/*
+ * rtm-task-parser.c: Streaming parser of XML task lists
+ *
+ * Copyright (C) 2009 Manuel Rego Casasnovas <mrego@igalia.com>
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301 USA
+ */
+
+
+/*
+ * Parses the XML response of tasks.getList with #GMarkupParseContext,
+ * loading each taskseries into a #RtmTask from the parser events instead of
+ * building a #RestXmlNode tree first. Only the taskseries being parsed is
+ * kept, and it is handed out as soon as its end tag is read.
+ *
+ * The response can be fed in pieces as they arrive. Each task of a
+ * taskseries, as the instances of a recurring one, is handed out as its own
+ * #RtmTask. The first one is loaded into the object of the taskseries, the
+ * others get a copy of the taskseries fields once its end tag is read.
+ *
+ * A parser can also load the tasks into a #RtmTaskBatch instead, see
+ * rtm_task_parser_set_batch().
+ */
+
+#include <string.h>
+#include <rtm-task-parser.h>
+#include <rtm-error.h>
+#include <rtm-glib-private.h>
+
+struct _RtmTaskParser {
+        GMarkupParseContext *context;
+        RtmTaskParserFunc func;
+        gpointer user_data;
+        gboolean seen_rsp;
+        gboolean failed;
+        gchar *list_id;
+        RtmTask *task;
+        gboolean seen_task;
+        GList *instances;
+        gboolean lazy;
+        RtmTaskBatch *batch;
+        gboolean in_series;
+        const gchar *text_element;
+        GString *text;
+};
+
+/**
+ * rtm_task_parser_load:
+ * @parser: a #RtmTaskParser.
+ * @task: the #RtmTask being parsed, unused when loading a batch.
+ * @element: the element name.
+ * @name: the attribute name.
+ * @value: the attribute value.
+ *
+ * Loads an attribute into @task, or into the batch of @parser.
+ */
+static void
+rtm_task_parser_load (RtmTaskParser *parser, RtmTask *task,
+                      const gchar *element, const gchar *name,
+                      const gchar *value)
+{
+        if (parser->batch != NULL) {
+                rtm_task_batch_load_attribute (parser->batch, element, name,
+                                               value);
+        } else {
+                rtm_task_load_attribute (task, element, name, value);
+        }
+}
+
+/**
+ * rtm_task_parser_load_attributes:
+ * @parser: a #RtmTaskParser.
+ * @task: the #RtmTask being parsed, unused when loading a batch.
+ * @element: the element name.
+ * @names: the attribute names of @element.
+ * @values: the attribute values of @element.
+ *
+ * Loads every attribute of an element into @task.
+ */
+static void
+rtm_task_parser_load_attributes (RtmTaskParser *parser, RtmTask *task,
+                                 const gchar *element, const gchar **names,
+                                 const gchar **values)
+{
+        guint i;
+
+        for (i = 0; names[i] != NULL; i++) {
+                rtm_task_parser_load (parser, task, element, names[i],
+                                      values[i]);
+        }
+}
+
+static const gchar *
+rtm_task_parser_lookup (const gchar **names, const gchar **values,
+                        const gchar *name)
+{
+        guint i;
+
+        for (i = 0; names[i] != NULL; i++) {
+                if (strcmp (names[i], name) == 0) {
+                        return values[i];
+                }
+        }
+
+        return NULL;
+}
+
+static void
+rtm_task_parser_start_element (GMarkupParseContext *context,
+                               const gchar *element_name,
+                               const gchar **attribute_names,
+                               const gchar **attribute_values,
+                               gpointer user_data, GError **error)
+{
+        RtmTaskParser *parser = user_data;
+        RtmTask *task;
+
+        if (!parser->seen_rsp) {
+                if (strcmp (element_name, "rsp") == 0) {
+                        parser->seen_rsp = TRUE;
+                        parser->failed = g_strcmp0 (
+                                rtm_task_parser_lookup (attribute_names,
+                                                        attribute_values,
+                                                        "stat"),
+                                "ok") != 0;
+                }
+                return;
+        }
+
+        if (parser->failed) {
+                if (strcmp (element_name, "err") == 0) {
+                        rtm_glib_set_response_error (
+                                error,
+                                rtm_task_parser_lookup (attribute_names,
+                                                        attribute_values,
+                                                        "code"),
+                                rtm_task_parser_lookup (attribute_names,
+                                                        attribute_values,
+                                                        "msg"));
+                }
+                return;
+        }
+
+        if (!parser->in_series) {
+                if (strcmp (element_name, "list") == 0) {
+                        g_free (parser->list_id);
+                        parser->list_id = g_strdup (rtm_task_parser_lookup (
+                                                            attribute_names,
+                                                            attribute_values,
+                                                            "id"));
+                } else if (strcmp (element_name, "taskseries") == 0) {
+                        parser->in_series = TRUE;
+                        if (parser->batch != NULL) {
+                                rtm_task_batch_begin_series (parser->batch);
+                        } else {
+                                parser->task = rtm_task_new ();
+                                rtm_task_set_lazy (parser->task,
+                                                   parser->lazy);
+                        }
+                        parser->seen_task = FALSE;
+                        rtm_task_parser_load_attributes (parser, parser->task,
+                                                         "taskseries",
+                                                         attribute_names,
+                                                         attribute_values);
+                        rtm_task_parser_load (parser, parser->task, "list",
+                                              "id", parser->list_id);
+                }
+                return;
+        }
+
+        if (strcmp (element_name, "task") == 0) {
+                if (parser->batch != NULL) {
+                        rtm_task_batch_begin_task (parser->batch);
+                        task = NULL;
+                } else if (!parser->seen_task) {
+                        parser->seen_task = TRUE;
+                        task = parser->task;
+                } else {
+                        task = rtm_task_new ();
+                        rtm_task_set_lazy (task, parser->lazy);
+                        parser->instances = g_list_prepend (
+                                parser->instances, task);
+                }
+                rtm_task_parser_load_attributes (parser, task, "task",
+                                                 attribute_names,
+                                                 attribute_values);
+        } else if (strcmp (element_name, "rrule") == 0) {
+                rtm_task_parser_load_attributes (parser, parser->task,
+                                                 "rrule",
+                                                 attribute_names,
+                                                 attribute_values);
+                parser->text_element = "rrule";
+                g_string_truncate (parser->text, 0);
+        } else if (strcmp (element_name, "tag") == 0) {
+                parser->text_element = "tag";
+                g_string_truncate (parser->text, 0);
+        }
+}
+
+static void
+rtm_task_parser_end_element (GMarkupParseContext *context,
+                             const gchar *element_name, gpointer user_data,
+                             GError **error)
+{
+        RtmTaskParser *parser = user_data;
+        RtmTask *task;
+        GList *instances, *item;
+
+        if (!parser->in_series) {
+                return;
+        }
+
+        if (parser->text_element != NULL &&
+            strcmp (element_name, parser->text_element) == 0) {
+                rtm_task_parser_load (parser, parser->task,
+                                      parser->text_element, "$t",
+                                      parser->text->str);
+                parser->text_element = NULL;
+        } else if (strcmp (element_name, "taskseries") == 0) {
+                parser->in_series = FALSE;
+                if (parser->batch != NULL) {
+                        rtm_task_batch_end_series (parser->batch);
+                        return;
+                }
+
+                task = parser->task;
+                instances = g_list_reverse (parser->instances);
+                parser->task = NULL;
+                parser->instances = NULL;
+
+                for (item = instances; item; item = item->next) {
+                        rtm_task_copy_series (item->data, task);
+                }
+                parser->func (task, parser->user_data);
+                for (item = instances; item; item = item->next) {
+                        parser->func (item->data, parser->user_data);
+                }
+                g_list_free (instances);
+        }
+}
+
+static void
+rtm_task_parser_text (GMarkupParseContext *context, const gchar *text,
+                      gsize text_len, gpointer user_data, GError **error)
+{
+        RtmTaskParser *parser = user_data;
+
+        if (parser->text_element != NULL) {
+                g_string_append_len (parser->text, text, text_len);
+        }
+}
+
+static const GMarkupParser rtm_task_parser_funcs = {
+        rtm_task_parser_start_element,
+        rtm_task_parser_end_element,
+        rtm_task_parser_text,
+        NULL,
+        NULL
+};
+
+/**
+ * rtm_task_parser_new:
+ * @func: the #RtmTaskParserFunc called for each task.
+ * @user_data: the data to pass to @func.
+ *
+ * Creates a parser of a tasks.getList response.
+ *
+ * Returns: a new #RtmTaskParser.
+ */
+RtmTaskParser *
+rtm_task_parser_new (RtmTaskParserFunc func, gpointer user_data)
+{
+        RtmTaskParser *parser;
+
+        parser = g_slice_new0 (RtmTaskParser);
+        parser->func = func;
+        parser->user_data = user_data;
+        parser->text = g_string_new (NULL);
+        parser->context = g_markup_parse_context_new (&rtm_task_parser_funcs,
+                                                      0, parser, NULL);
+
+        return parser;
+}
+
+/**
+ * rtm_task_parser_set_lazy:
+ * @parser: a #RtmTaskParser.
+ * @lazy: %TRUE to create tasks which decode the fields seldom read on first
+ * access.
+ *
+ * Sets whether the #RtmTask objects are lazy, see rtm_task_set_lazy().
+ */
+void
+rtm_task_parser_set_lazy (RtmTaskParser *parser, gboolean lazy)
+{
+        parser->lazy = lazy;
+}
+
+/**
+ * rtm_task_parser_set_batch:
+ * @parser: a #RtmTaskParser.
+ * @batch: the #RtmTaskBatch to load.
+ *
+ * Makes @parser load the tasks into @batch, instead of creating a #RtmTask
+ * for each of them. The function of @parser is not called.
+ */
+void
+rtm_task_parser_set_batch (RtmTaskParser *parser, RtmTaskBatch *batch)
+{
+        parser->batch = batch;
+}
+
+/**
+ * rtm_task_parser_set_error:
+ * @error: location to store #GError or %NULL.
+ * @tmp_error: the #GError of the parser.
+ *
+ * Propagates @tmp_error, turning the errors of a malformed document into
+ * the ones of an unknown response.
+ */
+static void
+rtm_task_parser_set_error (GError **error, GError *tmp_error)
+{
+        if (tmp_error->domain == RTM_ERROR_DOMAIN) {
+                g_propagate_error (error, tmp_error);
+                return;
+        }
+
+        g_set_error (error, RTM_ERROR_DOMAIN, RTM_UNKNOWN_ERROR,
+                     "Unknown response from Remember The Milk: %s",
+                     tmp_error->message);
+        g_error_free (tmp_error);
+}
+
+/**
+ * rtm_task_parser_feed:
+ * @parser: a #RtmTaskParser.
+ * @data: the next piece of the response.
+ * @length: the length of @data.
+ * @error: location to store #GError or %NULL.
+ *
+ * Parses the next piece of the response, calling the function of @parser
+ * for each task of the taskseries completed.
+ *
+ * Returns: %TRUE on success, %FALSE if the response is malformed or not
+ * successful.
+ */
+gboolean
+rtm_task_parser_feed (RtmTaskParser *parser, const gchar *data, gsize length,
+                      GError **error)
+{
+        GError *tmp_error = NULL;
+
+        if (!g_markup_parse_context_parse (parser->context, data, length,
+                                           &tmp_error)) {
+                rtm_task_parser_set_error (error, tmp_error);
+                return FALSE;
+        }
+
+        return TRUE;
+}
+
+/**
+ * rtm_task_parser_finish:
+ * @parser: a #RtmTaskParser.
+ * @error: location to store #GError or %NULL.
+ *
+ * Checks that the whole response has been fed.
+ *
+ * Returns: %TRUE on success, %FALSE if the response is incomplete.
+ */
+gboolean
+rtm_task_parser_finish (RtmTaskParser *parser, GError **error)
+{
+        GError *tmp_error = NULL;
+
+        if (!g_markup_parse_context_end_parse (parser->context, &tmp_error)) {
+                rtm_task_parser_set_error (error, tmp_error);
+                return FALSE;
+        }
+
+        /* A failed response without any err element */
+        if (!parser->seen_rsp || parser->failed) {
+                g_set_error (error, RTM_ERROR_DOMAIN, RTM_UNKNOWN_ERROR,
+                             "Unknown response from Remember The Milk");
+                return FALSE;
+        }
+
+        return TRUE;
+}
+
+void
+rtm_task_parser_free (RtmTaskParser *parser)
+{
+        g_markup_parse_context_free (parser->context);
+        if (parser->task != NULL) {
+                g_object_unref (parser->task);
+        }
+        g_list_free_full (parser->instances, g_object_unref);
+        g_free (parser->list_id);
+        g_string_free (parser->text, TRUE);
+
+        g_slice_free (RtmTaskParser, parser);
+}
@@ -0,0 +1,60 @@
+/*
+ * rtm-task-parser.h: Streaming parser of XML task lists
+ *
+ * Copyright (C) 2009 Manuel Rego Casasnovas <mrego@igalia.com>
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301 USA
+ */
+
+#ifndef __RTM_TASK_PARSER_H__
+#define __RTM_TASK_PARSER_H__
+
+#include <glib.h>
+#include <rtm-glib/rtm-task.h>
+#include <rtm-glib/rtm-task-batch.h>
+
+
+G_BEGIN_DECLS
+
+/*
+ * Called for each task of a taskseries as soon as the taskseries is parsed,
+ * with a new #RtmTask owned by the function.
+ */
+typedef void (*RtmTaskParserFunc) (RtmTask *task, gpointer user_data);
+
+typedef struct _RtmTaskParser RtmTaskParser;
+
+RtmTaskParser *
+rtm_task_parser_new (RtmTaskParserFunc func, gpointer user_data);
+
+void
+rtm_task_parser_set_lazy (RtmTaskParser *parser, gboolean lazy);
+
+void
+rtm_task_parser_set_batch (RtmTaskParser *parser, RtmTaskBatch *batch);
+
+gboolean
+rtm_task_parser_feed (RtmTaskParser *parser, const gchar *data,
+                      gsize length, GError **error);
+
+gboolean
+rtm_task_parser_finish (RtmTaskParser *parser, GError **error);
+
+void
+rtm_task_parser_free (RtmTaskParser *parser);
+
+G_END_DECLS
+
+#endif /* __RTM_TASK_PARSER_H__ */
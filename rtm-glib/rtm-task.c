@@ -25,13 +25,32 @@
  * #RtmTask represents a task from Remeber The Milk.
  */
 
+#include <string.h>
 #include <rtm-task.h>
 #include <rtm-util.h>
 #include <rtm-error.h>
+#include <rtm-attributes.h>
+#include <rtm-glib-private.h>
 
 #define RTM_TASK_GET_PRIVATE(obj) (G_TYPE_INSTANCE_GET_PRIVATE (        \
                                            (obj), RTM_TYPE_TASK, RtmTaskPrivate))
 
+/* Fields decoded on first access by a lazy #RtmTask */
+enum {
+        LAZY_URL,
+        LAZY_LOCATION_ID,
+        LAZY_SOURCE,
+        LAZY_CREATED,
+        LAZY_MODIFIED,
+        LAZY_ADDED,
+        LAZY_COMPLETED,
+        LAZY_DELETED,
+        LAZY_ESTIMATE,
+        LAZY_RECURRENCE,
+        LAZY_TAGS,
+        N_LAZY_FIELDS
+};
+
 struct _RtmTaskPrivate {
         gchar *id;
         gchar *taskseries_id;
@@ -53,6 +72,11 @@ struct _RtmTaskPrivate {
         gchar *recurrence;
         gboolean recurrence_every;
         GList *tags;
+        gboolean lazy;
+        guint pending;
+        GString *raw;
+        gsize raw_offsets[N_LAZY_FIELDS];
+        GString *raw_tags;
 };
 
 enum {
@@ -73,8 +97,129 @@ enum {
         PROP_RECURRENCE_EVERY,
 };
 
+/* Elements of a taskseries, in the order of rtm_task_element_names */
+enum {
+        ELEMENT_TASKSERIES,
+        ELEMENT_TASK,
+        ELEMENT_RRULE,
+        ELEMENT_TAG,
+        ELEMENT_LIST,
+};
+
+static const gchar * const rtm_task_element_names[] = {
+        "taskseries",
+        "task",
+        "rrule",
+        "tag",
+        "list",
+        NULL
+};
+
+/* Attributes of the taskseries element */
+enum {
+        SERIES_ID,
+        SERIES_NAME,
+        SERIES_URL,
+        SERIES_LOCATION_ID,
+        SERIES_SOURCE,
+        SERIES_CREATED,
+        SERIES_MODIFIED,
+};
+
+static const gchar * const rtm_task_series_attribute_names[] = {
+        "id",
+        "name",
+        "url",
+        "location_id",
+        "source",
+        "created",
+        "modified",
+        NULL
+};
+
+/* Attributes of the task element */
+enum {
+        TASK_ID,
+        TASK_PRIORITY,
+        TASK_DUE,
+        TASK_HAS_DUE_TIME,
+        TASK_ADDED,
+        TASK_COMPLETED,
+        TASK_DELETED,
+        TASK_ESTIMATE,
+        TASK_POSTPONED,
+};
+
+static const gchar * const rtm_task_task_attribute_names[] = {
+        "id",
+        "priority",
+        "due",
+        "has_due_time",
+        "added",
+        "completed",
+        "deleted",
+        "estimate",
+        "postponed",
+        NULL
+};
+
+/* Attributes of the rrule element, "$t" being its content */
+enum {
+        RRULE_EVERY,
+        RRULE_CONTENT,
+};
+
+static const gchar * const rtm_task_rrule_attribute_names[] = {
+        "every",
+        "$t",
+        NULL
+};
+
+static RtmAttributes rtm_task_elements =
+        RTM_ATTRIBUTES_INIT (rtm_task_element_names);
+static RtmAttributes rtm_task_series_attributes =
+        RTM_ATTRIBUTES_INIT (rtm_task_series_attribute_names);
+static RtmAttributes rtm_task_task_attributes =
+        RTM_ATTRIBUTES_INIT (rtm_task_task_attribute_names);
+static RtmAttributes rtm_task_rrule_attributes =
+        RTM_ATTRIBUTES_INIT (rtm_task_rrule_attribute_names);
+
+/* Lazy field of each attribute, or -1 if it is always decoded */
+static const gint rtm_task_series_lazy_fields[] = {
+        -1,
+        -1,
+        LAZY_URL,
+        LAZY_LOCATION_ID,
+        LAZY_SOURCE,
+        LAZY_CREATED,
+        LAZY_MODIFIED,
+};
+
+static const gint rtm_task_task_lazy_fields[] = {
+        -1,
+        -1,
+        -1,
+        -1,
+        LAZY_ADDED,
+        LAZY_COMPLETED,
+        LAZY_DELETED,
+        LAZY_ESTIMATE,
+        -1,
+};
+
+static const gint rtm_task_rrule_lazy_fields[] = {
+        -1,
+        LAZY_RECURRENCE,
+};
+
 G_DEFINE_TYPE (RtmTask, rtm_task, G_TYPE_OBJECT);
 
+static void
+rtm_task_ensure (RtmTask *task, gint field);
+
+static void
+rtm_task_forget (RtmTask *task, gint field);
+
 static void
 rtm_task_get_property (GObject *gobject, guint prop_id, GValue *value,
                        GParamSpec *pspec)
@@ -103,10 +248,12 @@ rtm_task_get_property (GObject *gobject, guint prop_id, GValue *value,
                 break;
 
         case PROP_URL:
+                rtm_task_ensure (RTM_TASK (gobject), LAZY_URL);
                 g_value_set_string (value, priv->url);
                 break;
 
         case PROP_LOCATION_ID:
+                rtm_task_ensure (RTM_TASK (gobject), LAZY_LOCATION_ID);
                 g_value_set_string (value, priv->location_id);
                 break;
 
@@ -115,6 +262,7 @@ rtm_task_get_property (GObject *gobject, guint prop_id, GValue *value,
                 break;
 
         case PROP_ESTIMATE:
+                rtm_task_ensure (RTM_TASK (gobject), LAZY_ESTIMATE);
                 g_value_set_string (value, priv->estimate);
                 break;
 
@@ -123,10 +271,12 @@ rtm_task_get_property (GObject *gobject, guint prop_id, GValue *value,
                 break;
 
         case PROP_SOURCE:
+                rtm_task_ensure (RTM_TASK (gobject), LAZY_SOURCE);
                 g_value_set_string (value, priv->source);
                 break;
 
         case PROP_RECURRENCE:
+                rtm_task_ensure (RTM_TASK (gobject), LAZY_RECURRENCE);
                 g_value_set_string (value, priv->recurrence);
                 break;
 
@@ -174,11 +324,13 @@ rtm_task_set_property (GObject *gobject, guint prop_id, const GValue *value,
                 break;
 
         case PROP_URL:
+                rtm_task_forget (RTM_TASK (gobject), LAZY_URL);
                 g_free (priv->url);
                 priv->url = g_value_dup_string (value);
                 break;
 
         case PROP_LOCATION_ID:
+                rtm_task_forget (RTM_TASK (gobject), LAZY_LOCATION_ID);
                 g_free (priv->location_id);
                 priv->location_id = g_value_dup_string (value);
                 break;
@@ -188,6 +340,7 @@ rtm_task_set_property (GObject *gobject, guint prop_id, const GValue *value,
                 break;
 
         case PROP_ESTIMATE:
+                rtm_task_forget (RTM_TASK (gobject), LAZY_ESTIMATE);
                 g_free (priv->estimate);
                 priv->estimate = g_value_dup_string (value);
                 break;
@@ -197,11 +350,13 @@ rtm_task_set_property (GObject *gobject, guint prop_id, const GValue *value,
                 break;
 
         case PROP_SOURCE:
+                rtm_task_forget (RTM_TASK (gobject), LAZY_SOURCE);
                 g_free (priv->source);
                 priv->source = g_value_dup_string (value);
                 break;
 
         case PROP_RECURRENCE:
+                rtm_task_forget (RTM_TASK (gobject), LAZY_RECURRENCE);
                 g_free (priv->recurrence);
                 priv->recurrence = g_value_dup_string (value);
                 break;
@@ -260,6 +415,12 @@ rtm_task_finalize (GObject *gobject)
         }
         g_free (priv->source);
         g_free (priv->recurrence);
+        if (priv->raw) {
+                g_string_free (priv->raw, TRUE);
+        }
+        if (priv->raw_tags) {
+                g_string_free (priv->raw_tags, TRUE);
+        }
 
         G_OBJECT_CLASS (rtm_task_parent_class)->finalize (gobject);
 }
@@ -613,6 +774,303 @@ rtm_task_set_priority (RtmTask *task, gchar* priority)
         return TRUE;
 }
 
+static void
+rtm_task_replace_string (gchar **field, const gchar *value)
+{
+        g_free (*field);
+        *field = g_strdup (value);
+}
+
+static void
+rtm_task_replace_date (GTimeVal **field, const gchar *value)
+{
+        GTimeVal date;
+
+        g_free (*field);
+        *field = NULL;
+
+        if (value && (g_strcmp0 (value, "") != 0)) {
+                rtm_util_g_time_val_from_iso8601 (value, &date);
+                *field = rtm_util_g_time_val_dup (&date);
+        }
+}
+
+static void
+rtm_task_apply_series_attribute (RtmTask *task, gint id, const gchar *value)
+{
+        RtmTaskPrivate *priv = task->priv;
+
+        switch (id) {
+        case SERIES_ID:
+                rtm_task_replace_string (&priv->taskseries_id, value);
+                break;
+        case SERIES_NAME:
+                rtm_task_replace_string (&priv->name, value);
+                break;
+        case SERIES_URL:
+                rtm_task_replace_string (&priv->url, value);
+                break;
+        case SERIES_LOCATION_ID:
+                rtm_task_replace_string (&priv->location_id, value);
+                break;
+        case SERIES_SOURCE:
+                rtm_task_replace_string (&priv->source, value);
+                break;
+        case SERIES_CREATED:
+                rtm_task_replace_date (&priv->created_date, value);
+                break;
+        case SERIES_MODIFIED:
+                rtm_task_replace_date (&priv->modified_date, value);
+                break;
+        }
+}
+
+static void
+rtm_task_apply_task_attribute (RtmTask *task, gint id, const gchar *value)
+{
+        RtmTaskPrivate *priv = task->priv;
+
+        switch (id) {
+        case TASK_ID:
+                rtm_task_replace_string (&priv->id, value);
+                break;
+        case TASK_PRIORITY:
+                rtm_task_replace_string (&priv->priority, value);
+                break;
+        case TASK_DUE:
+                rtm_task_replace_date (&priv->due_date, value);
+                break;
+        case TASK_HAS_DUE_TIME:
+                priv->has_due_time = (g_strcmp0 (value, "1") == 0);
+                break;
+        case TASK_ADDED:
+                rtm_task_replace_date (&priv->added_date, value);
+                break;
+        case TASK_COMPLETED:
+                rtm_task_replace_date (&priv->completed_date, value);
+                break;
+        case TASK_DELETED:
+                rtm_task_replace_date (&priv->deleted_date, value);
+                break;
+        case TASK_ESTIMATE:
+                rtm_task_replace_string (&priv->estimate, value);
+                break;
+        case TASK_POSTPONED:
+                if (value && (g_strcmp0 (value, "") != 0)) {
+                        priv->postponed = (guint) g_strtod (value, NULL);
+                }
+                break;
+        }
+}
+
+static void
+rtm_task_apply_rrule_attribute (RtmTask *task, gint id, const gchar *value)
+{
+        RtmTaskPrivate *priv = task->priv;
+
+        switch (id) {
+        case RRULE_EVERY:
+                priv->recurrence_every = (g_strcmp0 (value, "1") == 0);
+                break;
+        case RRULE_CONTENT:
+                rtm_task_replace_string (&priv->recurrence, value);
+                break;
+        }
+}
+
+static void
+rtm_task_append_tag (RtmTask *task, const gchar *tag)
+{
+        if (rtm_task_find_tag (task, (gchar *) tag) == NULL) {
+                task->priv->tags = g_list_append (task->priv->tags,
+                                                  g_strdup (tag));
+        }
+}
+
+/* How to decode each lazy field, but the tags */
+static const struct {
+        RtmAttributesSetFunc apply;
+        gint id;
+} rtm_task_lazy_decoders[] = {
+        { (RtmAttributesSetFunc) rtm_task_apply_series_attribute, SERIES_URL },
+        { (RtmAttributesSetFunc) rtm_task_apply_series_attribute, SERIES_LOCATION_ID },
+        { (RtmAttributesSetFunc) rtm_task_apply_series_attribute, SERIES_SOURCE },
+        { (RtmAttributesSetFunc) rtm_task_apply_series_attribute, SERIES_CREATED },
+        { (RtmAttributesSetFunc) rtm_task_apply_series_attribute, SERIES_MODIFIED },
+        { (RtmAttributesSetFunc) rtm_task_apply_task_attribute, TASK_ADDED },
+        { (RtmAttributesSetFunc) rtm_task_apply_task_attribute, TASK_COMPLETED },
+        { (RtmAttributesSetFunc) rtm_task_apply_task_attribute, TASK_DELETED },
+        { (RtmAttributesSetFunc) rtm_task_apply_task_attribute, TASK_ESTIMATE },
+        { (RtmAttributesSetFunc) rtm_task_apply_rrule_attribute, RRULE_CONTENT },
+};
+
+/**
+ * rtm_task_stash:
+ * @task: a #RtmTask.
+ * @field: the lazy field set by @value, or -1.
+ * @value: the raw value of the field.
+ *
+ * Keeps the raw value of a lazy field of a lazy #RtmTask, to be decoded by
+ * rtm_task_ensure() when it is first read.
+ *
+ * Returns: %TRUE if @value was kept, %FALSE if it has to be decoded now.
+ */
+static gboolean
+rtm_task_stash (RtmTask *task, gint field, const gchar *value)
+{
+        RtmTaskPrivate *priv = task->priv;
+
+        if (!priv->lazy || field < 0) {
+                return FALSE;
+        }
+
+        rtm_task_forget (task, field);
+        if (value == NULL) {
+                return FALSE;
+        }
+
+        if (priv->raw == NULL) {
+                priv->raw = g_string_sized_new (128);
+        }
+        priv->raw_offsets[field] = priv->raw->len;
+        g_string_append_len (priv->raw, value, strlen (value) + 1);
+        priv->pending |= 1 << field;
+
+        return TRUE;
+}
+
+/**
+ * rtm_task_ensure:
+ * @task: a #RtmTask.
+ * @field: a lazy field.
+ *
+ * Decodes the raw value of a lazy field, if it was not read yet.
+ */
+static void
+rtm_task_ensure (RtmTask *task, gint field)
+{
+        RtmTaskPrivate *priv = task->priv;
+        const gchar *tag, *end;
+
+        if ((priv->pending & (1 << field)) == 0) {
+                return;
+        }
+        priv->pending &= ~(1 << field);
+
+        if (field == LAZY_TAGS) {
+                end = priv->raw_tags->str + priv->raw_tags->len;
+                for (tag = priv->raw_tags->str; tag < end;
+                     tag += strlen (tag) + 1) {
+                        rtm_task_append_tag (task, tag);
+                }
+                g_string_free (priv->raw_tags, TRUE);
+                priv->raw_tags = NULL;
+                return;
+        }
+
+        rtm_task_lazy_decoders[field].apply (
+                task, rtm_task_lazy_decoders[field].id,
+                priv->raw->str + priv->raw_offsets[field]);
+
+        /* Every field is decoded, so the raw values are not needed */
+        if ((priv->pending & ~(1 << LAZY_TAGS)) == 0) {
+                g_string_free (priv->raw, TRUE);
+                priv->raw = NULL;
+        }
+}
+
+/**
+ * rtm_task_forget:
+ * @task: a #RtmTask.
+ * @field: a lazy field.
+ *
+ * Discards the raw value of a lazy field, as it is being set.
+ */
+static void
+rtm_task_forget (RtmTask *task, gint field)
+{
+        task->priv->pending &= ~(1 << field);
+}
+
+static void
+rtm_task_ensure_all (RtmTask *task)
+{
+        gint field;
+
+        for (field = 0; field < N_LAZY_FIELDS; field++) {
+                rtm_task_ensure (task, field);
+        }
+}
+
+static void
+rtm_task_set_series_attribute (RtmTask *task, gint id, const gchar *value)
+{
+        if (id >= 0 &&
+            rtm_task_stash (task, rtm_task_series_lazy_fields[id], value)) {
+                return;
+        }
+        rtm_task_apply_series_attribute (task, id, value);
+}
+
+static void
+rtm_task_set_task_attribute (RtmTask *task, gint id, const gchar *value)
+{
+        if (id >= 0 &&
+            rtm_task_stash (task, rtm_task_task_lazy_fields[id], value)) {
+                return;
+        }
+        rtm_task_apply_task_attribute (task, id, value);
+}
+
+static void
+rtm_task_set_rrule_attribute (RtmTask *task, gint id, const gchar *value)
+{
+        if (id >= 0 &&
+            rtm_task_stash (task, rtm_task_rrule_lazy_fields[id], value)) {
+                return;
+        }
+        rtm_task_apply_rrule_attribute (task, id, value);
+}
+
+static void
+rtm_task_load_tag (RtmTask *task, const gchar *tag)
+{
+        RtmTaskPrivate *priv = task->priv;
+
+        if (tag == NULL) {
+                return;
+        }
+
+        if (priv->lazy) {
+                if (priv->raw_tags == NULL) {
+                        priv->raw_tags = g_string_sized_new (64);
+                }
+                g_string_append_len (priv->raw_tags, tag, strlen (tag) + 1);
+                priv->pending |= 1 << LAZY_TAGS;
+                return;
+        }
+
+        rtm_task_append_tag (task, tag);
+}
+
+/**
+ * rtm_task_set_lazy:
+ * @task: a new #RtmTask.
+ * @lazy: %TRUE to decode the fields seldom read on first access.
+ *
+ * Makes the #RtmTask keep the raw values of the URL, location, source,
+ * estimate, recurrence, tags and every date but the due one as they are
+ * loaded, decoding each of them when it is first read. It has to be set
+ * before loading any data.
+ */
+void
+rtm_task_set_lazy (RtmTask *task, gboolean lazy)
+{
+        g_return_if_fail (task != NULL);
+
+        task->priv->lazy = lazy;
+}
+
 /**
  * rtm_task_load_data:
  * @task: a #RtmTask.
@@ -629,79 +1087,196 @@ rtm_task_load_data (RtmTask *task, RestXmlNode *node, const gchar *list_id)
         g_return_if_fail (list_id != NULL);
 
         RestXmlNode *node_tags, *node_tmp;
-        gchar *tag;
-        const gchar *due, *added, *completed, *deleted, *created, *modified;
-        GTimeVal due_date, added_date, completed_date, deleted_date,
-                created_date, modified_date;
-
-        task->priv->taskseries_id = g_strdup (rest_xml_node_get_attr (node, "id"));
-        task->priv->name = g_strdup (rest_xml_node_get_attr (node, "name"));
-        task->priv->url = g_strdup (rest_xml_node_get_attr (node, "url"));
-        task->priv->location_id = g_strdup (rest_xml_node_get_attr (node, "location_id"));
-        task->priv->source = g_strdup (rest_xml_node_get_attr (node, "source"));
-
-        created = rest_xml_node_get_attr (node, "created");
-        if (created && (g_strcmp0 (created, "") != 0)) {
-                g_time_val_from_iso8601 (created, &created_date);
-                task->priv->created_date = rtm_util_g_time_val_dup (&created_date);
-        }
 
-        modified = rest_xml_node_get_attr (node, "modified");
-        if (modified && (g_strcmp0 (modified, "") != 0)) {
-                g_time_val_from_iso8601 (modified, &modified_date);
-                task->priv->modified_date = rtm_util_g_time_val_dup (&modified_date);
-        }
+        rtm_attributes_load_node (
+                &rtm_task_series_attributes, node,
+                (RtmAttributesSetFunc) rtm_task_set_series_attribute, task);
 
         node_tmp = rest_xml_node_find (node, "rrule");
         if (node_tmp) {
-                task->priv->recurrence_every = (g_strcmp0 (rest_xml_node_get_attr (node_tmp, "every"), "1") == 0);
-                task->priv->recurrence = g_strdup (node_tmp->content);
+                rtm_attributes_load_node (
+                        &rtm_task_rrule_attributes, node_tmp,
+                        (RtmAttributesSetFunc) rtm_task_set_rrule_attribute,
+                        task);
+                rtm_task_set_rrule_attribute (task, RRULE_CONTENT,
+                                              node_tmp->content);
         }
 
         node_tags = rest_xml_node_find (node, "tags");
         for (node_tmp = rest_xml_node_find (node_tags, "tag"); node_tmp;
              node_tmp = node_tmp->next) {
-                tag = g_strdup (node_tmp->content);
-                rtm_task_add_tag (task, tag, NULL);
+                rtm_task_load_tag (task, node_tmp->content);
         }
 
         node_tmp = rest_xml_node_find (node, "task");
-        task->priv->id = g_strdup (rest_xml_node_get_attr (node_tmp, "id"));
-        task->priv->priority = g_strdup (rest_xml_node_get_attr (node_tmp, "priority"));
+        if (node_tmp) {
+                rtm_attributes_load_node (
+                        &rtm_task_task_attributes, node_tmp,
+                        (RtmAttributesSetFunc) rtm_task_set_task_attribute,
+                        task);
+        }
 
-        due = rest_xml_node_get_attr (node_tmp, "due");
-        if (due && (g_strcmp0 (due, "") != 0)) {
-                g_time_val_from_iso8601 (due, &due_date);
-                task->priv->due_date = rtm_util_g_time_val_dup (&due_date);
+        rtm_task_replace_string (&task->priv->list_id, list_id);
+}
+
+/**
+ * rtm_task_load_attribute:
+ * @task: a #RtmTask.
+ * @element: the element of the response with the attribute: "list",
+ * "taskseries", "task", "rrule" or "tag".
+ * @name: the name of the attribute, or "$t" for the content of @element.
+ * @value: the value of the attribute.
+ *
+ * Sets one field of the #RtmTask object, as found in a response. Unknown
+ * attributes are ignored.
+ */
+void
+rtm_task_load_attribute (RtmTask *task, const gchar *element,
+                         const gchar *name, const gchar *value)
+{
+        g_return_if_fail (task != NULL);
+        g_return_if_fail (element != NULL);
+        g_return_if_fail (name != NULL);
+
+        switch (rtm_attributes_lookup (&rtm_task_elements, element)) {
+        case ELEMENT_TASKSERIES:
+                rtm_task_set_series_attribute (
+                        task,
+                        rtm_attributes_lookup (&rtm_task_series_attributes,
+                                               name),
+                        value);
+                break;
+        case ELEMENT_TASK:
+                rtm_task_set_task_attribute (
+                        task,
+                        rtm_attributes_lookup (&rtm_task_task_attributes,
+                                               name),
+                        value);
+                break;
+        case ELEMENT_RRULE:
+                rtm_task_set_rrule_attribute (
+                        task,
+                        rtm_attributes_lookup (&rtm_task_rrule_attributes,
+                                               name),
+                        value);
+                break;
+        case ELEMENT_TAG:
+                if (g_strcmp0 (name, "$t") == 0) {
+                        rtm_task_load_tag (task, value);
+                }
+                break;
+        case ELEMENT_LIST:
+                if (g_strcmp0 (name, "id") == 0) {
+                        rtm_task_replace_string (&task->priv->list_id, value);
+                }
+                break;
         }
+}
 
-        task->priv->has_due_time = (g_strcmp0 (rest_xml_node_get_attr (node_tmp, "has_due_time"), "1") == 0);
+static void
+rtm_task_copy_date (GTimeVal **field, GTimeVal *value)
+{
+        g_free (*field);
+        *field = value ? rtm_util_g_time_val_dup (value) : NULL;
+}
 
-        added = rest_xml_node_get_attr (node_tmp, "added");
-        if (added && (g_strcmp0 (added, "") != 0)) {
-                g_time_val_from_iso8601 (added, &added_date);
-                task->priv->added_date = rtm_util_g_time_val_dup (&added_date);
+/**
+ * rtm_task_copy_raw:
+ * @task: a #RtmTask.
+ * @series: the #RtmTask where the taskseries was loaded.
+ * @field: a lazy field of the taskseries.
+ *
+ * Copies the raw value of @field from @series into @task without decoding
+ * it in @series, kept raw if @task is lazy too.
+ *
+ * Returns: %TRUE if @field was pending in @series, %FALSE if its decoded
+ * value has to be copied.
+ */
+static gboolean
+rtm_task_copy_raw (RtmTask *task, RtmTask *series, gint field)
+{
+        RtmTaskPrivate *series_priv = series->priv;
+        const gchar *value, *end;
+
+        if ((series_priv->pending & (1 << field)) == 0) {
+                /* The tags of @task are kept, the others are replaced */
+                if (field != LAZY_TAGS) {
+                        rtm_task_forget (task, field);
+                }
+                return FALSE;
+        }
+
+        if (field == LAZY_TAGS) {
+                end = series_priv->raw_tags->str + series_priv->raw_tags->len;
+                for (value = series_priv->raw_tags->str; value < end;
+                     value += strlen (value) + 1) {
+                        rtm_task_load_tag (task, value);
+                }
+                return TRUE;
         }
 
-        completed = rest_xml_node_get_attr (node_tmp, "completed");
-        if (completed && (g_strcmp0 (completed, "") != 0)) {
-                g_time_val_from_iso8601 (completed, &completed_date);
-                task->priv->completed_date = rtm_util_g_time_val_dup (&completed_date);
+        value = series_priv->raw->str + series_priv->raw_offsets[field];
+        if (!rtm_task_stash (task, field, value)) {
+                rtm_task_lazy_decoders[field].apply (
+                        task, rtm_task_lazy_decoders[field].id, value);
         }
 
-        deleted = rest_xml_node_get_attr (node_tmp, "deleted");
-        if (deleted && (g_strcmp0 (deleted, "") != 0)) {
-                g_time_val_from_iso8601 (deleted, &deleted_date);
-                task->priv->deleted_date = rtm_util_g_time_val_dup (&deleted_date);
+        return TRUE;
+}
+
+/**
+ * rtm_task_copy_series:
+ * @task: a #RtmTask with the data of one task of a taskseries.
+ * @series: the #RtmTask where the taskseries was loaded.
+ *
+ * Copies the fields shared by all the tasks of a taskseries, that is all
+ * but the ones of the task element, from @series into @task. The fields
+ * not decoded yet in @series are copied raw.
+ */
+void
+rtm_task_copy_series (RtmTask *task, RtmTask *series)
+{
+        g_return_if_fail (task != NULL);
+        g_return_if_fail (series != NULL);
+
+        RtmTaskPrivate *priv = task->priv;
+        RtmTaskPrivate *series_priv = series->priv;
+        GList *item;
+
+        rtm_task_replace_string (&priv->taskseries_id,
+                                 series_priv->taskseries_id);
+        rtm_task_replace_string (&priv->list_id, series_priv->list_id);
+        rtm_task_replace_string (&priv->name, series_priv->name);
+        if (!rtm_task_copy_raw (task, series, LAZY_URL)) {
+                rtm_task_replace_string (&priv->url, series_priv->url);
+        }
+        if (!rtm_task_copy_raw (task, series, LAZY_LOCATION_ID)) {
+                rtm_task_replace_string (&priv->location_id,
+                                         series_priv->location_id);
+        }
+        if (!rtm_task_copy_raw (task, series, LAZY_SOURCE)) {
+                rtm_task_replace_string (&priv->source, series_priv->source);
         }
+        if (!rtm_task_copy_raw (task, series, LAZY_RECURRENCE)) {
+                rtm_task_replace_string (&priv->recurrence,
+                                         series_priv->recurrence);
+        }
+        priv->recurrence_every = series_priv->recurrence_every;
 
-        task->priv->estimate = g_strdup (rest_xml_node_get_attr (node_tmp, "estimate"));
-        const gchar *postponed = rest_xml_node_get_attr (node_tmp, "postponed");
-        if (postponed && (g_strcmp0 (postponed, "") != 0)) {
-                task->priv->postponed = (guint) g_strtod (postponed, NULL);
+        if (!rtm_task_copy_raw (task, series, LAZY_CREATED)) {
+                rtm_task_copy_date (&priv->created_date,
+                                    series_priv->created_date);
+        }
+        if (!rtm_task_copy_raw (task, series, LAZY_MODIFIED)) {
+                rtm_task_copy_date (&priv->modified_date,
+                                    series_priv->modified_date);
         }
 
-        task->priv->list_id = g_strdup (list_id);
+        /* Raw tags are appended to the ones of the task, decoded or not */
+        rtm_task_copy_raw (task, series, LAZY_TAGS);
+        for (item = series_priv->tags; item; item = g_list_next (item)) {
+                rtm_task_append_tag (task, item->data);
+        }
 }
 
 /**
@@ -722,6 +1297,8 @@ rtm_task_to_string (RtmTask *task)
         gint i = 0;
         gchar *postponed;
 
+        rtm_task_ensure_all (task);
+
         tags = g_new0 (gchar*, g_list_length (task->priv->tags) + 1);
         for (item = task->priv->tags; item; item = g_list_next (item)) {
                 tags[i] = (gchar *) item->data;
@@ -778,6 +1355,7 @@ rtm_task_get_url (RtmTask *task)
 {
         g_return_val_if_fail (task != NULL, NULL);
 
+        rtm_task_ensure (task, LAZY_URL);
         return task->priv->url;
 }
 
@@ -796,6 +1374,7 @@ rtm_task_set_url (RtmTask *task, gchar* url)
         g_return_val_if_fail (task != NULL, FALSE);
         g_return_val_if_fail (url != NULL, FALSE);
 
+        rtm_task_forget (task, LAZY_URL);
         task->priv->url = g_strdup (url);
         return TRUE;
 }
@@ -813,6 +1392,7 @@ rtm_task_get_location_id (RtmTask *task)
 {
         g_return_val_if_fail (task != NULL, NULL);
 
+        rtm_task_ensure (task, LAZY_LOCATION_ID);
         return task->priv->location_id;
 }
 
@@ -831,6 +1411,7 @@ rtm_task_set_location_id (RtmTask *task, gchar* location_id)
         g_return_val_if_fail (task != NULL, FALSE);
         g_return_val_if_fail (location_id != NULL, FALSE);
 
+        rtm_task_forget (task, LAZY_LOCATION_ID);
         task->priv->location_id = g_strdup (location_id);
         return TRUE;
 }
@@ -884,6 +1465,8 @@ rtm_task_get_tags (RtmTask *task)
 {
         g_return_val_if_fail (task != NULL, NULL);
 
+        rtm_task_ensure (task, LAZY_TAGS);
+
         return g_list_copy (task->priv->tags);
 }
 
@@ -905,6 +1488,8 @@ rtm_task_find_tag (RtmTask *task, gchar *tag)
         GList *item;
         gchar *temp_tag;
 
+        rtm_task_ensure (task, LAZY_TAGS);
+
         for (item = task->priv->tags; item; item = g_list_next (item)) {
                 temp_tag = (gchar *) item->data;
                 if (g_strcmp0 (temp_tag, tag) == 0) {
@@ -995,6 +1580,7 @@ rtm_task_get_added_date (RtmTask *task)
 {
         g_return_val_if_fail (task != NULL, NULL);
 
+        rtm_task_ensure (task, LAZY_ADDED);
         return task->priv->added_date;
 }
 
@@ -1013,6 +1599,7 @@ rtm_task_set_added_date (RtmTask *task, GTimeVal *added_date)
         g_return_val_if_fail (task != NULL, FALSE);
         g_return_val_if_fail (added_date != NULL, FALSE);
 
+        rtm_task_forget (task, LAZY_ADDED);
         task->priv->added_date = rtm_util_g_time_val_dup (added_date);
         return TRUE;
 }
@@ -1030,6 +1617,7 @@ rtm_task_get_completed_date (RtmTask *task)
 {
         g_return_val_if_fail (task != NULL, NULL);
 
+        rtm_task_ensure (task, LAZY_COMPLETED);
         return task->priv->completed_date;
 }
 
@@ -1048,6 +1636,7 @@ rtm_task_set_completed_date (RtmTask *task, GTimeVal *completed_date)
         g_return_val_if_fail (task != NULL, FALSE);
         g_return_val_if_fail (completed_date != NULL, FALSE);
 
+        rtm_task_forget (task, LAZY_COMPLETED);
         task->priv->completed_date = rtm_util_g_time_val_dup (completed_date);
         return TRUE;
 }
@@ -1065,6 +1654,7 @@ rtm_task_get_deleted_date (RtmTask *task)
 {
         g_return_val_if_fail (task != NULL, NULL);
 
+        rtm_task_ensure (task, LAZY_DELETED);
         return task->priv->deleted_date;
 }
 
@@ -1083,6 +1673,7 @@ rtm_task_set_deleted_date (RtmTask *task, GTimeVal *deleted_date)
         g_return_val_if_fail (task != NULL, FALSE);
         g_return_val_if_fail (deleted_date != NULL, FALSE);
 
+        rtm_task_forget (task, LAZY_DELETED);
         task->priv->deleted_date = rtm_util_g_time_val_dup (deleted_date);
         return TRUE;
 }
@@ -1134,6 +1725,7 @@ rtm_task_get_estimate (RtmTask *task)
 {
         g_return_val_if_fail (task != NULL, NULL);
 
+        rtm_task_ensure (task, LAZY_ESTIMATE);
         return task->priv->estimate;
 }
 
@@ -1152,6 +1744,7 @@ rtm_task_set_estimate (RtmTask *task, gchar* estimate)
         g_return_val_if_fail (task != NULL, FALSE);
         g_return_val_if_fail (estimate != NULL, FALSE);
 
+        rtm_task_forget (task, LAZY_ESTIMATE);
         task->priv->estimate = g_strdup (estimate);
         return TRUE;
 }
@@ -1204,6 +1797,7 @@ rtm_task_get_created_date (RtmTask *task)
 {
         g_return_val_if_fail (task != NULL, NULL);
 
+        rtm_task_ensure (task, LAZY_CREATED);
         return task->priv->created_date;
 }
 
@@ -1222,6 +1816,7 @@ rtm_task_set_created_date (RtmTask *task, GTimeVal *created_date)
         g_return_val_if_fail (task != NULL, FALSE);
         g_return_val_if_fail (created_date != NULL, FALSE);
 
+        rtm_task_forget (task, LAZY_CREATED);
         task->priv->created_date = rtm_util_g_time_val_dup (created_date);
         return TRUE;
 }
@@ -1239,6 +1834,7 @@ rtm_task_get_modified_date (RtmTask *task)
 {
         g_return_val_if_fail (task != NULL, NULL);
 
+        rtm_task_ensure (task, LAZY_MODIFIED);
         return task->priv->modified_date;
 }
 
@@ -1257,6 +1853,7 @@ rtm_task_set_modified_date (RtmTask *task, GTimeVal *modified_date)
         g_return_val_if_fail (task != NULL, FALSE);
         g_return_val_if_fail (modified_date != NULL, FALSE);
 
+        rtm_task_forget (task, LAZY_MODIFIED);
         task->priv->modified_date = rtm_util_g_time_val_dup (modified_date);
         return TRUE;
 }
@@ -1274,6 +1871,7 @@ rtm_task_get_source (RtmTask *task)
 {
         g_return_val_if_fail (task != NULL, NULL);
 
+        rtm_task_ensure (task, LAZY_SOURCE);
         return task->priv->source;
 }
 
@@ -1292,6 +1890,7 @@ rtm_task_set_source (RtmTask *task, gchar* source)
         g_return_val_if_fail (task != NULL, FALSE);
         g_return_val_if_fail (source != NULL, FALSE);
 
+        rtm_task_forget (task, LAZY_SOURCE);
         task->priv->source = g_strdup (source);
         return TRUE;
 }
@@ -1309,6 +1908,7 @@ rtm_task_get_recurrence (RtmTask *task)
 {
         g_return_val_if_fail (task != NULL, NULL);
 
+        rtm_task_ensure (task, LAZY_RECURRENCE);
         return task->priv->recurrence;
 }
 
@@ -1327,6 +1927,7 @@ rtm_task_set_recurrence (RtmTask *task, gchar* recurrence)
         g_return_val_if_fail (task != NULL, FALSE);
         g_return_val_if_fail (recurrence != NULL, FALSE);
 
+        rtm_task_forget (task, LAZY_RECURRENCE);
         task->priv->recurrence = g_strdup (recurrence);
         return TRUE;
 }
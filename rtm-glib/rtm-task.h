@@ -92,6 +92,10 @@ rtm_task_set_priority (RtmTask *task, gchar* priority);
 void
 rtm_task_load_data (RtmTask *task, RestXmlNode *node, const gchar *list_id);
 
+void
+rtm_task_load_attribute (RtmTask *task, const gchar *element,
+                         const gchar *name, const gchar *value);
+
 gchar *
 rtm_task_to_string (RtmTask *task);
 
@@ -27,6 +27,7 @@
 
 #include <rtm-time-zone.h>
 #include <rtm-util.h>
+#include <rtm-attributes.h>
 
 #define RTM_TIME_ZONE_GET_PRIVATE(obj) (G_TYPE_INSTANCE_GET_PRIVATE (        \
                                            (obj), RTM_TYPE_TIME_ZONE, RtmTimeZonePrivate))
@@ -49,6 +50,27 @@ enum {
         PROP_CURRENT_OFFSET,
 };
 
+/* Attributes of the timezone element, in the order of rtm_time_zone_attribute_names */
+enum {
+        ATTRIBUTE_ID,
+        ATTRIBUTE_NAME,
+        ATTRIBUTE_DST,
+        ATTRIBUTE_OFFSET,
+        ATTRIBUTE_CURRENT_OFFSET,
+};
+
+static const gchar * const rtm_time_zone_attribute_names[] = {
+        "id",
+        "name",
+        "dst",
+        "offset",
+        "current_offset",
+        NULL
+};
+
+static RtmAttributes rtm_time_zone_attributes =
+        RTM_ATTRIBUTES_INIT (rtm_time_zone_attribute_names);
+
 G_DEFINE_TYPE (RtmTimeZone, rtm_time_zone, G_TYPE_OBJECT);
 
 static void
@@ -391,6 +413,34 @@ rtm_time_zone_set_current_offset (RtmTimeZone *time_zone, gchar* current_offset)
         return TRUE;
 }
 
+static void
+rtm_time_zone_set_attribute (RtmTimeZone *time_zone, gint id, const gchar *value)
+{
+        RtmTimeZonePrivate *priv = time_zone->priv;
+
+        switch (id) {
+        case ATTRIBUTE_ID:
+                g_free (priv->id);
+                priv->id = g_strdup (value);
+                break;
+        case ATTRIBUTE_NAME:
+                g_free (priv->name);
+                priv->name = g_strdup (value);
+                break;
+        case ATTRIBUTE_DST:
+                priv->dst = (g_strcmp0 (value, "1") == 0);
+                break;
+        case ATTRIBUTE_OFFSET:
+                g_free (priv->offset);
+                priv->offset = g_strdup (value);
+                break;
+        case ATTRIBUTE_CURRENT_OFFSET:
+                g_free (priv->current_offset);
+                priv->current_offset = g_strdup (value);
+                break;
+        }
+}
+
 /**
  * rtm_time_zone_load_data:
  * @time_zone: a #RtmTimeZone.
@@ -404,11 +454,30 @@ rtm_time_zone_load_data (RtmTimeZone *time_zone, RestXmlNode *node)
         g_return_if_fail (time_zone != NULL);
         g_return_if_fail (node != NULL);
 
-        time_zone->priv->id = g_strdup (rest_xml_node_get_attr (node, "id"));
-        time_zone->priv->name = g_strdup (rest_xml_node_get_attr (node, "name"));
-        time_zone->priv->dst = (g_strcmp0 (rest_xml_node_get_attr (node, "dst"), "1") == 0);
-        time_zone->priv->offset = g_strdup (rest_xml_node_get_attr (node, "offset"));
-        time_zone->priv->current_offset = g_strdup (rest_xml_node_get_attr (node, "current_offset"));
+        rtm_attributes_load_node (&rtm_time_zone_attributes, node,
+                                  (RtmAttributesSetFunc) rtm_time_zone_set_attribute,
+                                  time_zone);
+}
+
+/**
+ * rtm_time_zone_load_attribute:
+ * @time_zone: a #RtmTimeZone.
+ * @name: the name of an attribute of the timezone element.
+ * @value: the value of the attribute.
+ *
+ * Sets one field of the #RtmTimeZone object, as found in a response. Unknown
+ * attributes are ignored.
+ */
+void
+rtm_time_zone_load_attribute (RtmTimeZone *time_zone, const gchar *name,
+                              const gchar *value)
+{
+        g_return_if_fail (time_zone != NULL);
+        g_return_if_fail (name != NULL);
+
+        rtm_time_zone_set_attribute (
+                time_zone, rtm_attributes_lookup (&rtm_time_zone_attributes, name),
+                value);
 }
 
 /**
@@ -93,6 +93,10 @@ rtm_time_zone_set_current_offset (RtmTimeZone *time_zone, gchar* current_offset)
 void
 rtm_time_zone_load_data (RtmTimeZone *time_zone, RestXmlNode *node);
 
+void
+rtm_time_zone_load_attribute (RtmTimeZone *time_zone, const gchar *name,
+                              const gchar *value);
+
 gchar *
 rtm_time_zone_to_string (RtmTimeZone *time_zone);
 
@@ -0,0 +1,350 @@
+/*
+ * rtm-timeout.c: Time limit of API calls
+ *
+ * Copyright (C) 2009 Manuel Rego Casasnovas <mrego@igalia.com>
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301 USA
+ */
+
+
+/*
+ * Each attempt of a call gets its own #GCancellable, which is cancelled when
+ * the caller cancels the call or when the time limit expires, so the
+ * transport only has to honor a cancellable to support both.
+ *
+ * The timers run in a thread of their own, so they expire even while a
+ * synchronous call blocks the thread that made it. The thread is started
+ * with the first pending timer and kept for the next calls, it is only
+ * stopped once no timer has been pending for %RTM_TIMEOUT_LINGER seconds.
+ */
+
+#include <rtm-timeout.h>
+#include <rtm-error.h>
+#include <rtm-util.h>
+
+/* Seconds the timers thread waits without timers before stopping */
+#define RTM_TIMEOUT_LINGER 60
+
+struct _RtmTimeout {
+        gint ref_count;
+        guint timeout;
+        gint expired;
+        GCancellable *parent;
+        GCancellable *cancellable;
+        gulong cancelled_id;
+        GSource *source;
+};
+
+typedef struct {
+        GMainContext *context;
+        gint stop;
+} RtmTimeoutThread;
+
+/* The thread of the timers, the number of timers pending in it and the
+ * source stopping it when none is */
+G_LOCK_DEFINE_STATIC (rtm_timeout);
+static RtmTimeoutThread *rtm_timeout_thread_data = NULL;
+static guint rtm_timeout_n_pending = 0;
+static GSource *rtm_timeout_linger_source = NULL;
+
+static gpointer
+rtm_timeout_thread (gpointer user_data)
+{
+        RtmTimeoutThread *thread = user_data;
+
+        while (!g_atomic_int_get (&thread->stop)) {
+                g_main_context_iteration (thread->context, TRUE);
+        }
+
+        g_main_context_unref (thread->context);
+        g_slice_free (RtmTimeoutThread, thread);
+
+        return NULL;
+}
+
+static gboolean
+rtm_timeout_linger_cb (gpointer user_data)
+{
+        RtmTimeoutThread *thread = user_data;
+
+        G_LOCK (rtm_timeout);
+
+        /* A timer could have been taken while this was being dispatched */
+        if (rtm_timeout_n_pending == 0 &&
+            rtm_timeout_linger_source == g_main_current_source ()) {
+                g_source_unref (rtm_timeout_linger_source);
+                rtm_timeout_linger_source = NULL;
+                rtm_timeout_thread_data = NULL;
+
+                /* Seen by the thread once this returns, it runs here */
+                g_atomic_int_set (&thread->stop, TRUE);
+        }
+
+        G_UNLOCK (rtm_timeout);
+
+        return FALSE;
+}
+
+/**
+ * rtm_timeout_hold:
+ *
+ * Gets the context where the timers run, starting its thread if it is not
+ * running. Call rtm_timeout_release() once the timer is destroyed.
+ *
+ * Returns: the #GMainContext of the timers thread.
+ */
+static GMainContext *
+rtm_timeout_hold (void)
+{
+        RtmTimeoutThread *thread;
+
+        G_LOCK (rtm_timeout);
+
+        rtm_timeout_n_pending++;
+        if (rtm_timeout_linger_source) {
+                g_source_destroy (rtm_timeout_linger_source);
+                g_source_unref (rtm_timeout_linger_source);
+                rtm_timeout_linger_source = NULL;
+        }
+
+        if (rtm_timeout_thread_data == NULL) {
+                thread = g_slice_new0 (RtmTimeoutThread);
+                thread->context = g_main_context_new ();
+                rtm_timeout_thread_data = thread;
+                g_thread_unref (g_thread_new ("rtm-timeout",
+                                              rtm_timeout_thread, thread));
+        }
+        thread = rtm_timeout_thread_data;
+
+        G_UNLOCK (rtm_timeout);
+
+        return thread->context;
+}
+
+/**
+ * rtm_timeout_release:
+ *
+ * Drops a timer taken with rtm_timeout_hold(). If it was the last one
+ * pending, the thread of the timers is stopped after %RTM_TIMEOUT_LINGER
+ * seconds unless another timer is taken before.
+ */
+static void
+rtm_timeout_release (void)
+{
+        RtmTimeoutThread *thread;
+
+        G_LOCK (rtm_timeout);
+
+        if (--rtm_timeout_n_pending == 0) {
+                thread = rtm_timeout_thread_data;
+                rtm_timeout_linger_source = g_timeout_source_new_seconds (
+                        RTM_TIMEOUT_LINGER);
+                g_source_set_callback (rtm_timeout_linger_source,
+                                       rtm_timeout_linger_cb, thread, NULL);
+                g_source_attach (rtm_timeout_linger_source, thread->context);
+        }
+
+        G_UNLOCK (rtm_timeout);
+}
+
+static RtmTimeout *
+rtm_timeout_ref (RtmTimeout *timeout)
+{
+        g_atomic_int_inc (&timeout->ref_count);
+
+        return timeout;
+}
+
+static void
+rtm_timeout_unref (RtmTimeout *timeout)
+{
+        if (!g_atomic_int_dec_and_test (&timeout->ref_count)) {
+                return;
+        }
+
+        if (timeout->parent) {
+                g_object_unref (timeout->parent);
+        }
+        g_object_unref (timeout->cancellable);
+
+        g_slice_free (RtmTimeout, timeout);
+}
+
+static gboolean
+rtm_timeout_expired_cb (gpointer user_data)
+{
+        RtmTimeout *timeout = user_data;
+
+        DEBUG_PRINT ("rtm_timeout: no response after %u seconds",
+                     timeout->timeout);
+
+        g_atomic_int_set (&timeout->expired, TRUE);
+        g_cancellable_cancel (timeout->cancellable);
+
+        return FALSE;
+}
+
+static void
+rtm_timeout_cancelled_cb (GCancellable *parent, GCancellable *cancellable)
+{
+        g_cancellable_cancel (cancellable);
+}
+
+/**
+ * rtm_timeout_new:
+ * @timeout: the time limit in seconds, or 0 for no limit.
+ * @cancellable: optional #GCancellable of the caller, %NULL to ignore.
+ *
+ * Starts the time limit of an attempt to send a call.
+ *
+ * Returns: a new #RtmTimeout. Free with rtm_timeout_free() once the attempt
+ * is finished.
+ */
+RtmTimeout *
+rtm_timeout_new (guint timeout, GCancellable *cancellable)
+{
+        RtmTimeout *rtm_timeout;
+
+        rtm_timeout = g_slice_new0 (RtmTimeout);
+        rtm_timeout->ref_count = 1;
+        rtm_timeout->timeout = timeout;
+        rtm_timeout->cancellable = g_cancellable_new ();
+
+        if (cancellable) {
+                rtm_timeout->parent = g_object_ref (cancellable);
+                rtm_timeout->cancelled_id = g_cancellable_connect (
+                        cancellable,
+                        G_CALLBACK (rtm_timeout_cancelled_cb),
+                        rtm_timeout->cancellable, NULL);
+        }
+
+        if (timeout > 0) {
+                rtm_timeout->source = g_timeout_source_new_seconds (timeout);
+                g_source_set_callback (rtm_timeout->source,
+                                       rtm_timeout_expired_cb,
+                                       rtm_timeout_ref (rtm_timeout),
+                                       (GDestroyNotify) rtm_timeout_unref);
+                g_source_attach (rtm_timeout->source, rtm_timeout_hold ());
+        }
+
+        return rtm_timeout;
+}
+
+/**
+ * rtm_timeout_get_cancellable:
+ * @timeout: a #RtmTimeout.
+ *
+ * Gets the #GCancellable to be passed to the transport, which is cancelled
+ * when the time limit expires or the caller cancels.
+ *
+ * Returns: the #GCancellable of the attempt.
+ */
+GCancellable *
+rtm_timeout_get_cancellable (RtmTimeout *timeout)
+{
+        g_assert (timeout != NULL);
+
+        return timeout->cancellable;
+}
+
+/**
+ * rtm_timeout_check:
+ * @timeout: a #RtmTimeout.
+ * @error: the error returned by the attempt, if any.
+ *
+ * Replaces the error of an attempt interrupted by @timeout with
+ * %RTM_ERROR_TIMED_OUT if the time limit expired, or with
+ * %G_IO_ERROR_CANCELLED if the caller cancelled.
+ */
+void
+rtm_timeout_check (RtmTimeout *timeout, GError **error)
+{
+        g_assert (timeout != NULL);
+
+        if (error == NULL || *error == NULL) {
+                return;
+        }
+
+        if (g_atomic_int_get (&timeout->expired)) {
+                g_clear_error (error);
+                g_set_error (error,
+                             RTM_ERROR_DOMAIN,
+                             RTM_ERROR_TIMED_OUT,
+                             "No response after %u seconds",
+                             timeout->timeout);
+        } else if (g_cancellable_is_cancelled (timeout->parent)) {
+                g_clear_error (error);
+                g_cancellable_set_error_if_cancelled (timeout->parent, error);
+        }
+}
+
+/**
+ * rtm_timeout_free:
+ * @timeout: a #RtmTimeout.
+ *
+ * Stops the time limit and frees @timeout.
+ */
+void
+rtm_timeout_free (RtmTimeout *timeout)
+{
+        if (timeout->source) {
+                g_source_destroy (timeout->source);
+                g_source_unref (timeout->source);
+                rtm_timeout_release ();
+        }
+
+        if (timeout->cancelled_id) {
+                g_cancellable_disconnect (timeout->parent,
+                                          timeout->cancelled_id);
+        }
+
+        rtm_timeout_unref (timeout);
+}
+
+/**
+ * rtm_timeout_sleep:
+ * @delay: the time to wait in microseconds.
+ * @cancellable: optional #GCancellable object, %NULL to ignore.
+ *
+ * Blocks the current thread for @delay, waking up as soon as @cancellable
+ * is cancelled.
+ *
+ * Returns: %TRUE if the whole delay elapsed, %FALSE if it was cancelled.
+ */
+gboolean
+rtm_timeout_sleep (gint64 delay, GCancellable *cancellable)
+{
+        GPollFD pollfd;
+        gint64 end;
+        gint64 now;
+
+        if (!g_cancellable_make_pollfd (cancellable, &pollfd)) {
+                if (delay > 0) {
+                        g_usleep (delay);
+                }
+                return TRUE;
+        }
+
+        end = g_get_monotonic_time () + delay;
+        now = g_get_monotonic_time ();
+        while (now < end && !g_cancellable_is_cancelled (cancellable)) {
+                g_poll (&pollfd, 1, (gint) ((end - now + 999) / 1000));
+                now = g_get_monotonic_time ();
+        }
+
+        g_cancellable_release_fd (cancellable);
+
+        return !g_cancellable_is_cancelled (cancellable);
+}
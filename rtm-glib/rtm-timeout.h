@@ -0,0 +1,49 @@
+/*
+ * rtm-timeout.h: Time limit of API calls
+ *
+ * Copyright (C) 2009 Manuel Rego Casasnovas <mrego@igalia.com>
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301 USA
+ */
+
+
+#ifndef __RTM_TIMEOUT_H__
+#define __RTM_TIMEOUT_H__
+
+#include <gio/gio.h>
+
+
+G_BEGIN_DECLS
+
+typedef struct _RtmTimeout RtmTimeout;
+
+RtmTimeout *
+rtm_timeout_new (guint timeout, GCancellable *cancellable);
+
+GCancellable *
+rtm_timeout_get_cancellable (RtmTimeout *timeout);
+
+void
+rtm_timeout_check (RtmTimeout *timeout, GError **error);
+
+void
+rtm_timeout_free (RtmTimeout *timeout);
+
+gboolean
+rtm_timeout_sleep (gint64 delay, GCancellable *cancellable);
+
+G_END_DECLS
+
+#endif /* __RTM_TIMEOUT_H__ */
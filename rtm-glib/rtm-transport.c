@@ -0,0 +1,300 @@
+/*
+ * rtm-transport.c: Interface to send calls to Remember The Milk
+ *
+ * Copyright (C) 2009 Manuel Rego Casasnovas <mrego@igalia.com>
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301 USA
+ */
+
+/**
+ * SECTION:rtm-transport
+ * @short_description: An interface to send calls to Remember The Milk
+ *
+ * #RtmTransport abstracts how the signed parameters of a call reach the web
+ * service and how the response payload comes back. #RtmGlib uses a
+ * #RtmRestTransport by default, a #RtmLoopbackTransport serves canned
+ * responses from memory.
+ *
+ * The parameters are passed as a %NULL-terminated array alternating names
+ * and values, which already includes the method, api_key and api_sig.
+ *
+ * Large responses can be streamed with rtm_transport_send_stream_async(),
+ * which hands out the payload in pieces while it is downloaded, so it can
+ * be parsed without waiting for the whole of it.
+ */
+
+#include <rtm-transport.h>
+
+G_DEFINE_INTERFACE (RtmTransport, rtm_transport, G_TYPE_OBJECT);
+
+static void
+rtm_transport_send_thread (GTask *task, gpointer source_object,
+                           gpointer task_data, GCancellable *cancellable)
+{
+        RtmTransport *transport = RTM_TRANSPORT (source_object);
+        GBytes *payload;
+        GError *error = NULL;
+
+        payload = RTM_TRANSPORT_GET_INTERFACE (transport)->send (
+                transport, task_data, cancellable, &error);
+        if (payload == NULL) {
+                g_task_return_error (task, error);
+        } else {
+                g_task_return_pointer (task, payload,
+                                       (GDestroyNotify) g_bytes_unref);
+        }
+}
+
+static void
+rtm_transport_real_send_async (RtmTransport *transport, gchar **params,
+                               GCancellable *cancellable,
+                               GAsyncReadyCallback callback,
+                               gpointer user_data)
+{
+        GTask *task;
+
+        task = g_task_new (transport, cancellable, callback, user_data);
+        g_task_set_task_data (task, g_strdupv (params),
+                              (GDestroyNotify) g_strfreev);
+        g_task_run_in_thread (task, rtm_transport_send_thread);
+        g_object_unref (task);
+}
+
+static GBytes *
+rtm_transport_real_send_finish (RtmTransport *transport, GAsyncResult *result,
+                                GError **error)
+{
+        return g_task_propagate_pointer (G_TASK (result), error);
+}
+
+/* A streamed call of a transport without support for streaming */
+typedef struct {
+        RtmTransportChunkFunc chunk_func;
+        gpointer chunk_data;
+} RtmTransportStream;
+
+static void
+rtm_transport_stream_free (gpointer data)
+{
+        g_slice_free (RtmTransportStream, data);
+}
+
+static void
+rtm_transport_stream_cb (GObject *source_object, GAsyncResult *result,
+                         gpointer user_data)
+{
+        GTask *task = G_TASK (user_data);
+        RtmTransportStream *stream = g_task_get_task_data (task);
+        GBytes *payload;
+        gconstpointer data;
+        gsize length;
+        GError *error = NULL;
+
+        payload = rtm_transport_send_finish (RTM_TRANSPORT (source_object),
+                                             result, &error);
+        if (payload == NULL) {
+                g_task_return_error (task, error);
+        } else {
+                data = g_bytes_get_data (payload, &length);
+                stream->chunk_func (data, length, stream->chunk_data);
+                g_bytes_unref (payload);
+
+                g_task_return_boolean (task, TRUE);
+        }
+
+        g_object_unref (task);
+}
+
+static void
+rtm_transport_real_send_stream_async (RtmTransport *transport, gchar **params,
+                                      RtmTransportChunkFunc chunk_func,
+                                      gpointer chunk_data,
+                                      GCancellable *cancellable,
+                                      GAsyncReadyCallback callback,
+                                      gpointer user_data)
+{
+        GTask *task;
+        RtmTransportStream *stream;
+
+        task = g_task_new (transport, cancellable, callback, user_data);
+
+        stream = g_slice_new (RtmTransportStream);
+        stream->chunk_func = chunk_func;
+        stream->chunk_data = chunk_data;
+        g_task_set_task_data (task, stream, rtm_transport_stream_free);
+
+        rtm_transport_send_async (transport, params, cancellable,
+                                  rtm_transport_stream_cb, task);
+}
+
+static gboolean
+rtm_transport_real_send_stream_finish (RtmTransport *transport,
+                                       GAsyncResult *result, GError **error)
+{
+        return g_task_propagate_boolean (G_TASK (result), error);
+}
+
+static void
+rtm_transport_default_init (RtmTransportInterface *iface)
+{
+        iface->send_async = rtm_transport_real_send_async;
+        iface->send_finish = rtm_transport_real_send_finish;
+        iface->send_stream_async = rtm_transport_real_send_stream_async;
+        iface->send_stream_finish = rtm_transport_real_send_stream_finish;
+}
+
+/**
+ * rtm_transport_send:
+ * @transport: a #RtmTransport.
+ * @params: %NULL-terminated array alternating names and values.
+ * @cancellable: optional #GCancellable object, %NULL to ignore.
+ * @error: location to store #GError or %NULL.
+ *
+ * Sends a signed call and waits for the response.
+ *
+ * Returns: the response payload, or %NULL on error. Free with
+ * g_bytes_unref().
+ */
+GBytes *
+rtm_transport_send (RtmTransport *transport, gchar **params,
+                    GCancellable *cancellable, GError **error)
+{
+        g_return_val_if_fail (RTM_IS_TRANSPORT (transport), NULL);
+        g_return_val_if_fail (params != NULL, NULL);
+
+        return RTM_TRANSPORT_GET_INTERFACE (transport)->send (
+                transport, params, cancellable, error);
+}
+
+/**
+ * rtm_transport_send_async:
+ * @transport: a #RtmTransport.
+ * @params: %NULL-terminated array alternating names and values.
+ * @cancellable: optional #GCancellable object, %NULL to ignore.
+ * @callback: a #GAsyncReadyCallback to call when the request is satisfied.
+ * @user_data: the data to pass to callback function.
+ *
+ * Sends a signed call asynchronously. When the operation is finished,
+ * @callback will be called. You can then call rtm_transport_send_finish() to
+ * get the result of the operation.
+ */
+void
+rtm_transport_send_async (RtmTransport *transport, gchar **params,
+                          GCancellable *cancellable,
+                          GAsyncReadyCallback callback, gpointer user_data)
+{
+        g_return_if_fail (RTM_IS_TRANSPORT (transport));
+        g_return_if_fail (params != NULL);
+
+        RTM_TRANSPORT_GET_INTERFACE (transport)->send_async (
+                transport, params, cancellable, callback, user_data);
+}
+
+/**
+ * rtm_transport_send_finish:
+ * @transport: a #RtmTransport.
+ * @result: the #GAsyncResult passed to the callback.
+ * @error: location to store #GError or %NULL.
+ *
+ * Finishes an operation started with rtm_transport_send_async().
+ *
+ * Returns: the response payload, or %NULL on error. Free with
+ * g_bytes_unref().
+ */
+GBytes *
+rtm_transport_send_finish (RtmTransport *transport, GAsyncResult *result,
+                           GError **error)
+{
+        g_return_val_if_fail (RTM_IS_TRANSPORT (transport), NULL);
+
+        return RTM_TRANSPORT_GET_INTERFACE (transport)->send_finish (
+                transport, result, error);
+}
+
+/**
+ * rtm_transport_send_stream_async:
+ * @transport: a #RtmTransport.
+ * @params: %NULL-terminated array alternating names and values.
+ * @chunk_func: the #RtmTransportChunkFunc receiving the payload.
+ * @chunk_data: the data to pass to @chunk_func.
+ * @cancellable: optional #GCancellable object, %NULL to ignore.
+ * @callback: a #GAsyncReadyCallback to call when the request is satisfied.
+ * @user_data: the data to pass to callback function.
+ *
+ * Sends a signed call asynchronously, calling @chunk_func with each piece of
+ * the payload as it is downloaded. @chunk_func is called from the
+ * thread-default main context of the caller, always before @callback. You
+ * can then call rtm_transport_send_stream_finish() to know if the whole
+ * payload was received.
+ */
+void
+rtm_transport_send_stream_async (RtmTransport *transport, gchar **params,
+                                 RtmTransportChunkFunc chunk_func,
+                                 gpointer chunk_data,
+                                 GCancellable *cancellable,
+                                 GAsyncReadyCallback callback,
+                                 gpointer user_data)
+{
+        g_return_if_fail (RTM_IS_TRANSPORT (transport));
+        g_return_if_fail (params != NULL);
+        g_return_if_fail (chunk_func != NULL);
+
+        RTM_TRANSPORT_GET_INTERFACE (transport)->send_stream_async (
+                transport, params, chunk_func, chunk_data, cancellable,
+                callback, user_data);
+}
+
+/**
+ * rtm_transport_send_stream_finish:
+ * @transport: a #RtmTransport.
+ * @result: the #GAsyncResult passed to the callback.
+ * @error: location to store #GError or %NULL.
+ *
+ * Finishes an operation started with rtm_transport_send_stream_async().
+ *
+ * Returns: %TRUE if the whole payload was received, %FALSE on error.
+ */
+gboolean
+rtm_transport_send_stream_finish (RtmTransport *transport,
+                                  GAsyncResult *result, GError **error)
+{
+        g_return_val_if_fail (RTM_IS_TRANSPORT (transport), FALSE);
+
+        return RTM_TRANSPORT_GET_INTERFACE (transport)->send_stream_finish (
+                transport, result, error);
+}
+
+/**
+ * rtm_transport_lookup_param:
+ * @params: %NULL-terminated array alternating names and values.
+ * @name: the name of the parameter.
+ *
+ * Looks up the value of a parameter of a call.
+ *
+ * Returns: the value of @name, or %NULL if it is not in @params.
+ */
+const gchar *
+rtm_transport_lookup_param (gchar **params, const gchar *name)
+{
+        guint i;
+
+        for (i = 0; params != NULL && params[i] != NULL; i += 2) {
+                if (g_strcmp0 (params[i], name) == 0) {
+                        return params[i + 1];
+                }
+        }
+
+        return NULL;
+}
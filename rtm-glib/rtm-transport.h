@@ -0,0 +1,129 @@
+/*
+ * rtm-transport.h: Interface to send calls to Remember The Milk
+ *
+ * Copyright (C) 2009 Manuel Rego Casasnovas <mrego@igalia.com>
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301 USA
+ */
+
+#ifndef __RTM_TRANSPORT_H__
+#define __RTM_TRANSPORT_H__
+
+#include <glib-object.h>
+#include <gio/gio.h>
+
+
+G_BEGIN_DECLS
+
+#define RTM_TYPE_TRANSPORT (rtm_transport_get_type ())
+#define RTM_TRANSPORT(obj)                                                  \
+        (G_TYPE_CHECK_INSTANCE_CAST ((obj), RTM_TYPE_TRANSPORT, RtmTransport))
+#define RTM_IS_TRANSPORT(obj)                                       \
+        (G_TYPE_CHECK_INSTANCE_TYPE ((obj), RTM_TYPE_TRANSPORT))
+#define RTM_TRANSPORT_GET_INTERFACE(obj)                                    \
+        (G_TYPE_INSTANCE_GET_INTERFACE ((obj), RTM_TYPE_TRANSPORT, RtmTransportInterface))
+
+typedef struct _RtmTransport RtmTransport;
+typedef struct _RtmTransportInterface RtmTransportInterface;
+
+/**
+ * RtmTransportChunkFunc:
+ * @data: the next piece of the response payload.
+ * @length: the length of @data.
+ * @user_data: the data passed to rtm_transport_send_stream_async().
+ *
+ * Receives the payload of a streamed call as it is downloaded.
+ */
+typedef void (*RtmTransportChunkFunc) (const gchar *data, gsize length,
+                                       gpointer user_data);
+
+/**
+ * RtmTransportInterface:
+ * @parent_iface: the parent interface.
+ * @send: sends a signed call and waits for the response.
+ * @send_async: sends a signed call asynchronously. By default @send is run
+ * in a thread.
+ * @send_finish: finishes an operation started with @send_async.
+ * @send_stream_async: sends a signed call asynchronously, handing out the
+ * payload as it is downloaded. By default the whole payload got with
+ * @send_async is handed out at once.
+ * @send_stream_finish: finishes an operation started with
+ * @send_stream_async.
+ *
+ * Sends the signed parameters of a call to Remember The Milk and gets the
+ * response payload back, already decompressed. Failures to get a response
+ * are reported with the %RTM_ERROR_DOMAIN network codes; the payload of a
+ * failed response is returned as any other.
+ */
+struct _RtmTransportInterface {
+        GTypeInterface parent_iface;
+
+        GBytes * (*send) (RtmTransport *transport, gchar **params,
+                          GCancellable *cancellable, GError **error);
+
+        void (*send_async) (RtmTransport *transport, gchar **params,
+                            GCancellable *cancellable,
+                            GAsyncReadyCallback callback,
+                            gpointer user_data);
+
+        GBytes * (*send_finish) (RtmTransport *transport,
+                                 GAsyncResult *result, GError **error);
+
+        void (*send_stream_async) (RtmTransport *transport, gchar **params,
+                                   RtmTransportChunkFunc chunk_func,
+                                   gpointer chunk_data,
+                                   GCancellable *cancellable,
+                                   GAsyncReadyCallback callback,
+                                   gpointer user_data);
+
+        gboolean (*send_stream_finish) (RtmTransport *transport,
+                                        GAsyncResult *result,
+                                        GError **error);
+};
+
+GType
+rtm_transport_get_type (void) G_GNUC_CONST;
+
+GBytes *
+rtm_transport_send (RtmTransport *transport, gchar **params,
+                    GCancellable *cancellable, GError **error);
+
+void
+rtm_transport_send_async (RtmTransport *transport, gchar **params,
+                          GCancellable *cancellable,
+                          GAsyncReadyCallback callback, gpointer user_data);
+
+GBytes *
+rtm_transport_send_finish (RtmTransport *transport, GAsyncResult *result,
+                           GError **error);
+
+void
+rtm_transport_send_stream_async (RtmTransport *transport, gchar **params,
+                                 RtmTransportChunkFunc chunk_func,
+                                 gpointer chunk_data,
+                                 GCancellable *cancellable,
+                                 GAsyncReadyCallback callback,
+                                 gpointer user_data);
+
+gboolean
+rtm_transport_send_stream_finish (RtmTransport *transport,
+                                  GAsyncResult *result, GError **error);
+
+const gchar *
+rtm_transport_lookup_param (gchar **params, const gchar *name);
+
+G_END_DECLS
+
+#endif /* __RTM_TRANSPORT_H__ */
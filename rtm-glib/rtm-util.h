@@ -35,3 +35,6 @@ rtm_util_g_time_val_dup (GTimeVal *time_val);
 
 gchar *
 rtm_util_g_time_val_to_string (GTimeVal *time_val);
+
+gboolean
+rtm_util_g_time_val_from_iso8601 (const gchar *iso_date, GTimeVal *time_val);
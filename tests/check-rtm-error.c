@@ -0,0 +1,104 @@
+/*
+ * check-rtm-error.c: Test RtmError codes
+ *
+ * Copyright (C) 2009 Manuel Rego Casasnovas <mrego@igalia.com>
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301 USA
+ */
+
+#include <stdlib.h>
+#include <check.h>
+#include <gio/gio.h>
+#include <rtm-glib/rtm-error.h>
+
+START_TEST (test_service_code)
+{
+        fail_unless (rtm_error_from_service_code (96) == RTM_ERROR_INVALID_SIGNATURE,
+                     "Invalid signature code not mapped properly");
+        fail_unless (rtm_error_from_service_code (97) == RTM_ERROR_INVALID_SIGNATURE,
+                     "Missing signature code not mapped properly");
+        fail_unless (rtm_error_from_service_code (98) == RTM_ERROR_LOGIN_FAILED,
+                     "Login failed code not mapped properly");
+        fail_unless (rtm_error_from_service_code (100) == RTM_ERROR_INVALID_API_KEY,
+                     "Invalid API key code not mapped properly");
+        fail_unless (rtm_error_from_service_code (101) == RTM_ERROR_INVALID_FROB,
+                     "Invalid frob code not mapped properly");
+        fail_unless (rtm_error_from_service_code (105) == RTM_ERROR_SERVICE_UNAVAILABLE,
+                     "Service unavailable code not mapped properly");
+        fail_unless (rtm_error_from_service_code (340) == RTM_ERROR_RESPONSE_FAIL,
+                     "Other codes not mapped to response fail");
+}
+END_TEST
+
+START_TEST (test_transient)
+{
+        GError *error;
+
+        error = g_error_new (RTM_ERROR_DOMAIN, RTM_ERROR_NETWORK, "network");
+        fail_unless (rtm_error_is_transient (error),
+                     "Network error not transient");
+        g_error_free (error);
+
+        error = g_error_new (RTM_ERROR_DOMAIN, RTM_ERROR_SERVICE_UNAVAILABLE,
+                             "105: Service currently unavailable");
+        fail_unless (rtm_error_is_transient (error),
+                     "Service unavailable error not transient");
+        g_error_free (error);
+
+        error = g_error_new (RTM_ERROR_DOMAIN, RTM_ERROR_LOGIN_FAILED,
+                             "98: Login failed / Invalid auth token");
+        fail_if (rtm_error_is_transient (error),
+                 "Login failed error transient");
+        g_error_free (error);
+
+        error = g_error_new (G_IO_ERROR, G_IO_ERROR_CANCELLED, "cancelled");
+        fail_if (rtm_error_is_transient (error),
+                 "Error of other domain transient");
+        g_error_free (error);
+
+        fail_if (rtm_error_is_transient (NULL), "No error transient");
+}
+END_TEST
+
+Suite *
+check_rtm_error_suite (void)
+{
+        Suite * suite = suite_create ("RtmError");
+
+        TCase * tcase_service_code = tcase_create ("Service code");
+        tcase_add_test (tcase_service_code, test_service_code);
+        suite_add_tcase (suite, tcase_service_code);
+
+        TCase * tcase_transient = tcase_create ("Transient");
+        tcase_add_test (tcase_transient, test_transient);
+        suite_add_tcase (suite, tcase_transient);
+
+        return suite;
+}
+
+int
+main ()
+{
+        int number_failed;
+
+        SRunner *sr = srunner_create (NULL);
+
+        srunner_add_suite (sr, (Suite *) check_rtm_error_suite ());
+
+        srunner_run_all (sr, CK_VERBOSE);
+        number_failed = srunner_ntests_failed (sr);
+        srunner_free (sr);
+        return (number_failed == 0) ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -0,0 +1,1545 @@
+/*
+ * check-rtm-glib.c: Test RtmGlib class
+ *
+ * Copyright (C) 2009 Manuel Rego Casasnovas <mrego@igalia.com>
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301 USA
+ */
+
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <check.h>
+#include <rtm-glib/rtm-glib.h>
+#include <rtm-glib/rtm-coalescer.h>
+#include <rtm-glib/rtm-error.h>
+#include <rtm-glib/rtm-journal.h>
+#include <rtm-glib/rtm-loopback-transport.h>
+#include <rtm-glib/rtm-request-queue.h>
+#include <rtm-glib/rtm-rest-transport.h>
+
+#define API_KEY "api_key"
+#define SHARED_SECRET "shared_secret"
+#define AUTH_TOKEN "auth_token"
+
+RtmGlib *rtm;
+RtmLoopbackTransport *transport;
+
+void
+setup (void)
+{
+        g_type_init();
+
+        rtm = rtm_glib_new (API_KEY, SHARED_SECRET);
+        rtm_glib_set_rate_limit (rtm, 0, 1);
+
+        /* Authenticate first, most methods need an auth token */
+        transport = rtm_loopback_transport_new ();
+        rtm_glib_set_transport (rtm, RTM_TRANSPORT (transport));
+        rtm_loopback_transport_add_response (
+                transport, "rtm.auth.checkToken",
+                "<?xml version=\"1.0\" encoding=\"UTF-8\"?>"
+                "<rsp stat=\"ok\"><auth><token>" AUTH_TOKEN "</token>"
+                "<perms>delete</perms>"
+                "<user id=\"1\" username=\"bob\" fullname=\"Bob T. Monkey\"/>"
+                "</auth></rsp>");
+        rtm_glib_auth_check_token (rtm, AUTH_TOKEN, NULL);
+        g_object_unref (transport);
+
+        transport = rtm_loopback_transport_new ();
+        rtm_glib_set_transport (rtm, RTM_TRANSPORT (transport));
+}
+
+void
+teardown (void)
+{
+        g_object_unref (rtm);
+        g_object_unref (transport);
+}
+
+START_TEST (test_test_echo)
+{
+        GError *error = NULL;
+
+        rtm_loopback_transport_add_response (
+                transport, "rtm.test.echo",
+                "<?xml version=\"1.0\" encoding=\"UTF-8\"?>"
+                "<rsp stat=\"ok\"><api_key>" API_KEY "</api_key>"
+                "<method>rtm.test.echo</method></rsp>");
+
+        fail_unless (rtm_glib_test_echo (rtm, &error),
+                     "Echo response not valid");
+        fail_unless (error == NULL, "Echo call failed");
+        fail_unless (rtm_loopback_transport_get_n_requests (transport) == 1,
+                     "Echo call not sent through the transport");
+}
+END_TEST
+
+START_TEST (test_prewarm)
+{
+        rtm_loopback_transport_add_response (
+                transport, "rtm.test.echo",
+                "<?xml version=\"1.0\" encoding=\"UTF-8\"?>"
+                "<rsp stat=\"ok\"><api_key>" API_KEY "</api_key>"
+                "<method>rtm.test.echo</method></rsp>");
+
+        rtm_glib_prewarm (rtm, 0);
+
+        while (rtm_loopback_transport_get_n_requests (transport) == 0) {
+                g_main_context_iteration (NULL, TRUE);
+        }
+}
+END_TEST
+
+START_TEST (test_login_url)
+{
+        gchar *url, *md5, *api_sig;
+
+        url = rtm_glib_auth_get_login_url (rtm, "frob", "delete");
+        md5 = g_compute_checksum_for_string (
+                G_CHECKSUM_MD5,
+                SHARED_SECRET "api_key" API_KEY "frob" "frob" "perms" "delete",
+                -1);
+        api_sig = g_strconcat ("&api_sig=", md5, NULL);
+
+        fail_unless (g_str_has_suffix (url, api_sig),
+                     "Login URL not signed properly");
+
+        g_free (api_sig);
+        g_free (md5);
+        g_free (url);
+}
+END_TEST
+
+START_TEST (test_response_fail)
+{
+        gchar *username;
+        GError *error = NULL;
+
+        rtm_loopback_transport_add_response (
+                transport, "rtm.test.login",
+                "<?xml version=\"1.0\" encoding=\"UTF-8\"?>"
+                "<rsp stat=\"fail\">"
+                "<err code=\"98\" msg=\"Login failed / Invalid auth token\"/>"
+                "</rsp>");
+
+        username = rtm_glib_test_login (rtm, "auth_token", &error);
+        fail_unless (username == NULL, "Failed login returned a username");
+        fail_unless (g_error_matches (error, RTM_ERROR_DOMAIN,
+                                      RTM_ERROR_LOGIN_FAILED),
+                     "Failed login not reported properly");
+        g_error_free (error);
+}
+END_TEST
+
+START_TEST (test_method_not_found)
+{
+        GList *lists;
+        GError *error = NULL;
+
+        lists = rtm_glib_lists_get_list (rtm, &error);
+        fail_unless (lists == NULL, "Unknown method returned data");
+        fail_unless (g_error_matches (error, RTM_ERROR_DOMAIN,
+                                      RTM_ERROR_RESPONSE_FAIL),
+                     "Unknown method not reported properly");
+        g_error_free (error);
+}
+END_TEST
+
+START_TEST (test_timeout)
+{
+        fail_unless (rtm_glib_get_timeout (rtm) == 30,
+                     "Default timeout not set properly");
+
+        rtm_glib_set_timeout (rtm, 5);
+        fail_unless (rtm_glib_get_timeout (rtm) == 5,
+                     "Timeout not set properly");
+}
+END_TEST
+
+START_TEST (test_timeout_stall)
+{
+        GList *lists;
+        gint64 start;
+        GError *error = NULL;
+
+        rtm_loopback_transport_add_response (
+                transport, "rtm.lists.getList",
+                "<?xml version=\"1.0\" encoding=\"UTF-8\"?>"
+                "<rsp stat=\"ok\"><lists/></rsp>");
+        rtm_loopback_transport_set_latency (transport, 10000);
+        rtm_glib_set_timeout (rtm, 1);
+        rtm_glib_set_retry_policy (rtm, 0, 0, 0);
+
+        start = g_get_monotonic_time ();
+        lists = rtm_glib_lists_get_list (rtm, &error);
+
+        fail_unless (lists == NULL, "Stalled call returned data");
+        fail_unless (g_error_matches (error, RTM_ERROR_DOMAIN,
+                                      RTM_ERROR_TIMED_OUT),
+                     "Stalled call not reported as timed out");
+        fail_unless (g_get_monotonic_time () - start < 5 * G_USEC_PER_SEC,
+                     "Stalled call not interrupted by the timeout");
+
+        g_error_free (error);
+}
+END_TEST
+
+START_TEST (test_cancelled)
+{
+        GCancellable *cancellable;
+        GError *error = NULL;
+
+        cancellable = g_cancellable_new ();
+        g_cancellable_cancel (cancellable);
+
+        g_cancellable_push_current (cancellable);
+        fail_unless (!rtm_glib_test_echo (rtm, &error),
+                     "Cancelled call succeeded");
+        g_cancellable_pop_current (cancellable);
+
+        fail_unless (g_error_matches (error, G_IO_ERROR,
+                                      G_IO_ERROR_CANCELLED),
+                     "Cancelled call not reported properly");
+        fail_unless (rtm_loopback_transport_get_n_requests (transport) == 0,
+                     "Cancelled call sent");
+
+        g_error_free (error);
+        g_object_unref (cancellable);
+}
+END_TEST
+
+#define ECHO_RESPONSE "<?xml version=\"1.0\" encoding=\"UTF-8\"?>" \
+        "<rsp stat=\"ok\"><api_key>" API_KEY "</api_key>" \
+        "<method>rtm.test.echo</method></rsp>"
+
+START_TEST (test_rate_limit)
+{
+        RtmGlib *other;
+        gdouble rate;
+        gint64 start;
+        guint i;
+
+        rtm_loopback_transport_add_response (transport, "rtm.test.echo",
+                                             ECHO_RESPONSE);
+        rtm_glib_set_rate_limit (rtm, 10, 1);
+
+        /* The bucket belongs to the API key, not to the object */
+        other = rtm_glib_new (API_KEY, SHARED_SECRET);
+        rtm_glib_set_transport (other, RTM_TRANSPORT (transport));
+        rtm_glib_get_rate_limit (other, &rate, NULL);
+        fail_unless (rate == 10, "Rate limit not shared by the API key");
+
+        start = g_get_monotonic_time ();
+        for (i = 0; i < 4; i++) {
+                fail_unless (rtm_glib_test_echo (i % 2 ? other : rtm, NULL),
+                             "Rate limited call failed");
+        }
+
+        /* The first call goes at once, the others 100 ms apart */
+        fail_unless (g_get_monotonic_time () - start >=
+                     250 * G_TIME_SPAN_MILLISECOND,
+                     "Calls not spaced by the shared rate limit");
+        fail_unless (rtm_loopback_transport_get_n_requests (transport) == 4,
+                     "Rate limited calls not sent");
+
+        g_object_unref (other);
+}
+END_TEST
+
+START_TEST (test_rate_limit_refund)
+{
+        GCancellable *cancellable;
+        gint64 start;
+        GError *error = NULL;
+
+        rtm_loopback_transport_add_response (transport, "rtm.test.echo",
+                                             ECHO_RESPONSE);
+        rtm_glib_set_rate_limit (rtm, 2, 1);
+
+        start = g_get_monotonic_time ();
+        fail_unless (rtm_glib_test_echo (rtm, NULL), "First call failed");
+
+        /* Cancelled while waiting for its turn */
+        cancellable = g_cancellable_new ();
+        g_cancellable_cancel (cancellable);
+        g_cancellable_push_current (cancellable);
+        fail_unless (!rtm_glib_test_echo (rtm, &error),
+                     "Cancelled call succeeded");
+        g_cancellable_pop_current (cancellable);
+        fail_unless (g_error_matches (error, G_IO_ERROR,
+                                      G_IO_ERROR_CANCELLED),
+                     "Cancelled call not reported properly");
+        g_clear_error (&error);
+        g_object_unref (cancellable);
+
+        /* The next call takes the turn given back, 500 ms after the first
+         * instead of 1 s */
+        fail_unless (rtm_glib_test_echo (rtm, NULL), "Last call failed");
+        fail_unless (g_get_monotonic_time () - start <
+                     800 * G_TIME_SPAN_MILLISECOND,
+                     "Turn of the cancelled call not given back");
+        fail_unless (rtm_loopback_transport_get_n_requests (transport) == 2,
+                     "Cancelled call sent");
+}
+END_TEST
+
+#define LISTS_RESPONSE "<?xml version=\"1.0\" encoding=\"UTF-8\"?>" \
+        "<rsp stat=\"ok\"><lists>" \
+        "<list id=\"100653\" name=\"Inbox\" deleted=\"0\" " \
+        "locked=\"1\" archived=\"0\" position=\"-1\" smart=\"0\"/>" \
+        "</lists></rsp>"
+
+START_TEST (test_retry_read)
+{
+        GList *lists;
+        GError *error = NULL;
+
+        rtm_loopback_transport_add_response (transport, "rtm.lists.getList",
+                                             LISTS_RESPONSE);
+        rtm_glib_set_retry_policy (rtm, 3, 1, 1);
+        rtm_loopback_transport_fail_next (transport, 2);
+
+        lists = rtm_glib_lists_get_list (rtm, &error);
+        fail_unless (lists != NULL && error == NULL,
+                     "Read call not retried after transient errors");
+        fail_unless (rtm_loopback_transport_get_n_requests (transport) == 3,
+                     "Read call not sent once per attempt");
+
+        g_list_free_full (lists, g_object_unref);
+}
+END_TEST
+
+START_TEST (test_retry_write)
+{
+        gchar *timeline;
+        GError *error = NULL;
+
+        rtm_loopback_transport_add_response (
+                transport, "rtm.timelines.create",
+                "<?xml version=\"1.0\" encoding=\"UTF-8\"?>"
+                "<rsp stat=\"ok\"><timeline>12741021</timeline></rsp>");
+        rtm_glib_set_retry_policy (rtm, 3, 1, 1);
+        rtm_loopback_transport_fail_next (transport, 1);
+
+        timeline = rtm_glib_timelines_create (rtm, &error);
+        fail_unless (timeline == NULL, "Write call retried");
+        fail_unless (g_error_matches (error, RTM_ERROR_DOMAIN,
+                                      RTM_ERROR_NETWORK),
+                     "Transient error of a write call not reported");
+        fail_unless (rtm_loopback_transport_get_n_requests (transport) == 1,
+                     "Write call sent again");
+
+        g_error_free (error);
+}
+END_TEST
+
+START_TEST (test_retry_max_retries)
+{
+        GList *lists;
+        GError *error = NULL;
+
+        rtm_loopback_transport_add_response (transport, "rtm.lists.getList",
+                                             LISTS_RESPONSE);
+        rtm_glib_set_retry_policy (rtm, 2, 1, 1);
+        rtm_loopback_transport_fail_next (transport, 5);
+
+        lists = rtm_glib_lists_get_list (rtm, &error);
+        fail_unless (lists == NULL, "Call succeeded past the failures");
+        fail_unless (g_error_matches (error, RTM_ERROR_DOMAIN,
+                                      RTM_ERROR_NETWORK),
+                     "Last transient error not reported");
+        fail_unless (rtm_loopback_transport_get_n_requests (transport) == 3,
+                     "Call not given up after the maximum retries");
+
+        g_error_free (error);
+}
+END_TEST
+
+static void
+lists_get_list_cb (GObject *source_object, GAsyncResult *result,
+                   gpointer user_data)
+{
+        GList **lists = user_data;
+        GError *error = NULL;
+
+        *lists = rtm_glib_lists_get_list_finish (RTM_GLIB (source_object),
+                                                 result, &error);
+        fail_unless (error == NULL, "Lists call failed");
+}
+
+START_TEST (test_single_flight)
+{
+        GList *lists1 = NULL, *lists2 = NULL;
+
+        rtm_loopback_transport_add_response (
+                transport, "rtm.lists.getList",
+                "<?xml version=\"1.0\" encoding=\"UTF-8\"?>"
+                "<rsp stat=\"ok\"><lists>"
+                "<list id=\"100653\" name=\"Inbox\" deleted=\"0\" "
+                "locked=\"1\" archived=\"0\" position=\"-1\" smart=\"0\"/>"
+                "<list id=\"387549\" name=\"High Priority\" deleted=\"0\" "
+                "locked=\"0\" archived=\"0\" position=\"0\" smart=\"1\">"
+                "<filter>(priority:1)</filter></list>"
+                "</lists></rsp>");
+
+        rtm_glib_lists_get_list_async (rtm, NULL, lists_get_list_cb, &lists1);
+        rtm_glib_lists_get_list_async (rtm, NULL, lists_get_list_cb, &lists2);
+
+        while (lists1 == NULL || lists2 == NULL) {
+                g_main_context_iteration (NULL, TRUE);
+        }
+
+        fail_unless (rtm_loopback_transport_get_n_requests (transport) == 1,
+                     "Concurrent calls not shared");
+        fail_unless (g_list_length (lists1) == 2 &&
+                     g_list_length (lists2) == 2,
+                     "Lists not parsed properly");
+        fail_unless (g_strcmp0 (rtm_list_get_name (lists2->next->data),
+                                "High Priority") == 0,
+                     "List name not parsed properly");
+
+        g_list_free_full (lists1, g_object_unref);
+        g_list_free_full (lists2, g_object_unref);
+}
+END_TEST
+
+START_TEST (test_json_lists)
+{
+        GList *lists;
+        GError *error = NULL;
+
+        rtm_glib_set_use_json (rtm, TRUE);
+        rtm_loopback_transport_add_response (
+                transport, "rtm.lists.getList",
+                "{\"rsp\":{\"stat\":\"ok\",\"lists\":{\"list\":["
+                "{\"id\":\"100653\",\"name\":\"Inbox\","
+                "\"deleted\":\"0\",\"locked\":\"1\",\"archived\":\"0\","
+                "\"position\":\"-1\",\"smart\":\"0\"},"
+                "{\"id\":\"387549\",\"name\":\"High Priority\","
+                "\"deleted\":\"0\",\"locked\":\"0\",\"archived\":\"0\","
+                "\"position\":\"0\",\"smart\":\"1\","
+                "\"filter\":\"(priority:1)\"}]}}}");
+
+        lists = rtm_glib_lists_get_list (rtm, &error);
+        fail_unless (error == NULL, "JSON lists call failed");
+        fail_unless (g_list_length (lists) == 2,
+                     "JSON lists not decoded properly");
+        fail_unless (g_strcmp0 (rtm_list_get_name (lists->next->data),
+                                "High Priority") == 0,
+                     "JSON list name not decoded properly");
+        fail_unless (g_strcmp0 (rtm_list_get_filter (lists->next->data),
+                                "(priority:1)") == 0,
+                     "JSON list filter not decoded properly");
+
+        g_list_free_full (lists, g_object_unref);
+}
+END_TEST
+
+START_TEST (test_json_tasks)
+{
+        GList *tasks;
+        RtmTask *task;
+        GError *error = NULL;
+
+        rtm_glib_set_use_json (rtm, TRUE);
+        rtm_loopback_transport_add_response (
+                transport, "rtm.tasks.getList",
+                "{\"rsp\":{\"stat\":\"ok\",\"tasks\":{\"list\":"
+                "{\"id\":\"100653\",\"taskseries\":"
+                "{\"id\":\"650390\",\"name\":\"Get Bananas\","
+                "\"tags\":{\"tag\":[\"fruit\",\"shopping\"]},"
+                "\"participants\":[],\"notes\":[],"
+                "\"task\":{\"id\":\"815784\",\"due\":\"\","
+                "\"priority\":\"N\"}}}}}}");
+
+        tasks = rtm_glib_tasks_get_list (rtm, NULL, NULL, NULL, &error);
+        fail_unless (error == NULL, "JSON tasks call failed");
+        fail_unless (g_list_length (tasks) == 1,
+                     "JSON tasks not decoded properly");
+
+        task = tasks->data;
+        fail_unless (g_strcmp0 (rtm_task_get_name (task),
+                                "Get Bananas") == 0,
+                     "JSON task name not decoded properly");
+        fail_unless (g_strcmp0 (rtm_task_get_list_id (task), "100653") == 0,
+                     "JSON task list not decoded properly");
+        fail_unless (g_list_length (rtm_task_get_tags (task)) == 2,
+                     "JSON task tags not decoded properly");
+
+        g_list_free_full (tasks, g_object_unref);
+}
+END_TEST
+
+START_TEST (test_json_response_fail)
+{
+        GList *lists;
+        GError *error = NULL;
+
+        rtm_glib_set_use_json (rtm, TRUE);
+        rtm_loopback_transport_add_response (
+                transport, "rtm.lists.getList",
+                "{\"rsp\":{\"stat\":\"fail\",\"err\":{\"code\":\"98\","
+                "\"msg\":\"Login failed / Invalid auth token\"}}}");
+
+        lists = rtm_glib_lists_get_list (rtm, &error);
+        fail_unless (lists == NULL, "Failed JSON call returned data");
+        fail_unless (g_error_matches (error, RTM_ERROR_DOMAIN,
+                                      RTM_ERROR_LOGIN_FAILED),
+                     "Failed JSON call not reported properly");
+        g_error_free (error);
+}
+END_TEST
+
+START_TEST (test_streamed_tasks)
+{
+        GList *tasks;
+        RtmTask *task;
+        GError *error = NULL;
+
+        rtm_loopback_transport_add_response (
+                transport, "rtm.tasks.getList",
+                "<?xml version=\"1.0\" encoding=\"UTF-8\"?>"
+                "<rsp stat=\"ok\"><tasks><list id=\"100653\">"
+                "<taskseries id=\"650390\" name=\"Bananas &amp; milk\">"
+                "<rrule every=\"1\">FREQ=WEEKLY;INTERVAL=1</rrule>"
+                "<tags><tag>fruit</tag><tag>shopping</tag></tags>"
+                "<participants/><notes/>"
+                "<task id=\"815784\" due=\"\" priority=\"1\"/>"
+                "<task id=\"815785\" due=\"\" priority=\"2\"/>"
+                "</taskseries></list><list id=\"100654\">"
+                "<taskseries id=\"650391\" name=\"Call Bob\">"
+                "<tags/><task id=\"815786\" priority=\"N\"/>"
+                "</taskseries></list></tasks></rsp>");
+
+        tasks = rtm_glib_tasks_get_list (rtm, NULL, NULL, NULL, &error);
+        fail_unless (error == NULL, "Streamed tasks call failed");
+        fail_unless (g_list_length (tasks) == 3,
+                     "Streamed tasks not parsed properly");
+
+        task = tasks->data;
+        fail_unless (g_strcmp0 (rtm_task_get_name (task),
+                                "Bananas & milk") == 0,
+                     "Streamed task name not parsed properly");
+        fail_unless (g_strcmp0 (rtm_task_get_id (task), "815784") == 0 &&
+                     g_strcmp0 (rtm_task_get_priority (task), "1") == 0,
+                     "Streamed task not taken from the first task");
+        fail_unless (g_strcmp0 (rtm_task_get_recurrence (task),
+                                "FREQ=WEEKLY;INTERVAL=1") == 0,
+                     "Streamed task recurrence not parsed properly");
+        fail_unless (g_list_length (rtm_task_get_tags (task)) == 2,
+                     "Streamed task tags not parsed properly");
+
+        task = tasks->next->data;
+        fail_unless (g_strcmp0 (rtm_task_get_id (task), "815785") == 0 &&
+                     g_strcmp0 (rtm_task_get_priority (task), "2") == 0,
+                     "Streamed task instance not parsed properly");
+        fail_unless (g_strcmp0 (rtm_task_get_name (task),
+                                "Bananas & milk") == 0 &&
+                     g_strcmp0 (rtm_task_get_list_id (task), "100653") == 0 &&
+                     g_strcmp0 (rtm_task_get_recurrence (task),
+                                "FREQ=WEEKLY;INTERVAL=1") == 0 &&
+                     g_list_length (rtm_task_get_tags (task)) == 2,
+                     "Streamed task instance without its taskseries");
+
+        task = tasks->next->next->data;
+        fail_unless (g_strcmp0 (rtm_task_get_list_id (task), "100654") == 0,
+                     "Streamed task list not parsed properly");
+
+        g_list_free_full (tasks, g_object_unref);
+
+        rtm_loopback_transport_add_response (
+                transport, "rtm.tasks.getList",
+                "<?xml version=\"1.0\" encoding=\"UTF-8\"?>"
+                "<rsp stat=\"fail\"><err code=\"98\" "
+                "msg=\"Login failed / Invalid auth token\"/></rsp>");
+
+        tasks = rtm_glib_tasks_get_list (rtm, NULL, NULL, NULL, &error);
+        fail_unless (tasks == NULL, "Failed streamed call returned data");
+        fail_unless (g_error_matches (error, RTM_ERROR_DOMAIN,
+                                      RTM_ERROR_LOGIN_FAILED),
+                     "Failed streamed call not reported properly");
+        g_error_free (error);
+}
+END_TEST
+
+START_TEST (test_lazy_tasks)
+{
+        GList *tasks;
+        RtmTask *task;
+        GError *error = NULL;
+
+        rtm_glib_set_lazy_tasks (rtm, TRUE);
+        rtm_loopback_transport_add_response (
+                transport, "rtm.tasks.getList",
+                "<?xml version=\"1.0\" encoding=\"UTF-8\"?>"
+                "<rsp stat=\"ok\"><tasks><list id=\"100653\">"
+                "<taskseries id=\"650390\" name=\"Get Bananas\" "
+                "url=\"http://www.example.com\" source=\"api\" "
+                "created=\"2009-05-07T10:19:54Z\">"
+                "<rrule every=\"0\">FREQ=DAILY;INTERVAL=1</rrule>"
+                "<tags><tag>fruit</tag><tag>shopping</tag></tags>"
+                "<task id=\"815784\" priority=\"1\" estimate=\"1 hour\" "
+                "added=\"2009-05-07T10:19:54Z\" completed=\"\"/>"
+                "<task id=\"815785\" priority=\"2\" estimate=\"\" "
+                "added=\"2009-05-08T10:19:54Z\" completed=\"\"/>"
+                "</taskseries></list></tasks></rsp>");
+
+        tasks = rtm_glib_tasks_get_list (rtm, NULL, NULL, NULL, &error);
+        fail_unless (error == NULL, "Lazy tasks call failed");
+        fail_unless (g_list_length (tasks) == 2,
+                     "Lazy tasks not parsed properly");
+
+        /* The fields of the taskseries are copied before being decoded */
+        task = tasks->next->data;
+        fail_unless (g_strcmp0 (rtm_task_get_id (task), "815785") == 0 &&
+                     g_strcmp0 (rtm_task_get_url (task),
+                                "http://www.example.com") == 0 &&
+                     g_strcmp0 (rtm_task_get_recurrence (task),
+                                "FREQ=DAILY;INTERVAL=1") == 0 &&
+                     rtm_task_get_created_date (task) != NULL &&
+                     rtm_task_get_created_date (task)->tv_sec ==
+                     1241691594 &&
+                     rtm_task_get_added_date (task)->tv_sec == 1241777994 &&
+                     g_list_length (rtm_task_get_tags (task)) == 2,
+                     "Lazy taskseries fields not copied to its tasks");
+
+        task = tasks->data;
+        fail_unless (g_strcmp0 (rtm_task_get_name (task),
+                                "Get Bananas") == 0 &&
+                     g_strcmp0 (rtm_task_get_priority (task), "1") == 0,
+                     "Lazy task eager fields not parsed properly");
+        fail_unless (g_strcmp0 (rtm_task_get_source (task), "api") == 0 &&
+                     g_strcmp0 (rtm_task_get_estimate (task),
+                                "1 hour") == 0 &&
+                     g_strcmp0 (rtm_task_get_recurrence (task),
+                                "FREQ=DAILY;INTERVAL=1") == 0,
+                     "Lazy task fields not decoded on access");
+        fail_unless (rtm_task_get_added_date (task) != NULL &&
+                     rtm_task_get_added_date (task)->tv_sec == 1241691594 &&
+                     rtm_task_get_completed_date (task) == NULL,
+                     "Lazy task dates not decoded on access");
+        fail_unless (g_list_length (rtm_task_get_tags (task)) == 2,
+                     "Lazy task tags not decoded on access");
+
+        rtm_task_set_url (task, "http://www.example.org");
+        fail_unless (g_strcmp0 (rtm_task_get_url (task),
+                                "http://www.example.org") == 0,
+                     "Lazy task field set before access overwritten");
+
+        g_list_free_full (tasks, g_object_unref);
+}
+END_TEST
+
+START_TEST (test_task_batch)
+{
+        RtmTaskBatch *batch;
+        RtmTask *task;
+        const gchar * const *tags;
+        GError *error = NULL;
+
+        rtm_loopback_transport_add_response (
+                transport, "rtm.tasks.getList",
+                "<?xml version=\"1.0\" encoding=\"UTF-8\"?>"
+                "<rsp stat=\"ok\"><tasks><list id=\"100653\">"
+                "<taskseries id=\"650390\" name=\"Bananas &amp; milk\" "
+                "created=\"2009-05-07T10:19:54Z\">"
+                "<rrule every=\"1\">FREQ=WEEKLY;INTERVAL=1</rrule>"
+                "<tags><tag>fruit</tag><tag>shopping</tag></tags>"
+                "<task id=\"815784\" due=\"\" priority=\"1\"/>"
+                "<task id=\"815785\" due=\"2009-05-08T10:19:54Z\" "
+                "priority=\"2\"/>"
+                "</taskseries></list><list id=\"100654\">"
+                "<taskseries id=\"650391\" name=\"Call Bob\">"
+                "<tags/><task id=\"815786\" priority=\"N\"/>"
+                "</taskseries></list></tasks></rsp>");
+
+        batch = rtm_glib_tasks_get_batch (rtm, NULL, NULL, NULL, &error);
+        fail_unless (error == NULL, "Task batch call failed");
+        fail_unless (rtm_task_batch_get_length (batch) == 3,
+                     "Task batch not parsed properly");
+
+        fail_unless (g_strcmp0 (rtm_task_batch_get_name (batch, 0),
+                                "Bananas & milk") == 0 &&
+                     g_strcmp0 (rtm_task_batch_get_id (batch, 0),
+                                "815784") == 0 &&
+                     rtm_task_batch_get_due_date (batch, 0) == NULL,
+                     "Task batch first task not parsed properly");
+        fail_unless (g_strcmp0 (rtm_task_batch_get_id (batch, 1),
+                                "815785") == 0 &&
+                     g_strcmp0 (rtm_task_batch_get_priority (batch, 1),
+                                "2") == 0 &&
+                     rtm_task_batch_get_due_date (batch, 1)->tv_sec ==
+                     1241777994,
+                     "Task batch instance not parsed properly");
+        fail_unless (g_strcmp0 (rtm_task_batch_get_name (batch, 1),
+                                "Bananas & milk") == 0 &&
+                     g_strcmp0 (rtm_task_batch_get_list_id (batch, 1),
+                                "100653") == 0 &&
+                     rtm_task_batch_get_created_date (batch, 1)->tv_sec ==
+                     1241691594 &&
+                     rtm_task_batch_is_recurrence_every (batch, 1),
+                     "Task batch instance without its taskseries");
+
+        tags = rtm_task_batch_get_tags (batch, 1);
+        fail_unless (g_strv_length ((gchar **) tags) == 2 &&
+                     g_strcmp0 (tags[0], "fruit") == 0,
+                     "Task batch tags not parsed properly");
+        fail_unless (rtm_task_batch_get_tags (batch, 2)[0] == NULL &&
+                     g_strcmp0 (rtm_task_batch_get_list_id (batch, 2),
+                                "100654") == 0,
+                     "Task batch second list not parsed properly");
+
+        task = rtm_task_batch_get_task (batch, 1);
+        fail_unless (g_strcmp0 (rtm_task_get_id (task), "815785") == 0 &&
+                     g_strcmp0 (rtm_task_get_recurrence (task),
+                                "FREQ=WEEKLY;INTERVAL=1") == 0 &&
+                     g_list_length (rtm_task_get_tags (task)) == 2,
+                     "Task from a batch not created properly");
+        g_object_unref (task);
+
+        rtm_task_batch_unref (batch);
+
+        rtm_glib_set_use_json (rtm, TRUE);
+        rtm_loopback_transport_add_response (
+                transport, "rtm.tasks.getList",
+                "{\"rsp\":{\"stat\":\"ok\",\"tasks\":{\"list\":"
+                "{\"taskseries\":"
+                "{\"id\":\"650390\",\"name\":\"Get Bananas\","
+                "\"tags\":{\"tag\":\"fruit\"},"
+                "\"task\":[{\"id\":\"815784\"},{\"id\":\"815785\"}]},"
+                "\"id\":\"100653\"}}}}");
+
+        batch = rtm_glib_tasks_get_batch (rtm, NULL, NULL, NULL, &error);
+        fail_unless (error == NULL, "JSON task batch call failed");
+        fail_unless (rtm_task_batch_get_length (batch) == 2 &&
+                     g_strcmp0 (rtm_task_batch_get_id (batch, 1),
+                                "815785") == 0 &&
+                     g_strcmp0 (rtm_task_batch_get_list_id (batch, 1),
+                                "100653") == 0 &&
+                     g_strcmp0 (rtm_task_batch_get_tags (batch, 1)[0],
+                                "fruit") == 0,
+                     "JSON task batch not decoded properly");
+
+        rtm_task_batch_unref (batch);
+}
+END_TEST
+
+static void
+tasks_foreach_task (RtmGlib *rtm, RtmTask *task, gpointer user_data)
+{
+        GPtrArray *names = user_data;
+
+        g_ptr_array_add (names, g_strdup (rtm_task_get_name (task)));
+}
+
+static void
+tasks_foreach_cb (GObject *source_object, GAsyncResult *result,
+                  gpointer user_data)
+{
+        gboolean *done = user_data;
+
+        fail_unless (rtm_glib_tasks_foreach_finish (RTM_GLIB (source_object),
+                                                    result, NULL),
+                     "Streamed tasks call failed");
+        *done = TRUE;
+}
+
+START_TEST (test_tasks_foreach)
+{
+        GString *response;
+        GPtrArray *names;
+        gboolean done = FALSE;
+        gchar *name;
+        guint i;
+
+        response = g_string_new ("<?xml version=\"1.0\" encoding=\"UTF-8\"?>"
+                                 "<rsp stat=\"ok\"><tasks>"
+                                 "<list id=\"100653\">");
+        for (i = 0; i < 50; i++) {
+                g_string_append_printf (
+                        response,
+                        "<taskseries id=\"%u\" name=\"Task %u\">"
+                        "<tags><tag>tag</tag></tags>"
+                        "<task id=\"%u\" priority=\"N\"/></taskseries>",
+                        i, i, i);
+        }
+        g_string_append (response, "</list></tasks></rsp>");
+        rtm_loopback_transport_add_response (transport, "rtm.tasks.getList",
+                                             response->str);
+        g_string_free (response, TRUE);
+
+        names = g_ptr_array_new_with_free_func (g_free);
+        rtm_glib_tasks_foreach_async (rtm, NULL, NULL, NULL,
+                                      tasks_foreach_task, names, NULL,
+                                      tasks_foreach_cb, &done);
+
+        while (!done) {
+                g_main_context_iteration (NULL, TRUE);
+        }
+
+        fail_unless (names->len == 50, "Streamed tasks not handed out");
+        for (i = 0; i < names->len; i++) {
+                name = g_strdup_printf ("Task %u", i);
+                fail_unless (g_strcmp0 (g_ptr_array_index (names, i),
+                                        name) == 0,
+                             "Streamed tasks not handed out in order");
+                g_free (name);
+        }
+
+        g_ptr_array_free (names, TRUE);
+}
+END_TEST
+
+/* Answers every request of a kept alive connection with an echo response */
+static gboolean
+http_server_run_cb (GThreadedSocketService *service,
+                    GSocketConnection *connection, GObject *source_object,
+                    gpointer user_data)
+{
+        GDataInputStream *input;
+        GOutputStream *output;
+        gchar *response, *line;
+        gsize length;
+
+        input = g_data_input_stream_new (
+                g_io_stream_get_input_stream (G_IO_STREAM (connection)));
+        output = g_io_stream_get_output_stream (G_IO_STREAM (connection));
+        response = g_strdup_printf ("HTTP/1.1 200 OK\r\n"
+                                    "Content-Type: text/xml\r\n"
+                                    "Content-Length: %u\r\n"
+                                    "\r\n%s",
+                                    (guint) strlen (ECHO_RESPONSE),
+                                    ECHO_RESPONSE);
+
+        while (TRUE) {
+                /* The calls are GET requests, without a body */
+                do {
+                        line = g_data_input_stream_read_line (input, &length,
+                                                              NULL, NULL);
+                        g_free (line);
+                } while (line != NULL && length > 1);
+
+                if (line == NULL ||
+                    !g_output_stream_write_all (output, response,
+                                                strlen (response), NULL,
+                                                NULL, NULL)) {
+                        break;
+                }
+        }
+
+        g_free (response);
+        g_object_unref (input);
+
+        return TRUE;
+}
+
+START_TEST (test_connection_stats)
+{
+        GSocketService *service;
+        RtmRestTransport *rest_transport;
+        gchar *url;
+        guint16 port;
+        guint sessions, reused, i;
+
+        service = g_threaded_socket_service_new (4);
+        port = g_socket_listener_add_any_inet_port (
+                G_SOCKET_LISTENER (service), NULL, NULL);
+        fail_unless (port != 0, "HTTP server not started");
+        g_signal_connect (service, "run",
+                          G_CALLBACK (http_server_run_cb), NULL);
+        g_socket_service_start (service);
+
+        url = g_strdup_printf ("http://127.0.0.1:%u/", port);
+        rest_transport = rtm_rest_transport_new (url);
+        rtm_glib_set_transport (rtm, RTM_TRANSPORT (rest_transport));
+
+        /* Calls one after the other take the same session from the pool */
+        for (i = 0; i < 3; i++) {
+                fail_unless (rtm_glib_test_echo (rtm, NULL),
+                             "Echo call over HTTP failed");
+        }
+
+        rtm_glib_get_connection_stats (rtm, &sessions, &reused);
+        fail_unless (sessions == 1, "Session not kept in the pool");
+        fail_unless (reused == 2, "Session of the pool not reused");
+
+        g_socket_service_stop (service);
+        g_object_unref (rest_transport);
+        g_object_unref (service);
+        g_free (url);
+}
+END_TEST
+
+START_TEST (test_method_stats)
+{
+        const gchar *response =
+                "<?xml version=\"1.0\" encoding=\"UTF-8\"?>"
+                "<rsp stat=\"ok\"><lists/></rsp>";
+        GList *stats, *lists;
+        RtmMethodStats *lists_stats;
+        const guint64 *histogram;
+        guint64 count = 0;
+        guint bucket;
+        GError *error = NULL;
+
+        rtm_glib_reset_method_stats (rtm);
+        rtm_loopback_transport_add_response (transport, "rtm.lists.getList",
+                                             response);
+
+        lists = rtm_glib_lists_get_list (rtm, &error);
+        fail_unless (error == NULL, "Lists call failed");
+        g_list_free_full (lists, g_object_unref);
+
+        lists = rtm_glib_locations_get_list (rtm, &error);
+        fail_unless (lists == NULL && error != NULL,
+                     "Unknown method returned data");
+        g_clear_error (&error);
+
+        stats = rtm_glib_get_method_stats (rtm);
+        fail_unless (g_list_length (stats) == 2,
+                     "Method stats not recorded per method");
+
+        lists_stats = stats->data;
+        fail_unless (g_strcmp0 (rtm_method_stats_get_method (lists_stats),
+                                "rtm.lists.getList") == 0,
+                     "Method stats not sorted by method");
+        fail_unless (rtm_method_stats_get_n_calls (lists_stats) == 1 &&
+                     rtm_method_stats_get_n_errors (lists_stats) == 0,
+                     "Calls not counted properly");
+        fail_unless (rtm_method_stats_get_payload_size_sum (lists_stats) ==
+                     strlen (response),
+                     "Payload size not recorded properly");
+
+        histogram = rtm_method_stats_get_latency_histogram (
+                lists_stats, RTM_METHOD_PHASE_LOAD);
+        for (bucket = 0; bucket < RTM_METHOD_STATS_N_BUCKETS; bucket++) {
+                count += histogram[bucket];
+        }
+        fail_unless (count == 1, "Load latency not recorded");
+
+        fail_unless (rtm_method_stats_get_n_errors (stats->next->data) == 1,
+                     "Failed call not counted");
+
+        g_list_free_full (stats, (GDestroyNotify) rtm_method_stats_free);
+}
+END_TEST
+
+static void
+coalescer_cb (RtmCoalescer *coalescer, const gchar *method, RestXmlNode *root,
+              const GError *error, gpointer user_data)
+{
+        guint *n_callbacks = user_data;
+
+        fail_unless (root != NULL && error == NULL,
+                     "Coalesced modification failed");
+        (*n_callbacks)++;
+}
+
+START_TEST (test_coalescer)
+{
+        RtmCoalescer *coalescer;
+        RtmTask *task;
+        guint n_callbacks = 0;
+
+        rtm_loopback_transport_add_response (
+                transport, "rtm.tasks.setName",
+                "<?xml version=\"1.0\" encoding=\"UTF-8\"?>"
+                "<rsp stat=\"ok\"><transaction id=\"1\" undoable=\"0\"/>"
+                "</rsp>");
+        rtm_loopback_transport_add_response (
+                transport, "rtm.tasks.setPriority",
+                "<?xml version=\"1.0\" encoding=\"UTF-8\"?>"
+                "<rsp stat=\"ok\"><transaction id=\"2\" undoable=\"0\"/>"
+                "</rsp>");
+
+        task = rtm_task_new ();
+        rtm_task_set_list_id (task, "100653");
+        rtm_task_set_taskseries_id (task, "1");
+        rtm_task_set_id (task, "2");
+
+        coalescer = rtm_coalescer_new (rtm, 60000);
+
+        rtm_coalescer_set_name (coalescer, "timeline", task, "T",
+                                coalescer_cb, &n_callbacks);
+        rtm_coalescer_set_priority (coalescer, "timeline", task, "1",
+                                    coalescer_cb, &n_callbacks);
+        rtm_coalescer_set_name (coalescer, "timeline", task, "Ta",
+                                coalescer_cb, &n_callbacks);
+        rtm_coalescer_set_name (coalescer, "timeline", task, "Task",
+                                coalescer_cb, &n_callbacks);
+        rtm_coalescer_set_priority (coalescer, "timeline", task, "2",
+                                    coalescer_cb, &n_callbacks);
+
+        fail_unless (rtm_loopback_transport_get_n_requests (transport) == 0,
+                     "Modifications sent before the window is over");
+
+        rtm_coalescer_wait (coalescer);
+
+        fail_unless (n_callbacks == 5, "Callbacks not called for every "
+                     "modification");
+        fail_unless (rtm_loopback_transport_get_n_requests (transport) == 2,
+                     "Superseded modifications sent");
+        fail_unless (rtm_coalescer_get_n_sent (coalescer) == 2 &&
+                     rtm_coalescer_get_n_superseded (coalescer) == 3,
+                     "Coalescer statistics not counted properly");
+
+        g_object_unref (coalescer);
+        g_object_unref (task);
+}
+END_TEST
+
+static void
+journal_cb (RtmJournal *journal, const gchar *method, RestXmlNode *root,
+            const GError *error, gpointer user_data)
+{
+        guint *n_callbacks = user_data;
+
+        fail_unless (root != NULL && error == NULL,
+                     "Journal modification failed");
+        (*n_callbacks)++;
+}
+
+START_TEST (test_journal)
+{
+        RtmJournal *journal;
+        gchar *path;
+        guint n_callbacks = 0;
+        gint fd;
+        GError *error = NULL;
+
+        rtm_loopback_transport_add_response (
+                transport, "rtm.timelines.create",
+                "<?xml version=\"1.0\" encoding=\"UTF-8\"?>"
+                "<rsp stat=\"ok\"><timeline>12741021</timeline></rsp>");
+        rtm_loopback_transport_add_response (
+                transport, "rtm.tasks.setName",
+                "<?xml version=\"1.0\" encoding=\"UTF-8\"?>"
+                "<rsp stat=\"ok\"><transaction id=\"1\" undoable=\"0\"/>"
+                "</rsp>");
+
+        /* Left by a previous run, the last line was interrupted */
+        fd = g_file_open_tmp ("check-rtm-journal-XXXXXX", &path, NULL);
+        close (fd);
+        g_file_set_contents (
+                path,
+                "+ 1 rtm.tasks.setName timeline=1&list_id=1&taskseries_id=1"
+                "&task_id=1&name=First\n"
+                "+ 2 rtm.tasks.setName timeline=1&list_id=1&taskseries_id=1"
+                "&task_id=1&name=Second%20one\n"
+                "- 1\n"
+                "+ 3 rtm.tasks.setN",
+                -1, NULL);
+
+        journal = rtm_journal_new (rtm, path, &error);
+        fail_unless (journal != NULL && error == NULL,
+                     "Journal not opened");
+        fail_unless (rtm_journal_get_n_pending (journal) == 1,
+                     "Pending modifications not loaded");
+
+        rtm_journal_append (journal, "rtm.tasks.setName", journal_cb,
+                            &n_callbacks, "timeline", "1",
+                            "list_id", "1", "taskseries_id", "1",
+                            "task_id", "1", "name", "Third", NULL);
+        fail_unless (rtm_journal_sync (journal, &error),
+                     "Journal not synced");
+
+        while (rtm_journal_get_n_pending (journal) > 0 &&
+               !rtm_journal_is_offline (journal)) {
+                g_main_context_iteration (NULL, TRUE);
+        }
+
+        fail_unless (rtm_journal_get_n_pending (journal) == 0,
+                     "Journal not replayed");
+        fail_unless (n_callbacks == 1, "Journal callback not called");
+        fail_unless (rtm_loopback_transport_get_n_requests (transport) == 3,
+                     "Modifications not sent once each");
+
+        g_object_unref (journal);
+
+        journal = rtm_journal_new (rtm, path, &error);
+        fail_unless (rtm_journal_get_n_pending (journal) == 0,
+                     "Acknowledged modifications loaded again");
+        g_object_unref (journal);
+
+        unlink (path);
+        g_free (path);
+}
+END_TEST
+
+#define THREAD_POOL_CALLS 64
+
+static void
+thread_pool_parse (gpointer data, gpointer user_data)
+{
+        volatile gint *n_failed = user_data;
+        gchar *text, *time;
+
+        /* Each call parses its own text, so none of them is shared */
+        text = g_strdup_printf ("in %u days", GPOINTER_TO_UINT (data));
+        time = rtm_glib_time_parse (rtm, text, NULL, FALSE, NULL);
+        if (time == NULL) {
+                g_atomic_int_inc (n_failed);
+        }
+        g_free (time);
+        g_free (text);
+}
+
+START_TEST (test_thread_pool)
+{
+        GThreadPool *pool;
+        volatile gint n_failed = 0;
+        guint i;
+
+        rtm_loopback_transport_add_response (
+                transport, "rtm.time.parse",
+                "<?xml version=\"1.0\" encoding=\"UTF-8\"?>"
+                "<rsp stat=\"ok\"><time precision=\"date\">"
+                "2009-02-16T00:00:00Z</time></rsp>");
+
+        pool = g_thread_pool_new (thread_pool_parse, (gpointer) &n_failed,
+                                  4, FALSE, NULL);
+        for (i = 0; i < THREAD_POOL_CALLS; i++) {
+                g_thread_pool_push (pool, GUINT_TO_POINTER (i + 1), NULL);
+        }
+        g_thread_pool_free (pool, FALSE, TRUE);
+
+        fail_unless (n_failed == 0, "Calls from worker threads failed");
+        fail_unless (rtm_loopback_transport_get_n_requests (transport) ==
+                     THREAD_POOL_CALLS,
+                     "Calls from worker threads not sent");
+}
+END_TEST
+
+static void
+thread_pool_lists (gpointer data, gpointer user_data)
+{
+        volatile gint *n_failed = user_data;
+        GList *lists;
+
+        lists = rtm_glib_lists_get_list (rtm, NULL);
+        if (lists == NULL) {
+                g_atomic_int_inc (n_failed);
+        }
+        g_list_free_full (lists, g_object_unref);
+}
+
+START_TEST (test_thread_auth_token)
+{
+        GThreadPool *pool;
+        volatile gint n_failed = 0;
+        gchar *auth_token;
+        guint i;
+
+        rtm_loopback_transport_add_response (
+                transport, "rtm.lists.getList",
+                "<?xml version=\"1.0\" encoding=\"UTF-8\"?>"
+                "<rsp stat=\"ok\"><lists>"
+                "<list id=\"100653\" name=\"Inbox\" deleted=\"0\" "
+                "locked=\"1\" archived=\"0\" position=\"-1\" smart=\"0\"/>"
+                "</lists></rsp>");
+
+        /* Calls keep the token they took while it is replaced */
+        pool = g_thread_pool_new (thread_pool_lists, (gpointer) &n_failed,
+                                  4, FALSE, NULL);
+        for (i = 0; i < THREAD_POOL_CALLS; i++) {
+                g_thread_pool_push (pool, GUINT_TO_POINTER (i + 1), NULL);
+
+                auth_token = g_strdup_printf (AUTH_TOKEN "%u", i);
+                g_object_set (rtm, "auth_token", auth_token, NULL);
+                g_free (auth_token);
+        }
+        g_thread_pool_free (pool, FALSE, TRUE);
+
+        fail_unless (n_failed == 0, "Calls from worker threads failed");
+}
+END_TEST
+
+#define SINGLE_FLIGHT_THREADS 4
+
+START_TEST (test_thread_single_flight)
+{
+        GThreadPool *pool;
+        volatile gint n_failed = 0;
+        guint i;
+
+        rtm_loopback_transport_add_response (
+                transport, "rtm.lists.getList",
+                "<?xml version=\"1.0\" encoding=\"UTF-8\"?>"
+                "<rsp stat=\"ok\"><lists>"
+                "<list id=\"100653\" name=\"Inbox\" deleted=\"0\" "
+                "locked=\"1\" archived=\"0\" position=\"-1\" smart=\"0\"/>"
+                "</lists></rsp>");
+        rtm_loopback_transport_set_latency (transport, 500);
+
+        /* All the threads call while the first request is in flight */
+        pool = g_thread_pool_new (thread_pool_lists, (gpointer) &n_failed,
+                                  SINGLE_FLIGHT_THREADS, TRUE, NULL);
+        for (i = 0; i < SINGLE_FLIGHT_THREADS; i++) {
+                g_thread_pool_push (pool, GUINT_TO_POINTER (i + 1), NULL);
+        }
+        g_thread_pool_free (pool, FALSE, TRUE);
+
+        fail_unless (n_failed == 0, "Calls from worker threads failed");
+        fail_unless (rtm_loopback_transport_get_n_requests (transport) == 1,
+                     "Concurrent calls from threads not shared");
+}
+END_TEST
+
+#define PRESIGN_CALLS 500
+
+static void
+presign_cb (RtmRequestQueue *queue, const gchar *method, RestXmlNode *root,
+            const GError *error, gpointer user_data)
+{
+        guint *n_callbacks = user_data;
+
+        fail_unless (root != NULL && error == NULL,
+                     "Presigned call failed");
+        (*n_callbacks)++;
+}
+
+START_TEST (test_presign)
+{
+        RtmRequestQueue *queue;
+        gchar task_id[16];
+        guint n_callbacks = 0;
+        guint i;
+
+        rtm_loopback_transport_add_response (
+                transport, "rtm.tasks.setName",
+                "<?xml version=\"1.0\" encoding=\"UTF-8\"?>"
+                "<rsp stat=\"ok\"><transaction id=\"1\" undoable=\"0\"/>"
+                "</rsp>");
+
+        queue = rtm_request_queue_new (rtm, 1);
+        for (i = 0; i < PRESIGN_CALLS; i++) {
+                g_snprintf (task_id, sizeof (task_id), "%u", i);
+                rtm_request_queue_push (queue, "rtm.tasks.setName",
+                                        presign_cb, &n_callbacks,
+                                        "auth_token", AUTH_TOKEN,
+                                        "timeline", "1", "list_id", "1",
+                                        "taskseries_id", task_id,
+                                        "task_id", task_id,
+                                        "name", "Task", NULL);
+        }
+
+        rtm_request_queue_presign (queue);
+        rtm_request_queue_wait (queue);
+
+        fail_unless (n_callbacks == PRESIGN_CALLS,
+                     "Callbacks not called for every presigned call");
+        fail_unless (rtm_loopback_transport_get_n_requests (transport) ==
+                     PRESIGN_CALLS,
+                     "Presigned calls not sent");
+
+        g_object_unref (queue);
+}
+END_TEST
+
+static void
+queue_response_cb (RtmRequestQueue *queue, const gchar *method,
+                   RestXmlNode *root, const GError *error,
+                   gpointer user_data)
+{
+        RestXmlNode **response = user_data;
+
+        fail_unless (root != NULL && error == NULL, "Queued call failed");
+        fail_unless (g_strcmp0 (root->name, "rsp") == 0,
+                     "Queued call not parsed into a tree");
+        *response = rest_xml_node_ref (root);
+}
+
+START_TEST (test_queue_streamed_method)
+{
+        RtmRequestQueue *queue;
+        RestXmlNode *response = NULL;
+
+        rtm_loopback_transport_add_response (
+                transport, "rtm.tasks.getList",
+                "<?xml version=\"1.0\" encoding=\"UTF-8\"?>"
+                "<rsp stat=\"ok\"><tasks><list id=\"100653\">"
+                "<taskseries id=\"650390\" name=\"Get Bananas\">"
+                "<tags/><task id=\"815784\" priority=\"N\"/>"
+                "</taskseries></list></tasks></rsp>");
+
+        queue = rtm_request_queue_new (rtm, 1);
+        rtm_request_queue_push (queue, "rtm.tasks.getList",
+                                queue_response_cb, &response,
+                                "auth_token", AUTH_TOKEN, NULL);
+        rtm_request_queue_wait (queue);
+
+        fail_unless (response != NULL, "Queued call callback not called");
+        fail_unless (rest_xml_node_find (response, "taskseries") != NULL,
+                     "Queued tasks not parsed properly");
+
+        rest_xml_node_unref (response);
+        g_object_unref (queue);
+}
+END_TEST
+
+START_TEST (test_queue_json_format)
+{
+        RtmRequestQueue *queue;
+        RestXmlNode *response = NULL;
+
+        rtm_loopback_transport_add_response (
+                transport, "rtm.lists.getList",
+                "<?xml version=\"1.0\" encoding=\"UTF-8\"?>"
+                "<rsp stat=\"ok\"><lists>"
+                "<list id=\"100653\" name=\"Inbox\" deleted=\"0\" "
+                "locked=\"1\" archived=\"0\" position=\"-1\" smart=\"0\"/>"
+                "</lists></rsp>");
+
+        /* The callback gets a tree whatever the format asked */
+        queue = rtm_request_queue_new (rtm, 1);
+        rtm_request_queue_push (queue, "rtm.lists.getList",
+                                queue_response_cb, &response,
+                                "auth_token", AUTH_TOKEN,
+                                "format", "json", NULL);
+        rtm_request_queue_wait (queue);
+
+        fail_unless (response != NULL, "Queued call callback not called");
+        fail_unless (rest_xml_node_find (response, "list") != NULL,
+                     "Queued lists not parsed properly");
+
+        rest_xml_node_unref (response);
+        g_object_unref (queue);
+}
+END_TEST
+
+#define QUEUE_MAX_IN_FLIGHT 2
+#define QUEUE_CALLS 6
+
+static void
+queue_count_cb (RtmRequestQueue *queue, const gchar *method,
+                RestXmlNode *root, const GError *error, gpointer user_data)
+{
+        guint *n_callbacks = user_data;
+
+        fail_unless (root != NULL && error == NULL, "Queued call failed");
+        (*n_callbacks)++;
+}
+
+START_TEST (test_queue_max_in_flight)
+{
+        RtmRequestQueue *queue;
+        guint n_callbacks = 0;
+        gchar *text;
+        guint i;
+
+        rtm_loopback_transport_add_response (
+                transport, "rtm.time.parse",
+                "<?xml version=\"1.0\" encoding=\"UTF-8\"?>"
+                "<rsp stat=\"ok\"><time precision=\"date\">"
+                "2009-02-16T00:00:00Z</time></rsp>");
+        rtm_loopback_transport_set_latency (transport, 100);
+
+        /* Different texts, so the calls are not shared */
+        queue = rtm_request_queue_new (rtm, QUEUE_MAX_IN_FLIGHT);
+        for (i = 0; i < QUEUE_CALLS; i++) {
+                text = g_strdup_printf ("in %u days", i);
+                rtm_request_queue_push (queue, "rtm.time.parse",
+                                        queue_count_cb, &n_callbacks,
+                                        "text", text, NULL);
+                g_free (text);
+        }
+        rtm_request_queue_wait (queue);
+
+        fail_unless (n_callbacks == QUEUE_CALLS,
+                     "Queued call callbacks not called");
+        fail_unless (rtm_loopback_transport_get_n_requests (transport) ==
+                     QUEUE_CALLS,
+                     "Queued calls not sent");
+        fail_unless (rtm_loopback_transport_get_max_in_flight (transport) ==
+                     QUEUE_MAX_IN_FLIGHT,
+                     "Queued calls not kept within max_in_flight");
+
+        g_object_unref (queue);
+}
+END_TEST
+
+START_TEST (test_io_thread)
+{
+        RtmGlib *io_rtm;
+        RtmTransport *io_transport;
+        GMainContext *context = NULL;
+
+        io_rtm = rtm_glib_new (API_KEY, SHARED_SECRET);
+        rtm_glib_set_io_thread (io_rtm, TRUE);
+        fail_unless (rtm_glib_get_io_thread (io_rtm), "I/O thread not set");
+
+        io_transport = rtm_glib_get_transport (io_rtm);
+        fail_unless (RTM_IS_REST_TRANSPORT (io_transport),
+                     "Default transport not created");
+        g_object_get (io_transport, "context", &context, NULL);
+        fail_unless (context != NULL && context != g_main_context_default (),
+                     "Transport not running in the I/O thread");
+        g_main_context_unref (context);
+
+        rtm_glib_set_io_thread (io_rtm, FALSE);
+        fail_unless (!rtm_glib_get_io_thread (io_rtm),
+                     "I/O thread not stopped");
+
+        io_transport = rtm_glib_get_transport (io_rtm);
+        g_object_get (io_transport, "context", &context, NULL);
+        fail_unless (context == NULL,
+                     "Transport still running in the I/O thread");
+
+        g_object_unref (io_rtm);
+}
+END_TEST
+
+START_TEST (test_io_thread_toggle)
+{
+        GThreadPool *pool;
+        volatile gint n_failed = 0;
+        guint i;
+
+        rtm_loopback_transport_add_response (
+                transport, "rtm.time.parse",
+                "<?xml version=\"1.0\" encoding=\"UTF-8\"?>"
+                "<rsp stat=\"ok\"><time precision=\"date\">"
+                "2009-02-16T00:00:00Z</time></rsp>");
+
+        /* Calls go on while the I/O thread is started and stopped */
+        pool = g_thread_pool_new (thread_pool_parse, (gpointer) &n_failed,
+                                  4, FALSE, NULL);
+        for (i = 0; i < THREAD_POOL_CALLS; i++) {
+                g_thread_pool_push (pool, GUINT_TO_POINTER (i + 1), NULL);
+                rtm_glib_set_io_thread (rtm, i % 2 == 0);
+        }
+        g_thread_pool_free (pool, FALSE, TRUE);
+        rtm_glib_set_io_thread (rtm, FALSE);
+
+        fail_unless (n_failed == 0, "Calls from worker threads failed");
+        fail_unless (rtm_loopback_transport_get_n_requests (transport) ==
+                     THREAD_POOL_CALLS,
+                     "Calls from worker threads not sent");
+}
+END_TEST
+
+Suite *
+check_rtm_glib_suite (void)
+{
+        Suite * suite = suite_create ("RtmGlib");
+
+        TCase * tcase_test_echo = tcase_create ("Test echo");
+        tcase_add_checked_fixture (tcase_test_echo, setup, teardown);
+        tcase_add_test (tcase_test_echo, test_test_echo);
+        tcase_add_test (tcase_test_echo, test_prewarm);
+        suite_add_tcase (suite, tcase_test_echo);
+
+        TCase * tcase_signature = tcase_create ("Signature");
+        tcase_add_checked_fixture (tcase_signature, setup, teardown);
+        tcase_add_test (tcase_signature, test_login_url);
+        suite_add_tcase (suite, tcase_signature);
+
+        TCase * tcase_response_fail = tcase_create ("Response fail");
+        tcase_add_checked_fixture (tcase_response_fail, setup, teardown);
+        tcase_add_test (tcase_response_fail, test_response_fail);
+        tcase_add_test (tcase_response_fail, test_method_not_found);
+        suite_add_tcase (suite, tcase_response_fail);
+
+        TCase * tcase_cancel = tcase_create ("Timeout and cancellation");
+        tcase_add_checked_fixture (tcase_cancel, setup, teardown);
+        tcase_add_test (tcase_cancel, test_timeout);
+        tcase_add_test (tcase_cancel, test_timeout_stall);
+        tcase_add_test (tcase_cancel, test_cancelled);
+        suite_add_tcase (suite, tcase_cancel);
+
+        TCase * tcase_rate_limit = tcase_create ("Rate limit");
+        tcase_add_checked_fixture (tcase_rate_limit, setup, teardown);
+        tcase_add_test (tcase_rate_limit, test_rate_limit);
+        tcase_add_test (tcase_rate_limit, test_rate_limit_refund);
+        suite_add_tcase (suite, tcase_rate_limit);
+
+        TCase * tcase_retry = tcase_create ("Retry");
+        tcase_add_checked_fixture (tcase_retry, setup, teardown);
+        tcase_add_test (tcase_retry, test_retry_read);
+        tcase_add_test (tcase_retry, test_retry_write);
+        tcase_add_test (tcase_retry, test_retry_max_retries);
+        suite_add_tcase (suite, tcase_retry);
+
+        TCase * tcase_single_flight = tcase_create ("Single flight");
+        tcase_add_checked_fixture (tcase_single_flight, setup, teardown);
+        tcase_add_test (tcase_single_flight, test_single_flight);
+        suite_add_tcase (suite, tcase_single_flight);
+
+        TCase * tcase_json = tcase_create ("JSON responses");
+        tcase_add_checked_fixture (tcase_json, setup, teardown);
+        tcase_add_test (tcase_json, test_json_lists);
+        tcase_add_test (tcase_json, test_json_tasks);
+        tcase_add_test (tcase_json, test_json_response_fail);
+        suite_add_tcase (suite, tcase_json);
+
+        TCase * tcase_streamed = tcase_create ("Streamed responses");
+        tcase_add_checked_fixture (tcase_streamed, setup, teardown);
+        tcase_add_test (tcase_streamed, test_streamed_tasks);
+        tcase_add_test (tcase_streamed, test_tasks_foreach);
+        tcase_add_test (tcase_streamed, test_lazy_tasks);
+        tcase_add_test (tcase_streamed, test_task_batch);
+        suite_add_tcase (suite, tcase_streamed);
+
+        TCase * tcase_stats = tcase_create ("Method stats");
+        tcase_add_checked_fixture (tcase_stats, setup, teardown);
+        tcase_add_test (tcase_stats, test_method_stats);
+        tcase_add_test (tcase_stats, test_connection_stats);
+        suite_add_tcase (suite, tcase_stats);
+
+        TCase * tcase_coalescer = tcase_create ("Coalescer");
+        tcase_add_checked_fixture (tcase_coalescer, setup, teardown);
+        tcase_add_test (tcase_coalescer, test_coalescer);
+        suite_add_tcase (suite, tcase_coalescer);
+
+        TCase * tcase_journal = tcase_create ("Journal");
+        tcase_add_checked_fixture (tcase_journal, setup, teardown);
+        tcase_add_test (tcase_journal, test_journal);
+        suite_add_tcase (suite, tcase_journal);
+
+        TCase * tcase_queue = tcase_create ("Request queue");
+        tcase_add_checked_fixture (tcase_queue, setup, teardown);
+        tcase_add_test (tcase_queue, test_queue_streamed_method);
+        tcase_add_test (tcase_queue, test_queue_json_format);
+        tcase_add_test (tcase_queue, test_queue_max_in_flight);
+        suite_add_tcase (suite, tcase_queue);
+
+        TCase * tcase_threads = tcase_create ("Threads");
+        tcase_add_checked_fixture (tcase_threads, setup, teardown);
+        tcase_add_test (tcase_threads, test_thread_pool);
+        tcase_add_test (tcase_threads, test_thread_auth_token);
+        tcase_add_test (tcase_threads, test_thread_single_flight);
+        tcase_add_test (tcase_threads, test_io_thread);
+        tcase_add_test (tcase_threads, test_io_thread_toggle);
+        tcase_add_test (tcase_threads, test_presign);
+        suite_add_tcase (suite, tcase_threads);
+
+        return suite;
+}
+
+int
+main ()
+{
+        int number_failed;
+
+        SRunner *sr = srunner_create (NULL);
+
+        srunner_add_suite (sr, (Suite *) check_rtm_glib_suite ());
+
+        srunner_run_all (sr, CK_VERBOSE);
+        number_failed = srunner_ntests_failed (sr);
+        srunner_free (sr);
+        return (number_failed == 0) ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -0,0 +1,206 @@
+/*
+ * check-rtm-inflater.c: Test RtmInflater decoding
+ *
+ * Copyright (C) 2009 Manuel Rego Casasnovas <mrego@igalia.com>
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301 USA
+ */
+
+#include <stdlib.h>
+#include <string.h>
+#include <check.h>
+#include <gio/gio.h>
+#include <rtm-glib/rtm-inflater.h>
+
+#define XML_RESPONSE "<?xml version=\"1.0\" encoding=\"UTF-8\"?>" \
+        "<rsp stat=\"ok\"><lists><list id=\"100653\" name=\"Inbox\"/>" \
+        "</lists></rsp>"
+
+#define JSON_RESPONSE "{\"rsp\":{\"stat\":\"ok\",\"lists\":{\"list\":[" \
+        "{\"id\":\"100653\",\"name\":\"Inbox\"}]}}}"
+
+static GByteArray *
+compress (GZlibCompressorFormat format, const gchar *text)
+{
+        GConverter *compressor;
+        GByteArray *output;
+        gchar buffer[4096];
+        gsize length, bytes_read, bytes_written;
+        GConverterResult result;
+
+        compressor = G_CONVERTER (g_zlib_compressor_new (format, -1));
+        output = g_byte_array_new ();
+        length = strlen (text);
+
+        do {
+                result = g_converter_convert (compressor, text, length,
+                                              buffer, sizeof (buffer),
+                                              G_CONVERTER_INPUT_AT_END,
+                                              &bytes_read, &bytes_written,
+                                              NULL);
+                fail_unless (result != G_CONVERTER_ERROR,
+                             "Test data not compressed");
+                g_byte_array_append (output, (guint8 *) buffer,
+                                     bytes_written);
+                text += bytes_read;
+                length -= bytes_read;
+        } while (result != G_CONVERTER_FINISHED);
+
+        g_object_unref (compressor);
+
+        return output;
+}
+
+static gchar *
+inflate (const gchar *content_encoding, const guint8 *data, gsize length,
+         gsize chunk_size)
+{
+        RtmInflater *inflater;
+        GByteArray *output;
+        gsize offset, size;
+
+        inflater = rtm_inflater_new (content_encoding);
+        fail_unless (inflater != NULL, "Content coding not supported");
+
+        output = g_byte_array_new ();
+        for (offset = 0; offset < length; offset += size) {
+                size = MIN (chunk_size, length - offset);
+                fail_unless (rtm_inflater_feed (inflater,
+                                                (const gchar *) data + offset,
+                                                size, output, NULL),
+                             "Body not decoded");
+        }
+        fail_unless (rtm_inflater_finish (inflater, output, NULL),
+                     "Body not flushed");
+        rtm_inflater_free (inflater);
+
+        g_byte_array_append (output, (guint8 *) "", 1);
+
+        return (gchar *) g_byte_array_free (output, FALSE);
+}
+
+START_TEST (test_identity)
+{
+        fail_unless (rtm_inflater_new (NULL) == NULL,
+                     "Decoder created for an uncompressed body");
+        fail_unless (rtm_inflater_new ("identity") == NULL,
+                     "Decoder created for an unknown coding");
+}
+END_TEST
+
+START_TEST (test_gzip)
+{
+        GByteArray *body;
+        gchar *text;
+
+        body = compress (G_ZLIB_COMPRESSOR_FORMAT_GZIP, XML_RESPONSE);
+        fail_unless (body->data[0] == 0x1f && body->data[1] == 0x8b,
+                     "Test data not in gzip format");
+
+        text = inflate ("gzip", body->data, body->len, body->len);
+        fail_unless (g_strcmp0 (text, XML_RESPONSE) == 0,
+                     "Gzip body not decoded");
+        g_free (text);
+
+        /* The header is split across chunks */
+        text = inflate ("gzip", body->data, body->len, 1);
+        fail_unless (g_strcmp0 (text, XML_RESPONSE) == 0,
+                     "Gzip body not decoded chunk by chunk");
+        g_free (text);
+
+        g_byte_array_free (body, TRUE);
+}
+END_TEST
+
+START_TEST (test_deflate)
+{
+        GByteArray *body;
+        gchar *text;
+
+        body = compress (G_ZLIB_COMPRESSOR_FORMAT_ZLIB, JSON_RESPONSE);
+
+        text = inflate ("deflate", body->data, body->len, body->len);
+        fail_unless (g_strcmp0 (text, JSON_RESPONSE) == 0,
+                     "Deflate body not decoded");
+        g_free (text);
+
+        text = inflate ("deflate", body->data, body->len, 1);
+        fail_unless (g_strcmp0 (text, JSON_RESPONSE) == 0,
+                     "Deflate body not decoded chunk by chunk");
+        g_free (text);
+
+        /* The format comes from the body, not from the header */
+        text = inflate ("gzip", body->data, body->len, body->len);
+        fail_unless (g_strcmp0 (text, JSON_RESPONSE) == 0,
+                     "Zlib body labeled as gzip not decoded");
+        g_free (text);
+
+        g_byte_array_free (body, TRUE);
+}
+END_TEST
+
+START_TEST (test_pass_through)
+{
+        gchar *text;
+
+        /* Bodies already decoded by the HTTP session */
+        text = inflate ("gzip", (const guint8 *) JSON_RESPONSE,
+                        strlen (JSON_RESPONSE), 7);
+        fail_unless (g_strcmp0 (text, JSON_RESPONSE) == 0,
+                     "Decoded JSON body not copied as is");
+        g_free (text);
+
+        text = inflate ("deflate", (const guint8 *) XML_RESPONSE,
+                        strlen (XML_RESPONSE), 1);
+        fail_unless (g_strcmp0 (text, XML_RESPONSE) == 0,
+                     "Decoded XML body not copied as is");
+        g_free (text);
+
+        text = inflate ("gzip", (const guint8 *) "x", 1, 1);
+        fail_unless (g_strcmp0 (text, "x") == 0,
+                     "Body shorter than a header not copied as is");
+        g_free (text);
+}
+END_TEST
+
+Suite *
+check_rtm_inflater_suite (void)
+{
+        Suite * suite = suite_create ("RtmInflater");
+
+        TCase * tcase_formats = tcase_create ("Formats");
+        tcase_add_test (tcase_formats, test_identity);
+        tcase_add_test (tcase_formats, test_gzip);
+        tcase_add_test (tcase_formats, test_deflate);
+        tcase_add_test (tcase_formats, test_pass_through);
+        suite_add_tcase (suite, tcase_formats);
+
+        return suite;
+}
+
+int
+main ()
+{
+        int number_failed;
+
+        SRunner *sr = srunner_create (NULL);
+
+        srunner_add_suite (sr, (Suite *) check_rtm_inflater_suite ());
+
+        srunner_run_all (sr, CK_VERBOSE);
+        number_failed = srunner_ntests_failed (sr);
+        srunner_free (sr);
+        return (number_failed == 0) ? EXIT_SUCCESS : EXIT_FAILURE;
+}
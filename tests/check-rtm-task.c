@@ -310,6 +310,25 @@ START_TEST (test_load_data)
 }
 END_TEST
 
+START_TEST (test_load_dates)
+{
+        GTimeVal date;
+
+        /* The layout sent by Remember The Milk and a generic one */
+        rtm_task_load_attribute (task, "task", "due", "2008-02-29T23:59:59Z");
+        g_time_val_from_iso8601 ("2008-02-29T23:59:59Z", &date);
+        fail_unless (rtm_task_get_due_date (task)->tv_sec == date.tv_sec,
+                     "Task due date not loaded properly");
+
+        rtm_task_load_attribute (task, "task", "added",
+                                 "2009-05-07T12:19:54.5+02:00");
+        g_time_val_from_iso8601 ("2009-05-07T12:19:54.5+02:00", &date);
+        fail_unless (rtm_task_get_added_date (task)->tv_sec == date.tv_sec &&
+                     rtm_task_get_added_date (task)->tv_usec == date.tv_usec,
+                     "Task added date not loaded properly");
+}
+END_TEST
+
 START_TEST (test_find_tag)
 {
         gchar *found_tag;
@@ -484,6 +503,11 @@ check_rtm_task_suite (void)
         tcase_add_test (tcase_load_data, test_load_data);
         suite_add_tcase (suite, tcase_load_data);
 
+        TCase * tcase_load_dates = tcase_create ("Load dates");
+        tcase_add_checked_fixture (tcase_load_dates, setup, teardown);
+        tcase_add_test (tcase_load_dates, test_load_dates);
+        suite_add_tcase (suite, tcase_load_dates);
+
         TCase * tcase_find_tag = tcase_create ("Find tag");
         tcase_add_checked_fixture (tcase_find_tag, setup, teardown);
         tcase_add_test (tcase_find_tag, test_find_tag);